@@ -13,6 +13,18 @@
 #pragma once
 
 #include <DirectXMath.h>
+#include <cfloat>
+
+
+// SAL annotations are part of the Microsoft toolchain. Other compilers using the portable
+// DirectXMath headers may not have them, in which case they are defined away here.
+#ifndef _In_
+#define _WINDOWS_NUMERICS_SAL_FALLBACK_
+#define _In_
+#define _Out_
+#define _In_reads_(count)
+#define _Out_writes_(count)
+#endif
 
 
 #if defined __cplusplus_winrt && _MSC_VER >= 1900
@@ -56,6 +68,16 @@
 #endif
 
 
+// Constructors, common values and simple arithmetic are constexpr where the compiler supports it, so
+// constant tables of these types can be initialized at compile time rather than by dynamic initializers.
+// The C++/CX projection declares the struct members itself, so they cannot be constexpr in that mode.
+#if (!defined _MSC_VER || _MSC_VER >= 1900) && !defined _WINDOWS_NUMERICS_CX_PROJECTION_
+#define _WINDOWS_NUMERICS_CONSTEXPR_ constexpr
+#else
+#define _WINDOWS_NUMERICS_CONSTEXPR_ inline
+#endif
+
+
 namespace Windows { namespace Foundation { namespace Numerics
 {
 #ifndef _WINDOWS_NUMERICS_CX_PROJECTION_
@@ -75,8 +97,8 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         float2() = default;
-        float2(float x, float y);
-        explicit float2(float value);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float2(float x, float y);
+        _WINDOWS_NUMERICS_CONSTEXPR_ explicit float2(float value);
 
         // Conversion operators.
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(float2, Vector2)
@@ -90,39 +112,39 @@ namespace Windows { namespace Foundation { namespace Numerics
 #endif
 
         // Common values.
-        static float2 zero();
-        static float2 one();
-        static float2 unit_x();
-        static float2 unit_y();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float2 zero();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float2 one();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float2 unit_x();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float2 unit_y();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
 
 
     // Operators.
-    float2 operator +(float2 const& value1, float2 const& value2);
-    float2 operator -(float2 const& value1, float2 const& value2);
-    float2 operator *(float2 const& value1, float2 const& value2);
-    float2 operator *(float2 const& value1, float value2);
-    float2 operator *(float value1, float2 const& value2);
-    float2 operator /(float2 const& value1, float2 const& value2);
-    float2 operator /(float2 const& value1, float value2);
-    float2 operator -(float2 const& value);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator +(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator -(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float2 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator /(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator /(float2 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator -(float2 const& value);
     float2& operator +=(float2& value1, float2 const& value2);
     float2& operator -=(float2& value1, float2 const& value2);
     float2& operator *=(float2& value1, float2 const& value2);
     float2& operator *=(float2& value1, float value2);
     float2& operator /=(float2& value1, float2 const& value2);
     float2& operator /=(float2& value1, float value2);
-    bool operator ==(float2 const& value1, float2 const& value2);
-    bool operator !=(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float2 const& value1, float2 const& value2);
 
     // Functions.
     float length(float2 const& value);
     float length_squared(float2 const& value);
     float distance(float2 const& value1, float2 const& value2);
     float distance_squared(float2 const& value1, float2 const& value2);
-    float dot(float2 const& value1, float2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float dot(float2 const& value1, float2 const& value2);
     float2 normalize(float2 const& value);
     float2 reflect(float2 const& vector, float2 const& normal);
     float2 (min)(float2 const& value1, float2 const& value2);
@@ -135,6 +157,16 @@ namespace Windows { namespace Foundation { namespace Numerics
     float2 transform_normal(float2 const& normal, float4x4 const& matrix);
     float2 transform(float2 const& value, quaternion const& rotation);
 
+    // Batch functions.
+    void transform(_In_reads_(count) float2 const* positions, size_t count, float3x2 const& matrix, _Out_writes_(count) float2* results);
+    void transform(_In_reads_(count) float2 const* positions, size_t count, float4x4 const& matrix, _Out_writes_(count) float2* results);
+    void transform_normal(_In_reads_(count) float2 const* normals, size_t count, float3x2 const& matrix, _Out_writes_(count) float2* results);
+    void transform_normal(_In_reads_(count) float2 const* normals, size_t count, float4x4 const& matrix, _Out_writes_(count) float2* results);
+    void normalize(_In_reads_(count) float2 const* values, size_t count, _Out_writes_(count) float2* results);
+    void length(_In_reads_(count) float2 const* values, size_t count, _Out_writes_(count) float* results);
+    void dot(_In_reads_(count) float2 const* values1, _In_reads_(count) float2 const* values2, size_t count, _Out_writes_(count) float* results);
+    void lerp(_In_reads_(count) float2 const* values1, _In_reads_(count) float2 const* values2, size_t count, float amount, _Out_writes_(count) float2* results);
+
 
 #ifndef _WINDOWS_NUMERICS_CX_PROJECTION_
 
@@ -144,47 +176,47 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         float3() = default;
-        float3(float x, float y, float z);
-        float3(float2 value, float z);
-        explicit float3(float value);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float3(float x, float y, float z);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float3(float2 value, float z);
+        _WINDOWS_NUMERICS_CONSTEXPR_ explicit float3(float value);
 
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(float3, Vector3)
 
         // Common values.
-        static float3 zero();
-        static float3 one();
-        static float3 unit_x();
-        static float3 unit_y();
-        static float3 unit_z();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3 zero();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3 one();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3 unit_x();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3 unit_y();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3 unit_z();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
 
 
     // Operators.
-    float3 operator +(float3 const& value1, float3 const& value2);
-    float3 operator -(float3 const& value1, float3 const& value2);
-    float3 operator *(float3 const& value1, float3 const& value2);
-    float3 operator *(float3 const& value1, float value2);
-    float3 operator *(float value1, float3 const& value2);
-    float3 operator /(float3 const& value1, float3 const& value2);
-    float3 operator /(float3 const& value1, float value2);
-    float3 operator -(float3 const& value);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator +(float3 const& value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator -(float3 const& value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator *(float3 const& value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator *(float3 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator *(float value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator /(float3 const& value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator /(float3 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator -(float3 const& value);
     float3& operator +=(float3& value1, float3 const& value2);
     float3& operator -=(float3& value1, float3 const& value2);
     float3& operator *=(float3& value1, float3 const& value2);
     float3& operator *=(float3& value1, float value2);
     float3& operator /=(float3& value1, float3 const& value2);
     float3& operator /=(float3& value1, float value2);
-    bool operator ==(float3 const& value1, float3 const& value2);
-    bool operator !=(float3 const& value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float3 const& value1, float3 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float3 const& value1, float3 const& value2);
 
     // Functions.
     float length(float3 const& value);
     float length_squared(float3 const& value);
     float distance(float3 const& value1, float3 const& value2);
     float distance_squared(float3 const& value1, float3 const& value2);
-    float dot(float3 const& vector1, float3 const& vector2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float dot(float3 const& vector1, float3 const& vector2);
     float3 normalize(float3 const& value);
     float3 cross(float3 const& vector1, float3 const& vector2);
     float3 reflect(float3 const& vector, float3 const& normal);
@@ -196,6 +228,14 @@ namespace Windows { namespace Foundation { namespace Numerics
     float3 transform_normal(float3 const& normal, float4x4 const& matrix);
     float3 transform(float3 const& value, quaternion const& rotation);
 
+    // Batch functions.
+    void transform(_In_reads_(count) float3 const* positions, size_t count, float4x4 const& matrix, _Out_writes_(count) float3* results);
+    void transform_normal(_In_reads_(count) float3 const* normals, size_t count, float4x4 const& matrix, _Out_writes_(count) float3* results);
+    void normalize(_In_reads_(count) float3 const* values, size_t count, _Out_writes_(count) float3* results);
+    void length(_In_reads_(count) float3 const* values, size_t count, _Out_writes_(count) float* results);
+    void dot(_In_reads_(count) float3 const* values1, _In_reads_(count) float3 const* values2, size_t count, _Out_writes_(count) float* results);
+    void lerp(_In_reads_(count) float3 const* values1, _In_reads_(count) float3 const* values2, size_t count, float amount, _Out_writes_(count) float3* results);
+
 
 #ifndef _WINDOWS_NUMERICS_CX_PROJECTION_
 
@@ -205,20 +245,20 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         float4() = default;
-        float4(float x, float y, float z, float w);
-        float4(float2 value, float z, float w);
-        float4(float3 value, float w);
-        explicit float4(float value);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float4(float x, float y, float z, float w);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float4(float2 value, float z, float w);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float4(float3 value, float w);
+        _WINDOWS_NUMERICS_CONSTEXPR_ explicit float4(float value);
 
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(float4, Vector4)
 
         // Common values.
-        static float4 zero();
-        static float4 one();
-        static float4 unit_x();
-        static float4 unit_y();
-        static float4 unit_z();
-        static float4 unit_w();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4 zero();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4 one();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4 unit_x();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4 unit_y();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4 unit_z();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4 unit_w();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
@@ -260,6 +300,13 @@ namespace Windows { namespace Foundation { namespace Numerics
     float4 transform4(float3 const& value, quaternion const& rotation);
     float4 transform4(float2 const& value, quaternion const& rotation);
 
+    // Batch functions.
+    void transform(_In_reads_(count) float4 const* vectors, size_t count, float4x4 const& matrix, _Out_writes_(count) float4* results);
+    void normalize(_In_reads_(count) float4 const* values, size_t count, _Out_writes_(count) float4* results);
+    void length(_In_reads_(count) float4 const* values, size_t count, _Out_writes_(count) float* results);
+    void dot(_In_reads_(count) float4 const* values1, _In_reads_(count) float4 const* values2, size_t count, _Out_writes_(count) float* results);
+    void lerp(_In_reads_(count) float4 const* values1, _In_reads_(count) float4 const* values2, size_t count, float amount, _Out_writes_(count) float4* results);
+
 
 #ifndef _WINDOWS_NUMERICS_CX_PROJECTION_
 
@@ -271,43 +318,43 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         float3x2() = default;
-        float3x2(float m11, float m12, float m21, float m22, float m31, float m32);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float3x2(float m11, float m12, float m21, float m22, float m31, float m32);
 
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(float3x2, Matrix3x2)
 
         // Common values.
-        static float3x2 identity();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 identity();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
 
 
     // Factory functions.
-    float3x2 make_float3x2_translation(float2 const& position);
-    float3x2 make_float3x2_translation(float xPosition, float yPosition);
-    float3x2 make_float3x2_scale(float xScale, float yScale);
-    float3x2 make_float3x2_scale(float xScale, float yScale, float2 const& centerPoint);
-    float3x2 make_float3x2_scale(float2 const& scales);
-    float3x2 make_float3x2_scale(float2 const& scales, float2 const& centerPoint);
-    float3x2 make_float3x2_scale(float scale);
-    float3x2 make_float3x2_scale(float scale, float2 const& centerPoint);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_translation(float2 const& position);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_translation(float xPosition, float yPosition);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float xScale, float yScale);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float xScale, float yScale, float2 const& centerPoint);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float2 const& scales);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float2 const& scales, float2 const& centerPoint);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float scale);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float scale, float2 const& centerPoint);
     float3x2 make_float3x2_skew(float radiansX, float radiansY);
     float3x2 make_float3x2_skew(float radiansX, float radiansY, float2 const& centerPoint);
     float3x2 make_float3x2_rotation(float radians);
     float3x2 make_float3x2_rotation(float radians, float2 const& centerPoint);
 
     // Operators.
-    float3x2 operator +(float3x2 const& value1, float3x2 const& value2);
-    float3x2 operator -(float3x2 const& value1, float3x2 const& value2);
-    float3x2 operator *(float3x2 const& value1, float3x2 const& value2);
-    float3x2 operator *(float3x2 const& value1, float value2);
-    float3x2 operator -(float3x2 const& value);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator +(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator -(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator *(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator *(float3x2 const& value1, float value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator -(float3x2 const& value);
     float3x2& operator +=(float3x2& value1, float3x2 const& value2);
     float3x2& operator -=(float3x2& value1, float3x2 const& value2);
     float3x2& operator *=(float3x2& value1, float3x2 const& value2);
     float3x2& operator *=(float3x2& value1, float value2);
-    bool operator ==(float3x2 const& value1, float3x2 const& value2);
-    bool operator !=(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float3x2 const& value1, float3x2 const& value2);
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float3x2 const& value1, float3x2 const& value2);
 
     // Functions.
     bool is_identity(float3x2 const& value);
@@ -316,6 +363,9 @@ namespace Windows { namespace Foundation { namespace Numerics
     bool invert(float3x2 const& matrix, _Out_ float3x2* result);
     float3x2 lerp(float3x2 const& matrix1, float3x2 const& matrix2, float amount);
 
+    // Batch functions.
+    void multiply(_In_reads_(count) float3x2 const* matrices, size_t count, float3x2 const& matrix, _Out_writes_(count) float3x2* results);
+
 
 #ifndef _WINDOWS_NUMERICS_CX_PROJECTION_
 
@@ -328,13 +378,13 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         float4x4() = default;
-        float4x4(float m11, float m12, float m13, float m14, float m21, float m22, float m23, float m24, float m31, float m32, float m33, float m34, float m41, float m42, float m43, float m44);
-        explicit float4x4(float3x2 value);
+        _WINDOWS_NUMERICS_CONSTEXPR_ float4x4(float m11, float m12, float m13, float m14, float m21, float m22, float m23, float m24, float m31, float m32, float m33, float m34, float m41, float m42, float m43, float m44);
+        _WINDOWS_NUMERICS_CONSTEXPR_ explicit float4x4(float3x2 value);
         
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(float4x4, Matrix4x4)
 
         // Common values.
-        static float4x4 identity();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 identity();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
@@ -393,6 +443,9 @@ namespace Windows { namespace Foundation { namespace Numerics
     float4x4 transpose(float4x4 const& matrix);
     float4x4 lerp(float4x4 const& matrix1, float4x4 const& matrix2, float amount);
 
+    // Batch functions.
+    void multiply(_In_reads_(count) float4x4 const* matrices, size_t count, float4x4 const& matrix, _Out_writes_(count) float4x4* results);
+
 
 #ifndef _WINDOWS_NUMERICS_CX_PROJECTION_
 
@@ -403,9 +456,9 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         plane() = default;
-        plane(float x, float y, float z, float d);
-        plane(float3 normal, float d);
-        explicit plane(float4 value);
+        _WINDOWS_NUMERICS_CONSTEXPR_ plane(float x, float y, float z, float d);
+        _WINDOWS_NUMERICS_CONSTEXPR_ plane(float3 normal, float d);
+        _WINDOWS_NUMERICS_CONSTEXPR_ explicit plane(float4 value);
 
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(plane, Plane)
     };
@@ -437,13 +490,13 @@ namespace Windows { namespace Foundation { namespace Numerics
 
         // Constructors.
         quaternion() = default;
-        quaternion(float x, float y, float z, float w);
-        quaternion(float3 vectorPart, float scalarPart);
+        _WINDOWS_NUMERICS_CONSTEXPR_ quaternion(float x, float y, float z, float w);
+        _WINDOWS_NUMERICS_CONSTEXPR_ quaternion(float3 vectorPart, float scalarPart);
 
         _DEFINE_WINDOWS_NUMERICS_INTEROP_(quaternion, Quaternion)
 
         // Common values.
-        static quaternion identity();
+        static _WINDOWS_NUMERICS_CONSTEXPR_ quaternion identity();
     };
 
 #endif  // !_WINDOWS_NUMERICS_CX_PROJECTION_
@@ -510,3 +563,12 @@ namespace DirectX
 #undef _WINDOWS_NUMERICS_CX_PROJECTION_
 #undef _WINDOWS_NUMERICS_INTEROP_NAMESPACE_
 #undef _DEFINE_WINDOWS_NUMERICS_INTEROP_
+#undef _WINDOWS_NUMERICS_CONSTEXPR_
+
+#ifdef _WINDOWS_NUMERICS_SAL_FALLBACK_
+#undef _WINDOWS_NUMERICS_SAL_FALLBACK_
+#undef _In_
+#undef _Out_
+#undef _In_reads_
+#undef _Out_writes_
+#endif
@@ -10,12 +10,14 @@
 // License for the specific language governing permissions and limitations
 // under the License.
 
+#ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable: 4723) // potential divide by 0
 #pragma warning(disable: 4756) // overflow in constant arithmetic
+#endif
 
 
-#ifdef _CPPUNWIND
+#if defined _CPPUNWIND || defined __cpp_exceptions
 
 // If C++ exception handling is enabled, we can throw exceptions and use STL to access NaN.
 #include <stdexcept>
@@ -33,9 +35,17 @@
 #endif
 
 
+// The batch functions process enough values per call to keep data in SIMD
+// registers across several operations, so they use DirectXMath on ARM NEON
+// as well, unless SIMD has been explicitly disabled.
+#ifndef WINDOWS_NUMERICS_DISABLE_SIMD
+#define _WINDOWS_NUMERICS_BATCH_SIMD_
+#endif
+
+
 // Implementing some operations via the SIMD DirectXMath API is a performance
 // win for SSE CPU architectures (x86 and x64), but not for ARM NEON.
-#if defined _M_ARM && !defined WINDOWS_NUMERICS_DISABLE_SIMD
+#if (defined _M_ARM || defined __arm__) && !defined WINDOWS_NUMERICS_DISABLE_SIMD
 #define WINDOWS_NUMERICS_DISABLE_SIMD
 #endif
 
@@ -143,12 +153,12 @@ namespace DirectX
 
 namespace Windows { namespace Foundation { namespace Numerics
 {
-    inline float2::float2(float x, float y)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2::float2(float x, float y)
         : x(x), y(y)
     { }
 
 
-    inline float2::float2(float value)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2::float2(float value)
         : x(value), y(value)
     { }
 
@@ -208,78 +218,78 @@ namespace Windows { namespace Foundation { namespace Numerics
 #endif  // __cpluspluswinrt && !_WINDOWS_NUMERICS_CX_PROJECTION_
 
 
-    inline float2 float2::zero()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 float2::zero()
     {
         return float2(0, 0);
     }
 
 
-    inline float2 float2::one()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 float2::one()
     {
         return float2(1, 1);
     }
 
 
-    inline float2 float2::unit_x()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 float2::unit_x()
     {
         return float2(1, 0);
     }
 
 
-    inline float2 float2::unit_y()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 float2::unit_y()
     {
         return float2(0, 1);
     }
 
 
-    inline float2 operator +(float2 const& value1, float2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator +(float2 const& value1, float2 const& value2)
     {
         return float2(value1.x + value2.x,
                       value1.y + value2.y);
     }
 
 
-    inline float2 operator -(float2 const& value1, float2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator -(float2 const& value1, float2 const& value2)
     {
         return float2(value1.x - value2.x,
                       value1.y - value2.y);
     }
 
 
-    inline float2 operator *(float2 const& value1, float2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float2 const& value1, float2 const& value2)
     {
         return float2(value1.x * value2.x,
                       value1.y * value2.y);
     }
 
 
-    inline float2 operator *(float2 const& value1, float value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float2 const& value1, float value2)
     {
         return float2(value1.x * value2,
                       value1.y * value2);
     }
 
 
-    inline float2 operator *(float value1, float2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator *(float value1, float2 const& value2)
     {
         return value2 * value1;
     }
 
 
-    inline float2 operator /(float2 const& value1, float2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator /(float2 const& value1, float2 const& value2)
     {
         return float2(value1.x / value2.x,
                       value1.y / value2.y);
     }
 
 
-    inline float2 operator /(float2 const& value1, float value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator /(float2 const& value1, float value2)
     {
         return value1 * (1.0f / value2);
     }
 
 
-    inline float2 operator -(float2 const& value)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float2 operator -(float2 const& value)
     {
         return float2(-value.x,
                       -value.y);
@@ -334,14 +344,14 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator ==(float2 const& value1, float2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float2 const& value1, float2 const& value2)
     {
         return value1.x == value2.x &&
                value1.y == value2.y;
     }
 
 
-    inline bool operator !=(float2 const& value1, float2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float2 const& value1, float2 const& value2)
     {
         return value1.x != value2.x ||
                value1.y != value2.y;
@@ -372,7 +382,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float dot(float2 const& value1, float2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float dot(float2 const& value1, float2 const& value2)
     {
         return value1.x * value2.x +
                value1.y * value2.y;
@@ -471,52 +481,52 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3::float3(float x, float y, float z)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3::float3(float x, float y, float z)
         : x(x), y(y), z(z)
     { }
 
 
-    inline float3::float3(float2 value, float z)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3::float3(float2 value, float z)
         : x(value.x), y(value.y), z(z)
     { }
 
 
-    inline float3::float3(float value)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3::float3(float value)
         : x(value), y(value), z(value)
     { }
 
 
-    inline float3 float3::zero()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 float3::zero()
     {
         return float3(0, 0, 0);
     }
 
 
-    inline float3 float3::one()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 float3::one()
     {
         return float3(1, 1, 1);
     }
 
 
-    inline float3 float3::unit_x()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 float3::unit_x()
     {
         return float3(1, 0, 0);
     }
 
 
-    inline float3 float3::unit_y()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 float3::unit_y()
     {
         return float3(0, 1, 0);
     }
 
 
-    inline float3 float3::unit_z()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 float3::unit_z()
     {
         return float3(0, 0, 1);
     }
 
 
-    inline float3 operator +(float3 const& value1, float3 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator +(float3 const& value1, float3 const& value2)
     {
         return float3(value1.x + value2.x,
                       value1.y + value2.y,
@@ -524,7 +534,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3 operator -(float3 const& value1, float3 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator -(float3 const& value1, float3 const& value2)
     {
         return float3(value1.x - value2.x,
                       value1.y - value2.y,
@@ -532,7 +542,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3 operator *(float3 const& value1, float3 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator *(float3 const& value1, float3 const& value2)
     {
         return float3(value1.x * value2.x,
                       value1.y * value2.y,
@@ -540,7 +550,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3 operator *(float3 const& value1, float value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator *(float3 const& value1, float value2)
     {
         return float3(value1.x * value2,
                       value1.y * value2,
@@ -548,13 +558,13 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3 operator *(float value1, float3 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator *(float value1, float3 const& value2)
     {
         return value2 * value1;
     }
 
 
-    inline float3 operator /(float3 const& value1, float3 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator /(float3 const& value1, float3 const& value2)
     {
         return float3(value1.x / value2.x,
                       value1.y / value2.y,
@@ -562,13 +572,13 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3 operator /(float3 const& value1, float value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator /(float3 const& value1, float value2)
     {
         return value1 * (1.0f / value2);
     }
 
 
-    inline float3 operator -(float3 const& value)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3 operator -(float3 const& value)
     {
         return float3(-value.x,
                       -value.y,
@@ -624,7 +634,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator ==(float3 const& value1, float3 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float3 const& value1, float3 const& value2)
     {
         return value1.x == value2.x &&
                value1.y == value2.y &&
@@ -632,7 +642,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator !=(float3 const& value1, float3 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float3 const& value1, float3 const& value2)
     {
         return value1.x != value2.x ||
                value1.y != value2.y ||
@@ -664,7 +674,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float dot(float3 const& vector1, float3 const& vector2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float dot(float3 const& vector1, float3 const& vector2)
     {
         return vector1.x * vector2.x +
                vector1.y * vector2.y +
@@ -767,57 +777,57 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float4::float4(float x, float y, float z, float w)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4::float4(float x, float y, float z, float w)
         : x(x), y(y), z(z), w(w)
     { }
 
 
-    inline float4::float4(float2 value, float z, float w)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4::float4(float2 value, float z, float w)
         : x(value.x), y(value.y), z(z), w(w)
     { }
 
 
-    inline float4::float4(float3 value, float w)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4::float4(float3 value, float w)
         : x(value.x), y(value.y), z(value.z), w(w)
     { }
 
 
-    inline float4::float4(float value)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4::float4(float value)
         : x(value), y(value), z(value), w(value)
     { }
 
 
-    inline float4 float4::zero()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4 float4::zero()
     {
         return float4(0, 0, 0, 0);
     }
 
 
-    inline float4 float4::one()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4 float4::one()
     {
         return float4(1, 1, 1, 1);
     }
 
 
-    inline float4 float4::unit_x()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4 float4::unit_x()
     {
         return float4(1, 0, 0, 0);
     }
 
 
-    inline float4 float4::unit_y()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4 float4::unit_y()
     {
         return float4(0, 1, 0, 0);
     }
 
 
-    inline float4 float4::unit_z()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4 float4::unit_z()
     {
         return float4(0, 0, 1, 0);
     }
 
 
-    inline float4 float4::unit_w()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4 float4::unit_w()
     {
         return float4(0, 0, 0, 1);
     }
@@ -1201,12 +1211,12 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2::float3x2(float m11, float m12, float m21, float m22, float m31, float m32)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2::float3x2(float m11, float m12, float m21, float m22, float m31, float m32)
         : m11(m11), m12(m12), m21(m21), m22(m22), m31(m31), m32(m32)
     { }
 
 
-    inline float3x2 float3x2::identity()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 float3x2::identity()
     {
         return float3x2(1, 0,
                         0, 1,
@@ -1214,7 +1224,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 make_float3x2_translation(float2 const& position)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_translation(float2 const& position)
     {
         return float3x2(1, 0,
                         0, 1,
@@ -1222,7 +1232,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 make_float3x2_translation(float xPosition, float yPosition)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_translation(float xPosition, float yPosition)
     {
         return float3x2(1, 0,
                         0, 1,
@@ -1230,7 +1240,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 make_float3x2_scale(float xScale, float yScale)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float xScale, float yScale)
     {
         return float3x2(xScale, 0,
                         0,      yScale,
@@ -1238,18 +1248,15 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 make_float3x2_scale(float xScale, float yScale, float2 const& centerPoint)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float xScale, float yScale, float2 const& centerPoint)
     {
-        float tx = centerPoint.x * (1 - xScale);
-        float ty = centerPoint.y * (1 - yScale);
-
-        return float3x2(xScale, 0,
-                        0,      yScale,
-                        tx,     ty);
+        return float3x2(xScale,                         0,
+                        0,                              yScale,
+                        centerPoint.x * (1 - xScale),   centerPoint.y * (1 - yScale));
     }
 
 
-    inline float3x2 make_float3x2_scale(float2 const& scales)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float2 const& scales)
     {
         return float3x2(scales.x, 0,
                         0,        scales.y,
@@ -1257,17 +1264,13 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 make_float3x2_scale(float2 const& scales, float2 const& centerPoint)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float2 const& scales, float2 const& centerPoint)
     {
-        float2 t = centerPoint * (float2::one() - scales);
-
-        return float3x2(scales.x, 0,
-                        0,        scales.y,
-                        t.x,      t.y);
+        return make_float3x2_scale(scales.x, scales.y, centerPoint);
     }
 
 
-    inline float3x2 make_float3x2_scale(float scale)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float scale)
     {
         return float3x2(scale, 0,
                         0,     scale,
@@ -1275,13 +1278,9 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 make_float3x2_scale(float scale, float2 const& centerPoint)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 make_float3x2_scale(float scale, float2 const& centerPoint)
     {
-        float2 t = centerPoint * (1 - scale);
-
-        return float3x2(scale, 0,
-                        0,     scale,
-                        t.x,   t.y);
+        return make_float3x2_scale(scale, scale, centerPoint);
     }
 
 
@@ -1367,7 +1366,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 operator +(float3x2 const& value1, float3x2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator +(float3x2 const& value1, float3x2 const& value2)
     {
         return float3x2(value1.m11 + value2.m11,  value1.m12 + value2.m12,
                         value1.m21 + value2.m21,  value1.m22 + value2.m22,
@@ -1375,7 +1374,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 operator -(float3x2 const& value1, float3x2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator -(float3x2 const& value1, float3x2 const& value2)
     {
         return float3x2(value1.m11 - value2.m11,  value1.m12 - value2.m12,
                         value1.m21 - value2.m21,  value1.m22 - value2.m22,
@@ -1383,7 +1382,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 operator *(float3x2 const& value1, float3x2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator *(float3x2 const& value1, float3x2 const& value2)
     {
         return float3x2
         (
@@ -1402,7 +1401,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 operator *(float3x2 const& value1, float value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator *(float3x2 const& value1, float value2)
     {
         return float3x2(value1.m11 * value2,  value1.m12 * value2,
                         value1.m21 * value2,  value1.m22 * value2,
@@ -1410,7 +1409,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float3x2 operator -(float3x2 const& value)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float3x2 operator -(float3x2 const& value)
     {
         return float3x2(-value.m11, -value.m12,
                         -value.m21, -value.m22,
@@ -1450,7 +1449,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator ==(float3x2 const& value1, float3x2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator ==(float3x2 const& value1, float3x2 const& value2)
     {
         return value1.m11 == value2.m11 && value1.m22 == value2.m22 && // Check diagonal element first for early out.
                                            value1.m12 == value2.m12 &&
@@ -1459,7 +1458,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline bool operator !=(float3x2 const& value1, float3x2 const& value2)
+    _WINDOWS_NUMERICS_CONSTEXPR_ bool operator !=(float3x2 const& value1, float3x2 const& value2)
     {
         return value1.m11 != value2.m11 || value1.m12 != value2.m12 ||
                value1.m21 != value2.m21 || value1.m22 != value2.m22 ||
@@ -1526,7 +1525,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline float4x4::float4x4(float m11, float m12, float m13, float m14, float m21, float m22, float m23, float m24, float m31, float m32, float m33, float m34, float m41, float m42, float m43, float m44)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4x4::float4x4(float m11, float m12, float m13, float m14, float m21, float m22, float m23, float m24, float m31, float m32, float m33, float m34, float m41, float m42, float m43, float m44)
         : m11(m11), m12(m12), m13(m13), m14(m14),
           m21(m21), m22(m22), m23(m23), m24(m24),
           m31(m31), m32(m32), m33(m33), m34(m34),
@@ -1534,7 +1533,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     { }
 
 
-    inline float4x4::float4x4(float3x2 value)
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4x4::float4x4(float3x2 value)
         : m11(value.m11), m12(value.m12), m13(0), m14(0),
           m21(value.m21), m22(value.m22), m23(0), m24(0),
           m31(0),         m32(0),         m33(1), m34(0),
@@ -1542,7 +1541,7 @@ namespace Windows { namespace Foundation { namespace Numerics
     { }
 
 
-    inline float4x4 float4x4::identity()
+    _WINDOWS_NUMERICS_CONSTEXPR_ float4x4 float4x4::identity()
     {
         return float4x4(1, 0, 0, 0,
                         0, 1, 0, 0,
@@ -2478,17 +2477,17 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline plane::plane(float x, float y, float z, float d)
+    _WINDOWS_NUMERICS_CONSTEXPR_ plane::plane(float x, float y, float z, float d)
         : normal(x, y, z), d(d)
     { }
 
 
-    inline plane::plane(float3 normal, float d)
+    _WINDOWS_NUMERICS_CONSTEXPR_ plane::plane(float3 normal, float d)
         : normal(normal), d(d)
     { }
 
 
-    inline plane::plane(float4 value)
+    _WINDOWS_NUMERICS_CONSTEXPR_ plane::plane(float4 value)
         : normal(value.x, value.y, value.z), d(value.w)
     { }
 
@@ -2599,17 +2598,17 @@ namespace Windows { namespace Foundation { namespace Numerics
     }
 
 
-    inline quaternion::quaternion(float x, float y, float z, float w)
+    _WINDOWS_NUMERICS_CONSTEXPR_ quaternion::quaternion(float x, float y, float z, float w)
         : x(x), y(y), z(z), w(w)
     { }
 
 
-    inline quaternion::quaternion(float3 vectorPart, float scalarPart)
+    _WINDOWS_NUMERICS_CONSTEXPR_ quaternion::quaternion(float3 vectorPart, float scalarPart)
         : x(vectorPart.x), y(vectorPart.y), z(vectorPart.z), w(scalarPart)
     { }
 
 
-    inline quaternion quaternion::identity()
+    _WINDOWS_NUMERICS_CONSTEXPR_ quaternion quaternion::identity()
     {
         return quaternion(0, 0, 0, 1);
     }
@@ -2986,10 +2985,603 @@ namespace Windows { namespace Foundation { namespace Numerics
     {
         return value2 * value1;
     }
+
+
+    // Batch functions.
+    //
+    // The SIMD versions of the float2 and float3 functions load four values at a
+    // time, and rearrange them into separate vectors of x, y and z components so
+    // that all four results are computed at once. float4 values already fill a
+    // SIMD register, so they are processed one at a time, but with any matrix
+    // loaded only once per call. Values left over at the end of an array are
+    // passed to the corresponding single value function.
+
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+
+    namespace details
+    {
+        inline void XM_CALLCONV load_float2x4(_In_reads_(4) float2 const* values, _Out_ ::DirectX::XMVECTOR* x, _Out_ ::DirectX::XMVECTOR* y)
+        {
+            using namespace ::DirectX;
+
+            XMVECTOR a = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(values));         // x0 y0 x1 y1
+            XMVECTOR b = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(values + 2));     // x2 y2 x3 y3
+
+            *x = XMVectorPermute<0, 2, 4, 6>(a, b);
+            *y = XMVectorPermute<1, 3, 5, 7>(a, b);
+        }
+
+
+        inline void XM_CALLCONV store_float2x4(_Out_writes_(4) float2* results, ::DirectX::FXMVECTOR x, ::DirectX::FXMVECTOR y)
+        {
+            using namespace ::DirectX;
+
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(results), XMVectorMergeXY(x, y));
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(results + 2), XMVectorMergeZW(x, y));
+        }
+
+
+        inline void XM_CALLCONV load_float3x4(_In_reads_(4) float3 const* values, _Out_ ::DirectX::XMVECTOR* x, _Out_ ::DirectX::XMVECTOR* y, _Out_ ::DirectX::XMVECTOR* z)
+        {
+            using namespace ::DirectX;
+
+            XMVECTOR a = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(values));                             // x0 y0 z0 x1
+            XMVECTOR b = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(reinterpret_cast<float const*>(values) + 4));  // y1 z1 x2 y2
+            XMVECTOR c = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(reinterpret_cast<float const*>(values) + 8));  // z2 x3 y3 z3
+
+            *x = XMVectorPermute<0, 1, 2, 5>(XMVectorPermute<0, 3, 6, 7>(a, b), c);
+            *y = XMVectorPermute<0, 1, 2, 6>(XMVectorPermute<1, 4, 7, 7>(a, b), c);
+            *z = XMVectorPermute<0, 1, 4, 7>(XMVectorPermute<2, 5, 5, 5>(a, b), c);
+        }
+
+
+        inline void XM_CALLCONV store_float3x4(_Out_writes_(4) float3* results, ::DirectX::FXMVECTOR x, ::DirectX::FXMVECTOR y, ::DirectX::FXMVECTOR z)
+        {
+            using namespace ::DirectX;
+
+            XMVECTOR a = XMVectorPermute<0, 1, 4, 2>(XMVectorPermute<0, 4, 1, 5>(x, y), z);
+            XMVECTOR b = XMVectorPermute<0, 1, 6, 2>(XMVectorPermute<1, 5, 2, 6>(y, z), x);
+            XMVECTOR c = XMVectorPermute<6, 0, 1, 7>(XMVectorPermute<3, 7, 3, 7>(x, y), z);
+
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(results), a);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(reinterpret_cast<float*>(results) + 4), b);
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(reinterpret_cast<float*>(results) + 8), c);
+        }
+    }
+
+#endif
+
+
+    inline void transform(_In_reads_(count) float2 const* positions, size_t count, float3x2 const& matrix, _Out_writes_(count) float2* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        XMVECTOR m11 = XMVectorReplicate(matrix.m11), m12 = XMVectorReplicate(matrix.m12);
+        XMVECTOR m21 = XMVectorReplicate(matrix.m21), m22 = XMVectorReplicate(matrix.m22);
+        XMVECTOR m31 = XMVectorReplicate(matrix.m31), m32 = XMVectorReplicate(matrix.m32);
+
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            XMVECTOR x, y;
+            details::load_float2x4(positions + i, &x, &y);
+
+            XMVECTOR rx = XMVectorMultiplyAdd(x, m11, XMVectorMultiplyAdd(y, m21, m31));
+            XMVECTOR ry = XMVectorMultiplyAdd(x, m12, XMVectorMultiplyAdd(y, m22, m32));
+
+            details::store_float2x4(results + i, rx, ry);
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = transform(positions[i], matrix);
+        }
+    }
+
+
+    inline void transform(_In_reads_(count) float2 const* positions, size_t count, float4x4 const& matrix, _Out_writes_(count) float2* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        XMVECTOR m11 = XMVectorReplicate(matrix.m11), m12 = XMVectorReplicate(matrix.m12);
+        XMVECTOR m21 = XMVectorReplicate(matrix.m21), m22 = XMVectorReplicate(matrix.m22);
+        XMVECTOR m41 = XMVectorReplicate(matrix.m41), m42 = XMVectorReplicate(matrix.m42);
+
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            XMVECTOR x, y;
+            details::load_float2x4(positions + i, &x, &y);
+
+            XMVECTOR rx = XMVectorMultiplyAdd(x, m11, XMVectorMultiplyAdd(y, m21, m41));
+            XMVECTOR ry = XMVectorMultiplyAdd(x, m12, XMVectorMultiplyAdd(y, m22, m42));
+
+            details::store_float2x4(results + i, rx, ry);
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = transform(positions[i], matrix);
+        }
+    }
+
+
+    inline void transform_normal(_In_reads_(count) float2 const* normals, size_t count, float3x2 const& matrix, _Out_writes_(count) float2* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        XMVECTOR m11 = XMVectorReplicate(matrix.m11), m12 = XMVectorReplicate(matrix.m12);
+        XMVECTOR m21 = XMVectorReplicate(matrix.m21), m22 = XMVectorReplicate(matrix.m22);
+
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            XMVECTOR x, y;
+            details::load_float2x4(normals + i, &x, &y);
+
+            XMVECTOR rx = XMVectorMultiplyAdd(x, m11, XMVectorMultiply(y, m21));
+            XMVECTOR ry = XMVectorMultiplyAdd(x, m12, XMVectorMultiply(y, m22));
+
+            details::store_float2x4(results + i, rx, ry);
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = transform_normal(normals[i], matrix);
+        }
+    }
+
+
+    inline void transform_normal(_In_reads_(count) float2 const* normals, size_t count, float4x4 const& matrix, _Out_writes_(count) float2* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        XMVECTOR m11 = XMVectorReplicate(matrix.m11), m12 = XMVectorReplicate(matrix.m12);
+        XMVECTOR m21 = XMVectorReplicate(matrix.m21), m22 = XMVectorReplicate(matrix.m22);
+
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            XMVECTOR x, y;
+            details::load_float2x4(normals + i, &x, &y);
+
+            XMVECTOR rx = XMVectorMultiplyAdd(x, m11, XMVectorMultiply(y, m21));
+            XMVECTOR ry = XMVectorMultiplyAdd(x, m12, XMVectorMultiply(y, m22));
+
+            details::store_float2x4(results + i, rx, ry);
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = transform_normal(normals[i], matrix);
+        }
+    }
+
+
+    inline void normalize(_In_reads_(count) float2 const* values, size_t count, _Out_writes_(count) float2* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            XMVECTOR x, y;
+            details::load_float2x4(values + i, &x, &y);
+
+            XMVECTOR length = XMVectorSqrt(XMVectorMultiplyAdd(x, x, XMVectorMultiply(y, y)));
+
+            details::store_float2x4(results + i, XMVectorDivide(x, length), XMVectorDivide(y, length));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = normalize(values[i]);
+        }
+    }
+
+
+    inline void length(_In_reads_(count) float2 const* values, size_t count, _Out_writes_(count) float* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            XMVECTOR x, y;
+            details::load_float2x4(values + i, &x, &y);
+
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(results + i), XMVectorSqrt(XMVectorMultiplyAdd(x, x, XMVectorMultiply(y, y))));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = length(values[i]);
+        }
+    }
+
+
+    inline void dot(_In_reads_(count) float2 const* values1, _In_reads_(count) float2 const* values2, size_t count, _Out_writes_(count) float* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            XMVECTOR x1, y1, x2, y2;
+            details::load_float2x4(values1 + i, &x1, &y1);
+            details::load_float2x4(values2 + i, &x2, &y2);
+
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(results + i), XMVectorMultiplyAdd(x1, x2, XMVectorMultiply(y1, y2)));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = dot(values1[i], values2[i]);
+        }
+    }
+
+
+    inline void lerp(_In_reads_(count) float2 const* values1, _In_reads_(count) float2 const* values2, size_t count, float amount, _Out_writes_(count) float2* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        // Interpolation treats every component the same, so two float2 values fit in each register.
+        for (; i < (count & ~size_t(1)); i += 2)
+        {
+            XMVECTOR v1 = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(values1 + i));
+            XMVECTOR v2 = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(values2 + i));
+
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(results + i), XMVectorLerp(v1, v2, amount));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = lerp(values1[i], values2[i], amount);
+        }
+    }
+
+
+    inline void transform(_In_reads_(count) float3 const* positions, size_t count, float4x4 const& matrix, _Out_writes_(count) float3* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        XMVECTOR m11 = XMVectorReplicate(matrix.m11), m12 = XMVectorReplicate(matrix.m12), m13 = XMVectorReplicate(matrix.m13);
+        XMVECTOR m21 = XMVectorReplicate(matrix.m21), m22 = XMVectorReplicate(matrix.m22), m23 = XMVectorReplicate(matrix.m23);
+        XMVECTOR m31 = XMVectorReplicate(matrix.m31), m32 = XMVectorReplicate(matrix.m32), m33 = XMVectorReplicate(matrix.m33);
+        XMVECTOR m41 = XMVectorReplicate(matrix.m41), m42 = XMVectorReplicate(matrix.m42), m43 = XMVectorReplicate(matrix.m43);
+
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            XMVECTOR x, y, z;
+            details::load_float3x4(positions + i, &x, &y, &z);
+
+            XMVECTOR rx = XMVectorMultiplyAdd(x, m11, XMVectorMultiplyAdd(y, m21, XMVectorMultiplyAdd(z, m31, m41)));
+            XMVECTOR ry = XMVectorMultiplyAdd(x, m12, XMVectorMultiplyAdd(y, m22, XMVectorMultiplyAdd(z, m32, m42)));
+            XMVECTOR rz = XMVectorMultiplyAdd(x, m13, XMVectorMultiplyAdd(y, m23, XMVectorMultiplyAdd(z, m33, m43)));
+
+            details::store_float3x4(results + i, rx, ry, rz);
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = transform(positions[i], matrix);
+        }
+    }
+
+
+    inline void transform_normal(_In_reads_(count) float3 const* normals, size_t count, float4x4 const& matrix, _Out_writes_(count) float3* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        XMVECTOR m11 = XMVectorReplicate(matrix.m11), m12 = XMVectorReplicate(matrix.m12), m13 = XMVectorReplicate(matrix.m13);
+        XMVECTOR m21 = XMVectorReplicate(matrix.m21), m22 = XMVectorReplicate(matrix.m22), m23 = XMVectorReplicate(matrix.m23);
+        XMVECTOR m31 = XMVectorReplicate(matrix.m31), m32 = XMVectorReplicate(matrix.m32), m33 = XMVectorReplicate(matrix.m33);
+
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            XMVECTOR x, y, z;
+            details::load_float3x4(normals + i, &x, &y, &z);
+
+            XMVECTOR rx = XMVectorMultiplyAdd(x, m11, XMVectorMultiplyAdd(y, m21, XMVectorMultiply(z, m31)));
+            XMVECTOR ry = XMVectorMultiplyAdd(x, m12, XMVectorMultiplyAdd(y, m22, XMVectorMultiply(z, m32)));
+            XMVECTOR rz = XMVectorMultiplyAdd(x, m13, XMVectorMultiplyAdd(y, m23, XMVectorMultiply(z, m33)));
+
+            details::store_float3x4(results + i, rx, ry, rz);
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = transform_normal(normals[i], matrix);
+        }
+    }
+
+
+    inline void normalize(_In_reads_(count) float3 const* values, size_t count, _Out_writes_(count) float3* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            XMVECTOR x, y, z;
+            details::load_float3x4(values + i, &x, &y, &z);
+
+            XMVECTOR length = XMVectorSqrt(XMVectorMultiplyAdd(x, x, XMVectorMultiplyAdd(y, y, XMVectorMultiply(z, z))));
+
+            details::store_float3x4(results + i, XMVectorDivide(x, length), XMVectorDivide(y, length), XMVectorDivide(z, length));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = normalize(values[i]);
+        }
+    }
+
+
+    inline void length(_In_reads_(count) float3 const* values, size_t count, _Out_writes_(count) float* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            XMVECTOR x, y, z;
+            details::load_float3x4(values + i, &x, &y, &z);
+
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(results + i), XMVectorSqrt(XMVectorMultiplyAdd(x, x, XMVectorMultiplyAdd(y, y, XMVectorMultiply(z, z)))));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = length(values[i]);
+        }
+    }
+
+
+    inline void dot(_In_reads_(count) float3 const* values1, _In_reads_(count) float3 const* values2, size_t count, _Out_writes_(count) float* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            XMVECTOR x1, y1, z1, x2, y2, z2;
+            details::load_float3x4(values1 + i, &x1, &y1, &z1);
+            details::load_float3x4(values2 + i, &x2, &y2, &z2);
+
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(results + i), XMVectorMultiplyAdd(x1, x2, XMVectorMultiplyAdd(y1, y2, XMVectorMultiply(z1, z2))));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = dot(values1[i], values2[i]);
+        }
+    }
+
+
+    inline void lerp(_In_reads_(count) float3 const* values1, _In_reads_(count) float3 const* values2, size_t count, float amount, _Out_writes_(count) float3* results)
+    {
+        size_t i = 0;
+
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        // Interpolation treats every component the same, so four float3 values fit in three registers.
+        for (; i < (count & ~size_t(3)); i += 4)
+        {
+            auto source1 = reinterpret_cast<XMFLOAT4 const*>(values1 + i);
+            auto source2 = reinterpret_cast<XMFLOAT4 const*>(values2 + i);
+            auto destination = reinterpret_cast<XMFLOAT4*>(results + i);
+
+            XMVECTOR a = XMVectorLerp(XMLoadFloat4(source1),     XMLoadFloat4(source2),     amount);
+            XMVECTOR b = XMVectorLerp(XMLoadFloat4(source1 + 1), XMLoadFloat4(source2 + 1), amount);
+            XMVECTOR c = XMVectorLerp(XMLoadFloat4(source1 + 2), XMLoadFloat4(source2 + 2), amount);
+
+            XMStoreFloat4(destination,     a);
+            XMStoreFloat4(destination + 1, b);
+            XMStoreFloat4(destination + 2, c);
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            results[i] = lerp(values1[i], values2[i], amount);
+        }
+    }
+
+
+    inline void transform(_In_reads_(count) float4 const* vectors, size_t count, float4x4 const& matrix, _Out_writes_(count) float4* results)
+    {
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        XMMATRIX m = XMLoadFloat4x4(&matrix);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            XMStoreFloat4(&results[i], XMVector4Transform(XMLoadFloat4(&vectors[i]), m));
+        }
+#else
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = transform(vectors[i], matrix);
+        }
+#endif
+    }
+
+
+    inline void normalize(_In_reads_(count) float4 const* values, size_t count, _Out_writes_(count) float4* results)
+    {
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            XMVECTOR v = XMLoadFloat4(&values[i]);
+            XMStoreFloat4(&results[i], XMVectorDivide(v, XMVector4Length(v)));
+        }
+#else
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = normalize(values[i]);
+        }
+#endif
+    }
+
+
+    inline void length(_In_reads_(count) float4 const* values, size_t count, _Out_writes_(count) float* results)
+    {
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            XMStoreFloat(&results[i], XMVector4Length(XMLoadFloat4(&values[i])));
+        }
+#else
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = length(values[i]);
+        }
+#endif
+    }
+
+
+    inline void dot(_In_reads_(count) float4 const* values1, _In_reads_(count) float4 const* values2, size_t count, _Out_writes_(count) float* results)
+    {
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            XMStoreFloat(&results[i], XMVector4Dot(XMLoadFloat4(&values1[i]), XMLoadFloat4(&values2[i])));
+        }
+#else
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = dot(values1[i], values2[i]);
+        }
+#endif
+    }
+
+
+    inline void lerp(_In_reads_(count) float4 const* values1, _In_reads_(count) float4 const* values2, size_t count, float amount, _Out_writes_(count) float4* results)
+    {
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            XMStoreFloat4(&results[i], XMVectorLerp(XMLoadFloat4(&values1[i]), XMLoadFloat4(&values2[i]), amount));
+        }
+#else
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = lerp(values1[i], values2[i], amount);
+        }
+#endif
+    }
+
+
+    inline void multiply(_In_reads_(count) float3x2 const* matrices, size_t count, float3x2 const& matrix, _Out_writes_(count) float3x2* results)
+    {
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        // Each row of the result is (row.x * first row of matrix) + (row.y * second row of matrix), plus
+        // the third row of matrix for the translation. Rows one and two of each input share a register.
+        XMVECTOR row1 = XMVectorSet(matrix.m11, matrix.m12, matrix.m11, matrix.m12);
+        XMVECTOR row2 = XMVectorSet(matrix.m21, matrix.m22, matrix.m21, matrix.m22);
+        XMVECTOR row3 = XMVectorSet(matrix.m31, matrix.m32, 0, 0);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            XMVECTOR abcd = XMLoadFloat4(reinterpret_cast<XMFLOAT4 const*>(&matrices[i].m11));
+            XMVECTOR ef = XMLoadFloat2(reinterpret_cast<XMFLOAT2 const*>(&matrices[i].m31));
+
+            XMVECTOR r12 = XMVectorMultiplyAdd(XMVectorSwizzle<0, 0, 2, 2>(abcd), row1, XMVectorMultiply(XMVectorSwizzle<1, 1, 3, 3>(abcd), row2));
+            XMVECTOR r3 = XMVectorMultiplyAdd(XMVectorSplatX(ef), row1, XMVectorMultiplyAdd(XMVectorSplatY(ef), row2, row3));
+
+            XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&results[i].m11), r12);
+            XMStoreFloat2(reinterpret_cast<XMFLOAT2*>(&results[i].m31), r3);
+        }
+#else
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = matrices[i] * matrix;
+        }
+#endif
+    }
+
+
+    inline void multiply(_In_reads_(count) float4x4 const* matrices, size_t count, float4x4 const& matrix, _Out_writes_(count) float4x4* results)
+    {
+#ifdef _WINDOWS_NUMERICS_BATCH_SIMD_
+        using namespace ::DirectX;
+
+        XMMATRIX m = XMLoadFloat4x4(&matrix);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            XMStoreFloat4x4(&results[i], XMMatrixMultiply(XMLoadFloat4x4(&matrices[i]), m));
+        }
+#else
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = matrices[i] * matrix;
+        }
+#endif
+    }
 }}}
 
 
 #undef _WINDOWS_NUMERICS_THROW_
 #undef _WINDOWS_NUMERICS_NAN_
+#undef _WINDOWS_NUMERICS_BATCH_SIMD_
 
+#ifdef _MSC_VER
 #pragma warning(pop)
+#endif
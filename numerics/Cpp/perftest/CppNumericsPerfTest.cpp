@@ -15,6 +15,8 @@
 
 float valueTheOptimizerCannotRemove = 0;
 
+std::vector<PerfTestResult> perfTestResults;
+
 
 // Measures operations that are common to all the vector, matrix and quaternion types.
 template<typename T>
@@ -295,8 +297,220 @@ void RunQuaternionTests()
 }
 
 
-int __cdecl main()
+// Compares a batch function against a loop over the equivalent single value function.
+template<typename TValue, typename TParam, typename TResult, typename TBatchOperation, typename TSingleOperation>
+void RunBatchComparisonTest(std::string const& testName, TBatchOperation const& batchOperation, TSingleOperation const& singleOperation)
+{
+    RunBatchPerfTest<TValue, TParam, TResult>(testName + " (batch)", batchOperation);
+
+    RunBatchPerfTest<TValue, TParam, TResult>(testName + " (loop)", [&](TValue const* values, TParam const* params, size_t count, TResult* results)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = singleOperation(values[i], params[i]);
+        }
+    });
+}
+
+
+// Measures the batch functions that are common to all the vector types.
+template<typename T>
+void RunCommonVectorBatchTests(std::string const& typeName)
+{
+    RunBatchComparisonTest<T, T, T>(typeName + " normalize",
+        [](T const* values, T const*, size_t count, T* results) { normalize(values, count, results); },
+        [](T const& value, T const&) { return normalize(value); });
+
+    RunBatchComparisonTest<T, T, float>(typeName + " length",
+        [](T const* values, T const*, size_t count, float* results) { length(values, count, results); },
+        [](T const& value, T const&) { return length(value); });
+
+    RunBatchComparisonTest<T, T, float>(typeName + " dot",
+        [](T const* values, T const* params, size_t count, float* results) { dot(values, params, count, results); },
+        [](T const& value, T const& param) { return dot(value, param); });
+
+    RunBatchComparisonTest<T, T, T>(typeName + " lerp",
+        [](T const* values, T const* params, size_t count, T* results) { lerp(values, params, count, 0.5f, results); },
+        [](T const& value, T const& param) { return lerp(value, param, 0.5f); });
+}
+
+
+// The batch transforms use a single matrix for the whole array, so these tests pass
+// only the first of the generated parameters to both the batch and loop versions.
+template<typename T, typename TMatrix>
+void RunBatchTransformTest(std::string const& testName)
+{
+    RunBatchPerfTest<T, TMatrix, T>(testName + " (batch)", [](T const* values, TMatrix const* params, size_t count, T* results)
+    {
+        transform(values, count, params[0], results);
+    });
+
+    RunBatchPerfTest<T, TMatrix, T>(testName + " (loop)", [](T const* values, TMatrix const* params, size_t count, T* results)
+    {
+        auto& matrix = params[0];
+
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = transform(values[i], matrix);
+        }
+    });
+}
+
+
+template<typename T, typename TMatrix>
+void RunBatchTransformNormalTest(std::string const& testName)
+{
+    RunBatchPerfTest<T, TMatrix, T>(testName + " (batch)", [](T const* values, TMatrix const* params, size_t count, T* results)
+    {
+        transform_normal(values, count, params[0], results);
+    });
+
+    RunBatchPerfTest<T, TMatrix, T>(testName + " (loop)", [](T const* values, TMatrix const* params, size_t count, T* results)
+    {
+        auto& matrix = params[0];
+
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = transform_normal(values[i], matrix);
+        }
+    });
+}
+
+
+template<typename T>
+void RunBatchMultiplyTest(std::string const& testName)
+{
+    RunBatchPerfTest<T, T, T>(testName + " (batch)", [](T const* values, T const* params, size_t count, T* results)
+    {
+        multiply(values, count, params[0], results);
+    });
+
+    RunBatchPerfTest<T, T, T>(testName + " (loop)", [](T const* values, T const* params, size_t count, T* results)
+    {
+        auto& matrix = params[0];
+
+        for (size_t i = 0; i < count; i++)
+        {
+            results[i] = values[i] * matrix;
+        }
+    });
+}
+
+
+void RunBatchTests()
+{
+    RunCommonVectorBatchTests<float2>("float2 batch");
+    RunBatchTransformTest<float2, float3x2>("float2 batch transform (float3x2)");
+    RunBatchTransformTest<float2, float4x4>("float2 batch transform (float4x4)");
+    RunBatchTransformNormalTest<float2, float3x2>("float2 batch transform_normal (float3x2)");
+    RunBatchTransformNormalTest<float2, float4x4>("float2 batch transform_normal (float4x4)");
+
+    RunCommonVectorBatchTests<float3>("float3 batch");
+    RunBatchTransformTest<float3, float4x4>("float3 batch transform (float4x4)");
+    RunBatchTransformNormalTest<float3, float4x4>("float3 batch transform_normal (float4x4)");
+
+    RunCommonVectorBatchTests<float4>("float4 batch");
+    RunBatchTransformTest<float4, float4x4>("float4 batch transform (float4x4)");
+
+    RunBatchMultiplyTest<float3x2>("float3x2 batch multiply");
+    RunBatchMultiplyTest<float4x4>("float4x4 batch multiply");
+}
+
+
+#if !defined _MSC_VER || _MSC_VER >= 1900
+
+// Compares two ways of providing a large table of transforms, as used for static scene data.
+// Without constexpr, such a table is built by a dynamic initializer when the module loads.
+// With constexpr, it is computed by the compiler, so startup only has to page it in.
+const int ConstantTableSize = 4096;
+
+typedef std::array<float3x2, ConstantTableSize> ConstantTable;
+
+
+constexpr float3x2 MakeTableEntry(int i)
+{
+    return make_float3x2_scale(1 + (i % 16) * 0.125f, float2(static_cast<float>(i % 64), static_cast<float>(i / 64))) *
+           make_float3x2_translation(i * 0.5f, i * -0.25f);
+}
+
+
+template<size_t... I>
+constexpr ConstantTable MakeConstantTable(std::index_sequence<I...>)
+{
+    return ConstantTable{ { MakeTableEntry(I)... } };
+}
+
+
+constexpr ConstantTable constantTable = MakeConstantTable(std::make_index_sequence<ConstantTableSize>());
+
+
+// Does the same work as the dynamic initializer for a non-constexpr table.
+PERFTEST_NOINLINE void InitializeTable(ConstantTable& table, int firstIndex)
+{
+    for (int i = 0; i < ConstantTableSize; i++)
+    {
+        table[i] = MakeTableEntry(firstIndex + i);
+    }
+}
+
+
+void RunConstantTableTests()
+{
+    ConstantTable table;
+
+    // Stop the compiler evaluating the dynamic version at compile time too.
+    volatile int firstIndex = 0;
+
+    RunTestPasses("float3x2 table dynamic initialization", [&]
+    {
+        auto startTime = TestClock::now();
+
+        InitializeTable(table, firstIndex);
+
+        auto endTime = TestClock::now();
+
+        EnsureNotOptimizedAway(table[ConstantTableSize - 1]);
+
+        return std::chrono::duration<double>(endTime - startTime).count();
+    });
+
+    // There is no initialization to measure for the constexpr table, so this
+    // measures the cost of reading all of it instead.
+    RunTestPasses("float3x2 table constexpr (read)", [&]
+    {
+        auto startTime = TestClock::now();
+
+        table = constantTable;
+
+        auto endTime = TestClock::now();
+
+        EnsureNotOptimizedAway(table[ConstantTableSize - 1]);
+
+        return std::chrono::duration<double>(endTime - startTime).count();
+    });
+}
+
+#endif
+
+// Usage: CppNumericsPerfTest [--json <filename>]
+// The results table is always printed. If --json is specified, it is also written to the given file.
+int main(int argc, char* argv[])
 {
+    char const* jsonFilename = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::string(argv[i]) == "--json" && i + 1 < argc)
+        {
+            jsonFilename = argv[++i];
+        }
+        else
+        {
+            printf("Usage: %s [--json <filename>]\n", argv[0]);
+            return 1;
+        }
+    }
+
     printf("name, time, deviation\n");
 
     RunFloat2Tests();
@@ -306,8 +520,26 @@ int __cdecl main()
     RunFloat4x4Tests();
     RunPlaneTests();
     RunQuaternionTests();
+    RunBatchTests();
+
+#if !defined _MSC_VER || _MSC_VER >= 1900
+    RunConstantTableTests();
+#endif
 
     printf("\nEnsureNotOptimizedAway: %f\n", valueTheOptimizerCannotRemove);
 
+    if (jsonFilename)
+    {
+        std::ofstream json(jsonFilename);
+
+        WriteResultsAsJson(json);
+
+        if (!json)
+        {
+            printf("Failed to write %s\n", jsonFilename);
+            return 1;
+        }
+    }
+
     return 0;
 }
@@ -13,6 +13,14 @@
 #pragma once
 
 
+// Stops the compiler inlining a function, so the code being measured stays separate from the test infrastructure.
+#ifdef _MSC_VER
+#define PERFTEST_NOINLINE __declspec(noinline)
+#else
+#define PERFTEST_NOINLINE __attribute__((noinline))
+#endif
+
+
 // Each test is repeated a number of times, and the results averaged to ensure stable timing.
 const int TestPasses = 100;
 
@@ -24,12 +32,33 @@ const int InnerRepetitions = 1000000;
 // enregistered) but not so big as to spill out of cache and introduce unpredictable memory latencies.
 const int ParamCount = 64;
 
+// Batch tests process arrays of this many values per call, repeated enough times to cover the same
+// total number of values as a non-batch test. The arrays still fit comfortably in the L1 cache.
+const int BatchSize = 1024;
+
+
+// Test passes are timed with the highest resolution clock that is guaranteed never to go backwards.
+typedef std::conditional<std::chrono::high_resolution_clock::is_steady,
+                         std::chrono::high_resolution_clock,
+                         std::chrono::steady_clock>::type TestClock;
+
+
+// Results are printed as each test completes, and also collected so they can be written out as JSON at the end of the run.
+struct PerfTestResult
+{
+    std::string Name;
+    double Time;
+    double DeviationPercentage;
+};
+
+extern std::vector<PerfTestResult> perfTestResults;
+
 
 // The core thing being measured: repeats a simple operation a large number of times.
 // Marked as noinline to encourage inlining of the operation lambda, and to
 // keep this as separate as possible from the surrounding infrastructure goop.
 template<typename TValue, typename TParams, typename TOperation>
-__declspec(noinline) void RunInnerLoop(TValue* value, TParams& params, TOperation const& operation)
+PERFTEST_NOINLINE void RunInnerLoop(TValue* value, TParams& params, TOperation const& operation)
 {
     for (int i = 0; i < InnerRepetitions; i++)
     {
@@ -38,6 +67,17 @@ __declspec(noinline) void RunInnerLoop(TValue* value, TParams& params, TOperatio
 }
 
 
+// Batch equivalent of RunInnerLoop: repeats an operation over arrays of values.
+template<typename TValue, typename TParam, typename TResult, typename TOperation>
+PERFTEST_NOINLINE void RunBatchInnerLoop(TValue const* values, TParam const* params, TResult* results, TOperation const& operation)
+{
+    for (int i = 0; i < InnerRepetitions / BatchSize; i++)
+    {
+        operation(values, params, BatchSize, results);
+    }
+}
+
+
 // Runs a single test pass, returning how long it took.
 template<typename TValue, typename TParam, typename TOperation>
 double RunTestPass(TOperation const& operation)
@@ -49,21 +89,47 @@ double RunTestPass(TOperation const& operation)
     auto params = MakeRandom<TParam, ParamCount>();
     
     // Run the test, and time how long it takes.
-    LARGE_INTEGER startTime;
-    QueryPerformanceCounter(&startTime);
+    auto startTime = TestClock::now();
 
     RunInnerLoop(&value, params, operation);
 
-    LARGE_INTEGER endTime;
-    QueryPerformanceCounter(&endTime);
+    auto endTime = TestClock::now();
 
     // Make sure the compiler doesn't try to optimize out our computation!
     EnsureNotOptimizedAway(value);
 
-    LARGE_INTEGER frequency;
-    QueryPerformanceFrequency(&frequency);
+    return std::chrono::duration<double>(endTime - startTime).count();
+}
+
 
-    return static_cast<double>(endTime.QuadPart - startTime.QuadPart) / frequency.QuadPart;
+// Runs a single batch test pass, returning how long it took.
+template<typename TValue, typename TParam, typename TResult, typename TOperation>
+double RunBatchTestPass(TOperation const& operation)
+{
+    // Generate random (but identical for every pass) value and parameter arrays.
+    srand(1);
+
+    std::vector<TValue> values(BatchSize);
+    std::vector<TParam> params(BatchSize);
+    std::vector<TResult> results(BatchSize);
+
+    std::generate(values.begin(), values.end(), MakeRandom<TValue>);
+    std::generate(params.begin(), params.end(), MakeRandom<TParam>);
+
+    // Run the test, and time how long it takes.
+    auto startTime = TestClock::now();
+
+    RunBatchInnerLoop(values.data(), params.data(), results.data(), operation);
+
+    auto endTime = TestClock::now();
+
+    // Make sure the compiler doesn't try to optimize out our computation!
+    for (auto& result : results)
+    {
+        EnsureNotOptimizedAway(result);
+    }
+
+    return std::chrono::duration<double>(endTime - startTime).count();
 }
 
 
@@ -93,17 +159,13 @@ double GetDeviationPercentage(T const& results)
 }
 
 
-// The main test entrypoint.
-template<typename TValue, typename TParam, typename TOperation>
-__declspec(noinline) void RunPerfTest(std::string const& testName, TOperation const& operation)
+// Repeats a test pass multiple times, and reports the results.
+template<typename TTestPass>
+void RunTestPasses(std::string const& testName, TTestPass const& testPass)
 {
-    // Repeat the test multiple times.
     std::array<double, TestPasses> results;
 
-    std::generate(results.begin(), results.end(), [&]
-    {
-        return RunTestPass<TValue, TParam>(operation);
-    });
+    std::generate(results.begin(), results.end(), testPass);
 
     // Analyze the results.
     std::sort(results.begin(), results.end());
@@ -112,4 +174,66 @@ __declspec(noinline) void RunPerfTest(std::string const& testName, TOperation co
     auto deviation = GetDeviationPercentage(results);
 
     printf("%s, %f, %f%%\n", testName.c_str(), median, deviation);
+
+    perfTestResults.push_back(PerfTestResult{ testName, median, deviation });
+}
+
+
+// The main test entrypoint.
+template<typename TValue, typename TParam, typename TOperation>
+PERFTEST_NOINLINE void RunPerfTest(std::string const& testName, TOperation const& operation)
+{
+    RunTestPasses(testName, [&]
+    {
+        return RunTestPass<TValue, TParam>(operation);
+    });
+}
+
+
+// Entrypoint for batch tests. The operation is passed arrays of values and parameters,
+// plus the count, and writes its output to an array of results.
+template<typename TValue, typename TParam, typename TResult, typename TOperation>
+PERFTEST_NOINLINE void RunBatchPerfTest(std::string const& testName, TOperation const& operation)
+{
+    RunTestPasses(testName, [&]
+    {
+        return RunBatchTestPass<TValue, TParam, TResult>(operation);
+    });
+}
+
+
+// Writes the collected results as a JSON array of { "name", "time", "deviation" } objects,
+// matching the columns of the printed table. Time is in seconds, and deviation is a percentage.
+inline void WriteResultsAsJson(std::ostream& output)
+{
+    auto escape = [](std::string const& value)
+    {
+        std::string result;
+
+        for (char c : value)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+
+            result += c;
+        }
+
+        return result;
+    };
+
+    output.precision(9);
+
+    output << "[\n";
+
+    for (size_t i = 0; i < perfTestResults.size(); i++)
+    {
+        auto& result = perfTestResults[i];
+
+        output << "  { \"name\": \"" << escape(result.Name) << "\", "
+               << "\"time\": " << result.Time << ", "
+               << "\"deviation\": " << result.DeviationPercentage << " }"
+               << (i + 1 < perfTestResults.size() ? ",\n" : "\n");
+    }
+
+    output << "]\n";
 }
@@ -18,12 +18,16 @@ using namespace Windows::Foundation::Numerics;
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <numeric>
 #include <string>
-
-#define WIN32_LEAN_AND_MEAN
-#define NOMINMAX
-#include <windows.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "EnsureNotOptimizedAway.h"
 #include "MakeRandom.h"
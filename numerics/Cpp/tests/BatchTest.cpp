@@ -0,0 +1,317 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "Helpers.h"
+
+using namespace Windows::Foundation::Numerics;
+
+namespace NumericsTests
+{
+    NUMERICS_TEST_CLASS(BatchTest)
+    {
+        NUMERICS_TEST_CLASS_INNER(BatchTest)
+
+        // The batch functions process groups of values at a time, and pass any left over
+        // to the single value functions, so these counts cover full groups as well as
+        // every possible remainder.
+        static std::vector<size_t> GetTestCounts()
+        {
+            return std::vector<size_t>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 37 };
+        }
+
+        static const size_t MaxCount = 37;
+
+        // Values are kept small, so that differences in rounding between the batch and
+        // single value functions stay within the tolerance used by Equal.
+        static float TestValue(size_t i, size_t component)
+        {
+            return static_cast<float>((i * 7 + component * 3) % 11) * 0.5f - 2.5f + static_cast<float>(i % 5) * 0.1f;
+        }
+
+        static void MakeValue(size_t i, float2* value)
+        {
+            *value = float2(TestValue(i, 0), TestValue(i, 1));
+        }
+
+        static void MakeValue(size_t i, float3* value)
+        {
+            *value = float3(TestValue(i, 0), TestValue(i, 1), TestValue(i, 2));
+        }
+
+        static void MakeValue(size_t i, float4* value)
+        {
+            *value = float4(TestValue(i, 0), TestValue(i, 1), TestValue(i, 2), TestValue(i, 3));
+        }
+
+        static void MakeValue(size_t i, float3x2* value)
+        {
+            *value = float3x2(TestValue(i, 0), TestValue(i, 1),
+                              TestValue(i, 2), TestValue(i, 3),
+                              TestValue(i, 4), TestValue(i, 5));
+        }
+
+        static void MakeValue(size_t i, float4x4* value)
+        {
+            *value = float4x4(TestValue(i, 0),  TestValue(i, 1),  TestValue(i, 2),  TestValue(i, 3),
+                              TestValue(i, 4),  TestValue(i, 5),  TestValue(i, 6),  TestValue(i, 7),
+                              TestValue(i, 8),  TestValue(i, 9),  TestValue(i, 10), TestValue(i, 11),
+                              TestValue(i, 12), TestValue(i, 13), TestValue(i, 14), TestValue(i, 15));
+        }
+
+        template<typename T>
+        static std::vector<T> MakeValues(size_t count, size_t seed = 0)
+        {
+            std::vector<T> values(count);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                MakeValue(seed + i, &values[i]);
+            }
+
+            return values;
+        }
+
+        static float3x2 GenerateTestMatrix3x2()
+        {
+            return make_float3x2_rotation(ToRadians(30.0f)) *
+                   make_float3x2_scale(2.0f, 0.5f) *
+                   make_float3x2_translation(1.5f, -2.5f);
+        }
+
+        static float4x4 GenerateTestMatrix4x4()
+        {
+            return make_float4x4_from_yaw_pitch_roll(ToRadians(30.0f), ToRadians(-20.0f), ToRadians(45.0f)) *
+                   make_float4x4_scale(1.5f, 2.0f, 0.75f) *
+                   make_float4x4_translation(1.5f, -2.5f, 0.75f);
+        }
+
+        // Runs a batch function over each test count, checking every result against the
+        // single value function, and checking that nothing past the end of the results
+        // array is written. singleFn is passed each value along with its index.
+        template<typename TValue, typename TResult, typename TBatchFn, typename TSingleFn>
+        static void VerifyBatch(TBatchFn&& batchFn, TSingleFn&& singleFn)
+        {
+            for (size_t count : GetTestCounts())
+            {
+                auto values = MakeValues<TValue>(count);
+
+                std::vector<TResult> results(count + 1);
+                memset(&results.back(), 0xCD, sizeof(TResult));
+
+                batchFn(values.data(), count, results.data());
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    Assert::IsTrue(Equal(singleFn(values[i], i), results[i]));
+                }
+
+                auto guard = reinterpret_cast<unsigned char const*>(&results.back());
+
+                for (size_t i = 0; i < sizeof(TResult); i++)
+                {
+                    Assert::IsTrue(guard[i] == 0xCD);
+                }
+            }
+        }
+
+        // As VerifyBatch, but also checks that the results array can be the same as the input.
+        template<typename TValue, typename TBatchFn, typename TSingleFn>
+        static void VerifyBatchInPlace(TBatchFn&& batchFn, TSingleFn&& singleFn)
+        {
+            VerifyBatch<TValue, TValue>(batchFn, singleFn);
+
+            for (size_t count : GetTestCounts())
+            {
+                auto values = MakeValues<TValue>(count);
+                auto original = values;
+
+                batchFn(values.data(), count, values.data());
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    Assert::IsTrue(Equal(singleFn(original[i], i), values[i]));
+                }
+            }
+        }
+
+    public:
+        TEST_METHOD(BatchFloat2TransformTest)
+        {
+            float3x2 m3x2 = GenerateTestMatrix3x2();
+            float4x4 m4x4 = GenerateTestMatrix4x4();
+
+            VerifyBatchInPlace<float2>(
+                [&](float2 const* values, size_t count, float2* results) { transform(values, count, m3x2, results); },
+                [&](float2 const& value, size_t) { return transform(value, m3x2); });
+
+            VerifyBatchInPlace<float2>(
+                [&](float2 const* values, size_t count, float2* results) { transform(values, count, m4x4, results); },
+                [&](float2 const& value, size_t) { return transform(value, m4x4); });
+        }
+
+        TEST_METHOD(BatchFloat2TransformNormalTest)
+        {
+            float3x2 m3x2 = GenerateTestMatrix3x2();
+            float4x4 m4x4 = GenerateTestMatrix4x4();
+
+            VerifyBatchInPlace<float2>(
+                [&](float2 const* values, size_t count, float2* results) { transform_normal(values, count, m3x2, results); },
+                [&](float2 const& value, size_t) { return transform_normal(value, m3x2); });
+
+            VerifyBatchInPlace<float2>(
+                [&](float2 const* values, size_t count, float2* results) { transform_normal(values, count, m4x4, results); },
+                [&](float2 const& value, size_t) { return transform_normal(value, m4x4); });
+        }
+
+        TEST_METHOD(BatchFloat2NormalizeTest)
+        {
+            VerifyBatchInPlace<float2>(
+                [](float2 const* values, size_t count, float2* results) { normalize(values, count, results); },
+                [](float2 const& value, size_t) { return normalize(value); });
+        }
+
+        TEST_METHOD(BatchFloat2LengthTest)
+        {
+            VerifyBatch<float2, float>(
+                [](float2 const* values, size_t count, float* results) { length(values, count, results); },
+                [](float2 const& value, size_t) { return length(value); });
+        }
+
+        TEST_METHOD(BatchFloat2DotTest)
+        {
+            auto others = MakeValues<float2>(MaxCount, 100);
+
+            VerifyBatch<float2, float>(
+                [&](float2 const* values, size_t count, float* results) { dot(values, others.data(), count, results); },
+                [&](float2 const& value, size_t i) { return dot(value, others[i]); });
+        }
+
+        TEST_METHOD(BatchFloat2LerpTest)
+        {
+            auto targets = MakeValues<float2>(MaxCount, 100);
+
+            VerifyBatchInPlace<float2>(
+                [&](float2 const* values, size_t count, float2* results) { lerp(values, targets.data(), count, 0.3f, results); },
+                [&](float2 const& value, size_t i) { return lerp(value, targets[i], 0.3f); });
+        }
+
+        TEST_METHOD(BatchFloat3TransformTest)
+        {
+            float4x4 m = GenerateTestMatrix4x4();
+
+            VerifyBatchInPlace<float3>(
+                [&](float3 const* values, size_t count, float3* results) { transform(values, count, m, results); },
+                [&](float3 const& value, size_t) { return transform(value, m); });
+        }
+
+        TEST_METHOD(BatchFloat3TransformNormalTest)
+        {
+            float4x4 m = GenerateTestMatrix4x4();
+
+            VerifyBatchInPlace<float3>(
+                [&](float3 const* values, size_t count, float3* results) { transform_normal(values, count, m, results); },
+                [&](float3 const& value, size_t) { return transform_normal(value, m); });
+        }
+
+        TEST_METHOD(BatchFloat3NormalizeTest)
+        {
+            VerifyBatchInPlace<float3>(
+                [](float3 const* values, size_t count, float3* results) { normalize(values, count, results); },
+                [](float3 const& value, size_t) { return normalize(value); });
+        }
+
+        TEST_METHOD(BatchFloat3LengthTest)
+        {
+            VerifyBatch<float3, float>(
+                [](float3 const* values, size_t count, float* results) { length(values, count, results); },
+                [](float3 const& value, size_t) { return length(value); });
+        }
+
+        TEST_METHOD(BatchFloat3DotTest)
+        {
+            auto others = MakeValues<float3>(MaxCount, 100);
+
+            VerifyBatch<float3, float>(
+                [&](float3 const* values, size_t count, float* results) { dot(values, others.data(), count, results); },
+                [&](float3 const& value, size_t i) { return dot(value, others[i]); });
+        }
+
+        TEST_METHOD(BatchFloat3LerpTest)
+        {
+            auto targets = MakeValues<float3>(MaxCount, 100);
+
+            VerifyBatchInPlace<float3>(
+                [&](float3 const* values, size_t count, float3* results) { lerp(values, targets.data(), count, 0.3f, results); },
+                [&](float3 const& value, size_t i) { return lerp(value, targets[i], 0.3f); });
+        }
+
+        TEST_METHOD(BatchFloat4TransformTest)
+        {
+            float4x4 m = GenerateTestMatrix4x4();
+
+            VerifyBatchInPlace<float4>(
+                [&](float4 const* values, size_t count, float4* results) { transform(values, count, m, results); },
+                [&](float4 const& value, size_t) { return transform(value, m); });
+        }
+
+        TEST_METHOD(BatchFloat4NormalizeTest)
+        {
+            VerifyBatchInPlace<float4>(
+                [](float4 const* values, size_t count, float4* results) { normalize(values, count, results); },
+                [](float4 const& value, size_t) { return normalize(value); });
+        }
+
+        TEST_METHOD(BatchFloat4LengthTest)
+        {
+            VerifyBatch<float4, float>(
+                [](float4 const* values, size_t count, float* results) { length(values, count, results); },
+                [](float4 const& value, size_t) { return length(value); });
+        }
+
+        TEST_METHOD(BatchFloat4DotTest)
+        {
+            auto others = MakeValues<float4>(MaxCount, 100);
+
+            VerifyBatch<float4, float>(
+                [&](float4 const* values, size_t count, float* results) { dot(values, others.data(), count, results); },
+                [&](float4 const& value, size_t i) { return dot(value, others[i]); });
+        }
+
+        TEST_METHOD(BatchFloat4LerpTest)
+        {
+            auto targets = MakeValues<float4>(MaxCount, 100);
+
+            VerifyBatchInPlace<float4>(
+                [&](float4 const* values, size_t count, float4* results) { lerp(values, targets.data(), count, 0.3f, results); },
+                [&](float4 const& value, size_t i) { return lerp(value, targets[i], 0.3f); });
+        }
+
+        TEST_METHOD(BatchFloat3x2MultiplyTest)
+        {
+            float3x2 m = GenerateTestMatrix3x2();
+
+            VerifyBatchInPlace<float3x2>(
+                [&](float3x2 const* values, size_t count, float3x2* results) { multiply(values, count, m, results); },
+                [&](float3x2 const& value, size_t) { return value * m; });
+        }
+
+        TEST_METHOD(BatchFloat4x4MultiplyTest)
+        {
+            float4x4 m = GenerateTestMatrix4x4();
+
+            VerifyBatchInPlace<float4x4>(
+                [&](float4x4 const* values, size_t count, float4x4* results) { multiply(values, count, m, results); },
+                [&](float4x4 const& value, size_t) { return value * m; });
+        }
+    };
+}
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "Helpers.h"
+
+using namespace Windows::Foundation::Numerics;
+
+// Constructors, common values and simple arithmetic are only constexpr with compilers that support it,
+// and not in C++/CX projection mode.
+#if !defined _MSC_VER || (_MSC_VER >= 1900 && !defined __cplusplus_winrt)
+
+namespace NumericsTests
+{
+    // Constructors.
+    static_assert(float2(1, 2).x == 1 && float2(1, 2).y == 2, "float2 constructor");
+    static_assert(float2(3) == float2(3, 3), "float2 splat constructor");
+    static_assert(float3(float2(1, 2), 3) == float3(1, 2, 3), "float3 constructor");
+    static_assert(float3(4) == float3(4, 4, 4), "float3 splat constructor");
+    static_assert(float4(float3(1, 2, 3), 4).w == 4, "float4 constructor");
+    static_assert(float4(float2(1, 2), 3, 4).z == 3, "float4 constructor");
+    static_assert(float3x2(1, 2, 3, 4, 5, 6).m31 == 5, "float3x2 constructor");
+    static_assert(float4x4(float3x2(1, 2, 3, 4, 5, 6)).m42 == 6, "float4x4 constructor");
+    static_assert(plane(float3(1, 2, 3), 4).normal == float3(1, 2, 3), "plane constructor");
+    static_assert(quaternion(float3(1, 2, 3), 4).w == 4, "quaternion constructor");
+
+    // Common values.
+    static_assert(float2::zero() == float2(0, 0), "float2::zero");
+    static_assert(float2::one() == float2(1, 1), "float2::one");
+    static_assert(float2::unit_x() + float2::unit_y() == float2::one(), "float2::unit_x/unit_y");
+    static_assert(float3::unit_x() + float3::unit_y() + float3::unit_z() == float3::one(), "float3::unit_x/unit_y/unit_z");
+    static_assert(float4::unit_w().w == 1 && float4::zero().w == 0, "float4 common values");
+    static_assert(float3x2::identity() == float3x2(1, 0, 0, 1, 0, 0), "float3x2::identity");
+    static_assert(float4x4::identity().m44 == 1 && float4x4::identity().m41 == 0, "float4x4::identity");
+    static_assert(quaternion::identity().w == 1, "quaternion::identity");
+
+    // Arithmetic.
+    static_assert(float2(1, 2) + float2(3, 4) == float2(4, 6), "float2 operator +");
+    static_assert(float2(1, 2) - float2(3, 5) == float2(-2, -3), "float2 operator -");
+    static_assert(float2(1, 2) * float2(3, 4) == float2(3, 8), "float2 operator *");
+    static_assert(2 * float2(1, 2) == float2(1, 2) * 2, "float2 operator * (scalar)");
+    static_assert(float2(4, 8) / 2 == float2(2, 4), "float2 operator / (scalar)");
+    static_assert(-float2(1, 2) == float2(-1, -2), "float2 unary operator -");
+    static_assert(float2(1, 2) != float2(1, 3), "float2 operator !=");
+    static_assert(dot(float2(1, 2), float2(3, 4)) == 11, "float2 dot");
+    static_assert(float3(1, 2, 3) * float3(4, 5, 6) - float3(1) == float3(3, 9, 17), "float3 arithmetic");
+    static_assert(dot(float3(1, 2, 3), float3(4, 5, 6)) == 32, "float3 dot");
+
+    // Matrix helpers.
+    static_assert(make_float3x2_translation(3, 4) == float3x2(1, 0, 0, 1, 3, 4), "make_float3x2_translation");
+    static_assert(make_float3x2_translation(float2(3, 4)) == make_float3x2_translation(3, 4), "make_float3x2_translation (float2)");
+    static_assert(make_float3x2_scale(2, 3) == float3x2(2, 0, 0, 3, 0, 0), "make_float3x2_scale");
+    static_assert(make_float3x2_scale(float2(2, 3)) == make_float3x2_scale(2, 3), "make_float3x2_scale (float2)");
+    static_assert(make_float3x2_scale(2) == make_float3x2_scale(2, 2), "make_float3x2_scale (uniform)");
+    static_assert(make_float3x2_scale(2, 3, float2(1, 1)) == float3x2(2, 0, 0, 3, -1, -2), "make_float3x2_scale (center)");
+    static_assert(make_float3x2_scale(float2(2, 3), float2(1, 1)) == make_float3x2_scale(2, 3, float2(1, 1)), "make_float3x2_scale (float2, center)");
+    static_assert(make_float3x2_scale(2, float2(1, 1)) == make_float3x2_scale(2, 2, float2(1, 1)), "make_float3x2_scale (uniform, center)");
+    static_assert(make_float3x2_scale(2) * make_float3x2_translation(3, 4) == float3x2(2, 0, 0, 2, 3, 4), "float3x2 operator *");
+    static_assert(make_float3x2_scale(2) + make_float3x2_scale(1) - float3x2::identity() == make_float3x2_scale(2), "float3x2 operator + and -");
+    static_assert(-float3x2::identity() == float3x2::identity() * -1, "float3x2 unary operator -");
+
+
+    NUMERICS_TEST_CLASS(ConstexprTest)
+    {
+        NUMERICS_TEST_CLASS_INNER(ConstexprTest)
+
+        static constexpr float3x2 MakeTableEntry(int i)
+        {
+            return make_float3x2_scale(1 + (i % 8) * 0.25f, float2(static_cast<float>(i), 1)) *
+                   make_float3x2_translation(i * 0.5f, i * -2.0f);
+        }
+
+    public:
+        // Values computed at compile time should match the same calculations done at runtime. The
+        // inputs are chosen so that every intermediate value is exact, regardless of evaluation order.
+        TEST_METHOD(ConstexprTableMatchesRuntimeTest)
+        {
+            static constexpr float3x2 table[] =
+            {
+                MakeTableEntry(0),  MakeTableEntry(1),  MakeTableEntry(2),  MakeTableEntry(3),
+                MakeTableEntry(4),  MakeTableEntry(5),  MakeTableEntry(6),  MakeTableEntry(7),
+                MakeTableEntry(8),  MakeTableEntry(9),  MakeTableEntry(10), MakeTableEntry(11),
+                MakeTableEntry(12), MakeTableEntry(13), MakeTableEntry(14), MakeTableEntry(15),
+            };
+
+            for (size_t i = 0; i < _countof(table); i++)
+            {
+                volatile int runtimeIndex = static_cast<int>(i);
+
+                float3x2 expected = make_float3x2_scale(1 + (runtimeIndex % 8) * 0.25f, float2(static_cast<float>(runtimeIndex), 1)) *
+                                    make_float3x2_translation(runtimeIndex * 0.5f, runtimeIndex * -2.0f);
+
+                Assert::AreEqual(expected, table[i]);
+            }
+        }
+    };
+}
+
+#endif
@@ -935,12 +935,12 @@ namespace NumericsTests
         {
             // We should be trivial, but not POD because we have constructors.
             Assert::IsTrue(std::is_trivial<float3>::value);
-            Assert::IsFalse(std::is_pod<float3>::value);
+            Assert::AreEqual(StandardTypeTraits, std::is_pod<float3>::value);
 
             // Default constructor is present and trivial.
             Assert::IsTrue(std::is_default_constructible<float3>::value);
             Assert::IsTrue(std::is_trivially_default_constructible<float3>::value);
-            Assert::IsFalse(std::is_nothrow_default_constructible<float3>::value);
+            Assert::AreEqual(StandardTypeTraits, std::is_nothrow_default_constructible<float3>::value);
 
             // Copy constructor is present and trivial.
             Assert::IsTrue(std::is_copy_constructible<float3>::value);
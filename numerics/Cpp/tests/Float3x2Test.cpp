@@ -914,12 +914,12 @@ namespace NumericsTests
         {
             // We should be trivial, but not POD because we have constructors.
             Assert::IsTrue(std::is_trivial<float3x2>::value);
-            Assert::IsFalse(std::is_pod<float3x2>::value);
+            Assert::AreEqual(StandardTypeTraits, std::is_pod<float3x2>::value);
 
             // Default constructor is present and trivial.
             Assert::IsTrue(std::is_default_constructible<float3x2>::value);
             Assert::IsTrue(std::is_trivially_default_constructible<float3x2>::value);
-            Assert::IsFalse(std::is_nothrow_default_constructible<float3x2>::value);
+            Assert::AreEqual(StandardTypeTraits, std::is_nothrow_default_constructible<float3x2>::value);
 
             // Copy constructor is present and trivial.
             Assert::IsTrue(std::is_copy_constructible<float3x2>::value);
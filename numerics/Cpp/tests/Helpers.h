@@ -25,6 +25,15 @@ using namespace Windows::Foundation::Numerics;
 
 namespace NumericsTests
 {
+    // Visual C++ doesn't count types with constructors as POD, or trivial default constructors
+    // as nothrow. GCC and Clang follow the standard, which says both are true of these types.
+#ifdef _MSC_VER
+    const bool StandardTypeTraits = false;
+#else
+    const bool StandardTypeTraits = true;
+#endif
+
+
     // Angle conversion helper.
     inline float ToRadians(float degrees)
     {
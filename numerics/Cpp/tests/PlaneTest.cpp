@@ -319,12 +319,12 @@ namespace NumericsTests
         {
             // We should be trivial, but not POD because we have constructors.
             Assert::IsTrue(std::is_trivial<plane>::value);
-            Assert::IsFalse(std::is_pod<plane>::value);
+            Assert::AreEqual(StandardTypeTraits, std::is_pod<plane>::value);
 
             // Default constructor is present and trivial.
             Assert::IsTrue(std::is_default_constructible<plane>::value);
             Assert::IsTrue(std::is_trivially_default_constructible<plane>::value);
-            Assert::IsFalse(std::is_nothrow_default_constructible<plane>::value);
+            Assert::AreEqual(StandardTypeTraits, std::is_nothrow_default_constructible<plane>::value);
 
             // Copy constructor is present and trivial.
             Assert::IsTrue(std::is_copy_constructible<plane>::value);
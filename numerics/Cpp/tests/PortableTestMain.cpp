@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+// Runs the tests registered by PortableUnitTest.h. Exits with the number of
+// failed tests, so the CMake build can run them through CTest.
+
+#include "pch.h"
+
+#include <exception>
+
+int main()
+{
+    auto& testMethods = TestRegistry::GetTestMethods();
+
+    int failedCount = 0;
+
+    for (auto& testMethod : testMethods)
+    {
+        try
+        {
+            testMethod.Run();
+        }
+        catch (AssertFailedException const& e)
+        {
+            printf("FAILED %s::%s: %ls\n", testMethod.ClassName, testMethod.MethodName, e.Message.c_str());
+            failedCount++;
+        }
+        catch (std::exception const& e)
+        {
+            printf("FAILED %s::%s: unexpected exception: %s\n", testMethod.ClassName, testMethod.MethodName, e.what());
+            failedCount++;
+        }
+    }
+
+    printf("%zu tests, %d failed\n", testMethods.size(), failedCount);
+
+    return failedCount;
+}
@@ -0,0 +1,186 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+// Minimal stand-in for the parts of the Visual Studio CppUnitTestFramework
+// that these tests use, so they can be built with GCC or Clang. Used by the
+// CMake build (see ../CMakeLists.txt) in place of CppUnitTest.h.
+
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <cwchar>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifndef _MSC_VER
+
+using std::isinf;
+using std::isnan;
+
+#define _countof(array) (sizeof(array) / sizeof((array)[0]))
+
+template<size_t N, typename... Args>
+int swprintf_s(wchar_t (&buffer)[N], wchar_t const* format, Args... args)
+{
+    return swprintf(buffer, N, format, args...);
+}
+
+#endif
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework
+{
+    namespace Details
+    {
+        template<typename T>
+        auto DefaultToString(T const& value, int) -> decltype(std::to_wstring(value))
+        {
+            return std::to_wstring(value);
+        }
+
+        template<typename T>
+        std::wstring DefaultToString(T const&, long)
+        {
+            return L"?";
+        }
+    }
+
+    // Specialized by Helpers.h for the numerics types.
+    template<typename T>
+    std::wstring ToString(T const& value)
+    {
+        return Details::DefaultToString(value, 0);
+    }
+
+    template<typename T>
+    std::wstring ToString(T* value)
+    {
+        wchar_t tmp[32];
+        swprintf_s(tmp, L"%p", static_cast<void const*>(value));
+        return tmp;
+    }
+
+
+    struct AssertFailedException
+    {
+        std::wstring Message;
+    };
+
+
+    struct Assert
+    {
+        template<typename T>
+        static void AreEqual(T const& expected, T const& actual, wchar_t const* message = nullptr)
+        {
+            if (!(expected == actual))
+            {
+                Fail(L"Expected " + ToString(expected) + L", actual " + ToString(actual), message);
+            }
+        }
+
+        static void IsTrue(bool condition, wchar_t const* message = nullptr)
+        {
+            if (!condition)
+            {
+                Fail(L"IsTrue failed", message);
+            }
+        }
+
+        static void IsFalse(bool condition, wchar_t const* message = nullptr)
+        {
+            if (condition)
+            {
+                Fail(L"IsFalse failed", message);
+            }
+        }
+
+        static void Fail(wchar_t const* message = nullptr)
+        {
+            Fail(L"Fail", message);
+        }
+
+    private:
+        static void Fail(std::wstring const& what, wchar_t const* message)
+        {
+            throw AssertFailedException{ message ? what + L": " + message : what };
+        }
+    };
+
+
+    class TestRegistry
+    {
+    public:
+        struct TestMethod
+        {
+            char const* ClassName;
+            char const* MethodName;
+            std::function<void()> Run;
+        };
+
+        static std::vector<TestMethod>& GetTestMethods()
+        {
+            static std::vector<TestMethod> testMethods;
+            return testMethods;
+        }
+    };
+
+
+    // Registers a test method before main runs. TEST_METHOD refers to
+    // Instance, which is enough to have each one defined, and so constructed.
+    template<typename Method>
+    struct TestMethodRegistration
+    {
+        static TestMethodRegistration Instance;
+
+        TestMethodRegistration()
+        {
+            TestRegistry::GetTestMethods().push_back({ Method::GetClassName(), Method::GetMethodName(), &Method::Run });
+        }
+    };
+
+    template<typename Method>
+    TestMethodRegistration<Method> TestMethodRegistration<Method>::Instance;
+
+
+    // Test classes also need a GetTestClassName method, which pch.h adds
+    // through NUMERICS_TEST_CLASS_INNER.
+    template<typename T>
+    class TestClass
+    {
+    protected:
+        typedef T TestClassType;
+    };
+}}}
+
+
+#define TEST_CLASS(className)                                                                   \
+    class className : public ::Microsoft::VisualStudio::CppUnitTestFramework::TestClass<className>
+
+#define TEST_METHOD(methodName)                                                                 \
+public:                                                                                         \
+    struct methodName##_Registration                                                            \
+    {                                                                                           \
+        static char const* GetClassName() { return TestClassType::GetTestClassName(); }         \
+        static char const* GetMethodName() { return #methodName; }                             \
+        static void Run() { TestClassType().methodName(); }                                     \
+    };                                                                                          \
+                                                                                                \
+    void methodName##_Register()                                                                \
+    {                                                                                           \
+        (void)&::Microsoft::VisualStudio::CppUnitTestFramework::                                \
+            TestMethodRegistration<methodName##_Registration>::Instance;                        \
+    }                                                                                           \
+                                                                                                \
+    void methodName()
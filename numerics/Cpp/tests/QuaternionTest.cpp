@@ -878,12 +878,12 @@ namespace NumericsTests
         {
             // We should be trivial, but not POD because we have constructors.
             Assert::IsTrue(std::is_trivial<quaternion>::value);
-            Assert::IsFalse(std::is_pod<quaternion>::value);
+            Assert::AreEqual(StandardTypeTraits, std::is_pod<quaternion>::value);
 
             // Default constructor is present and trivial.
             Assert::IsTrue(std::is_default_constructible<quaternion>::value);
             Assert::IsTrue(std::is_trivially_default_constructible<quaternion>::value);
-            Assert::IsFalse(std::is_nothrow_default_constructible<quaternion>::value);
+            Assert::AreEqual(StandardTypeTraits, std::is_nothrow_default_constructible<quaternion>::value);
 
             // Copy constructor is present and trivial.
             Assert::IsTrue(std::is_copy_constructible<quaternion>::value);
@@ -16,13 +16,25 @@
 
 #pragma warning(disable: 4505)  // "unreferenced local function"
 
+#ifdef NUMERICS_PORTABLE_TESTS
+#include "PortableUnitTest.h"
+#else
 #include <SDKDDKVer.h>
 #include <CppUnitTest.h>
+#endif
+
+#include <cstring>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 #define NUMERICS_TEST_CLASS(ClassName) TEST_CLASS(ClassName)
+
+#ifdef NUMERICS_PORTABLE_TESTS
+#define NUMERICS_TEST_CLASS_INNER(ClassName) public: static char const* GetTestClassName() { return #ClassName; } private:
+#else
 #define NUMERICS_TEST_CLASS_INNER(ClassName)
+#endif
 
 #define NUMERICS_ABI_NAMESPACE Microsoft::Graphics::Canvas::Numerics
 
@@ -34,7 +34,7 @@ struct AddFtmBase
 
 
 // Traits helper for deducing the type of the completion handler delegate,
-// when given either an IAsyncOperation<T> or an IAsyncAction.
+// when given an IAsyncOperation<T>, IAsyncOperationWithProgress<T, P> or an IAsyncAction.
 template<typename T>
 struct AsyncCompletedHandlerType { };
 
@@ -44,6 +44,12 @@ struct AsyncCompletedHandlerType<ABI::Windows::Foundation::IAsyncOperation<TResu
     typedef ABI::Windows::Foundation::IAsyncOperationCompletedHandler<TResult> Type;
 };
 
+template<typename TResult, typename TProgress>
+struct AsyncCompletedHandlerType<ABI::Windows::Foundation::IAsyncOperationWithProgress<TResult, TProgress>>
+{
+    typedef ABI::Windows::Foundation::IAsyncOperationWithProgressCompletedHandler<TResult, TProgress> Type;
+};
+
 template<>
 struct AsyncCompletedHandlerType<ABI::Windows::Foundation::IAsyncAction>
 {
@@ -51,9 +57,26 @@ struct AsyncCompletedHandlerType<ABI::Windows::Foundation::IAsyncAction>
 };
 
 
-// Common implementation code shared between AsyncOperation and AsyncAction.
+// Traits helper for deducing the type of the progress handler delegate.
+// Async types that don't report progress use Nil, as AsyncBase expects.
+template<typename T>
+struct AsyncProgressHandlerType
+{
+    typedef Microsoft::WRL::Details::Nil Type;
+};
+
+template<typename TResult, typename TProgress>
+struct AsyncProgressHandlerType<ABI::Windows::Foundation::IAsyncOperationWithProgress<TResult, TProgress>>
+{
+    typedef ABI::Windows::Foundation::IAsyncOperationProgressHandler<TResult, TProgress> Type;
+};
+
+
+// Common implementation code shared between AsyncOperation, AsyncOperationWithProgress and AsyncAction.
 template<typename T>
-class AsyncCommon : public Microsoft::WRL::RuntimeClass<Microsoft::WRL::AsyncBase<typename AsyncCompletedHandlerType<T>::Type>, T>
+class AsyncCommon : public Microsoft::WRL::RuntimeClass<
+    Microsoft::WRL::AsyncBase<typename AsyncCompletedHandlerType<T>::Type, typename AsyncProgressHandlerType<T>::Type>,
+    T>
 {
 protected:
     AsyncCommon()
@@ -285,6 +308,77 @@ protected:
 };
 
 
+// Implements the WinRT IAsyncOperationWithProgress interface.  The worker
+// function is handed a callback that it can use to report progress.
+template<typename T, typename TProgress>
+class AsyncOperationWithProgress : public AsyncCommon<ABI::Windows::Foundation::IAsyncOperationWithProgress<T*, TProgress>>,
+                                   private LifespanTracker<AsyncOperationWithProgress<T, TProgress>>
+{
+    InspectableClass(IAsyncOperationWithProgress<T*, TProgress>::z_get_rc_name_impl(), BaseTrust);
+
+    // T_abi is often the same as T*, but if T is a runtime class, T_abi will be the corresponding interface.
+    typedef typename ABI::Windows::Foundation::Internal::GetAbiType<typename AsyncCommon::IAsyncOperationWithProgress::TResult_complex>::type T_abi;
+
+    typedef ABI::Windows::Foundation::IAsyncOperationProgressHandler<T*, TProgress> ProgressHandler;
+
+    // Stores the async operation result, once available.
+    Microsoft::WRL::ComPtr<T> m_result;
+
+
+public:
+    typedef std::function<void(TProgress)> ProgressReporter;
+
+    // Runs an async operation on the threadpool.
+    AsyncOperationWithProgress(std::function<Microsoft::WRL::ComPtr<T>(ProgressReporter const&)>&& workerFunction)
+    {
+        RunOnThreadPool([=]
+        {
+            m_result = workerFunction(
+                [this](TProgress progress)
+                {
+                    this->FireProgress(progress);
+                });
+        });
+    }
+
+
+    // Gets the result of the async operation.
+    virtual HRESULT STDMETHODCALLTYPE GetResults(T_abi* results)
+    {
+        HRESULT hr = CheckValidStateForResultsCall();
+
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return m_result.CopyTo(results);
+    }
+
+
+    // Sets the progress callback.
+    virtual HRESULT STDMETHODCALLTYPE put_Progress(ProgressHandler* handler)
+    {
+        return PutOnProgress(handler);
+    }
+
+
+    // Gets the progress callback.
+    virtual HRESULT STDMETHODCALLTYPE get_Progress(ProgressHandler** handler)
+    {
+        return GetOnProgress(handler);
+    }
+
+
+protected:
+    // Close notification.
+    virtual void OnClose()
+    {
+        m_result = nullptr;
+    }
+};
+
+
 // Implements the WinRT IAsyncAction interface.
 class AsyncAction : public AsyncCommon<ABI::Windows::Foundation::IAsyncAction>,
                     private LifespanTracker<AsyncAction>
@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "utils/LockUtilities.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Device-wide cache of solid color brushes, used by drawing sessions to
+    // implement the overloads that take a color rather than a brush.
+    //
+    // Each brush is created for a single color and never has SetColor called
+    // on it, so one brush can be shared by any number of drawing sessions.
+    // The pool holds a small number of the most recently used colors, and
+    // evicts the least recently used one when it is full.
+    //
+    class SolidColorBrushPool
+    {
+        typedef std::pair<uint32_t, ComPtr<ID2D1SolidColorBrush>> Entry;
+        typedef std::list<Entry> EntryList;
+
+        std::mutex m_mutex;
+
+        size_t m_capacity;
+        EntryList m_entries;    // Most recently used first
+        std::unordered_map<uint32_t, EntryList::iterator> m_entryLookup;
+
+        uint64_t m_hitCount;
+        uint64_t m_missCount;
+
+    public:
+        static const size_t DefaultCapacity = 32;
+
+        explicit SolidColorBrushPool(size_t capacity = DefaultCapacity)
+            : m_capacity(capacity)
+            , m_hitCount(0)
+            , m_missCount(0)
+        {
+            assert(capacity > 0);
+        }
+
+        //
+        // Returns the brush for the given color, calling createFn to make a
+        // new one if it is not already in the pool.
+        //
+        template<typename FN>
+        ComPtr<ID2D1SolidColorBrush> GetBrush(ABI::Windows::UI::Color const& color, FN&& createFn)
+        {
+            auto key = GetKey(color);
+
+            Lock lock(m_mutex);
+
+            auto it = m_entryLookup.find(key);
+
+            if (it != m_entryLookup.end())
+            {
+                ++m_hitCount;
+
+                // Move to the front of the list.
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+                return it->second->second;
+            }
+
+            ++m_missCount;
+
+            ComPtr<ID2D1SolidColorBrush> brush = createFn();
+
+            if (m_entries.size() >= m_capacity)
+            {
+                m_entryLookup.erase(m_entries.back().first);
+                m_entries.pop_back();
+            }
+
+            m_entries.emplace_front(key, brush);
+            m_entryLookup[key] = m_entries.begin();
+
+            return brush;
+        }
+
+        void Clear()
+        {
+            Lock lock(m_mutex);
+
+            m_entries.clear();
+            m_entryLookup.clear();
+        }
+
+        uint64_t GetHitCount()
+        {
+            Lock lock(m_mutex);
+            return m_hitCount;
+        }
+
+        uint64_t GetMissCount()
+        {
+            Lock lock(m_mutex);
+            return m_missCount;
+        }
+
+        size_t GetBrushCount()
+        {
+            Lock lock(m_mutex);
+            return m_entries.size();
+        }
+
+    private:
+        static uint32_t GetKey(ABI::Windows::UI::Color const& color)
+        {
+            return (static_cast<uint32_t>(color.A) << 24) |
+                   (static_cast<uint32_t>(color.R) << 16) |
+                   (static_cast<uint32_t>(color.G) << 8) |
+                   (static_cast<uint32_t>(color.B));
+        }
+    };
+}}}}
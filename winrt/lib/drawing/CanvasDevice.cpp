@@ -432,6 +432,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         , m_hardwareAcceleration(hardwareAcceleration)
         , m_debugLevel(debugLevel)
         , m_dxgiDevice(dxgiDevice)
+        , m_stagingTexturePool(std::make_shared<StagingTexturePool>())
+        , m_pixelBufferPool(std::make_shared<PixelBufferPool>())
+        , m_pixelReadbackQueue(std::make_shared<PixelReadbackQueue>())
     {
         CheckInPointer(dxgiDevice);
 
@@ -546,6 +549,152 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             });
     }
 
+    IFACEMETHODIMP CanvasDevice::get_TextLayoutCacheMaximumEntryCount(int32_t* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                GetResource();  // this ensures that Close() hasn't been called
+
+                *value = static_cast<int32_t>(m_textLayoutCache.GetMaximumEntryCount());
+            });
+    }
+
+    IFACEMETHODIMP CanvasDevice::put_TextLayoutCacheMaximumEntryCount(int32_t value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                GetResource();  // this ensures that Close() hasn't been called
+
+                if (value < 0)
+                    ThrowHR(E_INVALIDARG);
+
+                m_textLayoutCache.SetLimits(value, m_textLayoutCache.GetMaximumCharacterCount());
+            });
+    }
+
+    IFACEMETHODIMP CanvasDevice::get_TextLayoutCacheMaximumCharacterCount(int32_t* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                GetResource();  // this ensures that Close() hasn't been called
+
+                *value = static_cast<int32_t>(m_textLayoutCache.GetMaximumCharacterCount());
+            });
+    }
+
+    IFACEMETHODIMP CanvasDevice::put_TextLayoutCacheMaximumCharacterCount(int32_t value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                GetResource();  // this ensures that Close() hasn't been called
+
+                if (value < 0)
+                    ThrowHR(E_INVALIDARG);
+
+                m_textLayoutCache.SetLimits(m_textLayoutCache.GetMaximumEntryCount(), value);
+            });
+    }
+
+    IFACEMETHODIMP CanvasDevice::GetTextLayoutCacheStatistics(CanvasTextLayoutCacheStatistics* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                GetResource();  // this ensures that Close() hasn't been called
+
+                value->HitCount = static_cast<int64_t>(m_textLayoutCache.GetHitCount());
+                value->MissCount = static_cast<int64_t>(m_textLayoutCache.GetMissCount());
+                value->EntryCount = static_cast<int32_t>(m_textLayoutCache.GetEntryCount());
+                value->CharacterCount = static_cast<int32_t>(m_textLayoutCache.GetCharacterCount());
+            });
+    }
+
+    IFACEMETHODIMP CanvasDevice::get_TessellationCacheMaximumByteCount(int64_t* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                GetResource();  // this ensures that Close() hasn't been called
+
+                *value = static_cast<int64_t>(m_tessellationCache.GetMaximumByteCount());
+            });
+    }
+
+    IFACEMETHODIMP CanvasDevice::put_TessellationCacheMaximumByteCount(int64_t value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                GetResource();  // this ensures that Close() hasn't been called
+
+                if (value < 0 || static_cast<uint64_t>(value) > std::numeric_limits<size_t>::max())
+                    ThrowHR(E_INVALIDARG);
+
+                m_tessellationCache.SetMaximumByteCount(static_cast<size_t>(value));
+            });
+    }
+
+    IFACEMETHODIMP CanvasDevice::GetTessellationCacheStatistics(CanvasTessellationCacheStatistics* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                GetResource();  // this ensures that Close() hasn't been called
+
+                value->HitCount = static_cast<int64_t>(m_tessellationCache.GetHitCount());
+                value->MissCount = static_cast<int64_t>(m_tessellationCache.GetMissCount());
+                value->EntryCount = static_cast<int32_t>(m_tessellationCache.GetEntryCount());
+                value->ByteCount = static_cast<int64_t>(m_tessellationCache.GetByteCount());
+            });
+    }
+
+    IFACEMETHODIMP CanvasDevice::get_MaximumPixelReadbacksInFlight(int32_t* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                GetResource();  // this ensures that Close() hasn't been called
+
+                *value = static_cast<int32_t>(m_pixelReadbackQueue->GetMaximumInFlightCount());
+            });
+    }
+
+    IFACEMETHODIMP CanvasDevice::put_MaximumPixelReadbacksInFlight(int32_t value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                GetResource();  // this ensures that Close() hasn't been called
+
+                if (value < 1)
+                    ThrowHR(E_INVALIDARG);
+
+                m_pixelReadbackQueue->SetMaximumInFlightCount(static_cast<uint32_t>(value));
+            });
+    }
+
+    IFACEMETHODIMP CanvasDevice::GetPixelReadbackStatistics(CanvasPixelReadbackStatistics* value)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(value);
+                GetResource();  // this ensures that Close() hasn't been called
+
+                *value = m_pixelReadbackQueue->GetStatistics();
+            });
+    }
+
     IFACEMETHODIMP CanvasDevice::Close()
     {
         HRESULT hr = ResourceWrapper::Close();
@@ -555,6 +704,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         m_dxgiDevice.Close();
         m_d2dResourceCreationDeviceContext.Close();
         m_primaryOutput.Reset();
+        m_solidColorBrushPool.Clear();
+        m_textLayoutCache.Clear();
+        m_tessellationCache.Clear();
+        m_deviceContextPool.Clear();
+        m_stagingTexturePool->Clear();
+        m_pixelBufferPool->Clear();
 
         return S_OK;
     }
@@ -571,6 +726,35 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         return dc;
     }
 
+    ComPtr<ID2D1DeviceContext1> CanvasDevice::AcquirePooledDeviceContext()
+    {
+        return m_deviceContextPool.Acquire(
+            [&]
+            {
+                return CreateDeviceContext();
+            });
+    }
+
+    void CanvasDevice::ReleasePooledDeviceContext(ID2D1DeviceContext1* deviceContext)
+    {
+        m_deviceContextPool.Release(deviceContext);
+    }
+
+    std::shared_ptr<StagingTexturePool> CanvasDevice::GetStagingTexturePool()
+    {
+        return m_stagingTexturePool;
+    }
+
+    std::shared_ptr<PixelBufferPool> CanvasDevice::GetPixelBufferPool()
+    {
+        return m_pixelBufferPool;
+    }
+
+    std::shared_ptr<PixelReadbackQueue> CanvasDevice::GetPixelReadbackQueue()
+    {
+        return m_pixelReadbackQueue;
+    }
+
     ComPtr<ID2D1SolidColorBrush> CanvasDevice::CreateSolidColorBrush(D2D1_COLOR_F const& color)
     {
         // TODO #802: this isn't very threadsafe - we should really have a different
@@ -583,6 +767,25 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         return brush;
     }
 
+    ComPtr<ID2D1SolidColorBrush> CanvasDevice::GetSolidColorBrush(ABI::Windows::UI::Color const& color)
+    {
+        return m_solidColorBrushPool.GetBrush(color,
+            [&]
+            {
+                return CreateSolidColorBrush(ToD2DColor(color));
+            });
+    }
+
+    TextLayoutCache* CanvasDevice::GetTextLayoutCache()
+    {
+        return &m_textLayoutCache;
+    }
+
+    Geometry::TessellationCache* CanvasDevice::GetTessellationCache()
+    {
+        return &m_tessellationCache;
+    }
+
     ComPtr<ID2D1Bitmap1> CanvasDevice::CreateBitmapFromWicResource(
         IWICBitmapSource* wicBitmapSource,
         float dpi,
@@ -678,6 +881,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             {
                 auto& dxgiDevice = m_dxgiDevice.EnsureNotClosed();
 
+                m_solidColorBrushPool.Clear();
+                m_textLayoutCache.Clear();
+                m_tessellationCache.Clear();
+                m_deviceContextPool.Clear();
+                m_stagingTexturePool->Clear();
+                m_pixelBufferPool->Clear();
+
                 dxgiDevice->Trim();
             });
     }
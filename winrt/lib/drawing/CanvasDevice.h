@@ -71,7 +71,37 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         virtual ComPtr<ID2D1DeviceContext1> CreateDeviceContext() = 0;
 
+        // Returns a device context from the device's pool, creating a new one
+        // if the pool is empty.  Once EndDraw has succeeded the caller hands
+        // it back with ReleasePooledDeviceContext.
+        virtual ComPtr<ID2D1DeviceContext1> AcquirePooledDeviceContext() = 0;
+        virtual void ReleasePooledDeviceContext(ID2D1DeviceContext1* deviceContext) = 0;
+
+        // Returns the pool of staging textures used to read and write bitmap
+        // pixels.  This may be null, in which case nothing is pooled.
+        virtual std::shared_ptr<StagingTexturePool> GetStagingTexturePool() = 0;
+
+        // Returns the pool of CPU memory that SaveAsync copies pixels into.
+        // This may be null, in which case nothing is pooled.
+        virtual std::shared_ptr<PixelBufferPool> GetPixelBufferPool() = 0;
+
+        // Returns the ring of in-flight GetPixelBytesAsync readbacks.
+        virtual std::shared_ptr<PixelReadbackQueue> GetPixelReadbackQueue() = 0;
+
         virtual ComPtr<ID2D1SolidColorBrush> CreateSolidColorBrush(D2D1_COLOR_F const& color) = 0;
+
+        // Returns a brush from the device's pool.  The caller must not change
+        // the color of the returned brush, as it may be shared.
+        virtual ComPtr<ID2D1SolidColorBrush> GetSolidColorBrush(ABI::Windows::UI::Color const& color) = 0;
+
+        // Returns the device's text layout cache, which drawing sessions
+        // should only use when it is enabled.
+        virtual TextLayoutCache* GetTextLayoutCache() = 0;
+
+        // Returns the device's tessellation cache, which geometries should
+        // only use when it is enabled.
+        virtual Geometry::TessellationCache* GetTessellationCache() = 0;
+
         virtual ComPtr<ID2D1Bitmap1> CreateBitmapFromWicResource(
             IWICBitmapSource* wicBitmapSource,
             float dpi,
@@ -175,6 +205,18 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         EventSource<DeviceLostHandlerType, InvokeModeOptions<StopOnFirstError>> m_deviceLostEventList;
 
+        SolidColorBrushPool m_solidColorBrushPool;
+        TextLayoutCache m_textLayoutCache;
+        Geometry::TessellationCache m_tessellationCache;
+        DeviceContextPool m_deviceContextPool;
+
+        // Shared with any ScopedBitmapMappedPixelAccess or BitmapPixelSnapshot
+        // that is still using one of their textures or buffers, as those can
+        // outlive the device.
+        std::shared_ptr<StagingTexturePool> m_stagingTexturePool;
+        std::shared_ptr<PixelBufferPool> m_pixelBufferPool;
+        std::shared_ptr<PixelReadbackQueue> m_pixelReadbackQueue;
+
     public:
         CanvasDevice(
             std::shared_ptr<CanvasDeviceManager> manager,
@@ -199,6 +241,24 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         IFACEMETHOD(RaiseDeviceLost)() override;
 
+        IFACEMETHOD(get_TextLayoutCacheMaximumEntryCount)(int32_t* value) override;
+        IFACEMETHOD(put_TextLayoutCacheMaximumEntryCount)(int32_t value) override;
+
+        IFACEMETHOD(get_TextLayoutCacheMaximumCharacterCount)(int32_t* value) override;
+        IFACEMETHOD(put_TextLayoutCacheMaximumCharacterCount)(int32_t value) override;
+
+        IFACEMETHOD(GetTextLayoutCacheStatistics)(CanvasTextLayoutCacheStatistics* value) override;
+
+        IFACEMETHOD(get_TessellationCacheMaximumByteCount)(int64_t* value) override;
+        IFACEMETHOD(put_TessellationCacheMaximumByteCount)(int64_t value) override;
+
+        IFACEMETHOD(GetTessellationCacheStatistics)(CanvasTessellationCacheStatistics* value) override;
+
+        IFACEMETHOD(get_MaximumPixelReadbacksInFlight)(int32_t* value) override;
+        IFACEMETHOD(put_MaximumPixelReadbacksInFlight)(int32_t value) override;
+
+        IFACEMETHOD(GetPixelReadbackStatistics)(CanvasPixelReadbackStatistics* value) override;
+
         //
         // ICanvasResourceCreator
         //
@@ -217,7 +277,15 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         virtual ComPtr<ID2D1Device1> GetD2DDevice() override;
         virtual ComPtr<ID2D1DeviceContext1> CreateDeviceContext() override;
+        virtual ComPtr<ID2D1DeviceContext1> AcquirePooledDeviceContext() override;
+        virtual void ReleasePooledDeviceContext(ID2D1DeviceContext1* deviceContext) override;
+        virtual std::shared_ptr<StagingTexturePool> GetStagingTexturePool() override;
+        virtual std::shared_ptr<PixelBufferPool> GetPixelBufferPool() override;
+        virtual std::shared_ptr<PixelReadbackQueue> GetPixelReadbackQueue() override;
         virtual ComPtr<ID2D1SolidColorBrush> CreateSolidColorBrush(D2D1_COLOR_F const& color) override;
+        virtual ComPtr<ID2D1SolidColorBrush> GetSolidColorBrush(ABI::Windows::UI::Color const& color) override;
+        virtual TextLayoutCache* GetTextLayoutCache() override;
+        virtual Geometry::TessellationCache* GetTessellationCache() override;
         virtual ComPtr<ID2D1Bitmap1> CreateBitmapFromWicResource(
             IWICBitmapSource* wicBitmapSource,
             float dpi,
@@ -299,6 +367,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         //
         HRESULT GetDeviceRemovedErrorCode();
 
+        SolidColorBrushPool& GetSolidColorBrushPool() { return m_solidColorBrushPool; }
+        DeviceContextPool& GetDeviceContextPool() { return m_deviceContextPool; }
+
     private:
         template<typename FN>
         ComPtr<IDXGISwapChain1> CreateSwapChain(
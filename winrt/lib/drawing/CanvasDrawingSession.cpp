@@ -13,6 +13,7 @@
 #include "pch.h"
 
 #include "CanvasActiveLayer.h"
+#include "CanvasSpriteBatch.h"
 #include "text/CanvasTextFormat.h"
 #include "utils/TemporaryTransform.h"
 
@@ -35,7 +36,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
-    static D2D1_SIZE_F GetBitmapSize(D2D1_UNIT_MODE unitMode, ID2D1Bitmap* bitmap)
+    D2D1_SIZE_F GetBitmapSize(D2D1_UNIT_MODE unitMode, ID2D1Bitmap* bitmap)
     {
         switch (unitMode)
         {
@@ -55,6 +56,28 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
     
 
+    D2D1_COMPOSITE_MODE GetCompositeModeFromPrimitiveBlend(D2D1_PRIMITIVE_BLEND primitiveBlend)
+    {
+        switch (primitiveBlend)
+        {
+        case D2D1_PRIMITIVE_BLEND_SOURCE_OVER:
+            return D2D1_COMPOSITE_MODE_SOURCE_OVER;
+                
+        case D2D1_PRIMITIVE_BLEND_COPY:
+            return D2D1_COMPOSITE_MODE_SOURCE_COPY;
+                
+        case D2D1_PRIMITIVE_BLEND_ADD:
+            return D2D1_COMPOSITE_MODE_PLUS;
+                
+        case D2D1_PRIMITIVE_BLEND_MIN:
+            ThrowHR(E_FAIL, HStringReference(Strings::DrawImageMinBlendNotSupported).Get());
+                
+        default:
+            ThrowHR(E_UNEXPECTED);
+        }
+    }
+
+
     //
     // This drawing session adapter is used when wrapping an existing
     // ID2D1DeviceContext.  In this wrapper, interop, case we don't want
@@ -132,7 +155,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         : ResourceWrapper(manager, deviceContext)
         , m_owner(owner)
         , m_adapter(adapter)
+        , m_solidColorBrushColor{}
         , m_nextLayerId(0)
+        , m_activeSpriteBatchCount(0)
     {
         CheckInPointer(adapter.get());
     }
@@ -159,6 +184,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 if (!m_activeLayerIds.empty())
                     ThrowHR(E_FAIL, HStringReference(Strings::DidNotPopLayer).Get());
 
+                if (m_activeSpriteBatchCount != 0)
+                    ThrowHR(E_FAIL, HStringReference(Strings::DidNotCloseSpriteBatch).Get());
+
                 if (m_adapter)
                 {
                     // Arrange it so that m_adapter will always get
@@ -574,28 +602,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             }
         }
 
-        // When using a DrawImage overload that does not take an explicit
-        // composite mode parameter, we try to match the current device context
-        // primitive blend setting.
         D2D1_COMPOSITE_MODE GetCompositeModeFromPrimitiveBlend()
         {
-            switch (m_deviceContext->GetPrimitiveBlend())
-            {
-            case D2D1_PRIMITIVE_BLEND_SOURCE_OVER:
-                return D2D1_COMPOSITE_MODE_SOURCE_OVER;
-                
-            case D2D1_PRIMITIVE_BLEND_COPY:
-                return D2D1_COMPOSITE_MODE_SOURCE_COPY;
-                
-            case D2D1_PRIMITIVE_BLEND_ADD:
-                return D2D1_COMPOSITE_MODE_PLUS;
-                
-            case D2D1_PRIMITIVE_BLEND_MIN:
-                ThrowHR(E_FAIL, HStringReference(Strings::DrawImageMinBlendNotSupported).Get());
-                
-            default:
-                ThrowHR(E_UNEXPECTED);
-            }
+            return Canvas::GetCompositeModeFromPrimitiveBlend(m_deviceContext->GetPrimitiveBlend());
         }
     
         // Although there are some ID2D1DeviceContext::DrawBitmap methods that
@@ -2462,30 +2471,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         ID2D1Brush* brush,
         ICanvasTextFormat* format)
     {
-        auto& deviceContext = GetResource();
-        CheckInPointer(brush);
-
         if (!format)
         {
             format = GetDefaultTextFormat();
         }
 
-        ComPtr<ICanvasTextFormatInternal> formatInternal;
-        ThrowIfFailed(format->QueryInterface(formatInternal.GetAddressOf()));
-
-        uint32_t textLength;
-        auto textBuffer = WindowsGetStringRawBuffer(text, &textLength);
-        ThrowIfNullPointer(textBuffer, E_INVALIDARG);
-
-        auto d2dRect = ToD2DRect(rect);
-
-        deviceContext->DrawText(
-            textBuffer,
-            textLength,
-            formatInternal->GetRealizedTextFormat().Get(),
-            &d2dRect,
-            brush,
-            static_cast<D2D1_DRAW_TEXT_OPTIONS>(formatInternal->GetDrawTextOptions()));
+        DrawTextImpl(text, rect, brush, format, false);
     }
 
 
@@ -2501,25 +2492,98 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         }
 
         // When drawing using just a point we specify a zero sized rectangle and
-        // disable word wrapping.
+        // disable word wrapping.  The format provides a separate no-wrap copy
+        // of itself for this, so we never need to modify the caller's format.
         Rect rect{ point.X, point.Y, 0, 0 };
 
-        //
-        // TODO #802: there's a thread-safety implication since we're modifying state
-        // on something that _may_ be being used on another thread.
-        //
-        CanvasWordWrapping oldWordWrapping{};
-        ThrowIfFailed(format->get_WordWrapping(&oldWordWrapping));
+        DrawTextImpl(text, rect, brush, format, true);
+    }
 
-        ThrowIfFailed(format->put_WordWrapping(CanvasWordWrapping::NoWrap));
 
-        auto restoreWordWrapping = MakeScopeWarden(
-            [&]
-            {
-                format->put_WordWrapping(oldWordWrapping);
-            });
+    void CanvasDrawingSession::DrawTextImpl(
+        HSTRING text,
+        Rect const& rect,
+        ID2D1Brush* brush,
+        ICanvasTextFormat* format,
+        bool disableWordWrapping)
+    {
+        auto& deviceContext = GetResource();
+        CheckInPointer(brush);
+
+        auto formatInternal = As<ICanvasTextFormatInternal>(format);
+
+        auto dwriteFormat = disableWordWrapping
+            ? formatInternal->GetRealizedNoWrapTextFormat()
+            : formatInternal->GetRealizedTextFormat();
 
-        DrawTextAtRectImpl(text, rect, brush, format);
+        auto options = static_cast<D2D1_DRAW_TEXT_OPTIONS>(formatInternal->GetDrawTextOptions());
+
+        uint32_t textLength;
+        auto textBuffer = WindowsGetStringRawBuffer(text, &textLength);
+        ThrowIfNullPointer(textBuffer, E_INVALIDARG);
+
+        auto textLayoutCache = GetTextLayoutCache();
+
+        if (textLayoutCache && rect.Width >= 0 && rect.Height >= 0)
+        {
+            //
+            // This is what ID2D1RenderTarget::DrawText does internally,
+            // except that the layout can be reused the next time the same
+            // text is drawn.
+            //
+            auto textLayout = textLayoutCache->GetLayout(
+                textBuffer,
+                textLength,
+                dwriteFormat.Get(),
+                formatInternal->GetChangeCount(),
+                rect.Width,
+                rect.Height,
+                options,
+                [&]
+                {
+                    ComPtr<IDWriteTextLayout> newTextLayout;
+                    ThrowIfFailed(formatInternal->GetDWriteFactory()->CreateTextLayout(
+                        textBuffer,
+                        textLength,
+                        dwriteFormat.Get(),
+                        rect.Width,
+                        rect.Height,
+                        &newTextLayout));
+                    return newTextLayout;
+                });
+
+            deviceContext->DrawTextLayout(
+                D2D1_POINT_2F{ rect.X, rect.Y },
+                textLayout.Get(),
+                brush,
+                options);
+        }
+        else
+        {
+            auto d2dRect = ToD2DRect(rect);
+
+            deviceContext->DrawText(
+                textBuffer,
+                textLength,
+                dwriteFormat.Get(),
+                &d2dRect,
+                brush,
+                options);
+        }
+    }
+
+
+    TextLayoutCache* CanvasDrawingSession::GetTextLayoutCache()
+    {
+        if (!m_owner)
+            return nullptr;
+
+        auto textLayoutCache = As<ICanvasDeviceInternal>(m_owner)->GetTextLayoutCache();
+
+        if (!textLayoutCache || !textLayoutCache->IsEnabled())
+            return nullptr;
+
+        return textLayoutCache;
     }
 
 
@@ -3223,17 +3287,46 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
+    static bool IsSameColor(Color const& a, Color const& b)
+    {
+        return a.A == b.A &&
+               a.R == b.R &&
+               a.G == b.G &&
+               a.B == b.B;
+    }
+
     ID2D1SolidColorBrush* CanvasDrawingSession::GetColorBrush(Color const& color)
     {
-        if (m_solidColorBrush)
+        if (m_owner)
         {
-            m_solidColorBrush->SetColor(ToD2DColor(color));
+            // Brushes from the device pool are shared between drawing
+            // sessions, so their color must never be changed.  Remembering
+            // the most recent one saves a pool lookup when several things
+            // are drawn in the same color.
+            if (!m_solidColorBrush || !IsSameColor(color, m_solidColorBrushColor))
+            {
+                m_solidColorBrush = As<ICanvasDeviceInternal>(m_owner)->GetSolidColorBrush(color);
+                m_solidColorBrushColor = color;
+            }
         }
         else
         {
-            // TODO #802: pool and reuse this brush along with the device context?
-            auto& deviceContext = GetResource();
-            ThrowIfFailed(deviceContext->CreateSolidColorBrush(ToD2DColor(color), &m_solidColorBrush));
+            // Interop drawing sessions don't have a device to pool brushes
+            // on, so they keep reusing a single brush of their own.  The
+            // color is recorded here too, as get_Device can give this
+            // session an owner part way through, after which the brush is
+            // only reused if it still matches.
+            if (m_solidColorBrush)
+            {
+                m_solidColorBrush->SetColor(ToD2DColor(color));
+            }
+            else
+            {
+                auto& deviceContext = GetResource();
+                ThrowIfFailed(deviceContext->CreateSolidColorBrush(ToD2DColor(color), &m_solidColorBrush));
+            }
+
+            m_solidColorBrushColor = color;
         }
 
         return m_solidColorBrush.Get();
@@ -3653,5 +3746,88 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
 
+    //
+    // CreateSpriteBatch
+    //
+
+    IFACEMETHODIMP CanvasDrawingSession::CreateSpriteBatch(
+        ICanvasSpriteBatch** spriteBatch)
+    {
+        return CreateSpriteBatchImpl(CanvasSpriteSortMode::None, CanvasImageInterpolation::Linear, spriteBatch);
+    }
+
+    IFACEMETHODIMP CanvasDrawingSession::CreateSpriteBatchWithSortMode(
+        CanvasSpriteSortMode sortMode,
+        ICanvasSpriteBatch** spriteBatch)
+    {
+        return CreateSpriteBatchImpl(sortMode, CanvasImageInterpolation::Linear, spriteBatch);
+    }
+
+    IFACEMETHODIMP CanvasDrawingSession::CreateSpriteBatchWithSortModeAndInterpolation(
+        CanvasSpriteSortMode sortMode,
+        CanvasImageInterpolation interpolation,
+        ICanvasSpriteBatch** spriteBatch)
+    {
+        return CreateSpriteBatchImpl(sortMode, interpolation, spriteBatch);
+    }
+
+    HRESULT CanvasDrawingSession::CreateSpriteBatchImpl(
+        CanvasSpriteSortMode sortMode,
+        CanvasImageInterpolation interpolation,
+        ICanvasSpriteBatch** spriteBatch)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckAndClearOutPointer(spriteBatch);
+
+                GetResource();
+
+                switch (interpolation)
+                {
+                case CanvasImageInterpolation::NearestNeighbor:
+                case CanvasImageInterpolation::Linear:
+                    break;
+
+                default:
+                    // Sprites are drawn with DrawBitmap, which only
+                    // supports the two basic interpolation modes.
+                    ThrowHR(E_INVALIDARG);
+                }
+
+                // The sprites are drawn when the batch is closed, provided
+                // the drawing session is still around at that point.
+                WeakRef weakSelf = AsWeak(this);
+
+                auto batch = Make<CanvasSpriteBatch>(
+                    sortMode,
+                    interpolation,
+                    [weakSelf](CanvasSpriteBatch* batch) mutable
+                    {
+                        auto strongSelf = LockWeakRef<ICanvasDrawingSession>(weakSelf);
+                        auto self = static_cast<CanvasDrawingSession*>(strongSelf.Get());
+
+                        if (self)
+                            self->EndSpriteBatch(batch);
+                    });
+
+                CheckMakeResult(batch);
+
+                ++m_activeSpriteBatchCount;
+
+                ThrowIfFailed(batch.CopyTo(spriteBatch));
+            });
+    }
+
+    void CanvasDrawingSession::EndSpriteBatch(CanvasSpriteBatch* spriteBatch)
+    {
+        assert(m_activeSpriteBatchCount > 0);
+
+        --m_activeSpriteBatchCount;
+
+        spriteBatch->DrawTo(GetResource().Get());
+    }
+
+
     ActivatableStaticOnlyFactory(CanvasDrawingSessionFactory);
 }}}}
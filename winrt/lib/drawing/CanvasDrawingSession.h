@@ -28,6 +28,14 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
     class CanvasDrawingSessionManager;
     class CanvasDrawingSession;
+    class CanvasSpriteBatch;
+
+    D2D1_SIZE_F GetBitmapSize(D2D1_UNIT_MODE unitMode, ID2D1Bitmap* bitmap);
+
+    // When using a DrawImage overload that does not take an explicit
+    // composite mode parameter, we try to match the current device context
+    // primitive blend setting.
+    D2D1_COMPOSITE_MODE GetCompositeModeFromPrimitiveBlend(D2D1_PRIMITIVE_BLEND primitiveBlend);
 
     struct CanvasDrawingSessionTraits
     {
@@ -46,11 +54,14 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         std::shared_ptr<ICanvasDrawingSessionAdapter> m_adapter;
         ComPtr<ID2D1SolidColorBrush> m_solidColorBrush;
+        ABI::Windows::UI::Color m_solidColorBrushColor;
         ComPtr<ICanvasTextFormat> m_defaultTextFormat;
 
         std::vector<int> m_activeLayerIds;
         int m_nextLayerId;
 
+        int m_activeSpriteBatchCount;
+
         //
         // Contract:
         //     Drawing sessions created conventionally initialize this member.
@@ -1202,6 +1213,22 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             CanvasLayerOptions options,
             ICanvasActiveLayer** layer) override;
 
+        //
+        // CreateSpriteBatch
+        //
+
+        IFACEMETHOD(CreateSpriteBatch)(
+            ICanvasSpriteBatch** spriteBatch) override;
+
+        IFACEMETHOD(CreateSpriteBatchWithSortMode)(
+            CanvasSpriteSortMode sortMode,
+            ICanvasSpriteBatch** spriteBatch) override;
+
+        IFACEMETHOD(CreateSpriteBatchWithSortModeAndInterpolation)(
+            CanvasSpriteSortMode sortMode,
+            CanvasImageInterpolation interpolation,
+            ICanvasSpriteBatch** spriteBatch) override;
+
         //
         // ICanvasResourceCreator
         //
@@ -1275,8 +1302,19 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ID2D1Brush* brush,
             ICanvasTextFormat* format);
 
+        void DrawTextImpl(
+            HSTRING text,
+            Rect const& rect,
+            ID2D1Brush* brush,
+            ICanvasTextFormat* format,
+            bool disableWordWrapping);
+
         ICanvasTextFormat* GetDefaultTextFormat();
 
+        // Returns null if this session has no owning device, or the device's
+        // text layout cache is not enabled.
+        TextLayoutCache* GetTextLayoutCache();
+
         void DrawGeometryImpl(
             ICanvasGeometry* geometry,
             ID2D1Brush* brush,
@@ -1323,6 +1361,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ICanvasActiveLayer** layer);
 
         void PopLayer(int layerId, bool isAxisAlignedClip);
+
+        HRESULT CreateSpriteBatchImpl(
+            CanvasSpriteSortMode sortMode,
+            CanvasImageInterpolation interpolation,
+            ICanvasSpriteBatch** spriteBatch);
+
+        void EndSpriteBatch(CanvasSpriteBatch* spriteBatch);
     };
 
 
@@ -1387,4 +1432,39 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ThrowIfFailed(m_d2dDeviceContext->EndDraw());
         }
     };
+
+
+    //
+    // Drawing session adapter for a device context that came from a
+    // CanvasDevice's device context pool.  The device context goes back to
+    // the pool once drawing has ended successfully; if EndDraw fails (eg.
+    // because the device was lost) it is not reused.
+    //
+    class PooledCanvasDrawingSessionAdapter : public ICanvasDrawingSessionAdapter,
+                                              private LifespanTracker<PooledCanvasDrawingSessionAdapter>
+    {
+        ComPtr<ICanvasDeviceInternal> m_device;
+        ComPtr<ID2D1DeviceContext1> m_d2dDeviceContext;
+
+    public:
+        PooledCanvasDrawingSessionAdapter(ICanvasDeviceInternal* device, ID2D1DeviceContext1* d2dDeviceContext)
+            : m_device(device)
+            , m_d2dDeviceContext(d2dDeviceContext)
+        {
+            d2dDeviceContext->BeginDraw();
+        }
+
+        virtual D2D1_POINT_2F GetRenderingSurfaceOffset() override
+        {
+            return D2D1::Point2F(0, 0);
+        }
+
+        virtual void EndDraw() override
+        {
+            ThrowIfFailed(m_d2dDeviceContext->EndDraw());
+
+            auto deviceContext = std::move(m_d2dDeviceContext);
+            m_device->ReleasePooledDeviceContext(deviceContext.Get());
+        }
+    };
 }}}}
@@ -0,0 +1,639 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "CanvasSpriteBatch.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ABI::Windows::UI;
+
+    static D2D1_COLOR_F const WhiteTint{ 1, 1, 1, 1 };
+
+    static bool IsTinted(D2D1_COLOR_F const& tint)
+    {
+        // Alpha alone can be applied with DrawBitmap's opacity parameter.
+        return tint.r != 1.0f || tint.g != 1.0f || tint.b != 1.0f;
+    }
+
+    static bool operator==(D2D1_COLOR_F const& a, D2D1_COLOR_F const& b)
+    {
+        return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+    }
+
+    static D2D1_MATRIX_4X4_F ToPerspectiveTransform(D2D1_MATRIX_3X2_F const& m)
+    {
+        return D2D1::Matrix4x4F(
+            m._11, m._12, 0, 0,
+            m._21, m._22, 0, 0,
+            0,     0,     1, 0,
+            m._31, m._32, 0, 1);
+    }
+
+
+    //
+    // Draws sprites whose tint has a color component, which DrawBitmap
+    // cannot do.  A single ColorMatrix effect is shared by every tinted
+    // sprite in the batch.
+    //
+    class TintedSpriteDrawer
+    {
+        ID2D1DeviceContext1* m_deviceContext;
+        D2D1_INTERPOLATION_MODE m_interpolation;
+
+        ComPtr<ID2D1Effect> m_effect;
+        ComPtr<ID2D1Image> m_effectOutput;
+        D2D1_COMPOSITE_MODE m_compositeMode;
+
+        // The ColorMatrix effect's input for each bitmap in the batch,
+        // created the first time a tinted sprite uses that bitmap.
+        std::vector<ComPtr<ID2D1Effect>> m_dpiCompensatedInputs;
+
+        uint32_t m_currentBitmapIndex;
+        D2D1_COLOR_F m_currentTint;
+
+        D2D1::Matrix3x2F m_originalTransform;
+        bool m_isTransformModified;
+
+    public:
+        TintedSpriteDrawer(ID2D1DeviceContext1* deviceContext, D2D1_INTERPOLATION_MODE interpolation, size_t bitmapCount)
+            : m_deviceContext(deviceContext)
+            , m_interpolation(interpolation)
+            , m_compositeMode(D2D1_COMPOSITE_MODE_SOURCE_OVER)
+            , m_dpiCompensatedInputs(bitmapCount)
+            , m_currentBitmapIndex(UINT32_MAX)
+            , m_currentTint(WhiteTint)
+            , m_isTransformModified(false)
+        {
+        }
+
+        void Draw(
+            uint32_t bitmapIndex,
+            ID2D1Bitmap* bitmap,
+            D2D1_RECT_F const& destinationRect,
+            D2D1_RECT_F const* sourceRect,
+            D2D1_MATRIX_3X2_F const* transform,
+            D2D1_COLOR_F const& tint,
+            D2D1_UNIT_MODE unitMode)
+        {
+            EnsureEffect();
+
+            if (bitmapIndex != m_currentBitmapIndex)
+            {
+                m_effect->SetInputEffect(0, GetDpiCompensatedInput(bitmapIndex, bitmap));
+                m_currentBitmapIndex = bitmapIndex;
+            }
+
+            if (!(tint == m_currentTint))
+            {
+                D2D1_MATRIX_5X4_F tintMatrix = D2D1::Matrix5x4F(
+                    tint.r, 0,      0,      0,
+                    0,      tint.g, 0,      0,
+                    0,      0,      tint.b, 0,
+                    0,      0,      0,      tint.a,
+                    0,      0,      0,      0);
+
+                ThrowIfFailed(m_effect->SetValue(D2D1_COLORMATRIX_PROP_COLOR_MATRIX, tintMatrix));
+                m_currentTint = tint;
+            }
+
+            D2D1_RECT_F d2dSourceRect;
+
+            if (sourceRect)
+            {
+                d2dSourceRect = *sourceRect;
+            }
+            else
+            {
+                auto size = GetBitmapSize(unitMode, bitmap);
+                d2dSourceRect = D2D1_RECT_F{ 0, 0, size.width, size.height };
+            }
+
+            float sourceWidth  = d2dSourceRect.right - d2dSourceRect.left;
+            float sourceHeight = d2dSourceRect.bottom - d2dSourceRect.top;
+
+            if (sourceWidth == 0.0f || sourceHeight == 0.0f)
+            {
+                // Consistent with DrawImage, there is nothing useful to draw.
+                return;
+            }
+
+            auto spriteTransform =
+                D2D1::Matrix3x2F::Scale((destinationRect.right - destinationRect.left) / sourceWidth,
+                                        (destinationRect.bottom - destinationRect.top) / sourceHeight) *
+                D2D1::Matrix3x2F::Translation(destinationRect.left, destinationRect.top);
+
+            if (transform)
+                spriteTransform = spriteTransform * *D2D1::Matrix3x2F::ReinterpretBaseType(transform);
+
+            m_deviceContext->SetTransform(spriteTransform * m_originalTransform);
+            m_isTransformModified = true;
+
+            auto d2dOffset = D2D1_POINT_2F{ 0, 0 };
+            m_deviceContext->DrawImage(m_effectOutput.Get(), &d2dOffset, &d2dSourceRect, m_interpolation, m_compositeMode);
+        }
+
+        // Puts back the transform that was set before the first tinted
+        // sprite, ready for an untinted sprite or the end of the batch.
+        void RestoreTransform()
+        {
+            if (!m_isTransformModified)
+                return;
+
+            m_deviceContext->SetTransform(m_originalTransform);
+            m_isTransformModified = false;
+        }
+
+    private:
+        void EnsureEffect()
+        {
+            if (m_effect)
+                return;
+
+            ThrowIfFailed(m_deviceContext->CreateEffect(CLSID_D2D1ColorMatrix, &m_effect));
+            m_effect->GetOutput(&m_effectOutput);
+
+            m_compositeMode = GetCompositeModeFromPrimitiveBlend(m_deviceContext->GetPrimitiveBlend());
+
+            m_deviceContext->GetTransform(&m_originalTransform);
+        }
+
+        // Equivalent to D2D1::SetDpiCompensatedEffectInput, except that the
+        // DpiCompensation effect is kept rather than recreated each time the
+        // bitmap changes.
+        ID2D1Effect* GetDpiCompensatedInput(uint32_t bitmapIndex, ID2D1Bitmap* bitmap)
+        {
+            auto& input = m_dpiCompensatedInputs[bitmapIndex];
+
+            if (!input)
+            {
+                ThrowIfFailed(m_deviceContext->CreateEffect(CLSID_D2D1DpiCompensation, &input));
+
+                input->SetInput(0, bitmap);
+
+                float dpiX, dpiY;
+                bitmap->GetDpi(&dpiX, &dpiY);
+
+                ThrowIfFailed(input->SetValue(D2D1_DPICOMPENSATION_PROP_INPUT_DPI, D2D1::Point2F(dpiX, dpiY)));
+            }
+
+            return input.Get();
+        }
+    };
+
+
+    CanvasSpriteBatch::CanvasSpriteBatch(
+        CanvasSpriteSortMode sortMode,
+        CanvasImageInterpolation interpolation,
+        std::function<void(CanvasSpriteBatch*)>&& closeAction)
+        : m_closeAction(std::move(closeAction))
+        , m_sortMode(sortMode)
+        , m_interpolation(static_cast<D2D1_INTERPOLATION_MODE>(interpolation))
+    {
+    }
+
+
+    CanvasSpriteBatch::~CanvasSpriteBatch()
+    {
+        // Ignore any errors when closing during destruction
+        (void)Close();
+    }
+
+
+    IFACEMETHODIMP CanvasSpriteBatch::Close()
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                if (m_closeAction)
+                {
+                    // Arrange it so that the batch is always marked as
+                    // closed, even if drawing it throws.
+                    auto closeAction = std::move(m_closeAction);
+                    m_closeAction = nullptr;
+
+                    closeAction(this);
+                }
+
+                m_sprites.clear();
+                m_bitmapIndices.clear();
+                m_d2dBitmaps.clear();
+                m_canvasBitmaps.clear();
+            });
+    }
+
+
+    void CanvasSpriteBatch::DrawTo(ID2D1DeviceContext1* deviceContext)
+    {
+        if (m_sprites.empty())
+            return;
+
+        if (m_sortMode == CanvasSpriteSortMode::Bitmap)
+        {
+            // Stable, so sprites that share a bitmap keep their relative order.
+            std::stable_sort(m_sprites.begin(), m_sprites.end(),
+                [](Sprite const& a, Sprite const& b)
+                {
+                    return a.BitmapIndex < b.BitmapIndex;
+                });
+        }
+
+        auto unitMode = deviceContext->GetUnitMode();
+
+#if WINVER > 0x0603
+        auto deviceContext3 = MaybeAs<ID2D1DeviceContext3>(deviceContext);
+
+        if (deviceContext3 && TryDrawWithSpriteBatch(deviceContext3.Get(), unitMode))
+            return;
+#endif
+
+        DrawIndividually(deviceContext, unitMode);
+    }
+
+
+    D2D1_RECT_F CanvasSpriteBatch::GetDestinationRect(Sprite const& sprite, D2D1_UNIT_MODE unitMode)
+    {
+        auto destinationRect = sprite.DestinationRect;
+
+        if (!sprite.HasDestinationSize)
+        {
+            // Same size logic as DrawImage: an explicit source rectangle
+            // determines the size, otherwise we use the whole bitmap.
+            D2D1_SIZE_F size;
+
+            if (sprite.HasSourceRect)
+                size = D2D1_SIZE_F{ sprite.SourceRect.right - sprite.SourceRect.left, sprite.SourceRect.bottom - sprite.SourceRect.top };
+            else
+                size = GetBitmapSize(unitMode, m_d2dBitmaps[sprite.BitmapIndex].Get());
+
+            destinationRect.right = destinationRect.left + size.width;
+            destinationRect.bottom = destinationRect.top + size.height;
+        }
+
+        return destinationRect;
+    }
+
+
+#if WINVER > 0x0603
+
+    //
+    // ID2D1SpriteBatch takes source rectangles in whole pixels, whereas ours
+    // are in the device context's units.  Returns false if the rectangle
+    // does not land on pixel boundaries.
+    //
+    static bool TryGetPixelSourceRect(
+        D2D1_RECT_F const& sourceRect,
+        ID2D1Bitmap* bitmap,
+        D2D1_UNIT_MODE unitMode,
+        D2D1_RECT_U* pixelSourceRect)
+    {
+        float scaleX = 1;
+        float scaleY = 1;
+
+        if (unitMode == D2D1_UNIT_MODE_DIPS)
+        {
+            float dpiX, dpiY;
+            bitmap->GetDpi(&dpiX, &dpiY);
+
+            scaleX = dpiX / DEFAULT_DPI;
+            scaleY = dpiY / DEFAULT_DPI;
+        }
+
+        float const edges[] =
+        {
+            sourceRect.left * scaleX,
+            sourceRect.top * scaleY,
+            sourceRect.right * scaleX,
+            sourceRect.bottom * scaleY
+        };
+
+        uint32_t pixelEdges[4];
+
+        for (int i = 0; i < 4; i++)
+        {
+            float rounded = floorf(edges[i] + 0.5f);
+
+            if (rounded < 0 || fabsf(edges[i] - rounded) > 0.001f)
+                return false;
+
+            pixelEdges[i] = static_cast<uint32_t>(rounded);
+        }
+
+        if (pixelEdges[2] < pixelEdges[0] || pixelEdges[3] < pixelEdges[1])
+            return false;
+
+        *pixelSourceRect = D2D1_RECT_U{ pixelEdges[0], pixelEdges[1], pixelEdges[2], pixelEdges[3] };
+        return true;
+    }
+
+
+    //
+    // Adds every sprite to a single ID2D1SpriteBatch, then draws it with one
+    // DrawSpriteBatch call per run of sprites that share a bitmap.  With
+    // CanvasSpriteSortMode::Bitmap that is one call per distinct bitmap.
+    // Tints and transforms are per-sprite data, so need no further calls.
+    //
+    // Returns false, having drawn nothing, if any sprite's source rectangle
+    // cannot be expressed in whole pixels.
+    //
+    bool CanvasSpriteBatch::TryDrawWithSpriteBatch(ID2D1DeviceContext3* deviceContext, D2D1_UNIT_MODE unitMode)
+    {
+        auto spriteCount = static_cast<uint32_t>(m_sprites.size());
+
+        std::vector<D2D1_RECT_F> destinationRects(spriteCount);
+        std::vector<D2D1_RECT_U> sourceRects(spriteCount);
+        std::vector<D2D1_COLOR_F> colors(spriteCount);
+        std::vector<D2D1_MATRIX_3X2_F> transforms(spriteCount);
+
+        for (uint32_t i = 0; i < spriteCount; i++)
+        {
+            auto const& sprite = m_sprites[i];
+            auto d2dBitmap = m_d2dBitmaps[sprite.BitmapIndex].Get();
+
+            if (sprite.HasSourceRect)
+            {
+                if (!TryGetPixelSourceRect(sprite.SourceRect, d2dBitmap, unitMode, &sourceRects[i]))
+                    return false;
+            }
+            else
+            {
+                auto pixelSize = d2dBitmap->GetPixelSize();
+                sourceRects[i] = D2D1_RECT_U{ 0, 0, pixelSize.width, pixelSize.height };
+            }
+
+            destinationRects[i] = GetDestinationRect(sprite, unitMode);
+            colors[i] = sprite.Tint;
+            transforms[i] = sprite.HasTransform ? sprite.Transform : D2D1::Matrix3x2F::Identity();
+        }
+
+        ComPtr<ID2D1SpriteBatch> spriteBatch;
+        ThrowIfFailed(deviceContext->CreateSpriteBatch(&spriteBatch));
+        ThrowIfFailed(spriteBatch->AddSprites(spriteCount, destinationRects.data(), sourceRects.data(), colors.data(), transforms.data()));
+
+        // DrawSpriteBatch requires aliased antialiasing.
+        auto previousAntialiasMode = deviceContext->GetAntialiasMode();
+
+        if (previousAntialiasMode != D2D1_ANTIALIAS_MODE_ALIASED)
+            deviceContext->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+
+        auto restoreAntialiasModeWarden = MakeScopeWarden(
+            [&]
+            {
+                if (previousAntialiasMode != D2D1_ANTIALIAS_MODE_ALIASED)
+                    deviceContext->SetAntialiasMode(previousAntialiasMode);
+            });
+
+        // CanvasSpriteBatch only accepts the two interpolation modes that
+        // D2D1_BITMAP_INTERPOLATION_MODE has, and their values match.
+        auto interpolation = static_cast<D2D1_BITMAP_INTERPOLATION_MODE>(m_interpolation);
+
+        uint32_t runStart = 0;
+
+        while (runStart < spriteCount)
+        {
+            auto bitmapIndex = m_sprites[runStart].BitmapIndex;
+
+            uint32_t runEnd = runStart + 1;
+
+            while (runEnd < spriteCount && m_sprites[runEnd].BitmapIndex == bitmapIndex)
+                ++runEnd;
+
+            deviceContext->DrawSpriteBatch(
+                spriteBatch.Get(),
+                runStart,
+                runEnd - runStart,
+                m_d2dBitmaps[bitmapIndex].Get(),
+                interpolation,
+                D2D1_SPRITE_OPTIONS_NONE);
+
+            runStart = runEnd;
+        }
+
+        return true;
+    }
+
+#endif
+
+
+    //
+    // Used when ID2D1SpriteBatch is not available.  Untinted sprites are
+    // drawn with one DrawBitmap each, and tinted ones through a shared
+    // ColorMatrix effect.
+    //
+    void CanvasSpriteBatch::DrawIndividually(ID2D1DeviceContext1* deviceContext, D2D1_UNIT_MODE unitMode)
+    {
+        TintedSpriteDrawer tintedSpriteDrawer(deviceContext, m_interpolation, m_d2dBitmaps.size());
+
+        auto restoreTransformWarden = MakeScopeWarden([&] { tintedSpriteDrawer.RestoreTransform(); });
+
+        for (auto const& sprite : m_sprites)
+        {
+            auto d2dBitmap = m_d2dBitmaps[sprite.BitmapIndex].Get();
+            auto sourceRect = sprite.HasSourceRect ? &sprite.SourceRect : nullptr;
+            auto transform = sprite.HasTransform ? &sprite.Transform : nullptr;
+
+            auto destinationRect = GetDestinationRect(sprite, unitMode);
+
+            if (IsTinted(sprite.Tint))
+            {
+                tintedSpriteDrawer.Draw(sprite.BitmapIndex, d2dBitmap, destinationRect, sourceRect, transform, sprite.Tint, unitMode);
+            }
+            else
+            {
+                tintedSpriteDrawer.RestoreTransform();
+
+                D2D1_MATRIX_4X4_F perspective;
+
+                if (transform)
+                    perspective = ToPerspectiveTransform(*transform);
+
+                deviceContext->DrawBitmap(
+                    d2dBitmap,
+                    &destinationRect,
+                    sprite.Tint.a,
+                    m_interpolation,
+                    sourceRect,
+                    transform ? &perspective : nullptr);
+            }
+        }
+    }
+
+
+    IFACEMETHODIMP CanvasSpriteBatch::DrawToRect(
+        ICanvasBitmap* bitmap,
+        Rect destinationRectangle)
+    {
+        return DrawImpl(bitmap, &destinationRectangle, nullptr, nullptr, nullptr, nullptr);
+    }
+
+    IFACEMETHODIMP CanvasSpriteBatch::DrawAtOffset(
+        ICanvasBitmap* bitmap,
+        Vector2 offset)
+    {
+        return DrawImpl(bitmap, nullptr, &offset, nullptr, nullptr, nullptr);
+    }
+
+    IFACEMETHODIMP CanvasSpriteBatch::DrawWithTransform(
+        ICanvasBitmap* bitmap,
+        Matrix3x2 transform)
+    {
+        return DrawImpl(bitmap, nullptr, nullptr, &transform, nullptr, nullptr);
+    }
+
+    IFACEMETHODIMP CanvasSpriteBatch::DrawToRectWithTint(
+        ICanvasBitmap* bitmap,
+        Rect destinationRectangle,
+        Color tint)
+    {
+        return DrawImpl(bitmap, &destinationRectangle, nullptr, nullptr, nullptr, &tint);
+    }
+
+    IFACEMETHODIMP CanvasSpriteBatch::DrawAtOffsetWithTint(
+        ICanvasBitmap* bitmap,
+        Vector2 offset,
+        Color tint)
+    {
+        return DrawImpl(bitmap, nullptr, &offset, nullptr, nullptr, &tint);
+    }
+
+    IFACEMETHODIMP CanvasSpriteBatch::DrawWithTransformAndTint(
+        ICanvasBitmap* bitmap,
+        Matrix3x2 transform,
+        Color tint)
+    {
+        return DrawImpl(bitmap, nullptr, nullptr, &transform, nullptr, &tint);
+    }
+
+    IFACEMETHODIMP CanvasSpriteBatch::DrawFromSpriteSheetToRect(
+        ICanvasBitmap* bitmap,
+        Rect destinationRectangle,
+        Rect sourceRectangle)
+    {
+        return DrawImpl(bitmap, &destinationRectangle, nullptr, nullptr, &sourceRectangle, nullptr);
+    }
+
+    IFACEMETHODIMP CanvasSpriteBatch::DrawFromSpriteSheetAtOffset(
+        ICanvasBitmap* bitmap,
+        Vector2 offset,
+        Rect sourceRectangle)
+    {
+        return DrawImpl(bitmap, nullptr, &offset, nullptr, &sourceRectangle, nullptr);
+    }
+
+    IFACEMETHODIMP CanvasSpriteBatch::DrawFromSpriteSheetWithTransform(
+        ICanvasBitmap* bitmap,
+        Matrix3x2 transform,
+        Rect sourceRectangle)
+    {
+        return DrawImpl(bitmap, nullptr, nullptr, &transform, &sourceRectangle, nullptr);
+    }
+
+    IFACEMETHODIMP CanvasSpriteBatch::DrawFromSpriteSheetToRectWithTint(
+        ICanvasBitmap* bitmap,
+        Rect destinationRectangle,
+        Rect sourceRectangle,
+        Color tint)
+    {
+        return DrawImpl(bitmap, &destinationRectangle, nullptr, nullptr, &sourceRectangle, &tint);
+    }
+
+    IFACEMETHODIMP CanvasSpriteBatch::DrawFromSpriteSheetAtOffsetWithTint(
+        ICanvasBitmap* bitmap,
+        Vector2 offset,
+        Rect sourceRectangle,
+        Color tint)
+    {
+        return DrawImpl(bitmap, nullptr, &offset, nullptr, &sourceRectangle, &tint);
+    }
+
+    IFACEMETHODIMP CanvasSpriteBatch::DrawFromSpriteSheetWithTransformAndTint(
+        ICanvasBitmap* bitmap,
+        Matrix3x2 transform,
+        Rect sourceRectangle,
+        Color tint)
+    {
+        return DrawImpl(bitmap, nullptr, nullptr, &transform, &sourceRectangle, &tint);
+    }
+
+
+    HRESULT CanvasSpriteBatch::DrawImpl(
+        ICanvasBitmap* bitmap,
+        Rect const* destinationRectangle,
+        Vector2 const* offset,
+        Matrix3x2 const* transform,
+        Rect const* sourceRectangle,
+        Color const* tint)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                ThrowIfClosed();
+                CheckInPointer(bitmap);
+
+                Sprite sprite{};
+
+                sprite.BitmapIndex = GetBitmapIndex(bitmap);
+
+                if (destinationRectangle)
+                {
+                    sprite.DestinationRect = ToD2DRect(*destinationRectangle);
+                    sprite.HasDestinationSize = true;
+                }
+                else if (offset)
+                {
+                    sprite.DestinationRect.left = offset->X;
+                    sprite.DestinationRect.top = offset->Y;
+                }
+
+                if (transform)
+                {
+                    sprite.Transform = *ReinterpretAs<D2D1_MATRIX_3X2_F const*>(transform);
+                    sprite.HasTransform = true;
+                }
+
+                if (sourceRectangle)
+                {
+                    sprite.SourceRect = ToD2DRect(*sourceRectangle);
+                    sprite.HasSourceRect = true;
+                }
+
+                sprite.Tint = tint ? ToD2DColor(*tint) : WhiteTint;
+
+                m_sprites.push_back(sprite);
+            });
+    }
+
+
+    uint32_t CanvasSpriteBatch::GetBitmapIndex(ICanvasBitmap* bitmap)
+    {
+        auto it = m_bitmapIndices.find(bitmap);
+
+        if (it != m_bitmapIndices.end())
+            return it->second;
+
+        auto index = static_cast<uint32_t>(m_d2dBitmaps.size());
+
+        m_d2dBitmaps.push_back(As<ICanvasBitmapInternal>(bitmap)->GetD2DBitmap());
+        m_canvasBitmaps.push_back(bitmap);
+        m_bitmapIndices.insert(std::make_pair(bitmap, index));
+
+        return index;
+    }
+
+
+    void CanvasSpriteBatch::ThrowIfClosed()
+    {
+        if (!m_closeAction)
+            ThrowHR(RO_E_CLOSED);
+    }
+}}}}
@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ABI::Microsoft::Graphics::Canvas::Numerics;
+    using namespace ABI::Windows::Foundation;
+
+    //
+    // CanvasSpriteBatch records bitmap draws into a flat array, and only
+    // issues them to the device context when it is closed.
+    //
+    // Each distinct CanvasBitmap is resolved to its ID2D1Bitmap once, when it
+    // is first added to the batch, and sprites refer to it by index.  This
+    // means that flushing the batch does not need to QueryInterface, take an
+    // exception boundary, or re-read device context state for every sprite.
+    //
+    // When the device context supports ID2D1DeviceContext3 (Windows 10), the
+    // whole batch goes into one ID2D1SpriteBatch, which is drawn with one
+    // DrawSpriteBatch call per run of sprites that share a bitmap.
+    // CanvasSpriteSortMode::Bitmap orders the sprites so there is one such
+    // run per distinct bitmap.
+    //
+    // Otherwise, or if a source rectangle does not fall on whole pixels,
+    // each sprite is drawn with its own DrawBitmap.  Per-sprite transforms
+    // are passed through DrawBitmap's perspective transform parameter.
+    // Tinted sprites need an effect, which is reused for the whole batch and
+    // only has its input and color changed when these differ from the
+    // previous sprite.
+    //
+    class CanvasSpriteBatch : public RuntimeClass<ICanvasSpriteBatch, IClosable>,
+                              private LifespanTracker<CanvasSpriteBatch>
+    {
+        InspectableClass(RuntimeClass_Microsoft_Graphics_Canvas_CanvasSpriteBatch, BaseTrust);
+
+        struct Sprite
+        {
+            uint32_t BitmapIndex;
+            D2D1_RECT_F DestinationRect;    // If !HasDestinationSize, only left/top are used
+            D2D1_RECT_F SourceRect;
+            D2D1_COLOR_F Tint;
+            D2D1_MATRIX_3X2_F Transform;
+            bool HasDestinationSize;
+            bool HasSourceRect;
+            bool HasTransform;
+        };
+
+        std::function<void(CanvasSpriteBatch*)> m_closeAction;
+
+        CanvasSpriteSortMode m_sortMode;
+        D2D1_INTERPOLATION_MODE m_interpolation;
+
+        std::vector<Sprite> m_sprites;
+
+        // Bitmaps are kept alive by the batch until it is closed, so the
+        // ICanvasBitmap pointers used as lookup keys remain valid.
+        std::vector<ComPtr<ICanvasBitmap>> m_canvasBitmaps;
+        std::vector<ComPtr<ID2D1Bitmap1>> m_d2dBitmaps;
+        std::map<ICanvasBitmap*, uint32_t> m_bitmapIndices;
+
+    public:
+        CanvasSpriteBatch(
+            CanvasSpriteSortMode sortMode,
+            CanvasImageInterpolation interpolation,
+            std::function<void(CanvasSpriteBatch*)>&& closeAction);
+
+        virtual ~CanvasSpriteBatch();
+
+        // Called by CanvasDrawingSession when the batch is closed.
+        void DrawTo(ID2D1DeviceContext1* deviceContext);
+
+        size_t GetSpriteCount() const { return m_sprites.size(); }
+        size_t GetBitmapCount() const { return m_d2dBitmaps.size(); }
+
+        //
+        // IClosable
+        //
+
+        IFACEMETHOD(Close)() override;
+
+        //
+        // ICanvasSpriteBatch
+        //
+
+        IFACEMETHOD(DrawToRect)(
+            ICanvasBitmap* bitmap,
+            Rect destinationRectangle) override;
+
+        IFACEMETHOD(DrawAtOffset)(
+            ICanvasBitmap* bitmap,
+            Vector2 offset) override;
+
+        IFACEMETHOD(DrawWithTransform)(
+            ICanvasBitmap* bitmap,
+            Matrix3x2 transform) override;
+
+        IFACEMETHOD(DrawToRectWithTint)(
+            ICanvasBitmap* bitmap,
+            Rect destinationRectangle,
+            ABI::Windows::UI::Color tint) override;
+
+        IFACEMETHOD(DrawAtOffsetWithTint)(
+            ICanvasBitmap* bitmap,
+            Vector2 offset,
+            ABI::Windows::UI::Color tint) override;
+
+        IFACEMETHOD(DrawWithTransformAndTint)(
+            ICanvasBitmap* bitmap,
+            Matrix3x2 transform,
+            ABI::Windows::UI::Color tint) override;
+
+        IFACEMETHOD(DrawFromSpriteSheetToRect)(
+            ICanvasBitmap* bitmap,
+            Rect destinationRectangle,
+            Rect sourceRectangle) override;
+
+        IFACEMETHOD(DrawFromSpriteSheetAtOffset)(
+            ICanvasBitmap* bitmap,
+            Vector2 offset,
+            Rect sourceRectangle) override;
+
+        IFACEMETHOD(DrawFromSpriteSheetWithTransform)(
+            ICanvasBitmap* bitmap,
+            Matrix3x2 transform,
+            Rect sourceRectangle) override;
+
+        IFACEMETHOD(DrawFromSpriteSheetToRectWithTint)(
+            ICanvasBitmap* bitmap,
+            Rect destinationRectangle,
+            Rect sourceRectangle,
+            ABI::Windows::UI::Color tint) override;
+
+        IFACEMETHOD(DrawFromSpriteSheetAtOffsetWithTint)(
+            ICanvasBitmap* bitmap,
+            Vector2 offset,
+            Rect sourceRectangle,
+            ABI::Windows::UI::Color tint) override;
+
+        IFACEMETHOD(DrawFromSpriteSheetWithTransformAndTint)(
+            ICanvasBitmap* bitmap,
+            Matrix3x2 transform,
+            Rect sourceRectangle,
+            ABI::Windows::UI::Color tint) override;
+
+    private:
+        HRESULT DrawImpl(
+            ICanvasBitmap* bitmap,
+            Rect const* destinationRectangle,
+            Vector2 const* offset,
+            Matrix3x2 const* transform,
+            Rect const* sourceRectangle,
+            ABI::Windows::UI::Color const* tint);
+
+        uint32_t GetBitmapIndex(ICanvasBitmap* bitmap);
+
+        D2D1_RECT_F GetDestinationRect(Sprite const& sprite, D2D1_UNIT_MODE unitMode);
+
+#if WINVER > 0x0603
+        bool TryDrawWithSpriteBatch(ID2D1DeviceContext3* deviceContext, D2D1_UNIT_MODE unitMode);
+#endif
+
+        void DrawIndividually(ID2D1DeviceContext1* deviceContext, D2D1_UNIT_MODE unitMode);
+
+        void ThrowIfClosed();
+    };
+}}}}
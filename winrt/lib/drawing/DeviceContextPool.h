@@ -0,0 +1,160 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Device-wide pool of device contexts, used by drawing sessions over
+    // render targets and command lists so that opening a drawing session
+    // doesn't have to create a new ID2D1DeviceContext each time.
+    //
+    // The pool is a fixed number of slots, each holding either nothing or a
+    // reference to an idle device context.  Acquire and Release only ever
+    // swap pointers in and out of the slots, so they never block each
+    // other.  If the pool is empty Acquire creates a new device context, and
+    // if it is full Release lets the device context go.
+    //
+    // Device contexts are reset to D2D's defaults as they are released, so
+    // nothing set by one drawing session (including anything an interop
+    // caller set on the native device context) can leak into the next.
+    // D2D doesn't document the default rendering controls, so these are read
+    // from the first device context the pool creates.
+    //
+    class DeviceContextPool
+    {
+    public:
+        static const size_t Capacity = 8;
+
+    private:
+        std::array<std::atomic<ID2D1DeviceContext1*>, Capacity> m_slots;
+
+        std::once_flag m_defaultRenderingControlsRead;
+        D2D1_RENDERING_CONTROLS m_defaultRenderingControls;
+
+    public:
+        DeviceContextPool()
+            : m_defaultRenderingControls{}
+        {
+            for (auto& slot : m_slots)
+                slot.store(nullptr, std::memory_order_relaxed);
+        }
+
+        ~DeviceContextPool()
+        {
+            Clear();
+        }
+
+        DeviceContextPool(DeviceContextPool const&) = delete;
+        DeviceContextPool& operator=(DeviceContextPool const&) = delete;
+
+        //
+        // Returns an idle device context from the pool, calling createFn to
+        // make a new one if there aren't any.
+        //
+        template<typename FN>
+        ComPtr<ID2D1DeviceContext1> Acquire(FN&& createFn)
+        {
+            for (auto& slot : m_slots)
+            {
+                if (!slot.load(std::memory_order_relaxed))
+                    continue;
+
+                auto deviceContext = slot.exchange(nullptr, std::memory_order_acquire);
+
+                if (deviceContext)
+                {
+                    ComPtr<ID2D1DeviceContext1> result;
+                    result.Attach(deviceContext);
+                    return result;
+                }
+            }
+
+            ComPtr<ID2D1DeviceContext1> deviceContext = createFn();
+
+            std::call_once(m_defaultRenderingControlsRead,
+                [&]
+                {
+                    deviceContext->GetRenderingControls(&m_defaultRenderingControls);
+                });
+
+            return deviceContext;
+        }
+
+        //
+        // Resets deviceContext and returns it to the pool.  The caller must
+        // have acquired it from this pool, finished drawing with it (ie.
+        // EndDraw has succeeded) and must not use it again.
+        //
+        void Release(ID2D1DeviceContext1* deviceContext)
+        {
+            assert(deviceContext);
+
+            ResetState(deviceContext);
+
+            // Take the pool's reference before publishing the pointer, since
+            // another thread may acquire (and release) it straight away.
+            deviceContext->AddRef();
+
+            for (auto& slot : m_slots)
+            {
+                ID2D1DeviceContext1* expected = nullptr;
+
+                if (slot.compare_exchange_strong(expected, deviceContext, std::memory_order_release, std::memory_order_relaxed))
+                    return;
+            }
+
+            deviceContext->Release();
+        }
+
+        void Clear()
+        {
+            for (auto& slot : m_slots)
+            {
+                auto deviceContext = slot.exchange(nullptr, std::memory_order_acquire);
+
+                if (deviceContext)
+                    deviceContext->Release();
+            }
+        }
+
+        // Only an estimate if other threads are using the pool.
+        size_t GetPooledCount()
+        {
+            size_t count = 0;
+
+            for (auto& slot : m_slots)
+            {
+                if (slot.load(std::memory_order_relaxed))
+                    ++count;
+            }
+
+            return count;
+        }
+
+    private:
+        void ResetState(ID2D1DeviceContext1* deviceContext)
+        {
+            deviceContext->SetTarget(nullptr);
+            deviceContext->SetDpi(DEFAULT_DPI, DEFAULT_DPI);
+            deviceContext->SetTransform(D2D1::Matrix3x2F::Identity());
+            deviceContext->SetAntialiasMode(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
+            deviceContext->SetTextAntialiasMode(D2D1_TEXT_ANTIALIAS_MODE_DEFAULT);
+            deviceContext->SetPrimitiveBlend(D2D1_PRIMITIVE_BLEND_SOURCE_OVER);
+            deviceContext->SetUnitMode(D2D1_UNIT_MODE_DIPS);
+            deviceContext->SetTextRenderingParams(nullptr);
+            deviceContext->SetTags(0, 0);
+            deviceContext->SetRenderingControls(&m_defaultRenderingControls);
+        }
+    };
+}}}}
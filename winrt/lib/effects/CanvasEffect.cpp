@@ -16,12 +16,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
 {
     CanvasEffect::CanvasEffect(IID effectId, unsigned int propertiesSize, unsigned int sourcesSize, bool isSourcesSizeFixed)
         : m_effectId(effectId)
-        , m_propertiesChanged(false)
+        , m_anyPropertiesDirty(false)
         , m_realizationId(0)
         , m_insideGetImage(false)
         , m_closed(false)
     {
         m_properties.resize(propertiesSize);
+        m_dirtyProperties.resize(propertiesSize);
 
         m_sources = Make<Vector<IGraphicsEffectSource*>>(sourcesSize, isSourcesSizeFixed);
         CheckMakeResult(m_sources);
@@ -122,8 +123,14 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         m_insideGetImage = true;
         auto clearFlagWarden = MakeScopeWarden([&] { m_insideGetImage = false; });
 
-        // Update ID2D1Image with the latest property values if a change is detected
-        if (wasRecreated || m_propertiesChanged)
+        // A newly created D2D effect needs every property value, otherwise
+        // only the properties that have changed since last time are set.
+        if (wasRecreated)
+        {
+            MarkAllPropertiesDirty();
+        }
+
+        if (m_anyPropertiesDirty)
         {
             SetD2DProperties();
         }
@@ -228,7 +235,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
                 if (index >= m_properties.size())
                     ThrowHR(E_BOUNDS);
 
-                ThrowIfFailed(m_properties[index].CopyTo(value));
+                auto propertyValue = BoxProperty(m_propertyValueFactory.Get(), m_properties[index]);
+
+                *value = propertyValue.Detach();
             });
     }
 
@@ -371,59 +380,51 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         m_sources->SetChanged(false);
     }
 
+    void CanvasEffect::MarkAllPropertiesDirty()
+    {
+        m_dirtyProperties.assign(m_properties.size(), true);
+        m_anyPropertiesDirty = true;
+    }
+
     void CanvasEffect::SetD2DProperties()
     {
         for (unsigned i = 0; i < m_properties.size(); ++i)
         {
-            auto& propertyValue = m_properties[i];
+            if (!m_dirtyProperties[i])
+                continue;
+
+            auto& property = m_properties[i];
 
-            if (!propertyValue)
+            HRESULT hr;
+
+            switch (property.Type)
+            {
+            case PropertyType_Empty:
             {
                 WinStringBuilder message;
                 message.Format(Strings::EffectNullProperty, i);
                 ThrowHR(E_POINTER, message.Get());
             }
-
-            PropertyType propertyType;
-            ThrowIfFailed(propertyValue->get_Type(&propertyType));
-
-            HRESULT hr;
-
-            switch (propertyType)
-            {
             case PropertyType_Boolean:
-            {
-                boolean value;
-                ThrowIfFailed(propertyValue->GetBoolean(&value));
-                hr = m_resource->SetValue(i, static_cast<BOOL>(value));
+                hr = m_resource->SetValue(i, static_cast<BOOL>(property.BooleanValue));
                 break;
-            }
+
             case PropertyType_Int32:
-            {
-                INT32 value;
-                ThrowIfFailed(propertyValue->GetInt32(&value));
-                hr = m_resource->SetValue(i, value);
+                hr = m_resource->SetValue(i, property.Int32Value);
                 break;
-            }
+
             case PropertyType_UInt32:
-            {
-                UINT32 value;
-                ThrowIfFailed(propertyValue->GetUInt32(&value));
-                hr = m_resource->SetValue(i, value);
+                hr = m_resource->SetValue(i, property.UInt32Value);
                 break;
-            }
+
             case PropertyType_Single:
-            {
-                float value;
-                ThrowIfFailed(propertyValue->GetSingle(&value));
-                hr = m_resource->SetValue(i, value);
+                hr = m_resource->SetValue(i, property.SingleValue);
                 break;
-            }
+
             case PropertyType_SingleArray:
             {
-                ComArray<float> value;
-                ThrowIfFailed(propertyValue->GetSingleArray(value.GetAddressOfSize(), value.GetAddressOfData()));
-                hr = m_resource->SetValue(i, reinterpret_cast<BYTE*>(value.GetData()), value.GetSize() * sizeof(float));
+                auto& array = property.SingleArrayValue;
+                hr = m_resource->SetValue(i, reinterpret_cast<BYTE const*>(array.data()), static_cast<UINT32>(array.size() * sizeof(float)));
                 break;
             }
             default:
@@ -444,9 +445,50 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
                     ThrowHR(hr);
                 }
             }
+
+            m_dirtyProperties[i] = false;
+        }
+
+        m_anyPropertiesDirty = false;
+    }
+
+    ComPtr<IPropertyValue> CanvasEffect::BoxProperty(IPropertyValueStatics* factory, EffectPropertyValue const& property)
+    {
+        ComPtr<IPropertyValue> propertyValue;
+
+        switch (property.Type)
+        {
+        case PropertyType_Empty:
+            break;
+
+        case PropertyType_Boolean:
+            ThrowIfFailed(factory->CreateBoolean(property.BooleanValue, &propertyValue));
+            break;
+
+        case PropertyType_Int32:
+            ThrowIfFailed(factory->CreateInt32(property.Int32Value, &propertyValue));
+            break;
+
+        case PropertyType_UInt32:
+            ThrowIfFailed(factory->CreateUInt32(property.UInt32Value, &propertyValue));
+            break;
+
+        case PropertyType_Single:
+            ThrowIfFailed(factory->CreateSingle(property.SingleValue, &propertyValue));
+            break;
+
+        case PropertyType_SingleArray:
+        {
+            auto& array = property.SingleArrayValue;
+            ThrowIfFailed(factory->CreateSingleArray(static_cast<UINT32>(array.size()), const_cast<float*>(array.data()), &propertyValue));
+            break;
+        }
+        default:
+            assert(false);
+            ThrowHR(E_UNEXPECTED);
         }
 
-        m_propertiesChanged = false;
+        return propertyValue;
     }
 
     void CanvasEffect::ThrowIfClosed()
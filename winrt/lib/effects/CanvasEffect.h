@@ -55,8 +55,37 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
 
         IID m_effectId;
 
-        std::vector<ComPtr<IPropertyValue>> m_properties;
-        bool m_propertiesChanged;
+        //
+        // Property values are stored unboxed, in the form they will be passed
+        // to ID2D1Effect::SetValue.  Each one has its own dirty flag, so when
+        // a single property changes only that value is pushed to D2D.
+        //
+        struct EffectPropertyValue
+        {
+            PropertyType Type;      // PropertyType_Empty if the property has not been set
+
+            union
+            {
+                boolean BooleanValue;
+                int32_t Int32Value;
+                uint32_t UInt32Value;
+                float SingleValue;
+            };
+
+            // Used by PropertyType_SingleArray.  The capacity is retained
+            // when the value changes, so animating a vector or matrix
+            // property does not allocate.
+            std::vector<float> SingleArrayValue;
+
+            EffectPropertyValue()
+                : Type(PropertyType_Empty)
+                , UInt32Value(0)
+            { }
+        };
+
+        std::vector<EffectPropertyValue> m_properties;
+        std::vector<bool> m_dirtyProperties;
+        bool m_anyPropertiesDirty;
 
         ComPtr<Vector<IGraphicsEffectSource*>> m_sources;
 
@@ -147,8 +176,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         {
             assert(index < m_properties.size());
 
-            m_properties[index] = PropertyTypeConverter<TBoxed, TPublic>::Box(m_propertyValueFactory.Get(), value);
-            m_propertiesChanged = true;
+            if (PropertyTypeConverter<TBoxed, TPublic>::Store(m_properties[index], value))
+            {
+                MarkPropertyDirty(index);
+            }
         }
 
         template<typename TBoxed, typename TPublic>
@@ -158,7 +189,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
 
             CheckInPointer(value);
 
-            PropertyTypeConverter<TBoxed, TPublic>::Unbox(m_properties[index].Get(), value);
+            PropertyTypeConverter<TBoxed, TPublic>::Load(m_properties[index], value);
         }
 
         template<typename T>
@@ -166,8 +197,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         {
             assert(index < m_properties.size());
 
-            m_properties[index] = CreateProperty(m_propertyValueFactory.Get(), valueCount, value);
-            m_propertiesChanged = true;
+            if (StoreValue(m_properties[index], valueCount, value))
+            {
+                MarkPropertyDirty(index);
+            }
         }
 
         template<typename T>
@@ -184,7 +217,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
             CheckInPointer(valueCount);
             CheckAndClearOutPointer(value);
 
-            GetValueOfProperty(m_properties[index].Get(), valueCount, value);
+            LoadValue(m_properties[index], valueCount, value);
         }
 
 
@@ -196,6 +229,16 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         void SetD2DInputs(ID2D1DeviceContext* deviceContext, float targetDpi, bool wasRecreated);
         void SetD2DProperties();
 
+        void MarkPropertyDirty(unsigned int index)
+        {
+            m_dirtyProperties[index] = true;
+            m_anyPropertiesDirty = true;
+        }
+
+        void MarkAllPropertiesDirty();
+
+        static ComPtr<IPropertyValue> BoxProperty(IPropertyValueStatics* factory, EffectPropertyValue const& property);
+
         void ThrowIfClosed();
 
 
@@ -203,44 +246,46 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         // PropertyTypeConverter is responsible for converting values between TBoxed and TPublic forms.
         // This is designed to produce compile errors if incompatible types are specified.
         //
+        // Store returns true if the stored value was changed.
+        //
 
         template<typename TBoxed, typename TPublic, typename Enable = void>
         struct PropertyTypeConverter
         {
             static_assert(std::is_same<TBoxed, TPublic>::value, "Default PropertyTypeConverter should only be used when TBoxed = TPublic");
 
-            static ComPtr<IPropertyValue> Box(IPropertyValueStatics* factory, TPublic const& value)
+            static bool Store(EffectPropertyValue& property, TPublic const& value)
             {
-                return CreateProperty(factory, value);
+                return StoreValue(property, value);
             }
 
-            static void Unbox(IPropertyValue* propertyValue, TPublic* result)
+            static void Load(EffectPropertyValue const& property, TPublic* result)
             {
-                GetValueOfProperty(propertyValue, result);
+                LoadValue(property, result);
             }
         };
 
 
-        // Enum values are boxed as unsigned integers.
+        // Enum values are stored as unsigned integers.
         template<typename TPublic>
         struct PropertyTypeConverter<uint32_t, TPublic,
                                      typename std::enable_if<std::is_enum<TPublic>::value>::type>
         {
-            static ComPtr<IPropertyValue> Box(IPropertyValueStatics* factory, TPublic value)
+            static bool Store(EffectPropertyValue& property, TPublic value)
             {
-                return CreateProperty(factory, static_cast<uint32_t>(value));
+                return StoreValue(property, static_cast<uint32_t>(value));
             }
 
-            static void Unbox(IPropertyValue* propertyValue, TPublic* result)
+            static void Load(EffectPropertyValue const& property, TPublic* result)
             {
                 uint32_t value;
-                GetValueOfProperty(propertyValue, &value);
+                LoadValue(property, &value);
                 *result = static_cast<TPublic>(value);
             }
         };
 
 
-        // Vectors and matrices are boxed as float arrays.
+        // Vectors and matrices are stored as float arrays.
         template<int N, typename TPublic>
         struct PropertyTypeConverter<float[N], TPublic>
         {
@@ -254,83 +299,79 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
 
             static_assert(sizeof(TPublic) == sizeof(float[N]), "Wrong array size");
 
-            static ComPtr<IPropertyValue> Box(IPropertyValueStatics* factory, TPublic const& value)
+            static bool Store(EffectPropertyValue& property, TPublic const& value)
             {
-                ComPtr<IPropertyValue> propertyValue;
-                ThrowIfFailed(factory->CreateSingleArray(N, (float*)&value, &propertyValue));
-                return propertyValue;
+                return StoreValue(property, N, reinterpret_cast<float const*>(&value));
             }
 
-            static void Unbox(IPropertyValue* propertyValue, TPublic* result)
+            static void Load(EffectPropertyValue const& property, TPublic* result)
             {
-                ComArray<float> value;
+                ThrowIfWrongType(property, PropertyType_SingleArray);
 
-                ThrowIfFailed(propertyValue->GetSingleArray(value.GetAddressOfSize(), value.GetAddressOfData()));
-
-                if (value.GetSize() != N)
+                if (property.SingleArrayValue.size() != N)
                     ThrowHR(E_BOUNDS);
 
-                *result = *reinterpret_cast<TPublic*>(value.GetData());
+                *result = *reinterpret_cast<TPublic const*>(property.SingleArrayValue.data());
             }
         };
 
 
-        // Color can be boxed as a float4 (for properties that include alpha).
+        // Color can be stored as a float4 (for properties that include alpha).
         template<>
         struct PropertyTypeConverter<float[4], Color>
         {
             typedef PropertyTypeConverter<float[4], Numerics::Vector4> VectorConverter;
 
-            static ComPtr<IPropertyValue> Box(IPropertyValueStatics* factory, Color const& value)
+            static bool Store(EffectPropertyValue& property, Color const& value)
             {
-                return VectorConverter::Box(factory, ToVector4(value));
+                return VectorConverter::Store(property, ToVector4(value));
             }
 
-            static void Unbox(IPropertyValue* propertyValue, Color* result)
+            static void Load(EffectPropertyValue const& property, Color* result)
             {
                 Numerics::Vector4 value;
-                VectorConverter::Unbox(propertyValue, &value);
+                VectorConverter::Load(property, &value);
                 *result = ToWindowsColor(value);
             }
         };
 
 
-        // Color can also be boxed as float3 (for properties that only use rgb).
+        // Color can also be stored as float3 (for properties that only use rgb).
         template<>
         struct PropertyTypeConverter<float[3], Color>
         {
             typedef PropertyTypeConverter<float[3], Numerics::Vector3> VectorConverter;
 
-            static ComPtr<IPropertyValue> Box(IPropertyValueStatics* factory, Color const& value)
+            static bool Store(EffectPropertyValue& property, Color const& value)
             {
-                return VectorConverter::Box(factory, ToVector3(value));
+                return VectorConverter::Store(property, ToVector3(value));
             }
 
-            static void Unbox(IPropertyValue* propertyValue, Color* result)
+            static void Load(EffectPropertyValue const& property, Color* result)
             {
                 Numerics::Vector3 value;
-                VectorConverter::Unbox(propertyValue, &value);
+                VectorConverter::Load(property, &value);
                 *result = ToWindowsColor(value);
             }
         };
 
 
-        // Rect is boxed as a float4, after converting WinRT x/y/w/h format to D2D left/top/right/bottom.
+        // Rect is stored as a float4, after converting WinRT x/y/w/h format to D2D left/top/right/bottom.
         template<>
         struct PropertyTypeConverter<float[4], Rect>
         {
             typedef PropertyTypeConverter<float[4], Numerics::Vector4> VectorConverter;
 
-            static ComPtr<IPropertyValue> Box(IPropertyValueStatics* factory, Rect const& value)
+            static bool Store(EffectPropertyValue& property, Rect const& value)
             {
                 auto d2dRect = ToD2DRect(value);
-                return VectorConverter::Box(factory, *ReinterpretAs<Numerics::Vector4*>(&d2dRect));
+                return VectorConverter::Store(property, *ReinterpretAs<Numerics::Vector4*>(&d2dRect));
             }
 
-            static void Unbox(IPropertyValue* propertyValue, Rect* result)
+            static void Load(EffectPropertyValue const& property, Rect* result)
             {
                 Numerics::Vector4 value;
-                VectorConverter::Unbox(propertyValue, &value);
+                VectorConverter::Load(property, &value);
                 *result = FromD2DRect(*ReinterpretAs<D2D1_RECT_F*>(&value));
             }
         };
@@ -340,60 +381,90 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         template<>
         struct PropertyTypeConverter<ConvertRadiansToDegrees, float>
         {
-            static ComPtr<IPropertyValue> Box(IPropertyValueStatics* factory, float value)
+            static bool Store(EffectPropertyValue& property, float value)
             {
-                return CreateProperty(factory, ::DirectX::XMConvertToDegrees(value));
+                return StoreValue(property, ::DirectX::XMConvertToDegrees(value));
             }
 
-            static void Unbox(IPropertyValue* propertyValue, float* result)
+            static void Load(EffectPropertyValue const& property, float* result)
             {
                 float degrees;
-                GetValueOfProperty(propertyValue, &degrees);
+                LoadValue(property, &degrees);
                 *result = ::DirectX::XMConvertToRadians(degrees);
             }
         };
 
 
         //
-        // Wrap the IPropertyValue accessors (which use different method names for each type) with
-        // overloaded C++ versions that can be used by generic PropertyTypeConverter implementations.
+        // Overloaded accessors for the EffectPropertyValue union, which can be used by
+        // generic PropertyTypeConverter implementations.  Values are compared bitwise,
+        // so eg. changing 0 to -0 still counts as a change.
         //
 
+        static void ThrowIfWrongType(EffectPropertyValue const& property, PropertyType expectedType)
+        {
+            if (property.Type == expectedType)
+                return;
+
+            if (property.Type == PropertyType_Empty)
+                ThrowHR(E_POINTER);
+            else
+                ThrowHR(TYPE_E_TYPEMISMATCH);
+        }
+
 #define PROPERTY_TYPE_ACCESSOR(TYPE, WINRT_NAME)                                                        \
-        static ComPtr<IPropertyValue> CreateProperty(IPropertyValueStatics* factory, TYPE const& value) \
+        static bool StoreValue(EffectPropertyValue& property, TYPE const& value)                        \
         {                                                                                               \
-            ComPtr<IPropertyValue> propertyValue;                                                       \
-            ThrowIfFailed(factory->Create##WINRT_NAME(value, &propertyValue));                          \
-            return propertyValue;                                                                       \
+            if (property.Type == PropertyType_##WINRT_NAME &&                                           \
+                memcmp(&property.WINRT_NAME##Value, &value, sizeof(TYPE)) == 0)                         \
+            {                                                                                           \
+                return false;                                                                           \
+            }                                                                                           \
+                                                                                                        \
+            property.Type = PropertyType_##WINRT_NAME;                                                  \
+            property.WINRT_NAME##Value = value;                                                         \
+            property.SingleArrayValue.clear();                                                          \
+            return true;                                                                                \
         }                                                                                               \
                                                                                                         \
-        static void GetValueOfProperty(IPropertyValue* propertyValue, TYPE* result)                     \
+        static void LoadValue(EffectPropertyValue const& property, TYPE* result)                        \
         {                                                                                               \
-            ThrowIfFailed(propertyValue->Get##WINRT_NAME(result));                                      \
-        }
-
-#define ARRAY_PROPERTY_TYPE_ACCESSOR(TYPE, WINRT_NAME)                                                                          \
-        static ComPtr<IPropertyValue> CreateProperty(IPropertyValueStatics* factory, uint32_t valueCount, TYPE const* value)    \
-        {                                                                                                                       \
-            ComPtr<IPropertyValue> propertyValue;                                                                               \
-            ThrowIfFailed(factory->Create##WINRT_NAME##Array(valueCount, const_cast<TYPE*>(value), &propertyValue));            \
-            return propertyValue;                                                                                               \
-        }                                                                                                                       \
-                                                                                                                                \
-        static void GetValueOfProperty(IPropertyValue* propertyValue, uint32_t* valueCount, TYPE** value)                       \
-        {                                                                                                                       \
-            ThrowIfFailed(propertyValue->Get##WINRT_NAME##Array(valueCount, value));                                            \
+            ThrowIfWrongType(property, PropertyType_##WINRT_NAME);                                      \
+            *result = property.WINRT_NAME##Value;                                                       \
         }
 
         PROPERTY_TYPE_ACCESSOR(float,    Single)
         PROPERTY_TYPE_ACCESSOR(int32_t,  Int32)
         PROPERTY_TYPE_ACCESSOR(uint32_t, UInt32)
         PROPERTY_TYPE_ACCESSOR(boolean,  Boolean)
-        
-        ARRAY_PROPERTY_TYPE_ACCESSOR(float, Single)
 
 #undef PROPERTY_TYPE_ACCESSOR
-#undef ARRAY_PROPERTY_TYPE_ACCESSOR
+
+        static bool StoreValue(EffectPropertyValue& property, uint32_t valueCount, float const* value)
+        {
+            auto& array = property.SingleArrayValue;
+
+            if (property.Type == PropertyType_SingleArray &&
+                array.size() == valueCount &&
+                (valueCount == 0 || memcmp(array.data(), value, valueCount * sizeof(float)) == 0))
+            {
+                return false;
+            }
+
+            property.Type = PropertyType_SingleArray;
+            array.assign(value, value + valueCount);
+            return true;
+        }
+
+        static void LoadValue(EffectPropertyValue const& property, uint32_t* valueCount, float** value)
+        {
+            ThrowIfWrongType(property, PropertyType_SingleArray);
+
+            auto& array = property.SingleArrayValue;
+
+            ComArray<float> result(array.begin(), array.end());
+            result.Detach(valueCount, value);
+        }
 
 
         //
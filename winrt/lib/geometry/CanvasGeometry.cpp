@@ -22,6 +22,22 @@ using namespace ABI::Microsoft::Graphics::Canvas;
 
 static const Matrix3x2 Identity3x2 = { 1, 0, 0, 1, 0, 0 };
 
+// Returns null if the device has no tessellation cache, or it is disabled.
+static TessellationCache* GetEnabledTessellationCache(ICanvasDevice* device)
+{
+    auto deviceInternal = MaybeAs<ICanvasDeviceInternal>(device);
+
+    if (!deviceInternal)
+        return nullptr;
+
+    auto tessellationCache = deviceInternal->GetTessellationCache();
+
+    if (!tessellationCache || !tessellationCache->IsEnabled())
+        return nullptr;
+
+    return tessellationCache;
+}
+
 IFACEMETHODIMP CanvasGeometryFactory::CreateRectangle(
     ICanvasResourceCreator* resourceCreator,
     Rect rect,
@@ -276,7 +292,12 @@ CanvasGeometry::CanvasGeometry(
 
 IFACEMETHODIMP CanvasGeometry::Close()
 {
-    m_canvasDevice.Close();
+    auto device = m_canvasDevice.Close();
+
+    // Cached tessellations of this geometry can never be used again.
+    if (auto tessellationCache = GetEnabledTessellationCache(device.Get()))
+        tessellationCache->RemoveGeometry(GetResource().Get());
+
     return ResourceWrapper::Close();
 }
 
@@ -900,16 +921,146 @@ IFACEMETHODIMP CanvasGeometry::TessellateWithTransformAndFlatteningTolerance(
 
         auto& resource = GetResource();
 
-        auto tessellationSink = Make<TessellationSink>();
-        CheckMakeResult(tessellationSink);
+        auto d2dTransform = ReinterpretAs<D2D1_MATRIX_3X2_F*>(&transform);
 
-        ThrowIfFailed(resource->Tessellate(
-            ReinterpretAs<D2D1_MATRIX_3X2_F*>(&transform),
-            flatteningTolerance,
-            tessellationSink.Get()));
+        auto tessellate = [&]
+        {
+            auto tessellationSink = Make<TessellationSink>();
+            CheckMakeResult(tessellationSink);
+
+            ThrowIfFailed(resource->Tessellate(
+                d2dTransform,
+                flatteningTolerance,
+                tessellationSink.Get()));
+
+            return tessellationSink->TakeTriangles();
+        };
+
+        if (auto tessellationCache = GetEnabledTessellationCache(m_canvasDevice.EnsureNotClosed().Get()))
+        {
+            auto cachedTriangles = tessellationCache->GetTriangles(resource.Get(), *d2dTransform, flatteningTolerance, tessellate);
+
+            // The returned array belongs to the caller, so must be a copy.
+            ComArray<CanvasTriangleVertices> outputArray(cachedTriangles->begin(), cachedTriangles->end());
+            outputArray.Detach(trianglesCount, triangles);
+        }
+        else
+        {
+            auto tessellatedTriangles = tessellate();
 
-        auto outputArray = tessellationSink->GetTriangles();
-        outputArray.Detach(trianglesCount, triangles);
+            ComArray<CanvasTriangleVertices> outputArray(tessellatedTriangles.begin(), tessellatedTriangles.end());
+            outputArray.Detach(trianglesCount, triangles);
+        }
+    });
+}
+
+//
+// The following methods bypass the tessellation cache: their whole point is
+// to avoid holding the complete triangle list in memory, so each call asks
+// Direct2D to tessellate again and forwards triangles as they are generated.
+//
+static void TessellateToCallback(
+    ID2D1Geometry* geometry,
+    Matrix3x2 const& transform,
+    float flatteningTolerance,
+    CallbackTessellationSink::Callback&& callback)
+{
+    auto tessellationSink = Make<CallbackTessellationSink>(std::move(callback));
+    CheckMakeResult(tessellationSink);
+
+    ThrowIfFailed(geometry->Tessellate(
+        ReinterpretAs<D2D1_MATRIX_3X2_F const*>(&transform),
+        flatteningTolerance,
+        tessellationSink.Get()));
+
+    ThrowIfFailed(tessellationSink->Close());
+}
+
+IFACEMETHODIMP CanvasGeometry::GetTessellatedTriangleCount(
+    Matrix3x2 transform,
+    float flatteningTolerance,
+    UINT32* trianglesCount)
+{
+    return ExceptionBoundary([&]
+    {
+        CheckInPointer(trianglesCount);
+
+        auto& resource = GetResource();
+
+        uint32_t count = 0;
+
+        TessellateToCallback(resource.Get(), transform, flatteningTolerance,
+            [&](CanvasTriangleVertices const*, uint32_t batchCount)
+            {
+                count += batchCount;
+            });
+
+        *trianglesCount = count;
+    });
+}
+
+IFACEMETHODIMP CanvasGeometry::TessellateIntoBuffer(
+    Matrix3x2 transform,
+    float flatteningTolerance,
+    UINT32 bufferSize,
+    CanvasTriangleVertices* buffer,
+    UINT32* trianglesWritten)
+{
+    return ExceptionBoundary([&]
+    {
+        if (bufferSize > 0)
+            CheckInPointer(buffer);
+        CheckInPointer(trianglesWritten);
+
+        *trianglesWritten = 0;
+
+        auto& resource = GetResource();
+
+        uint32_t count = 0;
+
+        TessellateToCallback(resource.Get(), transform, flatteningTolerance,
+            [&](CanvasTriangleVertices const* triangles, uint32_t batchCount)
+            {
+                // Once the buffer overflows, keep counting so the error
+                // message can report the size that was actually needed.
+                if (count <= bufferSize && batchCount <= bufferSize - count)
+                {
+                    std::copy(
+                        triangles,
+                        triangles + batchCount,
+                        stdext::checked_array_iterator<CanvasTriangleVertices*>(buffer + count, bufferSize - count));
+                }
+
+                count += batchCount;
+            });
+
+        if (count > bufferSize)
+        {
+            WinStringBuilder message;
+            message.Format(Strings::TessellationBufferTooSmall, count, bufferSize);
+            ThrowHR(E_INVALIDARG, message.Get());
+        }
+
+        *trianglesWritten = count;
+    });
+}
+
+IFACEMETHODIMP CanvasGeometry::SendTessellationTo(
+    Matrix3x2 transform,
+    float flatteningTolerance,
+    ICanvasTessellationReceiver* receiver)
+{
+    return ExceptionBoundary([&]
+    {
+        CheckInPointer(receiver);
+
+        auto& resource = GetResource();
+
+        TessellateToCallback(resource.Get(), transform, flatteningTolerance,
+            [=](CanvasTriangleVertices const* triangles, uint32_t batchCount)
+            {
+                ThrowIfFailed(receiver->AddTriangles(batchCount, const_cast<CanvasTriangleVertices*>(triangles)));
+            });
     });
 }
 
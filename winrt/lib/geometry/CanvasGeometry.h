@@ -203,6 +203,23 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
             UINT32* trianglesCount,
             CanvasTriangleVertices** triangles) override;
 
+        IFACEMETHOD(GetTessellatedTriangleCount)(
+            Matrix3x2 transform,
+            float flatteningTolerance,
+            UINT32* trianglesCount) override;
+
+        IFACEMETHOD(TessellateIntoBuffer)(
+            Matrix3x2 transform,
+            float flatteningTolerance,
+            UINT32 bufferSize,
+            CanvasTriangleVertices* buffer,
+            UINT32* trianglesWritten) override;
+
+        IFACEMETHOD(SendTessellationTo)(
+            Matrix3x2 transform,
+            float flatteningTolerance,
+            ICanvasTessellationReceiver* receiver) override;
+
         IFACEMETHOD(SendPathTo)(
             ICanvasPathReceiver* streamReader) override;
 
@@ -0,0 +1,276 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#pragma once
+
+#include "utils/LockUtilities.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { namespace Geometry
+{
+    //
+    // Device-wide cache of the output of CanvasGeometry.Tessellate.
+    //
+    // D2D geometries are immutable, so the triangles only depend on the
+    // geometry, the transform and the flattening tolerance.  Transforms and
+    // tolerances are matched by comparing them bitwise.  Each entry holds a
+    // reference to its geometry, so a geometry's address can't be reused by
+    // a different one while it is in the cache.
+    //
+    // The cache is disabled until SetMaximumByteCount is called with a
+    // non-zero value.  It evicts the least recently used entries when the
+    // total size of the cached triangles, plus a fixed overhead per entry,
+    // goes over that budget.
+    //
+    // Triangle buffers are immutable once added, and are handed out as
+    // shared pointers, so they remain valid even if the entry is evicted or
+    // the cache is cleared.
+    //
+    class TessellationCache
+    {
+    public:
+        typedef std::vector<CanvasTriangleVertices> Triangles;
+        typedef std::shared_ptr<Triangles const> SharedTriangles;
+
+        // Charged for every entry, so that geometries that produce few or no
+        // triangles still count towards the budget.
+        static const size_t EntryOverheadInBytes = 256;
+
+    private:
+        struct Entry
+        {
+            size_t Hash;
+            ComPtr<ID2D1Geometry> Geometry;
+            D2D1_MATRIX_3X2_F Transform;
+            float FlatteningTolerance;
+            SharedTriangles Triangles;
+            size_t ByteCount;
+        };
+
+        typedef std::list<Entry> EntryList;
+
+        std::mutex m_mutex;
+
+        size_t m_maximumByteCount;
+
+        EntryList m_entries;    // Most recently used first
+        std::unordered_multimap<size_t, EntryList::iterator> m_entryLookup;
+        size_t m_byteCount;
+
+        uint64_t m_hitCount;
+        uint64_t m_missCount;
+
+    public:
+        TessellationCache()
+            : m_maximumByteCount(0)
+            , m_byteCount(0)
+            , m_hitCount(0)
+            , m_missCount(0)
+        {
+        }
+
+        bool IsEnabled()
+        {
+            Lock lock(m_mutex);
+            return m_maximumByteCount > 0;
+        }
+
+        void SetMaximumByteCount(size_t maximumByteCount)
+        {
+            Lock lock(m_mutex);
+
+            m_maximumByteCount = maximumByteCount;
+
+            TrimToLimit(lock);
+        }
+
+        size_t GetMaximumByteCount()
+        {
+            Lock lock(m_mutex);
+            return m_maximumByteCount;
+        }
+
+        //
+        // Returns the triangles for the given geometry, transform and
+        // tolerance, calling tessellateFn (which should return a Triangles)
+        // if they are not already in the cache.  Results too large to ever
+        // fit in the cache are returned without being cached.
+        //
+        template<typename FN>
+        SharedTriangles GetTriangles(
+            ID2D1Geometry* geometry,
+            D2D1_MATRIX_3X2_F const& transform,
+            float flatteningTolerance,
+            FN&& tessellateFn)
+        {
+            auto hash = GetHash(geometry, transform, flatteningTolerance);
+
+            {
+                Lock lock(m_mutex);
+
+                auto range = m_entryLookup.equal_range(hash);
+
+                for (auto it = range.first; it != range.second; ++it)
+                {
+                    auto& entry = *it->second;
+
+                    if (entry.Geometry.Get() == geometry &&
+                        memcmp(&entry.Transform, &transform, sizeof(transform)) == 0 &&
+                        memcmp(&entry.FlatteningTolerance, &flatteningTolerance, sizeof(flatteningTolerance)) == 0)
+                    {
+                        ++m_hitCount;
+
+                        // Move to the front of the list.
+                        m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+                        return entry.Triangles;
+                    }
+                }
+
+                ++m_missCount;
+            }
+
+            // Tessellation runs without holding the lock, since this is the
+            // expensive part.  If two threads race to tessellate the same
+            // geometry then both results are added, and the older one ages
+            // out.
+            auto triangles = std::make_shared<Triangles>(tessellateFn());
+
+            // Entries may live for a long time, so don't hang on to any
+            // spare capacity left over from building the vector.
+            triangles->shrink_to_fit();
+
+            auto byteCount = triangles->size() * sizeof(CanvasTriangleVertices) + EntryOverheadInBytes;
+
+            Lock lock(m_mutex);
+
+            if (byteCount > m_maximumByteCount)
+                return triangles;
+
+            m_entries.push_front(Entry{ hash, geometry, transform, flatteningTolerance, triangles, byteCount });
+            m_entryLookup.emplace(hash, m_entries.begin());
+            m_byteCount += byteCount;
+
+            TrimToLimit(lock);
+
+            return triangles;
+        }
+
+        // Called when a geometry is closed, as its entries can never be hit again.
+        void RemoveGeometry(ID2D1Geometry* geometry)
+        {
+            Lock lock(m_mutex);
+
+            for (auto it = m_entries.begin(); it != m_entries.end();)
+            {
+                auto next = std::next(it);
+
+                if (it->Geometry.Get() == geometry)
+                    RemoveEntry(lock, it);
+
+                it = next;
+            }
+        }
+
+        void Clear()
+        {
+            Lock lock(m_mutex);
+
+            m_entries.clear();
+            m_entryLookup.clear();
+            m_byteCount = 0;
+        }
+
+        uint64_t GetHitCount()
+        {
+            Lock lock(m_mutex);
+            return m_hitCount;
+        }
+
+        uint64_t GetMissCount()
+        {
+            Lock lock(m_mutex);
+            return m_missCount;
+        }
+
+        size_t GetEntryCount()
+        {
+            Lock lock(m_mutex);
+            return m_entries.size();
+        }
+
+        size_t GetByteCount()
+        {
+            Lock lock(m_mutex);
+            return m_byteCount;
+        }
+
+    private:
+        void TrimToLimit(Lock const& lock)
+        {
+            MustOwnLock(lock);
+
+            while (!m_entries.empty() && m_byteCount > m_maximumByteCount)
+            {
+                RemoveEntry(lock, std::prev(m_entries.end()));
+            }
+        }
+
+        void RemoveEntry(Lock const& lock, EntryList::iterator entry)
+        {
+            MustOwnLock(lock);
+
+            auto range = m_entryLookup.equal_range(entry->Hash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second == entry)
+                {
+                    m_entryLookup.erase(it);
+                    break;
+                }
+            }
+
+            m_byteCount -= entry->ByteCount;
+            m_entries.erase(entry);
+        }
+
+        static size_t GetHash(
+            ID2D1Geometry* geometry,
+            D2D1_MATRIX_3X2_F const& transform,
+            float flatteningTolerance)
+        {
+            // FNV-1a
+            uint64_t hash = 14695981039346656037ULL;
+
+            auto add = [&](uint64_t value)
+            {
+                hash ^= value;
+                hash *= 1099511628211ULL;
+            };
+
+            add(reinterpret_cast<uintptr_t>(geometry));
+
+            uint32_t transformBits[6];
+            static_assert(sizeof(transformBits) == sizeof(transform), "D2D1_MATRIX_3X2_F should be six floats");
+            memcpy(transformBits, &transform, sizeof(transformBits));
+
+            for (auto bits : transformBits)
+                add(bits);
+
+            uint32_t toleranceBits;
+            memcpy(&toleranceBits, &flatteningTolerance, sizeof(toleranceBits));
+            add(toleranceBits);
+
+            return static_cast<size_t>(hash);
+        }
+    };
+}}}}}
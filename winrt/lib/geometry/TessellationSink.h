@@ -43,11 +43,50 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
             return m_result;
         }
 
-        ComArray<CanvasTriangleVertices> GetTriangles()
+        std::vector<CanvasTriangleVertices> TakeTriangles()
         {
             ThrowIfFailed(m_result);
 
-            return ComArray<CanvasTriangleVertices>(m_triangles.begin(), m_triangles.end());
+            return std::move(m_triangles);
+        }
+    };
+
+
+    //
+    // Forwards each batch of triangles to a callback as Direct2D generates
+    // it, rather than accumulating them.  Used by the tessellation methods
+    // that write into a caller-provided buffer or stream to a receiver.
+    //
+    class CallbackTessellationSink : public RuntimeClass<RuntimeClassFlags<ClassicCom>, ID2D1TessellationSink>,
+                                     private LifespanTracker<CallbackTessellationSink>
+    {
+    public:
+        typedef std::function<void(CanvasTriangleVertices const*, uint32_t)> Callback;
+
+    private:
+        Callback m_callback;
+        HRESULT m_result;
+
+    public:
+        CallbackTessellationSink(Callback&& callback)
+            : m_callback(std::move(callback))
+            , m_result(S_OK)
+        { }
+
+        IFACEMETHODIMP_(void) AddTriangles(D2D1_TRIANGLE const* triangles, UINT32 trianglesCount)
+        {
+            if (FAILED(m_result))
+                return;
+
+            m_result = ExceptionBoundary([&]
+            {
+                m_callback(ReinterpretAs<CanvasTriangleVertices const*>(triangles), trianglesCount);
+            });
+        }
+
+        IFACEMETHODIMP Close()
+        {
+            return m_result;
         }
     };
 }}}}}
@@ -0,0 +1,212 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "BitmapBatchLoader.h"
+
+#include <thread>
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    BitmapBatchLoader::BitmapBatchLoader(
+        uint32_t fileCount,
+        DecodeFunction decode,
+        unsigned maxDecoderCount,
+        uint64_t maximumBytesInFlight)
+        : m_fileCount(fileCount)
+        , m_decode(std::move(decode))
+        , m_maxDecoderCount(maxDecoderCount ? maxDecoderCount : std::max(1u, std::thread::hardware_concurrency()))
+        , m_maximumBytesInFlight(maximumBytesInFlight)
+        , m_nextIndex(0)
+        , m_bytesInFlight(0)
+        , m_isStopRequested(false)
+        , m_activeDecoderCount(0)
+        , m_peakActiveDecoderCount(0)
+        , m_peakBytesInFlight(0)
+    {
+        assert(m_maximumBytesInFlight > 0);
+    }
+
+    void BitmapBatchLoader::Run(UploadFunction const& upload, ProgressFunction const& progress)
+    {
+        if (m_fileCount == 0)
+            return;
+
+        PTP_WORK work = CreateThreadpoolWork(&BitmapBatchLoader::DecodeCallback, this, nullptr);
+
+        if (!work)
+            ThrowHR(HRESULT_FROM_WIN32(GetLastError()));
+
+        // The decoders refer to this object, so must all have stopped before
+        // Run returns, however it returns.
+        auto closeWarden = MakeScopeWarden(
+            [&]
+            {
+                Cancel();
+                WaitForThreadpoolWorkCallbacks(work, FALSE);
+                CloseThreadpoolWork(work);
+            });
+
+        auto decoderCount = std::min(m_maxDecoderCount, m_fileCount);
+
+        for (unsigned i = 0; i < decoderCount; i++)
+        {
+            SubmitThreadpoolWork(work);
+        }
+
+        for (uint32_t loadedCount = 0; loadedCount < m_fileCount; )
+        {
+            DecodedImage decodedImage;
+
+            {
+                Lock lock(m_mutex);
+
+                m_conditionVariable.wait(lock,
+                    [&]
+                    {
+                        return !m_decodedImages.empty() || m_exception || m_isStopRequested;
+                    });
+
+                if (m_exception)
+                {
+                    auto exception = m_exception;
+                    lock.unlock();
+                    std::rethrow_exception(exception);
+                }
+
+                if (m_isStopRequested)
+                    return;
+
+                decodedImage = std::move(m_decodedImages.front());
+                m_decodedImages.pop_front();
+            }
+
+            upload(decodedImage.Index, decodedImage.Image.Get());
+
+            // The decoded pixels can go now that they are on the device.
+            decodedImage.Image.Reset();
+
+            {
+                Lock lock(m_mutex);
+                m_bytesInFlight -= decodedImage.SizeInBytes;
+            }
+
+            m_conditionVariable.notify_all();
+
+            ++loadedCount;
+
+            if (progress)
+                progress(loadedCount);
+        }
+    }
+
+    void BitmapBatchLoader::Cancel()
+    {
+        {
+            Lock lock(m_mutex);
+            m_isStopRequested = true;
+        }
+
+        m_conditionVariable.notify_all();
+    }
+
+    unsigned BitmapBatchLoader::GetPeakActiveDecoderCount()
+    {
+        Lock lock(m_mutex);
+        return m_peakActiveDecoderCount;
+    }
+
+    uint64_t BitmapBatchLoader::GetPeakBytesInFlight()
+    {
+        Lock lock(m_mutex);
+        return m_peakBytesInFlight;
+    }
+
+    void CALLBACK BitmapBatchLoader::DecodeCallback(PTP_CALLBACK_INSTANCE, void* context, PTP_WORK)
+    {
+        static_cast<BitmapBatchLoader*>(context)->DecodeFiles();
+    }
+
+    void BitmapBatchLoader::DecodeFiles()
+    {
+        for (;;)
+        {
+            uint32_t index;
+
+            {
+                Lock lock(m_mutex);
+
+                m_conditionVariable.wait(lock,
+                    [&]
+                    {
+                        return m_bytesInFlight < m_maximumBytesInFlight || m_exception || m_isStopRequested;
+                    });
+
+                if (m_exception || m_isStopRequested || m_nextIndex >= m_fileCount)
+                    return;
+
+                index = m_nextIndex++;
+
+                ++m_activeDecoderCount;
+                m_peakActiveDecoderCount = std::max(m_peakActiveDecoderCount, m_activeDecoderCount);
+            }
+
+            try
+            {
+                auto image = m_decode(index);
+
+                auto sizeInBytes = GetPixelBufferSize(image.Get());
+
+                Lock lock(m_mutex);
+
+                --m_activeDecoderCount;
+
+                m_decodedImages.push_back(DecodedImage{ index, image, sizeInBytes });
+                m_bytesInFlight += sizeInBytes;
+                m_peakBytesInFlight = std::max(m_peakBytesInFlight, m_bytesInFlight);
+            }
+            catch (...)
+            {
+                Lock lock(m_mutex);
+
+                --m_activeDecoderCount;
+
+                if (!m_exception)
+                    m_exception = std::current_exception();
+            }
+
+            m_conditionVariable.notify_all();
+        }
+    }
+
+    uint64_t BitmapBatchLoader::GetPixelBufferSize(IWICBitmap* image)
+    {
+        UINT width, height;
+        ThrowIfFailed(image->GetSize(&width, &height));
+
+        if (width == 0 || height == 0)
+            return 0;
+
+        // Locking the whole bitmap reports the size of the buffer holding
+        // its pixels, including any padding at the end of each row.
+        WICRect rect{ 0, 0, static_cast<INT>(width), static_cast<INT>(height) };
+
+        ComPtr<IWICBitmapLock> bitmapLock;
+        ThrowIfFailed(image->Lock(&rect, WICBitmapLockRead, &bitmapLock));
+
+        UINT bufferSize;
+        WICInProcPointer data;
+        ThrowIfFailed(bitmapLock->GetDataPointer(&bufferSize, &data));
+
+        return bufferSize;
+    }
+}}}}
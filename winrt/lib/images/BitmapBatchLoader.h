@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "utils/LockUtilities.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Does the work for CanvasBitmap.LoadManyAsync.
+    //
+    // Files are decoded on up to maxDecoderCount thread pool threads at
+    // once.  Each decode must produce an IWICBitmap that already holds all
+    // of the file's pixels, converted to premultiplied BGRA (which the WIC
+    // format converters do with SIMD code), so that none of the decoding is
+    // left to happen lazily during the upload.  Meanwhile the thread that
+    // calls Run uploads each decoded image to the device as soon as it is
+    // ready.  Uploading is the only step that uses the device, so it is the
+    // only one done one file at a time.
+    //
+    // Decoded images waiting to be uploaded are limited to about
+    // maximumBytesInFlight, counting the real size of each image's pixel
+    // buffer.  Once that much is waiting, decoders hold off starting new
+    // files until the uploader catches up.  Files that are already being
+    // decoded still finish, so the real peak can be higher by up to one
+    // image per decoder.
+    //
+    class BitmapBatchLoader : private LifespanTracker<BitmapBatchLoader>
+    {
+    public:
+        typedef std::function<ComPtr<IWICBitmap>(uint32_t index)> DecodeFunction;
+        typedef std::function<void(uint32_t index, IWICBitmap* decodedImage)> UploadFunction;
+        typedef std::function<void(uint32_t loadedCount)> ProgressFunction;
+
+        static const uint64_t DefaultMaximumBytesInFlight = 64 * 1024 * 1024;
+
+    private:
+        struct DecodedImage
+        {
+            uint32_t Index;
+            ComPtr<IWICBitmap> Image;
+            uint64_t SizeInBytes;
+        };
+
+        uint32_t m_fileCount;
+        DecodeFunction m_decode;
+        unsigned m_maxDecoderCount;
+        uint64_t m_maximumBytesInFlight;
+
+        std::mutex m_mutex;
+        std::condition_variable m_conditionVariable;
+
+        uint32_t m_nextIndex;
+        std::deque<DecodedImage> m_decodedImages;
+        uint64_t m_bytesInFlight;
+        bool m_isStopRequested;
+        std::exception_ptr m_exception;
+
+        unsigned m_activeDecoderCount;
+        unsigned m_peakActiveDecoderCount;
+        uint64_t m_peakBytesInFlight;
+
+    public:
+        // A maxDecoderCount of zero means one decoder per logical processor.
+        BitmapBatchLoader(
+            uint32_t fileCount,
+            DecodeFunction decode,
+            unsigned maxDecoderCount = 0,
+            uint64_t maximumBytesInFlight = DefaultMaximumBytesInFlight);
+
+        //
+        // Decodes every file and calls upload, then progress, for each one
+        // on the calling thread.  Files are uploaded in the order they finish
+        // decoding, which may not be the order of their indices.  Throws the
+        // first error from decode or upload, once all the decoders have
+        // stopped.  Returns early, without an error, if Cancel is called.
+        //
+        void Run(UploadFunction const& upload, ProgressFunction const& progress);
+
+        // Stops decoding any more files.  Can be called from any thread.
+        void Cancel();
+
+        unsigned GetPeakActiveDecoderCount();
+        uint64_t GetPeakBytesInFlight();
+
+    private:
+        static void CALLBACK DecodeCallback(PTP_CALLBACK_INSTANCE, void* context, PTP_WORK);
+
+        void DecodeFiles();
+
+        static uint64_t GetPixelBufferSize(IWICBitmap* image);
+    };
+
+
+    //
+    // The IAsyncOperationWithProgress returned by LoadManyAsync.  Cancelling
+    // it stops the loader, rather than waiting for every file to finish.
+    //
+    class LoadManyAsyncOperation : public AsyncOperationWithProgress<ABI::Windows::Foundation::Collections::IVectorView<CanvasBitmap*>, UINT32>
+    {
+        std::shared_ptr<BitmapBatchLoader> m_loader;
+
+    public:
+        LoadManyAsyncOperation(
+            std::shared_ptr<BitmapBatchLoader> const& loader,
+            std::function<ComPtr<ABI::Windows::Foundation::Collections::IVectorView<CanvasBitmap*>>(ProgressReporter const&)>&& workerFunction)
+            : AsyncOperationWithProgress(std::move(workerFunction))
+            , m_loader(loader)
+        {
+        }
+
+    protected:
+        virtual void OnCancel() override
+        {
+            m_loader->Cancel();
+        }
+    };
+}}}}
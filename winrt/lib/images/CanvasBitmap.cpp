@@ -16,6 +16,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
     using namespace ABI::Windows::Storage::Streams;
     using namespace ABI::Windows::Storage;
+    using namespace ABI::Windows::Foundation::Collections;
     using namespace ::Microsoft::WRL::Wrappers;
 
     //
@@ -34,31 +35,30 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         float dpi,
         CanvasAlphaMode alpha)
     {
-        ComPtr<ICanvasDeviceInternal> canvasDeviceInternal;
-        ThrowIfFailed(canvasDevice->QueryInterface(canvasDeviceInternal.GetAddressOf()));
+        return CreateNew(canvasDevice, m_adapter->CreateWICFormatConverter(fileName).Get(), dpi, alpha);
+    }
 
-        auto d2dBitmap = canvasDeviceInternal->CreateBitmapFromWicResource(m_adapter->CreateWICFormatConverter(fileName).Get(), dpi, alpha);
 
-        auto bitmap = Make<CanvasBitmap>(
-            shared_from_this(),
-            d2dBitmap.Get(),
-            canvasDevice);
-        CheckMakeResult(bitmap);
-        
-        return bitmap;
+    ComPtr<CanvasBitmap> CanvasBitmapManager::CreateNew(
+        ICanvasDevice* canvasDevice,
+        IStream* fileStream,
+        float dpi,
+        CanvasAlphaMode alpha)
+    {
+        return CreateNew(canvasDevice, m_adapter->CreateWICFormatConverter(fileStream).Get(), dpi, alpha);
     }
 
 
     ComPtr<CanvasBitmap> CanvasBitmapManager::CreateNew(
         ICanvasDevice* canvasDevice,
-        IStream* fileStream,
+        IWICBitmapSource* decodedImage,
         float dpi,
         CanvasAlphaMode alpha)
     {
         ComPtr<ICanvasDeviceInternal> canvasDeviceInternal;
         ThrowIfFailed(canvasDevice->QueryInterface(canvasDeviceInternal.GetAddressOf()));
 
-        auto d2dBitmap = canvasDeviceInternal->CreateBitmapFromWicResource(m_adapter->CreateWICFormatConverter(fileStream).Get(), dpi, alpha);
+        auto d2dBitmap = canvasDeviceInternal->CreateBitmapFromWicResource(decodedImage, dpi, alpha);
 
         auto bitmap = Make<CanvasBitmap>(
             shared_from_this(),
@@ -122,23 +122,21 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         CanvasAlphaMode alpha)
     {
         // Convert color array to bytes according to the default format, B8G8R8A8_UNORM.
-        std::vector<uint8_t> convertedBytes;
-        convertedBytes.resize(colorCount * 4);
+        // The buffer is left uninitialized, since every pixel is overwritten.
+        std::unique_ptr<uint32_t[]> convertedPixels;
 
-        for (uint32_t i = 0; i < colorCount; i++)
+        if (colorCount > 0)
         {
-            convertedBytes[i * 4 + 0] = colors[i].B;
-            convertedBytes[i * 4 + 1] = colors[i].G;
-            convertedBytes[i * 4 + 2] = colors[i].R;
-            convertedBytes[i * 4 + 3] = colors[i].A;
+            convertedPixels.reset(new uint32_t[colorCount]);
+            ConvertColorsToBgraPixels(colors, convertedPixels.get(), colorCount);
         }
 
-        assert(convertedBytes.size() <= UINT_MAX);
+        assert(static_cast<uint64_t>(colorCount) * 4 <= UINT_MAX);
 
         return CreateNew(
             device,
-            static_cast<uint32_t>(convertedBytes.size()),
-            convertedBytes.empty() ? nullptr : &convertedBytes[0],
+            colorCount * 4,
+            reinterpret_cast<uint8_t*>(convertedPixels.get()),
             widthInPixels,
             heightInPixels,
             PIXEL_FORMAT(B8G8R8A8UIntNormalized),
@@ -586,6 +584,113 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             });
     }
 
+    IFACEMETHODIMP CanvasBitmapFactory::LoadManyAsyncFromHstrings(
+        ICanvasResourceCreator* resourceCreator,
+        IIterable<HSTRING>* fileNames,
+        ABI::Windows::Foundation::IAsyncOperationWithProgress<IVectorView<CanvasBitmap*>*, UINT32>** canvasBitmapsAsyncOperation)
+    {
+        return LoadManyAsyncFromHstringsWithDpiAndAlpha(
+            resourceCreator,
+            fileNames,
+            DEFAULT_DPI,
+            CanvasAlphaMode::Premultiplied,
+            canvasBitmapsAsyncOperation);
+    }
+
+    IFACEMETHODIMP CanvasBitmapFactory::LoadManyAsyncFromHstringsWithDpi(
+        ICanvasResourceCreator* resourceCreator,
+        IIterable<HSTRING>* fileNames,
+        float dpi,
+        ABI::Windows::Foundation::IAsyncOperationWithProgress<IVectorView<CanvasBitmap*>*, UINT32>** canvasBitmapsAsyncOperation)
+    {
+        return LoadManyAsyncFromHstringsWithDpiAndAlpha(
+            resourceCreator,
+            fileNames,
+            dpi,
+            CanvasAlphaMode::Premultiplied,
+            canvasBitmapsAsyncOperation);
+    }
+
+    static std::vector<WinString> CopyFileNames(IIterable<HSTRING>* fileNames)
+    {
+        std::vector<WinString> result;
+
+        ComPtr<IIterator<HSTRING>> iterator;
+        ThrowIfFailed(fileNames->First(&iterator));
+
+        boolean hasCurrent;
+        ThrowIfFailed(iterator->get_HasCurrent(&hasCurrent));
+
+        while (hasCurrent)
+        {
+            WinString fileName;
+            ThrowIfFailed(iterator->get_Current(fileName.GetAddressOf()));
+
+            result.push_back(fileName);
+
+            ThrowIfFailed(iterator->MoveNext(&hasCurrent));
+        }
+
+        return result;
+    }
+
+    IFACEMETHODIMP CanvasBitmapFactory::LoadManyAsyncFromHstringsWithDpiAndAlpha(
+        ICanvasResourceCreator* resourceCreator,
+        IIterable<HSTRING>* fileNames,
+        float dpi,
+        CanvasAlphaMode alpha,
+        ABI::Windows::Foundation::IAsyncOperationWithProgress<IVectorView<CanvasBitmap*>*, UINT32>** canvasBitmapsAsyncOperation)
+    {
+        return ExceptionBoundary(
+            [&]
+            {
+                CheckInPointer(resourceCreator);
+                CheckInPointer(fileNames);
+                CheckAndClearOutPointer(canvasBitmapsAsyncOperation);
+
+                ComPtr<ICanvasDevice> canvasDevice;
+                ThrowIfFailed(resourceCreator->get_Device(&canvasDevice));
+
+                // The names are copied up front, since the caller may change
+                // the collection while the files are loading.
+                auto fileNameList = std::make_shared<std::vector<WinString>>(CopyFileNames(fileNames));
+                auto fileCount = static_cast<uint32_t>(fileNameList->size());
+
+                auto manager = GetManager();
+
+                auto loader = std::make_shared<BitmapBatchLoader>(
+                    fileCount,
+                    [=](uint32_t index)
+                    {
+                        return manager->DecodeBitmapFile((*fileNameList)[index]);
+                    });
+
+                auto asyncOperation = Make<LoadManyAsyncOperation>(
+                    loader,
+                    [=](LoadManyAsyncOperation::ProgressReporter const& reportProgress)
+                    {
+                        auto bitmaps = Make<::collections::Vector<CanvasBitmap*>>(fileCount, true);
+                        CheckMakeResult(bitmaps);
+
+                        loader->Run(
+                            [&](uint32_t index, IWICBitmap* decodedImage)
+                            {
+                                auto bitmap = manager->CreateBitmap(canvasDevice.Get(), decodedImage, dpi, alpha);
+                                bitmaps->InternalVector()[index] = As<ICanvasBitmap>(bitmap);
+                            },
+                            reportProgress);
+
+                        ComPtr<IVectorView<CanvasBitmap*>> bitmapsView;
+                        ThrowIfFailed(bitmaps->GetView(&bitmapsView));
+
+                        return bitmapsView;
+                    });
+
+                CheckMakeResult(asyncOperation);
+                ThrowIfFailed(asyncOperation.CopyTo(canvasBitmapsAsyncOperation));
+            });
+    }
+
     //
     // ICanvasFactoryNative
     //
@@ -627,6 +732,30 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             && "CanvasBitmap should never be constructed with a render-target bitmap.  This should have been validated before construction.");
     }
 
+    static std::shared_ptr<StagingTexturePool> GetStagingTexturePool(ICanvasDevice* device)
+    {
+        if (!device)
+            return nullptr;
+
+        return As<ICanvasDeviceInternal>(device)->GetStagingTexturePool();
+    }
+
+    static std::shared_ptr<PixelBufferPool> GetPixelBufferPool(ICanvasDevice* device)
+    {
+        if (!device)
+            return nullptr;
+
+        return As<ICanvasDeviceInternal>(device)->GetPixelBufferPool();
+    }
+
+    static std::shared_ptr<PixelReadbackQueue> GetPixelReadbackQueue(ICanvasDevice* device)
+    {
+        if (!device)
+            return std::make_shared<PixelReadbackQueue>();
+
+        return As<ICanvasDeviceInternal>(device)->GetPixelReadbackQueue();
+    }
+
     void VerifyWellFormedSubrectangle(D2D1_RECT_U subRectangle, D2D1_SIZE_U targetSize)
     {
         if (subRectangle.right <= subRectangle.left ||
@@ -642,6 +771,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
     void GetPixelBytesImpl(
+        ICanvasDevice* device,
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         D2D1_RECT_U const& subRectangle,
         uint32_t* valueCount,
@@ -652,7 +782,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         VerifyWellFormedSubrectangle(subRectangle, d2dBitmap->GetPixelSize());
 
-        ScopedBitmapMappedPixelAccess bitmapPixelAccess(d2dBitmap.Get(), D3D11_MAP_READ, &subRectangle);
+        ScopedBitmapMappedPixelAccess bitmapPixelAccess(d2dBitmap.Get(), GetStagingTexturePool(device), D3D11_MAP_READ, &subRectangle);
 
         const unsigned int bytesPerPixel = GetBytesPerPixel(d2dBitmap->GetPixelFormat().format);
         const unsigned int bytesPerRow = (subRectangle.right - subRectangle.left) * bytesPerPixel;
@@ -661,26 +791,48 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
         ComArray<BYTE> array(destSizeInBytes);
 
-        byte* destRowStart = array.GetData();
-        byte* sourceRowStart = static_cast<byte*>(bitmapPixelAccess.GetLockedData());
-        for (unsigned int y = subRectangle.top; y < subRectangle.bottom; y++)
-        {
-            const unsigned int byteCount = (subRectangle.right - subRectangle.left) * bytesPerPixel;
+        CopyPixelRows(
+            bitmapPixelAccess.GetLockedData(),
+            bitmapPixelAccess.GetStride(),
+            array.GetData(),
+            bytesPerRow,
+            bytesPerRow,
+            subRectangle.bottom - subRectangle.top);
 
-            assert(destRowStart - array.GetData() < UINT_MAX);
-            const unsigned int positionInBuffer = static_cast<unsigned int>(destRowStart - array.GetData());
-            const unsigned int bytesLeftInBuffer = destSizeInBytes - positionInBuffer;
+        array.Detach(valueCount, valueElements);
+    }
 
-            memcpy_s(destRowStart, bytesLeftInBuffer, sourceRowStart, byteCount);
+    void GetPixelBytesAsyncImpl(
+        ICanvasDevice* device,
+        ComPtr<ID2D1Bitmap1> const& d2dBitmap,
+        D2D1_RECT_U const& subRectangle,
+        IAsyncOperation<IBuffer*>** operation)
+    {
+        CheckAndClearOutPointer(operation);
 
-            destRowStart += bytesPerRow;
-            sourceRowStart += bitmapPixelAccess.GetStride();
-        }
+        VerifyWellFormedSubrectangle(subRectangle, d2dBitmap->GetPixelSize());
 
-        array.Detach(valueCount, valueElements);
+        auto readback = GetPixelReadbackQueue(device)->Issue(d2dBitmap.Get(), GetStagingTexturePool(device), subRectangle);
+
+        // Don't leave the readback taking up a slot in the ring if we can't
+        // hand it back to the caller.
+        auto abandonReadback = MakeScopeWarden(
+            [&]
+            {
+                readback->RequestCancel();
+                readback->TryComplete(false);
+            });
+
+        auto asyncOperation = Make<PixelReadbackAsyncOperation>(readback);
+        CheckMakeResult(asyncOperation);
+
+        ThrowIfFailed(asyncOperation.CopyTo(operation));
+
+        abandonReadback.Dismiss();
     }
 
     void GetPixelColorsImpl(
+        ICanvasDevice* device,
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         D2D1_RECT_U const& subRectangle,
         uint32_t* valueCount,
@@ -696,33 +848,31 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ThrowHR(E_INVALIDARG, HStringReference(Strings::PixelColorsFormatRestriction).Get());
         }
 
-        ScopedBitmapMappedPixelAccess bitmapPixelAccess(d2dBitmap.Get(), D3D11_MAP_READ, &subRectangle);
+        ScopedBitmapMappedPixelAccess bitmapPixelAccess(d2dBitmap.Get(), GetStagingTexturePool(device), D3D11_MAP_READ, &subRectangle);
 
         const unsigned int subRectangleWidth = subRectangle.right - subRectangle.left;
         const unsigned int subRectangleHeight = subRectangle.bottom - subRectangle.top;
         const unsigned int destSizeInPixels = subRectangleWidth * subRectangleHeight;
         ComArray<Color> array(destSizeInPixels);
 
-        byte* sourceRowStart = static_cast<byte*>(bitmapPixelAccess.GetLockedData());
+        byte* sourceStart = static_cast<byte*>(bitmapPixelAccess.GetLockedData());
+        const unsigned int sourceStride = bitmapPixelAccess.GetStride();
+        Color* destStart = array.GetData();
 
-        for (unsigned int y = 0; y < subRectangleHeight; y++)
-        {
-            for (unsigned int x = 0; x < subRectangleWidth; x++)
+        ParallelForBytes(subRectangleHeight, subRectangleWidth * 4, 0,
+            [=](uint32_t firstRow, uint32_t rowCount)
             {
-                uint32_t sourcePixel = *(reinterpret_cast<uint32_t*>(&sourceRowStart[x * 4]));
-                Color& destColor = array[y * subRectangleWidth + x];
-                destColor.B = (sourcePixel >> 0) & 0xFF;
-                destColor.G = (sourcePixel >> 8) & 0xFF;
-                destColor.R = (sourcePixel >> 16) & 0xFF;
-                destColor.A = (sourcePixel >> 24) & 0xFF;
-            }
-            sourceRowStart += bitmapPixelAccess.GetStride();
-        }
+                for (unsigned int y = firstRow; y < firstRow + rowCount; y++)
+                {
+                    ConvertBgraPixelsToColors(sourceStart + y * sourceStride, destStart + y * subRectangleWidth, subRectangleWidth);
+                }
+            });
 
         array.Detach(valueCount, valueElements);
     }
 
     void SaveBitmapToFileImpl(
+        ICanvasDevice* device,
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         ICanvasBitmapResourceCreationAdapter* adapter,
         HSTRING rawfileName,
@@ -735,12 +885,17 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         float dpiX, dpiY;
         d2dBitmap->GetDpi(&dpiX, &dpiY);
 
-        auto bitmapPixelAccess = std::make_shared<ScopedBitmapMappedPixelAccess>(d2dBitmap.Get(), D3D11_MAP_READ);
+        //
+        // The pixels are copied out now, so that the D2D lock isn't held
+        // while the encoder runs.  This lets other threads keep using the
+        // device, and lets several bitmaps be encoded at once.
+        //
+        auto pixels = std::make_shared<BitmapPixelSnapshot>(d2dBitmap.Get(), GetStagingTexturePool(device), GetPixelBufferPool(device));
 
         auto asyncAction = Make<AsyncAction>(
             [=]
             {
-                adapter->SaveLockedMemoryToFile(
+                adapter->SavePixelSnapshotToFile(
                     fileName,
                     fileFormat,
                     quality,
@@ -748,7 +903,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     size.height,
                     dpiX,
                     dpiY,
-                    bitmapPixelAccess.get());
+                    pixels.get());
             });
 
         CheckMakeResult(asyncAction);
@@ -756,6 +911,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
     void SaveBitmapToStreamImpl(
+        ICanvasDevice* device,
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         ICanvasBitmapResourceCreationAdapter* adapter,
         IRandomAccessStream* stream,
@@ -772,12 +928,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         float dpiX, dpiY;
         d2dBitmap->GetDpi(&dpiX, &dpiY);
 
-        auto bitmapPixelAccess = std::make_shared<ScopedBitmapMappedPixelAccess>(d2dBitmap.Get(), D3D11_MAP_READ);
+        auto pixels = std::make_shared<BitmapPixelSnapshot>(d2dBitmap.Get(), GetStagingTexturePool(device), GetPixelBufferPool(device));
 
         auto asyncAction = Make<AsyncAction>(
             [=]
             {
-                adapter->SaveLockedMemoryToStream(
+                adapter->SavePixelSnapshotToStream(
                     stream,
                     fileFormat,
                     quality,
@@ -785,7 +941,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     size.height,
                     dpiX,
                     dpiY,
-                    bitmapPixelAccess.get());
+                    pixels.get());
             });
 
         CheckMakeResult(asyncAction);
@@ -793,6 +949,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     }
 
     void SetPixelBytesImpl(
+        ICanvasDevice* device,
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         D2D1_RECT_U const& subRectangle,
         uint32_t valueCount,
@@ -815,25 +972,19 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ThrowHR(E_INVALIDARG, message.Get());
         }
 
-        ScopedBitmapMappedPixelAccess bitmapPixelAccess(d2dBitmap.Get(), D3D11_MAP_WRITE, &subRectangle);
-
-        byte* destRowStart = static_cast<byte*>(bitmapPixelAccess.GetLockedData());
-        byte* sourceRowStart = valueElements;
-
-        for (unsigned int y = subRectangle.top; y < subRectangle.bottom; y++)
-        {
-            const unsigned int byteCount = (subRectangle.right - subRectangle.left) * bytesPerPixel;
-            const unsigned int positionInBuffer = static_cast<unsigned int>(sourceRowStart - valueElements);
-            const unsigned int bytesLeftInBuffer = valueCount - positionInBuffer;
-
-            memcpy_s(destRowStart, bytesLeftInBuffer, sourceRowStart, byteCount);
+        ScopedBitmapMappedPixelAccess bitmapPixelAccess(d2dBitmap.Get(), GetStagingTexturePool(device), D3D11_MAP_WRITE, &subRectangle);
 
-            destRowStart += bitmapPixelAccess.GetStride();
-            sourceRowStart += bytesPerRow;
-        }
+        CopyPixelRows(
+            valueElements,
+            bytesPerRow,
+            bitmapPixelAccess.GetLockedData(),
+            bitmapPixelAccess.GetStride(),
+            bytesPerRow,
+            subRectangleHeight);
     }
 
     void SetPixelColorsImpl(
+        ICanvasDevice* device,
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         D2D1_RECT_U const& subRectangle,
         uint32_t valueCount,
@@ -859,27 +1010,19 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ThrowHR(E_INVALIDARG, HStringReference(Strings::PixelColorsFormatRestriction).Get());
         }
 
-        ScopedBitmapMappedPixelAccess bitmapPixelAccess(d2dBitmap.Get(), D3D11_MAP_WRITE, &subRectangle);
+        ScopedBitmapMappedPixelAccess bitmapPixelAccess(d2dBitmap.Get(), GetStagingTexturePool(device), D3D11_MAP_WRITE, &subRectangle);
 
-        const unsigned int destSizeInPixels = subRectangleWidth * subRectangleHeight;
-        ComArray<Color> array(destSizeInPixels);
-
-        byte* destRowStart = static_cast<byte*>(bitmapPixelAccess.GetLockedData());
+        byte* destStart = static_cast<byte*>(bitmapPixelAccess.GetLockedData());
+        const unsigned int destStride = bitmapPixelAccess.GetStride();
 
-        for (unsigned int y = 0; y < subRectangleHeight; y++)
-        {
-            for (unsigned int x = 0; x < subRectangleWidth; x++)
+        ParallelForBytes(subRectangleHeight, subRectangleWidth * 4, 0,
+            [=](uint32_t firstRow, uint32_t rowCount)
             {
-                uint32_t* destPixel = reinterpret_cast<uint32_t*>(&destRowStart[x * 4]);
-                Color& sourceColor = valueElements[y * subRectangleWidth + x];
-                *destPixel = 
-                    (static_cast<uint32_t>(sourceColor.B) << 0) | 
-                    (static_cast<uint32_t>(sourceColor.G) << 8) |
-                    (static_cast<uint32_t>(sourceColor.R) << 16) |
-                    (static_cast<uint32_t>(sourceColor.A) << 24);
-            }
-            destRowStart += bitmapPixelAccess.GetStride();
-        }
+                for (unsigned int y = firstRow; y < firstRow + rowCount; y++)
+                {
+                    ConvertColorsToBgraPixels(valueElements + y * subRectangleWidth, destStart + y * destStride, subRectangleWidth);
+                }
+            });
     }
 
 
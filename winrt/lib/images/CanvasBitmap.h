@@ -35,7 +35,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         virtual ComPtr<IWICBitmapSource> CreateWICFormatConverter(HSTRING fileName) = 0;
         virtual ComPtr<IWICBitmapSource> CreateWICFormatConverter(IStream* fileStream) = 0;
 
-        virtual void SaveLockedMemoryToFile(
+        // Copies all of source's pixels into memory straight away.
+        virtual ComPtr<IWICBitmap> CreateWICBitmapFromSource(IWICBitmapSource* source) = 0;
+
+        virtual void SavePixelSnapshotToFile(
             HSTRING fileName,
             CanvasBitmapFileFormat fileFormat,
             float quality,
@@ -43,9 +46,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             unsigned int height,
             float dpiX,
             float dpiY,
-            ScopedBitmapMappedPixelAccess* bitmapLock) = 0;
+            BitmapPixelSnapshot* pixels) = 0;
 
-        virtual void SaveLockedMemoryToStream(
+        virtual void SavePixelSnapshotToStream(
             IRandomAccessStream* stream,
             CanvasBitmapFileFormat fileFormat,
             float quality,
@@ -53,7 +56,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             unsigned int height,
             float dpiX,
             float dpiY,
-            ScopedBitmapMappedPixelAccess* bitmapLock) = 0;
+            BitmapPixelSnapshot* pixels) = 0;
     };
     
 
@@ -216,6 +219,24 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             CanvasAlphaMode alpha,
             ABI::Windows::Foundation::IAsyncOperation<CanvasBitmap*>** canvasBitmapAsyncOperation) override;
 
+        IFACEMETHOD(LoadManyAsyncFromHstrings)(
+            ICanvasResourceCreator* resourceCreator,
+            ABI::Windows::Foundation::Collections::IIterable<HSTRING>* fileNames,
+            ABI::Windows::Foundation::IAsyncOperationWithProgress<ABI::Windows::Foundation::Collections::IVectorView<CanvasBitmap*>*, UINT32>** canvasBitmapsAsyncOperation) override;
+
+        IFACEMETHOD(LoadManyAsyncFromHstringsWithDpi)(
+            ICanvasResourceCreator* resourceCreator,
+            ABI::Windows::Foundation::Collections::IIterable<HSTRING>* fileNames,
+            float dpi,
+            ABI::Windows::Foundation::IAsyncOperationWithProgress<ABI::Windows::Foundation::Collections::IVectorView<CanvasBitmap*>*, UINT32>** canvasBitmapsAsyncOperation) override;
+
+        IFACEMETHOD(LoadManyAsyncFromHstringsWithDpiAndAlpha)(
+            ICanvasResourceCreator* resourceCreator,
+            ABI::Windows::Foundation::Collections::IIterable<HSTRING>* fileNames,
+            float dpi,
+            CanvasAlphaMode alpha,
+            ABI::Windows::Foundation::IAsyncOperationWithProgress<ABI::Windows::Foundation::Collections::IVectorView<CanvasBitmap*>*, UINT32>** canvasBitmapsAsyncOperation) override;
+
         //
         // ICanvasDeviceResourceFactoryNative
         //
@@ -227,18 +248,27 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     };
 
     void GetPixelBytesImpl(
+        ICanvasDevice* device,
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         D2D1_RECT_U const& subRectangle,
         uint32_t* valueCount,
         uint8_t** valueElements);
 
+    void GetPixelBytesAsyncImpl(
+        ICanvasDevice* device,
+        ComPtr<ID2D1Bitmap1> const& d2dBitmap,
+        D2D1_RECT_U const& subRectangle,
+        IAsyncOperation<IBuffer*>** operation);
+
     void GetPixelColorsImpl(
+        ICanvasDevice* device,
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         D2D1_RECT_U const& subRectangle,
         uint32_t* valueCount,
         Color **valueElements);
 
     void SaveBitmapToFileImpl(
+        ICanvasDevice* device,
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         ICanvasBitmapResourceCreationAdapter* adapter,
         HSTRING rawfileName,
@@ -247,6 +277,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         IAsyncAction **resultAsyncAction);
 
     void SaveBitmapToStreamImpl(
+        ICanvasDevice* device,
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         ICanvasBitmapResourceCreationAdapter* adapter,
         IRandomAccessStream* stream,
@@ -255,12 +286,14 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         IAsyncAction **resultAsyncAction);
 
     void SetPixelBytesImpl(
+        ICanvasDevice* device,
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         D2D1_RECT_U const& subRectangle,
         uint32_t valueCount,
         uint8_t* valueElements);
 
     void SetPixelColorsImpl(
+        ICanvasDevice* device,
         ComPtr<ID2D1Bitmap1> const& d2dBitmap,
         D2D1_RECT_U const& subRectangle,
         uint32_t valueCount,
@@ -516,6 +549,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     auto& d2dBitmap = GetResource();
 
                     SaveBitmapToFileImpl(
+                        m_device.Get(),
                         d2dBitmap.Get(), 
                         Manager()->GetAdapter(),
                         rawfileName, 
@@ -552,6 +586,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     auto& d2dBitmap = GetResource();
 
                     SaveBitmapToStreamImpl(
+                        m_device.Get(),
                         d2dBitmap.Get(), 
                         Manager()->GetAdapter(),
                         stream,
@@ -571,6 +606,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     auto& d2dBitmap = GetResource();
 
                     GetPixelBytesImpl(
+                        m_device.Get(),
                         d2dBitmap,
                         GetResourceBitmapExtents(d2dBitmap),
                         valueCount, 
@@ -592,6 +628,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     auto& d2dBitmap = GetResource();
 
                     GetPixelBytesImpl(
+                        m_device.Get(),
                         d2dBitmap,
                         ToD2DRectU(left, top, width, height),
                         valueCount, 
@@ -599,6 +636,42 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 });
         }
 
+        IFACEMETHODIMP GetPixelBytesAsync(
+            IAsyncOperation<IBuffer*>** operation) override
+        {
+            return ExceptionBoundary(
+                [&]
+                {
+                    auto& d2dBitmap = GetResource();
+
+                    GetPixelBytesAsyncImpl(
+                        m_device.Get(),
+                        d2dBitmap,
+                        GetResourceBitmapExtents(d2dBitmap),
+                        operation);
+                });
+        }
+
+        IFACEMETHODIMP GetPixelBytesWithSubrectangleAsync(
+            int32_t left,
+            int32_t top,
+            int32_t width,
+            int32_t height,
+            IAsyncOperation<IBuffer*>** operation) override
+        {
+            return ExceptionBoundary(
+                [&]
+                {
+                    auto& d2dBitmap = GetResource();
+
+                    GetPixelBytesAsyncImpl(
+                        m_device.Get(),
+                        d2dBitmap,
+                        ToD2DRectU(left, top, width, height),
+                        operation);
+                });
+        }
+
         IFACEMETHODIMP GetPixelColors(
             uint32_t* valueCount,
             ABI::Windows::UI::Color **valueElements) override
@@ -609,6 +682,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     auto& d2dBitmap = GetResource();
 
                     GetPixelColorsImpl(
+                        m_device.Get(),
                         d2dBitmap,
                         GetResourceBitmapExtents(d2dBitmap),
                         valueCount, 
@@ -630,6 +704,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     auto& d2dBitmap = GetResource();
 
                     GetPixelColorsImpl(
+                        m_device.Get(),
                         d2dBitmap,
                         ToD2DRectU(left, top, width, height),
                         valueCount, 
@@ -647,6 +722,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     auto& d2dBitmap = GetResource();
 
                     SetPixelBytesImpl(
+                        m_device.Get(),
                         d2dBitmap,
                         GetResourceBitmapExtents(d2dBitmap),
                         valueCount, 
@@ -668,6 +744,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     auto& d2dBitmap = GetResource();
 
                     SetPixelBytesImpl(
+                        m_device.Get(),
                         d2dBitmap,
                         ToD2DRectU(left, top, width, height),
                         valueCount, 
@@ -685,6 +762,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     auto& d2dBitmap = GetResource();
 
                     SetPixelColorsImpl(
+                        m_device.Get(),
                         d2dBitmap,
                         GetResourceBitmapExtents(d2dBitmap),
                         valueCount, 
@@ -706,6 +784,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     auto& d2dBitmap = GetResource();
 
                     SetPixelColorsImpl(
+                        m_device.Get(),
                         d2dBitmap,
                         ToD2DRectU(left, top, width, height),
                         valueCount, 
@@ -813,6 +892,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             float dpi,
             CanvasAlphaMode alpha);
 
+        // Uploads an image that has already been decoded by the adapter.
+        ComPtr<CanvasBitmap> CreateNew(
+            ICanvasDevice* canvasDevice,
+            IWICBitmapSource* decodedImage,
+            float dpi,
+            CanvasAlphaMode alpha);
+
         ComPtr<CanvasBitmap> CreateNew(
             ICanvasDevice* device,
             uint32_t byteCount,
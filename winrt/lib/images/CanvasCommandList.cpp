@@ -111,11 +111,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 auto& d2dCommandList = GetResource();
                 auto& device = m_device.EnsureNotClosed();
 
-                auto deviceContext = As<ICanvasDeviceInternal>(device)->CreateDeviceContext();
+                auto deviceInternal = As<ICanvasDeviceInternal>(device);
+                auto deviceContext = deviceInternal->AcquirePooledDeviceContext();
                 deviceContext->SetTarget(d2dCommandList.Get());
 
                 auto drawingSessionManager = CanvasDrawingSessionFactory::GetOrCreateManager();
-                auto adapter = std::make_shared<SimpleCanvasDrawingSessionAdapter>(deviceContext.Get());
+                auto adapter = std::make_shared<PooledCanvasDrawingSessionAdapter>(deviceInternal.Get(), deviceContext.Get());
 
                 auto ds = drawingSessionManager->Create(device.Get(), deviceContext.Get(), adapter);
 
@@ -243,9 +243,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         assert(targetBitmap != nullptr);
 
         //
-        // Create a new ID2D1DeviceContext
+        // Get an ID2D1DeviceContext from the device's pool
         //
-        auto deviceContext = As<ICanvasDeviceInternal>(owner)->CreateDeviceContext();
+        auto deviceInternal = As<ICanvasDeviceInternal>(owner);
+        auto deviceContext = deviceInternal->AcquirePooledDeviceContext();
 
         //
         // Set the target
@@ -259,7 +260,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         targetBitmap->GetDpi(&dpiX, &dpiY);
         deviceContext->SetDpi(dpiX, dpiY);
 
-        auto adapter = std::make_shared<SimpleCanvasDrawingSessionAdapter>(deviceContext.Get());
+        auto adapter = std::make_shared<PooledCanvasDrawingSessionAdapter>(deviceInternal.Get(), deviceContext.Get());
 
         auto drawingSessionManager = CanvasDrawingSessionFactory::GetOrCreateManager();
         return drawingSessionManager->Create(owner, deviceContext.Get(), adapter);
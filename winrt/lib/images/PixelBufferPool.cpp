@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "PixelBufferPool.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    PixelBufferPool::PixelBufferPool(uint64_t budgetInBytes)
+        : m_budgetInBytes(budgetInBytes)
+        , m_idleSizeInBytes(0)
+        , m_hitCount(0)
+        , m_missCount(0)
+    {
+    }
+
+    std::vector<uint8_t> PixelBufferPool::Acquire(size_t sizeInBytes)
+    {
+        std::vector<uint8_t> buffer;
+
+        {
+            Lock lock(m_mutex);
+
+            auto bestFit = m_idleBuffers.end();
+
+            for (auto it = m_idleBuffers.begin(); it != m_idleBuffers.end(); ++it)
+            {
+                if (it->capacity() < sizeInBytes)
+                    continue;
+
+                if (bestFit == m_idleBuffers.end() || it->capacity() < bestFit->capacity())
+                    bestFit = it;
+            }
+
+            if (bestFit != m_idleBuffers.end())
+            {
+                ++m_hitCount;
+
+                buffer = std::move(*bestFit);
+                m_idleSizeInBytes -= buffer.capacity();
+                m_idleBuffers.erase(bestFit);
+            }
+            else
+            {
+                ++m_missCount;
+            }
+        }
+
+        // Allocating (and zeroing) a new buffer can take a while, so happens
+        // outside the lock.
+        buffer.resize(sizeInBytes);
+
+        return buffer;
+    }
+
+    void PixelBufferPool::Release(std::vector<uint8_t>&& buffer)
+    {
+        if (buffer.capacity() == 0)
+            return;
+
+        Lock lock(m_mutex);
+
+        m_idleSizeInBytes += buffer.capacity();
+        m_idleBuffers.push_front(std::move(buffer));
+
+        TrimToBudget(lock);
+    }
+
+    void PixelBufferPool::Clear()
+    {
+        std::list<std::vector<uint8_t>> idleBuffers;
+
+        {
+            Lock lock(m_mutex);
+
+            idleBuffers.swap(m_idleBuffers);
+            m_idleSizeInBytes = 0;
+        }
+
+        // idleBuffers is freed here, outside the lock
+    }
+
+    uint64_t PixelBufferPool::GetHitCount()
+    {
+        Lock lock(m_mutex);
+        return m_hitCount;
+    }
+
+    uint64_t PixelBufferPool::GetMissCount()
+    {
+        Lock lock(m_mutex);
+        return m_missCount;
+    }
+
+    size_t PixelBufferPool::GetIdleBufferCount()
+    {
+        Lock lock(m_mutex);
+        return m_idleBuffers.size();
+    }
+
+    uint64_t PixelBufferPool::GetIdleSizeInBytes()
+    {
+        Lock lock(m_mutex);
+        return m_idleSizeInBytes;
+    }
+
+    void PixelBufferPool::TrimToBudget(Lock const& lock)
+    {
+        MustOwnLock(lock);
+
+        while (m_idleSizeInBytes > m_budgetInBytes)
+        {
+            assert(!m_idleBuffers.empty());
+
+            m_idleSizeInBytes -= m_idleBuffers.back().capacity();
+            m_idleBuffers.pop_back();
+        }
+    }
+}}}}
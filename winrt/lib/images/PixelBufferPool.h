@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "utils/LockUtilities.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Device-wide pool of CPU memory used to hold copies of bitmap pixels
+    // while SaveAsync encodes them, so that saving a bitmap every frame
+    // doesn't allocate and free a large block each time.
+    //
+    // Acquire hands out the smallest idle buffer that is big enough.  Idle
+    // buffers are kept until their total size goes over the memory budget,
+    // at which point the least recently used ones are freed.
+    //
+    class PixelBufferPool
+    {
+        std::mutex m_mutex;
+
+        uint64_t m_budgetInBytes;
+        std::list<std::vector<uint8_t>> m_idleBuffers;     // Most recently released first
+        uint64_t m_idleSizeInBytes;
+
+        uint64_t m_hitCount;
+        uint64_t m_missCount;
+
+    public:
+        static const uint64_t DefaultBudgetInBytes = 64 * 1024 * 1024;
+
+        explicit PixelBufferPool(uint64_t budgetInBytes = DefaultBudgetInBytes);
+
+        // Returns a buffer of exactly sizeInBytes, although its capacity may
+        // be larger.
+        std::vector<uint8_t> Acquire(size_t sizeInBytes);
+
+        void Release(std::vector<uint8_t>&& buffer);
+
+        void Clear();
+
+        uint64_t GetHitCount();
+        uint64_t GetMissCount();
+        size_t GetIdleBufferCount();
+        uint64_t GetIdleSizeInBytes();
+
+    private:
+        void TrimToBudget(Lock const& lock);
+    };
+}}}}
@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#include "pch.h"
+#include "PixelConversion.h"
+#include "utils/ParallelFor.h"
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#define PIXEL_CONVERSION_SSE2
+#elif defined(_M_ARM)
+#include <arm_neon.h>
+#define PIXEL_CONVERSION_NEON
+#endif
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using ABI::Windows::UI::Color;
+
+    static_assert(sizeof(Color) == 4, "Color must be the same size as a B8G8R8A8 pixel");
+    static_assert(offsetof(Color, A) == 0 &&
+                  offsetof(Color, R) == 1 &&
+                  offsetof(Color, G) == 2 &&
+                  offsetof(Color, B) == 3,
+                  "Color channels must be stored in the reverse order to B8G8R8A8");
+
+    void ReversePixelByteOrderScalar(void const* source, void* destination, uint32_t pixelCount)
+    {
+        auto sourceBytes = static_cast<uint8_t const*>(source);
+        auto destinationBytes = static_cast<uint8_t*>(destination);
+
+        for (uint32_t i = 0; i < pixelCount; i++)
+        {
+            destinationBytes[0] = sourceBytes[3];
+            destinationBytes[1] = sourceBytes[2];
+            destinationBytes[2] = sourceBytes[1];
+            destinationBytes[3] = sourceBytes[0];
+
+            sourceBytes += 4;
+            destinationBytes += 4;
+        }
+    }
+
+#if defined(PIXEL_CONVERSION_SSE2)
+
+    static __forceinline __m128i ReverseBytesInEachPixel(__m128i value)
+    {
+        // Swap the two 16 bit halves of each pixel...
+        value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+        value = _mm_shufflehi_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+
+        // ...then the two bytes within each half.
+        return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+    }
+
+    void ReversePixelByteOrder(void const* source, void* destination, uint32_t pixelCount)
+    {
+        auto sourceVectors = static_cast<__m128i const*>(source);
+        auto destinationVectors = static_cast<__m128i*>(destination);
+
+        uint32_t vectorCount = pixelCount / 4;
+
+        // Two vectors per iteration, to keep more loads in flight.
+        for (uint32_t i = 0; i < vectorCount / 2; i++)
+        {
+            __m128i a = _mm_loadu_si128(sourceVectors + 0);
+            __m128i b = _mm_loadu_si128(sourceVectors + 1);
+
+            _mm_storeu_si128(destinationVectors + 0, ReverseBytesInEachPixel(a));
+            _mm_storeu_si128(destinationVectors + 1, ReverseBytesInEachPixel(b));
+
+            sourceVectors += 2;
+            destinationVectors += 2;
+        }
+
+        if (vectorCount % 2)
+        {
+            _mm_storeu_si128(destinationVectors, ReverseBytesInEachPixel(_mm_loadu_si128(sourceVectors)));
+
+            sourceVectors++;
+            destinationVectors++;
+        }
+
+        ReversePixelByteOrderScalar(sourceVectors, destinationVectors, pixelCount % 4);
+    }
+
+#elif defined(PIXEL_CONVERSION_NEON)
+
+    void ReversePixelByteOrder(void const* source, void* destination, uint32_t pixelCount)
+    {
+        auto sourceBytes = static_cast<uint8_t const*>(source);
+        auto destinationBytes = static_cast<uint8_t*>(destination);
+
+        uint32_t vectorCount = pixelCount / 4;
+
+        for (uint32_t i = 0; i < vectorCount; i++)
+        {
+            vst1q_u8(destinationBytes, vrev32q_u8(vld1q_u8(sourceBytes)));
+
+            sourceBytes += 16;
+            destinationBytes += 16;
+        }
+
+        ReversePixelByteOrderScalar(sourceBytes, destinationBytes, pixelCount % 4);
+    }
+
+#else
+
+    void ReversePixelByteOrder(void const* source, void* destination, uint32_t pixelCount)
+    {
+        ReversePixelByteOrderScalar(source, destination, pixelCount);
+    }
+
+#endif
+
+
+    void CopyPixelRows(
+        void const* source,
+        uint32_t sourceStride,
+        void* destination,
+        uint32_t destinationStride,
+        uint32_t bytesPerRow,
+        uint32_t rowCount,
+        unsigned maxThreadCount)
+    {
+        assert(bytesPerRow <= sourceStride || rowCount <= 1);
+        assert(bytesPerRow <= destinationStride || rowCount <= 1);
+
+        auto sourceBytes = static_cast<uint8_t const*>(source);
+        auto destinationBytes = static_cast<uint8_t*>(destination);
+
+        bool isTightlyPacked = (sourceStride == bytesPerRow && destinationStride == bytesPerRow);
+
+        ParallelForBytes(rowCount, bytesPerRow, maxThreadCount,
+            [=](uint32_t firstRow, uint32_t bandRowCount)
+            {
+                auto sourceRow = sourceBytes + static_cast<size_t>(firstRow) * sourceStride;
+                auto destinationRow = destinationBytes + static_cast<size_t>(firstRow) * destinationStride;
+
+                if (isTightlyPacked)
+                {
+                    // The whole band is contiguous, so can be copied in one go.
+                    memcpy(destinationRow, sourceRow, static_cast<size_t>(bandRowCount) * bytesPerRow);
+                    return;
+                }
+
+                for (uint32_t y = 0; y < bandRowCount; y++)
+                {
+                    memcpy(destinationRow, sourceRow, bytesPerRow);
+
+                    sourceRow += sourceStride;
+                    destinationRow += destinationStride;
+                }
+            });
+    }
+}}}}
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Conversion between arrays of Windows::UI::Color and B8G8R8A8 pixels.
+    //
+    // Color stores its channels in A, R, G, B order, while the pixel format
+    // stores them as B, G, R, A, so in both directions the conversion
+    // reverses the order of the four bytes that make up each pixel.  This is
+    // vectorized with SSE2 on x86/x64 and NEON on ARM.
+    //
+    // Source and destination may be unaligned, but must not overlap.
+    //
+
+    void ReversePixelByteOrder(void const* source, void* destination, uint32_t pixelCount);
+
+    // Portable reference implementation, which ReversePixelByteOrder uses
+    // for any pixels left over after its vector loop.
+    void ReversePixelByteOrderScalar(void const* source, void* destination, uint32_t pixelCount);
+
+    inline void ConvertColorsToBgraPixels(ABI::Windows::UI::Color const* colors, void* pixels, uint32_t pixelCount)
+    {
+        ReversePixelByteOrder(colors, pixels, pixelCount);
+    }
+
+    inline void ConvertBgraPixelsToColors(void const* pixels, ABI::Windows::UI::Color* colors, uint32_t pixelCount)
+    {
+        ReversePixelByteOrder(pixels, colors, pixelCount);
+    }
+
+
+    // Copies rows between buffers with different strides, using ParallelForBytes.
+    void CopyPixelRows(
+        void const* source,
+        uint32_t sourceStride,
+        void* destination,
+        uint32_t destinationStride,
+        uint32_t bytesPerRow,
+        uint32_t rowCount,
+        unsigned maxThreadCount = 0);
+}}}}
@@ -0,0 +1,397 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "PixelReadbackQueue.h"
+#include "PixelConversion.h"
+#include "TextureUtilities.h"
+#include "utils/D2DResourceLock.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    // WaitForResult normally wakes up when the GPU sets the ready event, but
+    // also checks on the readback this often in case it never does (for
+    // example, if the device is removed).
+    static const DWORD BackstopIntervalInMs = 100;
+
+    static bool IsMultithreadProtected(ID2D1Resource* d2dResource)
+    {
+        ComPtr<ID2D1Factory> d2dFactory;
+        d2dResource->GetFactory(&d2dFactory);
+
+        return !!As<ID2D1Multithread>(d2dFactory)->GetMultithreadProtected();
+    }
+
+    PixelReadback::PixelReadback(
+        std::shared_ptr<PixelReadbackQueue> const& queue,
+        ID2D1Bitmap1* d2dBitmap,
+        std::shared_ptr<StagingTexturePool> const& stagingTexturePool,
+        D2D1_RECT_U const& subRectangle)
+        : m_queue(queue)
+        , m_d2dBitmap(d2dBitmap)
+        , m_stagingTexturePool(stagingTexturePool)
+        , m_height(subRectangle.bottom - subRectangle.top)
+        , m_issueTime(PixelReadbackQueue::GetTimestamp())
+        , m_isCancelRequested(false)
+        , m_readyEvent(CreateEventEx(nullptr, nullptr, CREATE_EVENT_MANUAL_RESET, EVENT_ALL_ACCESS))
+        , m_state(State::InFlight)
+        , m_errorCode(S_OK)
+    {
+        if (!m_readyEvent.IsValid())
+            ThrowHR(HRESULT_FROM_WIN32(GetLastError()));
+
+        const uint32_t width = subRectangle.right - subRectangle.left;
+
+        ComPtr<IDXGISurface> dxgiSurface;
+        ThrowIfFailed(d2dBitmap->GetSurface(&dxgiSurface));
+
+        uint32_t subresourceIndex;
+        auto bitmapTexture = GetTexture2DForDXGISurface(As<IDXGISurface2>(dxgiSurface), &subresourceIndex);
+
+        D3D11_TEXTURE2D_DESC textureDescription;
+        bitmapTexture->GetDesc(&textureDescription);
+
+        m_bytesPerRow = width * GetBytesPerPixel(textureDescription.Format);
+
+        ComPtr<ID3D11Device> d3dDevice;
+        bitmapTexture->GetDevice(&d3dDevice);
+        d3dDevice->GetImmediateContext(&m_immediateContext);
+
+        if (m_stagingTexturePool)
+            m_stagingTexture = m_stagingTexturePool->Acquire(d3dDevice.Get(), textureDescription.Format, width, m_height, D3D11_CPU_ACCESS_READ);
+        else
+            m_stagingTexture = StagingTexturePool::CreateTexture(d3dDevice.Get(), textureDescription.Format, width, m_height, D3D11_CPU_ACCESS_READ);
+
+        D2DResourceLock lock(d2dBitmap);
+
+        D3D11_BOX sourceBox;
+        sourceBox.left = subRectangle.left;
+        sourceBox.top = subRectangle.top;
+        sourceBox.right = subRectangle.right;
+        sourceBox.bottom = subRectangle.bottom;
+        sourceBox.front = 0;
+        sourceBox.back = 1;
+
+        m_immediateContext->CopySubresourceRegion(
+            m_stagingTexture.Get(),
+            0, // Dest subresource
+            0, // Dest X
+            0, // Dest Y
+            0, // Dest Z
+            bitmapTexture.Get(),
+            subresourceIndex,
+            &sourceBox);
+
+        // This also flushes the context, so the copy starts now rather than
+        // whenever the context next happens to be flushed.
+        ThrowIfFailed(As<IDXGIDevice2>(d3dDevice)->EnqueueSetEvent(m_readyEvent.Get()));
+    }
+
+    bool PixelReadback::TryComplete(bool wait)
+    {
+        D2DResourceLock lock(m_d2dBitmap.Get());
+
+        if (m_state != State::InFlight)
+            return true;
+
+        if (m_isCancelRequested)
+        {
+            Finish(State::Canceled);
+            return true;
+        }
+
+        D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+
+        HRESULT hr = m_immediateContext->Map(
+            m_stagingTexture.Get(),
+            0, // staging texture doesn't have any subresources
+            D3D11_MAP_READ,
+            wait ? 0 : D3D11_MAP_FLAG_DO_NOT_WAIT,
+            &mappedSubresource);
+
+        if (hr == DXGI_ERROR_WAS_STILL_DRAWING)
+            return false;
+
+        if (FAILED(hr))
+        {
+            Finish(State::Failed, hr);
+            return true;
+        }
+
+        hr = ExceptionBoundary(
+            [&]
+            {
+                auto buffer = Make<ByteBuffer>(m_bytesPerRow * m_height);
+                CheckMakeResult(buffer);
+
+                CopyPixelRows(
+                    mappedSubresource.pData,
+                    mappedSubresource.RowPitch,
+                    buffer->GetData(),
+                    m_bytesPerRow,
+                    m_bytesPerRow,
+                    m_height);
+
+                m_result = buffer;
+            });
+
+        m_immediateContext->Unmap(m_stagingTexture.Get(), 0);
+
+        if (FAILED(hr))
+            Finish(State::Failed, hr);
+        else
+            Finish(State::Completed);
+
+        return true;
+    }
+
+    void PixelReadback::RequestCancel()
+    {
+        m_isCancelRequested = true;
+        SetEvent(m_readyEvent.Get());
+    }
+
+    void PixelReadback::WaitUntilFinished()
+    {
+        for (;;)
+        {
+            auto waitResult = WaitForSingleObjectEx(m_readyEvent.Get(), BackstopIntervalInMs, FALSE);
+
+            if (waitResult == WAIT_FAILED)
+                ThrowHR(HRESULT_FROM_WIN32(GetLastError()));
+
+            // Once the event is set the GPU has finished the copy, so mapping
+            // the staging texture won't block while holding the D2D lock.
+            if (TryComplete(waitResult == WAIT_OBJECT_0))
+                return;
+        }
+    }
+
+    ComPtr<IBuffer> PixelReadback::WaitForResult()
+    {
+        WaitUntilFinished();
+
+        D2DResourceLock lock(m_d2dBitmap.Get());
+
+        switch (m_state)
+        {
+        case State::Completed:
+            return m_result;
+
+        case State::Failed:
+            ThrowHR(m_errorCode);
+
+        default:
+            return nullptr;
+        }
+    }
+
+    PixelReadback::State PixelReadback::GetState()
+    {
+        D2DResourceLock lock(m_d2dBitmap.Get());
+        return m_state;
+    }
+
+    void PixelReadback::Finish(State state, HRESULT errorCode)
+    {
+        assert(m_state == State::InFlight);
+        assert(state != State::InFlight);
+
+        m_state = state;
+        m_errorCode = errorCode;
+
+        // The texture may still be the target of a copy if this was canceled,
+        // but anything else that uses it is queued up behind that copy.
+        if (m_stagingTexturePool)
+            m_stagingTexturePool->Release(m_stagingTexture.Get());
+
+        m_stagingTexture.Reset();
+
+        // Breaks the reference cycle between us and the queue
+        auto queue = std::move(m_queue);
+        queue->OnFinished(this, state, PixelReadbackQueue::GetTimestamp() - m_issueTime);
+    }
+
+
+    PixelReadbackQueue::PixelReadbackQueue()
+        : m_maximumInFlightCount(DefaultMaximumInFlightCount)
+        , m_completedCount(0)
+        , m_canceledCount(0)
+        , m_failedCount(0)
+        , m_stallCount(0)
+        , m_peakInFlightCount(0)
+        , m_totalLatency(0)
+        , m_maximumLatency(0)
+    {
+    }
+
+    std::shared_ptr<PixelReadback> PixelReadbackQueue::Issue(
+        ID2D1Bitmap1* d2dBitmap,
+        std::shared_ptr<StagingTexturePool> const& stagingTexturePool,
+        D2D1_RECT_U const& subRectangle)
+    {
+        bool stalled = false;
+
+        for (;;)
+        {
+            stalled |= WaitUntilThereIsRoom();
+
+            // Only take the D2D lock once there is room, so it is never held
+            // while waiting for the GPU.  Another thread may have taken the
+            // space in the meantime, in which case we go back to waiting.
+            D2DResourceLock d2dLock(d2dBitmap);
+
+            {
+                Lock lock(m_mutex);
+
+                if (m_inFlight.size() >= m_maximumInFlightCount)
+                    continue;
+
+                if (stalled)
+                    ++m_stallCount;
+            }
+
+            auto readback = std::make_shared<PixelReadback>(shared_from_this(), d2dBitmap, stagingTexturePool, subRectangle);
+
+            {
+                Lock lock(m_mutex);
+
+                m_inFlight.push_back(readback);
+                m_peakInFlightCount = std::max(m_peakInFlightCount, static_cast<uint32_t>(m_inFlight.size()));
+            }
+
+            // Without the D2D lock there is no safe way to read the pixels back
+            // from another thread, so do it now.
+            if (!IsMultithreadProtected(d2dBitmap))
+                readback->TryComplete(true);
+
+            return readback;
+        }
+    }
+
+    bool PixelReadbackQueue::WaitUntilThereIsRoom()
+    {
+        bool stalled = false;
+
+        for (;;)
+        {
+            std::shared_ptr<PixelReadback> oldest;
+
+            {
+                Lock lock(m_mutex);
+
+                if (m_inFlight.size() < m_maximumInFlightCount)
+                    return stalled;
+
+                oldest = m_inFlight.front();
+            }
+
+            stalled = true;
+            oldest->WaitUntilFinished();
+        }
+    }
+
+    uint32_t PixelReadbackQueue::GetMaximumInFlightCount()
+    {
+        Lock lock(m_mutex);
+        return m_maximumInFlightCount;
+    }
+
+    void PixelReadbackQueue::SetMaximumInFlightCount(uint32_t value)
+    {
+        assert(value > 0);
+
+        Lock lock(m_mutex);
+        m_maximumInFlightCount = value;
+    }
+
+    CanvasPixelReadbackStatistics PixelReadbackQueue::GetStatistics()
+    {
+        Lock lock(m_mutex);
+
+        CanvasPixelReadbackStatistics statistics{};
+
+        statistics.CompletedCount = static_cast<int64_t>(m_completedCount);
+        statistics.CanceledCount = static_cast<int64_t>(m_canceledCount);
+        statistics.FailedCount = static_cast<int64_t>(m_failedCount);
+        statistics.StallCount = static_cast<int64_t>(m_stallCount);
+        statistics.InFlightCount = static_cast<int32_t>(m_inFlight.size());
+        statistics.PeakInFlightCount = static_cast<int32_t>(m_peakInFlightCount);
+
+        if (m_completedCount > 0)
+            statistics.AverageLatency.Duration = m_totalLatency / static_cast<int64_t>(m_completedCount);
+
+        statistics.MaximumLatency.Duration = m_maximumLatency;
+
+        return statistics;
+    }
+
+    int64_t PixelReadbackQueue::GetTimestamp()
+    {
+        static LARGE_INTEGER frequency = []
+        {
+            LARGE_INTEGER value;
+            QueryPerformanceFrequency(&value);
+            return value;
+        }();
+
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+
+        // Split into whole seconds and the remainder so as not to overflow.
+        const int64_t ticksPerSecond = 10000000;
+        auto seconds = counter.QuadPart / frequency.QuadPart;
+        auto remainder = counter.QuadPart % frequency.QuadPart;
+
+        return seconds * ticksPerSecond + remainder * ticksPerSecond / frequency.QuadPart;
+    }
+
+    void PixelReadbackQueue::OnFinished(PixelReadback* readback, PixelReadback::State state, int64_t latency)
+    {
+        Lock lock(m_mutex);
+
+        auto it = std::find_if(m_inFlight.begin(), m_inFlight.end(),
+            [=](std::shared_ptr<PixelReadback> const& inFlight)
+            {
+                return inFlight.get() == readback;
+            });
+
+        // Hold on to the readback until we've released the lock, in case ours
+        // is the last reference to it.
+        std::shared_ptr<PixelReadback> finished;
+
+        if (it != m_inFlight.end())
+        {
+            finished = std::move(*it);
+            m_inFlight.erase(it);
+        }
+
+        switch (state)
+        {
+        case PixelReadback::State::Completed:
+            ++m_completedCount;
+            m_totalLatency += latency;
+            m_maximumLatency = std::max(m_maximumLatency, latency);
+            break;
+
+        case PixelReadback::State::Canceled:
+            ++m_canceledCount;
+            break;
+
+        case PixelReadback::State::Failed:
+            ++m_failedCount;
+            break;
+        }
+
+        lock.unlock();
+    }
+}}}}
@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "utils/ByteBuffer.h"
+#include "utils/LockUtilities.h"
+#include "StagingTexturePool.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    class PixelReadbackQueue;
+
+    //
+    // A single GetPixelBytesAsync request.  The GPU copy from the bitmap into
+    // a staging texture is issued as soon as this is created, and the pixels
+    // are read out of the staging texture once the GPU has caught up, so the
+    // thread that asked for them never waits for the GPU to finish its work.
+    //
+    // All access to the staging texture happens under the D2D lock, as it
+    // goes through the device's immediate context.
+    //
+    // m_readyEvent is set by the GPU once the copy has finished (through
+    // IDXGIDevice2::EnqueueSetEvent), or by RequestCancel, so WaitForResult
+    // can sleep until there is something to do rather than polling.
+    //
+    class PixelReadback : private LifespanTracker<PixelReadback>
+    {
+    public:
+        enum class State
+        {
+            InFlight,
+            Completed,
+            Canceled,
+            Failed
+        };
+
+    private:
+        std::shared_ptr<PixelReadbackQueue> m_queue;
+        ComPtr<ID2D1Bitmap1> m_d2dBitmap;
+        std::shared_ptr<StagingTexturePool> m_stagingTexturePool;
+        ComPtr<ID3D11DeviceContext> m_immediateContext;
+        ComPtr<ID3D11Texture2D> m_stagingTexture;
+        uint32_t m_bytesPerRow;
+        uint32_t m_height;
+        int64_t m_issueTime;
+
+        std::atomic<bool> m_isCancelRequested;
+        ::Microsoft::WRL::Wrappers::Event m_readyEvent;
+
+        // Guarded by the D2D lock
+        State m_state;
+        HRESULT m_errorCode;
+        ComPtr<ByteBuffer> m_result;
+
+    public:
+        // Issues the copy.  subRectangle must already have been validated.
+        PixelReadback(
+            std::shared_ptr<PixelReadbackQueue> const& queue,
+            ID2D1Bitmap1* d2dBitmap,
+            std::shared_ptr<StagingTexturePool> const& stagingTexturePool,
+            D2D1_RECT_U const& subRectangle);
+
+        //
+        // Reads the pixels back if the GPU has finished copying them.  If it
+        // hasn't, this waits for it when wait is true, or returns false
+        // straight away otherwise.  Returns true once the readback has
+        // finished, whether it completed, failed or was canceled.
+        //
+        bool TryComplete(bool wait);
+
+        //
+        // Asks for the readback to be abandoned.  The pixels are not read
+        // back if this happens before the GPU finishes copying them.
+        //
+        void RequestCancel();
+
+        //
+        // Waits until the readback has finished, whether it completed, failed
+        // or was canceled, without ever blocking on the GPU while holding the
+        // D2D lock.
+        //
+        void WaitUntilFinished();
+
+        //
+        // Waits until the readback has finished.  Returns the pixels, or null
+        // if the readback was canceled.  Throws if it failed.
+        //
+        ComPtr<IBuffer> WaitForResult();
+
+        State GetState();
+
+    private:
+        void Finish(State state, HRESULT errorCode = S_OK);
+    };
+
+
+    //
+    // Device-wide ring of GetPixelBytesAsync readbacks that have been issued
+    // but not yet read back.  At most MaximumInFlightCount readbacks can be in
+    // flight at a time: issuing another when the ring is full waits for the
+    // oldest to finish first, which bounds both the amount of staging memory
+    // in use and how far behind the GPU the app can get.  That wait happens
+    // without holding the D2D lock, so other threads can carry on using the
+    // device while the GPU catches up.
+    //
+    // Also keeps the latency and queue depth statistics that CanvasDevice
+    // reports through GetPixelReadbackStatistics.
+    //
+    class PixelReadbackQueue : public std::enable_shared_from_this<PixelReadbackQueue>
+    {
+        std::mutex m_mutex;
+
+        uint32_t m_maximumInFlightCount;
+        std::deque<std::shared_ptr<PixelReadback>> m_inFlight;     // Oldest first
+
+        uint64_t m_completedCount;
+        uint64_t m_canceledCount;
+        uint64_t m_failedCount;
+        uint64_t m_stallCount;
+        uint32_t m_peakInFlightCount;
+        int64_t m_totalLatency;
+        int64_t m_maximumLatency;
+
+    public:
+        static const uint32_t DefaultMaximumInFlightCount = 3;
+
+        PixelReadbackQueue();
+
+        std::shared_ptr<PixelReadback> Issue(
+            ID2D1Bitmap1* d2dBitmap,
+            std::shared_ptr<StagingTexturePool> const& stagingTexturePool,
+            D2D1_RECT_U const& subRectangle);
+
+        uint32_t GetMaximumInFlightCount();
+        void SetMaximumInFlightCount(uint32_t value);
+
+        CanvasPixelReadbackStatistics GetStatistics();
+
+        // Times are in 100ns units, to match Windows.Foundation.TimeSpan.
+        static int64_t GetTimestamp();
+
+    private:
+        friend class PixelReadback;
+
+        // Returns true if it had to wait.
+        bool WaitUntilThereIsRoom();
+
+        void OnFinished(PixelReadback* readback, PixelReadback::State state, int64_t latency);
+    };
+
+
+    //
+    // The IAsyncOperation returned by GetPixelBytesAsync.  Waits for the
+    // readback on the thread pool, and passes cancellation on to it.
+    //
+    class PixelReadbackAsyncOperation : public AsyncOperation<IBuffer>
+    {
+        std::shared_ptr<PixelReadback> m_readback;
+
+    public:
+        PixelReadbackAsyncOperation(std::shared_ptr<PixelReadback> const& readback)
+            : AsyncOperation(
+                [readback]
+                {
+                    return readback->WaitForResult();
+                })
+            , m_readback(readback)
+        {
+        }
+
+    protected:
+        virtual void OnCancel() override
+        {
+            m_readback->RequestCancel();
+        }
+    };
+}}}}
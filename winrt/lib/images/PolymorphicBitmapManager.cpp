@@ -76,7 +76,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         ThrowHR(E_INVALIDARG, message.Get());
     }
 
-    void SaveLockedMemoryToNativeStream(
+    void SavePixelSnapshotToNativeStream(
         IWICImagingFactory2* wicFactory,
         IWICStream* nativeStream,
         GUID encoderGuid,
@@ -85,7 +85,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         unsigned int height,
         float dpiX,
         float dpiY,
-        ScopedBitmapMappedPixelAccess* bitmapLock)
+        BitmapPixelSnapshot* pixels)
     {
         ComPtr<IWICBitmapEncoder> encoder;
         ThrowIfFailed(wicFactory->CreateEncoder(encoderGuid, NULL, &encoder));
@@ -125,9 +125,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             width,
             height,
             GUID_WICPixelFormat32bppBGRA,
-            bitmapLock->GetStride(),
-            bitmapLock->GetLockedBufferSize(),
-            static_cast<BYTE*>(bitmapLock->GetLockedData()),
+            pixels->GetStride(),
+            pixels->GetBufferSize(),
+            pixels->GetData(),
             &memoryBitmap));
 
         WICPixelFormatGUID pixelFormat;
@@ -157,7 +157,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 IID_PPV_ARGS(&m_wicFactory)));
         }
 
-        void SaveLockedMemoryToStream(
+        void SavePixelSnapshotToStream(
             IRandomAccessStream* randomAccessStream,
             CanvasBitmapFileFormat fileFormat,
             float quality,
@@ -165,7 +165,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             unsigned int height,
             float dpiX,
             float dpiY,
-            ScopedBitmapMappedPixelAccess* bitmapLock)
+            BitmapPixelSnapshot* pixels)
         {
             ComPtr<IWICStream> wicStream;
             ThrowIfFailed(m_wicFactory->CreateStream(&wicStream));
@@ -175,7 +175,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
             ThrowIfFailed(wicStream->InitializeFromIStream(iStream.Get()));
 
-            SaveLockedMemoryToNativeStream(
+            SavePixelSnapshotToNativeStream(
                 m_wicFactory.Get(), 
                 wicStream.Get(), 
                 GetGUIDForFileFormat(fileFormat),
@@ -184,10 +184,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 height, 
                 dpiX,
                 dpiY, 
-                bitmapLock);
+                pixels);
         }
 
-        void SaveLockedMemoryToFile(
+        void SavePixelSnapshotToFile(
             HSTRING fileName,
             CanvasBitmapFileFormat fileFormat,
             float quality,
@@ -195,7 +195,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             unsigned int height,
             float dpiX,
             float dpiY,
-            ScopedBitmapMappedPixelAccess* bitmapLock)
+            BitmapPixelSnapshot* pixels)
         {
             WinString fileNameString(fileName);
 
@@ -214,7 +214,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
             ThrowIfFailed(wicStream->InitializeFromFilename(static_cast<const wchar_t*>(fileNameString), GENERIC_WRITE));
 
-            SaveLockedMemoryToNativeStream(
+            SavePixelSnapshotToNativeStream(
                 m_wicFactory.Get(),
                 wicStream.Get(), 
                 encoderGuid, 
@@ -223,7 +223,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 height, 
                 dpiX, 
                 dpiY, 
-                bitmapLock);
+                pixels);
         }
 
         UINT GetOrientationFromFrameDecode(ComPtr<IWICBitmapFrameDecode> const& frameDecode)
@@ -362,6 +362,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
             return ApplyRotationIfNeeded(wicBitmapFrameSource, wicFormatConverter);
         }
+
+        ComPtr<IWICBitmap> CreateWICBitmapFromSource(IWICBitmapSource* source)
+        {
+            ComPtr<IWICBitmap> bitmap;
+            ThrowIfFailed(m_wicFactory->CreateBitmapFromSource(source, WICBitmapCacheOnLoad, &bitmap));
+            return bitmap;
+        }
     };
 
 
@@ -371,6 +378,24 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
     {
     }
 
+    ComPtr<IWICBitmap> PolymorphicBitmapManager::DecodeBitmapFile(HSTRING fileName)
+    {
+        auto adapter = m_bitmapManager->GetAdapter();
+
+        auto source = adapter->CreateWICFormatConverter(fileName);
+
+        //
+        // The default adapter already caches the converted pixels in an
+        // IWICBitmap created with WICBitmapCacheOnLoad, in which case there
+        // is nothing more to do.  Anything else decodes lazily, so is copied
+        // into memory here rather than by whoever uploads it.
+        //
+        if (auto bitmap = MaybeAs<IWICBitmap>(source))
+            return bitmap;
+
+        return adapter->CreateWICBitmapFromSource(source.Get());
+    }
+
     static ComPtr<ID2D1Bitmap1> CreateD2DBitmap(
         ICanvasDevice* canvasDevice, 
         IDirect3DSurface* surface,
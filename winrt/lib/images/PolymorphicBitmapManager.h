@@ -61,6 +61,13 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             return m_renderTargetManager->Create(args...);
         }
 
+        //
+        // Decodes all of an image file's pixels into memory, ready to be
+        // passed to CreateBitmap.  This lets LoadManyAsync decode several
+        // files at once while only uploading them one at a time.
+        //
+        ComPtr<IWICBitmap> DecodeBitmapFile(HSTRING fileName);
+
         ComPtr<ICanvasBitmap> CreateBitmapFromSurface(ICanvasDevice* device, IDirect3DSurface* surface, float dpi, CanvasAlphaMode alpha);
         ComPtr<CanvasRenderTarget> CreateRenderTargetFromSurface(ICanvasDevice* device, IDirect3DSurface* surface, float dpi, CanvasAlphaMode alpha);
 
@@ -0,0 +1,168 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "StagingTexturePool.h"
+#include "TextureUtilities.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    StagingTexturePool::StagingTexturePool(uint64_t budgetInBytes)
+        : m_budgetInBytes(budgetInBytes)
+        , m_idleSizeInBytes(0)
+        , m_hitCount(0)
+        , m_missCount(0)
+    {
+    }
+
+    ComPtr<ID3D11Texture2D> StagingTexturePool::Acquire(
+        ID3D11Device* d3dDevice,
+        DXGI_FORMAT format,
+        uint32_t width,
+        uint32_t height,
+        UINT cpuAccessFlags)
+    {
+        auto key = MakeKey(format, width, height, cpuAccessFlags);
+
+        {
+            Lock lock(m_mutex);
+
+            auto it = std::find_if(m_idleEntries.begin(), m_idleEntries.end(),
+                [&](Entry const& entry)
+                {
+                    return entry.Key == key;
+                });
+
+            if (it != m_idleEntries.end())
+            {
+                ++m_hitCount;
+
+                auto texture = it->Texture;
+                m_idleSizeInBytes -= it->SizeInBytes;
+                m_idleEntries.erase(it);
+
+                return texture;
+            }
+
+            ++m_missCount;
+        }
+
+        // Creating the texture can take a while, so happens outside the lock.
+        return CreateTexture(d3dDevice, key.Format, key.Width, key.Height, key.CpuAccessFlags);
+    }
+
+    void StagingTexturePool::Release(ID3D11Texture2D* texture)
+    {
+        assert(texture);
+
+        D3D11_TEXTURE2D_DESC description;
+        texture->GetDesc(&description);
+
+        TextureKey key{ description.Format, description.Width, description.Height, description.CPUAccessFlags };
+        auto sizeInBytes = GetSizeInBytes(key);
+
+        Lock lock(m_mutex);
+
+        m_idleEntries.push_front(Entry{ key, texture, sizeInBytes });
+        m_idleSizeInBytes += sizeInBytes;
+
+        TrimToBudget(lock);
+    }
+
+    void StagingTexturePool::Clear()
+    {
+        Lock lock(m_mutex);
+
+        m_idleEntries.clear();
+        m_idleSizeInBytes = 0;
+    }
+
+    ComPtr<ID3D11Texture2D> StagingTexturePool::CreateTexture(
+        ID3D11Device* d3dDevice,
+        DXGI_FORMAT format,
+        uint32_t width,
+        uint32_t height,
+        UINT cpuAccessFlags)
+    {
+        D3D11_TEXTURE2D_DESC description{};
+        description.Width = width;
+        description.Height = height;
+        description.MipLevels = 1;
+        description.ArraySize = 1;
+        description.Format = format;
+        description.SampleDesc.Count = 1;
+        description.Usage = D3D11_USAGE_STAGING;
+        description.CPUAccessFlags = cpuAccessFlags;
+
+        ComPtr<ID3D11Texture2D> texture;
+        ThrowIfFailed(d3dDevice->CreateTexture2D(&description, nullptr, &texture));
+
+        return texture;
+    }
+
+    uint64_t StagingTexturePool::GetHitCount()
+    {
+        Lock lock(m_mutex);
+        return m_hitCount;
+    }
+
+    uint64_t StagingTexturePool::GetMissCount()
+    {
+        Lock lock(m_mutex);
+        return m_missCount;
+    }
+
+    size_t StagingTexturePool::GetIdleTextureCount()
+    {
+        Lock lock(m_mutex);
+        return m_idleEntries.size();
+    }
+
+    uint64_t StagingTexturePool::GetIdleSizeInBytes()
+    {
+        Lock lock(m_mutex);
+        return m_idleSizeInBytes;
+    }
+
+    StagingTexturePool::TextureKey StagingTexturePool::MakeKey(DXGI_FORMAT format, uint32_t width, uint32_t height, UINT cpuAccessFlags)
+    {
+        auto roundUp = [](uint32_t value) { return (value + SizeStep - 1) / SizeStep * SizeStep; };
+
+        return TextureKey{ format, roundUp(width), roundUp(height), cpuAccessFlags };
+    }
+
+    uint64_t StagingTexturePool::GetSizeInBytes(TextureKey const& key)
+    {
+        // Formats without a simple per-pixel size (ie. block-compressed ones)
+        // are charged as if they were the largest format we know about, which
+        // over-estimates their size.
+        uint64_t bytesPerPixel = TryGetBytesPerPixel(key.Format);
+
+        if (bytesPerPixel == 0)
+            bytesPerPixel = 16;
+
+        return bytesPerPixel * key.Width * key.Height;
+    }
+
+    void StagingTexturePool::TrimToBudget(Lock const& lock)
+    {
+        MustOwnLock(lock);
+
+        while (m_idleSizeInBytes > m_budgetInBytes)
+        {
+            assert(!m_idleEntries.empty());
+
+            m_idleSizeInBytes -= m_idleEntries.back().SizeInBytes;
+            m_idleEntries.pop_back();
+        }
+    }
+}}}}
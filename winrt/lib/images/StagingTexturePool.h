@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "utils/LockUtilities.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Device-wide pool of the staging textures that ScopedBitmapMappedPixelAccess
+    // uses to read and write bitmap pixels from the CPU.
+    //
+    // Textures are keyed by format, CPU access and size.  Sizes are rounded
+    // up to a multiple of SizeStep, so that reading back a bitmap (or a
+    // region of one) that is about the same size as last time reuses the
+    // same texture.  Idle textures are kept until their total size goes over
+    // the memory budget, at which point the least recently used ones are
+    // released.
+    //
+    class StagingTexturePool
+    {
+        struct TextureKey
+        {
+            DXGI_FORMAT Format;
+            uint32_t Width;
+            uint32_t Height;
+            UINT CpuAccessFlags;
+
+            bool operator==(TextureKey const& other) const
+            {
+                return Format == other.Format &&
+                       Width == other.Width &&
+                       Height == other.Height &&
+                       CpuAccessFlags == other.CpuAccessFlags;
+            }
+        };
+
+        struct Entry
+        {
+            TextureKey Key;
+            ComPtr<ID3D11Texture2D> Texture;
+            uint64_t SizeInBytes;
+        };
+
+        std::mutex m_mutex;
+
+        uint64_t m_budgetInBytes;
+        std::list<Entry> m_idleEntries;     // Most recently released first
+        uint64_t m_idleSizeInBytes;
+
+        uint64_t m_hitCount;
+        uint64_t m_missCount;
+
+    public:
+        static const uint32_t SizeStep = 64;
+        static const uint64_t DefaultBudgetInBytes = 64 * 1024 * 1024;
+
+        explicit StagingTexturePool(uint64_t budgetInBytes = DefaultBudgetInBytes);
+
+        //
+        // Returns a staging texture at least width x height pixels in size,
+        // taking it from the pool if possible.  The pixels the caller is
+        // interested in are always at the top left of the texture.
+        //
+        ComPtr<ID3D11Texture2D> Acquire(
+            ID3D11Device* d3dDevice,
+            DXGI_FORMAT format,
+            uint32_t width,
+            uint32_t height,
+            UINT cpuAccessFlags);
+
+        //
+        // Hands a texture from Acquire back to the pool.  It must not be
+        // mapped.
+        //
+        void Release(ID3D11Texture2D* texture);
+
+        void Clear();
+
+        //
+        // Creates a staging texture of exactly the requested size, without
+        // involving any pool.
+        //
+        static ComPtr<ID3D11Texture2D> CreateTexture(
+            ID3D11Device* d3dDevice,
+            DXGI_FORMAT format,
+            uint32_t width,
+            uint32_t height,
+            UINT cpuAccessFlags);
+
+        uint64_t GetHitCount();
+        uint64_t GetMissCount();
+        size_t GetIdleTextureCount();
+        uint64_t GetIdleSizeInBytes();
+
+    private:
+        static TextureKey MakeKey(DXGI_FORMAT format, uint32_t width, uint32_t height, UINT cpuAccessFlags);
+        static uint64_t GetSizeInBytes(TextureKey const& key);
+
+        void TrimToBudget(Lock const& lock);
+    };
+}}}}
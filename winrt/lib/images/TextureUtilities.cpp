@@ -16,9 +16,13 @@
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
-    ScopedBitmapMappedPixelAccess::ScopedBitmapMappedPixelAccess(ID2D1Bitmap1* d2dBitmap, D3D11_MAP mapType, D2D1_RECT_U const* optionalSubRectangle)
-        : m_mapType(mapType)
-        , m_useSubrectangle(false)
+    ScopedBitmapMappedPixelAccess::ScopedBitmapMappedPixelAccess(
+        ID2D1Bitmap1* d2dBitmap,
+        std::shared_ptr<StagingTexturePool> const& stagingTexturePool,
+        D3D11_MAP mapType,
+        D2D1_RECT_U const* optionalSubRectangle)
+        : m_stagingTexturePool(stagingTexturePool)
+        , m_mapType(mapType)
         , m_d2dResourceLock(d2dBitmap)
     {
         ComPtr<IDXGISurface> dxgiSurface;
@@ -41,97 +45,104 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         UINT cpuAccessFlags = 
             m_mapType == D3D11_MAP_READ ? D3D11_CPU_ACCESS_READ : D3D11_CPU_ACCESS_WRITE;
 
-        D3D11_TEXTURE2D_DESC stagingDescription = textureDescription;
-        stagingDescription.CPUAccessFlags = cpuAccessFlags;
-        stagingDescription.BindFlags = 0;
-        stagingDescription.Usage = D3D11_USAGE_STAGING;
-        stagingDescription.ArraySize = 1;
-        stagingDescription.MipLevels = 0;
-        stagingDescription.Width = surfaceDescription.Width;
-        stagingDescription.Height = surfaceDescription.Height;
         if (optionalSubRectangle)
         {
             assert(optionalSubRectangle->right > optionalSubRectangle->left);
             assert(optionalSubRectangle->bottom > optionalSubRectangle->top);
-            stagingDescription.Width = optionalSubRectangle->right - optionalSubRectangle->left;
-            stagingDescription.Height = optionalSubRectangle->bottom - optionalSubRectangle->top;
-
-            m_useSubrectangle = true;
             m_subRectangle = *optionalSubRectangle;
         }
+        else
+        {
+            m_subRectangle = D2D1::RectU(0, 0, surfaceDescription.Width, surfaceDescription.Height);
+        }
 
-        ComPtr<ID3D11Texture2D> stagingTexture;
-        ThrowIfFailed(d3dDevice->CreateTexture2D(&stagingDescription, nullptr, &stagingTexture));
+        const uint32_t width = m_subRectangle.right - m_subRectangle.left;
+        const uint32_t height = m_subRectangle.bottom - m_subRectangle.top;
+
+        //
+        // Pooled staging textures may be larger than the area being
+        // accessed.  The accessed area is always at (0,0).
+        //
+        if (m_stagingTexturePool)
+            m_stagingTexture = m_stagingTexturePool->Acquire(d3dDevice.Get(), textureDescription.Format, width, height, cpuAccessFlags);
+        else
+            m_stagingTexture = StagingTexturePool::CreateTexture(d3dDevice.Get(), textureDescription.Format, width, height, cpuAccessFlags);
 
         d3dDevice->GetImmediateContext(&m_immediateContext);
 
-        m_stagingResource = As<ID3D11Resource>(stagingTexture);
         m_sourceResource = As<ID3D11Resource>(bitmapTexture);
 
         // 
         // This class copies only the requested subrectangle, not the
         // whole texture, in the interest of a small perf gain.
-        // The copied area is located at (0,0).
         //
         if (m_mapType == D3D11_MAP_READ)
         {
             D3D11_BOX sourceBox;
-            if (optionalSubRectangle)
-            {
-                sourceBox.left = optionalSubRectangle->left;
-                sourceBox.top = optionalSubRectangle->top;
-                sourceBox.right = optionalSubRectangle->right;
-                sourceBox.bottom = optionalSubRectangle->bottom;
-                sourceBox.front = 0;
-                sourceBox.back = 1;
-            }
+            sourceBox.left = m_subRectangle.left;
+            sourceBox.top = m_subRectangle.top;
+            sourceBox.right = m_subRectangle.right;
+            sourceBox.bottom = m_subRectangle.bottom;
+            sourceBox.front = 0;
+            sourceBox.back = 1;
 
             m_immediateContext->CopySubresourceRegion(
-                m_stagingResource.Get(),
+                m_stagingTexture.Get(),
                 0, // Dest subresource
                 0, // Dest X
                 0, // Dest Y
                 0, // Dest Z
                 m_sourceResource.Get(),
                 m_subresourceIndex,
-                optionalSubRectangle ? &sourceBox : nullptr);
+                &sourceBox);
         }
 
-        ThrowIfFailed(m_immediateContext->Map(
-            m_stagingResource.Get(),
+        HRESULT hr = m_immediateContext->Map(
+            m_stagingTexture.Get(),
             0, // staging texture doesn't have any subresources
             m_mapType,
             0, // Flags
-            &m_mappedSubresource));
+            &m_mappedSubresource);
+
+        if (FAILED(hr))
+        {
+            // The texture isn't mapped, so it is still fine to reuse
+            if (m_stagingTexturePool)
+                m_stagingTexturePool->Release(m_stagingTexture.Get());
+
+            ThrowHR(hr);
+        }
 
-        m_lockedBufferSize = m_mappedSubresource.RowPitch * stagingDescription.Height;
+        m_lockedBufferSize = m_mappedSubresource.RowPitch * height;
     }
 
     ScopedBitmapMappedPixelAccess::~ScopedBitmapMappedPixelAccess()
     {
-        m_immediateContext->Unmap(m_stagingResource.Get(), m_subresourceIndex);
+        m_immediateContext->Unmap(m_stagingTexture.Get(), 0);
 
         if (m_mapType == D3D11_MAP_WRITE)
         {
-            UINT destX = 0;
-            UINT destY = 0;
-            if (m_useSubrectangle)
-            {
-                destX = m_subRectangle.left;
-                destY = m_subRectangle.top;
-            }
+            D3D11_BOX sourceBox;
+            sourceBox.left = 0;
+            sourceBox.top = 0;
+            sourceBox.right = m_subRectangle.right - m_subRectangle.left;
+            sourceBox.bottom = m_subRectangle.bottom - m_subRectangle.top;
+            sourceBox.front = 0;
+            sourceBox.back = 1;
 
             m_immediateContext->CopySubresourceRegion(
                 m_sourceResource.Get(),
                 m_subresourceIndex, // Dest subresource
-                destX, // Dest X
-                destY, // Dest Y
+                m_subRectangle.left, // Dest X
+                m_subRectangle.top, // Dest Y
                 0, // Dest Z
-                m_stagingResource.Get(),
+                m_stagingTexture.Get(),
                 0, // Source subresource
-                nullptr // Source box
-                );
+                &sourceBox);
         }
+
+        if (m_stagingTexturePool)
+            m_stagingTexturePool->Release(m_stagingTexture.Get());
     }
 
     void* ScopedBitmapMappedPixelAccess::GetLockedData()
@@ -149,7 +160,73 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         return m_mappedSubresource.RowPitch;
     }
 
+    BitmapPixelSnapshot::BitmapPixelSnapshot(
+        ID2D1Bitmap1* d2dBitmap,
+        std::shared_ptr<StagingTexturePool> const& stagingTexturePool,
+        std::shared_ptr<PixelBufferPool> const& pixelBufferPool)
+        : m_pixelBufferPool(pixelBufferPool)
+    {
+        auto size = d2dBitmap->GetPixelSize();
+        m_stride = size.width * GetBytesPerPixel(d2dBitmap->GetPixelFormat().format);
+
+        auto bufferSize = m_stride * size.height;
+
+        if (m_pixelBufferPool)
+            m_buffer = m_pixelBufferPool->Acquire(bufferSize);
+        else
+            m_buffer.resize(bufferSize);
+
+        //
+        // Pooled staging textures may be wider than the bitmap, so the copy
+        // packs the rows together rather than copying RowPitch-sized rows.
+        // The mapping (and the D2D lock that goes with it) ends with this
+        // scope.
+        //
+        ScopedBitmapMappedPixelAccess bitmapPixelAccess(d2dBitmap, stagingTexturePool, D3D11_MAP_READ);
+
+        CopyPixelRows(
+            bitmapPixelAccess.GetLockedData(),
+            bitmapPixelAccess.GetStride(),
+            m_buffer.data(),
+            m_stride,
+            m_stride,
+            size.height);
+    }
+
+    BitmapPixelSnapshot::~BitmapPixelSnapshot()
+    {
+        if (m_pixelBufferPool)
+            m_pixelBufferPool->Release(std::move(m_buffer));
+    }
+
+    uint8_t* BitmapPixelSnapshot::GetData()
+    {
+        return m_buffer.data();
+    }
+
+    unsigned int BitmapPixelSnapshot::GetBufferSize()
+    {
+        return static_cast<unsigned int>(m_buffer.size());
+    }
+
+    unsigned int BitmapPixelSnapshot::GetStride()
+    {
+        return m_stride;
+    }
+
     unsigned int GetBytesPerPixel(DXGI_FORMAT format)
+    {
+        auto bytesPerPixel = TryGetBytesPerPixel(format);
+
+        // Some formats such as DXGI_FORMAT_UNKNOWN, and some block-compressed formats
+        // do not have valid sizes here.
+        if (bytesPerPixel == 0)
+            ThrowHR(E_INVALIDARG);
+
+        return bytesPerPixel;
+    }
+
+    unsigned int TryGetBytesPerPixel(DXGI_FORMAT format)
     {
         switch (format)
         {
@@ -231,10 +308,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         case DXGI_FORMAT_P8: return 1;
         case DXGI_FORMAT_A8P8: return 2;
         case DXGI_FORMAT_B4G4R4A4_UNORM: return 2;
-        default:
-            // Some formats such as DXGI_FORMAT_UNKNOWN, and some block-compressed formats
-            // do not have valid sizes here.
-            ThrowHR(E_INVALIDARG);
+        default: return 0;
         }
     }
 
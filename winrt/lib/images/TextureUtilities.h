@@ -13,25 +13,36 @@
 #pragma once
 
 #include "utils/D2DResourceLock.h"
+#include "StagingTexturePool.h"
+#include "PixelBufferPool.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
+    //
+    // Maps a bitmap's pixels (or a subrectangle of them) into CPU memory, via
+    // a staging texture.  The staging texture comes from stagingTexturePool,
+    // if there is one, and is given back to it once the pixels are unmapped.
+    //
     class ScopedBitmapMappedPixelAccess : LifespanTracker<ScopedBitmapMappedPixelAccess>
     {
         D3D11_MAPPED_SUBRESOURCE m_mappedSubresource;
         unsigned int m_subresourceIndex;
         unsigned int m_lockedBufferSize;
+        std::shared_ptr<StagingTexturePool> m_stagingTexturePool;
         ComPtr<ID3D11Resource> m_sourceResource;
-        ComPtr<ID3D11Resource> m_stagingResource;
+        ComPtr<ID3D11Texture2D> m_stagingTexture;
         ComPtr<ID3D11DeviceContext> m_immediateContext;
         D3D11_MAP m_mapType;
         D2D1_RECT_U m_subRectangle;
-        bool m_useSubrectangle;
 
         D2DResourceLock m_d2dResourceLock;
 
     public:
-        ScopedBitmapMappedPixelAccess(ID2D1Bitmap1* d2dBitmap, D3D11_MAP mapType, D2D1_RECT_U const* optionalSubRectangle = nullptr);
+        ScopedBitmapMappedPixelAccess(
+            ID2D1Bitmap1* d2dBitmap,
+            std::shared_ptr<StagingTexturePool> const& stagingTexturePool,
+            D3D11_MAP mapType,
+            D2D1_RECT_U const* optionalSubRectangle = nullptr);
 
         ~ScopedBitmapMappedPixelAccess();
 
@@ -42,8 +53,39 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         unsigned int GetStride();
     };
 
+    //
+    // A copy of a bitmap's pixels in CPU memory.  The pixels are mapped and
+    // copied in the constructor, so the staging texture and D2D lock are let
+    // go of before it returns, and the copy can then be used from any thread.
+    // The memory comes from pixelBufferPool, if there is one, and is given
+    // back to it on destruction.
+    //
+    class BitmapPixelSnapshot : LifespanTracker<BitmapPixelSnapshot>
+    {
+        std::shared_ptr<PixelBufferPool> m_pixelBufferPool;
+        std::vector<uint8_t> m_buffer;
+        unsigned int m_stride;
+
+    public:
+        BitmapPixelSnapshot(
+            ID2D1Bitmap1* d2dBitmap,
+            std::shared_ptr<StagingTexturePool> const& stagingTexturePool,
+            std::shared_ptr<PixelBufferPool> const& pixelBufferPool);
+
+        ~BitmapPixelSnapshot();
+
+        uint8_t* GetData();
+
+        unsigned int GetBufferSize();
+
+        unsigned int GetStride();
+    };
+
     unsigned int GetBytesPerPixel(DXGI_FORMAT format);
 
+    // Returns 0 for formats that don't have a whole number of bytes per pixel.
+    unsigned int TryGetBytesPerPixel(DXGI_FORMAT format);
+
     ComPtr<ID3D11Texture2D> GetTexture2DForDXGISurface(
         ComPtr<IDXGISurface2> const& dxgiSurface,
         uint32_t* subresourceIndexOut = nullptr);
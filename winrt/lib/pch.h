@@ -26,17 +26,22 @@
 
 // Standard C++
 #include <algorithm>
+#include <array>
 #include <assert.h>
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <iterator>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <set>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 // Win32
@@ -48,6 +53,9 @@
 #pragma warning(push)
 #pragma warning(disable: 4458)  // TODO: Disable "hides class member" warning until we pick up fix to MS.601961
 #include <d2d1_2.h>
+#if WINVER > 0x0603
+#include <d2d1_3.h>
+#endif
 #pragma warning(pop)
 
 #include <d3d11.h>
@@ -65,6 +73,7 @@
 #include <windows.ui.xaml.controls.h>
 #include <windows.ui.xaml.media.dxinterop.h>
 #include <windows.graphics.display.h>
+#include <robuffer.h>
 
 #pragma warning(default: 4265)  // "class has virtual functions, but destructor is not virtual"
 
@@ -97,13 +106,23 @@
 #include "utils/DxgiUtilities.h"
 #include "utils/ResourceManager.h"
 #include "utils/Strings.h"
+#include "utils/ParallelFor.h"
 #include "images/CanvasImage.h"
 #include "images/CanvasBitmap.h"
 #include "images/CanvasRenderTarget.h"
+#include "images/PixelConversion.h"
 #include "effects/CanvasEffect.h"
 #include "brushes/CanvasBrush.h"
 #include "brushes/CanvasImageBrush.h"
 #include "brushes/Gradients.h"
+#include "brushes/SolidColorBrushPool.h"
+#include "text/TextLayoutCache.h"
+#include "geometry/TessellationCache.h"
+#include "drawing/DeviceContextPool.h"
+#include "images/StagingTexturePool.h"
+#include "images/PixelBufferPool.h"
+#include "images/PixelReadbackQueue.h"
+#include "images/BitmapBatchLoader.h"
 #include "drawing/CanvasDevice.h"
 #include "drawing/CanvasDrawingSession.h"
 #include "drawing/CanvasStrokeStyle.h"
@@ -195,6 +195,7 @@ CanvasTextFormat::CanvasTextFormat(std::shared_ptr<CanvasTextFormatManager> mana
     , m_trimmingDelimiterCount(0)
     , m_wordWrapping(CanvasWordWrapping::Wrap)
     , m_drawTextOptions(CanvasDrawTextOptions::Default)
+    , m_changeCount(0)
 {
 }
 
@@ -203,6 +204,7 @@ CanvasTextFormat::CanvasTextFormat(std::shared_ptr<CanvasTextFormatManager> mana
     : m_manager(manager)
     , m_closed(false)
     , m_format(format)
+    , m_changeCount(0)
 {
     SetShadowPropertiesFromDWrite();
 }
@@ -235,14 +237,19 @@ IFACEMETHODIMP CanvasTextFormat::GetResource(REFIID iid, void** value)
 
 ComPtr<IDWriteTextFormat> CanvasTextFormat::GetRealizedTextFormat()
 {
+    Lock lock(m_mutex);
+    return RealizeTextFormat(lock);
+}
+
+
+ComPtr<IDWriteTextFormat> const& CanvasTextFormat::RealizeTextFormat(Lock const& lock)
+{
+    MustOwnLock(lock);
+
     if (m_format)
         return m_format;
 
-    ComPtr<IDWriteFactory2> factory;
-    ThrowIfFailed(DWriteCreateFactory(
-        DWRITE_FACTORY_TYPE_SHARED,
-        __uuidof(&factory),
-        static_cast<IUnknown**>(&factory)));
+    auto& factory = m_manager->GetSharedFactory();
 
     auto uriAndFontFamily = GetUriAndFontFamily(m_fontFamilyName);
     auto const& uri = uriAndFontFamily.first;
@@ -277,14 +284,80 @@ ComPtr<IDWriteTextFormat> CanvasTextFormat::GetRealizedTextFormat()
 }
 
 
+ComPtr<IDWriteTextFormat> CanvasTextFormat::GetRealizedNoWrapTextFormat()
+{
+    Lock lock(m_mutex);
+
+    auto format = RealizeTextFormat(lock);
+
+    if (format->GetWordWrapping() == DWRITE_WORD_WRAPPING_NO_WRAP)
+        return format;
+
+    if (m_noWrapFormat)
+        return m_noWrapFormat;
+
+    //
+    // The copy is made from the realized format, rather than the shadow
+    // properties, so that it picks up the already resolved font collection
+    // and any changes made through interop.
+    //
+    ComPtr<IDWriteFontCollection> fontCollection;
+    ThrowIfFailed(format->GetFontCollection(&fontCollection));
+
+    ComPtr<IDWriteTextFormat> noWrapFormat;
+
+    ThrowIfFailed(m_manager->GetSharedFactory()->CreateTextFormat(
+        static_cast<const wchar_t*>(GetFontFamilyName(format.Get())),
+        fontCollection.Get(),
+        format->GetFontWeight(),
+        format->GetFontStyle(),
+        format->GetFontStretch(),
+        format->GetFontSize(),
+        static_cast<const wchar_t*>(GetLocaleName(format.Get())),
+        &noWrapFormat));
+
+    ThrowIfFailed(noWrapFormat->SetReadingDirection(format->GetReadingDirection()));
+    ThrowIfFailed(noWrapFormat->SetFlowDirection(format->GetFlowDirection()));
+    ThrowIfFailed(noWrapFormat->SetIncrementalTabStop(format->GetIncrementalTabStop()));
+    ThrowIfFailed(noWrapFormat->SetParagraphAlignment(format->GetParagraphAlignment()));
+    ThrowIfFailed(noWrapFormat->SetTextAlignment(format->GetTextAlignment()));
+
+    DWriteLineSpacing spacing(format.Get());
+    ThrowIfFailed(noWrapFormat->SetLineSpacing(spacing.Method, spacing.Spacing, spacing.Baseline));
+
+    DWriteTrimming trimming(format.Get());
+    ThrowIfFailed(noWrapFormat->SetTrimming(&trimming.Options, trimming.Sign.Get()));
+
+    ThrowIfFailed(noWrapFormat->SetWordWrapping(DWRITE_WORD_WRAPPING_NO_WRAP));
+
+    m_noWrapFormat = noWrapFormat;
+
+    return m_noWrapFormat;
+}
+
+
 CanvasDrawTextOptions CanvasTextFormat::GetDrawTextOptions()
 {
     return m_drawTextOptions;
 }
 
 
-void CanvasTextFormat::Unrealize()
+uint32_t CanvasTextFormat::GetChangeCount()
+{
+    return m_changeCount;
+}
+
+
+ComPtr<IDWriteFactory> CanvasTextFormat::GetDWriteFactory()
 {
+    return m_manager->GetSharedFactory();
+}
+
+
+void CanvasTextFormat::Unrealize(Lock const& lock)
+{
+    MustOwnLock(lock);
+
     //
     // We're about to throw away m_format, so we need to extract all the
     // values stored on it into our shadow copies.
@@ -293,6 +366,8 @@ void CanvasTextFormat::Unrealize()
         SetShadowPropertiesFromDWrite();
 
     m_format.Reset();
+    m_noWrapFormat.Reset();
+    ++m_changeCount;
 }
 
 
@@ -396,6 +471,8 @@ HRESULT __declspec(nothrow) CanvasTextFormat::PropertyGet(T* value, ST const& sh
             CheckInPointer(value);
             ThrowIfClosed();
 
+            Lock lock(m_mutex);
+
             if (m_format)
                 SetFrom(value, realizedGetter());
             else
@@ -421,12 +498,19 @@ HRESULT __declspec(nothrow) CanvasTextFormat::PropertyPut(T value, TT* dest, FNV
                 return;
             }
 
+            Lock lock(m_mutex);
+
+            // The no-wrap copy is never modified, so it has to be thrown
+            // away whenever any property changes.
+            m_noWrapFormat.Reset();
+            ++m_changeCount;
+
             if (!realizer)
             {
                 // If there's no realizer set then we're going to have to
                 // throw away m_format (ready to be recreated the next time
                 // it is needed)
-                Unrealize();
+                Unrealize(lock);
             }
 
             // Set the shadow value
@@ -566,7 +650,9 @@ IFACEMETHODIMP CanvasTextFormat::put_FontFamily(HSTRING value)
             auto const& uri = uriAndFontFamily.first;
             m_manager->ValidateUri(uri);
 
-            Unrealize();
+            Lock lock(m_mutex);
+
+            Unrealize(lock);
             m_fontCollection.Reset();
 
             SetFrom(&m_fontFamilyName, value);
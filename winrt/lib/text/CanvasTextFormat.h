@@ -113,7 +113,16 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
     {
     public:
         virtual ComPtr<IDWriteTextFormat> GetRealizedTextFormat() = 0;
+        virtual ComPtr<IDWriteTextFormat> GetRealizedNoWrapTextFormat() = 0;
         virtual CanvasDrawTextOptions GetDrawTextOptions() = 0;
+
+        // Some properties are changed on the realized format in place, so
+        // anything made from it (such as a cached text layout) must also be
+        // keyed on this count, which goes up whenever a property changes.
+        virtual uint32_t GetChangeCount() = 0;
+
+        // The factory that created the realized formats.
+        virtual ComPtr<IDWriteFactory> GetDWriteFactory() = 0;
     };
 
 
@@ -176,6 +185,25 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         //
         ComPtr<IDWriteTextFormat> m_format;
 
+        //
+        // A copy of m_format with word wrapping disabled, used when drawing
+        // text at a point.  This is created on demand and is never modified
+        // once created; any property change simply discards it.  This means
+        // that drawing text at a point doesn't need to touch the
+        // caller-visible WordWrapping property.
+        //
+        ComPtr<IDWriteTextFormat> m_noWrapFormat;
+
+        //
+        // Guards m_format and m_noWrapFormat.  Drawing sessions on different
+        // threads may draw with the same format at once, and whichever gets
+        // there first creates these on demand.
+        //
+        std::mutex m_mutex;
+
+        // Incremented whenever a property changes; see GetChangeCount.
+        uint32_t m_changeCount;
+
     public:
         CanvasTextFormat(std::shared_ptr<CanvasTextFormatManager> manager);
         CanvasTextFormat(std::shared_ptr<CanvasTextFormatManager> manager, IDWriteTextFormat* format);
@@ -218,7 +246,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         //
 
         virtual ComPtr<IDWriteTextFormat> GetRealizedTextFormat() override;
+        virtual ComPtr<IDWriteTextFormat> GetRealizedNoWrapTextFormat() override;
         virtual CanvasDrawTextOptions GetDrawTextOptions() override;
+        virtual uint32_t GetChangeCount() override;
+        virtual ComPtr<IDWriteFactory> GetDWriteFactory() override;
 
         //
         // ICanvasResourceWrapperNative
@@ -241,7 +272,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
 
         void SetShadowPropertiesFromDWrite();
 
-        void Unrealize();
+        ComPtr<IDWriteTextFormat> const& RealizeTextFormat(Lock const& lock);
+        void Unrealize(Lock const& lock);
         void RealizeDirection();
         void RealizeIncrementalTabStop();
         void RealizeLineSpacing();
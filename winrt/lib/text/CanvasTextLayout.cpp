@@ -17,6 +17,8 @@
 #include "brushes/CanvasRadialGradientBrush.h"
 #include "brushes/CanvasImageBrush.h"
 
+#include "utils/ParallelFor.h"
+
 #include "CanvasTextLayout.h"
 #include "TextUtilities.h"
 
@@ -108,6 +110,79 @@ ComPtr<CanvasTextLayout> CanvasTextLayoutManager::CreateWrapper(
     return canvasTextLayout;
 }
 
+static CanvasTextMeasurement MeasureText(
+    IDWriteFactory* dwriteFactory,
+    HSTRING text,
+    IDWriteTextFormat* textFormat,
+    float requestedWidth,
+    float requestedHeight)
+{
+    uint32_t textLength;
+    auto textBuffer = WindowsGetStringRawBuffer(text, &textLength);
+    ThrowIfNullPointer(textBuffer, E_INVALIDARG);
+
+    ComPtr<IDWriteTextLayout> dwriteTextLayout;
+    ThrowIfFailed(dwriteFactory->CreateTextLayout(
+        textBuffer,
+        textLength,
+        textFormat,
+        requestedWidth,
+        requestedHeight,
+        &dwriteTextLayout));
+
+    DWRITE_TEXT_METRICS dwriteMetrics;
+    ThrowIfFailed(dwriteTextLayout->GetMetrics(&dwriteMetrics));
+
+    CanvasTextMeasurement measurement;
+    measurement.LayoutBounds = Rect{ dwriteMetrics.left, dwriteMetrics.top, dwriteMetrics.width, dwriteMetrics.height };
+    measurement.LineCount = dwriteMetrics.lineCount;
+    ThrowIfFailed(dwriteTextLayout->DetermineMinWidth(&measurement.MinimumLineLength));
+
+    return measurement;
+}
+
+ComArray<CanvasTextMeasurement> CanvasTextLayoutManager::MeasureTexts(
+    uint32_t textCount,
+    HSTRING const* texts,
+    ICanvasTextFormat* textFormat,
+    float requestedWidth,
+    float requestedHeight,
+    unsigned maxThreadCount)
+{
+    // Laying out a string is cheap enough that a band needs a good number
+    // of them to be worth handing to another thread.
+    const uint32_t minimumTextsPerBand = 32;
+    const uint32_t maximumBandCount = 64;
+
+    //
+    // The format is realized here, before any work is shared out, so every
+    // thread uses the same IDWriteTextFormat and its font family is only
+    // looked up once.  DirectWrite factories and formats are free threaded.
+    //
+    auto dwriteFactory = GetSharedFactory();
+    auto dwriteTextFormat = GetWrappedResource<IDWriteTextFormat>(textFormat);
+
+    ComArray<CanvasTextMeasurement> measurements(textCount);
+
+    ParallelFor(
+        textCount,
+        std::min(textCount / minimumTextsPerBand, maximumBandCount),
+        maxThreadCount,
+        [&](uint32_t firstText, uint32_t bandTextCount)
+        {
+            for (uint32_t i = firstText; i < firstText + bandTextCount; i++)
+            {
+                measurements[i] = MeasureText(
+                    dwriteFactory.Get(),
+                    texts[i],
+                    dwriteTextFormat.Get(),
+                    requestedWidth,
+                    requestedHeight);
+            }
+        });
+
+    return measurements;
+}
 
 //
 // CanvasTextLayoutFactory implementation
@@ -148,6 +223,35 @@ IFACEMETHODIMP CanvasTextLayoutFactory::Create(
         });
 }
 
+IFACEMETHODIMP CanvasTextLayoutFactory::MeasureTexts(
+    uint32_t textCount,
+    HSTRING* texts,
+    ICanvasTextFormat* textFormat,
+    float requestedWidth,
+    float requestedHeight,
+    uint32_t* valueCount,
+    CanvasTextMeasurement** valueElements)
+{
+    return ExceptionBoundary(
+        [&]
+        {
+            if (textCount > 0)
+                CheckInPointer(texts);
+            CheckInPointer(textFormat);
+            CheckInPointer(valueCount);
+            CheckAndClearOutPointer(valueElements);
+
+            auto measurements = GetManager()->MeasureTexts(
+                textCount,
+                texts,
+                textFormat,
+                requestedWidth,
+                requestedHeight);
+
+            measurements.Detach(valueCount, valueElements);
+        });
+}
+
 CanvasTextLayout::CanvasTextLayout(
     std::shared_ptr<CanvasTextLayoutManager> manager, 
     IDWriteTextLayout2* layout,
@@ -228,7 +332,7 @@ IFACEMETHODIMP CanvasTextLayout::##name(valueType value)            \
     return ExceptionBoundary(                                       \
         [&]                                                         \
         {                                                           \
-            auto& resource = GetResource();                         \
+            auto& resource = GetResourceForUpdate();                \
                                                                     \
             ThrowIfInvalid(value);                                  \
             resource->dwriteMethod(conversionFunc(value));          \
@@ -289,7 +393,7 @@ IFACEMETHODIMP CanvasTextLayout::put_Direction(CanvasTextDirection value)
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
             auto entry = DWriteToCanvasTextDirection::Lookup(value);
             ThrowIfFailed(resource->SetReadingDirection(entry->ReadingDirection));
             ThrowIfFailed(resource->SetFlowDirection(entry->FlowDirection));
@@ -331,7 +435,7 @@ IFACEMETHODIMP CanvasTextLayout::put_LineSpacing(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource(); 
+            auto& resource = GetResourceForUpdate(); 
 
             DWriteLineSpacing originalSpacing(resource.Get());
 
@@ -360,7 +464,7 @@ IFACEMETHODIMP CanvasTextLayout::put_LineSpacingBaseline(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource(); 
+            auto& resource = GetResourceForUpdate(); 
 
             DWRITE_LINE_SPACING_METHOD method;
             float spacing;
@@ -394,7 +498,7 @@ IFACEMETHODIMP CanvasTextLayout::put_TrimmingGranularity(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource(); 
+            auto& resource = GetResourceForUpdate(); 
 
             DWRITE_TRIMMING trimming;
             ComPtr<IDWriteInlineObject> inlineObject;
@@ -431,7 +535,7 @@ IFACEMETHODIMP CanvasTextLayout::put_TrimmingDelimiter(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource(); 
+            auto& resource = GetResourceForUpdate(); 
 
             DWRITE_TRIMMING trimming;
             ComPtr<IDWriteInlineObject> inlineObject;
@@ -470,7 +574,7 @@ IFACEMETHODIMP CanvasTextLayout::put_TrimmingDelimiterCount(
         [&]
         {
             ThrowIfNegative(value);
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             DWRITE_TRIMMING trimming;
             ComPtr<IDWriteInlineObject> inlineObject;
@@ -528,7 +632,7 @@ IFACEMETHODIMP CanvasTextLayout::put_RequestedSize(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             ThrowIfFailed(resource->SetMaxWidth(value.Width));
             ThrowIfFailed(resource->SetMaxHeight(value.Height));
@@ -797,7 +901,7 @@ IFACEMETHODIMP CanvasTextLayout::SetColor(
     return ExceptionBoundary(
         [&]
     {
-        auto& resource = GetResource();
+        auto& resource = GetResourceForUpdate();
 
         auto textRange = ToDWriteTextRange(characterIndex, characterCount);
 
@@ -819,7 +923,7 @@ IFACEMETHODIMP CanvasTextLayout::SetBrush(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             //
             // The brush parameter is allowed to be null. This will reset 
@@ -858,7 +962,7 @@ IFACEMETHODIMP CanvasTextLayout::SetFontFamily(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             auto uriAndFontFamily = GetUriAndFontFamily(WinString(fontFamilyName));
             auto const& uri = uriAndFontFamily.first;
@@ -881,7 +985,7 @@ IFACEMETHODIMP CanvasTextLayout::SetFontSize(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             ThrowIfFailed(resource->SetFontSize(fontSize, ToDWriteTextRange(characterIndex, characterCount)));
         });
@@ -895,7 +999,7 @@ IFACEMETHODIMP CanvasTextLayout::SetFontStretch(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             ThrowIfFailed(resource->SetFontStretch(ToFontStretch(fontStretch), ToDWriteTextRange(characterIndex, characterCount)));
         });
@@ -909,7 +1013,7 @@ IFACEMETHODIMP CanvasTextLayout::SetFontStyle(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             ThrowIfFailed(resource->SetFontStyle(ToFontStyle(fontStyle), ToDWriteTextRange(characterIndex, characterCount)));
         });
@@ -923,7 +1027,7 @@ IFACEMETHODIMP CanvasTextLayout::SetFontWeight(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             ThrowIfFailed(resource->SetFontWeight(ToFontWeight(fontWeight), ToDWriteTextRange(characterIndex, characterCount)));
         });
@@ -937,7 +1041,7 @@ IFACEMETHODIMP CanvasTextLayout::SetLocaleName(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             const wchar_t* localeNameBuffer = WindowsGetStringRawBuffer(name, nullptr);
 
@@ -953,7 +1057,7 @@ IFACEMETHODIMP CanvasTextLayout::SetStrikethrough(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             ThrowIfFailed(resource->SetStrikethrough(hasStrikethrough, ToDWriteTextRange(characterIndex, characterCount)));
         });
@@ -967,7 +1071,7 @@ IFACEMETHODIMP CanvasTextLayout::SetUnderline(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             ThrowIfFailed(resource->SetUnderline(hasUnderline, ToDWriteTextRange(characterIndex, characterCount)));
         });
@@ -1001,7 +1105,7 @@ IFACEMETHODIMP CanvasTextLayout::SetPairKerning(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             ThrowIfFailed(resource->SetPairKerning(hasPairKerning, ToDWriteTextRange(characterIndex, characterCount)));
         });
@@ -1077,7 +1181,7 @@ IFACEMETHODIMP CanvasTextLayout::SetCharacterSpacing(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             ThrowIfFailed(resource->SetCharacterSpacing(
                 leadingSpacing, 
@@ -1107,7 +1211,7 @@ IFACEMETHODIMP CanvasTextLayout::put_VerticalGlyphOrientation(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             ThrowIfFailed(resource->SetVerticalGlyphOrientation(ToVerticalGlyphOrientation(value)));
         });
@@ -1133,7 +1237,7 @@ IFACEMETHODIMP CanvasTextLayout::put_OpticalAlignment(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             ThrowIfFailed(resource->SetOpticalAlignment(ToOpticalAlignment(value)));
         });
@@ -1160,7 +1264,7 @@ IFACEMETHODIMP CanvasTextLayout::put_LastLineWrapping(
     return ExceptionBoundary(
         [&]
         {
-            auto& resource = GetResource();
+            auto& resource = GetResourceForUpdate();
 
             ThrowIfFailed(resource->SetLastLineWrapping(value));
         });
@@ -1388,9 +1492,306 @@ IFACEMETHODIMP CanvasTextLayout::GetCharacterRegions(
         });
 }
 
+IFACEMETHODIMP CanvasTextLayout::HitTestPoints(
+    uint32_t pointCount,
+    Vector2* points,
+    uint32_t* resultCount,
+    CanvasTextLayoutHitTestResult** results)
+{
+    return ExceptionBoundary(
+        [&]
+        {
+            if (pointCount > 0)
+                CheckInPointer(points);
+            CheckInPointer(resultCount);
+            CheckAndClearOutPointer(results);
+
+            auto& resource = GetResource();
+            auto cache = GetHitTestCache(resource.Get());
+
+            ComArray<CanvasTextLayoutHitTestResult> array(pointCount);
+
+            for (uint32_t i = 0; i < pointCount; ++i)
+            {
+                auto const& point = points[i];
+                auto& result = array[i];
+
+                if (cache->TryHitTestPoint(point.X, point.Y, &result))
+                    continue;
+
+                BOOL isTrailingHit;
+                BOOL isInside;
+                DWRITE_HIT_TEST_METRICS hitTestMetrics;
+                ThrowIfFailed(resource->HitTestPoint(point.X, point.Y, &isTrailingHit, &isInside, &hitTestMetrics));
+
+                result.Region = ToHitTestDescription(hitTestMetrics);
+                result.IsTrailingSide = !!isTrailingHit;
+                result.IsHit = !!isInside;
+            }
+
+            array.Detach(resultCount, results);
+        });
+}
+
+IFACEMETHODIMP CanvasTextLayout::GetCaretPositions(
+    uint32_t characterIndexCount,
+    int32_t* characterIndices,
+    boolean trailingSideOfCharacter,
+    uint32_t* locationCount,
+    Vector2** locations)
+{
+    return ExceptionBoundary(
+        [&]
+        {
+            if (characterIndexCount > 0)
+                CheckInPointer(characterIndices);
+            CheckInPointer(locationCount);
+            CheckAndClearOutPointer(locations);
+
+            for (uint32_t i = 0; i < characterIndexCount; ++i)
+                ThrowIfNegative(characterIndices[i]);
+
+            auto& resource = GetResource();
+            auto cache = GetHitTestCache(resource.Get());
+
+            ComArray<Vector2> array(characterIndexCount);
+
+            for (uint32_t i = 0; i < characterIndexCount; ++i)
+            {
+                auto characterIndex = static_cast<uint32_t>(characterIndices[i]);
+                auto& location = array[i];
+
+                if (cache->TryGetCaretPosition(characterIndex, !!trailingSideOfCharacter, &location))
+                    continue;
+
+                DWRITE_HIT_TEST_METRICS hitTestMetrics;
+                ThrowIfFailed(resource->HitTestTextPosition(
+                    characterIndex,
+                    trailingSideOfCharacter,
+                    &location.X,
+                    &location.Y,
+                    &hitTestMetrics));
+            }
+
+            array.Detach(locationCount, locations);
+        });
+}
+
+ComPtr<IDWriteTextLayout2> const& CanvasTextLayout::GetResourceForUpdate()
+{
+    auto& resource = GetResource();
+
+    DiscardHitTestCache();
+
+    return resource;
+}
+
+std::shared_ptr<CanvasTextLayout::HitTestCache const> CanvasTextLayout::GetHitTestCache(IDWriteTextLayout2* layout)
+{
+    Lock lock(m_hitTestCacheMutex);
+
+    // Built while holding the lock, so that threads querying a new layout
+    // at the same time wait for one cache rather than each building their own.
+    if (!m_hitTestCache)
+    {
+        auto cache = std::make_shared<HitTestCache>();
+        cache->Build(layout);
+        m_hitTestCache = std::move(cache);
+    }
+
+    return m_hitTestCache;
+}
+
+void CanvasTextLayout::DiscardHitTestCache()
+{
+    std::shared_ptr<HitTestCache const> discarded;
+
+    Lock lock(m_hitTestCacheMutex);
+
+    // Any queries still using the old cache keep it alive until they finish.
+    std::swap(discarded, m_hitTestCache);
+}
+
+template<typename T, typename FN>
+static std::vector<T> GetMetricsArray(FN&& getFn)
+{
+    uint32_t count = 0;
+    HRESULT hr = getFn(nullptr, 0, &count);
+
+    if (hr != E_NOT_SUFFICIENT_BUFFER)
+    {
+        ThrowIfFailed(hr);
+        return std::vector<T>();
+    }
+
+    std::vector<T> metrics(count);
+    ThrowIfFailed(getFn(metrics.data(), count, &count));
+    metrics.resize(count);
+
+    return metrics;
+}
+
+void CanvasTextLayout::HitTestCache::Build(IDWriteTextLayout2* layout)
+{
+    IsSimple = false;
+    Lines.clear();
+    Clusters.clear();
+    CharacterClusters.clear();
+
+    if (layout->GetReadingDirection() != DWRITE_READING_DIRECTION_LEFT_TO_RIGHT ||
+        layout->GetFlowDirection() != DWRITE_FLOW_DIRECTION_TOP_TO_BOTTOM)
+    {
+        return;
+    }
+
+    DWRITE_TRIMMING trimming{};
+    ComPtr<IDWriteInlineObject> trimmingSign;
+    ThrowIfFailed(layout->GetTrimming(&trimming, &trimmingSign));
+
+    if (trimming.granularity != DWRITE_TRIMMING_GRANULARITY_NONE)
+        return;
+
+    auto lineMetrics = GetMetricsArray<DWRITE_LINE_METRICS>(
+        [=](DWRITE_LINE_METRICS* metrics, uint32_t maxCount, uint32_t* actualCount)
+        {
+            return layout->GetLineMetrics(metrics, maxCount, actualCount);
+        });
+
+    auto clusterMetrics = GetMetricsArray<DWRITE_CLUSTER_METRICS>(
+        [=](DWRITE_CLUSTER_METRICS* metrics, uint32_t maxCount, uint32_t* actualCount)
+        {
+            return layout->GetClusterMetrics(metrics, maxCount, actualCount);
+        });
+
+    Lines.reserve(lineMetrics.size());
+    Clusters.reserve(clusterMetrics.size());
+
+    uint32_t characterIndex = 0;
+    uint32_t clusterIndex = 0;
+
+    for (auto const& lineMetric : lineMetrics)
+    {
+        //
+        // Cluster metrics only give widths, so the left edge of each line
+        // (which depends on alignment) and its vertical extent come from
+        // hit-testing the line's first character.
+        //
+        float x, y;
+        DWRITE_HIT_TEST_METRICS hitTestMetrics;
+        ThrowIfFailed(layout->HitTestTextPosition(characterIndex, FALSE, &x, &y, &hitTestMetrics));
+
+        Line line;
+        line.FirstCluster = clusterIndex;
+        line.Top = hitTestMetrics.top;
+        line.Height = hitTestMetrics.height;
+
+        auto lineIndex = static_cast<uint32_t>(Lines.size());
+        auto lineEnd = characterIndex + lineMetric.length;
+        auto left = hitTestMetrics.left;
+
+        while (characterIndex < lineEnd)
+        {
+            if (clusterIndex >= clusterMetrics.size())
+                return;
+
+            auto const& clusterMetric = clusterMetrics[clusterIndex];
+
+            if (clusterMetric.isRightToLeft)
+                return;
+
+            Cluster cluster;
+            cluster.CharacterIndex = characterIndex;
+            cluster.Line = lineIndex;
+            cluster.Left = left;
+            cluster.Width = clusterMetric.width;
+            cluster.IsSimple = clusterMetric.length == 1 &&
+                               !clusterMetric.isWhitespace &&
+                               !clusterMetric.isNewline &&
+                               !clusterMetric.isSoftHyphen;
+
+            Clusters.push_back(cluster);
+            CharacterClusters.insert(CharacterClusters.end(), clusterMetric.length, clusterIndex);
+
+            left += clusterMetric.width;
+            characterIndex += clusterMetric.length;
+            ++clusterIndex;
+        }
+
+        // A cluster that straddles two lines means the metrics don't agree
+        // with each other, so don't trust them.
+        if (characterIndex != lineEnd)
+            return;
+
+        line.ClusterCount = clusterIndex - line.FirstCluster;
+        Lines.push_back(line);
+    }
+
+    IsSimple = (clusterIndex == clusterMetrics.size());
+}
+
+bool CanvasTextLayout::HitTestCache::TryHitTestPoint(float x, float y, CanvasTextLayoutHitTestResult* result) const
+{
+    if (!IsSimple)
+        return false;
+
+    // Find the last line that starts above the point.
+    auto line = std::upper_bound(Lines.begin(), Lines.end(), y,
+        [](float value, Line const& l) { return value < l.Top; });
+
+    if (line == Lines.begin())
+        return false;
+
+    --line;
+
+    if (!(y > line->Top && y < line->Top + line->Height))
+        return false;
+
+    // Find the last cluster on that line that starts to the left of the point.
+    auto firstCluster = Clusters.begin() + line->FirstCluster;
+    auto endCluster = firstCluster + line->ClusterCount;
+
+    auto cluster = std::upper_bound(firstCluster, endCluster, x,
+        [](float value, Cluster const& c) { return value < c.Left; });
+
+    if (cluster == firstCluster)
+        return false;
+
+    --cluster;
+
+    auto middle = cluster->Left + cluster->Width / 2;
+
+    if (!cluster->IsSimple || !(x > cluster->Left && x < cluster->Left + cluster->Width) || x == middle)
+        return false;
+
+    result->Region.CharacterIndex = static_cast<int32_t>(cluster->CharacterIndex);
+    result->Region.CharacterCount = 1;
+    result->Region.LayoutBounds = Rect{ cluster->Left, line->Top, cluster->Width, line->Height };
+    result->IsTrailingSide = x > middle;
+    result->IsHit = true;
+
+    return true;
+}
+
+bool CanvasTextLayout::HitTestCache::TryGetCaretPosition(uint32_t characterIndex, bool trailingSide, Vector2* location) const
+{
+    if (!IsSimple || characterIndex >= CharacterClusters.size())
+        return false;
+
+    auto const& cluster = Clusters[CharacterClusters[characterIndex]];
+
+    if (!cluster.IsSimple)
+        return false;
+
+    location->X = trailingSide ? cluster.Left + cluster.Width : cluster.Left;
+    location->Y = Lines[cluster.Line].Top;
+
+    return true;
+}
+
 IFACEMETHODIMP CanvasTextLayout::Close()
 {
     m_device.Close();
+    DiscardHitTestCache();
 
     return ResourceWrapper::Close();
 }
@@ -39,6 +39,55 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
 
         ClosablePtr<ICanvasDevice> m_device;
 
+        //
+        // Cluster and line metrics used to answer HitTestPoints and
+        // GetCaretPositions queries without asking DirectWrite about each
+        // one.  This is built on first use, and discarded whenever the layout
+        // is changed through this wrapper.
+        //
+        // Queries may come from several threads at once, so the cache is
+        // built and discarded under m_hitTestCacheMutex, and each query
+        // holds on to its own reference to the cache it is reading.
+        //
+        // Only horizontal, left-to-right, untrimmed layouts are answered from
+        // the cache, and then only for points that fall strictly inside a
+        // single-character, non-whitespace cluster.  Anything else (bidi
+        // text, ligatures, points between lines, etc.) is passed through to
+        // DirectWrite so the results always match the single-query methods.
+        //
+        struct HitTestCache
+        {
+            struct Line
+            {
+                uint32_t FirstCluster;
+                uint32_t ClusterCount;
+                float Top;
+                float Height;
+            };
+
+            struct Cluster
+            {
+                uint32_t CharacterIndex;
+                uint32_t Line;
+                float Left;
+                float Width;
+                bool IsSimple;      // One character, not whitespace or a newline
+            };
+
+            bool IsSimple;
+            std::vector<Line> Lines;
+            std::vector<Cluster> Clusters;
+            std::vector<uint32_t> CharacterClusters;
+
+            void Build(IDWriteTextLayout2* layout);
+
+            bool TryHitTestPoint(float x, float y, CanvasTextLayoutHitTestResult* result) const;
+            bool TryGetCaretPosition(uint32_t characterIndex, bool trailingSide, Vector2* location) const;
+        };
+
+        std::mutex m_hitTestCacheMutex;
+        std::shared_ptr<HitTestCache const> m_hitTestCache;
+
     public:
         CanvasTextLayout(
             std::shared_ptr<CanvasTextLayoutManager> manager, 
@@ -333,6 +382,19 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
             uint32_t* descriptionCount,
             CanvasTextLayoutRegion** descriptions));
 
+        IFACEMETHOD(HitTestPoints)(
+            uint32_t pointCount,
+            Vector2* points,
+            uint32_t* resultCount,
+            CanvasTextLayoutHitTestResult** results);
+
+        IFACEMETHOD(GetCaretPositions)(
+            uint32_t characterIndexCount,
+            int32_t* characterIndices,
+            boolean trailingSideOfCharacter,
+            uint32_t* locationCount,
+            Vector2** locations);
+
         //
         // IClosable
         //
@@ -348,6 +410,16 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
     private:
         ComPtr<ICanvasBrush> PolymorphicGetOrCreateBrush(
             ComPtr<IUnknown> const& resource);
+
+        //
+        // Used by every method that modifies the layout, so that cached
+        // metrics derived from it are discarded.
+        //
+        ComPtr<IDWriteTextLayout2> const& GetResourceForUpdate();
+
+        std::shared_ptr<HitTestCache const> GetHitTestCache(IDWriteTextLayout2* layout);
+
+        void DiscardHitTestCache();
     };
 
     class CanvasTextLayoutManager
@@ -369,6 +441,19 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         virtual ComPtr<CanvasTextLayout> CreateWrapper(
             ICanvasDevice* device,
             IDWriteTextLayout2* resource);
+
+        //
+        // Measures each string as if it had been used to create a
+        // CanvasTextLayout.  maxThreadCount limits the number of threads used,
+        // as for ParallelFor; zero means one per processor.
+        //
+        ComArray<CanvasTextMeasurement> MeasureTexts(
+            uint32_t textCount,
+            HSTRING const* texts,
+            ICanvasTextFormat* textFormat,
+            float requestedWidth,
+            float requestedHeight,
+            unsigned maxThreadCount = 0);
     };
 
     //
@@ -378,6 +463,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
     class CanvasTextLayoutFactory
         : public ActivationFactory<
         ICanvasTextLayoutFactory,
+        ICanvasTextLayoutStatics,
         CloakedIid<ICanvasDeviceResourceFactoryNative >> ,
         public PerApplicationManager<CanvasTextLayoutFactory, CanvasTextLayoutManager>
     {
@@ -396,6 +482,15 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
             float requestedHeight,
             ICanvasTextLayout** textLayout);
 
+        IFACEMETHOD(MeasureTexts)(
+            uint32_t textCount,
+            HSTRING* texts,
+            ICanvasTextFormat* textFormat,
+            float requestedWidth,
+            float requestedHeight,
+            uint32_t* valueCount,
+            CanvasTextMeasurement** valueElements);
+
         //
         // Used by PerApplicationManager
         //
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include "utils/LockUtilities.h"
+
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { namespace Text
 {
     class ICanvasTextFormatAdapter;
@@ -25,6 +27,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         ComPtr<IDWriteFontCollectionLoader> m_customLoader;
         std::shared_ptr<ICanvasTextFormatAdapter> m_adapter;
 
+        // Managers are shared by every thread, so the factories, which are
+        // created on demand, need guarding.
+        std::mutex m_mutex;
+
     public:
         CustomFontManager(std::shared_ptr<ICanvasTextFormatAdapter> const& adapter);
 
@@ -32,7 +38,6 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
 
         void ValidateUri(WinString const& uriString);
 
-    protected:
         ComPtr<IDWriteFactory> const& GetSharedFactory();
 
     private:
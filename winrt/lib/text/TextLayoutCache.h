@@ -0,0 +1,262 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "utils/LockUtilities.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Device-wide cache of text layouts, used by drawing sessions to avoid
+    // shaping and laying out the same strings every time they are drawn.
+    //
+    // Layouts are keyed on the text, the realized IDWriteTextFormat and its
+    // change count, the size of the layout rectangle and the draw text
+    // options.  Changing any property of a CanvasTextFormat bumps its change
+    // count, so layouts made before the change are never found again and
+    // age out of the cache.
+    //
+    // The cache is disabled until SetLimits is called with a non-zero entry
+    // count.  It evicts the least recently used layouts when either the
+    // number of entries or the total number of characters goes over the
+    // limits.
+    //
+    class TextLayoutCache
+    {
+        struct Entry
+        {
+            size_t Hash;
+            std::wstring Text;
+            ComPtr<IDWriteTextFormat> Format;
+            uint32_t FormatChangeCount;
+            float Width;
+            float Height;
+            uint32_t Options;
+            ComPtr<IDWriteTextLayout> Layout;
+        };
+
+        typedef std::list<Entry> EntryList;
+
+        std::mutex m_mutex;
+
+        size_t m_maximumEntryCount;
+        size_t m_maximumCharacterCount;
+
+        EntryList m_entries;    // Most recently used first
+        std::unordered_multimap<size_t, EntryList::iterator> m_entryLookup;
+        size_t m_characterCount;
+
+        uint64_t m_hitCount;
+        uint64_t m_missCount;
+
+    public:
+        static const size_t DefaultMaximumCharacterCount = 64 * 1024;
+
+        TextLayoutCache()
+            : m_maximumEntryCount(0)
+            , m_maximumCharacterCount(DefaultMaximumCharacterCount)
+            , m_characterCount(0)
+            , m_hitCount(0)
+            , m_missCount(0)
+        {
+        }
+
+        bool IsEnabled()
+        {
+            Lock lock(m_mutex);
+            return m_maximumEntryCount > 0;
+        }
+
+        void SetLimits(size_t maximumEntryCount, size_t maximumCharacterCount)
+        {
+            Lock lock(m_mutex);
+
+            m_maximumEntryCount = maximumEntryCount;
+            m_maximumCharacterCount = maximumCharacterCount;
+
+            TrimToLimits(lock);
+        }
+
+        size_t GetMaximumEntryCount()
+        {
+            Lock lock(m_mutex);
+            return m_maximumEntryCount;
+        }
+
+        size_t GetMaximumCharacterCount()
+        {
+            Lock lock(m_mutex);
+            return m_maximumCharacterCount;
+        }
+
+        //
+        // Returns the layout for the given text and format, calling createFn
+        // to make a new one if it is not already in the cache.  Text that is
+        // too long to ever fit in the cache is laid out without being cached.
+        //
+        template<typename FN>
+        ComPtr<IDWriteTextLayout> GetLayout(
+            wchar_t const* text,
+            uint32_t textLength,
+            IDWriteTextFormat* format,
+            uint32_t formatChangeCount,
+            float width,
+            float height,
+            uint32_t options,
+            FN&& createFn)
+        {
+            auto hash = GetHash(text, textLength, format, formatChangeCount, width, height, options);
+
+            {
+                Lock lock(m_mutex);
+
+                auto range = m_entryLookup.equal_range(hash);
+
+                for (auto it = range.first; it != range.second; ++it)
+                {
+                    auto& entry = *it->second;
+
+                    if (entry.Format.Get() == format &&
+                        entry.FormatChangeCount == formatChangeCount &&
+                        entry.Width == width &&
+                        entry.Height == height &&
+                        entry.Options == options &&
+                        entry.Text.compare(0, entry.Text.size(), text, textLength) == 0)
+                    {
+                        ++m_hitCount;
+
+                        // Move to the front of the list.
+                        m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+                        return entry.Layout;
+                    }
+                }
+
+                ++m_missCount;
+            }
+
+            // The layout is created without holding the lock, since this is
+            // the expensive part.  If two threads race to create the same
+            // layout then both are added, and the older one ages out.
+            ComPtr<IDWriteTextLayout> layout = createFn();
+
+            Lock lock(m_mutex);
+
+            if (m_maximumEntryCount == 0 || textLength > m_maximumCharacterCount)
+                return layout;
+
+            m_entries.push_front(Entry{ hash, std::wstring(text, textLength), format, formatChangeCount, width, height, options, layout });
+            m_entryLookup.emplace(hash, m_entries.begin());
+            m_characterCount += textLength;
+
+            TrimToLimits(lock);
+
+            return layout;
+        }
+
+        void Clear()
+        {
+            Lock lock(m_mutex);
+
+            m_entries.clear();
+            m_entryLookup.clear();
+            m_characterCount = 0;
+        }
+
+        uint64_t GetHitCount()
+        {
+            Lock lock(m_mutex);
+            return m_hitCount;
+        }
+
+        uint64_t GetMissCount()
+        {
+            Lock lock(m_mutex);
+            return m_missCount;
+        }
+
+        size_t GetEntryCount()
+        {
+            Lock lock(m_mutex);
+            return m_entries.size();
+        }
+
+        size_t GetCharacterCount()
+        {
+            Lock lock(m_mutex);
+            return m_characterCount;
+        }
+
+    private:
+        void TrimToLimits(Lock const& lock)
+        {
+            MustOwnLock(lock);
+
+            while (!m_entries.empty() &&
+                   (m_entries.size() > m_maximumEntryCount || m_characterCount > m_maximumCharacterCount))
+            {
+                auto oldest = std::prev(m_entries.end());
+
+                auto range = m_entryLookup.equal_range(oldest->Hash);
+                for (auto it = range.first; it != range.second; ++it)
+                {
+                    if (it->second == oldest)
+                    {
+                        m_entryLookup.erase(it);
+                        break;
+                    }
+                }
+
+                m_characterCount -= oldest->Text.size();
+                m_entries.erase(oldest);
+            }
+        }
+
+        static size_t GetHash(
+            wchar_t const* text,
+            uint32_t textLength,
+            IDWriteTextFormat* format,
+            uint32_t formatChangeCount,
+            float width,
+            float height,
+            uint32_t options)
+        {
+            // FNV-1a
+            uint64_t hash = 14695981039346656037ULL;
+
+            auto add = [&](uint64_t value)
+            {
+                hash ^= value;
+                hash *= 1099511628211ULL;
+            };
+
+            for (uint32_t i = 0; i < textLength; i++)
+                add(text[i]);
+
+            add(reinterpret_cast<uintptr_t>(format));
+            add(formatChangeCount);
+            add(FloatBits(width));
+            add(FloatBits(height));
+            add(options);
+
+            return static_cast<size_t>(hash);
+        }
+
+        static uint32_t FloatBits(float value)
+        {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+    };
+}}}}
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    using namespace ::Microsoft::WRL;
+    using namespace ABI::Windows::Storage::Streams;
+
+    //
+    // A fixed-capacity IBuffer over memory that we own, used to hand blocks of
+    // bytes back from async operations (which can't return arrays).  Callers
+    // that want to avoid a copy can get at the bytes through
+    // IBufferByteAccess.
+    //
+    class ByteBuffer : public RuntimeClass<
+        RuntimeClassFlags<WinRtClassicComMix>,
+        IBuffer,
+        ::Windows::Storage::Streams::IBufferByteAccess>,
+        private LifespanTracker<ByteBuffer>
+    {
+        InspectableClass(InterfaceName_Windows_Storage_Streams_IBuffer, BaseTrust);
+
+        std::vector<uint8_t> m_bytes;
+        uint32_t m_length;
+
+    public:
+        explicit ByteBuffer(uint32_t capacity)
+            : m_bytes(capacity)
+            , m_length(capacity)
+        {
+        }
+
+        uint8_t* GetData()
+        {
+            return m_bytes.data();
+        }
+
+        //
+        // IBuffer
+        //
+
+        IFACEMETHODIMP get_Capacity(UINT32* value) override
+        {
+            return ExceptionBoundary(
+                [&]
+                {
+                    CheckInPointer(value);
+                    *value = static_cast<UINT32>(m_bytes.size());
+                });
+        }
+
+        IFACEMETHODIMP get_Length(UINT32* value) override
+        {
+            return ExceptionBoundary(
+                [&]
+                {
+                    CheckInPointer(value);
+                    *value = m_length;
+                });
+        }
+
+        IFACEMETHODIMP put_Length(UINT32 value) override
+        {
+            return ExceptionBoundary(
+                [&]
+                {
+                    if (value > m_bytes.size())
+                        ThrowHR(E_INVALIDARG);
+
+                    m_length = value;
+                });
+        }
+
+        //
+        // IBufferByteAccess
+        //
+
+        IFACEMETHODIMP Buffer(byte** value) override
+        {
+            return ExceptionBoundary(
+                [&]
+                {
+                    CheckAndClearOutPointer(value);
+                    *value = m_bytes.data();
+                });
+        }
+    };
+}}}}
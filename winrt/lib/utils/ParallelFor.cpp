@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "ParallelFor.h"
+
+#include <atomic>
+#include <thread>
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Shares out chunks between the calling thread and any thread pool
+    // workers.  Each thread takes the next unprocessed chunk until there are
+    // none left, so the work balances out even if some threads start late.
+    //
+    class ParallelForWork
+    {
+        std::function<void(uint32_t, uint32_t)> const& m_processRange;
+        uint32_t m_count;
+        uint32_t m_chunkCount;
+        std::atomic<uint32_t> m_nextChunk;
+
+        std::mutex m_mutex;
+        std::exception_ptr m_exception;
+
+    public:
+        ParallelForWork(uint32_t count, uint32_t chunkCount, std::function<void(uint32_t, uint32_t)> const& processRange)
+            : m_processRange(processRange)
+            , m_count(count)
+            , m_chunkCount(chunkCount)
+            , m_nextChunk(0)
+        {
+        }
+
+        void Run(unsigned workerCount)
+        {
+            PTP_WORK work = CreateThreadpoolWork(&ParallelForWork::WorkCallback, this, nullptr);
+
+            if (!work)
+                ThrowHR(HRESULT_FROM_WIN32(GetLastError()));
+
+            auto closeWarden = MakeScopeWarden([&] { CloseThreadpoolWork(work); });
+
+            for (unsigned i = 0; i < workerCount; i++)
+            {
+                SubmitThreadpoolWork(work);
+            }
+
+            ProcessChunks();
+
+            WaitForThreadpoolWorkCallbacks(work, FALSE);
+
+            if (m_exception)
+                std::rethrow_exception(m_exception);
+        }
+
+    private:
+        static void CALLBACK WorkCallback(PTP_CALLBACK_INSTANCE, void* context, PTP_WORK)
+        {
+            static_cast<ParallelForWork*>(context)->ProcessChunks();
+        }
+
+        void ProcessChunks()
+        {
+            for (;;)
+            {
+                uint32_t chunk = m_nextChunk++;
+
+                if (chunk >= m_chunkCount)
+                    return;
+
+                auto first = static_cast<uint32_t>(static_cast<uint64_t>(m_count) * chunk / m_chunkCount);
+                auto end = static_cast<uint32_t>(static_cast<uint64_t>(m_count) * (chunk + 1) / m_chunkCount);
+
+                try
+                {
+                    m_processRange(first, end - first);
+                }
+                catch (...)
+                {
+                    Lock lock(m_mutex);
+
+                    if (!m_exception)
+                        m_exception = std::current_exception();
+                }
+            }
+        }
+    };
+
+    void ParallelFor(
+        uint32_t count,
+        uint32_t chunkCount,
+        unsigned maxThreadCount,
+        std::function<void(uint32_t first, uint32_t count)> const& processRange)
+    {
+        unsigned threadCount = maxThreadCount ? maxThreadCount : std::thread::hardware_concurrency();
+
+        chunkCount = std::min(chunkCount, count);
+
+        if (threadCount < 2 || chunkCount < 2)
+        {
+            processRange(0, count);
+            return;
+        }
+
+        auto workerCount = std::min(threadCount, chunkCount) - 1;
+
+        ParallelForWork work(count, chunkCount, processRange);
+        work.Run(workerCount);
+    }
+
+    void ParallelForBytes(
+        uint32_t count,
+        uint32_t bytesPerItem,
+        unsigned maxThreadCount,
+        std::function<void(uint32_t first, uint32_t count)> const& processRange)
+    {
+        // Each chunk should be big enough to be worth handing to another thread.
+        const uint64_t minimumBytesPerChunk = 1024 * 1024;
+
+        // Using a few chunks per thread evens out the load if one thread is
+        // descheduled.
+        const unsigned chunksPerThread = 4;
+
+        uint64_t totalBytes = static_cast<uint64_t>(count) * bytesPerItem;
+
+        unsigned threadCount = maxThreadCount ? maxThreadCount : std::thread::hardware_concurrency();
+
+        if (totalBytes < ParallelForThresholdInBytes || threadCount < 2 || count < 2)
+        {
+            processRange(0, count);
+            return;
+        }
+
+        uint64_t chunkCount = std::min<uint64_t>(threadCount * chunksPerThread, totalBytes / minimumBytesPerChunk);
+        chunkCount = std::max<uint64_t>(2, std::min<uint64_t>(chunkCount, count));
+
+        auto workerCount = static_cast<unsigned>(std::min<uint64_t>(threadCount, chunkCount) - 1);
+
+        ParallelForWork work(count, static_cast<uint32_t>(chunkCount), processRange);
+        work.Run(workerCount);
+    }
+}}}}
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
+{
+    //
+    // Splits count items into chunkCount roughly equal ranges, and calls
+    // processRange(first, count) for each one.  Ranges are spread across
+    // the system thread pool, with the calling thread processing ranges
+    // too.  The first exception thrown by processRange is rethrown on the
+    // calling thread once every range has finished.
+    //
+    // maxThreadCount limits the number of threads used (including the
+    // calling thread); zero means one per logical processor.
+    //
+    void ParallelFor(
+        uint32_t count,
+        uint32_t chunkCount,
+        unsigned maxThreadCount,
+        std::function<void(uint32_t first, uint32_t count)> const& processRange);
+
+    //
+    // Like ParallelFor, but for cheap work on count items of bytesPerItem
+    // bytes each, such as copying rows of pixels.  The number of chunks is
+    // chosen from the total size, and anything smaller than
+    // ParallelForThresholdInBytes runs entirely on the calling thread,
+    // since waking up workers would cost more than they save.
+    //
+    const uint64_t ParallelForThresholdInBytes = 4 * 1024 * 1024;
+
+    void ParallelForBytes(
+        uint32_t count,
+        uint32_t bytesPerItem,
+        unsigned maxThreadCount,
+        std::function<void(uint32_t first, uint32_t count)> const& processRange);
+}}}}
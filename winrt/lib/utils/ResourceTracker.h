@@ -12,11 +12,23 @@
 
 #pragma once
 
+#include "LockUtilities.h"
+
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 {
     using namespace ::Microsoft::WRL;
     using namespace ::Microsoft::WRL::Wrappers;
 
+    //
+    // Maps resources to the wrappers that own them.
+    //
+    // The table is split into a number of shards, each with its own lock, and
+    // keys are distributed across the shards by their COM identity pointer.
+    // Lookups of different resources on different threads therefore rarely
+    // contend, while all operations on a single resource are still serialized
+    // by its shard lock (including constructing a new wrapper, which is what
+    // guarantees there is only ever one wrapper per resource).
+    //
     template<typename RESOURCE>
     class ResourceTracker
     {
@@ -24,8 +36,17 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
         typedef typename RESOURCE::wrapper_t VALUE;
         typedef typename RESOURCE::wrapper_interface_t IVALUE;
 
-        std::mutex m_mutex;
-        std::map<IUnknown*, WeakRef> m_resources;
+        typedef std::unordered_map<IUnknown*, WeakRef> ResourceMap;
+
+        struct Shard
+        {
+            std::mutex Mutex;
+            ResourceMap Resources;
+        };
+
+        static const size_t ShardCount = 16;
+
+        Shard m_shards[ShardCount];
 
     public:
         void Add(KEY* key, VALUE* value)
@@ -33,14 +54,16 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ComPtr<IUnknown> keyIdentity;
             ThrowIfFailed(key->QueryInterface(IID_PPV_ARGS(keyIdentity.GetAddressOf())));
 
-            std::lock_guard<std::mutex> lock(m_mutex);
-
             WeakRef weakValue;
             ThrowIfFailed(AsWeak(value, &weakValue));
 
-            auto it = m_resources.lower_bound(keyIdentity.Get());
+            auto& shard = GetShard(keyIdentity.Get());
+
+            Lock lock(shard.Mutex);
+
+            auto result = shard.Resources.emplace(keyIdentity.Get(), weakValue);
 
-            if (it != m_resources.end() && it->first == keyIdentity.Get())
+            if (!result.second)
             {
                 //
                 // We found an existing entry.  This should be impossible since
@@ -49,10 +72,6 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                 assert(false);
                 ThrowHR(E_UNEXPECTED);
             }
-
-            m_resources.insert(
-                it, 
-                std::make_pair(keyIdentity.Get(), weakValue));
         }
 
         template<typename CONSTRUCT_FN>
@@ -93,17 +112,19 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ComPtr<IUnknown> keyIdentity;
             ThrowIfFailed(key->QueryInterface(IID_PPV_ARGS(keyIdentity.GetAddressOf())));
 
-            std::lock_guard<std::mutex> lock(m_mutex);
+            auto& shard = GetShard(keyIdentity.Get());
+
+            Lock lock(shard.Mutex);
 
-            auto it = m_resources.find(keyIdentity.Get());
+            auto it = shard.Resources.find(keyIdentity.Get());
 
-            if (it == m_resources.end())
+            if (it == shard.Resources.end())
             {
                 assert(false);
                 ThrowHR(E_UNEXPECTED);
             }
 
-            m_resources.erase(it);
+            shard.Resources.erase(it);
         }
 
     private:
@@ -113,20 +134,20 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
             ComPtr<IUnknown> keyIdentity;
             ThrowIfFailed(key->QueryInterface(IID_PPV_ARGS(keyIdentity.GetAddressOf())));
 
-            std::lock_guard<std::mutex> lock(m_mutex);
+            auto& shard = GetShard(keyIdentity.Get());
 
-            auto it = m_resources.lower_bound(keyIdentity.Get());
+            Lock lock(shard.Mutex);
 
-            if (it != m_resources.end() && it->first == keyIdentity.Get())
+            auto it = shard.Resources.find(keyIdentity.Get());
+
+            if (it != shard.Resources.end())
             {
                 //
                 // We found an existing entry.  It's a weak reference so check that
                 // it is still valid.
                 //
-                auto weakRef = it->second;
-
                 ComPtr<IVALUE> ivalue;
-                (void)weakRef.As(&ivalue);
+                (void)it->second.As(&ivalue);
                 if (ivalue)
                 {
                     //
@@ -135,7 +156,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
                     // implementation class (consider canvas::CanvasDevice
                     // versus ICanvasDevice).
                     //
-                    // We know that we've only put VALUEs into m_resources, so
+                    // We know that we've only put VALUEs into the map, so
                     // we can safely cast from IVALUE to VALUE.
                     //
                     return std::make_pair(false, ComPtr<VALUE>(static_cast<VALUE*>(ivalue.Get())));
@@ -147,14 +168,25 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas
 
             WeakRef weakValue;
             ThrowIfFailed(AsWeak(value.Get(), &weakValue));
-        
-            m_resources.insert(
-                it,
-                std::make_pair(keyIdentity.Get(), weakValue));
+
+            shard.Resources.emplace(keyIdentity.Get(), weakValue);
 
             return std::make_pair(true, value);
         }
 
+        Shard& GetShard(IUnknown* keyIdentity)
+        {
+            //
+            // COM objects are heap allocated, so the low bits of their
+            // addresses carry little information.  Mix in higher bits before
+            // picking a shard.
+            //
+            auto bits = reinterpret_cast<uintptr_t>(keyIdentity);
+            bits ^= bits >> 12;
+
+            return m_shards[(bits >> 4) % ShardCount];
+        }
+
         void ValidateDevice(ComPtr<VALUE> const& value, bool wasNewlyConstructed, ICanvasDevice* expectedDevice)
         {
             //
@@ -43,7 +43,9 @@ STRING(SetFilledRegionDeterminationAfterBeginFigure, L"This operation is not all
 STRING(PathBuilderAddGeometryMidFigure, L"CanvasPathBuilder.AddGeometry may not be called in the middle of a figure.")
 STRING(PoppedWrongLayer, L"Attempting to close a CanvasActiveLayer that is not top of the stack. The most recently created layer must be closed first.")
 STRING(DidNotPopLayer, L"After calling CanvasDrawingSession.CreateLayer, you must close the resulting CanvasActiveLayer before ending the CanvasDrawingSession.")
+STRING(DidNotCloseSpriteBatch, L"After calling CanvasDrawingSession.CreateSpriteBatch, you must close the resulting CanvasSpriteBatch before ending the CanvasDrawingSession.")
 STRING(InvalidFontFamilyUri, L"The URI specified in the CanvasTextFormat's FontFamily is not a valid application URI that can be opened by StorageFile.GetFileFromApplicationUriAsync.")
 STRING(InvalidFontFamilyUriScheme, L"The URI specified in the CanvasTextFormat's FontFamily has an invalid scheme; the scheme may be omitted, or must be one of ms-appx:// or ms-appdata://.")
 STRING(InvalidAlphaModeForImageSource, L"An invalid alpha mode was specified. Use either CanvasAlphaMode.Ignore or CanvasAlphaMode.Premultiplied.")
 STRING(GetSharedDeviceUnknown, L"CanvasHardwareAcceleration.Unknown is not a valid parameter to this API.")
+STRING(TessellationBufferTooSmall, L"The buffer was too small to hold the tessellated geometry; %d triangles were required, but the buffer only holds %d.")
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "RemoveFromVisualTree.h"
+#include "RenderTargetSizePolicy.h"
 #include "utils/LockUtilities.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { namespace UI { namespace Xaml
@@ -103,6 +104,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
             CanvasAlphaMode AlphaMode;
             float Dpi;
             Size Size;
+            ABI::Windows::Foundation::Size AllocatedSize; // may be larger than Size; see RenderTargetSizePolicy
         };
 
     private:
@@ -452,12 +454,17 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
             if (callDrawHandlers)
             {
                 auto drawEventArgs = GetControl()->CreateDrawEventArgs(drawingSession.Get(), isRunningSlowly);
-                ThrowIfFailed(m_drawEventList.InvokeAll(GetControl(), drawEventArgs.Get()));
+                InvokeDrawHandlers(drawEventArgs.Get());
             }
 
             ThrowIfFailed(As<IClosable>(drawingSession)->Close());
         }        
 
+        void InvokeDrawHandlers(drawEventArgs_t* drawEventArgs)
+        {
+            ThrowIfFailed(m_drawEventList.InvokeAll(GetControl(), drawEventArgs));
+        }
+
         Color GetClearColor()
         {
             auto lock = GetLock();
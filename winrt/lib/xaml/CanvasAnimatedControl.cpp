@@ -154,6 +154,8 @@ CanvasAnimatedControl::CanvasAnimatedControl(std::shared_ptr<ICanvasAnimatedCont
     : BaseControl<CanvasAnimatedControlTraits>(adapter)
     , m_stepTimer(adapter)
     , m_hasUpdated(false)
+    , m_frameTimings(adapter)
+    , m_drawTiming{}
 {
     CreateSwapChainPanel();
 
@@ -247,6 +249,30 @@ IFACEMETHODIMP CanvasAnimatedControl::get_TargetElapsedTime(TimeSpan* value)
         });
 }
 
+IFACEMETHODIMP CanvasAnimatedControl::put_IsUpdatePipelined(boolean value)
+{
+    return ExceptionBoundary(
+        [&]
+        {
+            auto lock = GetLock();
+
+            m_sharedState.IsUpdatePipelined = !!value;
+        });
+}
+
+IFACEMETHODIMP CanvasAnimatedControl::get_IsUpdatePipelined(boolean* value)
+{
+    return ExceptionBoundary(
+        [&]
+        {
+            CheckInPointer(value);
+
+            auto lock = GetLock();
+
+            *value = m_sharedState.IsUpdatePipelined;
+        });
+}
+
 IFACEMETHODIMP CanvasAnimatedControl::put_Paused(boolean value)
 {
     return ExceptionBoundary(
@@ -380,6 +406,36 @@ IFACEMETHODIMP CanvasAnimatedControl::RunOnGameLoopThreadAsync(
         });
 }
 
+IFACEMETHODIMP CanvasAnimatedControl::GetFrameTimings(
+    UINT32* valueCount,
+    CanvasFrameTiming** valueElements)
+{
+    return ExceptionBoundary(
+        [&]
+        {
+            CheckInPointer(valueCount);
+            CheckAndClearOutPointer(valueElements);
+
+            auto frames = m_frameTimings.GetFrameTimings();
+
+            ComArray<CanvasFrameTiming> array(frames.begin(), frames.end());
+            array.Detach(valueCount, valueElements);
+        });
+}
+
+IFACEMETHODIMP CanvasAnimatedControl::GetFrameTimingPercentile(
+    float percentile,
+    CanvasFrameTiming* value)
+{
+    return ExceptionBoundary(
+        [&]
+        {
+            CheckInPointer(value);
+
+            *value = m_frameTimings.GetPercentile(percentile);
+        });
+}
+
 void CanvasAnimatedControl::CreateOrUpdateRenderTarget(
     ICanvasDevice* device,
     CanvasAlphaMode newAlphaMode,
@@ -393,43 +449,77 @@ void CanvasAnimatedControl::CreateOrUpdateRenderTarget(
     bool sizeChanged = (renderTarget->Size != newSize);
     bool needsCreate = needsTarget || alphaModeChanged || dpiChanged;
 
-    if (!needsCreate && !sizeChanged)
-        return;
-
     if (newSize.Width <= 0 || newSize.Height <= 0)
     {
-        // Zero-sized controls don't have swap chain objects
-        *renderTarget = RenderTarget{};
-        ThrowIfFailed(m_canvasSwapChainPanel->put_SwapChain(nullptr));
+        if (needsCreate || sizeChanged)
+        {
+            // Zero-sized controls don't have swap chain objects
+            *renderTarget = RenderTarget{};
+            ThrowIfFailed(m_canvasSwapChainPanel->put_SwapChain(nullptr));
+        }
+        return;
     }
-    else if (sizeChanged && !needsCreate)
-    {
-        ThrowIfFailed(renderTarget->Target->ResizeBuffersWithWidthAndHeight(newSize.Width, newSize.Height));
 
-        renderTarget->Size = newSize;
-    }
-    else
+    if (needsCreate)
     {
+        auto allocatedSize = m_sizePolicy.GetAllocationSize(Size{}, newSize);
+
         renderTarget->Target = GetAdapter()->CreateCanvasSwapChain(
             device,
-            newSize.Width,
-            newSize.Height,
+            allocatedSize.Width,
+            allocatedSize.Height,
             newDpi,
             newAlphaMode);
 
         renderTarget->AlphaMode = newAlphaMode;
         renderTarget->Dpi = newDpi;
+        renderTarget->AllocatedSize = allocatedSize;
+
+        ThrowIfFailed(renderTarget->Target->put_SourceSize(newSize));
         renderTarget->Size = newSize;
 
         ThrowIfFailed(m_canvasSwapChainPanel->put_SwapChain(renderTarget->Target.Get()));            
     }
+    else
+    {
+        UpdateSwapChainSize(renderTarget, newSize);
+    }
+}
+
+void CanvasAnimatedControl::UpdateSwapChainSize(
+    RenderTarget* renderTarget,
+    Size const& newSize)
+{
+    //
+    // The swap chain's buffers may be larger than the control, in which case
+    // SourceSize is set so that only the part matching the control is shown.
+    // This is called on every frame, even when the size hasn't changed, so
+    // that the size policy can tell when the control has stayed smaller than
+    // its buffers for long enough to be worth shrinking them.
+    //
+    auto allocatedSize = m_sizePolicy.GetAllocationSize(renderTarget->AllocatedSize, newSize);
+
+    if (allocatedSize != renderTarget->AllocatedSize)
+    {
+        ThrowIfFailed(renderTarget->Target->ResizeBuffersWithWidthAndHeight(allocatedSize.Width, allocatedSize.Height));
+        renderTarget->AllocatedSize = allocatedSize;
+    }
+    else if (renderTarget->Size == newSize)
+    {
+        return;
+    }
+
+    // ResizeBuffers resets the source size, so this is always set after the
+    // buffers change as well as when the control itself is resized.
+    ThrowIfFailed(renderTarget->Target->put_SourceSize(newSize));
+    renderTarget->Size = newSize;
 }
 
 ComPtr<CanvasAnimatedDrawEventArgs> CanvasAnimatedControl::CreateDrawEventArgs(
     ICanvasDrawingSession* drawingSession,
     bool isRunningSlowly)
 {
-    auto timing = GetTimingInformationFromTimer();
+    auto timing = m_drawTiming;
     timing.IsRunningSlowly = isRunningSlowly;
 
     auto drawEventArgs = Make<CanvasAnimatedDrawEventArgs>(drawingSession, timing);
@@ -590,6 +680,13 @@ void CanvasAnimatedControl::ChangedImpl()
             return;
         }
     }
+
+    //
+    // The tick loop may have been stopped (eg. by being unloaded) while a
+    // pipelined update was still running on a worker thread.  That has to
+    // finish before anything else touches the control's state.
+    //
+    m_updatePipeline.WaitUntilIdle();
         
     //
     // Call Trim on application suspend, but only once we are sure the
@@ -763,6 +860,9 @@ bool CanvasAnimatedControl::Tick(
 {
     RenderTarget* renderTarget = GetCurrentRenderTarget();
 
+    // Time spent waiting for vertical blank is counted as part of Present.
+    m_frameTimings.BeginFrame();
+
     //
     // On hardware rendering, the control synchronizes to vertical blank 
     // in order to
@@ -803,6 +903,18 @@ bool CanvasAnimatedControl::Tick(
         GetAdapter()->Sleep(static_cast<DWORD>(StepTimer::TicksToMilliseconds(StepTimer::DefaultTargetElapsedTime)));
     }
 
+    m_frameTimings.EndPhase(FramePhase::Present);
+
+    //
+    // Any pipelined update this tick starts must finish before the tick
+    // returns.  It only overlaps this tick's Draw and Present: the game loop
+    // thread goes on to dispatch input events and other work once the tick
+    // is done, and these must never run at the same time as Update.  This
+    // also means nothing is left running on the worker thread if this tick
+    // stops the update/render loop.
+    //
+    auto waitForPipelinedUpdate = MakeScopeWarden([&] { m_updatePipeline.WaitUntilIdle(); });
+
     //
     // Access shared state that's shared between the UI thread and the
     // update/render thread.  This is done in one place in order to hold the
@@ -824,6 +936,7 @@ bool CanvasAnimatedControl::Tick(
 
     bool isPaused = m_sharedState.IsPaused;
     bool firstTickAfterWasPaused = m_sharedState.FirstTickAfterWasPaused;
+    bool isUpdatePipelined = m_sharedState.IsUpdatePipelined;
 
     m_sharedState.ShouldResetElapsedTime = false;
     m_sharedState.FirstTickAfterWasPaused = false;
@@ -895,13 +1008,40 @@ bool CanvasAnimatedControl::Tick(
 
     UpdateResult updateResult{};
 
-    if (areResourcesCreated && !isPaused)
+    //
+    // A pipelined update started by the last tick is drawn by this one.
+    //
+    bool tookPipelinedUpdate = m_updatePipeline.TakeResult(&updateResult);
+
+    if (tookPipelinedUpdate)
+    {
+        m_frameTimings.AddPhaseTime(FramePhase::Update, updateResult.PipelinedUpdateTime);
+        m_hasUpdated |= updateResult.Updated;
+    }
+
+    if (areResourcesCreated && !isPaused && isUpdatePipelined)
     {
         bool forceUpdate = (firstTickAfterWasPaused || !m_hasUpdated);
 
-        updateResult = Update(forceUpdate);
+        // The timing is captured before the next update starts changing it
+        m_drawTiming = GetTimingInformationFromTimer();
 
-        m_hasUpdated |= updateResult.Updated;
+        StartPipelinedUpdate(forceUpdate);
+    }
+    else
+    {
+        if (areResourcesCreated && !isPaused && !tookPipelinedUpdate)
+        {
+            bool forceUpdate = (firstTickAfterWasPaused || !m_hasUpdated);
+
+            m_frameTimings.BeginPhase();
+            updateResult = Update(forceUpdate);
+            m_frameTimings.EndPhase(FramePhase::Update);
+
+            m_hasUpdated |= updateResult.Updated;
+        }
+
+        m_drawTiming = GetTimingInformationFromTimer();
     }
 
     //
@@ -910,15 +1050,17 @@ bool CanvasAnimatedControl::Tick(
     // This is desireable since using Present to wait for the vsync can
     // result in missed frames.
     //
+    bool drew = false;
+
     if ((updateResult.Updated || forceDraw || invalidated) && isVisible)
     {
         //
         // If the control's size has changed then the swapchain's buffers
-        // need to be resized as appropriate.
+        // may need to be resized.
         //
-        if (renderTarget->Size != currentSize)
+        if (currentSize.Width <= 0 || currentSize.Height <= 0 || !renderTarget->Target)
         {
-            if (currentSize.Width <= 0 || currentSize.Height <= 0 || !renderTarget->Target)
+            if (renderTarget->Size != currentSize)
             {
                 //
                 // Switching between zero and non-zero sized rendertargets requires calling
@@ -927,32 +1069,71 @@ bool CanvasAnimatedControl::Tick(
                 //
                 return false;
             }
-            else
-            {
-                // This can be done on the update/render thread because:
-                //
-                //  - no XAML methods are called
-                //
-                //  - the current render target won't be updated by the UI thread
-                //    while the update/render thread is running
-                //
-                ThrowIfFailed(renderTarget->Target->ResizeBuffersWithWidthAndHeight(currentSize.Width, currentSize.Height));
-                renderTarget->Size = currentSize;
-            }
+        }
+        else
+        {
+            // This can be done on the update/render thread because:
+            //
+            //  - no XAML methods are called
+            //
+            //  - the current render target won't be updated by the UI thread
+            //    while the update/render thread is running
+            //
+            UpdateSwapChainSize(renderTarget, currentSize);
         }
 
         if (renderTarget->Target)
         {
             bool invokeDrawHandlers = (areResourcesCreated && (m_hasUpdated || invalidated));
 
+            m_frameTimings.BeginPhase();
             Draw(renderTarget->Target.Get(), clearColor, invokeDrawHandlers, updateResult.IsRunningSlowly);
+            m_frameTimings.EndPhase(FramePhase::Draw);
+
+            m_frameTimings.BeginPhase();
             ThrowIfFailed(renderTarget->Target->Present());
+            m_frameTimings.EndPhase(FramePhase::Present);
+
+            drew = true;
         }
     }
 
+    if (updateResult.Updated || drew)
+    {
+        m_frameTimings.EndFrame(updateResult.UpdateCount, updateResult.IsRunningSlowly);
+    }
+
     return areResourcesCreated && !isPaused;
 }
 
+void CanvasAnimatedControl::StartPipelinedUpdate(bool forceUpdate)
+{
+    //
+    // The pipeline keeps the control (and so m_updatePipeline) alive while
+    // the update runs, even if the control is unloaded in the meantime.  It
+    // hands that reference back to the game loop or UI thread when it waits
+    // for the update, so the control is never destroyed on the worker.
+    //
+    auto work = m_updatePipeline.Begin(
+        As<IUnknown>(this),
+        [this, forceUpdate]
+        {
+            auto adapter = GetAdapter();
+
+            auto startTime = adapter->GetPerformanceCounter().QuadPart;
+            auto result = Update(forceUpdate);
+            result.PipelinedUpdateTime = adapter->GetPerformanceCounter().QuadPart - startTime;
+
+            return result;
+        });
+
+    auto cancelWarden = MakeScopeWarden([&] { m_updatePipeline.Cancel(); });
+
+    GetAdapter()->RunOnWorkerThread(std::move(work));
+
+    cancelWarden.Dismiss();
+}
+
 CanvasAnimatedControl::UpdateResult CanvasAnimatedControl::Update(bool forceUpdate)
 {
     UpdateResult result{};
@@ -968,6 +1149,7 @@ CanvasAnimatedControl::UpdateResult CanvasAnimatedControl::Update(bool forceUpda
 
             result.IsRunningSlowly = isRunningSlowly;
             result.Updated = true;
+            result.UpdateCount++;
         });
 
     return result;
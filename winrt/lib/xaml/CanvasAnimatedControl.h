@@ -16,7 +16,9 @@
 #include "AnimatedControlInput.h"
 #include "BaseControlAdapter.h"
 #include "CanvasSwapChainPanel.h"
+#include "FrameTimingRecorder.h"
 #include "StepTimer.h"
+#include "UpdatePipeline.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { namespace UI { namespace Xaml
 {
@@ -116,6 +118,9 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         virtual std::shared_ptr<CanvasGameLoop> CreateAndStartGameLoop(ComPtr<ISwapChainPanel> swapChainPanel, ComPtr<AnimatedControlInput> input) = 0;
 
         virtual void Sleep(DWORD timeInMs) = 0;
+
+        // Runs fn on a thread pool thread; used for pipelined updates.
+        virtual void RunOnWorkerThread(std::function<void()>&& fn) = 0;
     };
 
     std::shared_ptr<ICanvasAnimatedControlAdapter> CreateCanvasAnimatedControlAdapter();
@@ -141,6 +146,12 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         StepTimer m_stepTimer;
         bool m_hasUpdated;
 
+        FrameTimingRecorder m_frameTimings;
+
+        // Only used by whichever thread currently owns the render target: the
+        // update/render thread while it is running, otherwise the UI thread.
+        RenderTargetSizePolicy m_sizePolicy;
+
         //
         // State shared between the UI thread and the update/render thread.
         // Access to this must be guarded using BaseControl's mutex.
@@ -155,6 +166,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
                 , ShouldResetElapsedTime(false)
                 , NeedsDraw(true)
                 , Invalidated(false)
+                , IsUpdatePipelined(false)
             {}
 
             bool IsPaused;
@@ -164,6 +176,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
             bool ShouldResetElapsedTime;
             bool NeedsDraw;
             bool Invalidated;
+            bool IsUpdatePipelined;
             std::vector<ComPtr<AnimatedControlAsyncAction>> PendingAsyncActions;
         };
 
@@ -194,6 +207,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
 
         IFACEMETHODIMP get_TargetElapsedTime(TimeSpan* value) override;
 
+        IFACEMETHODIMP put_IsUpdatePipelined(boolean value) override;
+
+        IFACEMETHODIMP get_IsUpdatePipelined(boolean* value) override;
+
         IFACEMETHODIMP put_Paused(boolean value) override;
 
         IFACEMETHODIMP get_Paused(boolean* value) override;
@@ -212,6 +229,14 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
             IDispatchedHandler* callback,
             IAsyncAction** asyncAction) override;
 
+        IFACEMETHODIMP GetFrameTimings(
+            UINT32* valueCount,
+            CanvasFrameTiming** valueElements) override;
+
+        IFACEMETHODIMP GetFrameTimingPercentile(
+            float percentile,
+            CanvasFrameTiming* value) override;
+
         //
         // BaseControl
         //
@@ -245,10 +270,28 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         {
             bool Updated;
             bool IsRunningSlowly;
+            int32_t UpdateCount;
+            int64_t PipelinedUpdateTime;    // in performance counter units
         };
 
         UpdateResult Update(bool forceUpdate);
 
+        //
+        // When IsUpdatePipelined is set, each tick starts the Update for the
+        // next frame on a worker thread and then draws the results of the
+        // previous one.  The worker only ever touches the step timer while
+        // the game loop thread is waiting for it, and draws use the timing
+        // captured before it started (m_drawTiming).
+        //
+        UpdatePipeline<UpdateResult> m_updatePipeline;
+        CanvasTimingInformation m_drawTiming;
+
+        void StartPipelinedUpdate(bool forceUpdate);
+
+        void UpdateSwapChainSize(
+            RenderTarget* renderTarget,
+            Size const& newSize);
+
         void ChangedImpl();
 
         CanvasTimingInformation GetTimingInformationFromTimer();
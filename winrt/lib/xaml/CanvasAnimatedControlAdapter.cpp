@@ -237,6 +237,23 @@ public:
         ::Sleep(timeInMs);
     }
 
+    virtual void RunOnWorkerThread(std::function<void()>&& fn) override
+    {
+        auto handler = Callback<AddFtmBase<IWorkItemHandler>::Type>(
+            [fn](IAsyncAction*)
+            {
+                return ExceptionBoundary([&] { fn(); });
+            });
+        CheckMakeResult(handler);
+
+        ComPtr<IAsyncAction> ignoredAction;
+        ThrowIfFailed(m_threadPoolStatics->RunWithPriorityAndOptionsAsync(
+            handler.Get(),
+            WorkItemPriority_High,
+            WorkItemOptions_None,
+            &ignoredAction));
+    }
+
     virtual LARGE_INTEGER GetPerformanceCounter() override
     {
         LARGE_INTEGER counter;
@@ -40,8 +40,9 @@ IFACEMETHODIMP CanvasDrawEventArgsFactory::Create(
         });
 }
 
-CanvasDrawEventArgs::CanvasDrawEventArgs(ICanvasDrawingSession* drawingSession) 
+CanvasDrawEventArgs::CanvasDrawEventArgs(ICanvasDrawingSession* drawingSession, Rect const& updateRectangle) 
     : m_drawingSession(drawingSession)
+    , m_updateRectangle(updateRectangle)
 {}
 
 IFACEMETHODIMP CanvasDrawEventArgs::get_DrawingSession(ICanvasDrawingSession** value)
@@ -55,11 +56,23 @@ IFACEMETHODIMP CanvasDrawEventArgs::get_DrawingSession(ICanvasDrawingSession** v
         });
 }
 
+IFACEMETHODIMP CanvasDrawEventArgs::get_UpdateRectangle(Rect* value)
+{
+    return ExceptionBoundary(
+        [&]
+        {
+            CheckInPointer(value);
+            m_drawingSession.EnsureNotClosed();
+            *value = m_updateRectangle;
+        });
+}
+
 class CanvasControlAdapter : public BaseControlAdapter<CanvasControlTraits>
 {
     ComPtr<ICompositionTargetStatics> m_compositionTargetStatics;
     ComPtr<ICanvasImageSourceFactory> m_canvasImageSourceFactory;
     ComPtr<IActivationFactory> m_imageControlFactory;
+    ComPtr<IActivationFactory> m_rectangleGeometryFactory;
 
 public:
     CanvasControlAdapter()
@@ -79,6 +92,10 @@ public:
         ThrowIfFailed(GetActivationFactory(
             HStringReference(RuntimeClass_Windows_UI_Xaml_Controls_Image).Get(),
             &m_imageControlFactory));
+
+        ThrowIfFailed(GetActivationFactory(
+            HStringReference(RuntimeClass_Windows_UI_Xaml_Media_RectangleGeometry).Get(),
+            &m_rectangleGeometryFactory));
     }
 
     virtual RegisteredEvent AddCompositionRenderingCallback(IEventHandler<IInspectable*>* handler) override
@@ -129,6 +146,17 @@ public:
 
         return image;
     }
+
+    virtual ComPtr<IRectangleGeometry> CreateRectangleGeometry() override
+    {
+        ComPtr<IInspectable> inspectableGeometry;
+        ThrowIfFailed(m_rectangleGeometryFactory->ActivateInstance(&inspectableGeometry));
+
+        ComPtr<IRectangleGeometry> geometry;
+        ThrowIfFailed(inspectableGeometry.As(&geometry));
+
+        return geometry;
+    }
 };
 
 
@@ -162,6 +190,8 @@ CanvasControl::CanvasControl(
     std::shared_ptr<ICanvasControlAdapter> adapter)
     : BaseControl(adapter)
     , m_needToHookCompositionRendering(false)
+    , m_imageSourceSize{}
+    , m_arrangedSize{}
 {
     CreateImageControl();
 }
@@ -182,11 +212,20 @@ void CanvasControl::CreateImageControl()
     ThrowIfFailed(m_imageControl->put_Stretch(Stretch_Fill));
 
     //
-    // Set the image control as the content of this control.
+    // The CanvasImageSource may be larger than the control (see
+    // UpdateImageSourceSize), in which case the image control is arranged to
+    // the size of the image source and this clip hides the unused part.
     //
     ComPtr<IUIElement> imageAsUIElement;
     ThrowIfFailed(m_imageControl.As(&imageAsUIElement));
 
+    m_imageClip = GetAdapter()->CreateRectangleGeometry();
+    ThrowIfFailed(imageAsUIElement->put_Clip(m_imageClip.Get()));
+
+    //
+    // Set the image control as the content of this control.
+    //
+
     ComPtr<IUserControl> thisAsUserControl;
     ThrowIfFailed(GetComposableBase().As(&thisAsUserControl));
     thisAsUserControl->put_Content(imageAsUIElement.Get());
@@ -225,8 +264,18 @@ HRESULT CanvasControl::OnCompositionRendering(IInspectable*, IInspectable*)
 
             auto lock = GetLock();
             m_renderingEventRegistration.Release();
+            ShrinkImageSourceIfNecessary(lock);
+            bool needsDraw = !m_invalidRegion.IsEmpty();
             lock.unlock();
 
+            //
+            // Rendering may have only been hooked to count frames towards
+            // shrinking the image source, in which case there's nothing to
+            // draw.
+            //
+            if (!needsDraw)
+                return;
+
             if (!IsWindowVisible())
                 return;
 
@@ -236,11 +285,59 @@ HRESULT CanvasControl::OnCompositionRendering(IInspectable*, IInspectable*)
                     if (!target)
                         return;
 
-                    Draw(target, clearColor, callDrawHandlers, false);
+                    //
+                    // This is taken after RunWithRenderTarget has had a
+                    // chance to recreate the target, since a new target
+                    // always needs to be drawn in full.
+                    //
+                    auto invalidRegion = TakeInvalidRegion();
+                    auto size = GetCurrentRenderTarget()->Size;
+                    auto dpi = GetCurrentRenderTarget()->Dpi;
+
+                    if (invalidRegion.IsFull())
+                    {
+                        DrawRegion(target, clearColor, callDrawHandlers, Rect{ 0, 0, size.Width, size.Height });
+                        return;
+                    }
+
+                    for (auto region : invalidRegion.GetRectangles())
+                    {
+                        if (InvalidRegion::ClipAndSnapToPixels(&region, size, dpi))
+                            DrawRegion(target, clearColor, callDrawHandlers, region);
+                    }
                 });
         });
 }
 
+InvalidRegion CanvasControl::TakeInvalidRegion()
+{
+    auto lock = GetLock();
+
+    auto invalidRegion = m_invalidRegion;
+    m_invalidRegion.Clear();
+
+    return invalidRegion;
+}
+
+void CanvasControl::DrawRegion(
+    CanvasImageSource* target,
+    Color const& clearColor,
+    bool callDrawHandlers,
+    Rect const& region)
+{
+    ComPtr<ICanvasDrawingSession> drawingSession;
+    ThrowIfFailed(target->CreateDrawingSessionWithUpdateRectangle(clearColor, region, &drawingSession));
+
+    if (callDrawHandlers)
+    {
+        auto drawEventArgs = Make<CanvasDrawEventArgs>(drawingSession.Get(), region);
+        CheckMakeResult(drawEventArgs);
+        InvokeDrawHandlers(drawEventArgs.Get());
+    }
+
+    ThrowIfFailed(As<IClosable>(drawingSession)->Close());
+}
+
 void CanvasControl::CreateOrUpdateRenderTarget(
     ICanvasDevice* device,
     CanvasAlphaMode newAlphaMode,
@@ -248,49 +345,167 @@ void CanvasControl::CreateOrUpdateRenderTarget(
     Size newSize,
     RenderTarget* renderTarget)
 {
+    auto imageSourceSize = GetImageSourceSize(newSize);
+
     bool needsCreate = (renderTarget->Target == nullptr);
     needsCreate |= (renderTarget->AlphaMode != newAlphaMode);
     needsCreate |= (renderTarget->Dpi != newDpi);
-    needsCreate |= (renderTarget->Size != newSize);
+    needsCreate |= (renderTarget->AllocatedSize != imageSourceSize);
 
-    if (!needsCreate)
+    bool sizeChanged = (renderTarget->Size != newSize);
+
+    if (!needsCreate && !sizeChanged)
         return;
 
+    {
+        auto lock = GetLock();
+        m_invalidRegion.InvalidateAll();
+    }
+
     if (newSize.Width <= 0 || newSize.Height <= 0)
     {
         // Zero-sized controls don't have image sources
         *renderTarget = RenderTarget{};
         ThrowIfFailed(m_imageControl->put_Source(nullptr));
     }
-    else
+    else if (needsCreate)
     {
         renderTarget->Target = GetAdapter()->CreateCanvasImageSource(
             device,
-            newSize.Width,
-            newSize.Height,
+            imageSourceSize.Width,
+            imageSourceSize.Height,
             newDpi,
             newAlphaMode);
 
         renderTarget->AlphaMode = newAlphaMode;
         renderTarget->Dpi = newDpi;
         renderTarget->Size = newSize;
+        renderTarget->AllocatedSize = imageSourceSize;
 
         auto baseImageSource = As<IImageSource>(renderTarget->Target);
         ThrowIfFailed(m_imageControl->put_Source(baseImageSource.Get()));
     }
+    else
+    {
+        // The existing image source is big enough; only the part of it that
+        // is drawn to changes.
+        renderTarget->Size = newSize;
+    }
+}
+
+//
+// Called during layout to decide what size CanvasImageSource to use for a
+// control of the given size.  This is done here, rather than when the image
+// source is created, because the image control has to be arranged to match.
+//
+Size CanvasControl::UpdateImageSourceSize(Size const& controlSize)
+{
+    auto lock = GetLock();
+
+    m_arrangedSize = controlSize;
+
+    //
+    // Layout only ever grows the image source.  Shrinking it is left to
+    // ShrinkImageSourceIfNecessary, since layout stops being run as soon
+    // as the control stops changing size.
+    //
+    auto imageSourceSize = RenderTargetSizePolicy::GrowToFit(m_imageSourceSize, controlSize);
+
+    if (imageSourceSize != m_imageSourceSize)
+    {
+        m_imageSourceSize = imageSourceSize;
+        Changed(lock);
+    }
+    else if (RenderTargetSizePolicy::ShouldShrink(m_imageSourceSize, controlSize))
+    {
+        RequestCompositionRendering(lock);
+    }
+
+    return imageSourceSize;
+}
+
+//
+// Called once per rendered frame.  While the image source is much bigger
+// than the control this keeps CompositionTarget.Rendering hooked, so that
+// the size policy sees enough frames to decide to shrink it.
+//
+void CanvasControl::ShrinkImageSourceIfNecessary(Lock const& lock)
+{
+    MustOwnLock(lock);
+
+    auto imageSourceSize = m_sizePolicy.GetAllocationSize(m_imageSourceSize, m_arrangedSize);
+
+    if (imageSourceSize != m_imageSourceSize)
+    {
+        m_imageSourceSize = imageSourceSize;
+        Changed(lock);
+
+        //
+        // The image control is arranged to the size of the image source, so
+        // layout needs to run again to pick up the new size.
+        //
+        if (auto element = MaybeAs<IUIElement>(GetComposableBase()))
+            ThrowIfFailed(element->InvalidateArrange());
+    }
+    else if (RenderTargetSizePolicy::ShouldShrink(m_imageSourceSize, m_arrangedSize))
+    {
+        RequestCompositionRendering(lock);
+    }
+}
+
+Size CanvasControl::GetImageSourceSize(Size const& controlSize)
+{
+    auto lock = GetLock();
+
+    //
+    // If layout hasn't yet seen this size then fall back to an image source
+    // that exactly fits the control.
+    //
+    if (controlSize.Width > m_imageSourceSize.Width || controlSize.Height > m_imageSourceSize.Height)
+        return controlSize;
+
+    return m_imageSourceSize;
 }
 
 ComPtr<CanvasDrawEventArgs> CanvasControl::CreateDrawEventArgs(ICanvasDrawingSession* drawingSession, bool)
 {
-    auto drawEventArgs = Make<CanvasDrawEventArgs>(drawingSession);
+    auto size = GetCurrentRenderTarget()->Size;
+
+    auto drawEventArgs = Make<CanvasDrawEventArgs>(drawingSession, Rect{ 0, 0, size.Width, size.Height });
     CheckMakeResult(drawEventArgs);
     return drawEventArgs;
 }
 
+IFACEMETHODIMP CanvasControl::InvalidateRegion(Rect region)
+{
+    return ExceptionBoundary(
+        [&]
+        {
+            if (region.Width < 0 || region.Height < 0)
+                ThrowHR(E_INVALIDARG);
+
+            if (region.Width == 0 || region.Height == 0)
+                return;
+
+            auto lock = GetLock();
+            m_invalidRegion.Invalidate(region);
+            RequestCompositionRendering(lock);
+        });
+}
+
 void CanvasControl::Changed(Lock const& lock, ChangeReason)
 {
     MustOwnLock(lock);
 
+    m_invalidRegion.InvalidateAll();
+
+    RequestCompositionRendering(lock);
+}
+
+void CanvasControl::RequestCompositionRendering(Lock const& lock)
+{
+    MustOwnLock(lock);
+
     if (!IsLoaded())
         return;
 
@@ -369,10 +584,15 @@ IFACEMETHODIMP CanvasControl::ArrangeOverride(
     return ExceptionBoundary(
         [&]
         {
+            auto imageSourceSize = UpdateImageSourceSize(finalSize);
+
             //
-            // Call Arrange on our children (in this case just the image control).
+            // Call Arrange on our children (in this case just the image
+            // control).  This is arranged to the size of the image source,
+            // and clipped to our own size.
             //
-            ThrowIfFailed(As<IUIElement>(m_imageControl)->Arrange(Rect{ 0, 0, finalSize.Width, finalSize.Height }));
+            ThrowIfFailed(As<IUIElement>(m_imageControl)->Arrange(Rect{ 0, 0, imageSourceSize.Width, imageSourceSize.Height }));
+            ThrowIfFailed(m_imageClip->put_Rect(Rect{ 0, 0, finalSize.Width, finalSize.Height }));
 
             //
             // Reply that we're happy to accept the size chosen by the layout engine.
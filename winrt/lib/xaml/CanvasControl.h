@@ -13,6 +13,7 @@
 #pragma once
 
 #include "BaseControl.h"
+#include "InvalidRegion.h"
 
 namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { namespace UI { namespace Xaml
 {
@@ -41,11 +42,14 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         InspectableClass(RuntimeClass_Microsoft_Graphics_Canvas_UI_Xaml_CanvasDrawEventArgs, BaseTrust);
 
         ClosablePtr<ICanvasDrawingSession> m_drawingSession;
+        Rect m_updateRectangle;
 
      public:
-         CanvasDrawEventArgs(ICanvasDrawingSession* drawingSession);
+         CanvasDrawEventArgs(ICanvasDrawingSession* drawingSession, Rect const& updateRectangle = Rect{});
 
          IFACEMETHODIMP get_DrawingSession(ICanvasDrawingSession** value);
+
+         IFACEMETHODIMP get_UpdateRectangle(Rect* value);
     };
 
     typedef ITypedEventHandler<CanvasControl*, CanvasDrawEventArgs*> Static_DrawEventHandler;
@@ -73,6 +77,7 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         virtual RegisteredEvent AddSurfaceContentsLostCallback(IEventHandler<IInspectable*>*) = 0;
         virtual ComPtr<CanvasImageSource> CreateCanvasImageSource(ICanvasDevice* device, float width, float height, float dpi, CanvasAlphaMode alphaMode) = 0;
         virtual ComPtr<IImage> CreateImageControl() = 0;
+        virtual ComPtr<IRectangleGeometry> CreateRectangleGeometry() = 0;
         
 #define CB_HELPER(NAME, DELEGATE)                                       \
         template<typename T, typename METHOD, typename... EXTRA_ARGS>   \
@@ -107,9 +112,16 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         RegisteredEvent m_renderingEventRegistration; // protected by BaseControl's mutex
         bool m_needToHookCompositionRendering;        // protected by BaseControl's mutex
 
+        InvalidRegion m_invalidRegion;                // protected by BaseControl's mutex
+
         RegisteredEvent m_surfaceContentsLostEventRegistration;
 
         ComPtr<IImage> m_imageControl;
+        ComPtr<IRectangleGeometry> m_imageClip;
+
+        RenderTargetSizePolicy m_sizePolicy;          // protected by BaseControl's mutex
+        Size m_imageSourceSize;                       // protected by BaseControl's mutex
+        Size m_arrangedSize;                          // protected by BaseControl's mutex
         
     public:
         CanvasControl(std::shared_ptr<ICanvasControlAdapter> adapter);
@@ -129,6 +141,8 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
                 });
         }
 
+        IFACEMETHODIMP InvalidateRegion(Rect region) override;
+
         //
         // IFrameworkElementOverrides
         //
@@ -167,6 +181,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
 
     private:
         void HookCompositionRenderingIfNecessary();
+        void RequestCompositionRendering(Lock const& lock);
+
+        InvalidRegion TakeInvalidRegion();
+        void DrawRegion(CanvasImageSource* target, Color const& clearColor, bool callDrawHandlers, Rect const& region);
 
         void CreateImageControl();
         void RegisterEventHandlers();
@@ -176,6 +194,10 @@ namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { na
         HRESULT OnSurfaceContentsLost(IInspectable* sender, IInspectable* args);
 
         void ChangedImpl();
+
+        Size UpdateImageSourceSize(Size const& controlSize);
+        void ShrinkImageSourceIfNecessary(Lock const& lock);
+        Size GetImageSourceSize(Size const& controlSize);
     };
 
 }}}}}}
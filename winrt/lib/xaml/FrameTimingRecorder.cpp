@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "FrameTimingRecorder.h"
+
+using namespace ABI::Microsoft::Graphics::Canvas::UI::Xaml;
+
+FrameTimingRecorder::FrameTimingRecorder(
+    std::shared_ptr<ICanvasTimingAdapter> adapter,
+    size_t capacity)
+    : m_adapter(adapter)
+    , m_frequency(adapter->GetPerformanceFrequency().QuadPart)
+    , m_frameStartTime(0)
+    , m_phaseStartTime(0)
+    , m_currentFrame()
+    , m_frames(capacity)
+    , m_nextFrame(0)
+    , m_frameCount(0)
+{
+    assert(m_frequency > 0);
+    assert(capacity > 0);
+}
+
+void FrameTimingRecorder::BeginFrame()
+{
+    m_frameStartTime = m_adapter->GetPerformanceCounter().QuadPart;
+    m_phaseStartTime = m_frameStartTime;
+    m_currentFrame = CanvasFrameTiming{};
+}
+
+void FrameTimingRecorder::BeginPhase()
+{
+    m_phaseStartTime = m_adapter->GetPerformanceCounter().QuadPart;
+}
+
+void FrameTimingRecorder::EndPhase(FramePhase phase)
+{
+    AddPhaseTime(phase, m_adapter->GetPerformanceCounter().QuadPart - m_phaseStartTime);
+}
+
+void FrameTimingRecorder::AddPhaseTime(FramePhase phase, int64_t counterTicks)
+{
+    auto ticks = CounterToTicks(counterTicks);
+
+    switch (phase)
+    {
+    case FramePhase::Update:
+        m_currentFrame.UpdateTime.Duration += ticks;
+        break;
+
+    case FramePhase::Draw:
+        m_currentFrame.DrawTime.Duration += ticks;
+        break;
+
+    case FramePhase::Present:
+        m_currentFrame.PresentTime.Duration += ticks;
+        break;
+
+    default:
+        assert(false);
+    }
+}
+
+void FrameTimingRecorder::EndFrame(int32_t updateCount, bool isRunningSlowly)
+{
+    m_currentFrame.TotalTime.Duration = CounterToTicks(m_adapter->GetPerformanceCounter().QuadPart - m_frameStartTime);
+    m_currentFrame.UpdateCount = updateCount;
+    m_currentFrame.IsRunningSlowly = isRunningSlowly;
+
+    Lock lock(m_mutex);
+
+    m_frames[m_nextFrame] = m_currentFrame;
+    m_nextFrame = (m_nextFrame + 1) % m_frames.size();
+    m_frameCount = std::min(m_frameCount + 1, m_frames.size());
+}
+
+std::vector<CanvasFrameTiming> FrameTimingRecorder::GetFrameTimings()
+{
+    Lock lock(m_mutex);
+
+    std::vector<CanvasFrameTiming> frames;
+    frames.reserve(m_frameCount);
+
+    size_t oldestFrame = (m_nextFrame + m_frames.size() - m_frameCount) % m_frames.size();
+
+    for (size_t i = 0; i < m_frameCount; i++)
+    {
+        frames.push_back(m_frames[(oldestFrame + i) % m_frames.size()]);
+    }
+
+    return frames;
+}
+
+template<typename T, typename GET_FIELD>
+static T GetFieldPercentile(std::vector<CanvasFrameTiming> const& frames, size_t rank, GET_FIELD&& getField)
+{
+    std::vector<T> values;
+    values.reserve(frames.size());
+
+    for (auto& frame : frames)
+    {
+        values.push_back(getField(frame));
+    }
+
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+
+    return values[rank];
+}
+
+CanvasFrameTiming FrameTimingRecorder::GetPercentile(float percentile)
+{
+    if (!(percentile >= 0 && percentile <= 100))
+        ThrowHR(E_INVALIDARG);
+
+    auto frames = GetFrameTimings();
+
+    CanvasFrameTiming result{};
+
+    if (frames.empty())
+        return result;
+
+    // Nearest-rank: the smallest value that at least percentile% of the
+    // frames are less than or equal to.
+    auto rank = static_cast<size_t>(ceil(percentile / 100.0 * frames.size()));
+    rank = std::max<size_t>(rank, 1) - 1;
+
+    result.UpdateTime.Duration  = GetFieldPercentile<INT64>(frames, rank, [](CanvasFrameTiming const& f) { return f.UpdateTime.Duration; });
+    result.DrawTime.Duration    = GetFieldPercentile<INT64>(frames, rank, [](CanvasFrameTiming const& f) { return f.DrawTime.Duration; });
+    result.PresentTime.Duration = GetFieldPercentile<INT64>(frames, rank, [](CanvasFrameTiming const& f) { return f.PresentTime.Duration; });
+    result.TotalTime.Duration   = GetFieldPercentile<INT64>(frames, rank, [](CanvasFrameTiming const& f) { return f.TotalTime.Duration; });
+    result.UpdateCount          = GetFieldPercentile<INT32>(frames, rank, [](CanvasFrameTiming const& f) { return f.UpdateCount; });
+    result.IsRunningSlowly      = GetFieldPercentile<int>(frames, rank, [](CanvasFrameTiming const& f) { return f.IsRunningSlowly ? 1 : 0; }) != 0;
+
+    return result;
+}
+
+void FrameTimingRecorder::Clear()
+{
+    Lock lock(m_mutex);
+
+    m_nextFrame = 0;
+    m_frameCount = 0;
+}
+
+int64_t FrameTimingRecorder::CounterToTicks(int64_t counterTicks)
+{
+    // Convert QPC units into the canonical tick format used by TimeSpan.
+    return counterTicks * static_cast<int64_t>(StepTimer::TicksPerSecond) / m_frequency;
+}
@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "StepTimer.h"
+#include "utils/LockUtilities.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { namespace UI { namespace Xaml
+{
+    enum class FramePhase
+    {
+        Update,
+        Draw,
+        Present
+    };
+
+    //
+    // Records where the time goes in each iteration of the game loop, keeping
+    // the most recent frames in a ring buffer.
+    //
+    // BeginFrame, BeginPhase, EndPhase, AddPhaseTime and EndFrame are called
+    // by the game loop thread.  AddPhaseTime is for phases that were timed
+    // elsewhere, such as a pipelined Update.  The recorded frames may be
+    // read from any thread.
+    //
+    class FrameTimingRecorder
+    {
+        std::shared_ptr<ICanvasTimingAdapter> m_adapter;
+        int64_t m_frequency;
+
+        // The frame in progress.  Only used by the game loop thread.
+        int64_t m_frameStartTime;
+        int64_t m_phaseStartTime;
+        CanvasFrameTiming m_currentFrame;
+
+        std::mutex m_mutex;
+        std::vector<CanvasFrameTiming> m_frames;
+        size_t m_nextFrame;
+        size_t m_frameCount;
+
+    public:
+        static const size_t DefaultCapacity = 256;
+
+        FrameTimingRecorder(
+            std::shared_ptr<ICanvasTimingAdapter> adapter,
+            size_t capacity = DefaultCapacity);
+
+        void BeginFrame();
+        void BeginPhase();
+        void EndPhase(FramePhase phase);
+        void AddPhaseTime(FramePhase phase, int64_t counterTicks);
+        void EndFrame(int32_t updateCount, bool isRunningSlowly);
+
+        // Returns the recorded frames, oldest first.
+        std::vector<CanvasFrameTiming> GetFrameTimings();
+
+        // Returns the given percentile (0 to 100) of each field, using the
+        // nearest-rank method.  All fields are zero if no frames have been
+        // recorded.
+        CanvasFrameTiming GetPercentile(float percentile);
+
+        void Clear();
+
+    private:
+        int64_t CounterToTicks(int64_t counterTicks);
+    };
+}}}}}}
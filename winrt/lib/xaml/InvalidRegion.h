@@ -0,0 +1,194 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { namespace UI { namespace Xaml
+{
+    using ABI::Windows::Foundation::Rect;
+
+    //
+    // Tracks the parts of a control that need to be redrawn.
+    //
+    // The region is either the whole control, or a small set of rectangles.
+    // Rectangles that overlap or touch are merged as they are added.  Once
+    // there are more than MaxRectangles of them, the pair whose union adds
+    // the least extra area is merged, so the number of separate redraws
+    // stays bounded however many times Invalidate is called.
+    //
+    class InvalidRegion
+    {
+        bool m_isFull;
+        std::vector<Rect> m_rectangles;
+
+    public:
+        static const size_t MaxRectangles = 4;
+
+        InvalidRegion()
+            : m_isFull(true)
+        {
+        }
+
+        bool IsFull() const
+        {
+            return m_isFull;
+        }
+
+        bool IsEmpty() const
+        {
+            return !m_isFull && m_rectangles.empty();
+        }
+
+        std::vector<Rect> const& GetRectangles() const
+        {
+            return m_rectangles;
+        }
+
+        void InvalidateAll()
+        {
+            m_isFull = true;
+            m_rectangles.clear();
+        }
+
+        void Invalidate(Rect rect)
+        {
+            if (m_isFull || IsEmptyRect(rect))
+                return;
+
+            //
+            // Absorb every existing rectangle that the new one overlaps.
+            // Growing the new rectangle may make it overlap ones that were
+            // already checked, so keep going until nothing changes.
+            //
+            bool merged;
+            do
+            {
+                merged = false;
+
+                for (auto it = m_rectangles.begin(); it != m_rectangles.end();)
+                {
+                    if (Touches(*it, rect))
+                    {
+                        rect = Union(*it, rect);
+                        it = m_rectangles.erase(it);
+                        merged = true;
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            } while (merged);
+
+            m_rectangles.push_back(rect);
+
+            if (m_rectangles.size() > MaxRectangles)
+                MergeCheapestPair();
+        }
+
+        void Clear()
+        {
+            m_isFull = false;
+            m_rectangles.clear();
+        }
+
+        //
+        // Grows rect outwards to whole pixels at the given DPI, and clips it
+        // to a control of the given size.  Returns false if nothing is left.
+        //
+        // Image sources are updated in whole pixels, and convert each edge
+        // of the update rectangle by rounding it to the nearest pixel, so a
+        // rectangle that doesn't start and end on pixel boundaries could
+        // otherwise lose partly covered pixels, or vanish altogether.
+        //
+        static bool ClipAndSnapToPixels(Rect* rect, ABI::Windows::Foundation::Size const& size, float dpi)
+        {
+            float scale = dpi / DEFAULT_DPI;
+
+            float left   = (std::max)(floorf(rect->X * scale), 0.0f);
+            float top    = (std::max)(floorf(rect->Y * scale), 0.0f);
+            float right  = (std::min)(ceilf((rect->X + rect->Width) * scale), static_cast<float>(DipsToPixels(size.Width, dpi)));
+            float bottom = (std::min)(ceilf((rect->Y + rect->Height) * scale), static_cast<float>(DipsToPixels(size.Height, dpi)));
+
+            if (right <= left || bottom <= top)
+                return false;
+
+            *rect = Rect{ left / scale, top / scale, (right - left) / scale, (bottom - top) / scale };
+            return true;
+        }
+
+    private:
+        void MergeCheapestPair()
+        {
+            size_t bestA = 0;
+            size_t bestB = 1;
+            float bestCost = 0;
+            bool haveBest = false;
+
+            for (size_t a = 0; a < m_rectangles.size(); ++a)
+            {
+                for (size_t b = a + 1; b < m_rectangles.size(); ++b)
+                {
+                    auto& ra = m_rectangles[a];
+                    auto& rb = m_rectangles[b];
+
+                    float cost = Area(Union(ra, rb)) - Area(ra) - Area(rb);
+
+                    if (!haveBest || cost < bestCost)
+                    {
+                        haveBest = true;
+                        bestCost = cost;
+                        bestA = a;
+                        bestB = b;
+                    }
+                }
+            }
+
+            auto merged = Union(m_rectangles[bestA], m_rectangles[bestB]);
+
+            m_rectangles.erase(m_rectangles.begin() + bestB);
+            m_rectangles.erase(m_rectangles.begin() + bestA);
+
+            // The merged rectangle may now overlap others, so add it back
+            // through the usual path.
+            Invalidate(merged);
+        }
+
+        static bool IsEmptyRect(Rect const& rect)
+        {
+            return !(rect.Width > 0) || !(rect.Height > 0);
+        }
+
+        static bool Touches(Rect const& a, Rect const& b)
+        {
+            return a.X <= b.X + b.Width &&
+                   b.X <= a.X + a.Width &&
+                   a.Y <= b.Y + b.Height &&
+                   b.Y <= a.Y + a.Height;
+        }
+
+        static Rect Union(Rect const& a, Rect const& b)
+        {
+            float left   = (std::min)(a.X, b.X);
+            float top    = (std::min)(a.Y, b.Y);
+            float right  = (std::max)(a.X + a.Width, b.X + b.Width);
+            float bottom = (std::max)(a.Y + a.Height, b.Y + b.Height);
+
+            return Rect{ left, top, right - left, bottom - top };
+        }
+
+        static float Area(Rect const& rect)
+        {
+            return rect.Width * rect.Height;
+        }
+    };
+}}}}}}
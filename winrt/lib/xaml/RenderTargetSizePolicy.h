@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { namespace UI { namespace Xaml
+{
+    using ABI::Windows::Foundation::Size;
+
+    //
+    // Decides how large a control's render target should be allocated.
+    //
+    // Reallocating the render target every time the control changes size
+    // is expensive, particularly while the user is dragging a window edge.
+    // Instead, render targets are allocated in multiples of StepSize and
+    // the control only draws to the part it needs.  A render target is
+    // reallocated immediately if it is too small, but is only shrunk once
+    // it is at least MinimumShrink larger than needed, and has stayed that
+    // way for ShrinkDelay rendered frames in a row.
+    //
+    // All sizes are in dips.
+    //
+    class RenderTargetSizePolicy
+    {
+        int m_shrinkCount;
+
+    public:
+        static const int StepSize = 128;
+        static const int MinimumShrink = 2 * StepSize;
+        static const int ShrinkDelay = 30;
+
+        RenderTargetSizePolicy()
+            : m_shrinkCount(0)
+        {
+        }
+
+        //
+        // Returns the size to allocate for a render target that must be at
+        // least requiredSize, and should be called once per rendered frame.
+        // If the result is the same as allocatedSize then the existing
+        // render target should be kept.
+        //
+        Size GetAllocationSize(Size const& allocatedSize, Size const& requiredSize)
+        {
+            if (!ShouldShrink(allocatedSize, requiredSize))
+            {
+                m_shrinkCount = 0;
+                return GrowToFit(allocatedSize, requiredSize);
+            }
+
+            if (++m_shrinkCount < ShrinkDelay)
+                return allocatedSize;
+
+            m_shrinkCount = 0;
+            return RoundUp(requiredSize);
+        }
+
+        //
+        // Returns a new allocation size if allocatedSize is too small for
+        // requiredSize, or allocatedSize otherwise.  This never shrinks
+        // either dimension, so can be called at any time without affecting
+        // the shrink delay.
+        //
+        static Size GrowToFit(Size const& allocatedSize, Size const& requiredSize)
+        {
+            bool tooSmall = requiredSize.Width > allocatedSize.Width ||
+                            requiredSize.Height > allocatedSize.Height;
+
+            if (!tooSmall)
+                return allocatedSize;
+
+            auto roundedSize = RoundUp(requiredSize);
+
+            return Size{ (std::max)(allocatedSize.Width, roundedSize.Width),
+                         (std::max)(allocatedSize.Height, roundedSize.Height) };
+        }
+
+        //
+        // Returns true if allocatedSize is big enough for requiredSize, but
+        // so much bigger that it should eventually be shrunk.
+        //
+        static bool ShouldShrink(Size const& allocatedSize, Size const& requiredSize)
+        {
+            if (requiredSize.Width > allocatedSize.Width || requiredSize.Height > allocatedSize.Height)
+                return false;
+
+            auto roundedSize = RoundUp(requiredSize);
+
+            return allocatedSize.Width - roundedSize.Width >= MinimumShrink ||
+                   allocatedSize.Height - roundedSize.Height >= MinimumShrink;
+        }
+
+    private:
+        static Size RoundUp(Size const& size)
+        {
+            return Size{ RoundUp(size.Width), RoundUp(size.Height) };
+        }
+
+        static float RoundUp(float value)
+        {
+            if (value <= 0)
+                return 0;
+
+            return ceilf(value / StepSize) * StepSize;
+        }
+    };
+}}}}}}
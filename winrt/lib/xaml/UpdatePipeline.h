@@ -0,0 +1,158 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "utils/LockUtilities.h"
+
+namespace ABI { namespace Microsoft { namespace Graphics { namespace Canvas { namespace UI { namespace Xaml
+{
+    //
+    // Tracks a single piece of work running on a worker thread, and holds on
+    // to its result until it is collected.
+    //
+    // CanvasAnimatedControl uses this to run the Update for the next frame
+    // while the game loop thread draws the current one.  Only one piece of
+    // work can be outstanding at a time, and its result must be taken before
+    // the next one is started, so the worker can never get more than one
+    // frame ahead of the game loop thread.
+    //
+    // The work holds a reference to the pipeline's owner while it runs.
+    // When it completes that reference is handed over to the pipeline, and
+    // only released by whichever thread next waits for it, so the owner is
+    // never released (and so possibly destroyed) on the worker thread.
+    //
+    template<typename RESULT>
+    class UpdatePipeline
+    {
+        std::mutex m_mutex;
+        std::condition_variable m_conditionVariable;
+
+        bool m_isBusy;
+        bool m_hasResult;
+        HRESULT m_hr;
+        RESULT m_result;
+        ComPtr<IUnknown> m_owner;
+
+    public:
+        UpdatePipeline()
+            : m_isBusy(false)
+            , m_hasResult(false)
+            , m_hr(S_OK)
+            , m_result()
+        {
+        }
+
+        //
+        // Returns a function that runs fn and stores its result.  The caller
+        // is responsible for running this on a worker thread, or calling
+        // Cancel if that isn't possible.
+        //
+        // owner must be whatever owns this UpdatePipeline.  Callers of
+        // WaitUntilIdle and TakeResult must hold their own reference to it.
+        //
+        std::function<void()> Begin(ComPtr<IUnknown> owner, std::function<RESULT()> fn)
+        {
+            Lock lock(m_mutex);
+
+            assert(!m_isBusy && !m_hasResult);
+            m_isBusy = true;
+
+            return
+                [this, owner, fn] () mutable
+                {
+                    RESULT result{};
+
+                    HRESULT hr = ExceptionBoundary(
+                        [&]
+                        {
+                            result = fn();
+                        });
+
+                    Complete(hr, result, std::move(owner));
+                };
+        }
+
+        void Cancel()
+        {
+            Lock lock(m_mutex);
+
+            assert(m_isBusy);
+            m_isBusy = false;
+
+            lock.unlock();
+            m_conditionVariable.notify_all();
+        }
+
+        void WaitUntilIdle()
+        {
+            ComPtr<IUnknown> owner;
+            Lock lock(m_mutex);
+            owner = WaitUntilIdle(lock);
+        }
+
+        //
+        // Waits for any outstanding work to complete.  Returns false if there
+        // is no result waiting to be taken.  Rethrows any error from the work.
+        //
+        bool TakeResult(RESULT* result)
+        {
+            ComPtr<IUnknown> owner;
+            Lock lock(m_mutex);
+            owner = WaitUntilIdle(lock);
+
+            if (!m_hasResult)
+                return false;
+
+            m_hasResult = false;
+
+            HRESULT hr = m_hr;
+            m_hr = S_OK;
+            ThrowIfFailed(hr);
+
+            *result = m_result;
+            return true;
+        }
+
+    private:
+        //
+        // Returns the reference to the owner handed over by the last piece
+        // of work, which the caller should release after unlocking.
+        //
+        ComPtr<IUnknown> WaitUntilIdle(Lock& lock)
+        {
+            m_conditionVariable.wait(lock, [&] { return !m_isBusy; });
+
+            return std::move(m_owner);
+        }
+
+        void Complete(HRESULT hr, RESULT const& result, ComPtr<IUnknown>&& owner)
+        {
+            Lock lock(m_mutex);
+
+            assert(m_isBusy);
+
+            m_isBusy = false;
+            m_hasResult = true;
+            m_hr = hr;
+            m_result = result;
+            m_owner = std::move(owner);
+
+            //
+            // This notifies while still holding the lock, since once a
+            // waiter sees that the work is complete nothing stops it
+            // releasing the owner, and with it this pipeline.
+            //
+            m_conditionVariable.notify_all();
+        }
+    };
+}}}}}}
@@ -12,12 +12,15 @@
 
 #include "pch.h"
 
+#include <collection.h>
+
 using Platform::String;
 using namespace Microsoft::Graphics::Canvas;
 using namespace Microsoft::WRL::Wrappers;
 using namespace WinRTDirectX;
 using namespace Windows::Devices::Enumeration;
 using namespace Windows::Foundation;
+using namespace Windows::Foundation::Collections;
 using namespace Windows::Graphics::Imaging;
 using namespace Windows::Storage::Streams;
 using namespace Windows::UI;
@@ -223,6 +226,78 @@ public:
         }
     }
 
+    TEST_METHOD(CanvasBitmap_LoadManyAsync)
+    {
+        const unsigned bitmapCount = 8;
+        const float highDpi = 150;
+
+        CanvasDevice^ canvasDevice = ref new CanvasDevice();
+
+        auto fileNames = ref new Platform::Collections::Vector<String^>();
+
+        for (unsigned i = 0; i < bitmapCount; i++)
+        {
+            fileNames->Append(i % 2 ? L"Assets/imageTiger.jpg" : L"Assets/HighDpiGrid.png");
+        }
+
+        auto asyncOperation = CanvasBitmap::LoadManyAsync(canvasDevice, fileNames, highDpi);
+
+        std::vector<unsigned> progressReports;
+
+        asyncOperation->Progress = ref new AsyncOperationProgressHandler<IVectorView<CanvasBitmap^>^, unsigned>(
+            [&](IAsyncOperationWithProgress<IVectorView<CanvasBitmap^>^, unsigned>^, unsigned loadedCount)
+            {
+                progressReports.push_back(loadedCount);
+            });
+
+        auto bitmaps = WaitExecution(asyncOperation);
+
+        // The bitmaps come back in the same order as the file names, whichever
+        // order they finished loading in.
+        Assert::AreEqual(bitmapCount, bitmaps->Size);
+
+        for (unsigned i = 0; i < bitmapCount; i++)
+        {
+            auto bitmap = bitmaps->GetAt(i);
+
+            Assert::AreEqual(i % 2 ? 196u : 4u, bitmap->SizeInPixels.Width);
+            Assert::AreEqual(i % 2 ? 147u : 4u, bitmap->SizeInPixels.Height);
+            Assert::AreEqual(highDpi, bitmap->Dpi);
+            Assert::AreEqual(canvasDevice, bitmap->Device);
+        }
+
+        Assert::IsFalse(progressReports.empty());
+        Assert::IsTrue(std::is_sorted(progressReports.begin(), progressReports.end()));
+        Assert::AreEqual(bitmapCount, progressReports.back());
+    }
+
+    TEST_METHOD(CanvasBitmap_LoadManyAsync_WhenAFileIsMissing_Fails)
+    {
+        CanvasDevice^ canvasDevice = ref new CanvasDevice();
+
+        auto fileNames = ref new Platform::Collections::Vector<String^>();
+        fileNames->Append(L"Assets/imageTiger.jpg");
+        fileNames->Append(L"ThisImageFileDoesNotExist.jpg");
+        fileNames->Append(L"Assets/imageTiger.jpg");
+
+        auto async = CanvasBitmap::LoadManyAsync(canvasDevice, fileNames);
+
+        ExpectCOMException(HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND),
+            [&]
+            {
+                WaitExecution(async);
+            });
+    }
+
+    TEST_METHOD(CanvasBitmap_LoadManyAsync_NoFiles_ReturnsEmptyList)
+    {
+        CanvasDevice^ canvasDevice = ref new CanvasDevice();
+
+        auto bitmaps = WaitExecution(CanvasBitmap::LoadManyAsync(canvasDevice, ref new Platform::Collections::Vector<String^>()));
+
+        Assert::AreEqual(0u, bitmaps->Size);
+    }
+
     TEST_METHOD(CanvasBitmap_NativeInterop)
     {
         auto canvasDevice = ref new CanvasDevice();
@@ -1036,6 +1111,215 @@ public:
         VerifyBitmapSetData<Color>(canvasBitmap, width, imageData, 1);
     }
 
+    static Platform::Array<byte>^ ReadBufferBytes(IBuffer^ buffer)
+    {
+        auto bytes = ref new Platform::Array<byte>(buffer->Length);
+        DataReader::FromBuffer(buffer)->ReadBytes(bytes);
+        return bytes;
+    }
+
+    static void AssertBytesEqual(Platform::Array<byte>^ expected, Platform::Array<byte>^ actual)
+    {
+        Assert::AreEqual(expected->Length, actual->Length);
+
+        for (unsigned int i = 0; i < expected->Length; ++i)
+        {
+            Assert::AreEqual(expected[i], actual[i]);
+        }
+    }
+
+    TEST_METHOD(CanvasBitmap_GetPixelBytesAsync_MatchesGetPixelBytes)
+    {
+        const int width = 8;
+        const int height = 9;
+        Platform::Array<byte>^ imageData = ref new Platform::Array<byte>(width * height * 4);
+        for (unsigned int i = 0; i < imageData->Length; i++)
+        {
+            imageData[i] = ReferenceColorFromIndex<byte>(i);
+        }
+
+        auto canvasBitmap = CanvasBitmap::CreateFromBytes(
+            m_sharedDevice,
+            imageData,
+            width,
+            height,
+            DirectXPixelFormat::B8G8R8A8UIntNormalized,
+            DEFAULT_DPI,
+            CanvasAlphaMode::Premultiplied);
+
+        AssertBytesEqual(
+            canvasBitmap->GetPixelBytes(),
+            ReadBufferBytes(WaitExecution(canvasBitmap->GetPixelBytesAsync())));
+
+        AssertBytesEqual(
+            canvasBitmap->GetPixelBytes(1, 2, 3, 4),
+            ReadBufferBytes(WaitExecution(canvasBitmap->GetPixelBytesAsync(1, 2, 3, 4))));
+    }
+
+    TEST_METHOD(CanvasBitmap_GetPixelBytesAsync_InvalidArguments)
+    {
+        auto canvasBitmap = ref new CanvasRenderTarget(m_sharedDevice, 1, 1, DEFAULT_DPI);
+
+        SignedRect testCases[] = {
+            SignedRect(0, 0, 0, 0),
+            SignedRect(0, 0, 2, 2),
+            SignedRect(-2, 3, 5, 4),
+            SignedRect(0, 0, 1, -3),
+        };
+
+        for (SignedRect testCase : testCases)
+        {
+            // Invalid arguments are reported straight away, not through the async operation.
+            Assert::ExpectException<Platform::InvalidArgumentException^>(
+                [&]
+                {
+                    canvasBitmap->GetPixelBytesAsync(testCase.Left, testCase.Top, testCase.Width, testCase.Height);
+                });
+        }
+    }
+
+    TEST_METHOD(CanvasBitmap_GetPixelBytesAsync_ReadsPixelsAsTheyWereWhenCalled)
+    {
+        auto device = ref new CanvasDevice();
+        device->MaximumPixelReadbacksInFlight = 2;
+
+        auto renderTarget = ref new CanvasRenderTarget(device, 4, 4, DEFAULT_DPI);
+
+        const int readbackCount = 10;
+        std::vector<IAsyncOperation<IBuffer^>^> operations;
+
+        for (int i = 0; i < readbackCount; ++i)
+        {
+            auto drawingSession = renderTarget->CreateDrawingSession();
+            drawingSession->Clear(ColorHelper::FromArgb(255, static_cast<byte>(i * 20), 0, 0));
+            delete drawingSession;
+
+            operations.push_back(renderTarget->GetPixelBytesAsync());
+        }
+
+        for (int i = 0; i < readbackCount; ++i)
+        {
+            auto bytes = ReadBufferBytes(WaitExecution(operations[i]));
+
+            Assert::AreEqual(4u * 4u * 4u, bytes->Length);
+
+            // B8G8R8A8
+            Assert::AreEqual<byte>(0, bytes[0]);
+            Assert::AreEqual<byte>(0, bytes[1]);
+            Assert::AreEqual(static_cast<byte>(i * 20), bytes[2]);
+            Assert::AreEqual<byte>(255, bytes[3]);
+        }
+
+        auto statistics = device->GetPixelReadbackStatistics();
+
+        Assert::AreEqual<int64_t>(readbackCount, statistics.CompletedCount);
+        Assert::AreEqual<int64_t>(0, statistics.CanceledCount);
+        Assert::AreEqual<int64_t>(0, statistics.FailedCount);
+        Assert::AreEqual(0, statistics.InFlightCount);
+        Assert::IsTrue(statistics.PeakInFlightCount >= 1 && statistics.PeakInFlightCount <= 2);
+        Assert::IsTrue(statistics.MaximumLatency.Duration >= statistics.AverageLatency.Duration);
+    }
+
+    TEST_METHOD(CanvasBitmap_GetPixelBytesAsync_Cancel)
+    {
+        auto device = ref new CanvasDevice();
+        auto renderTarget = ref new CanvasRenderTarget(device, 256, 256, DEFAULT_DPI);
+
+        auto operation = renderTarget->GetPixelBytesAsync();
+        operation->Cancel();
+
+        // The readback may already have finished by the time we cancel it.
+        try
+        {
+            WaitExecution(operation);
+            Assert::IsTrue(operation->Status == AsyncStatus::Completed);
+        }
+        catch (task_canceled const&)
+        {
+            Assert::IsTrue(operation->Status == AsyncStatus::Canceled);
+        }
+
+        auto statistics = device->GetPixelReadbackStatistics();
+
+        Assert::AreEqual<int64_t>(1, statistics.CompletedCount + statistics.CanceledCount);
+        Assert::AreEqual(0, statistics.InFlightCount);
+    }
+
+    TEST_METHOD(CanvasBitmap_GetPixelBytesAsync_WhenRingIsFull_WaitsWithoutHoldingTheD2DLock)
+    {
+        auto device = ref new CanvasDevice();
+        device->MaximumPixelReadbacksInFlight = 1;
+
+        auto renderTarget = ref new CanvasRenderTarget(device, 2048, 2048, DEFAULT_DPI);
+
+        // Give the GPU plenty to get through before it can copy the pixels
+        // for the first readback, which fills the ring.
+        auto drawingSession = renderTarget->CreateDrawingSession();
+
+        for (int i = 0; i < 200; ++i)
+        {
+            drawingSession->FillEllipse(1024, 1024, 2000, 2000, ColorHelper::FromArgb(255, 0, static_cast<byte>(i), 0));
+        }
+
+        delete drawingSession;
+
+        auto firstReadback = renderTarget->GetPixelBytesAsync();
+
+        // The second readback has to wait for the first.
+        Event secondIssuedEvent(CreateEventEx(NULL, NULL, CREATE_EVENT_MANUAL_RESET, EVENT_ALL_ACCESS));
+        HANDLE secondIssuedHandle = secondIssuedEvent.Get();
+
+        Windows::System::Threading::ThreadPool::RunAsync(ref new Windows::System::Threading::WorkItemHandler(
+            [renderTarget, secondIssuedHandle](IAsyncAction^)
+            {
+                renderTarget->GetPixelBytesAsync();
+                SetEvent(secondIssuedHandle);
+            }));
+
+        // Give it time to start waiting.
+        WaitForSingleObjectEx(secondIssuedHandle, 100, false);
+
+        auto completedCountBeforeLocking = device->GetPixelReadbackStatistics().CompletedCount;
+
+        // Taking the D2D lock would block until the GPU caught up if the
+        // waiting thread held it.  Instead, we should get it while the first
+        // readback is still in flight.
+        ComPtr<ID2D1Factory> d2dFactory;
+        GetWrappedResource<ID2D1Device1>(device)->GetFactory(&d2dFactory);
+        auto d2dMultithread = As<ID2D1Multithread>(d2dFactory);
+
+        d2dMultithread->Enter();
+        auto completedCountWhileLocked = device->GetPixelReadbackStatistics().CompletedCount;
+        d2dMultithread->Leave();
+
+        WaitExecution(firstReadback);
+        Assert::AreEqual(WAIT_OBJECT_0, WaitForSingleObjectEx(secondIssuedHandle, 1000 * 5, false));
+
+        if (completedCountBeforeLocking > 0)
+        {
+            Logger::WriteMessage(L"The GPU finished the first readback before the lock was tested.\n");
+            return;
+        }
+
+        Assert::AreEqual<int64_t>(0, completedCountWhileLocked);
+    }
+
+    TEST_METHOD(CanvasDevice_MaximumPixelReadbacksInFlight)
+    {
+        auto device = ref new CanvasDevice();
+
+        Assert::AreEqual(3, device->MaximumPixelReadbacksInFlight);
+
+        device->MaximumPixelReadbacksInFlight = 1;
+        Assert::AreEqual(1, device->MaximumPixelReadbacksInFlight);
+
+        Assert::ExpectException<Platform::InvalidArgumentException^>(
+            [&]
+            {
+                device->MaximumPixelReadbacksInFlight = 0;
+            });
+    }
+
     TEST_METHOD(CanvasBitmap_GetAndSetPixelBytesAndColors_InvalidArguments)
     {
         auto canvasBitmap = ref new CanvasRenderTarget(m_sharedDevice, 1, 1, DEFAULT_DPI);
@@ -1549,4 +1833,160 @@ public:
             });
 
     }
+
+    ref class StreamThatBlocksWrites sealed : public IRandomAccessStream
+    {
+        InMemoryRandomAccessStream^ m_wrappedStream;
+        HANDLE m_writeStartedEvent;
+        HANDLE m_allowWriteEvent;
+
+    internal:
+        StreamThatBlocksWrites(HANDLE writeStartedEvent, HANDLE allowWriteEvent)
+            : m_writeStartedEvent(writeStartedEvent)
+            , m_allowWriteEvent(allowWriteEvent)
+        {
+            m_wrappedStream = ref new InMemoryRandomAccessStream();
+        }
+
+    public:
+        virtual ~StreamThatBlocksWrites() // Implements Dispose which is required
+        {
+        }
+
+        virtual IAsyncOperationWithProgress<IBuffer ^, unsigned int>^ ReadAsync(IBuffer^ buffer, unsigned int offset, InputStreamOptions options)
+        {
+            return m_wrappedStream->ReadAsync(buffer, offset, options);
+        }
+
+        virtual IAsyncOperationWithProgress<unsigned int, unsigned int>^ WriteAsync(IBuffer^ buffer)
+        {
+            // Holds up the encoder, on whatever thread it is running on,
+            // until the test lets it continue.
+            SetEvent(m_writeStartedEvent);
+            WaitForSingleObjectEx(m_allowWriteEvent, 1000 * 5, false);
+
+            return m_wrappedStream->WriteAsync(buffer);
+        }
+
+        virtual IAsyncOperation<bool>^ FlushAsync()
+        {
+            return m_wrappedStream->FlushAsync();
+        }
+
+        virtual property bool CanRead { bool get() { return true; } }
+
+        virtual property bool CanWrite { bool get() { return true; } }
+
+        virtual property unsigned __int64 Position { unsigned __int64 get() { return m_wrappedStream->Position; } }
+
+        virtual property unsigned __int64 Size
+        {
+            unsigned __int64 get() { return m_wrappedStream->Size; }
+            void set(unsigned __int64 value) { m_wrappedStream->Size = value; }
+        }
+
+        virtual IInputStream^ GetInputStreamAt(unsigned __int64 position)
+        {
+            return m_wrappedStream->GetInputStreamAt(position);
+        }
+
+        virtual IOutputStream^ GetOutputStreamAt(unsigned __int64 position)
+        {
+            return m_wrappedStream->GetOutputStreamAt(position);
+        }
+
+        virtual void Seek(unsigned __int64 position)
+        {
+            m_wrappedStream->Seek(position);
+        }
+
+        virtual IRandomAccessStream^ CloneStream()
+        {
+            Assert::Fail(); // Not impl
+            return nullptr;
+        }
+    };
+
+    TEST_METHOD(CanvasBitmap_SaveToStreamAsync_D2DLockIsReleasedBeforeEncoding)
+    {
+        auto canvasDevice = ref new CanvasDevice();
+        auto bitmap = ref new CanvasRenderTarget(canvasDevice, 64, 64, DEFAULT_DPI);
+
+        Event writeStartedEvent(CreateEventEx(NULL, NULL, CREATE_EVENT_MANUAL_RESET, EVENT_ALL_ACCESS));
+        Event allowWriteEvent(CreateEventEx(NULL, NULL, CREATE_EVENT_MANUAL_RESET, EVENT_ALL_ACCESS));
+        Event lockTakenEvent(CreateEventEx(NULL, NULL, CREATE_EVENT_MANUAL_RESET, EVENT_ALL_ACCESS));
+
+        auto stream = ref new StreamThatBlocksWrites(writeStartedEvent.Get(), allowWriteEvent.Get());
+
+        auto asyncSave = bitmap->SaveAsync(stream, CanvasBitmapFileFormat::Png);
+
+        // Wait until the encoder is part way through writing the image.
+        Assert::AreEqual(WAIT_OBJECT_0, WaitForSingleObjectEx(writeStartedEvent.Get(), 1000 * 5, false));
+
+        // Another thread should now be able to take the D2D lock.  This would
+        // block for as long as the encoder is stuck if SaveAsync still held it.
+        ComPtr<ID2D1Factory> d2dFactory;
+        GetWrappedResource<ID2D1Device1>(canvasDevice)->GetFactory(&d2dFactory);
+        auto d2dMultithread = As<ID2D1Multithread>(d2dFactory);
+
+        HANDLE lockTakenHandle = lockTakenEvent.Get();
+
+        Windows::System::Threading::ThreadPool::RunAsync(ref new Windows::System::Threading::WorkItemHandler(
+            [d2dMultithread, lockTakenHandle](IAsyncAction^)
+            {
+                d2dMultithread->Enter();
+                d2dMultithread->Leave();
+                SetEvent(lockTakenHandle);
+            }));
+
+        auto waitResult = WaitForSingleObjectEx(lockTakenEvent.Get(), 1000 * 5, false);
+
+        // Let the encoder finish either way, so that the worker thread is
+        // never left waiting on the lock once the test is over.
+        SetEvent(allowWriteEvent.Get());
+        WaitExecution(asyncSave);
+        WaitForSingleObjectEx(lockTakenEvent.Get(), 1000 * 5, false);
+
+        Assert::AreEqual(WAIT_OBJECT_0, waitResult);
+        Assert::IsTrue(stream->Size > 0);
+    }
+
+    TEST_METHOD(CanvasBitmap_SaveToStreamAsync_SeveralBitmapsAtOnce)
+    {
+        const int bitmapCount = 8;
+
+        auto canvasDevice = ref new CanvasDevice();
+
+        std::vector<InMemoryRandomAccessStream^> streams;
+        std::vector<IAsyncAction^> saves;
+
+        // Kick off all the saves before waiting for any of them.
+        for (int i = 0; i < bitmapCount; ++i)
+        {
+            auto bitmap = ref new CanvasRenderTarget(canvasDevice, 256, 256, DEFAULT_DPI);
+
+            auto drawingSession = bitmap->CreateDrawingSession();
+            drawingSession->Clear(ColorHelper::FromArgb(255, static_cast<byte>(i * 30), 0, 0));
+            delete drawingSession;
+
+            auto stream = ref new InMemoryRandomAccessStream();
+
+            streams.push_back(stream);
+            saves.push_back(bitmap->SaveAsync(stream, CanvasBitmapFileFormat::Png));
+        }
+
+        for (int i = 0; i < bitmapCount; ++i)
+        {
+            WaitExecution(saves[i]);
+
+            streams[i]->Seek(0);
+            auto loadedBitmap = WaitExecution(CanvasBitmap::LoadAsync(canvasDevice, streams[i]));
+
+            Assert::AreEqual(256u, loadedBitmap->SizeInPixels.Width);
+            Assert::AreEqual(256u, loadedBitmap->SizeInPixels.Height);
+
+            auto colors = loadedBitmap->GetPixelColors();
+            Assert::AreEqual(ColorHelper::FromArgb(255, static_cast<byte>(i * 30), 0, 0), colors[colors->Length - 1]);
+        }
+    }
 };
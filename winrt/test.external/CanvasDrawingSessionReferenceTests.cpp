@@ -0,0 +1,453 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "../test.internal/graphics/ReferenceRasterizer.h"
+
+using namespace canvas;
+using namespace Windows::UI;
+
+//
+// Golden-image tests: each scene is drawn through a CanvasDrawingSession on
+// a WARP device, and through ReferenceRasterizer, and the pixels compared.
+//
+// The two antialias slightly differently, so every pixel must match within
+// sc_tolerance, except for a few along the edges of shapes, which must
+// match within sc_edgeTolerance.
+//
+static const int sc_tolerance = 3;
+static const int sc_edgeTolerance = 64;
+static const double sc_maxEdgePixelFraction = 0.05;
+
+static D2D1_COLOR_F ToD2DColor(Color color)
+{
+    return D2D1::ColorF(color.R / 255.0f, color.G / 255.0f, color.B / 255.0f, color.A / 255.0f);
+}
+
+static D2D1_RECT_F ToD2DRect(Rect rect)
+{
+    return D2D1::RectF(rect.X, rect.Y, rect.X + rect.Width, rect.Y + rect.Height);
+}
+
+static D2D1_POINT_2F ToD2DPoint(float2 point)
+{
+    return D2D1::Point2F(point.x, point.y);
+}
+
+static D2D1_MATRIX_3X2_F ToD2DMatrix(float3x2 const& m)
+{
+    return D2D1::Matrix3x2F(m.m11, m.m12, m.m21, m.m22, m.m31, m.m32);
+}
+
+TEST_CLASS(CanvasDrawingSessionReferenceTests)
+{
+    CanvasDevice^ m_device;
+
+public:
+    CanvasDrawingSessionReferenceTests()
+        : m_device(ref new CanvasDevice(CanvasDebugLevel::None, CanvasHardwareAcceleration::Off))
+    {
+    }
+
+    //
+    // Draws each shape both through a CanvasDrawingSession and into a
+    // ReferenceRasterizer, so that a test only describes its scene once.
+    //
+    class Scene
+    {
+        CanvasDevice^ m_device;
+        CanvasRenderTarget^ m_renderTarget;
+        CanvasDrawingSession^ m_drawingSession;
+        ReferenceRasterizer m_reference;
+
+    public:
+        Scene(CanvasDevice^ device, uint32_t width, uint32_t height, Color clearColor)
+            : m_device(device)
+            , m_renderTarget(ref new CanvasRenderTarget(device, static_cast<float>(width), static_cast<float>(height), DEFAULT_DPI))
+            , m_reference(width, height)
+        {
+            m_drawingSession = m_renderTarget->CreateDrawingSession();
+
+            m_drawingSession->Clear(clearColor);
+            m_reference.Clear(ToD2DColor(clearColor));
+        }
+
+        ~Scene()
+        {
+            delete m_drawingSession;
+        }
+
+        void SetTransform(float3x2 const& transform)
+        {
+            m_drawingSession->Transform = transform;
+            m_reference.SetTransform(ToD2DMatrix(transform));
+        }
+
+        void FillRectangle(Rect rect, Color color)
+        {
+            m_drawingSession->FillRectangle(rect, color);
+            m_reference.FillRectangle(ToD2DRect(rect), ReferenceBrush::Solid(ToD2DColor(color)));
+        }
+
+        void FillRectangle(Rect rect, ICanvasBrush^ brush, ReferenceBrush const& referenceBrush)
+        {
+            m_drawingSession->FillRectangle(rect, brush);
+            m_reference.FillRectangle(ToD2DRect(rect), referenceBrush);
+        }
+
+        void FillEllipse(float2 center, float radiusX, float radiusY, Color color)
+        {
+            m_drawingSession->FillEllipse(center, radiusX, radiusY, color);
+            m_reference.FillEllipse(D2D1::Ellipse(ToD2DPoint(center), radiusX, radiusY), ReferenceBrush::Solid(ToD2DColor(color)));
+        }
+
+        void FillEllipse(float2 center, float radiusX, float radiusY, ICanvasBrush^ brush, ReferenceBrush const& referenceBrush)
+        {
+            m_drawingSession->FillEllipse(center, radiusX, radiusY, brush);
+            m_reference.FillEllipse(D2D1::Ellipse(ToD2DPoint(center), radiusX, radiusY), referenceBrush);
+        }
+
+        // Each figure is a closed polygon.
+        void FillPath(std::vector<std::vector<float2>> const& figures, CanvasFilledRegionDetermination filledRegionDetermination, Color color)
+        {
+            auto pathBuilder = ref new CanvasPathBuilder(m_device);
+            pathBuilder->SetFilledRegionDetermination(filledRegionDetermination);
+
+            std::vector<std::vector<D2D1_POINT_2F>> referenceFigures;
+
+            for (auto& figure : figures)
+            {
+                pathBuilder->BeginFigure(figure[0]);
+
+                for (size_t i = 1; i < figure.size(); i++)
+                {
+                    pathBuilder->AddLine(figure[i]);
+                }
+
+                pathBuilder->EndFigure(CanvasFigureLoop::Closed);
+
+                referenceFigures.emplace_back();
+
+                for (auto& point : figure)
+                {
+                    referenceFigures.back().push_back(ToD2DPoint(point));
+                }
+            }
+
+            m_drawingSession->FillGeometry(CanvasGeometry::CreatePath(pathBuilder), color);
+
+            m_reference.FillPolygons(
+                referenceFigures,
+                static_cast<D2D1_FILL_MODE>(filledRegionDetermination),
+                ReferenceBrush::Solid(ToD2DColor(color)));
+        }
+
+        void DrawImage(std::shared_ptr<ReferenceBitmap const> const& bitmap, Rect destinationRect, float opacity, CanvasImageInterpolation interpolation)
+        {
+            auto bytes = ref new Platform::Array<byte>(
+                reinterpret_cast<byte*>(const_cast<uint32_t*>(bitmap->Pixels.data())),
+                static_cast<unsigned>(bitmap->Pixels.size() * sizeof(uint32_t)));
+
+            auto canvasBitmap = CanvasBitmap::CreateFromBytes(
+                m_device,
+                bytes,
+                bitmap->Width,
+                bitmap->Height,
+                DirectXPixelFormat::B8G8R8A8UIntNormalized,
+                DEFAULT_DPI,
+                CanvasAlphaMode::Premultiplied);
+
+            Rect sourceRect(0, 0, static_cast<float>(bitmap->Width), static_cast<float>(bitmap->Height));
+
+            m_drawingSession->DrawImage(canvasBitmap, destinationRect, sourceRect, opacity, interpolation);
+
+            m_reference.DrawBitmap(
+                bitmap,
+                ToD2DRect(destinationRect),
+                opacity,
+                (interpolation == CanvasImageInterpolation::NearestNeighbor) ? D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR
+                                                                             : D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
+        }
+
+        void VerifyMatchesReference(double maxEdgePixelFraction = sc_maxEdgePixelFraction)
+        {
+            delete m_drawingSession;
+            m_drawingSession = nullptr;
+
+            auto actual = m_renderTarget->GetPixelBytes();
+            auto& expected = m_reference.GetPixels();
+
+            Assert::AreEqual(static_cast<unsigned>(expected.size() * 4), actual->Length);
+
+            size_t edgePixelCount = 0;
+
+            for (size_t i = 0; i < expected.size(); i++)
+            {
+                int difference = 0;
+
+                // Both are B8G8R8A8, so the bytes of each pixel are in the
+                // same order as the reference's packed channels.
+                for (int channel = 0; channel < 4; channel++)
+                {
+                    int expectedValue = (expected[i] >> (channel * 8)) & 0xFF;
+                    int actualValue = actual[static_cast<unsigned>(i * 4 + channel)];
+
+                    difference = std::max(difference, abs(expectedValue - actualValue));
+                }
+
+                if (difference <= sc_tolerance)
+                    continue;
+
+                if (difference > sc_edgeTolerance)
+                {
+                    auto x = static_cast<unsigned>(i % m_reference.GetWidth());
+                    auto y = static_cast<unsigned>(i / m_reference.GetWidth());
+
+                    wchar_t message[256];
+                    swprintf_s(message, L"Pixel (%u, %u) is %08X, but the reference is %08X",
+                        x, y, *reinterpret_cast<uint32_t*>(&actual[static_cast<unsigned>(i * 4)]), expected[i]);
+                    Assert::Fail(message);
+                }
+
+                edgePixelCount++;
+            }
+
+            wchar_t message[256];
+            swprintf_s(message, L"%Iu of %Iu pixels differ by more than %d", edgePixelCount, expected.size(), sc_tolerance);
+            Assert::IsTrue(edgePixelCount <= expected.size() * maxEdgePixelFraction, message);
+        }
+    };
+
+    static Platform::Array<CanvasGradientStop>^ MakeStops(std::initializer_list<std::pair<float, Color>> stops)
+    {
+        auto array = ref new Platform::Array<CanvasGradientStop>(static_cast<unsigned>(stops.size()));
+
+        unsigned i = 0;
+
+        for (auto& stop : stops)
+        {
+            array[i].Position = stop.first;
+            array[i].Color = stop.second;
+            i++;
+        }
+
+        return array;
+    }
+
+    static std::vector<D2D1_GRADIENT_STOP> ToReferenceStops(Platform::Array<CanvasGradientStop>^ stops)
+    {
+        std::vector<D2D1_GRADIENT_STOP> referenceStops;
+
+        for (unsigned i = 0; i < stops->Length; i++)
+        {
+            referenceStops.push_back(D2D1_GRADIENT_STOP{ stops[i].Position, ToD2DColor(stops[i].Color) });
+        }
+
+        return referenceStops;
+    }
+
+    static std::shared_ptr<ReferenceBitmap> MakeTestBitmap()
+    {
+        auto bitmap = std::make_shared<ReferenceBitmap>();
+
+        bitmap->Width = 8;
+        bitmap->Height = 8;
+
+        for (uint32_t y = 0; y < bitmap->Height; y++)
+        {
+            for (uint32_t x = 0; x < bitmap->Width; x++)
+            {
+                bitmap->Pixels.push_back(0xFF000000 | (x * 32) << 16 | (y * 32) << 8 | ((x + y) % 2) * 0xFF);
+            }
+        }
+
+        return bitmap;
+    }
+
+    TEST_METHOD(CanvasDrawingSessionReference_FillRectangle)
+    {
+        Scene scene(m_device, 128, 128, Colors::White);
+
+        scene.FillRectangle(Rect(8, 8, 48, 32), Colors::Blue);
+        scene.FillRectangle(Rect(20.5f, 30.25f, 60, 40.5f), ColorHelper::FromArgb(128, 255, 0, 0));
+        scene.FillRectangle(Rect(-10, 100, 200, 50), ColorHelper::FromArgb(64, 0, 128, 0));
+
+        scene.VerifyMatchesReference();
+    }
+
+    TEST_METHOD(CanvasDrawingSessionReference_FillEllipse)
+    {
+        Scene scene(m_device, 128, 128, Colors::Transparent);
+
+        scene.FillEllipse(float2(64, 64), 50, 30, Colors::Orange);
+        scene.FillEllipse(float2(40.5f, 80.25f), 20, 35, ColorHelper::FromArgb(160, 0, 0, 255));
+        scene.FillEllipse(float2(120, 10), 3, 3, Colors::Black);
+
+        scene.VerifyMatchesReference();
+    }
+
+    TEST_METHOD(CanvasDrawingSessionReference_FillPath)
+    {
+        // A self-intersecting star, whose middle is only filled with the
+        // winding rule, and a square with a square hole.
+        std::vector<std::vector<float2>> star =
+        {
+            { float2(64, 4), float2(100, 116), float2(6, 44), float2(122, 44), float2(28, 116) }
+        };
+
+        std::vector<std::vector<float2>> squareWithHole =
+        {
+            { float2(10, 10), float2(50, 10), float2(50, 50), float2(10, 50) },
+            { float2(20, 20), float2(20, 40), float2(40, 40), float2(40, 20) }
+        };
+
+        for (auto filledRegionDetermination : { CanvasFilledRegionDetermination::Alternate, CanvasFilledRegionDetermination::Winding })
+        {
+            Scene scene(m_device, 128, 128, Colors::White);
+
+            scene.FillPath(star, filledRegionDetermination, Colors::DarkGreen);
+            scene.FillPath(squareWithHole, filledRegionDetermination, ColorHelper::FromArgb(192, 128, 0, 128));
+
+            scene.VerifyMatchesReference();
+        }
+    }
+
+    TEST_METHOD(CanvasDrawingSessionReference_LinearGradientBrush)
+    {
+        Scene scene(m_device, 128, 128, Colors::White);
+
+        auto stops = MakeStops({ { 0.0f, Colors::Red }, { 0.5f, ColorHelper::FromArgb(128, 0, 255, 0) }, { 1.0f, Colors::Blue } });
+
+        auto brush = ref new CanvasLinearGradientBrush(m_device, stops);
+        brush->StartPoint = float2(16, 16);
+        brush->EndPoint = float2(112, 80);
+
+        auto referenceBrush = ReferenceBrush::LinearGradient(D2D1::Point2F(16, 16), D2D1::Point2F(112, 80), ToReferenceStops(stops));
+
+        scene.FillRectangle(Rect(0, 0, 128, 64), brush, referenceBrush);
+        scene.FillEllipse(float2(64, 96), 60, 28, brush, referenceBrush);
+
+        scene.VerifyMatchesReference();
+    }
+
+    TEST_METHOD(CanvasDrawingSessionReference_RadialGradientBrush)
+    {
+        Scene scene(m_device, 128, 128, Colors::Black);
+
+        auto stops = MakeStops({ { 0.0f, Colors::Yellow }, { 0.7f, Colors::Purple }, { 1.0f, ColorHelper::FromArgb(0, 0, 0, 255) } });
+
+        auto brush = ref new CanvasRadialGradientBrush(m_device, stops);
+        brush->Center = float2(60, 70);
+        brush->RadiusX = 50;
+        brush->RadiusY = 30;
+
+        auto referenceBrush = ReferenceBrush::RadialGradient(D2D1::Point2F(60, 70), 50, 30, ToReferenceStops(stops));
+
+        scene.FillRectangle(Rect(0, 0, 128, 128), brush, referenceBrush);
+
+        scene.VerifyMatchesReference();
+    }
+
+    TEST_METHOD(CanvasDrawingSessionReference_DrawImage_NearestNeighbor)
+    {
+        Scene scene(m_device, 128, 128, Colors::White);
+
+        scene.DrawImage(MakeTestBitmap(), Rect(0, 0, 64, 64), 1.0f, CanvasImageInterpolation::NearestNeighbor);
+        scene.DrawImage(MakeTestBitmap(), Rect(64, 64, 32, 32), 0.5f, CanvasImageInterpolation::NearestNeighbor);
+
+        scene.VerifyMatchesReference();
+    }
+
+    TEST_METHOD(CanvasDrawingSessionReference_DrawImage_Linear)
+    {
+        Scene scene(m_device, 128, 128, Colors::White);
+
+        scene.DrawImage(MakeTestBitmap(), Rect(10, 10, 80, 80), 0.75f, CanvasImageInterpolation::Linear);
+
+        // Direct2D and the reference handle the outermost half pixel of the
+        // bitmap differently, so allow for more edge pixels here.
+        scene.VerifyMatchesReference(0.1);
+    }
+
+    TEST_METHOD(CanvasDrawingSessionReference_Transform)
+    {
+        Scene scene(m_device, 128, 128, Colors::White);
+
+        scene.SetTransform(make_float3x2_rotation(0.5f, float2(64, 64)) * make_float3x2_scale(1.5f));
+
+        scene.FillRectangle(Rect(30, 30, 40, 20), Colors::Red);
+        scene.FillEllipse(float2(40, 60), 15, 10, Colors::Blue);
+
+        scene.VerifyMatchesReference();
+    }
+
+    PERF_TEST_METHOD_ATTRIBUTES(CanvasDrawingSessionReference_Throughput)
+    TEST_METHOD(CanvasDrawingSessionReference_Throughput)
+    {
+        // Draws the same scene through WARP and through the reference
+        // rasterizer.
+        const uint32_t size = 1024;
+        const int shapeCount = 200;
+
+        auto stops = MakeStops({ { 0.0f, Colors::Black }, { 1.0f, Colors::White } });
+        auto referenceStops = ToReferenceStops(stops);
+
+        auto renderTarget = ref new CanvasRenderTarget(m_device, static_cast<float>(size), static_cast<float>(size), DEFAULT_DPI);
+
+        double warpSeconds = MeasureSeconds(
+            [&]
+            {
+                auto drawingSession = renderTarget->CreateDrawingSession();
+                drawingSession->Clear(Colors::White);
+
+                for (int i = 0; i < shapeCount; i++)
+                {
+                    float x = static_cast<float>((i * 37) % 1000);
+                    float y = static_cast<float>((i * 91) % 1000);
+
+                    drawingSession->FillEllipse(float2(x, y), 40.0f + i % 30, 25.0f + i % 20, ColorHelper::FromArgb(153, static_cast<byte>(i % 7 * 36), static_cast<byte>(i % 5 * 51), static_cast<byte>(i % 3 * 85)));
+
+                    auto brush = ref new CanvasLinearGradientBrush(m_device, stops);
+                    brush->StartPoint = float2(y, x);
+                    brush->EndPoint = float2(y + 60, x);
+                    drawingSession->FillRectangle(Rect(y, x, 60, 30), brush);
+                }
+
+                delete drawingSession;
+                renderTarget->GetPixelBytes();
+            });
+
+        double referenceSeconds = MeasureSeconds(
+            [&]
+            {
+                ReferenceRasterizer rasterizer(size, size);
+                rasterizer.Clear(D2D1::ColorF(1, 1, 1, 1));
+
+                for (int i = 0; i < shapeCount; i++)
+                {
+                    float x = static_cast<float>((i * 37) % 1000);
+                    float y = static_cast<float>((i * 91) % 1000);
+
+                    D2D1_ELLIPSE ellipse = { D2D1::Point2F(x, y), 40.0f + i % 30, 25.0f + i % 20 };
+                    rasterizer.FillEllipse(ellipse, ReferenceBrush::Solid(ToD2DColor(ColorHelper::FromArgb(153, static_cast<byte>(i % 7 * 36), static_cast<byte>(i % 5 * 51), static_cast<byte>(i % 3 * 85)))));
+
+                    rasterizer.FillRectangle(D2D1::RectF(y, x, y + 60, x + 30),
+                        ReferenceBrush::LinearGradient(D2D1::Point2F(y, x), D2D1::Point2F(y + 60, x), referenceStops));
+                }
+
+                rasterizer.GetPixels();
+            });
+
+        LogPerfMessage(L"%d shapes at %ux%u: WARP %.1f ms, reference rasterizer %.1f ms\n", shapeCount * 2, size, size, warpSeconds * 1000.0, referenceSeconds * 1000.0);
+    }
+};
@@ -287,4 +287,46 @@ TEST_CLASS(CanvasBitmapTests)
         Assert::AreEqual(E_INVALIDARG, blurInterop->GetNamedPropertyMapping(L"BlurAmount", nullptr, &mapping));
         Assert::AreEqual(E_INVALIDARG, blurInterop->GetNamedPropertyMapping(L"BlurAmount", &index, nullptr));
     }
+
+    PERF_TEST_METHOD_ATTRIBUTES(CanvasEffect_AnimatingOnePropertyOfLargeGraph_Timing)
+    TEST_METHOD(CanvasEffect_AnimatingOnePropertyOfLargeGraph_Timing)
+    {
+        // Measures the per-frame cost of drawing a large effect graph where
+        // only one property changes each frame.
+        const int effectCount = 200;
+        const int frameCount = 500;
+
+        auto device = ref new CanvasDevice();
+        auto renderTarget = ref new CanvasRenderTarget(device, 16, 16, DEFAULT_DPI);
+
+        std::vector<Transform3DEffect^> effects;
+        ICanvasImage^ source = ref new CanvasRenderTarget(device, 16, 16, DEFAULT_DPI);
+
+        for (int i = 0; i < effectCount; i++)
+        {
+            auto effect = ref new Transform3DEffect();
+            effect->Source = source;
+            effects.push_back(effect);
+            source = effect;
+        }
+
+        auto animatedEffect = effects[effectCount / 2];
+        float4x4 matrix = animatedEffect->TransformMatrix;
+
+        double seconds = MeasureSeconds(
+            [&]
+            {
+                for (int frame = 0; frame < frameCount; frame++)
+                {
+                    matrix.m41 = static_cast<float>(frame % 16);
+                    animatedEffect->TransformMatrix = matrix;
+
+                    auto drawingSession = renderTarget->CreateDrawingSession();
+                    drawingSession->DrawImage(source);
+                    delete drawingSession;
+                }
+            });
+
+        LogPerfMessage(L"%d effects, one property animated: %.1f us per frame\n", effectCount, seconds * 1000000.0 / frameCount);
+    }
 };
@@ -77,4 +77,179 @@ TEST_CLASS(CanvasRenderTargetTests)
         Assert::AreEqual(renderTarget1->Size, Size{ 23, 42 });
         Assert::AreEqual(renderTarget2->Size, Size{ 7, 21 });
     }
+
+    TEST_METHOD(CanvasRenderTarget_DrawingSession_DoesNotInheritStateFromPreviousSession)
+    {
+        auto canvasDevice = ref new CanvasDevice();
+        auto renderTarget1 = ref new CanvasRenderTarget(canvasDevice, 1, 1, DEFAULT_DPI);
+        auto renderTarget2 = ref new CanvasRenderTarget(canvasDevice, 1, 1, 2 * DEFAULT_DPI);
+
+        auto drawingSession = renderTarget1->CreateDrawingSession();
+
+        auto defaultAntialiasing = drawingSession->Antialiasing;
+        auto defaultBlend = drawingSession->Blend;
+        auto defaultTextAntialiasing = drawingSession->TextAntialiasing;
+        auto defaultTransform = drawingSession->Transform;
+        auto defaultUnits = drawingSession->Units;
+
+        drawingSession->Antialiasing = CanvasAntialiasing::Aliased;
+        drawingSession->Blend = CanvasBlend::Copy;
+        drawingSession->TextAntialiasing = CanvasTextAntialiasing::ClearType;
+        drawingSession->Transform = float3x2{ 1, 2, 3, 4, 5, 6 };
+        drawingSession->Units = CanvasUnits::Pixels;
+
+        delete drawingSession;
+
+        // Drawing sessions share device contexts from the device's pool, so
+        // this may well get the same device context as the first one.
+        drawingSession = renderTarget2->CreateDrawingSession();
+
+        Assert::AreEqual(defaultAntialiasing, drawingSession->Antialiasing);
+        Assert::AreEqual(defaultBlend, drawingSession->Blend);
+        Assert::AreEqual(defaultTextAntialiasing, drawingSession->TextAntialiasing);
+        Assert::AreEqual(defaultTransform, drawingSession->Transform);
+        Assert::AreEqual(defaultUnits, drawingSession->Units);
+
+        auto deviceContext = GetWrappedResource<ID2D1DeviceContext1>(drawingSession);
+
+        float dpiX, dpiY;
+        deviceContext->GetDpi(&dpiX, &dpiY);
+        Assert::AreEqual(2 * DEFAULT_DPI, dpiX);
+        Assert::AreEqual(2 * DEFAULT_DPI, dpiY);
+
+        ComPtr<ID2D1Image> target;
+        deviceContext->GetTarget(&target);
+        ComPtr<ID2D1Image> expectedTarget = GetWrappedResource<ID2D1Bitmap1>(renderTarget2);
+        Assert::IsTrue(expectedTarget.Get() == target.Get());
+
+        delete drawingSession;
+    }
+
+    TEST_METHOD(CanvasRenderTarget_DrawingSession_DoesNotInheritInteropStateFromPreviousSession)
+    {
+        auto canvasDevice = ref new CanvasDevice();
+        auto renderTarget = ref new CanvasRenderTarget(canvasDevice, 1, 1, DEFAULT_DPI);
+
+        // A device context that no drawing session has used tells us what
+        // the defaults are.
+        ComPtr<ID2D1DeviceContext> freshDeviceContext;
+        ThrowIfFailed(GetWrappedResource<ID2D1Device1>(canvasDevice)->CreateDeviceContext(D2D1_DEVICE_CONTEXT_OPTIONS_NONE, &freshDeviceContext));
+
+        D2D1_RENDERING_CONTROLS defaultRenderingControls;
+        freshDeviceContext->GetRenderingControls(&defaultRenderingControls);
+
+        ComPtr<IDWriteFactory> dwriteFactory;
+        ThrowIfFailed(DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED, __uuidof(IDWriteFactory), static_cast<IUnknown**>(&dwriteFactory)));
+
+        ComPtr<IDWriteRenderingParams> renderingParams;
+        ThrowIfFailed(dwriteFactory->CreateRenderingParams(&renderingParams));
+
+        // Set state that drawing sessions don't expose, through the native
+        // device context.
+        auto drawingSession = renderTarget->CreateDrawingSession();
+        auto deviceContext = GetWrappedResource<ID2D1DeviceContext1>(drawingSession);
+
+        D2D1_RENDERING_CONTROLS renderingControls = defaultRenderingControls;
+        renderingControls.bufferPrecision = D2D1_BUFFER_PRECISION_32BPC_FLOAT;
+        renderingControls.tileSize = D2D1_SIZE_U{ defaultRenderingControls.tileSize.width / 2, defaultRenderingControls.tileSize.height / 2 };
+
+        deviceContext->SetTextRenderingParams(renderingParams.Get());
+        deviceContext->SetTags(1, 2);
+        deviceContext->SetRenderingControls(&renderingControls);
+
+        delete drawingSession;
+
+        drawingSession = renderTarget->CreateDrawingSession();
+        auto nextDeviceContext = GetWrappedResource<ID2D1DeviceContext1>(drawingSession);
+
+        // Without reusing the device context this test would prove nothing
+        Assert::IsTrue(IsSameInstance(deviceContext.Get(), nextDeviceContext.Get()));
+
+        ComPtr<IDWriteRenderingParams> actualRenderingParams;
+        nextDeviceContext->GetTextRenderingParams(&actualRenderingParams);
+        Assert::IsNull(actualRenderingParams.Get());
+
+        D2D1_TAG tag1, tag2;
+        nextDeviceContext->GetTags(&tag1, &tag2);
+        Assert::AreEqual<D2D1_TAG>(0, tag1);
+        Assert::AreEqual<D2D1_TAG>(0, tag2);
+
+        D2D1_RENDERING_CONTROLS actualRenderingControls;
+        nextDeviceContext->GetRenderingControls(&actualRenderingControls);
+        Assert::IsTrue(defaultRenderingControls.bufferPrecision == actualRenderingControls.bufferPrecision);
+        Assert::AreEqual(defaultRenderingControls.tileSize.width, actualRenderingControls.tileSize.width);
+        Assert::AreEqual(defaultRenderingControls.tileSize.height, actualRenderingControls.tileSize.height);
+
+        delete drawingSession;
+    }
+
+    TEST_METHOD(CanvasRenderTarget_DrawingSessionsOnTheSameDevice_ReuseDeviceContexts)
+    {
+        auto canvasDevice = ref new CanvasDevice();
+
+        std::vector<CanvasRenderTarget^> renderTargets;
+
+        for (int i = 0; i < 10; i++)
+        {
+            renderTargets.push_back(ref new CanvasRenderTarget(canvasDevice, 64, 64, DEFAULT_DPI));
+        }
+
+        ComPtr<ID2D1DeviceContext1> firstDeviceContext;
+
+        for (int frame = 0; frame < 3; frame++)
+        {
+            for (auto renderTarget : renderTargets)
+            {
+                auto drawingSession = renderTarget->CreateDrawingSession();
+                auto deviceContext = GetWrappedResource<ID2D1DeviceContext1>(drawingSession);
+
+                // With only one drawing session open at a time, every one of
+                // them gets the same device context from the pool.
+                if (!firstDeviceContext)
+                    firstDeviceContext = deviceContext;
+                else
+                    Assert::IsTrue(IsSameInstance(firstDeviceContext.Get(), deviceContext.Get()));
+
+                drawingSession->Clear(Colors::CornflowerBlue);
+                delete drawingSession;
+            }
+        }
+    }
+
+    PERF_TEST_METHOD_ATTRIBUTES(CanvasRenderTarget_DrawingSessionChurn_Timing)
+    TEST_METHOD(CanvasRenderTarget_DrawingSessionChurn_Timing)
+    {
+        // Opens many short drawing sessions across a set of render targets,
+        // as a compositor that redraws each of its layers every frame would.
+        const int renderTargetCount = 50;
+        const int frameCount = 20;
+
+        auto canvasDevice = ref new CanvasDevice();
+
+        std::vector<CanvasRenderTarget^> renderTargets;
+
+        for (int i = 0; i < renderTargetCount; i++)
+        {
+            renderTargets.push_back(ref new CanvasRenderTarget(canvasDevice, 64, 64, DEFAULT_DPI));
+        }
+
+        double seconds = MeasureSeconds(
+            [&]
+            {
+                for (int frame = 0; frame < frameCount; frame++)
+                {
+                    for (auto renderTarget : renderTargets)
+                    {
+                        auto drawingSession = renderTarget->CreateDrawingSession();
+                        drawingSession->Clear(Colors::CornflowerBlue);
+                        delete drawingSession;
+                    }
+                }
+            });
+
+        int sessionCount = renderTargetCount * frameCount;
+        double milliseconds = seconds * 1000.0;
+
+        LogPerfMessage(L"%d drawing sessions: %.1f ms, %.1f us per session\n", sessionCount, milliseconds, milliseconds * 1000.0 / sessionCount);
+    }
 };
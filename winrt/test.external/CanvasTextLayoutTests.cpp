@@ -112,4 +112,262 @@ public:
             }
         }
     }
+
+    TEST_METHOD(CanvasTextLayout_MeasureTexts_MatchesCanvasTextLayout)
+    {
+        auto format = ref new CanvasTextFormat();
+
+        auto texts = ref new Platform::Array<Platform::String^>(3);
+        texts[0] = L"";
+        texts[1] = L"A short string";
+        texts[2] = L"A longer string that wraps onto more than one line";
+
+        auto measurements = CanvasTextLayout::MeasureTexts(texts, format, 100, 0);
+
+        Assert::AreEqual(texts->Length, measurements->Length);
+
+        for (unsigned i = 0; i < texts->Length; i++)
+        {
+            auto textLayout = ref new CanvasTextLayout(m_device, texts[i], format, 100, 0);
+
+            Assert::AreEqual(textLayout->LayoutBounds.X, measurements[i].LayoutBounds.X);
+            Assert::AreEqual(textLayout->LayoutBounds.Y, measurements[i].LayoutBounds.Y);
+            Assert::AreEqual(textLayout->LayoutBounds.Width, measurements[i].LayoutBounds.Width);
+            Assert::AreEqual(textLayout->LayoutBounds.Height, measurements[i].LayoutBounds.Height);
+            Assert::AreEqual(textLayout->LineCount, measurements[i].LineCount);
+            Assert::AreEqual(textLayout->GetMinimumLineLength(), measurements[i].MinimumLineLength);
+        }
+    }
+
+    PERF_TEST_METHOD_ATTRIBUTES(CanvasTextLayout_MeasureTexts_Timing)
+    TEST_METHOD(CanvasTextLayout_MeasureTexts_Timing)
+    {
+        // Compares measuring the cells of a table through MeasureTexts with
+        // creating a CanvasTextLayout for each one.
+        const unsigned textCount = 5000;
+
+        auto format = ref new CanvasTextFormat();
+
+        auto texts = ref new Platform::Array<Platform::String^>(textCount);
+
+        for (unsigned i = 0; i < textCount; i++)
+        {
+            texts[i] = L"Cell " + i.ToString() + L", column " + (i % 7).ToString();
+        }
+
+        std::vector<Rect> layoutBounds(textCount);
+        std::vector<int> lineCounts(textCount);
+        std::vector<float> minimumLineLengths(textCount);
+
+        double perLayoutSeconds = MeasureSeconds(
+            [&]
+            {
+                for (unsigned i = 0; i < textCount; i++)
+                {
+                    auto textLayout = ref new CanvasTextLayout(m_device, texts[i], format, 200, 0);
+                    layoutBounds[i] = textLayout->LayoutBounds;
+                    lineCounts[i] = textLayout->LineCount;
+                    minimumLineLengths[i] = textLayout->GetMinimumLineLength();
+                    delete textLayout;
+                }
+            });
+
+        Platform::Array<CanvasTextMeasurement>^ measurements;
+
+        double batchSeconds = MeasureSeconds(
+            [&]
+            {
+                measurements = CanvasTextLayout::MeasureTexts(texts, format, 200, 0);
+            });
+
+        Assert::AreEqual(textCount, measurements->Length);
+
+        for (unsigned i = 0; i < textCount; i++)
+        {
+            Assert::AreEqual(layoutBounds[i], measurements[i].LayoutBounds);
+            Assert::AreEqual(lineCounts[i], measurements[i].LineCount);
+            Assert::AreEqual(minimumLineLengths[i], measurements[i].MinimumLineLength);
+        }
+
+        LogPerfMessage(L"Measuring %u strings: %.1f ms with a CanvasTextLayout each, %.1f ms with MeasureTexts\n", textCount, perLayoutSeconds * 1000.0, batchSeconds * 1000.0);
+    }
+
+    TEST_METHOD(CanvasTextLayout_HitTestPoints_MatchesHitTest)
+    {
+        auto format = ref new CanvasTextFormat();
+
+        // Mixes plain characters with whitespace, a ligature, a surrogate
+        // pair, right-to-left text and a hard line break.
+        Platform::String^ text = L"Office fjord \xD83D\xDE00 \x05E9\x05DC\x05D5\x05DD tab\there\r\nSecond line";
+
+        auto textLayout = ref new CanvasTextLayout(m_device, text, format, 120, 0);
+
+        auto bounds = textLayout->LayoutBounds;
+
+        for (int pass = 0; pass < 2; pass++)
+        {
+            std::vector<float2> pointVector;
+
+            for (float y = bounds.Y - 5; y < bounds.Y + bounds.Height + 5; y += 1.5f)
+            {
+                for (float x = bounds.X - 5; x < bounds.X + bounds.Width + 5; x += 0.75f)
+                {
+                    pointVector.push_back(float2{ x, y });
+                }
+            }
+
+            auto points = ref new Platform::Array<float2>(pointVector.data(), static_cast<unsigned>(pointVector.size()));
+
+            auto results = textLayout->HitTestPoints(points);
+
+            Assert::AreEqual(points->Length, results->Length);
+
+            for (unsigned i = 0; i < points->Length; i++)
+            {
+                CanvasTextLayoutRegion region;
+                bool isTrailingSide;
+                bool isHit = textLayout->HitTest(points[i].x, points[i].y, &region, &isTrailingSide);
+
+                Assert::AreEqual(isHit, results[i].IsHit);
+                Assert::AreEqual(isTrailingSide, results[i].IsTrailingSide);
+                Assert::AreEqual(region.CharacterIndex, results[i].Region.CharacterIndex);
+                Assert::AreEqual(region.CharacterCount, results[i].Region.CharacterCount);
+                Assert::AreEqual(region.LayoutBounds, results[i].Region.LayoutBounds);
+            }
+
+            auto characterIndices = ref new Platform::Array<int>(text->Length() + 2);
+            for (unsigned i = 0; i < characterIndices->Length; i++)
+            {
+                characterIndices[i] = static_cast<int>(i);
+            }
+
+            for (int trailingSide = 0; trailingSide < 2; trailingSide++)
+            {
+                auto locations = textLayout->GetCaretPositions(characterIndices, !!trailingSide);
+
+                Assert::AreEqual(characterIndices->Length, locations->Length);
+
+                for (unsigned i = 0; i < characterIndices->Length; i++)
+                {
+                    auto location = textLayout->GetCaretPosition(characterIndices[i], !!trailingSide);
+
+                    Assert::AreEqual(location.x, locations[i].x);
+                    Assert::AreEqual(location.y, locations[i].y);
+                }
+            }
+
+            // Changing the layout must discard the cached metrics.
+            textLayout->SetFontSize(0, 6, 30.0f);
+            bounds = textLayout->LayoutBounds;
+        }
+    }
+
+    TEST_METHOD(CanvasTextLayout_HitTestPoints_OnSimpleText_MatchesIDWriteTextLayout)
+    {
+        // Plain left-to-right text, wrapped onto several lines, is hit
+        // tested from HitTestPoints' cached metrics rather than by DirectWrite.
+        auto format = ref new CanvasTextFormat();
+
+        auto textLayout = ref new CanvasTextLayout(
+            m_device,
+            L"The quick brown fox jumps over the lazy dog.  Pack my box with five dozen liquor jugs.",
+            format,
+            150,
+            0);
+
+        auto dwriteTextLayout = GetWrappedResource<IDWriteTextLayout>(textLayout);
+
+        auto bounds = textLayout->LayoutBounds;
+
+        std::vector<float2> pointVector;
+
+        for (float y = bounds.Y - 5; y < bounds.Y + bounds.Height + 5; y += 1.3f)
+        {
+            for (float x = bounds.X - 5; x < bounds.X + bounds.Width + 5; x += 0.7f)
+            {
+                pointVector.push_back(float2{ x, y });
+            }
+        }
+
+        auto points = ref new Platform::Array<float2>(pointVector.data(), static_cast<unsigned>(pointVector.size()));
+
+        auto results = textLayout->HitTestPoints(points);
+
+        Assert::AreEqual(points->Length, results->Length);
+
+        for (unsigned i = 0; i < points->Length; i++)
+        {
+            BOOL isTrailingHit;
+            BOOL isInside;
+            DWRITE_HIT_TEST_METRICS metrics;
+            ThrowIfFailed(dwriteTextLayout->HitTestPoint(points[i].x, points[i].y, &isTrailingHit, &isInside, &metrics));
+
+            Assert::AreEqual(!!isInside, results[i].IsHit);
+            Assert::AreEqual(!!isTrailingHit, results[i].IsTrailingSide);
+            Assert::AreEqual(static_cast<int>(metrics.textPosition), results[i].Region.CharacterIndex);
+            Assert::AreEqual(static_cast<int>(metrics.length), results[i].Region.CharacterCount);
+            Assert::AreEqual(Rect{ metrics.left, metrics.top, metrics.width, metrics.height }, results[i].Region.LayoutBounds);
+        }
+    }
+
+    PERF_TEST_METHOD_ATTRIBUTES(CanvasTextLayout_HitTestPoints_Timing)
+    TEST_METHOD(CanvasTextLayout_HitTestPoints_Timing)
+    {
+        // Compares hit testing every point of a pointer trail with HitTest
+        // and with a single HitTestPoints call.
+        const unsigned pointCount = 20000;
+
+        auto format = ref new CanvasTextFormat();
+
+        auto textLayout = ref new CanvasTextLayout(
+            m_device,
+            L"The quick brown fox jumps over the lazy dog.  Pack my box with five dozen liquor jugs.",
+            format,
+            300,
+            0);
+
+        auto bounds = textLayout->LayoutBounds;
+
+        auto points = ref new Platform::Array<float2>(pointCount);
+
+        for (unsigned i = 0; i < pointCount; i++)
+        {
+            points[i] = float2{
+                bounds.X + bounds.Width * (i % 997) / 997.0f,
+                bounds.Y + bounds.Height * (i % 89) / 89.0f };
+        }
+
+        int hitCount1 = 0;
+
+        double singleSeconds = MeasureSeconds(
+            [&]
+            {
+                for (unsigned i = 0; i < pointCount; i++)
+                {
+                    CanvasTextLayoutRegion region;
+                    if (textLayout->HitTest(points[i].x, points[i].y, &region))
+                        hitCount1++;
+                }
+            });
+
+        Platform::Array<CanvasTextLayoutHitTestResult>^ results;
+
+        double batchSeconds = MeasureSeconds(
+            [&]
+            {
+                results = textLayout->HitTestPoints(points);
+            });
+
+        int hitCount2 = 0;
+
+        for (unsigned i = 0; i < pointCount; i++)
+        {
+            if (results[i].IsHit)
+                hitCount2++;
+        }
+
+        Assert::AreEqual(hitCount1, hitCount2);
+
+        LogPerfMessage(L"Hit testing %u points: %.1f ms with HitTest, %.1f ms with HitTestPoints\n", pointCount, singleSeconds * 1000.0, batchSeconds * 1000.0);
+    }
 };
@@ -425,6 +425,33 @@ inline T WaitExecution(IAsyncOperation<T>^ asyncOperation)
     return asyncTask.get();
 };
 
+template<typename T, typename TProgress>
+inline T WaitExecution(IAsyncOperationWithProgress<T, TProgress>^ asyncOperation)
+{
+    using namespace Microsoft::WRL::Wrappers;
+
+    Event emptyEvent(CreateEventEx(NULL, NULL, CREATE_EVENT_MANUAL_RESET, EVENT_ALL_ACCESS));
+    if (!emptyEvent.IsValid())
+        throw std::bad_alloc();
+
+    task_options options;
+    options.set_continuation_context(task_continuation_context::use_arbitrary());
+
+    task<T> asyncTask(asyncOperation);
+
+    asyncTask.then([&](task<T>)
+    {
+        SetEvent(emptyEvent.Get());
+    }, options);
+
+    // waiting before event executed
+    auto timeout = 1000 * 5;
+    auto waitResult = WaitForSingleObjectEx(emptyEvent.Get(), timeout, true);
+    Assert::AreEqual(WAIT_OBJECT_0, waitResult, L"WaitExecution: WaitForSingleObject timed out.");
+
+    return asyncTask.get();
+};
+
 inline void WaitExecution(IAsyncAction^ ayncAction)
 {
     using namespace Microsoft::WRL::Wrappers;
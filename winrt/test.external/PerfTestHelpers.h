@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdarg>
+
+//
+// Perf tests time something and log the results, since these depend on the
+// machine running them.  They are placed in the "Perf" category, which the
+// automated test run skips (see RunTests in Win2D.proj).  Run them on demand
+// from Test Explorer, or with:
+//
+//    vstest.console <test binary> /TestCaseFilter:"TestCategory=Perf"
+//
+// Usage:
+//
+//    PERF_TEST_METHOD_ATTRIBUTES(MyTest)
+//    TEST_METHOD(MyTest)
+//    {
+//        double seconds = MeasureSeconds([&] { ... });
+//        LogPerfMessage(L"%.0f things per second\n", thingCount / seconds);
+//    }
+//
+
+#define PERF_TEST_METHOD_ATTRIBUTES(METHOD_NAME)                    \
+    BEGIN_TEST_METHOD_ATTRIBUTE(METHOD_NAME)                        \
+        TEST_METHOD_ATTRIBUTE(L"TestCategory", L"Perf")             \
+    END_TEST_METHOD_ATTRIBUTE()
+
+template<typename FN>
+double MeasureSeconds(FN&& fn)
+{
+    LARGE_INTEGER frequency, start, end;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&start);
+
+    fn();
+
+    QueryPerformanceCounter(&end);
+
+    return static_cast<double>(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+}
+
+inline void LogPerfMessage(wchar_t const* format, ...)
+{
+    wchar_t message[256];
+
+    va_list args;
+    va_start(args, format);
+    vswprintf_s(message, format, args);
+    va_end(args);
+
+    Microsoft::VisualStudio::CppUnitTestFramework::Logger::WriteMessage(message);
+}
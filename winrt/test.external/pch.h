@@ -58,3 +58,4 @@ using namespace Microsoft::WRL;
 #include "Helpers.h"
 #include "MockDxgiDevice.h"
 #include "MockDxgiSurface.h"
+#include "PerfTestHelpers.h"
@@ -0,0 +1,456 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include <atomic>
+#include <thread>
+
+class StubWICBitmapLock : public RuntimeClass<RuntimeClassFlags<ClassicCom>, IWICBitmapLock>
+{
+    UINT m_width;
+    UINT m_height;
+    UINT m_stride;
+
+public:
+    StubWICBitmapLock(UINT width, UINT height, UINT stride)
+        : m_width(width)
+        , m_height(height)
+        , m_stride(stride)
+    {
+    }
+
+    IFACEMETHODIMP GetSize(UINT* width, UINT* height) override
+    {
+        *width = m_width;
+        *height = m_height;
+        return S_OK;
+    }
+
+    IFACEMETHODIMP GetStride(UINT* stride) override
+    {
+        *stride = m_stride;
+        return S_OK;
+    }
+
+    IFACEMETHODIMP GetDataPointer(UINT* bufferSize, WICInProcPointer* data) override
+    {
+        *bufferSize = m_stride * m_height;
+        *data = nullptr;
+        return S_OK;
+    }
+
+    IFACEMETHODIMP GetPixelFormat(WICPixelFormatGUID* pixelFormat) override
+    {
+        *pixelFormat = GUID_WICPixelFormat32bppPBGRA;
+        return S_OK;
+    }
+};
+
+// Each row of pixels is padded out to a multiple of rowAlignment bytes.
+static ComPtr<MockWICBitmap> MakeDecodedImage(UINT width, UINT height, UINT rowAlignment = 4)
+{
+    auto image = Make<MockWICBitmap>();
+
+    image->MockGetSize =
+        [=](UINT* actualWidth, UINT* actualHeight)
+        {
+            *actualWidth = width;
+            *actualHeight = height;
+        };
+
+    image->MockLock =
+        [=](WICRect const* rect, DWORD flags, IWICBitmapLock** bitmapLock)
+        {
+            Assert::IsNotNull(rect);
+            Assert::AreEqual(static_cast<INT>(width), rect->Width);
+            Assert::AreEqual(static_cast<INT>(height), rect->Height);
+            Assert::IsTrue(flags == WICBitmapLockRead);
+
+            auto stride = (width * 4 + rowAlignment - 1) / rowAlignment * rowAlignment;
+            return Make<StubWICBitmapLock>(width, height, stride).CopyTo(bitmapLock);
+        };
+
+    return image;
+}
+
+//
+// Encodes a PNG into memory, with a pattern that doesn't compress down to
+// almost nothing, so that decoding it is a realistic amount of work.
+//
+static std::vector<BYTE> EncodePng(IWICImagingFactory* wicFactory, UINT width, UINT height, UINT seed)
+{
+    const UINT stride = width * 4;
+
+    std::vector<BYTE> pixels(stride * height);
+    uint32_t random = seed * 2654435761u + 1;
+
+    for (auto& value : pixels)
+    {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        value = static_cast<BYTE>(random & 0x3F);
+    }
+
+    // An encoded PNG can be a little larger than the raw pixels
+    std::vector<BYTE> buffer(pixels.size() + 64 * 1024);
+
+    ComPtr<IWICStream> stream;
+    ThrowIfFailed(wicFactory->CreateStream(&stream));
+    ThrowIfFailed(stream->InitializeFromMemory(buffer.data(), static_cast<DWORD>(buffer.size())));
+
+    ComPtr<IWICBitmapEncoder> encoder;
+    ThrowIfFailed(wicFactory->CreateEncoder(GUID_ContainerFormatPng, nullptr, &encoder));
+    ThrowIfFailed(encoder->Initialize(stream.Get(), WICBitmapEncoderNoCache));
+
+    ComPtr<IWICBitmapFrameEncode> frame;
+    ThrowIfFailed(encoder->CreateNewFrame(&frame, nullptr));
+    ThrowIfFailed(frame->Initialize(nullptr));
+    ThrowIfFailed(frame->SetSize(width, height));
+
+    WICPixelFormatGUID pixelFormat = GUID_WICPixelFormat32bppBGRA;
+    ThrowIfFailed(frame->SetPixelFormat(&pixelFormat));
+    Assert::IsTrue(IsEqualGUID(pixelFormat, GUID_WICPixelFormat32bppBGRA));
+
+    ThrowIfFailed(frame->WritePixels(height, stride, static_cast<UINT>(pixels.size()), pixels.data()));
+    ThrowIfFailed(frame->Commit());
+    ThrowIfFailed(encoder->Commit());
+
+    ULARGE_INTEGER encodedSize;
+    ThrowIfFailed(stream->Seek(LARGE_INTEGER{}, STREAM_SEEK_CUR, &encodedSize));
+
+    buffer.resize(static_cast<size_t>(encodedSize.QuadPart));
+    return buffer;
+}
+
+//
+// Decodes a PNG from memory in the same way as the default bitmap adapter
+// does for LoadManyAsync: a format converter to premultiplied BGRA, read in
+// full into an IWICBitmap.
+//
+static ComPtr<IWICBitmap> DecodePng(IWICImagingFactory* wicFactory, std::vector<BYTE>& png)
+{
+    ComPtr<IWICStream> stream;
+    ThrowIfFailed(wicFactory->CreateStream(&stream));
+    ThrowIfFailed(stream->InitializeFromMemory(png.data(), static_cast<DWORD>(png.size())));
+
+    ComPtr<IWICBitmapDecoder> decoder;
+    ThrowIfFailed(wicFactory->CreateDecoderFromStream(stream.Get(), nullptr, WICDecodeMetadataCacheOnDemand, &decoder));
+
+    ComPtr<IWICBitmapFrameDecode> frame;
+    ThrowIfFailed(decoder->GetFrame(0, &frame));
+
+    ComPtr<IWICFormatConverter> converter;
+    ThrowIfFailed(wicFactory->CreateFormatConverter(&converter));
+    ThrowIfFailed(converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppPBGRA, WICBitmapDitherTypeNone, nullptr, 0, WICBitmapPaletteTypeMedianCut));
+
+    ComPtr<IWICBitmap> bitmap;
+    ThrowIfFailed(wicFactory->CreateBitmapFromSource(converter.Get(), WICBitmapCacheOnLoad, &bitmap));
+    return bitmap;
+}
+
+TEST_CLASS(BitmapBatchLoaderTests)
+{
+    TEST_METHOD_EX(BitmapBatchLoader_Run_UploadsEveryFileOnceOnTheCallingThread)
+    {
+        const uint32_t fileCount = 50;
+
+        auto image = MakeDecodedImage(8, 8);
+        std::atomic<int> decodeCount(0);
+
+        BitmapBatchLoader loader(
+            fileCount,
+            [&](uint32_t index) -> ComPtr<IWICBitmap>
+            {
+                Assert::IsTrue(index < fileCount);
+                decodeCount++;
+                return image;
+            },
+            4);
+
+        auto callingThread = GetCurrentThreadId();
+        std::vector<int> uploadCounts(fileCount);
+
+        loader.Run(
+            [&](uint32_t index, IWICBitmap* decodedImage)
+            {
+                Assert::IsTrue(callingThread == GetCurrentThreadId());
+                Assert::IsTrue(IsSameInstance(image.Get(), decodedImage));
+                uploadCounts[index]++;
+            },
+            nullptr);
+
+        Assert::AreEqual(static_cast<int>(fileCount), decodeCount.load());
+
+        for (auto uploadCount : uploadCounts)
+        {
+            Assert::AreEqual(1, uploadCount);
+        }
+    }
+
+    TEST_METHOD_EX(BitmapBatchLoader_Run_ReportsProgressAfterEachUpload)
+    {
+        const uint32_t fileCount = 20;
+
+        auto image = MakeDecodedImage(8, 8);
+
+        BitmapBatchLoader loader(fileCount, [&](uint32_t) -> ComPtr<IWICBitmap> { return image; });
+
+        uint32_t uploadCount = 0;
+        std::vector<uint32_t> progressReports;
+
+        loader.Run(
+            [&](uint32_t, IWICBitmap*)
+            {
+                uploadCount++;
+            },
+            [&](uint32_t loadedCount)
+            {
+                Assert::AreEqual(uploadCount, loadedCount);
+                progressReports.push_back(loadedCount);
+            });
+
+        Assert::AreEqual<size_t>(fileCount, progressReports.size());
+
+        for (uint32_t i = 0; i < fileCount; i++)
+        {
+            Assert::AreEqual(i + 1, progressReports[i]);
+        }
+    }
+
+    TEST_METHOD_EX(BitmapBatchLoader_WhenThereAreNoFiles_RunDoesNothing)
+    {
+        BitmapBatchLoader loader(0, [](uint32_t) -> ComPtr<IWICBitmap> { Assert::Fail(); return nullptr; });
+
+        loader.Run(
+            [](uint32_t, IWICBitmap*) { Assert::Fail(); },
+            [](uint32_t) { Assert::Fail(); });
+    }
+
+    TEST_METHOD_EX(BitmapBatchLoader_WhenDecodeFails_RunThrowsTheError)
+    {
+        auto image = MakeDecodedImage(8, 8);
+
+        BitmapBatchLoader loader(
+            10,
+            [&](uint32_t index) -> ComPtr<IWICBitmap>
+            {
+                if (index == 3)
+                    ThrowHR(WINCODEC_ERR_COMPONENTNOTFOUND);
+
+                return image;
+            });
+
+        ExpectHResultException(WINCODEC_ERR_COMPONENTNOTFOUND,
+            [&]
+            {
+                loader.Run([](uint32_t, IWICBitmap*) {}, nullptr);
+            });
+    }
+
+    TEST_METHOD_EX(BitmapBatchLoader_WhenUploadFails_RunThrowsTheErrorAndStopsDecoding)
+    {
+        const uint32_t fileCount = 100;
+
+        auto image = MakeDecodedImage(8, 8);
+        std::atomic<uint32_t> decodeCount(0);
+
+        BitmapBatchLoader loader(
+            fileCount,
+            [&](uint32_t) -> ComPtr<IWICBitmap>
+            {
+                decodeCount++;
+                return image;
+            },
+            1,
+            8 * 8 * 4);
+
+        ExpectHResultException(E_OUTOFMEMORY,
+            [&]
+            {
+                loader.Run([](uint32_t, IWICBitmap*) { ThrowHR(E_OUTOFMEMORY); }, nullptr);
+            });
+
+        Assert::IsTrue(decodeCount.load() < fileCount);
+    }
+
+    TEST_METHOD_EX(BitmapBatchLoader_DecodersAreLimitedToMaxDecoderCount)
+    {
+        auto image = MakeDecodedImage(8, 8);
+
+        auto decode = [&](uint32_t) -> ComPtr<IWICBitmap>
+        {
+            Sleep(1);
+            return image;
+        };
+
+        BitmapBatchLoader loader(40, decode, 3);
+        loader.Run([](uint32_t, IWICBitmap*) {}, nullptr);
+
+        Assert::IsTrue(loader.GetPeakActiveDecoderCount() >= 1);
+        Assert::IsTrue(loader.GetPeakActiveDecoderCount() <= 3);
+
+        // There is never more than one decoder per file
+        BitmapBatchLoader smallLoader(2, decode, 8);
+        smallLoader.Run([](uint32_t, IWICBitmap*) {}, nullptr);
+
+        Assert::IsTrue(smallLoader.GetPeakActiveDecoderCount() <= 2);
+    }
+
+    TEST_METHOD_EX(BitmapBatchLoader_WhenUploadIsSlow_BytesInFlightStayNearTheLimit)
+    {
+        const uint64_t imageSize = 64 * 64 * 4;
+        const uint64_t maximumBytesInFlight = 2 * imageSize;
+        const unsigned decoderCount = 4;
+
+        auto image = MakeDecodedImage(64, 64);
+
+        BitmapBatchLoader loader(
+            40,
+            [&](uint32_t) -> ComPtr<IWICBitmap> { return image; },
+            decoderCount,
+            maximumBytesInFlight);
+
+        loader.Run(
+            [](uint32_t, IWICBitmap*)
+            {
+                Sleep(2);
+            },
+            nullptr);
+
+        // Decoders stop starting new files once the limit is reached, but
+        // each one may already be part way through a file.
+        Assert::IsTrue(loader.GetPeakBytesInFlight() >= imageSize);
+        Assert::IsTrue(loader.GetPeakBytesInFlight() < maximumBytesInFlight + decoderCount * imageSize);
+    }
+
+    TEST_METHOD_EX(BitmapBatchLoader_BytesInFlightIncludeRowPadding)
+    {
+        // 10 pixels is 40 bytes per row, padded out to 64
+        auto image = MakeDecodedImage(10, 3, 64);
+
+        BitmapBatchLoader loader(1, [&](uint32_t) -> ComPtr<IWICBitmap> { return image; });
+        loader.Run([](uint32_t, IWICBitmap*) {}, nullptr);
+
+        Assert::AreEqual<uint64_t>(64 * 3, loader.GetPeakBytesInFlight());
+    }
+
+    TEST_METHOD_EX(BitmapBatchLoader_Cancel_StopsRunWithoutAnError)
+    {
+        const uint32_t fileCount = 100;
+
+        auto image = MakeDecodedImage(8, 8);
+        std::atomic<uint32_t> decodeCount(0);
+
+        BitmapBatchLoader loader(
+            fileCount,
+            [&](uint32_t) -> ComPtr<IWICBitmap>
+            {
+                decodeCount++;
+                return image;
+            },
+            1,
+            8 * 8 * 4);
+
+        uint32_t uploadCount = 0;
+
+        loader.Run(
+            [&](uint32_t, IWICBitmap*)
+            {
+                uploadCount++;
+            },
+            [&](uint32_t loadedCount)
+            {
+                if (loadedCount == 5)
+                    loader.Cancel();
+            });
+
+        Assert::AreEqual(5u, uploadCount);
+        Assert::IsTrue(decodeCount.load() < fileCount);
+    }
+
+    PERF_TEST_METHOD_ATTRIBUTES(BitmapBatchLoader_LoadThroughput_Scaling)
+    TEST_METHOD_EX(BitmapBatchLoader_LoadThroughput_Scaling)
+    {
+        // Decodes a directory's worth of PNG sprites, encoded in memory up
+        // front, with real WIC decoders and an increasing number of decoder
+        // threads.  Uploading goes through the same manager calls that
+        // LoadManyAsync makes, to a stub device.
+        const uint32_t fileCount = 128;
+        const UINT imageSize = 256;
+        const uint64_t imageBytes = imageSize * imageSize * 4;
+        const uint64_t maximumBytesInFlight = 8 * imageBytes;
+
+        ComPtr<IWICImagingFactory> wicFactory;
+        ThrowIfFailed(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&wicFactory)));
+
+        std::vector<std::vector<BYTE>> pngs;
+
+        for (uint32_t i = 0; i < fileCount; i++)
+        {
+            pngs.push_back(EncodePng(wicFactory.Get(), imageSize, imageSize, i));
+        }
+
+        auto manager = std::make_shared<PolymorphicBitmapManager>(std::make_shared<TestBitmapResourceCreationAdapter>());
+
+        auto device = Make<StubCanvasDevice>();
+        device->MockCreateBitmapFromWicResource =
+            [](IWICBitmapSource*, CanvasAlphaMode, float dpi) -> ComPtr<ID2D1Bitmap1>
+            {
+                return Make<StubD2DBitmap>(D2D1_BITMAP_OPTIONS_NONE, dpi);
+            };
+
+        unsigned maxDecoderCount = std::max(1u, std::thread::hardware_concurrency());
+
+        for (unsigned decoderCount = 1; decoderCount <= maxDecoderCount; decoderCount *= 2)
+        {
+            std::vector<ComPtr<CanvasBitmap>> bitmaps(fileCount);
+            uint32_t lastProgress = 0;
+
+            BitmapBatchLoader loader(
+                fileCount,
+                [&](uint32_t index)
+                {
+                    return DecodePng(wicFactory.Get(), pngs[index]);
+                },
+                decoderCount,
+                maximumBytesInFlight);
+
+            double seconds = MeasureSeconds(
+                [&]
+                {
+                    loader.Run(
+                        [&](uint32_t index, IWICBitmap* decodedImage)
+                        {
+                            bitmaps[index] = manager->CreateBitmap(device.Get(), decodedImage, DEFAULT_DPI, CanvasAlphaMode::Premultiplied);
+                        },
+                        [&](uint32_t loadedCount)
+                        {
+                            Assert::AreEqual(lastProgress + 1, loadedCount);
+                            lastProgress = loadedCount;
+                        });
+                });
+
+            for (auto& bitmap : bitmaps)
+            {
+                Assert::IsNotNull(bitmap.Get());
+            }
+
+            Assert::AreEqual(fileCount, lastProgress);
+            Assert::IsTrue(loader.GetPeakActiveDecoderCount() <= decoderCount);
+            Assert::IsTrue(loader.GetPeakBytesInFlight() < maximumBytesInFlight + decoderCount * imageBytes);
+
+            LogPerfMessage(L"%u decoders: %.0f files per second (%u decoding at once, peak %llu bytes waiting to upload)\n", decoderCount, fileCount / seconds, loader.GetPeakActiveDecoderCount(), loader.GetPeakBytesInFlight());
+        }
+    }
+};
@@ -196,6 +196,32 @@ TEST_CLASS(CanvasBitmapUnitTest)
         Assert::AreEqual(f.m_testImageHeightDip, size.Height);
     }
 
+    TEST_METHOD_EX(CanvasBitmap_CreateFromDecodedImage_UploadsThatImageWithoutDecodingAgain)
+    {
+        Fixture f;
+
+        f.m_adapter->MockCreateWICFormatConverter = [] { Assert::Fail(); };
+
+        auto decodedImage = Make<MockWICFormatConverter>();
+        bool isUploaded = false;
+
+        f.m_canvasDevice->MockCreateBitmapFromWicResource =
+            [&](IWICBitmapSource* converter, CanvasAlphaMode alpha, float dpi) -> ComPtr<ID2D1Bitmap1>
+            {
+                Assert::IsTrue(IsSameInstance(decodedImage.Get(), converter));
+                Assert::IsTrue(CanvasAlphaMode::Ignore == alpha);
+                Assert::AreEqual(144.0f, dpi);
+                isUploaded = true;
+
+                return Make<StubD2DBitmap>(D2D1_BITMAP_OPTIONS_NONE, dpi);
+            };
+
+        auto canvasBitmap = f.m_bitmapManager->Create(f.m_canvasDevice.Get(), static_cast<IWICBitmapSource*>(decodedImage.Get()), 144.0f, CanvasAlphaMode::Ignore);
+
+        Assert::IsTrue(isUploaded);
+        Assert::IsNotNull(canvasBitmap.Get());
+    }
+
     TEST_METHOD_EX(CanvasBitmap_Get_Bounds)
     {
         Fixture f;
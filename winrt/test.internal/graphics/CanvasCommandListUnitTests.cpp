@@ -179,6 +179,31 @@ TEST_CLASS(CanvasCommandListTests)
         ThrowIfFailed(As<IClosable>(ds)->Close());
     }
 
+    TEST_METHOD_EX(CanvasCommandList_CreateDrawingSession_UsesDeviceContextFromDevicePool)
+    {
+        Fixture f;
+
+        auto dc = Make<MockD2DDeviceContext>();
+        dc->SetTargetMethod.AllowAnyCall();
+        dc->SetTextAntialiasModeMethod.AllowAnyCall();
+        dc->BeginDrawMethod.SetExpectedCalls(1);
+        dc->EndDrawMethod.SetExpectedCalls(1);
+
+        f.Device->CreateDeviceContextMethod.SetExpectedCalls(0);
+        f.Device->AcquirePooledDeviceContextMethod.SetExpectedCalls(1, [=] { return dc; });
+
+        ComPtr<ICanvasDrawingSession> ds;
+        ThrowIfFailed(f.CommandList->CreateDrawingSession(&ds));
+
+        f.Device->ReleasePooledDeviceContextMethod.SetExpectedCalls(1,
+            [=](ID2D1DeviceContext1* deviceContext)
+            {
+                Assert::IsTrue(IsSameInstance(dc.Get(), deviceContext));
+            });
+
+        ThrowIfFailed(As<IClosable>(ds)->Close());
+    }
+
     TEST_METHOD_EX(CanvasCommandList_GetD2DImage_ClosesD2DCommandListOnFirstCall)
     {
         Fixture f;
@@ -12,6 +12,9 @@
 
 #include "pch.h"
 
+#include "mocks/MockD2DRectangleGeometry.h"
+#include "mocks/MockDWriteTextLayout.h"
+
 TEST_CLASS(CanvasDeviceTests)
 {
 public:
@@ -329,6 +332,120 @@ public:
         Assert::AreEqual(someSize, maximumBitmapSize);
     }
 
+    TEST_METHOD_EX(CanvasDevice_TextLayoutCache_Properties)
+    {
+        auto canvasDevice = m_deviceManager->Create(CanvasDebugLevel::None, CanvasHardwareAcceleration::On);
+        auto textLayoutCache = As<ICanvasDeviceInternal>(canvasDevice)->GetTextLayoutCache();
+
+        int32_t value;
+        ThrowIfFailed(canvasDevice->get_TextLayoutCacheMaximumEntryCount(&value));
+        Assert::AreEqual(0, value);
+        Assert::IsFalse(textLayoutCache->IsEnabled());
+
+        ThrowIfFailed(canvasDevice->put_TextLayoutCacheMaximumEntryCount(100));
+        ThrowIfFailed(canvasDevice->put_TextLayoutCacheMaximumCharacterCount(2000));
+
+        ThrowIfFailed(canvasDevice->get_TextLayoutCacheMaximumEntryCount(&value));
+        Assert::AreEqual(100, value);
+        ThrowIfFailed(canvasDevice->get_TextLayoutCacheMaximumCharacterCount(&value));
+        Assert::AreEqual(2000, value);
+
+        Assert::IsTrue(textLayoutCache->IsEnabled());
+        Assert::AreEqual(100U, static_cast<uint32_t>(textLayoutCache->GetMaximumEntryCount()));
+        Assert::AreEqual(2000U, static_cast<uint32_t>(textLayoutCache->GetMaximumCharacterCount()));
+
+        Assert::AreEqual(E_INVALIDARG, canvasDevice->put_TextLayoutCacheMaximumEntryCount(-1));
+        Assert::AreEqual(E_INVALIDARG, canvasDevice->put_TextLayoutCacheMaximumCharacterCount(-1));
+        Assert::AreEqual(E_INVALIDARG, canvasDevice->get_TextLayoutCacheMaximumEntryCount(nullptr));
+        Assert::AreEqual(E_INVALIDARG, canvasDevice->get_TextLayoutCacheMaximumCharacterCount(nullptr));
+        Assert::AreEqual(E_INVALIDARG, canvasDevice->GetTextLayoutCacheStatistics(nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasDevice_TextLayoutCache_StatisticsAndTrim)
+    {
+        auto canvasDevice = m_deviceManager->Create(CanvasDebugLevel::None, CanvasHardwareAcceleration::On);
+        auto textLayoutCache = As<ICanvasDeviceInternal>(canvasDevice)->GetTextLayoutCache();
+
+        ThrowIfFailed(canvasDevice->put_TextLayoutCacheMaximumEntryCount(16));
+
+        auto format = Make<MockDWriteTextLayout>();
+
+        for (int i = 0; i < 3; i++)
+        {
+            textLayoutCache->GetLayout(L"abc", 3, format.Get(), 0, 10, 10, 0,
+                [] { return Make<MockDWriteTextLayout>(); });
+        }
+
+        CanvasTextLayoutCacheStatistics statistics;
+        ThrowIfFailed(canvasDevice->GetTextLayoutCacheStatistics(&statistics));
+        Assert::AreEqual(2LL, statistics.HitCount);
+        Assert::AreEqual(1LL, statistics.MissCount);
+        Assert::AreEqual(1, statistics.EntryCount);
+        Assert::AreEqual(3, statistics.CharacterCount);
+
+        ThrowIfFailed(canvasDevice->Trim());
+
+        ThrowIfFailed(canvasDevice->GetTextLayoutCacheStatistics(&statistics));
+        Assert::AreEqual(0, statistics.EntryCount);
+        Assert::AreEqual(0, statistics.CharacterCount);
+    }
+
+    TEST_METHOD_EX(CanvasDevice_TessellationCache_Properties)
+    {
+        auto canvasDevice = m_deviceManager->Create(CanvasDebugLevel::None, CanvasHardwareAcceleration::On);
+        auto tessellationCache = As<ICanvasDeviceInternal>(canvasDevice)->GetTessellationCache();
+
+        int64_t value;
+        ThrowIfFailed(canvasDevice->get_TessellationCacheMaximumByteCount(&value));
+        Assert::AreEqual(0LL, value);
+        Assert::IsFalse(tessellationCache->IsEnabled());
+
+        ThrowIfFailed(canvasDevice->put_TessellationCacheMaximumByteCount(4096));
+
+        ThrowIfFailed(canvasDevice->get_TessellationCacheMaximumByteCount(&value));
+        Assert::AreEqual(4096LL, value);
+
+        Assert::IsTrue(tessellationCache->IsEnabled());
+        Assert::AreEqual(4096U, static_cast<uint32_t>(tessellationCache->GetMaximumByteCount()));
+
+        ThrowIfFailed(canvasDevice->put_TessellationCacheMaximumByteCount(0));
+        Assert::IsFalse(tessellationCache->IsEnabled());
+
+        Assert::AreEqual(E_INVALIDARG, canvasDevice->put_TessellationCacheMaximumByteCount(-1));
+        Assert::AreEqual(E_INVALIDARG, canvasDevice->get_TessellationCacheMaximumByteCount(nullptr));
+        Assert::AreEqual(E_INVALIDARG, canvasDevice->GetTessellationCacheStatistics(nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasDevice_TessellationCache_StatisticsAndTrim)
+    {
+        auto canvasDevice = m_deviceManager->Create(CanvasDebugLevel::None, CanvasHardwareAcceleration::On);
+        auto tessellationCache = As<ICanvasDeviceInternal>(canvasDevice)->GetTessellationCache();
+
+        ThrowIfFailed(canvasDevice->put_TessellationCacheMaximumByteCount(4096));
+
+        auto geometry = Make<MockD2DRectangleGeometry>();
+        D2D1_MATRIX_3X2_F identity = D2D1::Matrix3x2F::Identity();
+
+        for (int i = 0; i < 3; i++)
+        {
+            tessellationCache->GetTriangles(geometry.Get(), identity, 1,
+                [] { return Geometry::TessellationCache::Triangles(2); });
+        }
+
+        CanvasTessellationCacheStatistics statistics;
+        ThrowIfFailed(canvasDevice->GetTessellationCacheStatistics(&statistics));
+        Assert::AreEqual(2LL, statistics.HitCount);
+        Assert::AreEqual(1LL, statistics.MissCount);
+        Assert::AreEqual(1, statistics.EntryCount);
+        Assert::AreEqual(static_cast<int64_t>(2 * sizeof(Geometry::CanvasTriangleVertices) + Geometry::TessellationCache::EntryOverheadInBytes), statistics.ByteCount);
+
+        ThrowIfFailed(canvasDevice->Trim());
+
+        ThrowIfFailed(canvasDevice->GetTessellationCacheStatistics(&statistics));
+        Assert::AreEqual(0, statistics.EntryCount);
+        Assert::AreEqual(0LL, statistics.ByteCount);
+    }
+
     TEST_METHOD_EX(CanvasDevice_CreateCommandList_ReturnsCommandListFromDeviceContext)
     {
         auto d2dDevice = Make<MockD2DDevice>();
@@ -18,7 +18,9 @@
 
 #include "mocks/MockD2DGeometryRealization.h"
 #include "mocks/MockD2DRectangleGeometry.h"
+#include "mocks/MockDWriteTextLayout.h"
 #include "stubs/StubCanvasBrush.h"
+#include "stubs/StubCanvasTextFormatAdapter.h"
 #include "stubs/StubCanvasTextLayoutAdapter.h"
 #include "stubs/StubD2DEffect.h"
 
@@ -4073,6 +4075,45 @@ TEST_CLASS(CanvasDrawingSession_DrawTextTests)
         }
     }
 
+    TEST_METHOD_EX(CanvasDrawingSession_DrawTextAtPoint_DoesNotRecreateTextFormatOnEachDraw)
+    {
+        CanvasDrawingSessionFixture f;
+
+        auto adapter = std::make_shared<StubCanvasTextFormatAdapterWithDWriteFactory>();
+        auto format = std::make_shared<CanvasTextFormatManager>(adapter)->Create();
+        ThrowIfFailed(format->put_WordWrapping(CanvasWordWrapping::WholeWord));
+
+        auto realizedFormat = format->GetRealizedTextFormat();
+
+        const int drawCount = 1000;
+
+        // Only the no-wrap copy of the format is created, and only once.
+        adapter->ExpectCreateTextFormat(1);
+
+        IDWriteTextFormat* drawnFormat = nullptr;
+
+        f.DeviceContext->DrawTextMethod.SetExpectedCalls(drawCount,
+            [&](wchar_t const*, uint32_t, IDWriteTextFormat* actualFormat, D2D1_RECT_F const*, ID2D1Brush*, D2D1_DRAW_TEXT_OPTIONS, DWRITE_MEASURING_MODE)
+            {
+                Assert::AreEqual(DWRITE_WORD_WRAPPING_NO_WRAP, actualFormat->GetWordWrapping());
+
+                if (!drawnFormat)
+                    drawnFormat = actualFormat;
+
+                Assert::AreEqual(drawnFormat, actualFormat);
+                Assert::AreNotEqual(realizedFormat.Get(), actualFormat);
+            });
+
+        for (int i = 0; i < drawCount; i++)
+        {
+            ThrowIfFailed(f.DS->DrawTextAtPointWithColorAndFormat(WinString(L"text"), Vector2{ 1, 2 }, ArbitraryMarkerColor1, format.Get()));
+        }
+
+        // The caller's format has not been touched.
+        Assert::AreEqual(realizedFormat.Get(), format->GetRealizedTextFormat().Get());
+        Assert::AreEqual(DWRITE_WORD_WRAPPING_WHOLE_WORD, realizedFormat->GetWordWrapping());
+    }
+
     TEST_METHOD_EX(CanvasDrawingSession_DrawTextAtPointWithColor)
     {
         TestDrawText(false, false, true, D2D1_RECT_F{ 23, 42, 23, 42 },
@@ -4761,3 +4802,709 @@ TEST_CLASS(CanvasDrawingSession_CreateLayerTests)
         ThrowIfFailed(As<IClosable>(activeLayer)->Close());
     }
 };
+
+TEST_CLASS(CanvasDrawingSession_SpriteBatchTests)
+{
+    struct Fixture : public CanvasDrawingSessionFixture
+    {
+        Fixture()
+        {
+            DeviceContext->GetUnitModeMethod.AllowAnyCall([] { return D2D1_UNIT_MODE_DIPS; });
+            DeviceContext->GetPrimitiveBlendMethod.AllowAnyCall([] { return D2D1_PRIMITIVE_BLEND_SOURCE_OVER; });
+        }
+
+        ComPtr<CanvasBitmap> MakeBitmap()
+        {
+            auto d2dBitmap = Make<StubD2DBitmap>();
+            d2dBitmap->GetSizeMethod.AllowAnyCall([] { return D2D1_SIZE_F{ 23, 45 }; });
+            d2dBitmap->GetPixelSizeMethod.AllowAnyCall([] { return D2D1_SIZE_U{ 67, 89 }; });
+
+            auto converter = Make<MockWICFormatConverter>();
+            auto adapter = std::make_shared<TestBitmapResourceCreationAdapter>(converter);
+            auto bitmapManager = std::make_shared<CanvasBitmapManager>(adapter);
+
+            return bitmapManager->GetOrCreate(Make<StubCanvasDevice>().Get(), d2dBitmap.Get());
+        }
+
+        ComPtr<ICanvasSpriteBatch> CreateSpriteBatch(CanvasSpriteSortMode sortMode = CanvasSpriteSortMode::None)
+        {
+            ComPtr<ICanvasSpriteBatch> spriteBatch;
+            ThrowIfFailed(DS->CreateSpriteBatchWithSortMode(sortMode, &spriteBatch));
+            return spriteBatch;
+        }
+    };
+
+    TEST_METHOD_EX(CanvasDrawingSession_CreateSpriteBatch_NullArgs)
+    {
+        Fixture f;
+
+        Assert::AreEqual(E_INVALIDARG, f.DS->CreateSpriteBatch(nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.DS->CreateSpriteBatchWithSortMode(CanvasSpriteSortMode::None, nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.DS->CreateSpriteBatchWithSortModeAndInterpolation(CanvasSpriteSortMode::None, CanvasImageInterpolation::Linear, nullptr));
+
+        auto spriteBatch = f.CreateSpriteBatch();
+        Assert::AreEqual(E_INVALIDARG, spriteBatch->DrawAtOffset(nullptr, Vector2{ 0, 0 }));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_CreateSpriteBatch_WhenInterpolationNotSupportedByDrawBitmap_ReturnsInvalidArg)
+    {
+        Fixture f;
+
+        ComPtr<ICanvasSpriteBatch> spriteBatch;
+        Assert::AreEqual(E_INVALIDARG, f.DS->CreateSpriteBatchWithSortModeAndInterpolation(CanvasSpriteSortMode::None, CanvasImageInterpolation::Cubic, &spriteBatch));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_SpriteBatch_DrawsNothingUntilClosed)
+    {
+        Fixture f;
+        auto bitmap = f.MakeBitmap();
+
+        auto spriteBatch = f.CreateSpriteBatch();
+
+        for (int i = 0; i < 10; i++)
+            ThrowIfFailed(spriteBatch->DrawAtOffset(bitmap.Get(), Vector2{ float(i), 0 }));
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(10);
+        ThrowIfFailed(As<IClosable>(spriteBatch)->Close());
+
+        // Closing a second time is a no-op, but further draws fail
+        ThrowIfFailed(As<IClosable>(spriteBatch)->Close());
+        Assert::AreEqual(RO_E_CLOSED, spriteBatch->DrawAtOffset(bitmap.Get(), Vector2{ 0, 0 }));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_SpriteBatch_DrawToRect_PassesParametersToDrawBitmap)
+    {
+        Fixture f;
+        auto bitmap = f.MakeBitmap();
+
+        Rect expectedDestRect{ 1, 2, 3, 4 };
+        Rect expectedSourceRect{ 5, 6, 7, 8 };
+
+        ComPtr<ICanvasSpriteBatch> spriteBatch;
+        ThrowIfFailed(f.DS->CreateSpriteBatchWithSortModeAndInterpolation(CanvasSpriteSortMode::None, CanvasImageInterpolation::NearestNeighbor, &spriteBatch));
+        ThrowIfFailed(spriteBatch->DrawFromSpriteSheetToRect(bitmap.Get(), expectedDestRect, expectedSourceRect));
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(1,
+            [&](ID2D1Bitmap* d2dBitmap, D2D1_RECT_F const* destRect, FLOAT opacity, D2D1_INTERPOLATION_MODE interpolation, D2D1_RECT_F const* sourceRect, D2D1_MATRIX_4X4_F const* perspective)
+            {
+                Assert::IsTrue(IsSameInstance(bitmap->GetD2DBitmap().Get(), d2dBitmap));
+                Assert::AreEqual(ToD2DRect(expectedDestRect), *destRect);
+                Assert::AreEqual(1.0f, opacity);
+                Assert::AreEqual(D2D1_INTERPOLATION_MODE_NEAREST_NEIGHBOR, interpolation);
+                Assert::AreEqual(ToD2DRect(expectedSourceRect), *sourceRect);
+                Assert::IsNull(perspective);
+            });
+
+        ThrowIfFailed(As<IClosable>(spriteBatch)->Close());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_SpriteBatch_DrawAtOffset_UsesBitmapSizeAndAlphaOfTint)
+    {
+        Fixture f;
+        auto bitmap = f.MakeBitmap();
+
+        auto spriteBatch = f.CreateSpriteBatch();
+        ThrowIfFailed(spriteBatch->DrawAtOffsetWithTint(bitmap.Get(), Vector2{ 10, 20 }, Color{ 128, 255, 255, 255 }));
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(1,
+            [&](ID2D1Bitmap*, D2D1_RECT_F const* destRect, FLOAT opacity, D2D1_INTERPOLATION_MODE interpolation, D2D1_RECT_F const* sourceRect, D2D1_MATRIX_4X4_F const* perspective)
+            {
+                Assert::AreEqual(D2D1_RECT_F{ 10, 20, 33, 65 }, *destRect);
+                Assert::AreEqual(128 / 255.0f, opacity);
+                Assert::AreEqual(D2D1_INTERPOLATION_MODE_LINEAR, interpolation);
+                Assert::IsNull(sourceRect);
+                Assert::IsNull(perspective);
+            });
+
+        ThrowIfFailed(As<IClosable>(spriteBatch)->Close());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_SpriteBatch_DrawWithTransform_PassesPerspectiveTransform)
+    {
+        Fixture f;
+        auto bitmap = f.MakeBitmap();
+
+        auto spriteBatch = f.CreateSpriteBatch();
+        ThrowIfFailed(spriteBatch->DrawWithTransform(bitmap.Get(), Matrix3x2{ 1, 2, 3, 4, 5, 6 }));
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(1,
+            [&](ID2D1Bitmap*, D2D1_RECT_F const* destRect, FLOAT, D2D1_INTERPOLATION_MODE, D2D1_RECT_F const*, D2D1_MATRIX_4X4_F const* perspective)
+            {
+                Assert::AreEqual(D2D1_RECT_F{ 0, 0, 23, 45 }, *destRect);
+
+                Assert::IsNotNull(perspective);
+
+                D2D1_MATRIX_4X4_F expected = D2D1::Matrix4x4F(
+                    1, 2, 0, 0,
+                    3, 4, 0, 0,
+                    0, 0, 1, 0,
+                    5, 6, 0, 1);
+
+                Assert::AreEqual(expected, *perspective);
+            });
+
+        ThrowIfFailed(As<IClosable>(spriteBatch)->Close());
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_SpriteBatch_WhenSortedByBitmap_DrawsSpritesGroupedByBitmap)
+    {
+        Fixture f;
+        auto bitmap1 = f.MakeBitmap();
+        auto bitmap2 = f.MakeBitmap();
+
+        auto spriteBatch = f.CreateSpriteBatch(CanvasSpriteSortMode::Bitmap);
+
+        for (int i = 0; i < 4; i++)
+        {
+            ThrowIfFailed(spriteBatch->DrawAtOffset(bitmap1.Get(), Vector2{ float(i), 0 }));
+            ThrowIfFailed(spriteBatch->DrawAtOffset(bitmap2.Get(), Vector2{ float(i), 0 }));
+        }
+
+        std::vector<ID2D1Bitmap*> drawnBitmaps;
+        std::vector<float> drawnOffsets;
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(8,
+            [&](ID2D1Bitmap* d2dBitmap, D2D1_RECT_F const* destRect, FLOAT, D2D1_INTERPOLATION_MODE, D2D1_RECT_F const*, D2D1_MATRIX_4X4_F const*)
+            {
+                drawnBitmaps.push_back(d2dBitmap);
+                drawnOffsets.push_back(destRect->left);
+            });
+
+        ThrowIfFailed(As<IClosable>(spriteBatch)->Close());
+
+        for (int i = 0; i < 8; i++)
+        {
+            auto expectedBitmap = (i < 4) ? bitmap1 : bitmap2;
+            Assert::IsTrue(IsSameInstance(expectedBitmap->GetD2DBitmap().Get(), drawnBitmaps[i]));
+
+            // Sorting is stable, so each bitmap's sprites keep their order
+            Assert::AreEqual(float(i % 4), drawnOffsets[i]);
+        }
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_SpriteBatch_WhenTinted_SetsUpEffectOncePerDistinctBitmap)
+    {
+        Fixture f;
+        auto bitmap1 = f.MakeBitmap();
+        auto bitmap2 = f.MakeBitmap();
+
+        Color tint{ 255, 255, 0, 0 };
+
+        auto spriteBatch = f.CreateSpriteBatch(CanvasSpriteSortMode::Bitmap);
+
+        const int spritesPerBitmap = 50;
+
+        for (int i = 0; i < spritesPerBitmap; i++)
+        {
+            ThrowIfFailed(spriteBatch->DrawAtOffsetWithTint(bitmap1.Get(), Vector2{ float(i), 0 }, tint));
+            ThrowIfFailed(spriteBatch->DrawAtOffsetWithTint(bitmap2.Get(), Vector2{ float(i), 0 }, tint));
+        }
+
+        D2D1::Matrix3x2F currentTransform = D2D1::Matrix3x2F::Identity();
+
+        f.DeviceContext->GetTransformMethod.AllowAnyCall([&](D2D1_MATRIX_3X2_F* m) { *m = currentTransform; });
+        f.DeviceContext->SetTransformMethod.AllowAnyCall([&](D2D1_MATRIX_3X2_F const* m) { currentTransform = *D2D1::Matrix3x2F::ReinterpretBaseType(m); });
+
+        // One ColorMatrix effect for the whole batch, plus one DPI
+        // compensation effect per distinct bitmap.
+        f.DeviceContext->CreateEffectMethod.SetExpectedCalls(3,
+            [](IID const& iid, ID2D1Effect** effect)
+            {
+                return Make<StubD2DEffect>(iid).CopyTo(effect);
+            });
+
+        f.DeviceContext->DrawImageMethod.SetExpectedCalls(spritesPerBitmap * 2,
+            [&](ID2D1Image* image, D2D1_POINT_2F const*, D2D1_RECT_F const* sourceRect, D2D1_INTERPOLATION_MODE, D2D1_COMPOSITE_MODE compositeMode)
+            {
+                auto colorMatrixEffect = MaybeAs<ID2D1Effect>(image);
+                Assert::IsNotNull(colorMatrixEffect.Get());
+
+                D2D1_MATRIX_5X4_F expectedMatrix = D2D1::Matrix5x4F(
+                    1, 0, 0, 0,
+                    0, 0, 0, 0,
+                    0, 0, 0, 0,
+                    0, 0, 0, 1,
+                    0, 0, 0, 0);
+
+                D2D1_MATRIX_5X4_F actualMatrix;
+                colorMatrixEffect->GetValue(D2D1_COLORMATRIX_PROP_COLOR_MATRIX, &actualMatrix);
+                Assert::AreEqual(expectedMatrix, actualMatrix);
+
+                Assert::AreEqual(D2D1_RECT_F{ 0, 0, 23, 45 }, *sourceRect);
+                Assert::AreEqual(D2D1_COMPOSITE_MODE_SOURCE_OVER, compositeMode);
+            });
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(0);
+
+        ThrowIfFailed(As<IClosable>(spriteBatch)->Close());
+
+        // The original transform is restored
+        Assert::AreEqual(D2D1_MATRIX_3X2_F{ 1, 0, 0, 1, 0, 0 }, static_cast<D2D1_MATRIX_3X2_F>(currentTransform));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_SpriteBatch_WhenTintedAndUnsorted_ReusesEffectInputForEachBitmap)
+    {
+        Fixture f;
+        auto bitmap1 = f.MakeBitmap();
+        auto bitmap2 = f.MakeBitmap();
+
+        Color tint{ 255, 255, 0, 0 };
+
+        auto spriteBatch = f.CreateSpriteBatch();
+
+        const int spritesPerBitmap = 50;
+
+        for (int i = 0; i < spritesPerBitmap; i++)
+        {
+            ThrowIfFailed(spriteBatch->DrawAtOffsetWithTint(bitmap1.Get(), Vector2{ float(i), 0 }, tint));
+            ThrowIfFailed(spriteBatch->DrawAtOffsetWithTint(bitmap2.Get(), Vector2{ float(i), 0 }, tint));
+        }
+
+        D2D1::Matrix3x2F currentTransform = D2D1::Matrix3x2F::Identity();
+
+        f.DeviceContext->GetTransformMethod.SetExpectedCalls(1, [&](D2D1_MATRIX_3X2_F* m) { *m = currentTransform; });
+        f.DeviceContext->SetTransformMethod.AllowAnyCall([&](D2D1_MATRIX_3X2_F const* m) { currentTransform = *D2D1::Matrix3x2F::ReinterpretBaseType(m); });
+
+        // The bitmap changes on every sprite, but each one's DPI
+        // compensation effect is only created once.
+        f.DeviceContext->CreateEffectMethod.SetExpectedCalls(3,
+            [](IID const& iid, ID2D1Effect** effect)
+            {
+                return Make<StubD2DEffect>(iid).CopyTo(effect);
+            });
+
+        f.DeviceContext->DrawImageMethod.SetExpectedCalls(spritesPerBitmap * 2);
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(0);
+
+        ThrowIfFailed(As<IClosable>(spriteBatch)->Close());
+
+        Assert::AreEqual(D2D1_MATRIX_3X2_F{ 1, 0, 0, 1, 0, 0 }, static_cast<D2D1_MATRIX_3X2_F>(currentTransform));
+    }
+
+#if WINVER > 0x0603
+
+    TEST_METHOD_EX(CanvasDrawingSession_SpriteBatch_WhenSpriteBatchSupported_DrawsOncePerDistinctBitmap)
+    {
+        Fixture f;
+        f.DeviceContext->IsDeviceContext3Supported = true;
+
+        auto bitmap1 = f.MakeBitmap();
+        auto bitmap2 = f.MakeBitmap();
+
+        auto spriteBatch = f.CreateSpriteBatch(CanvasSpriteSortMode::Bitmap);
+
+        const uint32_t spritesPerBitmap = 100;
+
+        for (uint32_t i = 0; i < spritesPerBitmap; i++)
+        {
+            ThrowIfFailed(spriteBatch->DrawAtOffset(bitmap1.Get(), Vector2{ float(i), 0 }));
+            ThrowIfFailed(spriteBatch->DrawAtOffsetWithTint(bitmap2.Get(), Vector2{ float(i), 0 }, Color{ 255, 255, 0, 0 }));
+        }
+
+        auto d2dSpriteBatch = Make<MockD2DSpriteBatch>();
+
+        f.DeviceContext->CreateSpriteBatchMethod.SetExpectedCalls(1,
+            [&](ID2D1SpriteBatch** value)
+            {
+                return d2dSpriteBatch.CopyTo(value);
+            });
+
+        d2dSpriteBatch->AddSpritesMethod.SetExpectedCalls(1,
+            [&](UINT32 spriteCount, D2D1_RECT_F const* destinationRects, D2D1_RECT_U const*, D2D1_COLOR_F const* colors, D2D1_MATRIX_3X2_F const*, UINT32, UINT32, UINT32, UINT32)
+            {
+                Assert::AreEqual(spritesPerBitmap * 2, spriteCount);
+
+                for (uint32_t i = 0; i < spriteCount; i++)
+                {
+                    // Sorting is stable, so each bitmap's sprites keep their order
+                    Assert::AreEqual(float(i % spritesPerBitmap), destinationRects[i].left);
+
+                    auto expectedColor = (i < spritesPerBitmap) ? D2D1_COLOR_F{ 1, 1, 1, 1 } : D2D1_COLOR_F{ 1, 0, 0, 1 };
+                    Assert::AreEqual(expectedColor, colors[i]);
+                }
+
+                return S_OK;
+            });
+
+        f.DeviceContext->GetAntialiasModeMethod.AllowAnyCall([] { return D2D1_ANTIALIAS_MODE_ALIASED; });
+
+        std::vector<ID2D1Bitmap*> drawnBitmaps;
+
+        f.DeviceContext->DrawSpriteBatchMethod.SetExpectedCalls(2,
+            [&](ID2D1SpriteBatch* batch, UINT32 startIndex, UINT32 spriteCount, ID2D1Bitmap* d2dBitmap, D2D1_BITMAP_INTERPOLATION_MODE interpolation, D2D1_SPRITE_OPTIONS options)
+            {
+                Assert::IsTrue(IsSameInstance(d2dSpriteBatch.Get(), batch));
+                Assert::AreEqual<UINT32>(static_cast<UINT32>(drawnBitmaps.size()) * spritesPerBitmap, startIndex);
+                Assert::AreEqual(spritesPerBitmap, spriteCount);
+                Assert::AreEqual(D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, interpolation);
+                Assert::AreEqual(D2D1_SPRITE_OPTIONS_NONE, options);
+
+                drawnBitmaps.push_back(d2dBitmap);
+            });
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(0);
+        f.DeviceContext->DrawImageMethod.SetExpectedCalls(0);
+        f.DeviceContext->CreateEffectMethod.SetExpectedCalls(0);
+
+        ThrowIfFailed(As<IClosable>(spriteBatch)->Close());
+
+        Assert::IsTrue(IsSameInstance(bitmap1->GetD2DBitmap().Get(), drawnBitmaps[0]));
+        Assert::IsTrue(IsSameInstance(bitmap2->GetD2DBitmap().Get(), drawnBitmaps[1]));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_SpriteBatch_WhenSpriteBatchSupported_PassesSourceRectAndTransformAsSpriteData)
+    {
+        Fixture f;
+        f.DeviceContext->IsDeviceContext3Supported = true;
+
+        auto bitmap = f.MakeBitmap();
+
+        ComPtr<ICanvasSpriteBatch> spriteBatch;
+        ThrowIfFailed(f.DS->CreateSpriteBatchWithSortModeAndInterpolation(CanvasSpriteSortMode::None, CanvasImageInterpolation::NearestNeighbor, &spriteBatch));
+
+        ThrowIfFailed(spriteBatch->DrawFromSpriteSheetToRect(bitmap.Get(), Rect{ 1, 2, 3, 4 }, Rect{ 5, 6, 7, 8 }));
+        ThrowIfFailed(spriteBatch->DrawWithTransform(bitmap.Get(), Matrix3x2{ 1, 2, 3, 4, 5, 6 }));
+
+        auto d2dSpriteBatch = Make<MockD2DSpriteBatch>();
+        f.DeviceContext->CreateSpriteBatchMethod.SetExpectedCalls(1, [&](ID2D1SpriteBatch** value) { return d2dSpriteBatch.CopyTo(value); });
+
+        d2dSpriteBatch->AddSpritesMethod.SetExpectedCalls(1,
+            [&](UINT32 spriteCount, D2D1_RECT_F const* destinationRects, D2D1_RECT_U const* sourceRects, D2D1_COLOR_F const*, D2D1_MATRIX_3X2_F const* transforms, UINT32, UINT32, UINT32, UINT32)
+            {
+                Assert::AreEqual(2u, spriteCount);
+
+                Assert::AreEqual(D2D1_RECT_F{ 1, 2, 4, 6 }, destinationRects[0]);
+                Assert::AreEqual(D2D1_RECT_U{ 5, 6, 12, 14 }, sourceRects[0]);
+                Assert::AreEqual(D2D1_MATRIX_3X2_F{ 1, 0, 0, 1, 0, 0 }, transforms[0]);
+
+                // Without a source rect the whole bitmap is drawn at its DIP size
+                Assert::AreEqual(D2D1_RECT_F{ 0, 0, 23, 45 }, destinationRects[1]);
+                Assert::AreEqual(D2D1_RECT_U{ 0, 0, 67, 89 }, sourceRects[1]);
+                Assert::AreEqual(D2D1_MATRIX_3X2_F{ 1, 2, 3, 4, 5, 6 }, transforms[1]);
+
+                return S_OK;
+            });
+
+        // DrawSpriteBatch needs aliased antialiasing; the original mode is
+        // put back afterwards.
+        f.DeviceContext->GetAntialiasModeMethod.SetExpectedCalls(1, [] { return D2D1_ANTIALIAS_MODE_PER_PRIMITIVE; });
+
+        std::vector<D2D1_ANTIALIAS_MODE> antialiasModes;
+        f.DeviceContext->SetAntialiasModeMethod.SetExpectedCalls(2, [&](D2D1_ANTIALIAS_MODE mode) { antialiasModes.push_back(mode); });
+
+        f.DeviceContext->DrawSpriteBatchMethod.SetExpectedCalls(1,
+            [&](ID2D1SpriteBatch*, UINT32 startIndex, UINT32 spriteCount, ID2D1Bitmap*, D2D1_BITMAP_INTERPOLATION_MODE interpolation, D2D1_SPRITE_OPTIONS)
+            {
+                Assert::AreEqual(0u, startIndex);
+                Assert::AreEqual(2u, spriteCount);
+                Assert::AreEqual(D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR, interpolation);
+                Assert::AreEqual<size_t>(1, antialiasModes.size());
+            });
+
+        ThrowIfFailed(As<IClosable>(spriteBatch)->Close());
+
+        Assert::AreEqual(D2D1_ANTIALIAS_MODE_ALIASED, antialiasModes[0]);
+        Assert::AreEqual(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE, antialiasModes[1]);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_SpriteBatch_WhenSourceRectIsNotWholePixels_FallsBackToDrawBitmap)
+    {
+        Fixture f;
+        f.DeviceContext->IsDeviceContext3Supported = true;
+
+        auto bitmap = f.MakeBitmap();
+
+        auto spriteBatch = f.CreateSpriteBatch();
+        ThrowIfFailed(spriteBatch->DrawAtOffset(bitmap.Get(), Vector2{ 0, 0 }));
+        ThrowIfFailed(spriteBatch->DrawFromSpriteSheetAtOffset(bitmap.Get(), Vector2{ 0, 0 }, Rect{ 0.5f, 0, 10, 10 }));
+
+        f.DeviceContext->CreateSpriteBatchMethod.SetExpectedCalls(0);
+        f.DeviceContext->DrawSpriteBatchMethod.SetExpectedCalls(0);
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(2);
+
+        ThrowIfFailed(As<IClosable>(spriteBatch)->Close());
+    }
+
+#endif
+
+    TEST_METHOD_EX(CanvasDrawingSession_SpriteBatch_WhenNotClosed_ClosingDrawingSessionFails)
+    {
+        Fixture f;
+
+        auto spriteBatch = f.CreateSpriteBatch();
+
+        Assert::AreEqual(E_FAIL, As<IClosable>(f.DS)->Close());
+        ValidateStoredErrorState(E_FAIL, Strings::DidNotCloseSpriteBatch);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_SpriteBatch_WhenClosedAfterDrawingSession_DoesNotDraw)
+    {
+        Fixture f;
+        auto bitmap = f.MakeBitmap();
+
+        auto spriteBatch = f.CreateSpriteBatch();
+        ThrowIfFailed(spriteBatch->DrawAtOffset(bitmap.Get(), Vector2{ 0, 0 }));
+
+        f.DS.Reset();
+
+        f.DeviceContext->DrawBitmapMethod.SetExpectedCalls(0);
+        ThrowIfFailed(As<IClosable>(spriteBatch)->Close());
+    }
+};
+
+TEST_CLASS(CanvasDrawingSession_ColorBrushTests)
+{
+    struct Fixture
+    {
+        ComPtr<StubD2DDeviceContextWithGetFactory> DeviceContext;
+        ComPtr<StubCanvasDevice> Device;
+        std::map<uint32_t, ComPtr<MockD2DSolidColorBrush>> PooledBrushes;
+
+        Fixture()
+            : DeviceContext(Make<StubD2DDeviceContextWithGetFactory>())
+            , Device(Make<StubCanvasDevice>())
+        {
+            DeviceContext->CreateSolidColorBrushMethod.SetExpectedCalls(0);
+
+            Device->GetSolidColorBrushMethod.AllowAnyCall(
+                [=](Color const& color)
+                {
+                    return GetPooledBrush(color);
+                });
+        }
+
+        ComPtr<ID2D1SolidColorBrush> GetPooledBrush(Color const& color)
+        {
+            auto& brush = PooledBrushes[GetKey(color)];
+
+            if (!brush)
+            {
+                brush = Make<MockD2DSolidColorBrush>();
+                brush->MockSetColor = [](D2D1_COLOR_F const*) { Assert::Fail(L"Pooled brushes must not have their color changed"); };
+            }
+
+            return brush;
+        }
+
+        ComPtr<CanvasDrawingSession> CreateDrawingSession()
+        {
+            auto manager = std::make_shared<CanvasDrawingSessionManager>();
+            return manager->Create(Device.Get(), DeviceContext.Get(), std::make_shared<StubCanvasDrawingSessionAdapter>());
+        }
+
+        static uint32_t GetKey(Color const& color)
+        {
+            return (color.A << 24) | (color.R << 16) | (color.G << 8) | color.B;
+        }
+    };
+
+    TEST_METHOD_EX(CanvasDrawingSession_WhenOwnedByDevice_ColorBrushesComeFromDevicePool)
+    {
+        Fixture f;
+        auto ds = f.CreateDrawingSession();
+
+        std::vector<ID2D1Brush*> usedBrushes;
+
+        f.DeviceContext->FillRectangleMethod.AllowAnyCall(
+            [&](D2D1_RECT_F const*, ID2D1Brush* brush)
+            {
+                usedBrushes.push_back(brush);
+            });
+
+        Color palette[] = { ArbitraryMarkerColor1, ArbitraryMarkerColor2 };
+
+        // Consecutive draws in the same color reuse the previous brush
+        // without going back to the pool.
+        f.Device->GetSolidColorBrushMethod.SetExpectedCalls(4,
+            [&](Color const& color)
+            {
+                return f.GetPooledBrush(color);
+            });
+
+        for (int i = 0; i < 8; i++)
+        {
+            ThrowIfFailed(ds->FillRectangleAtCoordsWithColor(0, 0, 1, 1, palette[(i / 2) % 2]));
+        }
+
+        Assert::AreEqual(2U, static_cast<uint32_t>(f.PooledBrushes.size()));
+
+        for (int i = 0; i < 8; i++)
+        {
+            auto& expectedBrush = f.PooledBrushes[Fixture::GetKey(palette[(i / 2) % 2])];
+            Assert::IsTrue(IsSameInstance(expectedBrush.Get(), usedBrushes[i]));
+        }
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_WhenOwnedByDevice_ColorBrushesAreSharedBetweenSessions)
+    {
+        Fixture f;
+
+        ID2D1Brush* brushFromFirstSession = nullptr;
+        ID2D1Brush* brushFromSecondSession = nullptr;
+
+        {
+            auto ds = f.CreateDrawingSession();
+            f.DeviceContext->FillRectangleMethod.SetExpectedCalls(1, [&](D2D1_RECT_F const*, ID2D1Brush* brush) { brushFromFirstSession = brush; });
+            ThrowIfFailed(ds->FillRectangleAtCoordsWithColor(0, 0, 1, 1, ArbitraryMarkerColor1));
+        }
+
+        {
+            auto ds = f.CreateDrawingSession();
+            f.DeviceContext->FillRectangleMethod.SetExpectedCalls(1, [&](D2D1_RECT_F const*, ID2D1Brush* brush) { brushFromSecondSession = brush; });
+            ThrowIfFailed(ds->FillRectangleAtCoordsWithColor(0, 0, 1, 1, ArbitraryMarkerColor1));
+        }
+
+        Assert::IsNotNull(brushFromFirstSession);
+        Assert::AreEqual(brushFromFirstSession, brushFromSecondSession);
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_WhenInteropSessionGainsDevice_PrivateBrushIsNotReusedForADifferentColor)
+    {
+        Fixture f;
+        f.DeviceContext->GetDeviceMethod.SetExpectedCalls(1, [](ID2D1Device** d2dDevice) { Make<StubD2DDevice>().CopyTo(d2dDevice); });
+
+        auto privateBrush = Make<MockD2DSolidColorBrush>();
+        f.DeviceContext->CreateSolidColorBrushMethod.SetExpectedCalls(1,
+            [&](D2D1_COLOR_F const*, D2D1_BRUSH_PROPERTIES const*, ID2D1SolidColorBrush** brush)
+            {
+                return privateBrush.CopyTo(brush);
+            });
+
+        auto manager = std::make_shared<CanvasDrawingSessionManager>();
+        auto ds = manager->Create(nullptr, f.DeviceContext.Get(), std::make_shared<StubCanvasDrawingSessionAdapter>());
+
+        std::vector<ID2D1Brush*> usedBrushes;
+        f.DeviceContext->FillRectangleMethod.AllowAnyCall([&](D2D1_RECT_F const*, ID2D1Brush* brush) { usedBrushes.push_back(brush); });
+
+        ThrowIfFailed(ds->FillRectangleAtCoordsWithColor(0, 0, 1, 1, ArbitraryMarkerColor1));
+
+        // This gives the session an owner, so further brushes come from the pool
+        ComPtr<ICanvasDevice> device;
+        ThrowIfFailed(ds->get_Device(&device));
+
+        ThrowIfFailed(ds->FillRectangleAtCoordsWithColor(0, 0, 1, 1, Color{ 0, 0, 0, 0 }));
+
+        Assert::AreEqual<size_t>(2, usedBrushes.size());
+        Assert::IsTrue(IsSameInstance(privateBrush.Get(), usedBrushes[0]));
+        Assert::IsFalse(IsSameInstance(privateBrush.Get(), usedBrushes[1]));
+    }
+};
+
+TEST_CLASS(CanvasDrawingSession_TextLayoutCacheTests)
+{
+    struct Fixture
+    {
+        ComPtr<StubD2DDeviceContextWithGetFactory> DeviceContext;
+        ComPtr<StubCanvasDevice> Device;
+        TextLayoutCache Cache;
+        std::shared_ptr<StubCanvasTextFormatAdapterWithDWriteFactory> Adapter;
+        ComPtr<CanvasTextFormat> Format;
+        ComPtr<CanvasDrawingSession> DS;
+
+        Fixture()
+            : DeviceContext(Make<StubD2DDeviceContextWithGetFactory>())
+            , Device(Make<StubCanvasDevice>())
+            , Adapter(std::make_shared<StubCanvasTextFormatAdapterWithDWriteFactory>())
+        {
+            Device->GetSolidColorBrushMethod.AllowAnyCall(
+                [](Color const&)
+                {
+                    return Make<MockD2DSolidColorBrush>();
+                });
+
+            Device->GetTextLayoutCacheMethod.AllowAnyCall(
+                [this]
+                {
+                    return &Cache;
+                });
+
+            Format = std::make_shared<CanvasTextFormatManager>(Adapter)->Create();
+
+            auto manager = std::make_shared<CanvasDrawingSessionManager>();
+            DS = manager->Create(Device.Get(), DeviceContext.Get(), std::make_shared<StubCanvasDrawingSessionAdapter>());
+        }
+
+        void DrawText(wchar_t const* text)
+        {
+            ThrowIfFailed(DS->DrawTextAtRectWithColorAndFormat(WinString(text), Rect{ 1, 2, 30, 40 }, ArbitraryMarkerColor1, Format.Get()));
+        }
+    };
+
+    TEST_METHOD_EX(CanvasDrawingSession_TextLayoutCache_WhenDisabled_DrawTextIsUsed)
+    {
+        Fixture f;
+
+        f.Adapter->DWriteFactory->CreateTextLayoutMethod.SetExpectedCalls(0);
+        f.DeviceContext->DrawTextLayoutMethod.SetExpectedCalls(0);
+        f.DeviceContext->DrawTextMethod.SetExpectedCalls(2);
+
+        f.DrawText(L"text");
+        f.DrawText(L"text");
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_TextLayoutCache_WhenEnabled_RepeatedDrawsDoNotCreateTextLayouts)
+    {
+        Fixture f;
+        f.Cache.SetLimits(16, TextLayoutCache::DefaultMaximumCharacterCount);
+
+        ThrowIfFailed(f.Format->put_Options(CanvasDrawTextOptions::Clip));
+        auto realizedFormat = f.Format->GetRealizedTextFormat();
+
+        auto layout = Make<MockDWriteTextLayout>();
+
+        f.Adapter->DWriteFactory->CreateTextLayoutMethod.SetExpectedCalls(1,
+            [&](WCHAR const* text, UINT32 textLength, IDWriteTextFormat* format, FLOAT maxWidth, FLOAT maxHeight, IDWriteTextLayout** textLayout)
+            {
+                Assert::AreEqual(L"Score", std::wstring(text, textLength).c_str());
+                Assert::IsTrue(IsSameInstance(realizedFormat.Get(), format));
+                Assert::AreEqual(30.0f, maxWidth);
+                Assert::AreEqual(40.0f, maxHeight);
+                return layout.CopyTo(textLayout);
+            });
+
+        const int drawCount = 100;
+
+        f.DeviceContext->DrawTextMethod.SetExpectedCalls(0);
+        f.DeviceContext->DrawTextLayoutMethod.SetExpectedCalls(drawCount,
+            [&](D2D1_POINT_2F point, IDWriteTextLayout* textLayout, ID2D1Brush*, D2D1_DRAW_TEXT_OPTIONS options)
+            {
+                Assert::AreEqual(1.0f, point.x);
+                Assert::AreEqual(2.0f, point.y);
+                Assert::IsTrue(IsSameInstance(layout.Get(), textLayout));
+                Assert::AreEqual(D2D1_DRAW_TEXT_OPTIONS_CLIP, options);
+            });
+
+        for (int i = 0; i < drawCount; i++)
+        {
+            f.DrawText(L"Score");
+        }
+
+        Assert::AreEqual(static_cast<uint32_t>(drawCount - 1), static_cast<uint32_t>(f.Cache.GetHitCount()));
+        Assert::AreEqual(1U, static_cast<uint32_t>(f.Cache.GetMissCount()));
+    }
+
+    TEST_METHOD_EX(CanvasDrawingSession_TextLayoutCache_WhenFormatChanges_NewTextLayoutIsCreated)
+    {
+        Fixture f;
+        f.Cache.SetLimits(16, TextLayoutCache::DefaultMaximumCharacterCount);
+
+        f.Adapter->DWriteFactory->CreateTextLayoutMethod.SetExpectedCalls(2,
+            [](WCHAR const*, UINT32, IDWriteTextFormat*, FLOAT, FLOAT, IDWriteTextLayout** textLayout)
+            {
+                return Make<MockDWriteTextLayout>().CopyTo(textLayout);
+            });
+
+        f.DeviceContext->DrawTextLayoutMethod.SetExpectedCalls(3);
+
+        f.DrawText(L"text");
+        f.DrawText(L"text");
+
+        // Text alignment is changed on the realized format in place, so the
+        // previously cached layout must not be used.
+        auto realizedFormat = f.Format->GetRealizedTextFormat();
+        ThrowIfFailed(f.Format->put_HorizontalAlignment(CanvasHorizontalAlignment::Center));
+        Assert::IsTrue(IsSameInstance(realizedFormat.Get(), f.Format->GetRealizedTextFormat().Get()));
+
+        f.DrawText(L"text");
+    }
+};
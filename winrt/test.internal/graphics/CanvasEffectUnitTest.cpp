@@ -465,6 +465,206 @@ public:
         }
     }
 
+    TEST_METHOD_EX(CanvasEffect_SettingUnchangedPropertyValue_DoesNotReSetD2DProperty)
+    {
+        Fixture f;
+
+        std::vector<ComPtr<MockD2DEffectThatCountsCalls>> mockEffects;
+        f.m_deviceContext->CreateEffectMethod.AllowAnyCall(
+            [&](IID const&, ID2D1Effect** effect)
+            {
+                mockEffects.push_back(Make<MockD2DEffectThatCountsCalls>());
+                return mockEffects.back().CopyTo(effect);
+            });
+
+        f.m_deviceContext->DrawImageMethod.AllowAnyCall();
+
+        auto testEffect = Make<TestEffect>(m_blurGuid, 2, 0, true);
+
+        testEffect->SetFloatProperty(0, 1);
+        testEffect->SetVectorProperty(1, Numerics::Vector4{ 1, 2, 3, 4 });
+
+        ThrowIfFailed(f.m_drawingSession->DrawImageAtOrigin(testEffect.Get()));
+        CheckCallCount(mockEffects, 1, { 0 }, { 2 });
+
+        // Storing the same values again is not a change.
+        testEffect->SetFloatProperty(0, 1);
+        testEffect->SetVectorProperty(1, Numerics::Vector4{ 1, 2, 3, 4 });
+
+        ThrowIfFailed(f.m_drawingSession->DrawImageAtOrigin(testEffect.Get()));
+        CheckCallCount(mockEffects, 1, { 0 }, { 2 });
+
+        // Changing one component of the vector only re-sets that property.
+        testEffect->SetVectorProperty(1, Numerics::Vector4{ 1, 2, 3, 5 });
+
+        ThrowIfFailed(f.m_drawingSession->DrawImageAtOrigin(testEffect.Get()));
+        CheckCallCount(mockEffects, 1, { 0 }, { 3 });
+
+        float expectedVector[] = { 1, 2, 3, 5 };
+        Assert::AreEqual(sizeof(expectedVector), mockEffects[0]->m_properties[1].size());
+        Assert::AreEqual(0, memcmp(expectedVector, mockEffects[0]->m_properties[1].data(), sizeof(expectedVector)));
+
+        // Changing a value and then changing it back before drawing still counts as a change.
+        testEffect->SetFloatProperty(0, 2);
+        testEffect->SetFloatProperty(0, 1);
+
+        ThrowIfFailed(f.m_drawingSession->DrawImageAtOrigin(testEffect.Get()));
+        CheckCallCount(mockEffects, 1, { 0 }, { 4 });
+    }
+
+    TEST_METHOD_EX(CanvasEffect_AnimatingOnePropertyOfLargeGraph_OnlySetsThatProperty)
+    {
+        Fixture f;
+
+        const int effectCount = 64;
+        const unsigned propertyCount = 16;
+        const int animatedEffect = effectCount / 2;
+        const unsigned animatedProperty = 5;
+        const int frameCount = 100;
+
+        std::vector<ComPtr<MockD2DEffectThatCountsCalls>> mockEffects;
+        f.m_deviceContext->CreateEffectMethod.AllowAnyCall(
+            [&](IID const&, ID2D1Effect** effect)
+            {
+                mockEffects.push_back(Make<MockD2DEffectThatCountsCalls>());
+                return mockEffects.back().CopyTo(effect);
+            });
+
+        f.m_deviceContext->DrawImageMethod.AllowAnyCall();
+
+        // Build a chain of effects, each with a mixture of scalar and array properties.
+        std::vector<ComPtr<TestEffect>> testEffects;
+
+        for (int i = 0; i < effectCount; i++)
+        {
+            auto testEffect = Make<TestEffect>(m_blurGuid, propertyCount, 1, true);
+
+            for (unsigned j = 0; j < propertyCount; j++)
+            {
+                if (j % 2)
+                    testEffect->SetVectorProperty(j, Numerics::Vector4{ 0, 0, 0, static_cast<float>(j) });
+                else
+                    testEffect->SetFloatProperty(j, static_cast<float>(j));
+            }
+
+            if (!testEffects.empty())
+                ThrowIfFailed(testEffects.back()->put_Source(testEffect.Get()));
+
+            testEffects.push_back(testEffect);
+        }
+
+        ThrowIfFailed(testEffects.back()->put_Source(CreateStubCanvasBitmap().Get()));
+
+        // The first draw sets every property.
+        ThrowIfFailed(f.m_drawingSession->DrawImageAtOrigin(testEffects[0].Get()));
+
+        Assert::AreEqual<size_t>(effectCount, mockEffects.size());
+
+        for (auto& mockEffect : mockEffects)
+        {
+            Assert::AreEqual<int>(propertyCount, mockEffect->m_setValueCalls);
+            mockEffect->m_setValueCalls = 0;
+        }
+
+        // Animate a single property, in the style of a per-frame update.
+        auto& animatedMockEffect = mockEffects[animatedEffect];
+        animatedMockEffect->MockSetValue =
+            [&](UINT32 index, D2D1_PROPERTY_TYPE, CONST BYTE*, UINT32 dataSize)
+            {
+                Assert::AreEqual(animatedProperty, index);
+                Assert::AreEqual<size_t>(sizeof(Numerics::Vector4), dataSize);
+                animatedMockEffect->m_setValueCalls++;
+                return S_OK;
+            };
+
+        for (int frame = 0; frame < frameCount; frame++)
+        {
+            testEffects[animatedEffect]->SetVectorProperty(animatedProperty, Numerics::Vector4{ static_cast<float>(frame), 0, 0, 1 });
+
+            ThrowIfFailed(f.m_drawingSession->DrawImageAtOrigin(testEffects[0].Get()));
+        }
+
+        for (int i = 0; i < effectCount; i++)
+        {
+            Assert::AreEqual(i == animatedEffect ? frameCount : 0, mockEffects[i]->m_setValueCalls);
+        }
+    }
+
+    TEST_METHOD_EX(CanvasEffect_WhenD2DEffectIsRecreated_AllPropertiesAreSet)
+    {
+        Fixture f;
+
+        std::vector<ComPtr<MockD2DEffectThatCountsCalls>> mockEffects;
+        auto createCountingEffect =
+            [&](IID const&, ID2D1Effect** effect)
+            {
+                mockEffects.push_back(Make<MockD2DEffectThatCountsCalls>());
+                return mockEffects.back().CopyTo(effect);
+            };
+
+        f.m_deviceContext->CreateEffectMethod.AllowAnyCall(createCountingEffect);
+        f.m_deviceContext->DrawImageMethod.AllowAnyCall();
+
+        auto testEffect = Make<TestEffect>(m_blurGuid, 3, 0, true);
+
+        for (unsigned i = 0; i < 3; i++)
+            testEffect->SetFloatProperty(i, static_cast<float>(i));
+
+        ThrowIfFailed(f.m_drawingSession->DrawImageAtOrigin(testEffect.Get()));
+        CheckCallCount(mockEffects, 1, { 0 }, { 3 });
+
+        testEffect->SetFloatProperty(1, 23);
+
+        // Drawing on a different device recreates the D2D effect, which needs every property.
+        auto deviceContext2 = f.MakeDeviceContext();
+        auto drawingSession2 = f.m_drawingSessionManager->Create(deviceContext2.Get(), std::make_shared<StubCanvasDrawingSessionAdapter>());
+        auto stubDevice2 = Make<StubD2DDevice>();
+
+        deviceContext2->GetDeviceMethod.AllowAnyCallAlwaysCopyValueToParam(stubDevice2);
+        deviceContext2->CreateEffectMethod.AllowAnyCall(createCountingEffect);
+        deviceContext2->DrawImageMethod.AllowAnyCall();
+
+        ThrowIfFailed(drawingSession2->DrawImageAtOrigin(testEffect.Get()));
+        CheckCallCount(mockEffects, 2, { 0, 0 }, { 3, 3 });
+
+        float expectedValue = 23;
+        Assert::AreEqual(0, memcmp(&expectedValue, mockEffects[1]->m_properties[1].data(), sizeof(float)));
+    }
+
+    TEST_METHOD_EX(CanvasEffect_GetProperty_BoxesStoredValues)
+    {
+        auto testEffect = Make<TestEffect>(m_blurGuid, 3, 0, true);
+
+        testEffect->SetFloatProperty(0, 42);
+        testEffect->SetVectorProperty(1, Numerics::Vector4{ 1, 2, 3, 4 });
+
+        ComPtr<IPropertyValue> propertyValue;
+        PropertyType propertyType;
+
+        ThrowIfFailed(testEffect->GetProperty(0, &propertyValue));
+        ThrowIfFailed(propertyValue->get_Type(&propertyType));
+        Assert::IsTrue(propertyType == PropertyType_Single);
+
+        float floatValue;
+        ThrowIfFailed(propertyValue->GetSingle(&floatValue));
+        Assert::AreEqual(42.0f, floatValue);
+
+        ThrowIfFailed(testEffect->GetProperty(1, &propertyValue));
+        ThrowIfFailed(propertyValue->get_Type(&propertyType));
+        Assert::IsTrue(propertyType == PropertyType_SingleArray);
+
+        ComArray<float> arrayValue;
+        ThrowIfFailed(propertyValue->GetSingleArray(arrayValue.GetAddressOfSize(), arrayValue.GetAddressOfData()));
+        Assert::AreEqual(4u, arrayValue.GetSize());
+        Assert::AreEqual(4.0f, arrayValue[3]);
+
+        // Unset properties are reported as null.
+        ThrowIfFailed(testEffect->GetProperty(2, &propertyValue));
+        Assert::IsNull(propertyValue.Get());
+
+        Assert::AreEqual(E_BOUNDS, testEffect->GetProperty(3, &propertyValue));
+    }
+
     TEST_METHOD_EX(CanvasEffect_DpiCompensation)
     {
         Fixture f;
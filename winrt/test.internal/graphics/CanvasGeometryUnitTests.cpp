@@ -20,6 +20,7 @@
 #include "mocks/MockD2DTransformedGeometry.h"
 #include "mocks/MockD2DGeometryGroup.h"
 #include "stubs/StubGeometrySink.h"
+#include "stubs/StubTessellationReceiver.h"
 
 static const D2D1_MATRIX_3X2_F sc_someD2DTransform = { 1, 2, 3, 4, 5, 6 };
 static const D2D1_MATRIX_3X2_F sc_identityD2DTransform = { 1, 0, 0, 1, 0, 0 };
@@ -29,6 +30,50 @@ static const D2D1_TRIANGLE sc_triangle1 = { { 1, 2 }, { 3, 4 }, { 5, 6 } };
 static const D2D1_TRIANGLE sc_triangle2 = { { 7, 8 }, { 9, 10 }, { 11, 12 } };
 static const D2D1_TRIANGLE sc_triangle3 = { { 13, 14 }, { 15, 16 }, { 17, 18 } };
 
+#ifdef _DEBUG
+
+// Counts CRT heap allocations made while an AllocationCounter is in scope.
+class AllocationCounter
+{
+    static int s_allocationCount;
+    static size_t s_allocatedBytes;
+
+    _CRT_ALLOC_HOOK m_previousHook;
+
+public:
+    AllocationCounter()
+    {
+        s_allocationCount = 0;
+        s_allocatedBytes = 0;
+        m_previousHook = _CrtSetAllocHook(AllocHook);
+    }
+
+    ~AllocationCounter()
+    {
+        _CrtSetAllocHook(m_previousHook);
+    }
+
+    int GetAllocationCount() const { return s_allocationCount; }
+    size_t GetAllocatedBytes() const { return s_allocatedBytes; }
+
+private:
+    static int __cdecl AllocHook(int allocType, void*, size_t size, int, long, unsigned char const*, int)
+    {
+        if (allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC)
+        {
+            s_allocationCount++;
+            s_allocatedBytes += size;
+        }
+
+        return TRUE;
+    }
+};
+
+int AllocationCounter::s_allocationCount;
+size_t AllocationCounter::s_allocatedBytes;
+
+#endif
+
 
 TEST_CLASS(CanvasGeometryTests)
 {
@@ -1142,6 +1187,18 @@ public:
 
     struct TessellateFixture : public GeometryOperationsFixture_DoesNotOutputToTempPathBuilder
     {
+        TessellationCache Cache;
+
+        TessellateFixture()
+        {
+            Device->GetTessellationCacheMethod.AllowAnyCall([this] { return &Cache; });
+        }
+
+        void EnableTessellationCache(size_t maximumByteCount = 1024 * 1024)
+        {
+            Cache.SetMaximumByteCount(maximumByteCount);
+        }
+
         void ExpectOneTessellateCall(D2D1_MATRIX_3X2_F expectedTransform, float expectedFlatteningTolerance)
         {
             D2DRectangleGeometry->TessellateMethod.SetExpectedCalls(1,
@@ -1164,6 +1221,41 @@ public:
                 });
         }
 
+        int TessellateCallCount = 0;
+
+        void AllowAnyTessellateCalls()
+        {
+            D2DRectangleGeometry->TessellateMethod.AllowAnyCall(
+                [=](D2D1_MATRIX_3X2_F const*, float, ID2D1TessellationSink* sink)
+                {
+                    TessellateCallCount++;
+                    sink->AddTriangles(&sc_triangle1, 1);
+                    return S_OK;
+                });
+        }
+
+        void Tessellate(Matrix3x2 const& transform, float flatteningTolerance)
+        {
+            ComArray<CanvasTriangleVertices> triangles;
+            ThrowIfFailed(RectangleGeometry->TessellateWithTransformAndFlatteningTolerance(transform, flatteningTolerance, triangles.GetAddressOfSize(), triangles.GetAddressOfData()));
+        }
+
+        void ExpectManyTessellatedTriangles(uint32_t triangleCount, uint32_t batchSize)
+        {
+            D2DRectangleGeometry->TessellateMethod.AllowAnyCall(
+                [=](D2D1_MATRIX_3X2_F const*, float, ID2D1TessellationSink* sink)
+                {
+                    std::vector<D2D1_TRIANGLE> batch(batchSize, sc_triangle1);
+
+                    for (uint32_t i = 0; i < triangleCount; i += batchSize)
+                    {
+                        sink->AddTriangles(batch.data(), std::min(batchSize, triangleCount - i));
+                    }
+
+                    return S_OK;
+                });
+        }
+
         void ValidateTessellatedTriangles(ComArray<CanvasTriangleVertices>& triangles)
         {
             Assert::AreEqual(3u, triangles.GetSize());
@@ -1212,6 +1304,385 @@ public:
         Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->TessellateWithTransformAndFlatteningTolerance(Matrix3x2{}, 0, t.GetAddressOfSize(), nullptr));
     }
 
+    TEST_METHOD_EX(CanvasGeometry_Tessellate_WhenCacheIsDisabled_TessellatesEveryCall)
+    {
+        TessellateFixture f;
+        f.AllowAnyTessellateCalls();
+
+        for (int i = 0; i < 3; i++)
+        {
+            f.Tessellate(sc_someTransform, 1);
+        }
+
+        Assert::AreEqual(3, f.TessellateCallCount);
+        Assert::AreEqual<size_t>(0, f.Cache.GetEntryCount());
+        Assert::AreEqual(0u, static_cast<uint32_t>(f.Cache.GetMissCount()));
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_Tessellate_RepeatedCallsAreCached)
+    {
+        TessellateFixture f;
+        f.EnableTessellationCache();
+
+        f.ExpectOneTessellateCall(sc_someD2DTransform, 23);
+
+        for (int i = 0; i < 3; i++)
+        {
+            ComArray<CanvasTriangleVertices> triangles;
+            ThrowIfFailed(f.RectangleGeometry->TessellateWithTransformAndFlatteningTolerance(sc_someTransform, 23, triangles.GetAddressOfSize(), triangles.GetAddressOfData()));
+            f.ValidateTessellatedTriangles(triangles);
+        }
+
+        Assert::AreEqual(2u, static_cast<uint32_t>(f.Cache.GetHitCount()));
+        Assert::AreEqual(1u, static_cast<uint32_t>(f.Cache.GetMissCount()));
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_Tessellate_DifferentTransformOrToleranceIsNotCached)
+    {
+        TessellateFixture f;
+        f.EnableTessellationCache();
+        f.AllowAnyTessellateCalls();
+
+        const Matrix3x2 identity = { 1, 0, 0, 1, 0, 0 };
+
+        f.Tessellate(sc_someTransform, 1);
+        f.Tessellate(sc_someTransform, 2);
+        f.Tessellate(identity, 1);
+
+        Assert::AreEqual(3, f.TessellateCallCount);
+
+        f.Tessellate(sc_someTransform, 2);
+        f.Tessellate(identity, 1);
+        f.Tessellate(sc_someTransform, 1);
+
+        Assert::AreEqual(3, f.TessellateCallCount);
+
+        Assert::AreEqual(3u, static_cast<uint32_t>(f.Cache.GetHitCount()));
+        Assert::AreEqual(3u, static_cast<uint32_t>(f.Cache.GetMissCount()));
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_Tessellate_DifferentGeometriesAreNotShared)
+    {
+        TessellateFixture f;
+        f.EnableTessellationCache();
+        f.AllowAnyTessellateCalls();
+
+        int ellipseTessellateCallCount = 0;
+
+        f.D2DEllipseGeometry->TessellateMethod.AllowAnyCall(
+            [&](D2D1_MATRIX_3X2_F const*, float, ID2D1TessellationSink* sink)
+            {
+                ellipseTessellateCallCount++;
+                sink->AddTriangles(&sc_triangle2, 1);
+                return S_OK;
+            });
+
+        ComArray<CanvasTriangleVertices> triangles;
+        ThrowIfFailed(f.RectangleGeometry->TessellateWithTransformAndFlatteningTolerance(sc_someTransform, 1, triangles.GetAddressOfSize(), triangles.GetAddressOfData()));
+        ThrowIfFailed(f.EllipseGeometry->TessellateWithTransformAndFlatteningTolerance(sc_someTransform, 1, triangles.GetAddressOfSize(), triangles.GetAddressOfData()));
+
+        Assert::AreEqual(1, f.TessellateCallCount);
+        Assert::AreEqual(1, ellipseTessellateCallCount);
+        Assert::AreEqual(sc_triangle2, *ReinterpretAs<D2D1_TRIANGLE const*>(&triangles[0]));
+        Assert::AreEqual<size_t>(2, f.Cache.GetEntryCount());
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_Tessellate_CacheEvictsLeastRecentlyUsedToStayWithinByteBudget)
+    {
+        TessellateFixture f;
+        f.AllowAnyTessellateCalls();
+
+        // Each call produces one triangle.
+        const size_t entryByteCount = sizeof(CanvasTriangleVertices) + TessellationCache::EntryOverheadInBytes;
+        const int capacity = 4;
+
+        f.EnableTessellationCache(capacity * entryByteCount);
+
+        for (int i = 0; i < capacity; i++)
+        {
+            f.Tessellate(sc_someTransform, static_cast<float>(i));
+        }
+
+        Assert::AreEqual(capacity * entryByteCount, f.Cache.GetByteCount());
+
+        // Touch the oldest entry, so the second oldest is evicted instead.
+        f.Tessellate(sc_someTransform, 0);
+        f.Tessellate(sc_someTransform, static_cast<float>(capacity));
+
+        Assert::AreEqual(capacity + 1, f.TessellateCallCount);
+        Assert::AreEqual<size_t>(capacity, f.Cache.GetEntryCount());
+        Assert::AreEqual(capacity * entryByteCount, f.Cache.GetByteCount());
+
+        f.Tessellate(sc_someTransform, 0);
+        Assert::AreEqual(capacity + 1, f.TessellateCallCount);
+
+        f.Tessellate(sc_someTransform, 1);
+        Assert::AreEqual(capacity + 2, f.TessellateCallCount);
+
+        // Shrinking the budget evicts entries straight away.
+        f.Cache.SetMaximumByteCount(entryByteCount);
+        Assert::AreEqual<size_t>(1, f.Cache.GetEntryCount());
+        Assert::AreEqual(entryByteCount, f.Cache.GetByteCount());
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_Tessellate_WhenResultIsLargerThanBudget_ItIsNotCached)
+    {
+        TessellateFixture f;
+        f.EnableTessellationCache(TessellationCache::EntryOverheadInBytes + sizeof(CanvasTriangleVertices));
+
+        f.ExpectManyTessellatedTriangles(2, 2);
+
+        ComArray<CanvasTriangleVertices> triangles;
+        ThrowIfFailed(f.RectangleGeometry->TessellateWithTransformAndFlatteningTolerance(sc_someTransform, 1, triangles.GetAddressOfSize(), triangles.GetAddressOfData()));
+
+        Assert::AreEqual(2u, triangles.GetSize());
+        Assert::AreEqual<size_t>(0, f.Cache.GetEntryCount());
+        Assert::AreEqual<size_t>(0, f.Cache.GetByteCount());
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_Tessellate_TessellatesWithoutHoldingTheCacheLock)
+    {
+        TessellateFixture f;
+        f.EnableTessellationCache();
+
+        f.D2DRectangleGeometry->TessellateMethod.SetExpectedCalls(1,
+            [&](D2D1_MATRIX_3X2_F const*, float, ID2D1TessellationSink* sink)
+            {
+                // This would deadlock if the cache's lock was held.
+                Assert::AreEqual(1u, static_cast<uint32_t>(f.Cache.GetMissCount()));
+
+                sink->AddTriangles(&sc_triangle1, 1);
+                return S_OK;
+            });
+
+        f.Tessellate(sc_someTransform, 1);
+
+        Assert::AreEqual<size_t>(1, f.Cache.GetEntryCount());
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_Tessellate_CachedTrianglesOutliveEviction)
+    {
+        TessellateFixture f;
+        f.EnableTessellationCache();
+
+        auto triangles = f.Cache.GetTriangles(f.D2DRectangleGeometry.Get(), sc_someD2DTransform, 1,
+            [] { return TessellationCache::Triangles(1, *ReinterpretAs<CanvasTriangleVertices const*>(&sc_triangle2)); });
+
+        f.Cache.Clear();
+
+        Assert::AreEqual<size_t>(1, triangles->size());
+        Assert::AreEqual(sc_triangle2, *ReinterpretAs<D2D1_TRIANGLE const*>(&(*triangles)[0]));
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_Close_RemovesItsEntriesFromTessellationCache)
+    {
+        TessellateFixture f;
+        f.EnableTessellationCache();
+        f.AllowAnyTessellateCalls();
+
+        f.D2DEllipseGeometry->TessellateMethod.AllowAnyCall(
+            [](D2D1_MATRIX_3X2_F const*, float, ID2D1TessellationSink*) { return S_OK; });
+
+        f.Tessellate(sc_someTransform, 1);
+        f.Tessellate(sc_someTransform, 2);
+
+        ComArray<CanvasTriangleVertices> triangles;
+        ThrowIfFailed(f.EllipseGeometry->TessellateWithTransformAndFlatteningTolerance(sc_someTransform, 1, triangles.GetAddressOfSize(), triangles.GetAddressOfData()));
+
+        Assert::AreEqual<size_t>(3, f.Cache.GetEntryCount());
+
+        ThrowIfFailed(As<ABI::Windows::Foundation::IClosable>(f.RectangleGeometry)->Close());
+
+        Assert::AreEqual<size_t>(1, f.Cache.GetEntryCount());
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_GetTessellatedTriangleCount)
+    {
+        TessellateFixture f;
+
+        f.ExpectOneTessellateCall(sc_someD2DTransform, 23);
+
+        UINT32 count = 0;
+        ThrowIfFailed(f.RectangleGeometry->GetTessellatedTriangleCount(sc_someTransform, 23, &count));
+
+        Assert::AreEqual(3u, count);
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_TessellateIntoBuffer)
+    {
+        TessellateFixture f;
+        f.EnableTessellationCache();
+
+        f.ExpectOneTessellateCall(sc_someD2DTransform, 23);
+
+        CanvasTriangleVertices buffer[4] = {};
+        UINT32 written = 0;
+        ThrowIfFailed(f.RectangleGeometry->TessellateIntoBuffer(sc_someTransform, 23, _countof(buffer), buffer, &written));
+
+        Assert::AreEqual(3u, written);
+        Assert::AreEqual(sc_triangle1, *ReinterpretAs<D2D1_TRIANGLE const*>(&buffer[0]));
+        Assert::AreEqual(sc_triangle2, *ReinterpretAs<D2D1_TRIANGLE const*>(&buffer[1]));
+        Assert::AreEqual(sc_triangle3, *ReinterpretAs<D2D1_TRIANGLE const*>(&buffer[2]));
+
+        // Bypasses the tessellation cache.
+        Assert::AreEqual<size_t>(0, f.Cache.GetEntryCount());
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_TessellateIntoBuffer_WhenBufferTooSmall_Fails)
+    {
+        TessellateFixture f;
+
+        f.ExpectOneTessellateCall(sc_someD2DTransform, 23);
+
+        CanvasTriangleVertices buffer[2] = {};
+        UINT32 written = 123;
+
+        ExpectHResultException(E_INVALIDARG,
+            [&] { ThrowIfFailed(f.RectangleGeometry->TessellateIntoBuffer(sc_someTransform, 23, _countof(buffer), buffer, &written)); });
+
+        Assert::AreEqual(0u, written);
+
+        // Batches that fit are still copied; the one that overflowed is not.
+        Assert::AreEqual(sc_triangle1, *ReinterpretAs<D2D1_TRIANGLE const*>(&buffer[0]));
+        Assert::AreEqual(D2D1_TRIANGLE{}, *ReinterpretAs<D2D1_TRIANGLE const*>(&buffer[1]));
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_TessellateIntoBuffer_EmptyGeometry_AllowsNullBuffer)
+    {
+        TessellateFixture f;
+
+        f.D2DRectangleGeometry->TessellateMethod.SetExpectedCalls(1,
+            [](D2D1_MATRIX_3X2_F const*, float, ID2D1TessellationSink*) { return S_OK; });
+
+        UINT32 written = 123;
+        ThrowIfFailed(f.RectangleGeometry->TessellateIntoBuffer(sc_someTransform, 23, 0, nullptr, &written));
+
+        Assert::AreEqual(0u, written);
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_SendTessellationTo)
+    {
+        TessellateFixture f;
+
+        f.ExpectOneTessellateCall(sc_someD2DTransform, 23);
+
+        std::vector<CanvasTriangleVertices> received;
+        std::vector<UINT32> batchSizes;
+
+        auto receiver = Make<StubTessellationReceiver>();
+        receiver->AddTrianglesMethod.AllowAnyCall(
+            [&](UINT32 trianglesCount, CanvasTriangleVertices* triangles)
+            {
+                batchSizes.push_back(trianglesCount);
+                received.insert(received.end(), triangles, triangles + trianglesCount);
+                return S_OK;
+            });
+
+        ThrowIfFailed(f.RectangleGeometry->SendTessellationTo(sc_someTransform, 23, receiver.Get()));
+
+        Assert::AreEqual<size_t>(2, batchSizes.size());
+        Assert::AreEqual(1u, batchSizes[0]);
+        Assert::AreEqual(2u, batchSizes[1]);
+
+        Assert::AreEqual<size_t>(3, received.size());
+        Assert::AreEqual(sc_triangle1, *ReinterpretAs<D2D1_TRIANGLE const*>(&received[0]));
+        Assert::AreEqual(sc_triangle2, *ReinterpretAs<D2D1_TRIANGLE const*>(&received[1]));
+        Assert::AreEqual(sc_triangle3, *ReinterpretAs<D2D1_TRIANGLE const*>(&received[2]));
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_SendTessellationTo_ErrorIsPropagated)
+    {
+        TessellateFixture f;
+
+        f.ExpectOneTessellateCall(sc_someD2DTransform, 23);
+
+        auto receiver = Make<StubTessellationReceiver>();
+        receiver->AddTrianglesMethod.SetExpectedCalls(1,
+            [](UINT32, CanvasTriangleVertices*) { return E_FAIL; });
+
+        Assert::AreEqual(E_FAIL, f.RectangleGeometry->SendTessellationTo(sc_someTransform, 23, receiver.Get()));
+    }
+
+    TEST_METHOD_EX(CanvasGeometry_TessellateIntoBuffer_NullArgs)
+    {
+        GeometryOperationsFixture_DoesNotOutputToTempPathBuilder f;
+
+        CanvasTriangleVertices buffer[1];
+        UINT32 count;
+
+        Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->GetTessellatedTriangleCount(sc_someTransform, 0, nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->TessellateIntoBuffer(sc_someTransform, 0, 1, nullptr, &count));
+        Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->TessellateIntoBuffer(sc_someTransform, 0, 1, buffer, nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.RectangleGeometry->SendTessellationTo(sc_someTransform, 0, nullptr));
+    }
+
+#ifdef _DEBUG
+
+    TEST_METHOD_EX(CanvasGeometry_TessellateIntoBuffer_AllocationsDoNotDependOnTriangleCount)
+    {
+        const uint32_t batchSize = 256;
+        const uint32_t triangleCounts[] = { 1000, 100000 };
+
+        int bufferAllocationCounts[_countof(triangleCounts)];
+
+        for (int i = 0; i < _countof(triangleCounts); i++)
+        {
+            auto triangleCount = triangleCounts[i];
+
+            TessellateFixture f;
+            f.ExpectManyTessellatedTriangles(triangleCount, batchSize);
+
+            std::vector<CanvasTriangleVertices> buffer(triangleCount);
+            auto receiver = Make<StubTessellationReceiver>();
+            receiver->AddTrianglesMethod.AllowAnyCall([](UINT32, CanvasTriangleVertices*) { return S_OK; });
+
+            int allocationCounts[3];
+            size_t allocatedBytes[3];
+
+            {
+                AllocationCounter counter;
+                ComArray<CanvasTriangleVertices> triangles;
+                ThrowIfFailed(f.RectangleGeometry->TessellateWithTransformAndFlatteningTolerance(sc_someTransform, 1, triangles.GetAddressOfSize(), triangles.GetAddressOfData()));
+                allocationCounts[0] = counter.GetAllocationCount();
+                allocatedBytes[0] = counter.GetAllocatedBytes();
+            }
+
+            {
+                AllocationCounter counter;
+                UINT32 written;
+                ThrowIfFailed(f.RectangleGeometry->TessellateIntoBuffer(sc_someTransform, 2, triangleCount, buffer.data(), &written));
+                Assert::AreEqual(triangleCount, written);
+                allocationCounts[1] = counter.GetAllocationCount();
+                allocatedBytes[1] = counter.GetAllocatedBytes();
+            }
+
+            {
+                AllocationCounter counter;
+                ThrowIfFailed(f.RectangleGeometry->SendTessellationTo(sc_someTransform, 3, receiver.Get()));
+                allocationCounts[2] = counter.GetAllocationCount();
+                allocatedBytes[2] = counter.GetAllocatedBytes();
+            }
+
+            wchar_t message[256];
+            swprintf_s(message, L"%u triangles: Tessellate %d allocs / %Iu bytes, TessellateIntoBuffer %d allocs / %Iu bytes, SendTessellationTo %d allocs / %Iu bytes\n",
+                triangleCount,
+                allocationCounts[0], allocatedBytes[0],
+                allocationCounts[1], allocatedBytes[1],
+                allocationCounts[2], allocatedBytes[2]);
+            Logger::WriteMessage(message);
+
+            // Neither path should allocate anything that scales with the output.
+            Assert::IsTrue(allocatedBytes[1] < triangleCount * sizeof(CanvasTriangleVertices));
+            Assert::IsTrue(allocatedBytes[2] < triangleCount * sizeof(CanvasTriangleVertices));
+
+            bufferAllocationCounts[i] = allocationCounts[1];
+        }
+
+        Assert::AreEqual(bufferAllocationCounts[0], bufferAllocationCounts[1]);
+    }
+
+#endif
+
     TEST_METHOD_EX(CanvasGeometry_Closure)
     {
         GeometryOperationsFixture_DoesNotOutputToTempPathBuilder f;
@@ -1277,6 +1748,13 @@ public:
         Assert::AreEqual(RO_E_CLOSED, canvasGeometry->Tessellate(t.GetAddressOfSize(), t.GetAddressOfData()));
         Assert::AreEqual(RO_E_CLOSED, canvasGeometry->TessellateWithTransformAndFlatteningTolerance(m, 0, t.GetAddressOfSize(), t.GetAddressOfData()));
 
+        UINT32 count;
+        CanvasTriangleVertices buffer[1];
+        auto tessellationReceiver = Make<StubTessellationReceiver>();
+        Assert::AreEqual(RO_E_CLOSED, canvasGeometry->GetTessellatedTriangleCount(m, 0, &count));
+        Assert::AreEqual(RO_E_CLOSED, canvasGeometry->TessellateIntoBuffer(m, 0, 1, buffer, &count));
+        Assert::AreEqual(RO_E_CLOSED, canvasGeometry->SendTessellationTo(m, 0, tessellationReceiver.Get()));
+
         auto geometrySink = Make<StubGeometrySink>();
         Assert::AreEqual(RO_E_CLOSED, canvasGeometry->SendPathTo(geometrySink.Get()));
 
@@ -150,6 +150,83 @@ TEST_CLASS(CanvasRenderTargetTests)
         ThrowIfFailed(renderTarget->CreateDrawingSession(&drawingSession));
     }
 
+    TEST_METHOD_EX(CanvasRenderTarget_DrawingSessions_ReuseDeviceContextsFromDevicePool)
+    {
+        Fixture f;
+
+        DeviceContextPool pool;
+        int createCount = 0;
+
+        f.m_canvasDevice->CreateDeviceContextMethod.AllowAnyCall(
+            [&]
+            {
+                createCount++;
+
+                auto deviceContext = Make<StubD2DDeviceContext>(f.m_d2dDevice.Get());
+                deviceContext->SetDpiMethod.AllowAnyCall();
+                deviceContext->SetTransformMethod.AllowAnyCall();
+                deviceContext->SetAntialiasModeMethod.AllowAnyCall();
+                deviceContext->SetTextAntialiasModeMethod.AllowAnyCall();
+                deviceContext->SetPrimitiveBlendMethod.AllowAnyCall();
+                deviceContext->SetUnitModeMethod.AllowAnyCall();
+                deviceContext->SetTextRenderingParamsMethod.AllowAnyCall();
+                deviceContext->SetTagsMethod.AllowAnyCall();
+                deviceContext->SetRenderingControlsMethod.AllowAnyCall();
+                deviceContext->GetRenderingControlsMethod.AllowAnyCall();
+                return deviceContext;
+            });
+
+        f.m_canvasDevice->AcquirePooledDeviceContextMethod.AllowAnyCall(
+            [&]
+            {
+                return pool.Acquire([&] { return f.m_canvasDevice->CreateDeviceContext(); });
+            });
+
+        f.m_canvasDevice->ReleasePooledDeviceContextMethod.AllowAnyCall(
+            [&](ID2D1DeviceContext1* deviceContext)
+            {
+                pool.Release(deviceContext);
+            });
+
+        // Simulates a compositor that draws to each of its render targets
+        // every frame, with a few drawing sessions open at once.
+        const int renderTargetCount = 20;
+        const int frameCount = 10;
+        const int openAtOnce = 3;
+
+        std::vector<ComPtr<ID2D1Bitmap1>> bitmaps;
+        std::vector<ComPtr<CanvasRenderTarget>> renderTargets;
+
+        for (int i = 0; i < renderTargetCount; i++)
+        {
+            bitmaps.push_back(Make<StubD2DBitmap>(D2D1_BITMAP_OPTIONS_TARGET));
+            renderTargets.push_back(f.CreateRenderTarget(bitmaps.back()));
+        }
+
+        for (int frame = 0; frame < frameCount; frame++)
+        {
+            for (int i = 0; i < renderTargetCount; i += openAtOnce)
+            {
+                std::vector<ComPtr<ICanvasDrawingSession>> drawingSessions;
+
+                for (int j = i; j < (std::min)(i + openAtOnce, renderTargetCount); j++)
+                {
+                    ComPtr<ICanvasDrawingSession> drawingSession;
+                    ThrowIfFailed(renderTargets[j]->CreateDrawingSession(&drawingSession));
+
+                    ValidateDrawingSession(drawingSession.Get(), f.m_d2dDevice.Get(), bitmaps[j].Get());
+
+                    drawingSessions.push_back(drawingSession);
+                }
+
+                for (auto& drawingSession : drawingSessions)
+                    ThrowIfFailed(As<IClosable>(drawingSession)->Close());
+            }
+        }
+
+        Assert::AreEqual(openAtOnce, createCount);
+    }
+
     TEST_METHOD_EX(CanvasRenderTarget_Wrapped_CreatesDrawingSession)
     {
         Fixture f;
@@ -18,6 +18,8 @@
 #include "stubs/StubStorageFileStatics.h"
 #include "stubs/StubCanvasTextFormatAdapter.h"
 
+#include <thread>
+
 namespace canvas
 {
     std::shared_ptr<CanvasTextFormatManager> CreateTestManager()
@@ -773,27 +775,136 @@ namespace canvas
                 static_cast<CanvasDrawTextOptions>(999));
         }
 
-#undef TEST_SIMPLE_PROPERTY
-#undef SIMPLE_DWRITE_SETTER
-#undef SIMPLE_DWRITE_GETTER
-#undef SIMPLE_CANVAS_SETTER
-#undef SIMPLE_CANVAS_GETTER
+        TEST_METHOD_EX(CanvasTextFormat_GetRealizedNoWrapTextFormat_WhenWordWrappingIsNoWrap_ReturnsRealizedFormat)
+        {
+            auto ctf = CreateTestManager()->Create();
+            ThrowIfFailed(ctf->put_WordWrapping(CanvasWordWrapping::NoWrap));
+
+            auto dwf = ctf->GetRealizedTextFormat();
+            Assert::AreEqual(dwf.Get(), ctf->GetRealizedNoWrapTextFormat().Get());
+        }
 
-        class StubCanvasTextFormatAdapterWithDWriteFactory : public StubCanvasTextFormatAdapter
+        TEST_METHOD_EX(CanvasTextFormat_GetRealizedNoWrapTextFormat_ReturnsUnwrappedCopyOfRealizedFormat)
         {
-        public:
-            ComPtr<MockDWriteFactory> DWriteFactory;
+            auto ctf = CreateTestManager()->Create();
+            ThrowIfFailed(ctf->put_WordWrapping(CanvasWordWrapping::WholeWord));
+            ThrowIfFailed(ctf->put_FontFamily(WinString(L"Ariel")));
+            ThrowIfFailed(ctf->put_FontSize(123.0f));
+            ThrowIfFailed(ctf->put_FontStyle(ABI::Windows::UI::Text::FontStyle_Italic));
+            ThrowIfFailed(ctf->put_LocaleName(WinString(L"fr-FR")));
+            ThrowIfFailed(ctf->put_Direction(CanvasTextDirection::RightToLeftThenBottomToTop));
+            ThrowIfFailed(ctf->put_IncrementalTabStop(12.0f));
+            ThrowIfFailed(ctf->put_LineSpacing(5.0f));
+            ThrowIfFailed(ctf->put_LineSpacingBaseline(3.0f));
+            ThrowIfFailed(ctf->put_VerticalAlignment(CanvasVerticalAlignment::Bottom));
+            ThrowIfFailed(ctf->put_HorizontalAlignment(CanvasHorizontalAlignment::Right));
+            ThrowIfFailed(ctf->put_TrimmingGranularity(CanvasTextTrimmingGranularity::Word));
+
+            auto dwf = ctf->GetRealizedTextFormat();
+            auto noWrap = ctf->GetRealizedNoWrapTextFormat();
+
+            Assert::AreNotEqual(dwf.Get(), noWrap.Get());
+            Assert::AreEqual(DWRITE_WORD_WRAPPING_NO_WRAP, noWrap->GetWordWrapping());
+
+            Assert::AreEqual(L"Ariel", GetFontFamilyName(noWrap.Get()).c_str());
+
+            wchar_t localeName[16];
+            ThrowIfFailed(noWrap->GetLocaleName(localeName, _countof(localeName)));
+            Assert::AreEqual(L"fr-FR", localeName);
+            Assert::AreEqual(dwf->GetFontSize(), noWrap->GetFontSize());
+            Assert::AreEqual(dwf->GetFontStyle(), noWrap->GetFontStyle());
+            Assert::AreEqual(dwf->GetReadingDirection(), noWrap->GetReadingDirection());
+            Assert::AreEqual(dwf->GetFlowDirection(), noWrap->GetFlowDirection());
+            Assert::AreEqual(dwf->GetIncrementalTabStop(), noWrap->GetIncrementalTabStop());
+            Assert::AreEqual(dwf->GetParagraphAlignment(), noWrap->GetParagraphAlignment());
+            Assert::AreEqual(dwf->GetTextAlignment(), noWrap->GetTextAlignment());
+
+            DWriteLineSpacing expectedSpacing(dwf.Get());
+            DWriteLineSpacing actualSpacing(noWrap.Get());
+            Assert::AreEqual(expectedSpacing.Method, actualSpacing.Method);
+            Assert::AreEqual(expectedSpacing.Spacing, actualSpacing.Spacing);
+            Assert::AreEqual(expectedSpacing.Baseline, actualSpacing.Baseline);
+
+            Assert::AreEqual(DWriteTrimming(dwf.Get()).Options.granularity, DWriteTrimming(noWrap.Get()).Options.granularity);
+
+            // The caller-visible format is untouched.
+            Assert::AreEqual(DWRITE_WORD_WRAPPING_WHOLE_WORD, dwf->GetWordWrapping());
+
+            CanvasWordWrapping wordWrapping{};
+            ThrowIfFailed(ctf->get_WordWrapping(&wordWrapping));
+            Assert::AreEqual(CanvasWordWrapping::WholeWord, wordWrapping);
+
+            // The copy is reused.
+            Assert::AreEqual(noWrap.Get(), ctf->GetRealizedNoWrapTextFormat().Get());
+            Assert::AreEqual(dwf.Get(), ctf->GetRealizedTextFormat().Get());
+        }
+
+        TEST_METHOD_EX(CanvasTextFormat_GetRealizedNoWrapTextFormat_IsRecreatedWhenAPropertyChanges)
+        {
+            auto ctf = CreateTestManager()->Create();
+
+            auto noWrap = ctf->GetRealizedNoWrapTextFormat();
+
+            // Setting a property to its current value keeps the copy.
+            ThrowIfFailed(ctf->put_FontSize(noWrap->GetFontSize()));
+            Assert::AreEqual(noWrap.Get(), ctf->GetRealizedNoWrapTextFormat().Get());
+
+            // Properties that are realized in place still discard the copy,
+            // since the copy is never modified.
+            ThrowIfFailed(ctf->put_HorizontalAlignment(CanvasHorizontalAlignment::Center));
+            auto newNoWrap = ctf->GetRealizedNoWrapTextFormat();
+            Assert::AreNotEqual(noWrap.Get(), newNoWrap.Get());
+            Assert::AreEqual(DWRITE_TEXT_ALIGNMENT_CENTER, newNoWrap->GetTextAlignment());
+            Assert::AreEqual(DWRITE_TEXT_ALIGNMENT_LEADING, noWrap->GetTextAlignment());
+
+            // Properties that unrealize the format discard the copy.
+            ThrowIfFailed(ctf->put_FontSize(99.0f));
+            noWrap = ctf->GetRealizedNoWrapTextFormat();
+            Assert::AreNotEqual(newNoWrap.Get(), noWrap.Get());
+            Assert::AreEqual(99.0f, noWrap->GetFontSize());
+
+            // Switching to NoWrap makes the realized format usable directly.
+            ThrowIfFailed(ctf->put_WordWrapping(CanvasWordWrapping::NoWrap));
+            Assert::AreEqual(ctf->GetRealizedTextFormat().Get(), ctf->GetRealizedNoWrapTextFormat().Get());
+        }
 
-            StubCanvasTextFormatAdapterWithDWriteFactory()
-                : DWriteFactory(Make<MockDWriteFactory>())
+        TEST_METHOD_EX(CanvasTextFormat_GetRealizedNoWrapTextFormat_WhenCalledFromManyThreads_CreatesEachFormatOnce)
+        {
+            auto adapter = std::make_shared<StubCanvasTextFormatAdapterWithDWriteFactory>();
+            auto ctf = std::make_shared<CanvasTextFormatManager>(adapter)->Create();
+
+            // One for the realized format, and one for its no-wrap copy.
+            adapter->ExpectCreateTextFormat(2);
+
+            const int threadCount = 8;
+            std::vector<ComPtr<IDWriteTextFormat>> noWrapFormats(threadCount);
+            std::vector<std::thread> threads;
+
+            for (int i = 0; i < threadCount; i++)
             {
+                threads.emplace_back(
+                    [&, i]
+                    {
+                        noWrapFormats[i] = ctf->GetRealizedNoWrapTextFormat();
+                    });
             }
 
-            virtual ComPtr<IDWriteFactory> CreateDWriteFactory(DWRITE_FACTORY_TYPE type) override
+            for (auto& thread : threads)
             {
-                return DWriteFactory;
+                thread.join();
             }
-        };
+
+            for (auto& noWrapFormat : noWrapFormats)
+            {
+                Assert::AreEqual(noWrapFormats[0].Get(), noWrapFormat.Get());
+            }
+        }
+
+#undef TEST_SIMPLE_PROPERTY
+#undef SIMPLE_DWRITE_SETTER
+#undef SIMPLE_DWRITE_GETTER
+#undef SIMPLE_CANVAS_SETTER
+#undef SIMPLE_CANVAS_GETTER
 
         struct CustomFontFixture
         {
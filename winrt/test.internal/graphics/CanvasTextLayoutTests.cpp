@@ -25,6 +25,8 @@
 #include "stubs/TestBitmapResourceCreationAdapter.h"
 #include "stubs/TestEffect.h"
 
+#include <thread>
+
 namespace canvas
 {
     using namespace ABI::Windows::UI::Text;
@@ -190,6 +192,8 @@ namespace canvas
             CanvasTextLayoutRegion hitTestDesc{};
             Vector2 pt{};
             CanvasTextLayoutRegion* hitTestDescArr{};
+            CanvasTextLayoutHitTestResult* hitTestResultArr{};
+            Vector2* ptArr{};
             ComPtr<ICanvasBrush> canvasBrush;
             ComPtr<ICanvasDevice> canvasDevice;
 
@@ -296,6 +300,8 @@ namespace canvas
             Assert::AreEqual(RO_E_CLOSED, textLayout->GetCaretPosition(0, b, &pt));
             Assert::AreEqual(RO_E_CLOSED, textLayout->GetCaretPositionWithDescription(0, b, &hitTestDesc, &pt));
             Assert::AreEqual(RO_E_CLOSED, textLayout->GetCharacterRegions(0, 0, &u, &hitTestDescArr));
+            Assert::AreEqual(RO_E_CLOSED, textLayout->HitTestPoints(1, &pt, &u, &hitTestResultArr));
+            Assert::AreEqual(RO_E_CLOSED, textLayout->GetCaretPositions(1, &i, b, &u, &ptArr));
 
             Assert::AreEqual(RO_E_CLOSED, textLayout->GetBrush(0, &canvasBrush));
             Assert::AreEqual(RO_E_CLOSED, textLayout->SetBrush(0, 0, Make<StubCanvasBrush>().Get()));
@@ -313,6 +319,9 @@ namespace canvas
             INT32* arr;
             CanvasTextLayoutRegion hitTestDesc{};
             CanvasTextLayoutRegion* hitTestDescArr{};
+            CanvasTextLayoutHitTestResult* hitTestResultArr{};
+            Vector2* ptArr{};
+            uint32_t u{};
             boolean b{};
             Assert::AreEqual(E_INVALIDARG, textLayout->GetFormatChangeIndices(nullptr, &arr));
             Assert::AreEqual(E_INVALIDARG, textLayout->get_Direction(nullptr));
@@ -358,6 +367,12 @@ namespace canvas
             Assert::AreEqual(E_INVALIDARG, textLayout->GetCaretPosition(0, b, nullptr));
             Assert::AreEqual(E_INVALIDARG, textLayout->GetCaretPositionWithDescription(0, b, &hitTestDesc, nullptr));
             Assert::AreEqual(E_INVALIDARG, textLayout->GetCharacterRegions(0, 0, nullptr, &hitTestDescArr));
+            Assert::AreEqual(E_INVALIDARG, textLayout->HitTestPoints(1, nullptr, &u, &hitTestResultArr));
+            Assert::AreEqual(E_INVALIDARG, textLayout->HitTestPoints(0, nullptr, nullptr, &hitTestResultArr));
+            Assert::AreEqual(E_INVALIDARG, textLayout->HitTestPoints(0, nullptr, &u, nullptr));
+            Assert::AreEqual(E_INVALIDARG, textLayout->GetCaretPositions(1, nullptr, b, &u, &ptArr));
+            Assert::AreEqual(E_INVALIDARG, textLayout->GetCaretPositions(0, nullptr, b, nullptr, &ptArr));
+            Assert::AreEqual(E_INVALIDARG, textLayout->GetCaretPositions(0, nullptr, b, &u, nullptr));
             Assert::AreEqual(E_INVALIDARG, textLayout->GetBrush(0, nullptr));
             Assert::AreEqual(E_INVALIDARG, textLayout->get_Device(nullptr));
         }
@@ -429,6 +444,10 @@ namespace canvas
             Assert::AreEqual(E_INVALIDARG, textLayout->GetCharacterRegions(-1, 0, &u, &hitTestDescArr));
             Assert::AreEqual(E_INVALIDARG, textLayout->GetCharacterRegions(0, -1, &u, &hitTestDescArr));
 
+            INT32 negativeIndices[] = { 0, -1 };
+            Vector2* ptArr{};
+            Assert::AreEqual(E_INVALIDARG, textLayout->GetCaretPositions(2, negativeIndices, false, &u, &ptArr));
+
             ComPtr<ICanvasBrush> stubBrush = Make<StubCanvasBrush>();
             Assert::AreEqual(E_INVALIDARG, textLayout->GetBrush(-1, &stubBrush));
             Assert::AreEqual(E_INVALIDARG, textLayout->SetBrush(-1, 0, stubBrush.Get()));
@@ -1440,6 +1459,267 @@ namespace canvas
                 VerifyHitTestDescription(hitTestDescriptionArray[i], i);
         }
 
+        //
+        // Sets up a layout with a single line, whose left edge is at x=5, of
+        // three one-character clusters that are each 10 DIPs wide.
+        //
+        void SetupSimpleLineMetrics(Fixture& f, int* clusterMetricsCallCount = nullptr)
+        {
+            auto layout = f.Adapter->MockTextLayout;
+
+            layout->GetLineMetricsMethod.AllowAnyCall(
+                [](DWRITE_LINE_METRICS* lineMetrics, UINT32 maxCount, UINT32* actualCount)
+                {
+                    *actualCount = 1;
+                    if (maxCount < 1)
+                        return E_NOT_SUFFICIENT_BUFFER;
+
+                    lineMetrics[0] = DWRITE_LINE_METRICS{};
+                    lineMetrics[0].length = 3;
+                    return S_OK;
+                });
+
+            layout->GetClusterMetricsMethod.AllowAnyCall(
+                [=](DWRITE_CLUSTER_METRICS* clusterMetrics, UINT32 maxCount, UINT32* actualCount)
+                {
+                    if (clusterMetricsCallCount)
+                        ++(*clusterMetricsCallCount);
+
+                    *actualCount = 3;
+                    if (maxCount < 3)
+                        return E_NOT_SUFFICIENT_BUFFER;
+
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        clusterMetrics[i] = DWRITE_CLUSTER_METRICS{};
+                        clusterMetrics[i].width = 10;
+                        clusterMetrics[i].length = 1;
+                    }
+                    return S_OK;
+                });
+        }
+
+        static HRESULT GetLineStart(UINT32 textPosition, BOOL isTrailingHit, FLOAT* pointX, FLOAT* pointY, DWRITE_HIT_TEST_METRICS* hitTestMetrics)
+        {
+            Assert::AreEqual(0u, textPosition);
+            Assert::IsFalse(!!isTrailingHit);
+
+            *hitTestMetrics = DWRITE_HIT_TEST_METRICS{};
+            hitTestMetrics->left = 5;
+            hitTestMetrics->top = 2;
+            hitTestMetrics->width = 10;
+            hitTestMetrics->height = 20;
+            *pointX = 5;
+            *pointY = 2;
+            return S_OK;
+        }
+
+        TEST_METHOD_EX(CanvasTextLayoutTests_HitTestPoints_PointsInsideClustersAreAnsweredFromCachedMetrics)
+        {
+            Fixture f;
+            SetupSimpleLineMetrics(f);
+
+            f.Adapter->MockTextLayout->HitTestTextPositionMethod.SetExpectedCalls(1, GetLineStart);
+
+            // Only the point that misses the text needs to be passed to DirectWrite.
+            f.Adapter->MockTextLayout->HitTestPointMethod.SetExpectedCalls(1,
+                [&](FLOAT x, FLOAT y, BOOL* isTrailingHit, BOOL* isInside, DWRITE_HIT_TEST_METRICS* hitTestMetrics)
+                {
+                    Assert::AreEqual(100.0f, x);
+                    Assert::AreEqual(10.0f, y);
+                    *isTrailingHit = TRUE;
+                    *isInside = FALSE;
+                    WriteHitTestDescription(hitTestMetrics);
+                    return S_OK;
+                });
+
+            auto textLayout = f.CreateSimpleTextLayout();
+
+            Vector2 points[] = { { 8, 10 }, { 22, 10 }, { 100, 10 } };
+
+            uint32_t resultCount;
+            CanvasTextLayoutHitTestResult* results;
+            Assert::AreEqual(S_OK, textLayout->HitTestPoints(_countof(points), points, &resultCount, &results));
+            Assert::AreEqual(3u, resultCount);
+
+            Assert::AreEqual(0, results[0].Region.CharacterIndex);
+            Assert::AreEqual(1, results[0].Region.CharacterCount);
+            Assert::AreEqual(Rect{ 5, 2, 10, 20 }, results[0].Region.LayoutBounds);
+            Assert::IsFalse(!!results[0].IsTrailingSide);
+            Assert::IsTrue(!!results[0].IsHit);
+
+            Assert::AreEqual(1, results[1].Region.CharacterIndex);
+            Assert::AreEqual(Rect{ 15, 2, 10, 20 }, results[1].Region.LayoutBounds);
+            Assert::IsTrue(!!results[1].IsTrailingSide);
+            Assert::IsTrue(!!results[1].IsHit);
+
+            VerifyHitTestDescription(results[2].Region);
+            Assert::IsTrue(!!results[2].IsTrailingSide);
+            Assert::IsFalse(!!results[2].IsHit);
+
+            CoTaskMemFree(results);
+        }
+
+        TEST_METHOD_EX(CanvasTextLayoutTests_GetCaretPositions_CharactersInsideTheTextAreAnsweredFromCachedMetrics)
+        {
+            Fixture f;
+            SetupSimpleLineMetrics(f);
+
+            // The first call finds the start of the line; the second is for
+            // the index past the end of the text.
+            f.Adapter->MockTextLayout->HitTestTextPositionMethod.SetExpectedCalls(2,
+                [&](UINT32 textPosition, BOOL isTrailingHit, FLOAT* pointX, FLOAT* pointY, DWRITE_HIT_TEST_METRICS* hitTestMetrics)
+                {
+                    if (textPosition == 0)
+                        return GetLineStart(textPosition, isTrailingHit, pointX, pointY, hitTestMetrics);
+
+                    Assert::AreEqual(3u, textPosition);
+                    Assert::IsTrue(!!isTrailingHit);
+                    *pointX = 50;
+                    *pointY = 60;
+                    return S_OK;
+                });
+
+            auto textLayout = f.CreateSimpleTextLayout();
+
+            INT32 characterIndices[] = { 0, 2, 3 };
+
+            uint32_t locationCount;
+            Vector2* locations;
+            Assert::AreEqual(S_OK, textLayout->GetCaretPositions(_countof(characterIndices), characterIndices, true, &locationCount, &locations));
+            Assert::AreEqual(3u, locationCount);
+
+            Assert::AreEqual(Vector2{ 15, 2 }, locations[0]);
+            Assert::AreEqual(Vector2{ 35, 2 }, locations[1]);
+            Assert::AreEqual(Vector2{ 50, 60 }, locations[2]);
+
+            CoTaskMemFree(locations);
+        }
+
+        TEST_METHOD_EX(CanvasTextLayoutTests_HitTestPoints_CachedMetricsAreDiscardedWhenTheLayoutIsChanged)
+        {
+            Fixture f;
+
+            int clusterMetricsCallCount = 0;
+            SetupSimpleLineMetrics(f, &clusterMetricsCallCount);
+
+            f.Adapter->MockTextLayout->HitTestTextPositionMethod.AllowAnyCall(GetLineStart);
+            f.Adapter->MockTextLayout->SetFontSizeMethod.AllowAnyCall();
+
+            auto textLayout = f.CreateSimpleTextLayout();
+
+            Vector2 point{ 8, 10 };
+            INT32 characterIndex = 0;
+
+            uint32_t count;
+            CanvasTextLayoutHitTestResult* results;
+            Vector2* locations;
+
+            Assert::AreEqual(S_OK, textLayout->HitTestPoints(1, &point, &count, &results));
+            CoTaskMemFree(results);
+            Assert::AreEqual(S_OK, textLayout->GetCaretPositions(1, &characterIndex, false, &count, &locations));
+            CoTaskMemFree(locations);
+
+            // Two calls: one to get the count, and one to get the metrics.
+            Assert::AreEqual(2, clusterMetricsCallCount);
+
+            Assert::AreEqual(S_OK, textLayout->SetFontSize(0, 1, 20.0f));
+
+            Assert::AreEqual(S_OK, textLayout->HitTestPoints(1, &point, &count, &results));
+            CoTaskMemFree(results);
+
+            Assert::AreEqual(4, clusterMetricsCallCount);
+        }
+
+        TEST_METHOD_EX(CanvasTextLayoutTests_HitTestPoints_WhenCalledFromManyThreads_SharesOneCache)
+        {
+            Fixture f;
+
+            int clusterMetricsCallCount = 0;
+            SetupSimpleLineMetrics(f, &clusterMetricsCallCount);
+
+            f.Adapter->MockTextLayout->HitTestTextPositionMethod.SetExpectedCalls(1, GetLineStart);
+
+            auto textLayout = f.CreateSimpleTextLayout();
+
+            const int threadCount = 8;
+            const int iterationCount = 100;
+            std::vector<HRESULT> hrs(threadCount, S_OK);
+            std::vector<int> characterIndices(threadCount, -1);
+            std::vector<std::thread> threads;
+
+            for (int i = 0; i < threadCount; i++)
+            {
+                threads.emplace_back(
+                    [&, i]
+                    {
+                        // Each thread hits a different one of the three clusters.
+                        Vector2 point{ 8.0f + 10.0f * (i % 3), 10 };
+
+                        for (int j = 0; j < iterationCount && SUCCEEDED(hrs[i]); j++)
+                        {
+                            uint32_t resultCount;
+                            CanvasTextLayoutHitTestResult* results;
+                            hrs[i] = textLayout->HitTestPoints(1, &point, &resultCount, &results);
+
+                            if (SUCCEEDED(hrs[i]))
+                            {
+                                characterIndices[i] = results[0].Region.CharacterIndex;
+                                CoTaskMemFree(results);
+                            }
+                        }
+                    });
+            }
+
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+
+            for (int i = 0; i < threadCount; i++)
+            {
+                Assert::AreEqual(S_OK, hrs[i]);
+                Assert::AreEqual(i % 3, characterIndices[i]);
+            }
+
+            // The cache was built once, and then shared by every thread.
+            Assert::AreEqual(2, clusterMetricsCallCount);
+        }
+
+        TEST_METHOD_EX(CanvasTextLayoutTests_HitTestPoints_WhenTextIsRightToLeft_EveryPointIsPassedToDirectWrite)
+        {
+            Fixture f;
+
+            f.Adapter->MockTextLayout->GetReadingDirectionMethod.AllowAnyCall([] { return DWRITE_READING_DIRECTION_RIGHT_TO_LEFT; });
+            f.Adapter->MockTextLayout->GetClusterMetricsMethod.SetExpectedCalls(0);
+
+            f.Adapter->MockTextLayout->HitTestPointMethod.SetExpectedCalls(2,
+                [&](FLOAT x, FLOAT y, BOOL* isTrailingHit, BOOL* isInside, DWRITE_HIT_TEST_METRICS* hitTestMetrics)
+                {
+                    *isTrailingHit = FALSE;
+                    *isInside = TRUE;
+                    WriteHitTestDescription(hitTestMetrics, static_cast<uint32_t>(x));
+                    return S_OK;
+                });
+
+            auto textLayout = f.CreateSimpleTextLayout();
+
+            Vector2 points[] = { { 0, 0 }, { 1, 0 } };
+
+            uint32_t resultCount;
+            CanvasTextLayoutHitTestResult* results;
+            Assert::AreEqual(S_OK, textLayout->HitTestPoints(_countof(points), points, &resultCount, &results));
+            Assert::AreEqual(2u, resultCount);
+
+            for (uint32_t i = 0; i < resultCount; ++i)
+            {
+                VerifyHitTestDescription(results[i].Region, i);
+                Assert::IsTrue(!!results[i].IsHit);
+            }
+
+            CoTaskMemFree(results);
+        }
+
         TEST_METHOD_EX(CanvasTextLayoutTests_get_Device)
         {
             Fixture f;
@@ -1635,4 +1915,170 @@ namespace canvas
             CheckEffectTypeAndInput(f.MockEffects[1].Get(), CLSID_D2D1DpiCompensation, testBitmap.Get(), f.DeviceContext.Get(), dpi);
         }
     };
+
+    TEST_CLASS(CanvasTextLayout_MeasureTextsTests)
+    {
+    public:
+        struct Fixture
+        {
+            ComPtr<ICanvasTextFormat> Format;
+            std::shared_ptr<StubCanvasTextLayoutAdapter> Adapter;
+            std::shared_ptr<CanvasTextLayoutManager> LayoutManager;
+            std::vector<WinString> Strings;
+            std::vector<HSTRING> Texts;
+
+            Fixture()
+                : Adapter(std::make_shared<StubCanvasTextLayoutAdapter>())
+                , LayoutManager(std::make_shared<CanvasTextLayoutManager>(Adapter))
+            {
+                Format = std::make_shared<CanvasTextFormatManager>(std::make_shared<StubCanvasTextFormatAdapter>())->Create();
+            }
+
+            void AddTexts(int count)
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    Strings.push_back(WinString(std::wstring(i + 1, L'x')));
+                }
+
+                Texts.assign(Strings.begin(), Strings.end());
+            }
+
+            ComArray<CanvasTextMeasurement> MeasureTexts(unsigned maxThreadCount)
+            {
+                return LayoutManager->MeasureTexts(
+                    static_cast<uint32_t>(Texts.size()),
+                    Texts.data(),
+                    Format.Get(),
+                    123.0f,
+                    456.0f,
+                    maxThreadCount);
+            }
+        };
+
+        TEST_METHOD_EX(CanvasTextLayout_MeasureTexts_ReturnsMetricsOfEachText)
+        {
+            Fixture f;
+            f.AddTexts(3);
+
+            auto realizedFormat = GetWrappedResource<IDWriteTextFormat>(f.Format);
+
+            f.Adapter->GetMockDWriteFactory()->CreateTextLayoutMethod.SetExpectedCalls(3,
+                [&](WCHAR const* text, UINT32 textLength, IDWriteTextFormat* textFormat, FLOAT maxWidth, FLOAT maxHeight, IDWriteTextLayout** textLayout)
+                {
+                    Assert::AreEqual(std::wstring(textLength, L'x').c_str(), std::wstring(text, textLength).c_str());
+                    Assert::IsTrue(IsSameInstance(realizedFormat.Get(), textFormat));
+                    Assert::AreEqual(123.0f, maxWidth);
+                    Assert::AreEqual(456.0f, maxHeight);
+
+                    auto length = static_cast<float>(textLength);
+
+                    auto layout = Make<MockDWriteTextLayout>();
+
+                    layout->GetMetrics_BaseFormat_Method.AllowAnyCall(
+                        [=](DWRITE_TEXT_METRICS* metrics)
+                        {
+                            *metrics = DWRITE_TEXT_METRICS{};
+                            metrics->left = length;
+                            metrics->top = length * 2;
+                            metrics->width = length * 3;
+                            metrics->height = length * 4;
+                            metrics->lineCount = textLength * 5;
+                            return S_OK;
+                        });
+
+                    layout->DetermineMinWidthMethod.AllowAnyCall(
+                        [=](FLOAT* minWidth)
+                        {
+                            *minWidth = length * 6;
+                            return S_OK;
+                        });
+
+                    return layout.CopyTo(textLayout);
+                });
+
+            auto measurements = f.MeasureTexts(1);
+
+            Assert::AreEqual(3U, measurements.GetSize());
+
+            for (uint32_t i = 0; i < 3; i++)
+            {
+                float length = static_cast<float>(i + 1);
+
+                Assert::AreEqual(Rect{ length, length * 2, length * 3, length * 4 }, measurements[i].LayoutBounds);
+                Assert::AreEqual(static_cast<int32_t>(i + 1) * 5, measurements[i].LineCount);
+                Assert::AreEqual(length * 6, measurements[i].MinimumLineLength);
+            }
+        }
+
+        TEST_METHOD_EX(CanvasTextLayout_MeasureTexts_WhenNoTexts_ReturnsEmptyArray)
+        {
+            Fixture f;
+
+            f.Adapter->GetMockDWriteFactory()->CreateTextLayoutMethod.SetExpectedCalls(0);
+
+            auto measurements = f.MeasureTexts(1);
+
+            Assert::AreEqual(0U, measurements.GetSize());
+        }
+
+        TEST_METHOD_EX(CanvasTextLayout_MeasureTexts_WhenMeasuringFails_ErrorIsReturned)
+        {
+            Fixture f;
+            f.AddTexts(200);
+
+            f.Adapter->GetMockDWriteFactory()->CreateTextLayoutMethod.AllowAnyCall(
+                [](WCHAR const*, UINT32, IDWriteTextFormat*, FLOAT, FLOAT, IDWriteTextLayout**)
+                {
+                    return E_OUTOFMEMORY;
+                });
+
+            ExpectHResultException(E_OUTOFMEMORY, [&] { f.MeasureTexts(1); });
+        }
+
+        TEST_METHOD_EX(CanvasTextLayout_MeasureTexts_OnManyThreads_MatchesCanvasTextLayout)
+        {
+            // This uses a real DirectWrite factory, since the mocks are not
+            // thread safe.
+            auto layoutManager = std::make_shared<CanvasTextLayoutManager>(std::make_shared<StubCanvasTextFormatAdapter>());
+            auto device = Make<StubCanvasDevice>();
+
+            auto format = std::make_shared<CanvasTextFormatManager>(std::make_shared<StubCanvasTextFormatAdapter>())->Create();
+
+            std::vector<WinString> strings;
+
+            for (int i = 0; i < 500; i++)
+            {
+                strings.push_back(WinString(L"Row " + std::to_wstring(i) + std::wstring(i % 40, L' ') + L"some wrapping text"));
+            }
+
+            std::vector<HSTRING> texts(strings.begin(), strings.end());
+
+            auto measurements = layoutManager->MeasureTexts(
+                static_cast<uint32_t>(texts.size()),
+                texts.data(),
+                format.Get(),
+                100.0f,
+                0.0f,
+                4);
+
+            Assert::AreEqual(static_cast<uint32_t>(texts.size()), measurements.GetSize());
+
+            for (uint32_t i = 0; i < texts.size(); i++)
+            {
+                auto textLayout = layoutManager->Create(device.Get(), texts[i], format.Get(), 100.0f, 0.0f);
+
+                Rect expectedBounds;
+                int32_t expectedLineCount;
+                float expectedMinimumLineLength;
+                ThrowIfFailed(textLayout->get_LayoutBounds(&expectedBounds));
+                ThrowIfFailed(textLayout->get_LineCount(&expectedLineCount));
+                ThrowIfFailed(textLayout->GetMinimumLineLength(&expectedMinimumLineLength));
+
+                Assert::AreEqual(expectedBounds, measurements[i].LayoutBounds);
+                Assert::AreEqual(expectedLineCount, measurements[i].LineCount);
+                Assert::AreEqual(expectedMinimumLineLength, measurements[i].MinimumLineLength);
+            }
+        }
+    };
 }
\ No newline at end of file
@@ -0,0 +1,292 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+static ComPtr<MockD2DDeviceContext> MakePoolableDeviceContext()
+{
+    auto deviceContext = Make<MockD2DDeviceContext>();
+
+    deviceContext->SetTargetMethod.AllowAnyCall();
+    deviceContext->SetDpiMethod.AllowAnyCall();
+    deviceContext->SetTransformMethod.AllowAnyCall();
+    deviceContext->SetAntialiasModeMethod.AllowAnyCall();
+    deviceContext->SetTextAntialiasModeMethod.AllowAnyCall();
+    deviceContext->SetPrimitiveBlendMethod.AllowAnyCall();
+    deviceContext->SetUnitModeMethod.AllowAnyCall();
+    deviceContext->SetTextRenderingParamsMethod.AllowAnyCall();
+    deviceContext->SetTagsMethod.AllowAnyCall();
+    deviceContext->SetRenderingControlsMethod.AllowAnyCall();
+    deviceContext->GetRenderingControlsMethod.AllowAnyCall(
+        [](D2D1_RENDERING_CONTROLS* renderingControls)
+        {
+            *renderingControls = D2D1_RENDERING_CONTROLS{ D2D1_BUFFER_PRECISION_8BPC_UNORM, D2D1_SIZE_U{ 1024, 1024 } };
+        });
+
+    return deviceContext;
+}
+
+TEST_CLASS(DeviceContextPoolTests)
+{
+    class Fixture
+    {
+    public:
+        DeviceContextPool Pool;
+        int CreateCount;
+
+        Fixture()
+            : CreateCount(0)
+        {
+        }
+
+        ComPtr<ID2D1DeviceContext1> Acquire()
+        {
+            return Pool.Acquire(
+                [&]
+                {
+                    CreateCount++;
+                    return MakePoolableDeviceContext();
+                });
+        }
+    };
+
+    TEST_METHOD_EX(DeviceContextPool_WhenEmpty_CreatesDeviceContext)
+    {
+        Fixture f;
+
+        auto dc1 = f.Acquire();
+        auto dc2 = f.Acquire();
+
+        Assert::IsFalse(IsSameInstance(dc1.Get(), dc2.Get()));
+        Assert::AreEqual(2, f.CreateCount);
+    }
+
+    TEST_METHOD_EX(DeviceContextPool_ReleasedDeviceContextIsReused)
+    {
+        Fixture f;
+
+        auto dc1 = f.Acquire();
+        f.Pool.Release(dc1.Get());
+
+        auto dc2 = f.Acquire();
+
+        Assert::IsTrue(IsSameInstance(dc1.Get(), dc2.Get()));
+        Assert::AreEqual(1, f.CreateCount);
+        Assert::AreEqual<size_t>(0, f.Pool.GetPooledCount());
+    }
+
+    TEST_METHOD_EX(DeviceContextPool_SessionChurn_CreatesAtMostOneDeviceContextPerOpenSession)
+    {
+        Fixture f;
+
+        const int openAtOnce = 3;
+
+        for (int i = 0; i < 200; ++i)
+        {
+            std::vector<ComPtr<ID2D1DeviceContext1>> dcs;
+
+            for (int j = 0; j < openAtOnce; ++j)
+                dcs.push_back(f.Acquire());
+
+            for (auto& dc : dcs)
+                f.Pool.Release(dc.Get());
+        }
+
+        Assert::AreEqual(openAtOnce, f.CreateCount);
+    }
+
+    TEST_METHOD_EX(DeviceContextPool_WhenFull_ReleasedDeviceContextsAreDropped)
+    {
+        Fixture f;
+
+        const size_t count = DeviceContextPool::Capacity + 3;
+
+        std::vector<ComPtr<ID2D1DeviceContext1>> dcs;
+
+        for (size_t i = 0; i < count; ++i)
+            dcs.push_back(f.Acquire());
+
+        for (auto& dc : dcs)
+            f.Pool.Release(dc.Get());
+
+        Assert::AreEqual(static_cast<size_t>(DeviceContextPool::Capacity), f.Pool.GetPooledCount());
+
+        // Only the pool's references remain on the pooled device contexts
+        dcs.clear();
+
+        for (size_t i = 0; i < count; ++i)
+            f.Acquire();
+
+        Assert::AreEqual(static_cast<int>(count + count - DeviceContextPool::Capacity), f.CreateCount);
+    }
+
+    TEST_METHOD_EX(DeviceContextPool_Clear_EmptiesPool)
+    {
+        Fixture f;
+
+        auto dc = f.Acquire();
+        f.Pool.Release(dc.Get());
+        dc.Reset();
+
+        f.Pool.Clear();
+
+        Assert::AreEqual<size_t>(0, f.Pool.GetPooledCount());
+
+        f.Acquire();
+        Assert::AreEqual(2, f.CreateCount);
+    }
+
+    TEST_METHOD_EX(DeviceContextPool_Release_ResetsDeviceContextState)
+    {
+        DeviceContextPool pool;
+
+        const D2D1_RENDERING_CONTROLS defaultRenderingControls{ D2D1_BUFFER_PRECISION_8BPC_UNORM, D2D1_SIZE_U{ 512, 256 } };
+
+        auto dc = Make<MockD2DDeviceContext>();
+
+        dc->GetRenderingControlsMethod.SetExpectedCalls(1,
+            [=](D2D1_RENDERING_CONTROLS* renderingControls)
+            {
+                *renderingControls = defaultRenderingControls;
+            });
+
+        auto acquired = pool.Acquire([=] { return dc; });
+        Assert::IsTrue(IsSameInstance(dc.Get(), acquired.Get()));
+
+        dc->SetTargetMethod.SetExpectedCalls(1,
+            [](ID2D1Image* target)
+            {
+                Assert::IsNull(target);
+            });
+
+        dc->SetDpiMethod.SetExpectedCalls(1,
+            [](float dpiX, float dpiY)
+            {
+                Assert::AreEqual(DEFAULT_DPI, dpiX);
+                Assert::AreEqual(DEFAULT_DPI, dpiY);
+            });
+
+        dc->SetTransformMethod.SetExpectedCalls(1,
+            [](D2D1_MATRIX_3X2_F const* transform)
+            {
+                Assert::IsTrue(static_cast<D2D1::Matrix3x2F const*>(transform)->IsIdentity());
+            });
+
+        dc->SetAntialiasModeMethod.SetExpectedCalls(1,
+            [](D2D1_ANTIALIAS_MODE mode)
+            {
+                Assert::AreEqual(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE, mode);
+            });
+
+        dc->SetTextAntialiasModeMethod.SetExpectedCalls(1,
+            [](D2D1_TEXT_ANTIALIAS_MODE mode)
+            {
+                Assert::AreEqual(D2D1_TEXT_ANTIALIAS_MODE_DEFAULT, mode);
+            });
+
+        dc->SetPrimitiveBlendMethod.SetExpectedCalls(1,
+            [](D2D1_PRIMITIVE_BLEND blend)
+            {
+                Assert::AreEqual(D2D1_PRIMITIVE_BLEND_SOURCE_OVER, blend);
+            });
+
+        dc->SetUnitModeMethod.SetExpectedCalls(1,
+            [](D2D1_UNIT_MODE mode)
+            {
+                Assert::AreEqual(D2D1_UNIT_MODE_DIPS, mode);
+            });
+
+        dc->SetTextRenderingParamsMethod.SetExpectedCalls(1,
+            [](IDWriteRenderingParams* params)
+            {
+                Assert::IsNull(params);
+            });
+
+        dc->SetTagsMethod.SetExpectedCalls(1,
+            [](D2D1_TAG tag1, D2D1_TAG tag2)
+            {
+                Assert::AreEqual<D2D1_TAG>(0, tag1);
+                Assert::AreEqual<D2D1_TAG>(0, tag2);
+            });
+
+        dc->SetRenderingControlsMethod.SetExpectedCalls(1,
+            [=](D2D1_RENDERING_CONTROLS const* renderingControls)
+            {
+                Assert::IsTrue(defaultRenderingControls.bufferPrecision == renderingControls->bufferPrecision);
+                Assert::AreEqual(defaultRenderingControls.tileSize.width, renderingControls->tileSize.width);
+                Assert::AreEqual(defaultRenderingControls.tileSize.height, renderingControls->tileSize.height);
+            });
+
+        pool.Release(acquired.Get());
+    }
+
+    TEST_METHOD_EX(DeviceContextPool_DefaultRenderingControlsAreOnlyReadFromTheFirstNewDeviceContext)
+    {
+        DeviceContextPool pool;
+
+        auto dc1 = MakePoolableDeviceContext();
+        auto dc2 = MakePoolableDeviceContext();
+
+        dc1->GetRenderingControlsMethod.SetExpectedCalls(1,
+            [](D2D1_RENDERING_CONTROLS* renderingControls)
+            {
+                *renderingControls = D2D1_RENDERING_CONTROLS{ D2D1_BUFFER_PRECISION_8BPC_UNORM, D2D1_SIZE_U{ 1024, 1024 } };
+            });
+
+        dc2->GetRenderingControlsMethod.SetExpectedCalls(0);
+
+        auto acquired1 = pool.Acquire([=] { return dc1; });
+        auto acquired2 = pool.Acquire([=] { return dc2; });
+
+        pool.Release(acquired1.Get());
+        pool.Release(acquired2.Get());
+    }
+};
+
+TEST_CLASS(PooledCanvasDrawingSessionAdapterTests)
+{
+    TEST_METHOD_EX(PooledCanvasDrawingSessionAdapter_WhenEndDrawSucceeds_ReturnsDeviceContextToDevice)
+    {
+        auto device = Make<MockCanvasDevice>();
+        auto dc = Make<MockD2DDeviceContext>();
+
+        dc->BeginDrawMethod.SetExpectedCalls(1);
+
+        auto adapter = std::make_shared<PooledCanvasDrawingSessionAdapter>(device.Get(), dc.Get());
+
+        dc->EndDrawMethod.SetExpectedCalls(1);
+
+        device->ReleasePooledDeviceContextMethod.SetExpectedCalls(1,
+            [=](ID2D1DeviceContext1* released)
+            {
+                Assert::IsTrue(IsSameInstance(dc.Get(), released));
+            });
+
+        adapter->EndDraw();
+    }
+
+    TEST_METHOD_EX(PooledCanvasDrawingSessionAdapter_WhenEndDrawFails_DoesNotReturnDeviceContextToDevice)
+    {
+        auto device = Make<MockCanvasDevice>();
+        auto dc = Make<MockD2DDeviceContext>();
+
+        dc->BeginDrawMethod.SetExpectedCalls(1);
+
+        auto adapter = std::make_shared<PooledCanvasDrawingSessionAdapter>(device.Get(), dc.Get());
+
+        dc->EndDrawMethod.SetExpectedCalls(1, [](D2D1_TAG*, D2D1_TAG*) { return D2DERR_RECREATE_TARGET; });
+
+        device->ReleasePooledDeviceContextMethod.SetExpectedCalls(0);
+
+        ExpectHResultException(D2DERR_RECREATE_TARGET, [&] { adapter->EndDraw(); });
+    }
+};
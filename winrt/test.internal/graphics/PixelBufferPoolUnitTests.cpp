@@ -0,0 +1,160 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+TEST_CLASS(PixelBufferPoolTests)
+{
+    TEST_METHOD_EX(PixelBufferPool_Acquire_ReturnsBufferOfRequestedSize)
+    {
+        PixelBufferPool pool;
+
+        auto buffer = pool.Acquire(1234);
+
+        Assert::AreEqual<size_t>(1234, buffer.size());
+        Assert::AreEqual<uint64_t>(1, pool.GetMissCount());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_RepeatedAcquireAndRelease_ReusesOneBuffer)
+    {
+        PixelBufferPool pool;
+
+        auto firstBuffer = pool.Acquire(4096);
+        auto firstData = firstBuffer.data();
+        pool.Release(std::move(firstBuffer));
+
+        for (int i = 0; i < 100; ++i)
+        {
+            auto buffer = pool.Acquire(4096);
+            Assert::IsTrue(firstData == buffer.data());
+            pool.Release(std::move(buffer));
+        }
+
+        Assert::AreEqual<uint64_t>(100, pool.GetHitCount());
+        Assert::AreEqual<uint64_t>(1, pool.GetMissCount());
+        Assert::AreEqual<size_t>(1, pool.GetIdleBufferCount());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_SmallerRequest_ReusesLargerBuffer)
+    {
+        PixelBufferPool pool;
+
+        auto buffer = pool.Acquire(4096);
+        auto data = buffer.data();
+        pool.Release(std::move(buffer));
+
+        auto smallerBuffer = pool.Acquire(100);
+
+        Assert::IsTrue(data == smallerBuffer.data());
+        Assert::AreEqual<size_t>(100, smallerBuffer.size());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_LargerRequest_DoesNotReuseSmallerBuffer)
+    {
+        PixelBufferPool pool;
+
+        pool.Release(pool.Acquire(100));
+
+        auto buffer = pool.Acquire(4096);
+
+        Assert::AreEqual<size_t>(4096, buffer.size());
+        Assert::AreEqual<uint64_t>(0, pool.GetHitCount());
+        Assert::AreEqual<size_t>(1, pool.GetIdleBufferCount());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_Acquire_PicksSmallestBufferThatFits)
+    {
+        PixelBufferPool pool;
+
+        auto large = pool.Acquire(8192);
+        auto medium = pool.Acquire(2048);
+        auto small = pool.Acquire(512);
+        auto mediumData = medium.data();
+
+        pool.Release(std::move(large));
+        pool.Release(std::move(medium));
+        pool.Release(std::move(small));
+
+        auto buffer = pool.Acquire(1000);
+
+        Assert::IsTrue(mediumData == buffer.data());
+        Assert::AreEqual<size_t>(2, pool.GetIdleBufferCount());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_BuffersInUse_AreNotShared)
+    {
+        PixelBufferPool pool;
+
+        auto buffer1 = pool.Acquire(256);
+        auto buffer2 = pool.Acquire(256);
+
+        Assert::IsFalse(buffer1.data() == buffer2.data());
+        Assert::AreEqual<uint64_t>(2, pool.GetMissCount());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_WhenOverBudget_LeastRecentlyReleasedBuffersAreDropped)
+    {
+        PixelBufferPool pool(2 * 1024);
+
+        auto buffer1 = pool.Acquire(1024);
+        auto buffer2 = pool.Acquire(1024);
+        auto buffer3 = pool.Acquire(1024);
+        auto data3 = buffer3.data();
+
+        pool.Release(std::move(buffer1));
+        pool.Release(std::move(buffer2));
+        pool.Release(std::move(buffer3));
+
+        Assert::AreEqual<size_t>(2, pool.GetIdleBufferCount());
+        Assert::AreEqual<uint64_t>(2 * 1024, pool.GetIdleSizeInBytes());
+
+        // The most recently released buffer is still there
+        auto reacquired = pool.Acquire(1024);
+        auto reacquired2 = pool.Acquire(1024);
+
+        Assert::IsTrue(data3 == reacquired.data() || data3 == reacquired2.data());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_BufferLargerThanBudget_IsNotKept)
+    {
+        PixelBufferPool pool(1024);
+
+        pool.Release(pool.Acquire(4096));
+
+        Assert::AreEqual<size_t>(0, pool.GetIdleBufferCount());
+        Assert::AreEqual<uint64_t>(0, pool.GetIdleSizeInBytes());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_EmptyBuffer_IsNotKept)
+    {
+        PixelBufferPool pool;
+
+        pool.Release(std::vector<uint8_t>());
+
+        Assert::AreEqual<size_t>(0, pool.GetIdleBufferCount());
+    }
+
+    TEST_METHOD_EX(PixelBufferPool_Clear_EmptiesPool)
+    {
+        PixelBufferPool pool;
+
+        pool.Release(pool.Acquire(1024));
+
+        pool.Clear();
+
+        Assert::AreEqual<size_t>(0, pool.GetIdleBufferCount());
+        Assert::AreEqual<uint64_t>(0, pool.GetIdleSizeInBytes());
+
+        pool.Acquire(1024);
+        Assert::AreEqual<uint64_t>(2, pool.GetMissCount());
+    }
+};
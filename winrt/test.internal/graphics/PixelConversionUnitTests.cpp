@@ -0,0 +1,237 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+
+#include "pch.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace ABI::Windows::UI;
+
+TEST_CLASS(PixelConversionTests)
+{
+    static std::vector<uint8_t> MakeTestBytes(uint32_t pixelCount)
+    {
+        std::vector<uint8_t> bytes(pixelCount * 4);
+
+        for (size_t i = 0; i < bytes.size(); i++)
+        {
+            bytes[i] = static_cast<uint8_t>(i * 31 + 7);
+        }
+
+        return bytes;
+    }
+
+    TEST_METHOD_EX(PixelConversion_Scalar_ReversesBytesOfEachPixel)
+    {
+        uint8_t source[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        uint8_t destination[8];
+
+        ReversePixelByteOrderScalar(source, destination, 2);
+
+        uint8_t expected[] = { 4, 3, 2, 1, 8, 7, 6, 5 };
+        Assert::AreEqual(0, memcmp(expected, destination, sizeof(expected)));
+    }
+
+    TEST_METHOD_EX(PixelConversion_MatchesScalarReference_ForAllLengthsAndAlignments)
+    {
+        // Lengths cover the vector loop, its unrolled remainder and the
+        // scalar tail.  Offsets make the source and destination unaligned.
+        for (uint32_t pixelCount = 0; pixelCount < 70; pixelCount++)
+        {
+            for (uint32_t sourceOffset = 0; sourceOffset < 4; sourceOffset++)
+            {
+                for (uint32_t destinationOffset = 0; destinationOffset < 4; destinationOffset++)
+                {
+                    auto source = MakeTestBytes(pixelCount + 1);
+
+                    // Guard bytes either side of the destination check for overruns.
+                    std::vector<uint8_t> expected(pixelCount * 4 + 8, 0xCD);
+                    std::vector<uint8_t> actual(pixelCount * 4 + 8, 0xCD);
+
+                    ReversePixelByteOrderScalar(&source[sourceOffset], &expected[destinationOffset], pixelCount);
+                    ReversePixelByteOrder(&source[sourceOffset], &actual[destinationOffset], pixelCount);
+
+                    Assert::IsTrue(expected == actual);
+                }
+            }
+        }
+    }
+
+    TEST_METHOD_EX(PixelConversion_ColorsRoundTripThroughBgraPixels)
+    {
+        const uint32_t pixelCount = 37;
+
+        std::vector<Color> colors(pixelCount);
+
+        for (uint32_t i = 0; i < pixelCount; i++)
+        {
+            colors[i] = Color{ static_cast<uint8_t>(i), static_cast<uint8_t>(i + 64), static_cast<uint8_t>(i + 128), static_cast<uint8_t>(i + 192) };
+        }
+
+        std::vector<uint32_t> pixels(pixelCount);
+        ConvertColorsToBgraPixels(colors.data(), pixels.data(), pixelCount);
+
+        for (uint32_t i = 0; i < pixelCount; i++)
+        {
+            uint32_t expected =
+                (static_cast<uint32_t>(colors[i].B) << 0) |
+                (static_cast<uint32_t>(colors[i].G) << 8) |
+                (static_cast<uint32_t>(colors[i].R) << 16) |
+                (static_cast<uint32_t>(colors[i].A) << 24);
+
+            Assert::AreEqual(expected, pixels[i]);
+        }
+
+        std::vector<Color> roundTripped(pixelCount);
+        ConvertBgraPixelsToColors(pixels.data(), roundTripped.data(), pixelCount);
+
+        Assert::AreEqual(0, memcmp(colors.data(), roundTripped.data(), pixelCount * sizeof(Color)));
+    }
+
+    TEST_METHOD_EX(PixelConversion_MatchesScalarReference_ForImageSizes)
+    {
+        const uint32_t sizes[] = { 64, 255, 1024 };
+
+        for (auto size : sizes)
+        {
+            const uint32_t pixelCount = size * size;
+
+            auto source = MakeTestBytes(pixelCount);
+            std::vector<uint8_t> expected(source.size());
+            std::vector<uint8_t> actual(source.size());
+
+            ReversePixelByteOrderScalar(source.data(), expected.data(), pixelCount);
+            ReversePixelByteOrder(source.data(), actual.data(), pixelCount);
+
+            Assert::IsTrue(expected == actual);
+        }
+    }
+
+    PERF_TEST_METHOD_ATTRIBUTES(PixelConversion_Throughput)
+    TEST_METHOD_EX(PixelConversion_Throughput)
+    {
+        // Compares the vectorized and scalar conversions across a range of
+        // image sizes, checking that they agree at each size.
+        const uint32_t sizes[] = { 64, 256, 1024, 2048, 3840 };
+
+        for (auto size : sizes)
+        {
+            const uint32_t pixelCount = size * size;
+            const int repeatCount = std::max(1u, (1 << 24) / pixelCount);
+
+            auto source = MakeTestBytes(pixelCount);
+            std::vector<uint8_t> scalarDestination(source.size());
+            std::vector<uint8_t> vectorDestination(source.size());
+
+            auto measure = [&](void (*convert)(void const*, void*, uint32_t), std::vector<uint8_t>& destination)
+            {
+                double seconds = MeasureSeconds(
+                    [&]
+                    {
+                        for (int i = 0; i < repeatCount; i++)
+                        {
+                            convert(source.data(), destination.data(), pixelCount);
+                        }
+                    });
+
+                return static_cast<double>(pixelCount) * repeatCount / seconds / 1000000.0;
+            };
+
+            double scalarRate = measure(ReversePixelByteOrderScalar, scalarDestination);
+            double vectorRate = measure(ReversePixelByteOrder, vectorDestination);
+
+            Assert::IsTrue(scalarDestination == vectorDestination);
+
+            LogPerfMessage(L"%ux%u: scalar %.0f, vectorized %.0f megapixels per second\n", size, size, scalarRate, vectorRate);
+        }
+    }
+
+    TEST_METHOD_EX(PixelConversion_CopyPixelRows_HandlesDifferentStrides)
+    {
+        // 4096 rows of 4096 bytes is large enough to be split across threads.
+        const uint32_t bytesPerRow = 4096;
+        const uint32_t rowCount = 4096;
+
+        struct Case { uint32_t SourceStride; uint32_t DestinationStride; };
+
+        Case cases[] =
+        {
+            { bytesPerRow,      bytesPerRow },
+            { bytesPerRow + 64, bytesPerRow },
+            { bytesPerRow,      bytesPerRow + 32 },
+        };
+
+        for (auto const& testCase : cases)
+        {
+            for (unsigned threadCount = 1; threadCount <= 8; threadCount *= 2)
+            {
+                auto source = MakeTestBytes(testCase.SourceStride * rowCount / 4);
+                std::vector<uint8_t> expected(testCase.DestinationStride * rowCount, 0xCD);
+                std::vector<uint8_t> actual(testCase.DestinationStride * rowCount, 0xCD);
+
+                for (uint32_t y = 0; y < rowCount; y++)
+                {
+                    memcpy(&expected[y * testCase.DestinationStride], &source[y * testCase.SourceStride], bytesPerRow);
+                }
+
+                CopyPixelRows(source.data(), testCase.SourceStride, actual.data(), testCase.DestinationStride, bytesPerRow, rowCount, threadCount);
+
+                Assert::IsTrue(expected == actual);
+            }
+        }
+    }
+
+    PERF_TEST_METHOD_ATTRIBUTES(PixelConversion_CopyPixelRows_Scaling)
+    TEST_METHOD_EX(PixelConversion_CopyPixelRows_Scaling)
+    {
+        // Copies a synthetic mapped buffer (8192 x 2048 pixels, with a padded
+        // stride as a staging texture might have) using an increasing number
+        // of threads.
+        const uint32_t bytesPerRow = 8192 * 4;
+        const uint32_t sourceStride = bytesPerRow + 256;
+        const uint32_t rowCount = 2048;
+        const int repeatCount = 8;
+
+        auto source = MakeTestBytes(sourceStride * rowCount / 4);
+
+        std::vector<uint8_t> expected(static_cast<size_t>(bytesPerRow) * rowCount);
+
+        for (uint32_t y = 0; y < rowCount; y++)
+        {
+            memcpy(&expected[y * bytesPerRow], &source[y * sourceStride], bytesPerRow);
+        }
+
+        unsigned maxThreadCount = std::max(1u, std::thread::hardware_concurrency());
+
+        for (unsigned threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+        {
+            std::vector<uint8_t> destination(expected.size());
+
+            double seconds = MeasureSeconds(
+                [&]
+                {
+                    for (int i = 0; i < repeatCount; i++)
+                    {
+                        CopyPixelRows(source.data(), sourceStride, destination.data(), bytesPerRow, bytesPerRow, rowCount, threadCount);
+                    }
+                });
+
+            Assert::IsTrue(expected == destination);
+
+            double gigabytesPerSecond = static_cast<double>(bytesPerRow) * rowCount * repeatCount / seconds / (1024 * 1024 * 1024);
+
+            LogPerfMessage(L"%u threads: %.2f GB per second\n", threadCount, gigabytesPerSecond);
+        }
+    }
+};
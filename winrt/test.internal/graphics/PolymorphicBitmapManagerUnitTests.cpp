@@ -69,3 +69,40 @@ TEST_CLASS(PolymorphicBitmapManagerTests_FromD2DBitmap)
         AssertClassName(wrapped, RuntimeClass_Microsoft_Graphics_Canvas_CanvasRenderTarget);
     }
 };
+
+TEST_CLASS(PolymorphicBitmapManagerTests_DecodeBitmapFile)
+{
+    TEST_METHOD_EX(DecodeBitmapFile_WhenAdapterReturnsLazySource_ItIsReadIntoABitmap)
+    {
+        auto converter = Make<MockWICFormatConverter>();
+        auto adapter = std::make_shared<TestBitmapResourceCreationAdapter>(converter);
+        auto manager = std::make_shared<PolymorphicBitmapManager>(adapter);
+
+        auto expectedBitmap = Make<MockWICBitmap>();
+        int callCount = 0;
+
+        adapter->MockCreateWICBitmapFromSource =
+            [&](IWICBitmapSource* source) -> ComPtr<IWICBitmap>
+            {
+                callCount++;
+                Assert::IsTrue(IsSameInstance(converter.Get(), source));
+                return expectedBitmap;
+            };
+
+        auto decodedImage = manager->DecodeBitmapFile(WinString(L"fileName"));
+
+        Assert::AreEqual(1, callCount);
+        Assert::IsTrue(IsSameInstance(expectedBitmap.Get(), decodedImage.Get()));
+    }
+
+    TEST_METHOD_EX(DecodeBitmapFile_WhenAdapterReturnsBitmap_ItIsReturnedAsIs)
+    {
+        auto bitmap = Make<MockWICBitmap>();
+        auto adapter = std::make_shared<TestBitmapResourceCreationAdapter>(bitmap);
+        auto manager = std::make_shared<PolymorphicBitmapManager>(adapter);
+
+        auto decodedImage = manager->DecodeBitmapFile(WinString(L"fileName"));
+
+        Assert::IsTrue(IsSameInstance(bitmap.Get(), decodedImage.Get()));
+    }
+};
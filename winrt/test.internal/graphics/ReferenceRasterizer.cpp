@@ -0,0 +1,616 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+#include "ReferenceRasterizer.h"
+
+#include <ScopeWarden.h>
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace canvas
+{
+    static D2D1_COLOR_F Premultiply(D2D1_COLOR_F const& color)
+    {
+        return D2D1::ColorF(color.r * color.a, color.g * color.a, color.b * color.a, color.a);
+    }
+
+    static D2D1_COLOR_F Scale(D2D1_COLOR_F const& color, float amount)
+    {
+        return D2D1::ColorF(color.r * amount, color.g * amount, color.b * amount, color.a * amount);
+    }
+
+    static D2D1_COLOR_F Lerp(D2D1_COLOR_F const& a, D2D1_COLOR_F const& b, float t)
+    {
+        return D2D1::ColorF(a.r + (b.r - a.r) * t,
+                            a.g + (b.g - a.g) * t,
+                            a.b + (b.b - a.b) * t,
+                            a.a + (b.a - a.a) * t);
+    }
+
+    static uint8_t ToByte(float value)
+    {
+        return static_cast<uint8_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+
+    static D2D1_COLOR_F UnpackPixel(uint32_t pixel)
+    {
+        const float scale = 1.0f / 255.0f;
+
+        return D2D1::ColorF(((pixel >> 16) & 0xFF) * scale,
+                            ((pixel >> 8) & 0xFF) * scale,
+                            (pixel & 0xFF) * scale,
+                            (pixel >> 24) * scale);
+    }
+
+    static uint32_t PackPixel(D2D1_COLOR_F const& color)
+    {
+        return (static_cast<uint32_t>(ToByte(color.a)) << 24) |
+               (static_cast<uint32_t>(ToByte(color.r)) << 16) |
+               (static_cast<uint32_t>(ToByte(color.g)) << 8) |
+               (static_cast<uint32_t>(ToByte(color.b)));
+    }
+
+
+    //
+    // ReferenceBrush
+    //
+
+    ReferenceBrush::ReferenceBrush(Type type)
+        : m_type(type)
+        , m_transform(D2D1::Matrix3x2F::Identity())
+        , m_opacity(1.0f)
+        , m_color(D2D1::ColorF(0, 0, 0, 0))
+        , m_startPoint(D2D1::Point2F())
+        , m_endPoint(D2D1::Point2F())
+        , m_interpolationMode(D2D1_BITMAP_INTERPOLATION_MODE_LINEAR)
+    {
+    }
+
+    ReferenceBrush ReferenceBrush::Solid(D2D1_COLOR_F const& color)
+    {
+        ReferenceBrush brush(Type::Solid);
+        brush.m_color = Premultiply(color);
+        return brush;
+    }
+
+    static std::vector<D2D1_GRADIENT_STOP> PrepareGradientStops(std::vector<D2D1_GRADIENT_STOP> stops)
+    {
+        if (stops.empty())
+            ThrowHR(E_INVALIDARG);
+
+        std::stable_sort(stops.begin(), stops.end(),
+            [](D2D1_GRADIENT_STOP const& a, D2D1_GRADIENT_STOP const& b)
+            {
+                return a.position < b.position;
+            });
+
+        for (auto& stop : stops)
+        {
+            stop.color = Premultiply(stop.color);
+        }
+
+        return stops;
+    }
+
+    ReferenceBrush ReferenceBrush::LinearGradient(
+        D2D1_POINT_2F startPoint,
+        D2D1_POINT_2F endPoint,
+        std::vector<D2D1_GRADIENT_STOP> stops)
+    {
+        ReferenceBrush brush(Type::LinearGradient);
+        brush.m_startPoint = startPoint;
+        brush.m_endPoint = endPoint;
+        brush.m_stops = PrepareGradientStops(std::move(stops));
+        return brush;
+    }
+
+    ReferenceBrush ReferenceBrush::RadialGradient(
+        D2D1_POINT_2F center,
+        float radiusX,
+        float radiusY,
+        std::vector<D2D1_GRADIENT_STOP> stops)
+    {
+        ReferenceBrush brush(Type::RadialGradient);
+        brush.m_startPoint = center;
+        brush.m_endPoint = D2D1::Point2F(radiusX, radiusY);
+        brush.m_stops = PrepareGradientStops(std::move(stops));
+        return brush;
+    }
+
+    ReferenceBrush ReferenceBrush::Bitmap(
+        std::shared_ptr<ReferenceBitmap const> bitmap,
+        D2D1_BITMAP_INTERPOLATION_MODE interpolationMode)
+    {
+        if (!bitmap || bitmap->Width == 0 || bitmap->Height == 0)
+            ThrowHR(E_INVALIDARG);
+
+        if (bitmap->Pixels.size() != static_cast<size_t>(bitmap->Width) * bitmap->Height)
+            ThrowHR(E_INVALIDARG);
+
+        ReferenceBrush brush(Type::Bitmap);
+        brush.m_bitmap = std::move(bitmap);
+        brush.m_interpolationMode = interpolationMode;
+        return brush;
+    }
+
+    D2D1_COLOR_F ReferenceBrush::GetColor(D2D1_POINT_2F point) const
+    {
+        D2D1_COLOR_F color;
+
+        switch (m_type)
+        {
+        case Type::Solid:
+            color = m_color;
+            break;
+
+        case Type::LinearGradient:
+            {
+                float dx = m_endPoint.x - m_startPoint.x;
+                float dy = m_endPoint.y - m_startPoint.y;
+                float lengthSquared = dx * dx + dy * dy;
+
+                float position = 0;
+
+                if (lengthSquared > 0)
+                    position = ((point.x - m_startPoint.x) * dx + (point.y - m_startPoint.y) * dy) / lengthSquared;
+
+                color = GetGradientColor(position);
+            }
+            break;
+
+        case Type::RadialGradient:
+            {
+                float radiusX = m_endPoint.x;
+                float radiusY = m_endPoint.y;
+
+                float position = 1;
+
+                if (radiusX > 0 && radiusY > 0)
+                {
+                    float dx = (point.x - m_startPoint.x) / radiusX;
+                    float dy = (point.y - m_startPoint.y) / radiusY;
+                    position = sqrtf(dx * dx + dy * dy);
+                }
+
+                color = GetGradientColor(position);
+            }
+            break;
+
+        case Type::Bitmap:
+            color = GetBitmapColor(point);
+            break;
+
+        default:
+            assert(false);
+            ThrowHR(E_UNEXPECTED);
+        }
+
+        return (m_opacity == 1.0f) ? color : Scale(color, m_opacity);
+    }
+
+    D2D1_COLOR_F ReferenceBrush::GetGradientColor(float position) const
+    {
+        if (position <= m_stops.front().position)
+            return m_stops.front().color;
+
+        if (position >= m_stops.back().position)
+            return m_stops.back().color;
+
+        for (size_t i = 1; i < m_stops.size(); i++)
+        {
+            auto& next = m_stops[i];
+
+            if (position < next.position)
+            {
+                auto& previous = m_stops[i - 1];
+                float t = (position - previous.position) / (next.position - previous.position);
+                return Lerp(previous.color, next.color, t);
+            }
+        }
+
+        return m_stops.back().color;
+    }
+
+    D2D1_COLOR_F ReferenceBrush::GetBitmapColor(D2D1_POINT_2F point) const
+    {
+        if (m_interpolationMode == D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR)
+        {
+            return GetBitmapPixel(static_cast<int>(floorf(point.x)), static_cast<int>(floorf(point.y)));
+        }
+
+        // Bilinear filtering between the four nearest pixel centers.
+        float x = point.x - 0.5f;
+        float y = point.y - 0.5f;
+
+        float x0 = floorf(x);
+        float y0 = floorf(y);
+
+        float fx = x - x0;
+        float fy = y - y0;
+
+        int ix = static_cast<int>(x0);
+        int iy = static_cast<int>(y0);
+
+        auto top = Lerp(GetBitmapPixel(ix, iy), GetBitmapPixel(ix + 1, iy), fx);
+        auto bottom = Lerp(GetBitmapPixel(ix, iy + 1), GetBitmapPixel(ix + 1, iy + 1), fx);
+
+        return Lerp(top, bottom, fy);
+    }
+
+    D2D1_COLOR_F ReferenceBrush::GetBitmapPixel(int x, int y) const
+    {
+        // Clamp to the edges of the bitmap.
+        x = std::min(std::max(x, 0), static_cast<int>(m_bitmap->Width) - 1);
+        y = std::min(std::max(y, 0), static_cast<int>(m_bitmap->Height) - 1);
+
+        return UnpackPixel(m_bitmap->Pixels[static_cast<size_t>(y) * m_bitmap->Width + x]);
+    }
+
+
+    //
+    // ReferenceRasterizer
+    //
+
+    // Per-thread working memory, reused for every row in a band.
+    struct ReferenceRasterizer::Scratch
+    {
+        std::vector<float> Coverage;
+        std::vector<std::pair<float, int>> Crossings;
+    };
+
+    ReferenceRasterizer::ReferenceRasterizer(uint32_t width, uint32_t height)
+        : m_width(width)
+        , m_height(height)
+        , m_maxThreadCount(0)
+        , m_transform(D2D1::Matrix3x2F::Identity())
+        , m_pixels(static_cast<size_t>(width) * height)
+    {
+    }
+
+    void ReferenceRasterizer::Clear(D2D1_COLOR_F const& color)
+    {
+        // Anything drawn before the clear would be overwritten, so need not
+        // be rasterized at all.
+        m_commands.clear();
+
+        std::fill(m_pixels.begin(), m_pixels.end(), PackPixel(Premultiply(color)));
+    }
+
+    void ReferenceRasterizer::FillRectangle(D2D1_RECT_F const& rect, ReferenceBrush const& brush)
+    {
+        std::vector<std::vector<D2D1_POINT_2F>> figures(1);
+
+        figures[0].push_back(D2D1::Point2F(rect.left, rect.top));
+        figures[0].push_back(D2D1::Point2F(rect.right, rect.top));
+        figures[0].push_back(D2D1::Point2F(rect.right, rect.bottom));
+        figures[0].push_back(D2D1::Point2F(rect.left, rect.bottom));
+
+        AddCommand(figures, D2D1_FILL_MODE_WINDING, brush);
+    }
+
+    void ReferenceRasterizer::FillEllipse(D2D1_ELLIPSE const& ellipse, ReferenceBrush const& brush)
+    {
+        // Choose enough segments that the flattened outline stays within a
+        // tenth of a pixel of the true curve, allowing for any scale in the
+        // current transform.
+        const float tolerance = 0.1f;
+        const float pi = 3.14159265f;
+
+        auto& m = m_transform;
+        float scale = sqrtf(std::max(m._11 * m._11 + m._12 * m._12, m._21 * m._21 + m._22 * m._22));
+        float radius = std::max(fabsf(ellipse.radiusX), fabsf(ellipse.radiusY)) * scale;
+
+        int segmentCount = 8;
+
+        if (radius > tolerance)
+        {
+            float angle = acosf(1 - tolerance / radius);
+            segmentCount = std::min(std::max(static_cast<int>(ceilf(pi / angle)), 8), 1024);
+        }
+
+        // An inscribed polygon is smaller than the ellipse, so push the
+        // vertices out until the areas match.
+        float segmentAngle = 2 * pi / segmentCount;
+        float areaCorrection = sqrtf(segmentAngle / sinf(segmentAngle));
+
+        float radiusX = ellipse.radiusX * areaCorrection;
+        float radiusY = ellipse.radiusY * areaCorrection;
+
+        std::vector<std::vector<D2D1_POINT_2F>> figures(1);
+        figures[0].reserve(segmentCount);
+
+        for (int i = 0; i < segmentCount; i++)
+        {
+            float theta = segmentAngle * i;
+
+            figures[0].push_back(D2D1::Point2F(
+                ellipse.point.x + radiusX * cosf(theta),
+                ellipse.point.y + radiusY * sinf(theta)));
+        }
+
+        AddCommand(figures, D2D1_FILL_MODE_WINDING, brush);
+    }
+
+    void ReferenceRasterizer::FillPolygons(
+        std::vector<std::vector<D2D1_POINT_2F>> const& figures,
+        D2D1_FILL_MODE fillMode,
+        ReferenceBrush const& brush)
+    {
+        AddCommand(figures, fillMode, brush);
+    }
+
+    void ReferenceRasterizer::DrawBitmap(
+        std::shared_ptr<ReferenceBitmap const> const& bitmap,
+        D2D1_RECT_F const& destinationRect,
+        float opacity,
+        D2D1_BITMAP_INTERPOLATION_MODE interpolationMode)
+    {
+        auto brush = ReferenceBrush::Bitmap(bitmap, interpolationMode);
+
+        // Map the whole bitmap, in pixels, onto the destination rectangle.
+        brush.SetTransform(
+            D2D1::Matrix3x2F::Scale((destinationRect.right - destinationRect.left) / bitmap->Width,
+                                    (destinationRect.bottom - destinationRect.top) / bitmap->Height) *
+            D2D1::Matrix3x2F::Translation(destinationRect.left, destinationRect.top));
+
+        brush.SetOpacity(opacity);
+
+        FillRectangle(destinationRect, brush);
+    }
+
+    void ReferenceRasterizer::AddCommand(
+        std::vector<std::vector<D2D1_POINT_2F>> const& figures,
+        D2D1_FILL_MODE fillMode,
+        ReferenceBrush const& brush)
+    {
+        auto& transform = *D2D1::Matrix3x2F::ReinterpretBaseType(&m_transform);
+
+        // Brush positions are mapped by the brush transform and then the
+        // drawing transform, so pixels need the inverse of both.
+        D2D1::Matrix3x2F deviceToBrush = *D2D1::Matrix3x2F::ReinterpretBaseType(&brush.GetTransform()) * transform;
+
+        if (!D2D1InvertMatrix(&deviceToBrush))
+            return;
+
+        Command command{ std::vector<Edge>(), fillMode, brush, deviceToBrush, 0, 0 };
+
+        float minY = std::numeric_limits<float>::max();
+        float maxY = -std::numeric_limits<float>::max();
+
+        for (auto& figure : figures)
+        {
+            for (size_t i = 0; i < figure.size(); i++)
+            {
+                auto p0 = transform.TransformPoint(figure[i]);
+                auto p1 = transform.TransformPoint(figure[(i + 1) % figure.size()]);
+
+                // Horizontal edges never cross a sample row.
+                if (p0.y == p1.y)
+                    continue;
+
+                if (p0.y < p1.y)
+                    command.Edges.push_back(Edge{ p0.x, p0.y, p1.x, p1.y, 1 });
+                else
+                    command.Edges.push_back(Edge{ p1.x, p1.y, p0.x, p0.y, -1 });
+
+                minY = std::min(minY, std::min(p0.y, p1.y));
+                maxY = std::max(maxY, std::max(p0.y, p1.y));
+            }
+        }
+
+        if (command.Edges.empty())
+            return;
+
+        command.FirstRow = static_cast<uint32_t>(std::min(std::max(floorf(minY), 0.0f), static_cast<float>(m_height)));
+        command.EndRow = static_cast<uint32_t>(std::min(std::max(ceilf(maxY), 0.0f), static_cast<float>(m_height)));
+
+        if (command.FirstRow >= command.EndRow)
+            return;
+
+        m_commands.push_back(std::move(command));
+    }
+
+    void ReferenceRasterizer::Flush()
+    {
+        if (m_commands.empty())
+            return;
+
+        auto clearCommands = MakeScopeWarden([&] { m_commands.clear(); });
+
+        uint32_t bandCount = (m_height + BandHeight - 1) / BandHeight;
+
+        unsigned threadCount = m_maxThreadCount ? m_maxThreadCount : std::thread::hardware_concurrency();
+        threadCount = std::max(1u, std::min(threadCount, bandCount));
+
+        // This is also built into test.external, which cannot use the
+        // library's ParallelFor, so the bands are shared out here: each
+        // thread takes the next unprocessed band until there are none left.
+        std::atomic<uint32_t> nextBand(0);
+
+        // An exception can't be allowed to escape a thread, so the first one
+        // thrown is kept, the remaining bands are skipped, and it is rethrown
+        // once every thread has finished.
+        std::mutex exceptionMutex;
+        std::exception_ptr firstException;
+
+        auto rasterizeBands = [&]
+        {
+            try
+            {
+                for (uint32_t band = nextBand++; band < bandCount; band = nextBand++)
+                {
+                    uint32_t firstRow = band * BandHeight;
+                    RasterizeRows(firstRow, std::min(m_height - firstRow, static_cast<uint32_t>(BandHeight)));
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+
+                if (!firstException)
+                    firstException = std::current_exception();
+
+                nextBand = bandCount;
+            }
+        };
+
+        {
+            std::vector<std::thread> workers;
+
+            // This also runs if starting a thread fails, since destroying a
+            // thread that hasn't been joined terminates the process.
+            auto joinWorkers = MakeScopeWarden(
+                [&]
+                {
+                    nextBand = bandCount;
+
+                    for (auto& worker : workers)
+                    {
+                        worker.join();
+                    }
+                });
+
+            for (unsigned i = 1; i < threadCount; i++)
+            {
+                workers.emplace_back(rasterizeBands);
+            }
+
+            rasterizeBands();
+        }
+
+        if (firstException)
+            std::rethrow_exception(firstException);
+    }
+
+    std::vector<uint32_t> const& ReferenceRasterizer::GetPixels()
+    {
+        Flush();
+        return m_pixels;
+    }
+
+    uint32_t ReferenceRasterizer::GetPixel(uint32_t x, uint32_t y)
+    {
+        assert(x < m_width && y < m_height);
+
+        Flush();
+        return m_pixels[static_cast<size_t>(y) * m_width + x];
+    }
+
+    void ReferenceRasterizer::RasterizeRows(uint32_t firstRow, uint32_t rowCount)
+    {
+        Scratch scratch;
+        scratch.Coverage.resize(m_width);
+
+        uint32_t endRow = firstRow + rowCount;
+
+        for (auto& command : m_commands)
+        {
+            uint32_t commandFirstRow = std::max(firstRow, command.FirstRow);
+            uint32_t commandEndRow = std::min(endRow, command.EndRow);
+
+            for (uint32_t y = commandFirstRow; y < commandEndRow; y++)
+            {
+                RasterizeRow(command, y, scratch);
+            }
+        }
+    }
+
+    void ReferenceRasterizer::RasterizeRow(Command const& command, uint32_t y, Scratch& scratch)
+    {
+        // Coverage is sampled on several rows within the pixel, and computed
+        // exactly along each of those rows.
+        const float sampleWeight = 1.0f / SamplesPerPixelRow;
+
+        auto& coverage = scratch.Coverage;
+        auto& crossings = scratch.Crossings;
+
+        float width = static_cast<float>(m_width);
+        uint32_t minX = m_width;
+        uint32_t maxX = 0;
+
+        for (int sample = 0; sample < SamplesPerPixelRow; sample++)
+        {
+            float sampleY = y + (sample + 0.5f) * sampleWeight;
+
+            crossings.clear();
+
+            for (auto& edge : command.Edges)
+            {
+                if (sampleY >= edge.Y0 && sampleY < edge.Y1)
+                {
+                    float x = edge.X0 + (sampleY - edge.Y0) * (edge.X1 - edge.X0) / (edge.Y1 - edge.Y0);
+                    crossings.emplace_back(x, edge.Direction);
+                }
+            }
+
+            std::sort(crossings.begin(), crossings.end());
+
+            int winding = 0;
+
+            for (size_t i = 0; i + 1 < crossings.size(); i++)
+            {
+                winding += crossings[i].second;
+
+                bool inside = (command.FillMode == D2D1_FILL_MODE_ALTERNATE) ? (winding & 1) != 0 : winding != 0;
+
+                if (!inside)
+                    continue;
+
+                float spanStart = std::max(crossings[i].first, 0.0f);
+                float spanEnd = std::min(crossings[i + 1].first, width);
+
+                if (spanStart >= spanEnd)
+                    continue;
+
+                auto firstPixel = static_cast<uint32_t>(spanStart);
+                auto endPixel = std::min(static_cast<uint32_t>(ceilf(spanEnd)), m_width);
+
+                for (uint32_t x = firstPixel; x < endPixel; x++)
+                {
+                    float overlap = std::min(spanEnd, x + 1.0f) - std::max(spanStart, static_cast<float>(x));
+                    coverage[x] += overlap * sampleWeight;
+                }
+
+                minX = std::min(minX, firstPixel);
+                maxX = std::max(maxX, endPixel);
+            }
+        }
+
+        auto deviceToBrush = D2D1::Matrix3x2F::ReinterpretBaseType(&command.DeviceToBrush);
+        auto row = &m_pixels[static_cast<size_t>(y) * m_width];
+
+        for (uint32_t x = minX; x < maxX; x++)
+        {
+            float pixelCoverage = std::min(coverage[x], 1.0f);
+            coverage[x] = 0;
+
+            if (pixelCoverage <= 0)
+                continue;
+
+            auto brushPoint = deviceToBrush->TransformPoint(D2D1::Point2F(x + 0.5f, y + 0.5f));
+            auto source = Scale(command.Brush.GetColor(brushPoint), pixelCoverage);
+
+            // Source-over blending with premultiplied alpha.
+            auto destination = UnpackPixel(row[x]);
+            float inverseAlpha = 1 - source.a;
+
+            row[x] = PackPixel(D2D1::ColorF(source.r + destination.r * inverseAlpha,
+                                            source.g + destination.g * inverseAlpha,
+                                            source.b + destination.b * inverseAlpha,
+                                            source.a + destination.a * inverseAlpha));
+        }
+    }
+}
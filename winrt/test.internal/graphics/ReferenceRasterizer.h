@@ -0,0 +1,197 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace canvas
+{
+    //
+    // Pixels in premultiplied B8G8R8A8 format, tightly packed.
+    //
+    struct ReferenceBitmap
+    {
+        uint32_t Width;
+        uint32_t Height;
+        std::vector<uint32_t> Pixels;
+    };
+
+    //
+    // Describes how ReferenceRasterizer colors the pixels covered by a shape.
+    //
+    // Positions are in brush space, which Transform maps into the
+    // coordinate space of the shape being filled.  Gradient stops use
+    // straight alpha colors, and are interpolated with premultiplied alpha
+    // and clamped beyond the first and last stop, matching Direct2D's
+    // defaults.
+    //
+    class ReferenceBrush
+    {
+    public:
+        enum class Type
+        {
+            Solid,
+            LinearGradient,
+            RadialGradient,
+            Bitmap
+        };
+
+        static ReferenceBrush Solid(D2D1_COLOR_F const& color);
+
+        static ReferenceBrush LinearGradient(
+            D2D1_POINT_2F startPoint,
+            D2D1_POINT_2F endPoint,
+            std::vector<D2D1_GRADIENT_STOP> stops);
+
+        static ReferenceBrush RadialGradient(
+            D2D1_POINT_2F center,
+            float radiusX,
+            float radiusY,
+            std::vector<D2D1_GRADIENT_STOP> stops);
+
+        static ReferenceBrush Bitmap(
+            std::shared_ptr<ReferenceBitmap const> bitmap,
+            D2D1_BITMAP_INTERPOLATION_MODE interpolationMode);
+
+        ReferenceBrush& SetTransform(D2D1_MATRIX_3X2_F const& transform) { m_transform = transform; return *this; }
+        ReferenceBrush& SetOpacity(float opacity) { m_opacity = opacity; return *this; }
+
+        Type GetType() const { return m_type; }
+        D2D1_MATRIX_3X2_F const& GetTransform() const { return m_transform; }
+
+        // Returns the premultiplied color of the brush at a point in brush space.
+        D2D1_COLOR_F GetColor(D2D1_POINT_2F point) const;
+
+    private:
+        explicit ReferenceBrush(Type type);
+
+        D2D1_COLOR_F GetGradientColor(float position) const;
+        D2D1_COLOR_F GetBitmapColor(D2D1_POINT_2F point) const;
+        D2D1_COLOR_F GetBitmapPixel(int x, int y) const;
+
+        Type m_type;
+        D2D1_MATRIX_3X2_F m_transform;
+        float m_opacity;
+
+        D2D1_COLOR_F m_color;                           // Solid, premultiplied
+        D2D1_POINT_2F m_startPoint;                     // LinearGradient start, or RadialGradient center
+        D2D1_POINT_2F m_endPoint;                       // LinearGradient end, or RadialGradient radii
+        std::vector<D2D1_GRADIENT_STOP> m_stops;        // Sorted by position, premultiplied
+        std::shared_ptr<ReferenceBitmap const> m_bitmap;
+        D2D1_BITMAP_INTERPOLATION_MODE m_interpolationMode;
+    };
+
+    //
+    // A software rasterizer that fills shapes into a premultiplied B8G8R8A8
+    // pixel buffer, without needing a Direct3D device.
+    //
+    // This is a reference implementation for tests: it supports a small
+    // subset of what CanvasDrawingSession can do, following Direct2D's
+    // conventions for each (pixel centers at half-integer coordinates,
+    // source-over blending, per-primitive antialiasing), but is not
+    // intended to be pixel-exact with Direct2D.  The golden-image tests in
+    // test.external compare it, within a tolerance, against
+    // CanvasDrawingSession running on WARP.
+    //
+    // Drawing calls are recorded, and rasterized when the pixels are read
+    // or Flush is called.  Rasterization splits the target into bands of
+    // rows which are processed in parallel, each band drawing every
+    // recorded shape that overlaps it in order.  Results do not depend on
+    // the number of threads used.
+    //
+    // Curves are not supported directly; paths must be flattened into
+    // polygons first, for example using CanvasGeometry.Simplify.
+    //
+    class ReferenceRasterizer
+    {
+    public:
+        static const uint32_t BandHeight = 32;
+        static const int SamplesPerPixelRow = 4;
+
+        ReferenceRasterizer(uint32_t width, uint32_t height);
+
+        uint32_t GetWidth() const { return m_width; }
+        uint32_t GetHeight() const { return m_height; }
+
+        // Zero means one thread per logical processor.
+        void SetMaxThreadCount(unsigned maxThreadCount) { m_maxThreadCount = maxThreadCount; }
+
+        void SetTransform(D2D1_MATRIX_3X2_F const& transform) { m_transform = transform; }
+        D2D1_MATRIX_3X2_F const& GetTransform() const { return m_transform; }
+
+        void Clear(D2D1_COLOR_F const& color);
+
+        void FillRectangle(D2D1_RECT_F const& rect, ReferenceBrush const& brush);
+
+        void FillEllipse(D2D1_ELLIPSE const& ellipse, ReferenceBrush const& brush);
+
+        // Each figure is a closed polygon.
+        void FillPolygons(
+            std::vector<std::vector<D2D1_POINT_2F>> const& figures,
+            D2D1_FILL_MODE fillMode,
+            ReferenceBrush const& brush);
+
+        void DrawBitmap(
+            std::shared_ptr<ReferenceBitmap const> const& bitmap,
+            D2D1_RECT_F const& destinationRect,
+            float opacity = 1.0f,
+            D2D1_BITMAP_INTERPOLATION_MODE interpolationMode = D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
+
+        void Flush();
+
+        // Flushes any pending drawing, then returns the pixels.
+        std::vector<uint32_t> const& GetPixels();
+
+        uint32_t GetPixel(uint32_t x, uint32_t y);
+
+        size_t GetPendingCommandCount() const { return m_commands.size(); }
+
+    private:
+        // Edges are stored in device space, with Y0 < Y1.
+        struct Edge
+        {
+            float X0;
+            float Y0;
+            float X1;
+            float Y1;
+            int Direction;
+        };
+
+        struct Command
+        {
+            std::vector<Edge> Edges;
+            D2D1_FILL_MODE FillMode;
+            ReferenceBrush Brush;
+            D2D1_MATRIX_3X2_F DeviceToBrush;
+            uint32_t FirstRow;
+            uint32_t EndRow;
+        };
+
+        struct Scratch;
+
+        void AddCommand(
+            std::vector<std::vector<D2D1_POINT_2F>> const& figures,
+            D2D1_FILL_MODE fillMode,
+            ReferenceBrush const& brush);
+
+        void RasterizeRows(uint32_t firstRow, uint32_t rowCount);
+
+        void RasterizeRow(Command const& command, uint32_t y, Scratch& scratch);
+
+        uint32_t m_width;
+        uint32_t m_height;
+        unsigned m_maxThreadCount;
+        D2D1_MATRIX_3X2_F m_transform;
+
+        std::vector<uint32_t> m_pixels;
+        std::vector<Command> m_commands;
+    };
+}
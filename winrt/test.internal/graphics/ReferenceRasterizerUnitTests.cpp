@@ -0,0 +1,313 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "ReferenceRasterizer.h"
+
+static const uint32_t sc_opaqueWhite = 0xFFFFFFFF;
+static const uint32_t sc_transparent = 0;
+
+TEST_CLASS(ReferenceRasterizerTests)
+{
+    static ReferenceBrush WhiteBrush()
+    {
+        return ReferenceBrush::Solid(D2D1::ColorF(1, 1, 1, 1));
+    }
+
+    static std::vector<D2D1_GRADIENT_STOP> BlackToWhiteStops()
+    {
+        D2D1_GRADIENT_STOP stops[] =
+        {
+            { 0, D2D1::ColorF(0, 0, 0, 1) },
+            { 1, D2D1::ColorF(1, 1, 1, 1) },
+        };
+
+        return std::vector<D2D1_GRADIENT_STOP>(std::begin(stops), std::end(stops));
+    }
+
+    static void DrawTestScene(ReferenceRasterizer& rasterizer)
+    {
+        rasterizer.Clear(D2D1::ColorF(1, 1, 1, 1));
+
+        for (int i = 0; i < 200; i++)
+        {
+            float x = static_cast<float>((i * 37) % 1000);
+            float y = static_cast<float>((i * 91) % 1000);
+
+            D2D1_ELLIPSE ellipse = { D2D1::Point2F(x, y), 40.0f + i % 30, 25.0f + i % 20 };
+            rasterizer.FillEllipse(ellipse, ReferenceBrush::Solid(D2D1::ColorF((i % 7) / 7.0f, (i % 5) / 5.0f, (i % 3) / 3.0f, 0.6f)));
+
+            rasterizer.FillRectangle(D2D1::RectF(y, x, y + 60, x + 30),
+                ReferenceBrush::LinearGradient(D2D1::Point2F(y, x), D2D1::Point2F(y + 60, x), BlackToWhiteStops()));
+        }
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_Clear)
+    {
+        ReferenceRasterizer rasterizer(8, 8);
+
+        rasterizer.Clear(D2D1::ColorF(1, 0, 0, 0.5f));
+
+        for (auto pixel : rasterizer.GetPixels())
+        {
+            Assert::AreEqual(0x80800000u, pixel);
+        }
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_Clear_DiscardsPendingDrawing)
+    {
+        ReferenceRasterizer rasterizer(8, 8);
+
+        rasterizer.FillRectangle(D2D1::RectF(0, 0, 8, 8), WhiteBrush());
+        Assert::AreEqual<size_t>(1, rasterizer.GetPendingCommandCount());
+
+        rasterizer.Clear(D2D1::ColorF(0, 0, 0, 0));
+        Assert::AreEqual<size_t>(0, rasterizer.GetPendingCommandCount());
+
+        Assert::AreEqual(sc_transparent, rasterizer.GetPixel(4, 4));
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_FillRectangle_PixelAligned)
+    {
+        ReferenceRasterizer rasterizer(8, 8);
+
+        rasterizer.FillRectangle(D2D1::RectF(2, 2, 6, 6), ReferenceBrush::Solid(D2D1::ColorF(0, 0, 1, 1)));
+
+        for (uint32_t y = 0; y < 8; y++)
+        {
+            for (uint32_t x = 0; x < 8; x++)
+            {
+                bool inside = (x >= 2 && x < 6 && y >= 2 && y < 6);
+                Assert::AreEqual(inside ? 0xFF0000FFu : sc_transparent, rasterizer.GetPixel(x, y));
+            }
+        }
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_FillRectangle_PartiallyCoveredPixelsAreAntialiased)
+    {
+        ReferenceRasterizer rasterizer(8, 8);
+
+        rasterizer.FillRectangle(D2D1::RectF(2.5f, 2, 6, 6), WhiteBrush());
+
+        Assert::AreEqual(0x80808080u, rasterizer.GetPixel(2, 3));
+        Assert::AreEqual(sc_opaqueWhite, rasterizer.GetPixel(3, 3));
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_FillRectangle_ClipsToTarget)
+    {
+        ReferenceRasterizer rasterizer(8, 8);
+
+        rasterizer.FillRectangle(D2D1::RectF(-100, -100, 100, 100), WhiteBrush());
+
+        for (auto pixel : rasterizer.GetPixels())
+        {
+            Assert::AreEqual(sc_opaqueWhite, pixel);
+        }
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_FillEllipse_CoversExpectedArea)
+    {
+        ReferenceRasterizer rasterizer(64, 64);
+
+        D2D1_ELLIPSE ellipse = { D2D1::Point2F(32, 32), 20, 20 };
+        rasterizer.FillEllipse(ellipse, WhiteBrush());
+
+        double area = 0;
+
+        for (auto pixel : rasterizer.GetPixels())
+        {
+            area += (pixel >> 24) / 255.0;
+        }
+
+        Assert::AreEqual(3.14159265 * 20 * 20, area, 2.0);
+
+        Assert::AreEqual(sc_opaqueWhite, rasterizer.GetPixel(32, 32));
+        Assert::AreEqual(sc_opaqueWhite, rasterizer.GetPixel(32, 13));
+        Assert::AreEqual(sc_transparent, rasterizer.GetPixel(32, 11));
+        Assert::AreEqual(sc_transparent, rasterizer.GetPixel(16, 16));
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_FillPolygons_FillModes)
+    {
+        // Two squares with the same winding direction, one inside the other.
+        std::vector<std::vector<D2D1_POINT_2F>> figures(2);
+        figures[0] = { D2D1::Point2F(0, 0), D2D1::Point2F(8, 0), D2D1::Point2F(8, 8), D2D1::Point2F(0, 8) };
+        figures[1] = { D2D1::Point2F(2, 2), D2D1::Point2F(6, 2), D2D1::Point2F(6, 6), D2D1::Point2F(2, 6) };
+
+        ReferenceRasterizer winding(8, 8);
+        winding.FillPolygons(figures, D2D1_FILL_MODE_WINDING, WhiteBrush());
+
+        Assert::AreEqual(sc_opaqueWhite, winding.GetPixel(1, 1));
+        Assert::AreEqual(sc_opaqueWhite, winding.GetPixel(4, 4));
+
+        ReferenceRasterizer alternate(8, 8);
+        alternate.FillPolygons(figures, D2D1_FILL_MODE_ALTERNATE, WhiteBrush());
+
+        Assert::AreEqual(sc_opaqueWhite, alternate.GetPixel(1, 1));
+        Assert::AreEqual(sc_transparent, alternate.GetPixel(4, 4));
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_SetTransform)
+    {
+        ReferenceRasterizer rasterizer(8, 8);
+
+        rasterizer.SetTransform(D2D1::Matrix3x2F::Scale(2, 2) * D2D1::Matrix3x2F::Translation(4, 0));
+        rasterizer.FillRectangle(D2D1::RectF(0, 0, 1, 1), WhiteBrush());
+
+        Assert::AreEqual(sc_transparent, rasterizer.GetPixel(0, 0));
+        Assert::AreEqual(sc_transparent, rasterizer.GetPixel(3, 0));
+        Assert::AreEqual(sc_opaqueWhite, rasterizer.GetPixel(4, 0));
+        Assert::AreEqual(sc_opaqueWhite, rasterizer.GetPixel(5, 1));
+        Assert::AreEqual(sc_transparent, rasterizer.GetPixel(6, 0));
+        Assert::AreEqual(sc_transparent, rasterizer.GetPixel(4, 2));
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_SourceOverBlending)
+    {
+        ReferenceRasterizer rasterizer(2, 2);
+
+        rasterizer.Clear(D2D1::ColorF(0, 0, 1, 1));
+        rasterizer.FillRectangle(D2D1::RectF(0, 0, 2, 2), ReferenceBrush::Solid(D2D1::ColorF(1, 0, 0, 0.5f)));
+
+        Assert::AreEqual(0xFF800080u, rasterizer.GetPixel(0, 0));
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_LinearGradient)
+    {
+        ReferenceRasterizer rasterizer(100, 1);
+
+        rasterizer.FillRectangle(D2D1::RectF(0, 0, 100, 1),
+            ReferenceBrush::LinearGradient(D2D1::Point2F(0, 0), D2D1::Point2F(100, 0), BlackToWhiteStops()));
+
+        // Sampled at pixel centers, so the ends are just inside the gradient.
+        Assert::AreEqual(0xFF010101u, rasterizer.GetPixel(0, 0));
+        Assert::AreEqual(0xFF818181u, rasterizer.GetPixel(50, 0));
+        Assert::AreEqual(0xFFFEFEFEu, rasterizer.GetPixel(99, 0));
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_RadialGradient_ClampsBeyondLastStop)
+    {
+        ReferenceRasterizer rasterizer(20, 20);
+
+        rasterizer.FillRectangle(D2D1::RectF(0, 0, 20, 20),
+            ReferenceBrush::RadialGradient(D2D1::Point2F(10, 10), 5, 5, BlackToWhiteStops()));
+
+        Assert::AreEqual(sc_opaqueWhite, rasterizer.GetPixel(0, 0));
+        Assert::AreEqual(sc_opaqueWhite, rasterizer.GetPixel(19, 10));
+
+        // Pixel (10, 10) has its center half a pixel diagonally from the gradient center.
+        auto centerPixel = rasterizer.GetPixel(10, 10);
+        Assert::IsTrue((centerPixel & 0xFF) < 0x30);
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_GradientStopsAreSorted)
+    {
+        D2D1_GRADIENT_STOP stops[] =
+        {
+            { 1, D2D1::ColorF(1, 1, 1, 1) },
+            { 0, D2D1::ColorF(0, 0, 0, 1) },
+        };
+
+        ReferenceRasterizer rasterizer(2, 1);
+
+        rasterizer.FillRectangle(D2D1::RectF(0, 0, 2, 1),
+            ReferenceBrush::LinearGradient(D2D1::Point2F(0.5f, 0), D2D1::Point2F(1.5f, 0), std::vector<D2D1_GRADIENT_STOP>(std::begin(stops), std::end(stops))));
+
+        Assert::AreEqual(0xFF000000u, rasterizer.GetPixel(0, 0));
+        Assert::AreEqual(sc_opaqueWhite, rasterizer.GetPixel(1, 0));
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_DrawBitmap_NearestNeighbor)
+    {
+        auto bitmap = std::make_shared<ReferenceBitmap>();
+        bitmap->Width = 2;
+        bitmap->Height = 2;
+        bitmap->Pixels = { 0xFFFF0000, 0xFF00FF00, 0xFF0000FF, 0xFFFFFFFF };
+
+        ReferenceRasterizer rasterizer(4, 4);
+
+        rasterizer.DrawBitmap(bitmap, D2D1::RectF(0, 0, 4, 4), 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR);
+
+        for (uint32_t y = 0; y < 4; y++)
+        {
+            for (uint32_t x = 0; x < 4; x++)
+            {
+                Assert::AreEqual(bitmap->Pixels[(y / 2) * 2 + (x / 2)], rasterizer.GetPixel(x, y));
+            }
+        }
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_DrawBitmap_LinearWithOpacity)
+    {
+        auto bitmap = std::make_shared<ReferenceBitmap>();
+        bitmap->Width = 2;
+        bitmap->Height = 1;
+        bitmap->Pixels = { 0xFFFF0000, 0xFF0000FF };
+
+        ReferenceRasterizer rasterizer(4, 1);
+
+        rasterizer.DrawBitmap(bitmap, D2D1::RectF(0, 0, 4, 1), 0.5f);
+
+        // The outer pixels are clamped to the edge of the bitmap, while the
+        // inner ones blend a quarter of the way towards their neighbor.
+        Assert::AreEqual(0x80800000u, rasterizer.GetPixel(0, 0));
+        Assert::AreEqual(0x80600020u, rasterizer.GetPixel(1, 0));
+        Assert::AreEqual(0x80200060u, rasterizer.GetPixel(2, 0));
+        Assert::AreEqual(0x80000080u, rasterizer.GetPixel(3, 0));
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_InvalidBrushes)
+    {
+        ExpectHResultException(E_INVALIDARG, [] { ReferenceBrush::LinearGradient(D2D1::Point2F(), D2D1::Point2F(), std::vector<D2D1_GRADIENT_STOP>()); });
+        ExpectHResultException(E_INVALIDARG, [] { ReferenceBrush::Bitmap(nullptr, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR); });
+
+        auto wrongSize = std::make_shared<ReferenceBitmap>();
+        wrongSize->Width = 2;
+        wrongSize->Height = 2;
+        wrongSize->Pixels.resize(3);
+
+        ExpectHResultException(E_INVALIDARG, [&] { ReferenceBrush::Bitmap(wrongSize, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR); });
+    }
+
+    TEST_METHOD_EX(ReferenceRasterizer_ResultDoesNotDependOnThreadCount)
+    {
+        ReferenceRasterizer singleThreaded(1024, 1024);
+        singleThreaded.SetMaxThreadCount(1);
+        DrawTestScene(singleThreaded);
+
+        ReferenceRasterizer multiThreaded(1024, 1024);
+        multiThreaded.SetMaxThreadCount(8);
+        DrawTestScene(multiThreaded);
+
+        Assert::IsTrue(singleThreaded.GetPixels() == multiThreaded.GetPixels());
+    }
+
+    PERF_TEST_METHOD_ATTRIBUTES(ReferenceRasterizer_Throughput)
+    TEST_METHOD_EX(ReferenceRasterizer_Throughput)
+    {
+        for (unsigned threadCount = 1; threadCount <= 8; threadCount *= 2)
+        {
+            ReferenceRasterizer rasterizer(1024, 1024);
+            rasterizer.SetMaxThreadCount(threadCount);
+
+            double seconds = MeasureSeconds(
+                [&]
+                {
+                    DrawTestScene(rasterizer);
+                    rasterizer.Flush();
+                });
+
+            LogPerfMessage(L"%u threads: 400 shapes at 1024x1024 in %.1f ms\n", threadCount, seconds * 1000.0);
+        }
+    }
+};
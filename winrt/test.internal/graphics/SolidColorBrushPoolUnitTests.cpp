@@ -0,0 +1,155 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+using namespace ABI::Windows::UI;
+
+TEST_CLASS(SolidColorBrushPoolTests)
+{
+    class Fixture
+    {
+    public:
+        SolidColorBrushPool Pool;
+        int CreateCount;
+
+        Fixture(size_t capacity = SolidColorBrushPool::DefaultCapacity)
+            : Pool(capacity)
+            , CreateCount(0)
+        {
+        }
+
+        ComPtr<ID2D1SolidColorBrush> GetBrush(Color const& color)
+        {
+            return Pool.GetBrush(color,
+                [&]
+                {
+                    CreateCount++;
+                    return Make<MockD2DSolidColorBrush>();
+                });
+        }
+    };
+
+    static Color MakeColor(int i)
+    {
+        return Color{ 255, static_cast<uint8_t>(i), 0, 0 };
+    }
+
+    TEST_METHOD_EX(SolidColorBrushPool_SameColorReturnsSameBrush)
+    {
+        Fixture f;
+
+        auto brush1 = f.GetBrush(MakeColor(1));
+        auto brush2 = f.GetBrush(MakeColor(1));
+
+        Assert::IsTrue(IsSameInstance(brush1.Get(), brush2.Get()));
+        Assert::AreEqual(1, f.CreateCount);
+        Assert::AreEqual(1U, static_cast<uint32_t>(f.Pool.GetHitCount()));
+        Assert::AreEqual(1U, static_cast<uint32_t>(f.Pool.GetMissCount()));
+    }
+
+    TEST_METHOD_EX(SolidColorBrushPool_DifferentColorsReturnDifferentBrushes)
+    {
+        Fixture f;
+
+        // Colors that only differ in one channel must not be confused
+        auto brush1 = f.GetBrush(Color{ 1, 2, 3, 4 });
+        auto brush2 = f.GetBrush(Color{ 2, 2, 3, 4 });
+        auto brush3 = f.GetBrush(Color{ 1, 2, 3, 5 });
+
+        Assert::IsFalse(IsSameInstance(brush1.Get(), brush2.Get()));
+        Assert::IsFalse(IsSameInstance(brush1.Get(), brush3.Get()));
+        Assert::IsFalse(IsSameInstance(brush2.Get(), brush3.Get()));
+
+        Assert::AreEqual(3, f.CreateCount);
+        Assert::AreEqual(0U, static_cast<uint32_t>(f.Pool.GetHitCount()));
+        Assert::AreEqual(3U, static_cast<uint32_t>(f.Pool.GetMissCount()));
+    }
+
+    TEST_METHOD_EX(SolidColorBrushPool_AlternatingPalette_OnlyMissesOncePerColor)
+    {
+        Fixture f;
+
+        const int paletteSize = 8;
+        const int drawCount = 1000;
+
+        for (int i = 0; i < drawCount; i++)
+        {
+            f.GetBrush(MakeColor(i % paletteSize));
+        }
+
+        Assert::AreEqual(paletteSize, f.CreateCount);
+        Assert::AreEqual(static_cast<uint32_t>(paletteSize), static_cast<uint32_t>(f.Pool.GetMissCount()));
+        Assert::AreEqual(static_cast<uint32_t>(drawCount - paletteSize), static_cast<uint32_t>(f.Pool.GetHitCount()));
+    }
+
+    TEST_METHOD_EX(SolidColorBrushPool_WhenFull_EvictsLeastRecentlyUsed)
+    {
+        Fixture f(3);
+
+        auto brush1 = f.GetBrush(MakeColor(1));
+        f.GetBrush(MakeColor(2));
+        f.GetBrush(MakeColor(3));
+
+        // Touch color 1 so that color 2 becomes the least recently used
+        f.GetBrush(MakeColor(1));
+
+        f.GetBrush(MakeColor(4));
+        Assert::AreEqual(3U, static_cast<uint32_t>(f.Pool.GetBrushCount()));
+        Assert::AreEqual(4, f.CreateCount);
+
+        // Colors 1, 3 and 4 are still pooled
+        Assert::IsTrue(IsSameInstance(brush1.Get(), f.GetBrush(MakeColor(1)).Get()));
+        f.GetBrush(MakeColor(3));
+        f.GetBrush(MakeColor(4));
+        Assert::AreEqual(4, f.CreateCount);
+
+        // Color 2 was evicted
+        f.GetBrush(MakeColor(2));
+        Assert::AreEqual(5, f.CreateCount);
+    }
+
+    TEST_METHOD_EX(SolidColorBrushPool_Clear_ReleasesBrushes)
+    {
+        Fixture f;
+
+        f.GetBrush(MakeColor(1));
+        f.GetBrush(MakeColor(2));
+        Assert::AreEqual(2U, static_cast<uint32_t>(f.Pool.GetBrushCount()));
+
+        f.Pool.Clear();
+        Assert::AreEqual(0U, static_cast<uint32_t>(f.Pool.GetBrushCount()));
+
+        f.GetBrush(MakeColor(1));
+        Assert::AreEqual(3, f.CreateCount);
+    }
+
+    TEST_METHOD_EX(SolidColorBrushPool_WhenCreateThrows_PoolIsUnchanged)
+    {
+        Fixture f;
+
+        ExpectHResultException(E_OUTOFMEMORY,
+            [&]
+            {
+                f.Pool.GetBrush(MakeColor(1),
+                    []() -> ComPtr<ID2D1SolidColorBrush>
+                    {
+                        ThrowHR(E_OUTOFMEMORY);
+                    });
+            });
+
+        Assert::AreEqual(0U, static_cast<uint32_t>(f.Pool.GetBrushCount()));
+
+        f.GetBrush(MakeColor(1));
+        Assert::AreEqual(1, f.CreateCount);
+    }
+};
@@ -0,0 +1,204 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+TEST_CLASS(StagingTexturePoolTests)
+{
+    class Fixture
+    {
+    public:
+        ComPtr<MockD3D11Device> D3DDevice;
+        std::vector<D3D11_TEXTURE2D_DESC> CreatedTextures;
+
+        Fixture()
+            : D3DDevice(Make<MockD3D11Device>())
+        {
+            D3DDevice->CreateTexture2DMethod.AllowAnyCall(
+                [=](D3D11_TEXTURE2D_DESC const* description, D3D11_SUBRESOURCE_DATA const* initialData, ID3D11Texture2D** texture)
+                {
+                    Assert::IsNull(initialData);
+
+                    CreatedTextures.push_back(*description);
+
+                    auto mockTexture = Make<MockD3D11Texture2D>(*description);
+                    return mockTexture.CopyTo(texture);
+                });
+        }
+
+        ComPtr<ID3D11Texture2D> Acquire(
+            StagingTexturePool& pool,
+            uint32_t width,
+            uint32_t height,
+            DXGI_FORMAT format = DXGI_FORMAT_B8G8R8A8_UNORM,
+            UINT cpuAccessFlags = D3D11_CPU_ACCESS_READ)
+        {
+            return pool.Acquire(D3DDevice.Get(), format, width, height, cpuAccessFlags);
+        }
+    };
+
+    TEST_METHOD_EX(StagingTexturePool_Acquire_CreatesStagingTextureRoundedUpToSizeStep)
+    {
+        Fixture f;
+        StagingTexturePool pool;
+
+        auto texture = f.Acquire(pool, 100, 1, DXGI_FORMAT_R8G8B8A8_UNORM, D3D11_CPU_ACCESS_WRITE);
+
+        Assert::IsNotNull(texture.Get());
+        Assert::AreEqual<size_t>(1, f.CreatedTextures.size());
+
+        auto const& description = f.CreatedTextures[0];
+        Assert::AreEqual(128U, description.Width);
+        Assert::AreEqual(64U, description.Height);
+        Assert::AreEqual(1U, description.MipLevels);
+        Assert::AreEqual(1U, description.ArraySize);
+        Assert::AreEqual(DXGI_FORMAT_R8G8B8A8_UNORM, description.Format);
+        Assert::AreEqual(1U, description.SampleDesc.Count);
+        Assert::AreEqual(D3D11_USAGE_STAGING, description.Usage);
+        Assert::AreEqual(0U, description.BindFlags);
+        Assert::AreEqual(static_cast<UINT>(D3D11_CPU_ACCESS_WRITE), description.CPUAccessFlags);
+        Assert::AreEqual(0U, description.MiscFlags);
+    }
+
+    TEST_METHOD_EX(StagingTexturePool_RepeatedAcquireAndRelease_CreatesOneTexture)
+    {
+        Fixture f;
+        StagingTexturePool pool;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            auto texture = f.Acquire(pool, 256, 256);
+            pool.Release(texture.Get());
+        }
+
+        Assert::AreEqual<size_t>(1, f.CreatedTextures.size());
+        Assert::AreEqual<uint64_t>(99, pool.GetHitCount());
+        Assert::AreEqual<uint64_t>(1, pool.GetMissCount());
+        Assert::AreEqual<size_t>(1, pool.GetIdleTextureCount());
+    }
+
+    TEST_METHOD_EX(StagingTexturePool_SizesWithinSameStep_ShareTexture)
+    {
+        Fixture f;
+        StagingTexturePool pool;
+
+        auto texture1 = f.Acquire(pool, 65, 10);
+        pool.Release(texture1.Get());
+
+        auto texture2 = f.Acquire(pool, 128, 64);
+
+        Assert::IsTrue(IsSameInstance(texture1.Get(), texture2.Get()));
+        Assert::AreEqual<size_t>(1, f.CreatedTextures.size());
+    }
+
+    TEST_METHOD_EX(StagingTexturePool_TexturesInUse_AreNotShared)
+    {
+        Fixture f;
+        StagingTexturePool pool;
+
+        auto texture1 = f.Acquire(pool, 32, 32);
+        auto texture2 = f.Acquire(pool, 32, 32);
+
+        Assert::IsFalse(IsSameInstance(texture1.Get(), texture2.Get()));
+        Assert::AreEqual<size_t>(2, f.CreatedTextures.size());
+    }
+
+    TEST_METHOD_EX(StagingTexturePool_DifferentFormatSizeOrCpuAccess_DoNotShareTexture)
+    {
+        Fixture f;
+        StagingTexturePool pool;
+
+        auto texture = f.Acquire(pool, 32, 32);
+        pool.Release(texture.Get());
+
+        f.Acquire(pool, 32, 32, DXGI_FORMAT_R8G8B8A8_UNORM);
+        f.Acquire(pool, 32, 32, DXGI_FORMAT_B8G8R8A8_UNORM, D3D11_CPU_ACCESS_WRITE);
+        f.Acquire(pool, 32, 65);
+
+        Assert::AreEqual<size_t>(4, f.CreatedTextures.size());
+        Assert::AreEqual<uint64_t>(0, pool.GetHitCount());
+        Assert::AreEqual<size_t>(1, pool.GetIdleTextureCount());
+    }
+
+    TEST_METHOD_EX(StagingTexturePool_WhenOverBudget_LeastRecentlyReleasedTexturesAreDropped)
+    {
+        Fixture f;
+
+        // Room for two 64x64 B8G8R8A8 textures
+        StagingTexturePool pool(2 * 64 * 64 * 4);
+
+        auto texture1 = f.Acquire(pool, 64, 64);
+        auto texture2 = f.Acquire(pool, 64, 64, DXGI_FORMAT_R8G8B8A8_UNORM);
+        auto texture3 = f.Acquire(pool, 64, 64, DXGI_FORMAT_B8G8R8A8_UNORM, D3D11_CPU_ACCESS_WRITE);
+
+        pool.Release(texture1.Get());
+        pool.Release(texture2.Get());
+        pool.Release(texture3.Get());
+
+        Assert::AreEqual<size_t>(2, pool.GetIdleTextureCount());
+        Assert::AreEqual<uint64_t>(2 * 64 * 64 * 4, pool.GetIdleSizeInBytes());
+
+        // texture1 was released first, so it is the one that was dropped
+        auto reacquired1 = f.Acquire(pool, 64, 64);
+        auto reacquired3 = f.Acquire(pool, 64, 64, DXGI_FORMAT_B8G8R8A8_UNORM, D3D11_CPU_ACCESS_WRITE);
+
+        Assert::IsFalse(IsSameInstance(texture1.Get(), reacquired1.Get()));
+        Assert::IsTrue(IsSameInstance(texture3.Get(), reacquired3.Get()));
+    }
+
+    TEST_METHOD_EX(StagingTexturePool_TextureLargerThanBudget_IsNotKept)
+    {
+        Fixture f;
+        StagingTexturePool pool(64 * 64 * 4);
+
+        auto texture = f.Acquire(pool, 128, 128);
+        pool.Release(texture.Get());
+
+        Assert::AreEqual<size_t>(0, pool.GetIdleTextureCount());
+        Assert::AreEqual<uint64_t>(0, pool.GetIdleSizeInBytes());
+    }
+
+    TEST_METHOD_EX(StagingTexturePool_Clear_EmptiesPool)
+    {
+        Fixture f;
+        StagingTexturePool pool;
+
+        auto texture = f.Acquire(pool, 64, 64);
+        pool.Release(texture.Get());
+
+        pool.Clear();
+
+        Assert::AreEqual<size_t>(0, pool.GetIdleTextureCount());
+        Assert::AreEqual<uint64_t>(0, pool.GetIdleSizeInBytes());
+
+        f.Acquire(pool, 64, 64);
+        Assert::AreEqual<size_t>(2, f.CreatedTextures.size());
+    }
+
+    TEST_METHOD_EX(StagingTexturePool_WhenCreateTextureFails_ErrorIsPropagated)
+    {
+        StagingTexturePool pool;
+        auto d3dDevice = Make<MockD3D11Device>();
+
+        d3dDevice->CreateTexture2DMethod.SetExpectedCalls(1,
+            [](D3D11_TEXTURE2D_DESC const*, D3D11_SUBRESOURCE_DATA const*, ID3D11Texture2D**)
+            {
+                return E_OUTOFMEMORY;
+            });
+
+        ExpectHResultException(E_OUTOFMEMORY,
+            [&]
+            {
+                pool.Acquire(d3dDevice.Get(), DXGI_FORMAT_B8G8R8A8_UNORM, 1, 1, D3D11_CPU_ACCESS_READ);
+            });
+    }
+};
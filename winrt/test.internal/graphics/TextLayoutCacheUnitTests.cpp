@@ -0,0 +1,250 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include "mocks/MockDWriteTextLayout.h"
+
+TEST_CLASS(TextLayoutCacheTests)
+{
+    class Fixture
+    {
+    public:
+        TextLayoutCache Cache;
+        ComPtr<IDWriteTextFormat> Format;
+        int CreateCount;
+
+        Fixture(size_t maximumEntryCount = 16, size_t maximumCharacterCount = TextLayoutCache::DefaultMaximumCharacterCount)
+            : Format(Make<MockDWriteTextLayout>())
+            , CreateCount(0)
+        {
+            Cache.SetLimits(maximumEntryCount, maximumCharacterCount);
+        }
+
+        ComPtr<IDWriteTextLayout> GetLayout(
+            std::wstring const& text,
+            float width = 100,
+            float height = 50,
+            uint32_t options = 0,
+            uint32_t formatChangeCount = 0,
+            IDWriteTextFormat* format = nullptr)
+        {
+            return Cache.GetLayout(
+                text.c_str(),
+                static_cast<uint32_t>(text.size()),
+                format ? format : Format.Get(),
+                formatChangeCount,
+                width,
+                height,
+                options,
+                [&]
+                {
+                    CreateCount++;
+                    return Make<MockDWriteTextLayout>();
+                });
+        }
+    };
+
+    TEST_METHOD_EX(TextLayoutCache_IsDisabledByDefault)
+    {
+        TextLayoutCache cache;
+
+        Assert::IsFalse(cache.IsEnabled());
+        Assert::AreEqual(0U, static_cast<uint32_t>(cache.GetMaximumEntryCount()));
+        Assert::AreEqual(static_cast<uint32_t>(TextLayoutCache::DefaultMaximumCharacterCount), static_cast<uint32_t>(cache.GetMaximumCharacterCount()));
+
+        // Layouts are still created, but are not kept.
+        int createCount = 0;
+
+        for (int i = 0; i < 2; i++)
+        {
+            cache.GetLayout(L"a", 1, Make<MockDWriteTextLayout>().Get(), 0, 1, 1, 0,
+                [&]
+                {
+                    createCount++;
+                    return Make<MockDWriteTextLayout>();
+                });
+        }
+
+        Assert::AreEqual(2, createCount);
+        Assert::AreEqual(0U, static_cast<uint32_t>(cache.GetEntryCount()));
+    }
+
+    TEST_METHOD_EX(TextLayoutCache_SameKeyReturnsSameLayout)
+    {
+        Fixture f;
+
+        auto layout1 = f.GetLayout(L"Score: 100");
+        auto layout2 = f.GetLayout(L"Score: 100");
+
+        Assert::IsTrue(IsSameInstance(layout1.Get(), layout2.Get()));
+        Assert::AreEqual(1, f.CreateCount);
+        Assert::AreEqual(1U, static_cast<uint32_t>(f.Cache.GetHitCount()));
+        Assert::AreEqual(1U, static_cast<uint32_t>(f.Cache.GetMissCount()));
+        Assert::AreEqual(1U, static_cast<uint32_t>(f.Cache.GetEntryCount()));
+        Assert::AreEqual(10U, static_cast<uint32_t>(f.Cache.GetCharacterCount()));
+    }
+
+    TEST_METHOD_EX(TextLayoutCache_EachPartOfTheKeyIsSignificant)
+    {
+        Fixture f;
+        auto otherFormat = Make<MockDWriteTextLayout>();
+
+        f.GetLayout(L"abc");
+        f.GetLayout(L"abd");
+        f.GetLayout(L"ab");
+        f.GetLayout(L"abc", 101);
+        f.GetLayout(L"abc", 100, 51);
+        f.GetLayout(L"abc", 100, 50, 1);
+        f.GetLayout(L"abc", 100, 50, 0, 1);
+        f.GetLayout(L"abc", 100, 50, 0, 0, otherFormat.Get());
+
+        Assert::AreEqual(8, f.CreateCount);
+        Assert::AreEqual(0U, static_cast<uint32_t>(f.Cache.GetHitCount()));
+    }
+
+    TEST_METHOD_EX(TextLayoutCache_RepeatedLabels_OnlyMissOncePerLabel)
+    {
+        Fixture f(64);
+
+        const int labelCount = 20;
+        const int frameCount = 50;
+
+        for (int frame = 0; frame < frameCount; frame++)
+        {
+            for (int i = 0; i < labelCount; i++)
+            {
+                f.GetLayout(L"Label " + std::to_wstring(i));
+            }
+        }
+
+        Assert::AreEqual(labelCount, f.CreateCount);
+        Assert::AreEqual(static_cast<uint32_t>(labelCount), static_cast<uint32_t>(f.Cache.GetMissCount()));
+        Assert::AreEqual(static_cast<uint32_t>(labelCount * (frameCount - 1)), static_cast<uint32_t>(f.Cache.GetHitCount()));
+    }
+
+    TEST_METHOD_EX(TextLayoutCache_WhenEntryCountIsExceeded_EvictsLeastRecentlyUsed)
+    {
+        Fixture f(3);
+
+        auto layout1 = f.GetLayout(L"1");
+        f.GetLayout(L"2");
+        f.GetLayout(L"3");
+
+        // Touch "1" so that "2" becomes the least recently used
+        f.GetLayout(L"1");
+
+        f.GetLayout(L"4");
+        Assert::AreEqual(3U, static_cast<uint32_t>(f.Cache.GetEntryCount()));
+        Assert::AreEqual(4, f.CreateCount);
+
+        Assert::IsTrue(IsSameInstance(layout1.Get(), f.GetLayout(L"1").Get()));
+        f.GetLayout(L"3");
+        f.GetLayout(L"4");
+        Assert::AreEqual(4, f.CreateCount);
+
+        f.GetLayout(L"2");
+        Assert::AreEqual(5, f.CreateCount);
+    }
+
+    TEST_METHOD_EX(TextLayoutCache_WhenCharacterCountIsExceeded_EvictsLeastRecentlyUsed)
+    {
+        Fixture f(16, 10);
+
+        f.GetLayout(L"aaaa");
+        f.GetLayout(L"bbbb");
+        Assert::AreEqual(8U, static_cast<uint32_t>(f.Cache.GetCharacterCount()));
+
+        f.GetLayout(L"cccc");
+        Assert::AreEqual(2U, static_cast<uint32_t>(f.Cache.GetEntryCount()));
+        Assert::AreEqual(8U, static_cast<uint32_t>(f.Cache.GetCharacterCount()));
+
+        f.GetLayout(L"bbbb");
+        f.GetLayout(L"cccc");
+        Assert::AreEqual(3, f.CreateCount);
+
+        f.GetLayout(L"aaaa");
+        Assert::AreEqual(4, f.CreateCount);
+    }
+
+    TEST_METHOD_EX(TextLayoutCache_TextLongerThanCharacterLimit_IsNotCached)
+    {
+        Fixture f(16, 4);
+
+        f.GetLayout(L"abc");
+        f.GetLayout(L"too long");
+        f.GetLayout(L"too long");
+
+        Assert::AreEqual(3, f.CreateCount);
+        Assert::AreEqual(1U, static_cast<uint32_t>(f.Cache.GetEntryCount()));
+        Assert::AreEqual(3U, static_cast<uint32_t>(f.Cache.GetCharacterCount()));
+
+        // The short entry was not pushed out by the long text.
+        f.GetLayout(L"abc");
+        Assert::AreEqual(3, f.CreateCount);
+    }
+
+    TEST_METHOD_EX(TextLayoutCache_ReducingLimits_TrimsCache)
+    {
+        Fixture f;
+
+        f.GetLayout(L"1");
+        f.GetLayout(L"2");
+        f.GetLayout(L"3");
+
+        f.Cache.SetLimits(1, TextLayoutCache::DefaultMaximumCharacterCount);
+        Assert::AreEqual(1U, static_cast<uint32_t>(f.Cache.GetEntryCount()));
+
+        f.GetLayout(L"3");
+        Assert::AreEqual(3, f.CreateCount);
+
+        f.Cache.SetLimits(0, TextLayoutCache::DefaultMaximumCharacterCount);
+        Assert::IsFalse(f.Cache.IsEnabled());
+        Assert::AreEqual(0U, static_cast<uint32_t>(f.Cache.GetEntryCount()));
+        Assert::AreEqual(0U, static_cast<uint32_t>(f.Cache.GetCharacterCount()));
+    }
+
+    TEST_METHOD_EX(TextLayoutCache_Clear_ReleasesLayouts)
+    {
+        Fixture f;
+
+        f.GetLayout(L"1");
+        f.GetLayout(L"2");
+
+        f.Cache.Clear();
+        Assert::AreEqual(0U, static_cast<uint32_t>(f.Cache.GetEntryCount()));
+        Assert::AreEqual(0U, static_cast<uint32_t>(f.Cache.GetCharacterCount()));
+
+        f.GetLayout(L"1");
+        Assert::AreEqual(3, f.CreateCount);
+    }
+
+    TEST_METHOD_EX(TextLayoutCache_WhenCreateThrows_CacheIsUnchanged)
+    {
+        Fixture f;
+
+        ExpectHResultException(E_OUTOFMEMORY,
+            [&]
+            {
+                f.Cache.GetLayout(L"1", 1, f.Format.Get(), 0, 1, 1, 0,
+                    []() -> ComPtr<IDWriteTextLayout>
+                    {
+                        ThrowHR(E_OUTOFMEMORY);
+                    });
+            });
+
+        Assert::AreEqual(0U, static_cast<uint32_t>(f.Cache.GetEntryCount()));
+
+        f.GetLayout(L"1");
+        Assert::AreEqual(1, f.CreateCount);
+    }
+};
@@ -55,6 +55,14 @@ namespace canvas
         CALL_COUNTER_WITH_MOCK(TrimMethod, HRESULT());
         CALL_COUNTER_WITH_MOCK(GetInterfaceMethod, HRESULT(REFIID,void**));
         CALL_COUNTER_WITH_MOCK(CreateDeviceContextMethod, ComPtr<ID2D1DeviceContext1>());
+        CALL_COUNTER_WITH_MOCK(AcquirePooledDeviceContextMethod, ComPtr<ID2D1DeviceContext1>());
+        CALL_COUNTER_WITH_MOCK(ReleasePooledDeviceContextMethod, void(ID2D1DeviceContext1*));
+        CALL_COUNTER_WITH_MOCK(GetStagingTexturePoolMethod, std::shared_ptr<StagingTexturePool>());
+        CALL_COUNTER_WITH_MOCK(GetPixelBufferPoolMethod, std::shared_ptr<PixelBufferPool>());
+        CALL_COUNTER_WITH_MOCK(GetPixelReadbackQueueMethod, std::shared_ptr<PixelReadbackQueue>());
+        CALL_COUNTER_WITH_MOCK(GetSolidColorBrushMethod, ComPtr<ID2D1SolidColorBrush>(ABI::Windows::UI::Color const&));
+        CALL_COUNTER_WITH_MOCK(GetTextLayoutCacheMethod, TextLayoutCache*());
+        CALL_COUNTER_WITH_MOCK(GetTessellationCacheMethod, Geometry::TessellationCache*());
         CALL_COUNTER_WITH_MOCK(CreateSwapChainForCompositionMethod, ComPtr<IDXGISwapChain1>(int32_t, int32_t, DirectXPixelFormat, int32_t, CanvasAlphaMode));
         CALL_COUNTER_WITH_MOCK(CreateSwapChainForCoreWindowMethod, ComPtr<IDXGISwapChain1>(ICoreWindow*, int32_t, int32_t, DirectXPixelFormat, int32_t, CanvasAlphaMode));
         CALL_COUNTER_WITH_MOCK(CreateCommandListMethod, ComPtr<ID2D1CommandList>());
@@ -124,6 +132,72 @@ namespace canvas
             return RaiseDeviceLostMethod.WasCalled();
         }
 
+        IFACEMETHODIMP get_TextLayoutCacheMaximumEntryCount(int32_t* value) override
+        {
+            Assert::Fail(L"Unexpected call to get_TextLayoutCacheMaximumEntryCount");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP put_TextLayoutCacheMaximumEntryCount(int32_t value) override
+        {
+            Assert::Fail(L"Unexpected call to put_TextLayoutCacheMaximumEntryCount");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP get_TextLayoutCacheMaximumCharacterCount(int32_t* value) override
+        {
+            Assert::Fail(L"Unexpected call to get_TextLayoutCacheMaximumCharacterCount");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP put_TextLayoutCacheMaximumCharacterCount(int32_t value) override
+        {
+            Assert::Fail(L"Unexpected call to put_TextLayoutCacheMaximumCharacterCount");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP GetTextLayoutCacheStatistics(CanvasTextLayoutCacheStatistics* value) override
+        {
+            Assert::Fail(L"Unexpected call to GetTextLayoutCacheStatistics");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP get_TessellationCacheMaximumByteCount(int64_t* value) override
+        {
+            Assert::Fail(L"Unexpected call to get_TessellationCacheMaximumByteCount");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP put_TessellationCacheMaximumByteCount(int64_t value) override
+        {
+            Assert::Fail(L"Unexpected call to put_TessellationCacheMaximumByteCount");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP GetTessellationCacheStatistics(CanvasTessellationCacheStatistics* value) override
+        {
+            Assert::Fail(L"Unexpected call to GetTessellationCacheStatistics");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP get_MaximumPixelReadbacksInFlight(int32_t* value) override
+        {
+            Assert::Fail(L"Unexpected call to get_MaximumPixelReadbacksInFlight");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP put_MaximumPixelReadbacksInFlight(int32_t value) override
+        {
+            Assert::Fail(L"Unexpected call to put_MaximumPixelReadbacksInFlight");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP GetPixelReadbackStatistics(CanvasPixelReadbackStatistics* value) override
+        {
+            Assert::Fail(L"Unexpected call to GetPixelReadbackStatistics");
+            return E_NOTIMPL;
+        }
+
         //
         // ICanvasResourceCreator
         //
@@ -177,6 +251,31 @@ namespace canvas
             return CreateDeviceContextMethod.WasCalled();
         }
 
+        virtual ComPtr<ID2D1DeviceContext1> AcquirePooledDeviceContext() override
+        {
+            return AcquirePooledDeviceContextMethod.WasCalled();
+        }
+
+        virtual void ReleasePooledDeviceContext(ID2D1DeviceContext1* deviceContext) override
+        {
+            ReleasePooledDeviceContextMethod.WasCalled(deviceContext);
+        }
+
+        virtual std::shared_ptr<StagingTexturePool> GetStagingTexturePool() override
+        {
+            return GetStagingTexturePoolMethod.WasCalled();
+        }
+
+        virtual std::shared_ptr<PixelBufferPool> GetPixelBufferPool() override
+        {
+            return GetPixelBufferPoolMethod.WasCalled();
+        }
+
+        virtual std::shared_ptr<PixelReadbackQueue> GetPixelReadbackQueue() override
+        {
+            return GetPixelReadbackQueueMethod.WasCalled();
+        }
+
         virtual ComPtr<ID2D1SolidColorBrush> CreateSolidColorBrush(D2D1_COLOR_F const& color) override
         {
             if (!MockCreateSolidColorBrush)
@@ -188,6 +287,21 @@ namespace canvas
             return MockCreateSolidColorBrush(color);
         }
 
+        virtual ComPtr<ID2D1SolidColorBrush> GetSolidColorBrush(ABI::Windows::UI::Color const& color) override
+        {
+            return GetSolidColorBrushMethod.WasCalled(color);
+        }
+
+        virtual TextLayoutCache* GetTextLayoutCache() override
+        {
+            return GetTextLayoutCacheMethod.WasCalled();
+        }
+
+        virtual Geometry::TessellationCache* GetTessellationCache() override
+        {
+            return GetTessellationCacheMethod.WasCalled();
+        }
+
         virtual ComPtr<ID2D1Bitmap1> CreateBitmapFromWicResource(
             IWICBitmapSource* converter,
             float dpi,
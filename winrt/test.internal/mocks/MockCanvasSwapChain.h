@@ -20,6 +20,7 @@ namespace canvas
         CALL_COUNTER_WITH_MOCK(PresentMethod, HRESULT());
         CALL_COUNTER_WITH_MOCK(CreateDrawingSessionMethod, HRESULT(Color, ICanvasDrawingSession**));
         CALL_COUNTER_WITH_MOCK(put_TransformMethod, HRESULT(Matrix3x2));
+        CALL_COUNTER_WITH_MOCK(put_SourceSizeMethod, HRESULT(Size));
 
         MockCanvasSwapChain(
             ICanvasDevice* device,
@@ -30,6 +31,7 @@ namespace canvas
             : CanvasSwapChain(device, manager, adapter, dxgiSwapChain, dpi)
         {
             CreateDrawingSessionMethod.AllowAnyCall();
+            put_SourceSizeMethod.AllowAnyCall();
         }
 
         IFACEMETHOD(CreateDrawingSession)(
@@ -101,8 +103,7 @@ namespace canvas
 
         IFACEMETHOD(put_SourceSize)(Size value) override
         {
-            Assert::Fail(L"Unexpected call to put_SourceSize");
-            return E_NOTIMPL;
+            return put_SourceSizeMethod.WasCalled(value);
         }
 
         IFACEMETHOD(get_TransformMatrix)(Matrix3x2* value) override
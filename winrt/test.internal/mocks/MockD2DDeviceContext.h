@@ -21,7 +21,11 @@ namespace canvas
 
     class MockD2DDeviceContext : public RuntimeClass<
         RuntimeClassFlags<ClassicCom>,
+#if WINVER > 0x0603
+        ChainInterfaces<ID2D1DeviceContext3, ID2D1DeviceContext2, ID2D1DeviceContext1, ID2D1DeviceContext, ID2D1RenderTarget, ID2D1Resource>>
+#else
         ChainInterfaces<ID2D1DeviceContext1, ID2D1DeviceContext, ID2D1RenderTarget, ID2D1Resource>>
+#endif
     {
     public:
         CALL_COUNTER_WITH_MOCK(ClearMethod                           , void(D2D1_COLOR_F const*));
@@ -35,6 +39,10 @@ namespace canvas
         CALL_COUNTER_WITH_MOCK(SetTextAntialiasModeMethod            , void(D2D1_TEXT_ANTIALIAS_MODE));
         CALL_COUNTER_WITH_MOCK(GetUnitModeMethod                     , D2D1_UNIT_MODE());
         CALL_COUNTER_WITH_MOCK(SetUnitModeMethod                     , void(D2D1_UNIT_MODE));
+        CALL_COUNTER_WITH_MOCK(SetTextRenderingParamsMethod          , void(IDWriteRenderingParams*));
+        CALL_COUNTER_WITH_MOCK(SetTagsMethod                         , void(D2D1_TAG, D2D1_TAG));
+        CALL_COUNTER_WITH_MOCK(SetRenderingControlsMethod            , void(D2D1_RENDERING_CONTROLS const*));
+        CALL_COUNTER_WITH_MOCK(GetRenderingControlsMethod            , void(D2D1_RENDERING_CONTROLS*));
         CALL_COUNTER_WITH_MOCK(SetDpiMethod                          , void(float dpiX, float dpiY));
         CALL_COUNTER_WITH_MOCK(GetDpiMethod                          , void(float* dpiX, float* dpiY));
         CALL_COUNTER_WITH_MOCK(DrawLineMethod                        , void(D2D1_POINT_2F,D2D1_POINT_2F,ID2D1Brush*,float,ID2D1StrokeStyle*));
@@ -72,8 +80,22 @@ namespace canvas
         CALL_COUNTER_WITH_MOCK(PopAxisAlignedClipMethod              , void());
         CALL_COUNTER_WITH_MOCK(FillOpacityMaskMethod                 , void(ID2D1Bitmap*, ID2D1Brush*, D2D1_RECT_F const*, D2D1_RECT_F const*));
 
+#if WINVER > 0x0603
+        CALL_COUNTER_WITH_MOCK(CreateSpriteBatchMethod               , HRESULT(ID2D1SpriteBatch**));
+        CALL_COUNTER_WITH_MOCK(DrawSpriteBatchMethod                 , void(ID2D1SpriteBatch*, UINT32, UINT32, ID2D1Bitmap*, D2D1_BITMAP_INTERPOLATION_MODE, D2D1_SPRITE_OPTIONS));
+
+        // ID2D1DeviceContext2 and 3 are only exposed to tests that ask for
+        // them, so that by default code sees the same device context it
+        // would on Windows 8.1.
+        bool IsDeviceContext3Supported;
+#endif
+
         MockD2DDeviceContext()
         {
+#if WINVER > 0x0603
+            IsDeviceContext3Supported = false;
+#endif
+
             CreateSolidColorBrushMethod.AllowAnyCall(
                 [](D2D1_COLOR_F const*, D2D1_BRUSH_PROPERTIES const*, ID2D1SolidColorBrush** theValue)
                 {
@@ -82,6 +104,20 @@ namespace canvas
                 });
         }
 
+#if WINVER > 0x0603
+        STDMETHOD(QueryInterface)(REFIID riid, _Outptr_result_nullonfailure_ void **ppvObject)
+        {
+            if (!IsDeviceContext3Supported &&
+                (riid == __uuidof(ID2D1DeviceContext3) || riid == __uuidof(ID2D1DeviceContext2)))
+            {
+                *ppvObject = nullptr;
+                return E_NOINTERFACE;
+            }
+
+            return RuntimeClass::QueryInterface(riid, ppvObject);
+        }
+#endif
+
         // ID2D1Resource
 
         IFACEMETHODIMP_(void) GetFactory(ID2D1Factory **) const override
@@ -274,9 +310,9 @@ namespace canvas
             return GetTextAntialiasModeMethod.WasCalled();
         }
 
-        IFACEMETHODIMP_(void) SetTextRenderingParams(IDWriteRenderingParams *) override
+        IFACEMETHODIMP_(void) SetTextRenderingParams(IDWriteRenderingParams* params) override
         {
-            Assert::Fail(L"Unexpected call to SetTextRenderingParams");
+            SetTextRenderingParamsMethod.WasCalled(params);
         }
 
         IFACEMETHODIMP_(void) GetTextRenderingParams(IDWriteRenderingParams **) const override
@@ -284,9 +320,9 @@ namespace canvas
             Assert::Fail(L"Unexpected call to GetTextRenderingParams");
         }
 
-        IFACEMETHODIMP_(void) SetTags(D2D1_TAG,D2D1_TAG) override
+        IFACEMETHODIMP_(void) SetTags(D2D1_TAG tag1, D2D1_TAG tag2) override
         {
-            Assert::Fail(L"Unexpected call to SetTags");
+            SetTagsMethod.WasCalled(tag1, tag2);
         }
 
         IFACEMETHODIMP_(void) GetTags(D2D1_TAG *,D2D1_TAG *) const override
@@ -496,14 +532,14 @@ namespace canvas
             return GetTargetMethod.WasCalled(target);
         }
 
-        IFACEMETHODIMP_(void) SetRenderingControls(const D2D1_RENDERING_CONTROLS *) override
+        IFACEMETHODIMP_(void) SetRenderingControls(const D2D1_RENDERING_CONTROLS* renderingControls) override
         {
-            Assert::Fail(L"Unexpected call to SetRenderingControls");
+            SetRenderingControlsMethod.WasCalled(renderingControls);
         }
 
-        IFACEMETHODIMP_(void) GetRenderingControls(D2D1_RENDERING_CONTROLS *) const override
+        IFACEMETHODIMP_(void) GetRenderingControls(D2D1_RENDERING_CONTROLS* renderingControls) const override
         {
-            Assert::Fail(L"Unexpected call to GetRenderingControls");
+            GetRenderingControlsMethod.WasCalled(renderingControls);
         }
 
         IFACEMETHODIMP_(void) SetPrimitiveBlend(D2D1_PRIMITIVE_BLEND b) override
@@ -591,5 +627,92 @@ namespace canvas
         {
             return DrawGeometryRealizationMethod.WasCalled(geometryRealization, brush);
         }
+
+#if WINVER > 0x0603
+
+        // ID2D1DeviceContext2
+
+        IFACEMETHODIMP CreateInk(D2D1_INK_POINT const*, ID2D1Ink**) override
+        {
+            Assert::Fail(L"Unexpected call to CreateInk");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP CreateInkStyle(D2D1_INK_STYLE_PROPERTIES const*, ID2D1InkStyle**) override
+        {
+            Assert::Fail(L"Unexpected call to CreateInkStyle");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP CreateGradientMesh(D2D1_GRADIENT_MESH_PATCH const*, UINT32, ID2D1GradientMesh**) override
+        {
+            Assert::Fail(L"Unexpected call to CreateGradientMesh");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP CreateImageSourceFromWic(IWICBitmapSource*, D2D1_IMAGE_SOURCE_LOADING_OPTIONS, D2D1_ALPHA_MODE, ID2D1ImageSourceFromWic**) override
+        {
+            Assert::Fail(L"Unexpected call to CreateImageSourceFromWic");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP CreateLookupTable3D(D2D1_BUFFER_PRECISION, UINT32 const*, BYTE const*, UINT32, UINT32 const*, ID2D1LookupTable3D**) override
+        {
+            Assert::Fail(L"Unexpected call to CreateLookupTable3D");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP CreateImageSourceFromDxgi(IDXGISurface**, UINT32, DXGI_COLOR_SPACE_TYPE, D2D1_IMAGE_SOURCE_FROM_DXGI_OPTIONS, ID2D1ImageSource**) override
+        {
+            Assert::Fail(L"Unexpected call to CreateImageSourceFromDxgi");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP GetGradientMeshWorldBounds(ID2D1GradientMesh*, D2D1_RECT_F*) const override
+        {
+            Assert::Fail(L"Unexpected call to GetGradientMeshWorldBounds");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP_(void) DrawInk(ID2D1Ink*, ID2D1Brush*, ID2D1InkStyle*) override
+        {
+            Assert::Fail(L"Unexpected call to DrawInk");
+        }
+
+        IFACEMETHODIMP_(void) DrawGradientMesh(ID2D1GradientMesh*) override
+        {
+            Assert::Fail(L"Unexpected call to DrawGradientMesh");
+        }
+
+        IFACEMETHODIMP_(void) DrawGdiMetafile(ID2D1GdiMetafile*, D2D1_RECT_F const*, D2D1_RECT_F const*) override
+        {
+            Assert::Fail(L"Unexpected call to DrawGdiMetafile");
+        }
+
+        IFACEMETHODIMP CreateTransformedImageSource(ID2D1ImageSource*, D2D1_TRANSFORMED_IMAGE_SOURCE_PROPERTIES const*, ID2D1TransformedImageSource**) override
+        {
+            Assert::Fail(L"Unexpected call to CreateTransformedImageSource");
+            return E_NOTIMPL;
+        }
+
+        // ID2D1DeviceContext3
+
+        IFACEMETHODIMP CreateSpriteBatch(ID2D1SpriteBatch** spriteBatch) override
+        {
+            return CreateSpriteBatchMethod.WasCalled(spriteBatch);
+        }
+
+        IFACEMETHODIMP_(void) DrawSpriteBatch(
+            ID2D1SpriteBatch* spriteBatch,
+            UINT32 startIndex,
+            UINT32 spriteCount,
+            ID2D1Bitmap* bitmap,
+            D2D1_BITMAP_INTERPOLATION_MODE interpolationMode,
+            D2D1_SPRITE_OPTIONS spriteOptions) override
+        {
+            DrawSpriteBatchMethod.WasCalled(spriteBatch, startIndex, spriteCount, bitmap, interpolationMode, spriteOptions);
+        }
+
+#endif
     };
 }
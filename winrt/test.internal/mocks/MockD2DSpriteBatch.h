@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#if WINVER > 0x0603
+
+namespace canvas
+{
+    class MockD2DSpriteBatch : public RuntimeClass<
+        RuntimeClassFlags<ClassicCom>,
+        ChainInterfaces<ID2D1SpriteBatch, ID2D1Resource>>
+    {
+    public:
+        CALL_COUNTER_WITH_MOCK(AddSpritesMethod, HRESULT(UINT32, D2D1_RECT_F const*, D2D1_RECT_U const*, D2D1_COLOR_F const*, D2D1_MATRIX_3X2_F const*, UINT32, UINT32, UINT32, UINT32));
+
+        IFACEMETHODIMP_(void) GetFactory(ID2D1Factory**) const override
+        {
+            Assert::Fail(L"Unexpected call to GetFactory");
+        }
+
+        IFACEMETHODIMP AddSprites(
+            UINT32 spriteCount,
+            D2D1_RECT_F const* destinationRectangles,
+            D2D1_RECT_U const* sourceRectangles,
+            D2D1_COLOR_F const* colors,
+            D2D1_MATRIX_3X2_F const* transforms,
+            UINT32 destinationRectanglesStride,
+            UINT32 sourceRectanglesStride,
+            UINT32 colorsStride,
+            UINT32 transformsStride) override
+        {
+            return AddSpritesMethod.WasCalled(
+                spriteCount,
+                destinationRectangles,
+                sourceRectangles,
+                colors,
+                transforms,
+                destinationRectanglesStride,
+                sourceRectanglesStride,
+                colorsStride,
+                transformsStride);
+        }
+
+        IFACEMETHODIMP SetSprites(UINT32, UINT32, D2D1_RECT_F const*, D2D1_RECT_U const*, D2D1_COLOR_F const*, D2D1_MATRIX_3X2_F const*, UINT32, UINT32, UINT32, UINT32) override
+        {
+            Assert::Fail(L"Unexpected call to SetSprites");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP GetSprites(UINT32, UINT32, D2D1_RECT_F*, D2D1_RECT_U*, D2D1_COLOR_F*, D2D1_MATRIX_3X2_F*) const override
+        {
+            Assert::Fail(L"Unexpected call to GetSprites");
+            return E_NOTIMPL;
+        }
+
+        IFACEMETHODIMP_(UINT32) GetSpriteCount() const override
+        {
+            Assert::Fail(L"Unexpected call to GetSpriteCount");
+            return 0;
+        }
+
+        IFACEMETHODIMP_(void) Clear() override
+        {
+            Assert::Fail(L"Unexpected call to Clear");
+        }
+    };
+}
+
+#endif
@@ -21,6 +21,7 @@ namespace canvas
     {
     public:
         CALL_COUNTER_WITH_MOCK(GetDeviceRemovedReasonMethod, HRESULT());
+        CALL_COUNTER_WITH_MOCK(CreateTexture2DMethod, HRESULT(const D3D11_TEXTURE2D_DESC*, const D3D11_SUBRESOURCE_DATA*, ID3D11Texture2D**));
 
         MockD3D11Device()
         {
@@ -48,7 +49,7 @@ namespace canvas
             _In_reads_opt_(_Inexpressible_(pDesc->MipLevels * pDesc->ArraySize))  const D3D11_SUBRESOURCE_DATA *pInitialData,
             _Out_opt_  ID3D11Texture2D **ppTexture2D)
         {
-            return E_NOTIMPL;
+            return CreateTexture2DMethod.WasCalled(pDesc, pInitialData, ppTexture2D);
         }
 
         HRESULT STDMETHODCALLTYPE CreateTexture3D(
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace canvas
+{
+    class MockD3D11Texture2D : public RuntimeClass<
+        RuntimeClassFlags<ClassicCom>,
+        ChainInterfaces<ID3D11Texture2D, ID3D11Resource, ID3D11DeviceChild>>
+    {
+        D3D11_TEXTURE2D_DESC m_description;
+
+    public:
+        MockD3D11Texture2D(D3D11_TEXTURE2D_DESC const& description)
+            : m_description(description)
+        {
+        }
+
+        //
+        // ID3D11Texture2D
+        //
+
+        STDMETHOD_(void, GetDesc)(
+            _Out_  D3D11_TEXTURE2D_DESC *pDesc)
+        {
+            *pDesc = m_description;
+        }
+
+        //
+        // ID3D11Resource
+        //
+
+        STDMETHOD_(void, GetType)(
+            _Out_  D3D11_RESOURCE_DIMENSION *pResourceDimension)
+        {
+            *pResourceDimension = D3D11_RESOURCE_DIMENSION_TEXTURE2D;
+        }
+
+        STDMETHOD_(void, SetEvictionPriority)(
+            _In_  UINT EvictionPriority)
+        {
+            Assert::Fail(L"Unexpected call to SetEvictionPriority");
+        }
+
+        STDMETHOD_(UINT, GetEvictionPriority)()
+        {
+            Assert::Fail(L"Unexpected call to GetEvictionPriority");
+            return 0;
+        }
+
+        //
+        // ID3D11DeviceChild
+        //
+
+        STDMETHOD_(void, GetDevice)(
+            _Out_  ID3D11Device **ppDevice)
+        {
+            Assert::Fail(L"Unexpected call to GetDevice");
+        }
+
+        STDMETHOD(GetPrivateData)(
+            _In_  REFGUID guid,
+            _Inout_  UINT *pDataSize,
+            _Out_writes_bytes_opt_(*pDataSize)  void *pData)
+        {
+            Assert::Fail(L"Unexpected call to GetPrivateData");
+            return E_NOTIMPL;
+        }
+
+        STDMETHOD(SetPrivateData)(
+            _In_  REFGUID guid,
+            _In_  UINT DataSize,
+            _In_reads_bytes_opt_(DataSize)  const void *pData)
+        {
+            Assert::Fail(L"Unexpected call to SetPrivateData");
+            return E_NOTIMPL;
+        }
+
+        STDMETHOD(SetPrivateDataInterface)(
+            _In_  REFGUID guid,
+            _In_opt_  const IUnknown *pData)
+        {
+            Assert::Fail(L"Unexpected call to SetPrivateDataInterface");
+            return E_NOTIMPL;
+        }
+    };
+}
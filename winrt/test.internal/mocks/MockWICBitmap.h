@@ -21,6 +21,7 @@ namespace canvas
     public:
 
         std::function<void(unsigned int* width, unsigned int* height)> MockGetSize;
+        std::function<HRESULT(const WICRect* lock, DWORD flags, IWICBitmapLock** bitmaplock)> MockLock;
 
         //
         // IWICBitmap
@@ -31,7 +32,10 @@ namespace canvas
             DWORD flags,
             IWICBitmapLock **bitmaplock) override
         {
-            return E_NOTIMPL;
+            if (!MockLock)
+                return E_NOTIMPL;
+
+            return MockLock(lock, flags, bitmaplock);
         }
 
         virtual HRESULT STDMETHODCALLTYPE SetPalette(
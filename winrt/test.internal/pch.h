@@ -35,6 +35,7 @@ using namespace ABI::Microsoft::Graphics::Canvas::Effects;
 // TODO #997/#1429: move these files
 #include "../test.external/MockDxgiDevice.h"
 #include "../test.external/MockDxgiSurface.h"
+#include "../test.external/PerfTestHelpers.h"
 
 #include "utils/Helpers.h"
 #include "mocks/MockHelpers.h"
@@ -54,18 +55,22 @@ using namespace ABI::Microsoft::Graphics::Canvas::Effects;
 #include "mocks/MockD2DLinearGradientBrush.h"
 #include "mocks/MockD2DRadialGradientBrush.h"
 #include "mocks/MockD2DSolidColorBrush.h"
+#include "mocks/MockD2DSpriteBatch.h"
 #include "mocks/MockD2DStrokeStyle.h"
 #include "mocks/MockD3D11Device.h"
+#include "mocks/MockD3D11Texture2D.h"
 #include "xaml/MockRecreatableDeviceManager.h"
 #include "mocks/MockSurfaceImageSource.h"
 #include "mocks/MockSurfaceImageSourceFactory.h"
 #include "mocks/MockSuspendingEventArgs.h"
+#include "mocks/MockWICBitmap.h"
 #include "mocks/MockWICFormatConverter.h"
 #include "stubs/StubD2DResources.h"
 #include "stubs/StubCanvasDevice.h"
 #include "stubs/StubCanvasDrawingSessionAdapter.h"
 #include "stubs/StubD2DDeviceContext.h"
 #include "stubs/StubImageControl.h"
+#include "stubs/StubRectangleGeometry.h"
 #include "stubs/StubSurfaceImageSource.h"
 #include "stubs/StubSurfaceImageSourceFactory.h"
 #include "stubs/StubUserControl.h"
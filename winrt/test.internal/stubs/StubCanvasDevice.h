@@ -33,6 +33,8 @@ namespace canvas
             , m_deviceLostEventSource(Make<MockEventSource<DeviceLostHandlerType>>(L"DeviceLost"))
         {
             GetInterfaceMethod.AllowAnyCall();
+            GetTextLayoutCacheMethod.AllowAnyCall();
+            GetTessellationCacheMethod.AllowAnyCall();
             CreateDeviceContextMethod.AllowAnyCall(
                 [=]
                 {
@@ -41,6 +43,28 @@ namespace canvas
                     return dc;
                 });
 
+            // By default nothing is pooled, so each drawing session still
+            // goes through CreateDeviceContext.
+            AcquirePooledDeviceContextMethod.AllowAnyCall(
+                [=]
+                {
+                    return CreateDeviceContext();
+                });
+
+            ReleasePooledDeviceContextMethod.AllowAnyCall();
+
+            // No staging texture or pixel buffer pools, so pixel access
+            // creates new ones each time.
+            GetStagingTexturePoolMethod.AllowAnyCall();
+            GetPixelBufferPoolMethod.AllowAnyCall();
+
+            auto pixelReadbackQueue = std::make_shared<PixelReadbackQueue>();
+            GetPixelReadbackQueueMethod.AllowAnyCall(
+                [=]
+                {
+                    return pixelReadbackQueue;
+                });
+
             CreateRectangleGeometryMethod.AllowAnyCall(
                 [](D2D1_RECT_F const&)
                 {
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "StubStorageFileStatics.h"
+#include "mocks/MockDWriteFactory.h"
 
 namespace canvas
 {
@@ -38,4 +39,43 @@ namespace canvas
             return StorageFileStatics.Get();
         }
     };
+
+    class StubCanvasTextFormatAdapterWithDWriteFactory : public StubCanvasTextFormatAdapter
+    {
+        ComPtr<IDWriteFactory> m_realFactory;
+
+    public:
+        ComPtr<MockDWriteFactory> DWriteFactory;
+
+        StubCanvasTextFormatAdapterWithDWriteFactory()
+            : m_realFactory(StubCanvasTextFormatAdapter::CreateDWriteFactory(DWRITE_FACTORY_TYPE_SHARED))
+            , DWriteFactory(Make<MockDWriteFactory>())
+        {
+            DWriteFactory->CreateTextFormatMethod.AllowAnyCall(GetCreateTextFormatFunction());
+        }
+
+        void ExpectCreateTextFormat(int count)
+        {
+            DWriteFactory->CreateTextFormatMethod.SetExpectedCalls(count, GetCreateTextFormatFunction());
+        }
+
+        virtual ComPtr<IDWriteFactory> CreateDWriteFactory(DWRITE_FACTORY_TYPE type) override
+        {
+            return DWriteFactory;
+        }
+
+    private:
+        // Text formats are created by a real DWrite factory, so that they
+        // can be inspected by the tests.
+        std::function<HRESULT(WCHAR const*, IDWriteFontCollection*, DWRITE_FONT_WEIGHT, DWRITE_FONT_STYLE, DWRITE_FONT_STRETCH, FLOAT, WCHAR const*, IDWriteTextFormat**)> GetCreateTextFormatFunction()
+        {
+            auto realFactory = m_realFactory;
+
+            return
+                [=] (WCHAR const* fontFamilyName, IDWriteFontCollection* fontCollection, DWRITE_FONT_WEIGHT fontWeight, DWRITE_FONT_STYLE fontStyle, DWRITE_FONT_STRETCH fontStretch, FLOAT fontSize, WCHAR const* localeName, IDWriteTextFormat** textFormat)
+                {
+                    return realFactory->CreateTextFormat(fontFamilyName, fontCollection, fontWeight, fontStyle, fontStretch, fontSize, localeName, textFormat);
+                };
+        }
+    };
 }
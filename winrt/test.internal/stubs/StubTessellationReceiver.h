@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+namespace canvas
+{
+    class StubTessellationReceiver : public RuntimeClass<
+        RuntimeClassFlags<WinRtClassicComMix>,
+        ICanvasTessellationReceiver>
+    {
+    public:
+        CALL_COUNTER_WITH_MOCK(AddTrianglesMethod, HRESULT(UINT32, CanvasTriangleVertices*));
+
+        IFACEMETHODIMP AddTriangles(
+            UINT32 trianglesCount,
+            CanvasTriangleVertices* triangles)
+        {
+            return AddTrianglesMethod.WasCalled(trianglesCount, triangles);
+        }
+    };
+}
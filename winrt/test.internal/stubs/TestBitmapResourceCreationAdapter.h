@@ -18,12 +18,13 @@ class TestBitmapResourceCreationAdapter : public ICanvasBitmapResourceCreationAd
 
 public:
     std::function<void()> MockCreateWICFormatConverter;
+    std::function<ComPtr<IWICBitmap>(IWICBitmapSource*)> MockCreateWICBitmapFromSource;
 
     TestBitmapResourceCreationAdapter()
     {
     }
 
-    TestBitmapResourceCreationAdapter(ComPtr<IWICFormatConverter> converter)
+    TestBitmapResourceCreationAdapter(ComPtr<IWICBitmapSource> converter)
         : m_converter(converter)
     {
     }
@@ -41,7 +42,18 @@ public:
         return nullptr;
     }
 
-    virtual void SaveLockedMemoryToFile(
+    ComPtr<IWICBitmap> CreateWICBitmapFromSource(IWICBitmapSource* source)
+    {
+        if (!MockCreateWICBitmapFromSource)
+        {
+            Assert::Fail(); // Unexpected
+            return nullptr;
+        }
+
+        return MockCreateWICBitmapFromSource(source);
+    }
+
+    virtual void SavePixelSnapshotToFile(
         HSTRING fileName,
         CanvasBitmapFileFormat fileFormat,
         float quality,
@@ -49,13 +61,13 @@ public:
         unsigned int height,
         float dpiX,
         float dpiY,
-        ScopedBitmapMappedPixelAccess* bitmapLock)
+        BitmapPixelSnapshot* pixels)
     {
         Assert::Fail(); // Unexpected
     }
 
 
-    virtual void SaveLockedMemoryToStream(
+    virtual void SavePixelSnapshotToStream(
         IRandomAccessStream* stream,
         CanvasBitmapFileFormat fileFormat,
         float quality,
@@ -63,7 +75,7 @@ public:
         unsigned int height,
         float dpiX,
         float dpiY,
-        ScopedBitmapMappedPixelAccess* bitmapLock)
+        BitmapPixelSnapshot* pixels)
     {
         Assert::Fail(); // Unexpected
     }
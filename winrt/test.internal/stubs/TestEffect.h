@@ -94,6 +94,20 @@ public:
             MockSetProperty();
         CanvasEffect::SetBoxedProperty<TBoxed>(index, value);
     }
+
+    //
+    // Direct access to arbitrary property indices, for testing effects with many properties
+    //
+
+    void SetFloatProperty(unsigned int index, float value)
+    {
+        CanvasEffect::SetBoxedProperty<float>(index, value);
+    }
+
+    void SetVectorProperty(unsigned int index, Numerics::Vector4 const& value)
+    {
+        CanvasEffect::SetBoxedProperty<float[4]>(index, value);
+    }
 };
 
 inline void CheckEffectTypeAndInput(MockD2DEffectThatCountsCalls* mockEffect, IID const& expectedId, ID2D1Image* expectedInput, float expectedDpi = 0)
@@ -391,7 +391,7 @@ namespace Microsoft
                 ThrowIfFailed(StringCchPrintf(
                     buf,
                     _countof(buf),
-                    L"D2D1_RECT_U{l=%f,t=%f,r=%f,b=%f}",
+                    L"D2D1_RECT_U{l=%u,t=%u,r=%u,b=%u}",
                     value.left, value.top, value.right, value.bottom));
 
                 return buf;
@@ -842,6 +842,22 @@ namespace Microsoft
                 END_ENUM(D2D1_INTERPOLATION_MODE);
             }
 
+            ENUM_TO_STRING(D2D1_BITMAP_INTERPOLATION_MODE)
+            {
+                ENUM_VALUE(D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR);
+                ENUM_VALUE(D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
+                END_ENUM(D2D1_BITMAP_INTERPOLATION_MODE);
+            }
+
+#if WINVER > 0x0603
+            ENUM_TO_STRING(D2D1_SPRITE_OPTIONS)
+            {
+                ENUM_VALUE(D2D1_SPRITE_OPTIONS_NONE);
+                ENUM_VALUE(D2D1_SPRITE_OPTIONS_CLAMP_TO_SOURCE_RECTANGLE);
+                END_ENUM(D2D1_SPRITE_OPTIONS);
+            }
+#endif
+
             ENUM_TO_STRING(CanvasAlphaMode)
             {
                 ENUM_VALUE(CanvasAlphaMode::Ignore);
@@ -1169,6 +1185,11 @@ inline bool operator==(D2D1_POINT_2U const& a, D2D1_POINT_2U const& b)
     return a.x == b.x && a.y == b.y;
 }
 
+inline bool operator==(D2D1_RECT_U const& a, D2D1_RECT_U const& b)
+{
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
 #define ASSERT_IMPLEMENTS_INTERFACE(obj, INTERFACE)                     \
     {                                                                   \
         ComPtr<INTERFACE> iface;                                        \
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include <atomic>
+
+TEST_CLASS(ParallelForTests)
+{
+    TEST_METHOD_EX(ParallelForBytes_SmallAmountsOfWorkRunOnCallingThread)
+    {
+        auto callingThread = GetCurrentThreadId();
+        int callCount = 0;
+
+        ParallelForBytes(16, 1024, 8,
+            [&](uint32_t first, uint32_t itemCount)
+            {
+                Assert::IsTrue(callingThread == GetCurrentThreadId());
+                Assert::AreEqual(0u, first);
+                Assert::AreEqual(16u, itemCount);
+                callCount++;
+            });
+
+        Assert::AreEqual(1, callCount);
+    }
+
+    TEST_METHOD_EX(ParallelForBytes_VisitsEveryItemOnce)
+    {
+        const uint32_t itemCount = 4099;
+        const uint32_t bytesPerItem = 16384;
+
+        for (unsigned threadCount = 1; threadCount <= 16; threadCount *= 2)
+        {
+            std::vector<std::atomic<int>> visits(itemCount);
+
+            for (auto& visit : visits)
+                visit = 0;
+
+            ParallelForBytes(itemCount, bytesPerItem, threadCount,
+                [&](uint32_t first, uint32_t chunkItemCount)
+                {
+                    for (uint32_t i = first; i < first + chunkItemCount; i++)
+                    {
+                        visits[i]++;
+                    }
+                });
+
+            for (auto& visit : visits)
+            {
+                Assert::AreEqual(1, visit.load());
+            }
+        }
+    }
+
+    TEST_METHOD_EX(ParallelFor_SplitsSmallWorkIntoChunks)
+    {
+        const uint32_t itemCount = 100;
+        const uint32_t chunkCount = 10;
+
+        std::vector<std::atomic<int>> visits(itemCount);
+
+        for (auto& visit : visits)
+            visit = 0;
+
+        std::atomic<int> chunksProcessed(0);
+
+        ParallelFor(itemCount, chunkCount, 4,
+            [&](uint32_t first, uint32_t chunkItemCount)
+            {
+                chunksProcessed++;
+
+                for (uint32_t i = first; i < first + chunkItemCount; i++)
+                {
+                    visits[i]++;
+                }
+            });
+
+        Assert::AreEqual(static_cast<int>(chunkCount), chunksProcessed.load());
+
+        for (auto& visit : visits)
+        {
+            Assert::AreEqual(1, visit.load());
+        }
+    }
+
+    TEST_METHOD_EX(ParallelForBytes_ExceptionsAreRethrownOnCallingThread)
+    {
+        ExpectHResultException(E_OUTOFMEMORY,
+            [&]
+            {
+                ParallelForBytes(4096, 16384, 4,
+                    [&](uint32_t first, uint32_t)
+                    {
+                        if (first > 0)
+                            ThrowHR(E_OUTOFMEMORY);
+                    });
+            });
+    }
+};
@@ -12,6 +12,9 @@
 
 #include "pch.h"
 
+#include <atomic>
+#include <thread>
+
 namespace
 {
     class DummyResource : public RuntimeClass<RuntimeClassFlags<ClassicCom>, IUnknown>
@@ -48,7 +51,7 @@ namespace
             : ResourceWrapper(manager, resource)
             , m_device(device)
         {
-            static int nextId = 1;
+            static std::atomic<int> nextId(1);
             m_id = nextId++;
         }
 
@@ -185,6 +188,155 @@ TEST_CLASS(ResourceTrackerUnitTests)
         auto otherCanvasDevice = Make<StubCanvasDevice>();
         ExpectHResultException(E_INVALIDARG, [&]{ manager->GetOrCreate(otherCanvasDevice.Get(), resource.Get()); });
     }
+
+    //
+    // Runs fn(threadIndex) on several threads at once, rethrowing the first
+    // exception (if any) on the calling thread.
+    //
+    template<typename FN>
+    static void RunOnThreads(int threadCount, FN&& fn)
+    {
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> exceptions(threadCount);
+
+        for (int i = 0; i < threadCount; i++)
+        {
+            threads.emplace_back(
+                [&, i]
+                {
+                    try
+                    {
+                        fn(i);
+                    }
+                    catch (...)
+                    {
+                        exceptions[i] = std::current_exception();
+                    }
+                });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (auto& exception : exceptions)
+        {
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+    }
+
+    TEST_METHOD_EX(ResourceTracker_GetOrCreate_FromManyThreads_ReturnsOneWrapperPerResource)
+    {
+        const int threadCount = 8;
+        const int resourceCount = 64;
+        const int iterationCount = 2000;
+
+        auto manager = std::make_shared<DummyManager>();
+        auto canvasDevice = Make<StubCanvasDevice>();
+
+        std::vector<ComPtr<DummyResource>> sharedResources;
+
+        for (int i = 0; i < resourceCount; i++)
+        {
+            sharedResources.push_back(Make<DummyResource>());
+        }
+
+        // Each thread keeps every wrapper it gets, so none of them can expire
+        // and all threads must end up with the same wrapper for each resource.
+        std::vector<std::vector<ComPtr<DummyWrapper>>> wrappersSeenByThread(threadCount);
+
+        RunOnThreads(threadCount,
+            [&](int threadIndex)
+            {
+                auto& wrappers = wrappersSeenByThread[threadIndex];
+                wrappers.resize(resourceCount);
+
+                for (int i = 0; i < iterationCount; i++)
+                {
+                    int resourceIndex = (i * 7 + threadIndex * 13) % resourceCount;
+
+                    auto wrapper = manager->GetOrCreate(canvasDevice.Get(), sharedResources[resourceIndex].Get());
+
+                    if (!wrappers[resourceIndex])
+                        wrappers[resourceIndex] = wrapper;
+                    else if (wrappers[resourceIndex] != wrapper)
+                        ThrowHR(E_UNEXPECTED);
+
+                    // Churn wrappers for a resource only this thread knows
+                    // about, so that Add and Remove run concurrently with the
+                    // lookups.
+                    auto privateResource = Make<DummyResource>();
+                    auto privateWrapper = manager->Create(canvasDevice.Get(), privateResource.Get());
+
+                    if (manager->GetOrCreate(canvasDevice.Get(), privateResource.Get()) != privateWrapper)
+                        ThrowHR(E_UNEXPECTED);
+
+                    if (i % 2)
+                        ThrowIfFailed(privateWrapper->Close());
+                }
+            });
+
+        for (int i = 0; i < resourceCount; i++)
+        {
+            for (int j = 1; j < threadCount; j++)
+            {
+                Assert::AreEqual(wrappersSeenByThread[0][i].Get(), wrappersSeenByThread[j][i].Get());
+            }
+        }
+
+        // Wrappers can still be looked up, and replaced once released, after
+        // the threads have finished.
+        auto existingWrapper = wrappersSeenByThread[0][0];
+        Assert::AreEqual(existingWrapper.Get(), manager->GetOrCreate(canvasDevice.Get(), sharedResources[0].Get()).Get());
+
+        int oldId = existingWrapper->GetId();
+        existingWrapper.Reset();
+        wrappersSeenByThread.clear();
+
+        auto newWrapper = manager->GetOrCreate(canvasDevice.Get(), sharedResources[0].Get());
+        Assert::AreNotEqual(oldId, newWrapper->GetId());
+    }
+
+    PERF_TEST_METHOD_ATTRIBUTES(ResourceTracker_GetOrCreate_Throughput)
+    TEST_METHOD_EX(ResourceTracker_GetOrCreate_Throughput)
+    {
+        // Measures lookups of existing wrappers from several threads.
+        const int resourceCount = 256;
+        const int lookupsPerThread = 20000;
+
+        auto manager = std::make_shared<DummyManager>();
+        auto canvasDevice = Make<StubCanvasDevice>();
+
+        std::vector<ComPtr<DummyResource>> resources;
+        std::vector<ComPtr<DummyWrapper>> wrappers;
+
+        for (int i = 0; i < resourceCount; i++)
+        {
+            resources.push_back(Make<DummyResource>());
+            wrappers.push_back(manager->Create(canvasDevice.Get(), resources.back().Get()));
+        }
+
+        for (int threadCount = 1; threadCount <= 8; threadCount *= 2)
+        {
+            double seconds = MeasureSeconds(
+                [&]
+                {
+                    RunOnThreads(threadCount,
+                        [&](int threadIndex)
+                        {
+                            for (int i = 0; i < lookupsPerThread; i++)
+                            {
+                                auto& resource = resources[(i + threadIndex * 31) % resourceCount];
+                                manager->GetOrCreate(canvasDevice.Get(), resource.Get());
+                            }
+                        });
+                });
+
+            LogPerfMessage(L"%d threads: %.0f lookups per second\n", threadCount, threadCount * lookupsPerThread / seconds);
+        }
+    }
 };
 
 
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <thread>
+
 #include <lib/xaml/CanvasGameLoop.h>
 
 #include "BaseControlTestAdapter.h"
@@ -22,19 +24,24 @@
 class CanvasAnimatedControlTestAdapter : public BaseControlTestAdapter<CanvasAnimatedControlTraits>
 {
     std::shared_ptr<CanvasSwapChainPanelTestAdapter> m_swapChainPanelAdapter;
-    int64_t m_performanceCounter;
+    std::atomic<int64_t> m_performanceCounter;
     ComPtr<MockAsyncAction> m_gameThreadAction;
     ComPtr<StubDispatcher> m_gameThreadDispatcher;
     ComPtr<StubSwapChainPanel> m_swapChainPanel;
     ComPtr<StubCoreIndependentInputSource> m_coreIndependentInputSource;
+    std::vector<std::thread> m_workerThreads;
 
 public:
     CALL_COUNTER_WITH_MOCK(CreateCanvasSwapChainMethod, ComPtr<CanvasSwapChain>(ICanvasDevice*, float, float, float, CanvasAlphaMode));
     std::shared_ptr<CanvasSwapChainManager> SwapChainManager;
     ComPtr<StubCanvasDevice> InitialDevice;
+    int WorkerThreadItemCount;
+    bool RunWorkerThreadItemsOnRealThreads;
 
     CanvasAnimatedControlTestAdapter(StubCanvasDevice* initialDevice = nullptr)
         : m_performanceCounter(0)
+        , WorkerThreadItemCount(0)
+        , RunWorkerThreadItemsOnRealThreads(false)
         , SwapChainManager(std::make_shared<CanvasSwapChainManager>())
         , InitialDevice(initialDevice)
         , m_gameThreadDispatcher(Make<StubDispatcher>())
@@ -138,6 +145,33 @@ public:
         if (m_sleepFn) m_sleepFn(timeInMs);
     }
 
+    // Work items are run immediately, rather than on another thread, so that
+    // the order things happen in is deterministic.  Tests that need to see
+    // work actually running alongside the game loop thread can set
+    // RunWorkerThreadItemsOnRealThreads instead.
+    virtual void RunOnWorkerThread(std::function<void()>&& fn) override
+    {
+        ++WorkerThreadItemCount;
+
+        if (RunWorkerThreadItemsOnRealThreads)
+            m_workerThreads.emplace_back(std::move(fn));
+        else
+            fn();
+    }
+
+    void JoinWorkerThreads()
+    {
+        for (auto& thread : m_workerThreads)
+            thread.join();
+
+        m_workerThreads.clear();
+    }
+
+    ~CanvasAnimatedControlTestAdapter()
+    {
+        JoinWorkerThreads();
+    }
+
     void SetTime(int64_t time)
     {
         m_performanceCounter = time;
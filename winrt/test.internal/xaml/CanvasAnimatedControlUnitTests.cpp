@@ -12,6 +12,8 @@
 
 #include "pch.h"
 
+#include <thread>
+
 static Color const AnyColor                 {   1,   2,   3,   4 };
 static Color const AnyOtherColor            {   5,   6,   7,   8 };
 static Color const AnyOpaqueColor           { 255,   2,   3,   4 };
@@ -31,6 +33,7 @@ public:
         : m_dxgiSwapChain(Make<MockDxgiSwapChain>())
     {
         m_dxgiSwapChain->Present1Method.AllowAnyCall();
+        m_dxgiSwapChain->SetSourceSizeMethod.AllowAnyCall();
 
         m_dxgiSwapChain->GetDesc1Method.AllowAnyCall(
             [=](DXGI_SWAP_CHAIN_DESC1* desc)
@@ -415,6 +418,28 @@ TEST_CLASS(CanvasAnimatedControlTests)
             Adapter->DoChanged();
         }
 
+        void ExpectSourceSize(Size size)
+        {
+            m_dxgiSwapChain->ResizeBuffersMethod.SetExpectedCalls(0);
+            m_dxgiSwapChain->SetSourceSizeMethod.SetExpectedCalls(1,
+                [=](UINT width, UINT height)
+                {
+                    Assert::AreEqual(static_cast<UINT>(size.Width), width);
+                    Assert::AreEqual(static_cast<UINT>(size.Height), height);
+                    return S_OK;
+                });
+        }
+
+        void AllowAnyResizeBuffers(std::function<void(Size)> fn)
+        {
+            m_dxgiSwapChain->ResizeBuffersMethod.AllowAnyCall(
+                [=](UINT, UINT width, UINT height, DXGI_FORMAT, UINT)
+                {
+                    fn(Size{ static_cast<float>(width), static_cast<float>(height) });
+                    return S_OK;
+                });
+        }
+
         void ExpectOneResizeBuffers(Size size)
         {
             m_dxgiSwapChain->ResizeBuffersMethod.SetExpectedCalls(1,
@@ -450,23 +475,117 @@ TEST_CLASS(CanvasAnimatedControlTests)
         }
     };
 
-    TEST_METHOD_EX(CanvasAnimatedControl_WhenControlIsResized_ThenResizeBuffersIsCalled)
+    static float RoundUpToStep(float value)
+    {
+        float step = static_cast<float>(RenderTargetSizePolicy::StepSize);
+        return ceilf(value / step) * step;
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenControlIsResizedBeyondBuffers_ThenResizeBuffersIsCalled)
+    {
+        const float step = static_cast<float>(RenderTargetSizePolicy::StepSize);
+        const float initialWidth = ResizeFixture::InitialWidth;
+        const float initialHeight = ResizeFixture::InitialHeight;
+
+        Size sizes[] 
+        { 
+            { initialWidth + step, initialHeight        }, // width only
+            { initialWidth,        initialHeight + step }, // height only
+            { initialWidth + step, initialHeight + step }, // both
+        };
+
+        for (auto size : sizes)
+        {
+            ResizeFixture f;
+            f.ExpectOneResizeBuffers(Size{ RoundUpToStep(size.Width), RoundUpToStep(size.Height) });
+            f.Execute(size);
+        }
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenControlIsResizedWithinBuffers_ThenOnlySourceSizeChanges)
     {
         Size sizes[] 
         { 
             { ResizeFixture::InitialWidth + 1, ResizeFixture::InitialHeight     }, // width only
             { ResizeFixture::InitialWidth,     ResizeFixture::InitialHeight + 1 }, // height only
-            { ResizeFixture::InitialWidth + 1, ResizeFixture::InitialHeight + 1 }, // both
+            { ResizeFixture::InitialWidth - 1, ResizeFixture::InitialHeight - 1 }, // both, smaller
         };
 
         for (auto size : sizes)
         {
             ResizeFixture f;
-            f.ExpectOneResizeBuffers(size);
+            f.ExpectSourceSize(size);
             f.Execute(size);
         }
     }
 
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenControlStaysMuchSmallerThanBuffers_ThenBuffersAreShrunk)
+    {
+        ResizeFixture f;
+
+        int resizeCount = 0;
+        Size lastBufferSize{};
+        f.AllowAnyResizeBuffers(
+            [&](Size size)
+            {
+                lastBufferSize = size;
+                ++resizeCount;
+            });
+
+        f.Execute(Size{ 1000, 1000 });
+
+        Assert::AreEqual(1, resizeCount);
+        resizeCount = 0;
+
+        f.UserControl->Resize(Size{ 10, 10 });
+
+        for (int i = 0; i < RenderTargetSizePolicy::ShrinkDelay / 2; ++i)
+        {
+            f.Adapter->ProgressTime(TicksPerFrame);
+            f.Adapter->Tick();
+            f.Adapter->DoChanged();
+        }
+
+        Assert::AreEqual(0, resizeCount);
+
+        for (int i = 0; i < RenderTargetSizePolicy::ShrinkDelay; ++i)
+        {
+            f.Adapter->ProgressTime(TicksPerFrame);
+            f.Adapter->Tick();
+            f.Adapter->DoChanged();
+        }
+
+        Assert::AreEqual(1, resizeCount);
+        Assert::AreEqual(Size{ RoundUpToStep(10), RoundUpToStep(10) }, lastBufferSize);
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenControlIsResizedManyTimes_ThenBuffersAreRarelyReallocated)
+    {
+        ResizeFixture f;
+
+        int resizeCount = 0;
+        f.AllowAnyResizeBuffers([&](Size) { ++resizeCount; });
+
+        // Simulate the user dragging the edge of a window out and then back
+        // in again.
+        const int resizeSteps = 500;
+        for (int i = 0; i < resizeSteps; ++i)
+        {
+            float offset = static_cast<float>(i < resizeSteps / 2 ? i : resizeSteps - i);
+            Size size{ ResizeFixture::InitialWidth + offset * 2, ResizeFixture::InitialHeight + offset };
+
+            f.UserControl->Resize(size);
+            f.Adapter->ProgressTime(TicksPerFrame);
+            f.Adapter->Tick();
+            f.Adapter->DoChanged();
+        }
+
+        // Without the size policy every one of these would resize the
+        // buffers.  With it, they're only resized as each step boundary is
+        // crossed.
+        Assert::IsTrue(resizeCount <= 10);
+    }
+
     TEST_METHOD_EX(CanvasAnimatedControl_WhenControlIsResizedToCurrentSize_ThenResizeBuffersIsNotCalled)
     {
         ResizeFixture f;
@@ -917,6 +1036,111 @@ TEST_CLASS(CanvasAnimatedControlTests)
         }
     }
 
+    static ComArray<CanvasFrameTiming> GetFrameTimings(CanvasAnimatedControl* control)
+    {
+        ComArray<CanvasFrameTiming> frames;
+        ThrowIfFailed(control->GetFrameTimings(frames.GetAddressOfSize(), frames.GetAddressOfData()));
+        return frames;
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_FrameTimings_RecordUpdateAndDrawTime)
+    {
+        UpdateRenderFixture f;
+        f.GetIntoSteadyState();
+
+        Assert::AreEqual(1u, GetFrameTimings(f.Control.Get()).GetSize());
+
+        const int64_t updateTime = 1000;
+        const int64_t drawTime = 2000;
+
+        f.OnUpdate.SetExpectedCalls(1,
+            [&](ICanvasAnimatedControl*, ICanvasAnimatedUpdateEventArgs*)
+            {
+                f.Adapter->ProgressTime(updateTime);
+                return S_OK;
+            });
+
+        f.OnDraw.SetExpectedCalls(1,
+            [&](ICanvasAnimatedControl*, ICanvasAnimatedDrawEventArgs*)
+            {
+                f.Adapter->ProgressTime(drawTime);
+                return S_OK;
+            });
+
+        f.Adapter->ProgressTime(TicksPerFrame);
+        f.RenderSingleFrame();
+
+        auto frames = GetFrameTimings(f.Control.Get());
+        Assert::AreEqual(2u, frames.GetSize());
+
+        auto& frame = frames[1];
+        Assert::AreEqual(updateTime, frame.UpdateTime.Duration);
+        Assert::AreEqual(drawTime, frame.DrawTime.Duration);
+        Assert::AreEqual(0LL, frame.PresentTime.Duration);
+        Assert::AreEqual(updateTime + drawTime, frame.TotalTime.Duration);
+        Assert::AreEqual(1, frame.UpdateCount);
+        Assert::IsFalse(!!frame.IsRunningSlowly);
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_FrameTimings_RecordCatchUpUpdates)
+    {
+        UpdateRenderFixture f;
+        f.GetIntoSteadyState();
+
+        f.OnUpdate.SetExpectedCalls(3);
+        f.OnDraw.SetExpectedCalls(1);
+
+        f.Adapter->ProgressTime(TicksPerFrame * 3);
+        f.RenderSingleFrame();
+
+        auto frames = GetFrameTimings(f.Control.Get());
+        Assert::AreEqual(2u, frames.GetSize());
+        Assert::AreEqual(3, frames[1].UpdateCount);
+        Assert::IsTrue(!!frames[1].IsRunningSlowly);
+
+        CanvasFrameTiming percentile;
+        ThrowIfFailed(f.Control->GetFrameTimingPercentile(100, &percentile));
+        Assert::AreEqual(3, percentile.UpdateCount);
+        Assert::IsTrue(!!percentile.IsRunningSlowly);
+
+        ThrowIfFailed(f.Control->GetFrameTimingPercentile(50, &percentile));
+        Assert::AreEqual(1, percentile.UpdateCount);
+        Assert::IsFalse(!!percentile.IsRunningSlowly);
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_FrameTimings_FramesThatDoNothingAreNotRecorded)
+    {
+        UpdateRenderFixture f;
+        f.GetIntoSteadyState();
+
+        f.OnUpdate.SetExpectedCalls(0);
+        f.OnDraw.SetExpectedCalls(0);
+        ThrowIfFailed(f.Control->put_Paused(TRUE));
+
+        for (int i = 0; i < 10; ++i)
+        {
+            f.Adapter->ProgressTime(TicksPerFrame);
+            f.Adapter->DoChanged();
+            f.RenderSingleFrame();
+        }
+
+        Assert::AreEqual(1u, GetFrameTimings(f.Control.Get()).GetSize());
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_FrameTimings_InvalidArgs)
+    {
+        CanvasAnimatedControlFixture f;
+
+        ComArray<CanvasFrameTiming> frames;
+        CanvasFrameTiming frame;
+
+        Assert::AreEqual(E_INVALIDARG, f.Control->GetFrameTimings(nullptr, frames.GetAddressOfData()));
+        Assert::AreEqual(E_INVALIDARG, f.Control->GetFrameTimings(frames.GetAddressOfSize(), nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.Control->GetFrameTimingPercentile(50, nullptr));
+        Assert::AreEqual(E_INVALIDARG, f.Control->GetFrameTimingPercentile(-1, &frame));
+        Assert::AreEqual(E_INVALIDARG, f.Control->GetFrameTimingPercentile(101, &frame));
+    }
+
     TEST_METHOD_EX(CanvasAnimatedControl_FixedTimeStep_WhenPausedAfterUpdateAndClearColorChanged_DrawIsCalled)
     {
         UpdateRenderFixture f;
@@ -2530,7 +2754,7 @@ TEST_CLASS(CanvasAnimatedControl_VisibilityTests)
 
         f.Window->SetVisible(false);
 
-        f.UserControl->Resize(Size{ 3, 4 });
+        f.UserControl->Resize(Size{ 1000, 1000 });
 
         f.DoNotExpectResizeBuffers();
         f.OnUpdate.SetExpectedCalls(1);
@@ -2543,7 +2767,7 @@ TEST_CLASS(CanvasAnimatedControl_VisibilityTests)
 
         f.Window->SetVisible(false);
 
-        f.UserControl->Resize(Size{ 3, 4 });
+        f.UserControl->Resize(Size{ 1000, 1000 });
 
         f.OnUpdate.SetExpectedCalls(1);
         f.RenderSingleFrame();
@@ -3039,3 +3263,417 @@ TEST_CLASS(CanvasAnimatedControl_AppAccessingWorkerThreadTests)
         f.VerifyTickLoopIsStillRunning();
     }
 };
+
+TEST_CLASS(CanvasAnimatedControl_PipelinedUpdateTests)
+{
+    struct Event
+    {
+        bool IsDraw;
+        INT64 UpdateCount;
+    };
+
+    class Fixture : public CanvasAnimatedControlFixture
+    {
+    public:
+        std::vector<Event> Events;
+
+        Fixture(bool isUpdatePipelined = true)
+        {
+            ThrowIfFailed(Control->put_IsUpdatePipelined(isUpdatePipelined));
+
+            auto onUpdate = Callback<Animated_UpdateEventHandler>(
+                [=](ICanvasAnimatedControl*, ICanvasAnimatedUpdateEventArgs* args)
+                {
+                    CanvasTimingInformation timing;
+                    ThrowIfFailed(args->get_Timing(&timing));
+                    Events.push_back(Event{ false, timing.UpdateCount });
+                    return S_OK;
+                });
+            AddUpdateHandler(onUpdate.Get());
+
+            auto onDraw = Callback<Animated_DrawEventHandler>(
+                [=](ICanvasAnimatedControl*, ICanvasAnimatedDrawEventArgs* args)
+                {
+                    CanvasTimingInformation timing;
+                    ThrowIfFailed(args->get_Timing(&timing));
+                    Events.push_back(Event{ true, timing.UpdateCount });
+                    return S_OK;
+                });
+            AddDrawHandler(onDraw.Get());
+
+            Load();
+            Adapter->DoChanged();
+        }
+
+        ~Fixture()
+        {
+            //
+            // Give the loop a final, paused, tick so that it stops, and
+            // draws the last pipelined update.
+            //
+            if (Adapter->GameThreadHasPendingWork())
+            {
+                ThrowIfFailed(Control->put_Paused(TRUE));
+                TickOneFrame();
+            }
+        }
+
+        void TickOneFrame()
+        {
+            Adapter->ProgressTime(TicksPerFrame);
+            Adapter->Tick();
+        }
+
+        void AssertEvents(std::vector<Event> const& expected)
+        {
+            Assert::AreEqual(expected.size(), Events.size());
+
+            for (size_t i = 0; i < expected.size(); ++i)
+            {
+                Assert::AreEqual(expected[i].IsDraw, Events[i].IsDraw);
+                Assert::AreEqual(expected[i].UpdateCount, Events[i].UpdateCount);
+            }
+        }
+    };
+
+    static Event U(INT64 updateCount) { return Event{ false, updateCount }; }
+    static Event D(INT64 updateCount) { return Event{ true, updateCount }; }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_IsUpdatePipelined_DefaultsToFalse)
+    {
+        CanvasAnimatedControlFixture f;
+
+        boolean value;
+        ThrowIfFailed(f.Control->get_IsUpdatePipelined(&value));
+        Assert::IsFalse(!!value);
+
+        ThrowIfFailed(f.Control->put_IsUpdatePipelined(TRUE));
+        ThrowIfFailed(f.Control->get_IsUpdatePipelined(&value));
+        Assert::IsTrue(!!value);
+
+        Assert::AreEqual(E_INVALIDARG, f.Control->get_IsUpdatePipelined(nullptr));
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenNotPipelined_UpdateAndDrawAlternateOnGameLoopThread)
+    {
+        Fixture f(false);
+
+        for (int i = 0; i < 3; ++i)
+            f.TickOneFrame();
+
+        f.AssertEvents({ U(1), D(1), U(2), D(2), U(3), D(3) });
+        Assert::AreEqual(0, f.Adapter->WorkerThreadItemCount);
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenPipelined_NextUpdateStartsBeforeCurrentFrameIsDrawn)
+    {
+        Fixture f;
+
+        for (int i = 0; i < 4; ++i)
+            f.TickOneFrame();
+
+        // Each Draw sees the timing of the Update whose results it is
+        // drawing, even though the next Update has already run.
+        f.AssertEvents({ U(1), U(2), D(1), U(3), D(2), U(4), D(3) });
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenPipelined_UpdateIsNeverMoreThanOneFrameAhead)
+    {
+        Fixture f;
+
+        for (int i = 0; i < 10; ++i)
+        {
+            f.TickOneFrame();
+
+            // Exactly one update is started per tick
+            Assert::AreEqual(i + 1, f.Adapter->WorkerThreadItemCount);
+
+            auto updates = std::count_if(f.Events.begin(), f.Events.end(), [](Event const& e) { return !e.IsDraw; });
+            auto draws = std::count_if(f.Events.begin(), f.Events.end(), [](Event const& e) { return e.IsDraw; });
+
+            Assert::AreEqual<ptrdiff_t>(1, updates - draws);
+        }
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenPipelinedAndPaused_LastUpdateIsStillDrawn)
+    {
+        Fixture f;
+
+        f.TickOneFrame();
+        f.TickOneFrame();
+
+        ThrowIfFailed(f.Control->put_Paused(TRUE));
+        f.TickOneFrame();
+
+        f.AssertEvents({ U(1), U(2), D(1), D(2) });
+        Assert::AreEqual(2, f.Adapter->WorkerThreadItemCount);
+        Assert::IsFalse(f.Adapter->GameThreadHasPendingWork());
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenPipelinedIsTurnedOff_PendingUpdateIsDrawnBeforeUpdatingOnGameLoopThread)
+    {
+        Fixture f;
+
+        f.TickOneFrame();
+        f.TickOneFrame();
+
+        ThrowIfFailed(f.Control->put_IsUpdatePipelined(FALSE));
+        f.TickOneFrame();
+        f.TickOneFrame();
+
+        f.AssertEvents({ U(1), U(2), D(1), D(2), U(3), D(3) });
+        Assert::AreEqual(2, f.Adapter->WorkerThreadItemCount);
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenPipelined_UpdateTimeIsRecordedAgainstTheFrameThatDrawsIt)
+    {
+        Fixture f;
+
+        const int64_t updateTime = 1000;
+
+        auto onUpdate = Callback<Animated_UpdateEventHandler>(
+            [&](ICanvasAnimatedControl*, ICanvasAnimatedUpdateEventArgs*)
+            {
+                f.Adapter->ProgressTime(updateTime);
+                return S_OK;
+            });
+        f.AddUpdateHandler(onUpdate.Get());
+
+        f.TickOneFrame();
+        f.TickOneFrame();
+
+        ComArray<CanvasFrameTiming> frames;
+        ThrowIfFailed(f.Control->GetFrameTimings(frames.GetAddressOfSize(), frames.GetAddressOfData()));
+
+        Assert::IsTrue(frames.GetSize() > 0);
+        Assert::AreEqual(updateTime, frames[frames.GetSize() - 1].UpdateTime.Duration);
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenPipelinedUpdateFails_ErrorIsReportedByTheNextTick)
+    {
+        Fixture f;
+
+        auto onUpdate = Callback<Animated_UpdateEventHandler>(
+            [&](ICanvasAnimatedControl*, ICanvasAnimatedUpdateEventArgs*)
+            {
+                return f.Events.size() > 1 ? E_FAIL : S_OK;
+            });
+        f.AddUpdateHandler(onUpdate.Get());
+
+        f.TickOneFrame();
+        Assert::IsTrue(f.Adapter->GameThreadHasPendingWork());
+
+        // This tick starts the update that fails...
+        f.TickOneFrame();
+        Assert::IsTrue(f.Adapter->GameThreadHasPendingWork());
+
+        // ...and this one picks up the failure, which stops the loop and is
+        // then reported in the same way as a failure on the game loop thread
+        f.TickOneFrame();
+        Assert::IsFalse(f.Adapter->GameThreadHasPendingWork());
+
+        ExpectHResultException(E_FAIL, [&] { f.Adapter->DoChanged(); });
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenPipelinedOnRealThreads_NextUpdateRunsWhileCurrentFrameIsDrawn)
+    {
+        CanvasAnimatedControlFixture f;
+        f.Adapter->RunWorkerThreadItemsOnRealThreads = true;
+        ThrowIfFailed(f.Control->put_IsUpdatePipelined(TRUE));
+
+        //
+        // Draw N waits for Update N+1 to start, and Update N+1 waits for
+        // Draw N to start, so each wait only succeeds if the two really are
+        // running at the same time.
+        //
+        std::mutex mutex;
+        std::condition_variable conditionVariable;
+        INT64 lastUpdateStarted = 0;
+        INT64 lastDrawStarted = 0;
+        int overlapCount = 0;
+
+        const int frameCount = 4;
+        auto const timeout = std::chrono::seconds(5);
+
+        auto onUpdate = Callback<Animated_UpdateEventHandler>(
+            [&](ICanvasAnimatedControl*, ICanvasAnimatedUpdateEventArgs* args)
+            {
+                CanvasTimingInformation timing;
+                ThrowIfFailed(args->get_Timing(&timing));
+
+                Lock lock(mutex);
+                lastUpdateStarted = timing.UpdateCount;
+                conditionVariable.notify_all();
+
+                if (timing.UpdateCount > 1 &&
+                    conditionVariable.wait_for(lock, timeout, [&] { return lastDrawStarted == timing.UpdateCount - 1; }))
+                {
+                    ++overlapCount;
+                }
+
+                return S_OK;
+            });
+        f.AddUpdateHandler(onUpdate.Get());
+
+        auto onDraw = Callback<Animated_DrawEventHandler>(
+            [&](ICanvasAnimatedControl*, ICanvasAnimatedDrawEventArgs* args)
+            {
+                CanvasTimingInformation timing;
+                ThrowIfFailed(args->get_Timing(&timing));
+
+                Lock lock(mutex);
+                lastDrawStarted = timing.UpdateCount;
+                conditionVariable.notify_all();
+
+                // The last frame is drawn after the loop is paused, so there
+                // is no next update for it to wait for
+                if (timing.UpdateCount < frameCount &&
+                    conditionVariable.wait_for(lock, timeout, [&] { return lastUpdateStarted == timing.UpdateCount + 1; }))
+                {
+                    ++overlapCount;
+                }
+
+                return S_OK;
+            });
+        f.AddDrawHandler(onDraw.Get());
+
+        f.Load();
+        f.Adapter->DoChanged();
+
+        for (int i = 0; i < frameCount; ++i)
+        {
+            f.Adapter->ProgressTime(TicksPerFrame);
+            f.Adapter->Tick();
+        }
+
+        // Collect the last pipelined update, and with it the reference it
+        // holds to the control
+        ThrowIfFailed(f.Control->put_Paused(TRUE));
+        f.Adapter->ProgressTime(TicksPerFrame);
+        f.Adapter->Tick();
+
+        f.Adapter->JoinWorkerThreads();
+
+        // Every tick after the first draws one frame while updating the next
+        Lock lock(mutex);
+        Assert::AreEqual((frameCount - 1) * 2, overlapCount);
+    }
+
+    TEST_METHOD_EX(CanvasAnimatedControl_WhenPipelinedOnRealThreads_UpdateHasFinishedWhenTickReturns)
+    {
+        CanvasAnimatedControlFixture f;
+        f.Adapter->RunWorkerThreadItemsOnRealThreads = true;
+        ThrowIfFailed(f.Control->put_IsUpdatePipelined(TRUE));
+
+        //
+        // Input events are dispatched by the game loop thread between ticks,
+        // so an update that is still running when the tick returns would run
+        // at the same time as them.  Each update waits for the frame before
+        // it to start drawing, and then takes a while longer, so it is still
+        // in flight when that frame has been presented.
+        //
+        std::mutex mutex;
+        std::condition_variable conditionVariable;
+        bool isUpdateRunning = false;
+        INT64 lastDrawStarted = 0;
+
+        auto const timeout = std::chrono::seconds(5);
+
+        auto onUpdate = Callback<Animated_UpdateEventHandler>(
+            [&](ICanvasAnimatedControl*, ICanvasAnimatedUpdateEventArgs* args)
+            {
+                CanvasTimingInformation timing;
+                ThrowIfFailed(args->get_Timing(&timing));
+
+                Lock lock(mutex);
+                isUpdateRunning = true;
+
+                if (timing.UpdateCount > 1)
+                    conditionVariable.wait_for(lock, timeout, [&] { return lastDrawStarted == timing.UpdateCount - 1; });
+
+                // Give the tick every chance to return before the update ends
+                lock.unlock();
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                lock.lock();
+
+                isUpdateRunning = false;
+                return S_OK;
+            });
+        f.AddUpdateHandler(onUpdate.Get());
+
+        auto onDraw = Callback<Animated_DrawEventHandler>(
+            [&](ICanvasAnimatedControl*, ICanvasAnimatedDrawEventArgs* args)
+            {
+                CanvasTimingInformation timing;
+                ThrowIfFailed(args->get_Timing(&timing));
+
+                Lock lock(mutex);
+                lastDrawStarted = timing.UpdateCount;
+                conditionVariable.notify_all();
+                return S_OK;
+            });
+        f.AddDrawHandler(onDraw.Get());
+
+        f.Load();
+        f.Adapter->DoChanged();
+
+        for (int i = 0; i < 4; ++i)
+        {
+            f.Adapter->ProgressTime(TicksPerFrame);
+            f.Adapter->Tick();
+
+            Lock lock(mutex);
+            Assert::IsFalse(isUpdateRunning);
+        }
+
+        ThrowIfFailed(f.Control->put_Paused(TRUE));
+        f.Adapter->ProgressTime(TicksPerFrame);
+        f.Adapter->Tick();
+
+        f.Adapter->JoinWorkerThreads();
+    }
+};
+
+TEST_CLASS(UpdatePipelineTests)
+{
+    static ULONG GetRefCount(IUnknown* object)
+    {
+        object->AddRef();
+        return object->Release();
+    }
+
+    TEST_METHOD_EX(UpdatePipeline_OwnerIsReleasedByTheThreadThatTakesTheResult_NotTheWorker)
+    {
+        auto owner = Make<MockAsyncAction>();
+        UpdatePipeline<int> pipeline;
+
+        std::thread worker(pipeline.Begin(As<IUnknown>(owner), [] { return 123; }));
+        worker.join();
+
+        // The worker has finished, and even destroyed its copy of the work,
+        // but the pipeline still holds the reference it was handed
+        Assert::AreEqual(2ul, GetRefCount(owner.Get()));
+
+        int result = 0;
+        Assert::IsTrue(pipeline.TakeResult(&result));
+        Assert::AreEqual(123, result);
+
+        Assert::AreEqual(1ul, GetRefCount(owner.Get()));
+    }
+
+    TEST_METHOD_EX(UpdatePipeline_WhenWorkIsCancelled_OwnerIsNotHeld)
+    {
+        auto owner = Make<MockAsyncAction>();
+        UpdatePipeline<int> pipeline;
+
+        {
+            auto work = pipeline.Begin(As<IUnknown>(owner), [] { return 123; });
+            pipeline.Cancel();
+        }
+
+        Assert::AreEqual(1ul, GetRefCount(owner.Get()));
+
+        int result = 0;
+        Assert::IsFalse(pipeline.TakeResult(&result));
+    }
+};
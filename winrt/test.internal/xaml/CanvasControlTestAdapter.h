@@ -62,6 +62,10 @@ public:
     // means).
     std::function<ComPtr<MockCanvasDrawingSession>()> OnCanvasImageSourceDrawingSessionFactory_Create;
 
+    // The update rectangle, in pixels, passed to every drawing session
+    // created through CreateCanvasImageSource.
+    std::vector<RECT> CanvasImageSourceDrawingSessionUpdateRects;
+
     virtual ComPtr<CanvasImageSource> CreateCanvasImageSource(
         ICanvasDevice* device, 
         float width, 
@@ -84,8 +88,10 @@ public:
 
         auto dsFactory = std::make_shared<MockCanvasImageSourceDrawingSessionFactory>();
         dsFactory->CreateMethod.AllowAnyCall(
-            [&](ICanvasDevice*, ISurfaceImageSourceNativeWithD2D*, Color const&, RECT const&, float)
+            [&](ICanvasDevice*, ISurfaceImageSourceNativeWithD2D*, Color const&, RECT const& updateRect, float)
             {
+                CanvasImageSourceDrawingSessionUpdateRects.push_back(updateRect);
+
                 if (OnCanvasImageSourceDrawingSessionFactory_Create)
                 {
                     // We call the function through a copy - this is so the
@@ -118,4 +124,12 @@ public:
     {
         return Make<StubImageControl>();
     }
+
+    ComPtr<StubRectangleGeometry> LastCreatedRectangleGeometry;
+
+    virtual ComPtr<IRectangleGeometry> CreateRectangleGeometry() override
+    {
+        LastCreatedRectangleGeometry = Make<StubRectangleGeometry>();
+        return LastCreatedRectangleGeometry;
+    }
 };
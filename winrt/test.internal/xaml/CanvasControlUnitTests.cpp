@@ -44,6 +44,25 @@ TEST_CLASS(CanvasControlTests_CommonAdapter)
         Assert::AreEqual(drawingSession.Get(), drawingSessionRetrieved.Get());
     }
 
+    TEST_METHOD_EX(CanvasControl_DrawEventArgs_UpdateRectangle)
+    {
+        ComPtr<ICanvasDrawingSession> drawingSession = Make<MockCanvasDrawingSession>();
+
+        Rect expectedRect{ 1, 2, 3, 4 };
+        auto drawEventArgs = Make<CanvasDrawEventArgs>(drawingSession.Get(), expectedRect);
+
+        Assert::AreEqual(E_INVALIDARG, drawEventArgs->get_UpdateRectangle(nullptr));
+
+        Rect rect;
+        ThrowIfFailed(drawEventArgs->get_UpdateRectangle(&rect));
+        Assert::AreEqual(expectedRect, rect);
+
+        // Args created without a rectangle report an empty one
+        drawEventArgs = Make<CanvasDrawEventArgs>(drawingSession.Get());
+        ThrowIfFailed(drawEventArgs->get_UpdateRectangle(&rect));
+        Assert::AreEqual(Rect{}, rect);
+    }
+
     TEST_METHOD_EX(CanvasControl_Callbacks)
     {
         using namespace ABI::Windows::Foundation;
@@ -167,6 +186,7 @@ TEST_CLASS(CanvasControlTests_CommonAdapter)
         VERIFY_THREADING_RESTRICTION(S_OK, f.Control->get_ClearColor(&color));
 
         VERIFY_THREADING_RESTRICTION(S_OK, f.Control->Invalidate());
+        VERIFY_THREADING_RESTRICTION(S_OK, f.Control->InvalidateRegion(Rect{ 0, 0, 1, 1 }));
     }
 };
 
@@ -423,6 +443,188 @@ TEST_CLASS(CanvasControlTests_SizeTests)
     };
 };
 
+TEST_CLASS(CanvasControl_SizePolicy)
+{
+    class Fixture : public CanvasControlFixture
+    {
+    public:
+        std::vector<Size> CreatedImageSourceSizes;
+
+        Fixture()
+        {
+            Adapter->CreateCanvasImageSourceMethod.AllowAnyCall(
+                [=](ICanvasDevice*, float width, float height, float, CanvasAlphaMode)
+                {
+                    CreatedImageSourceSizes.push_back(Size{ width, height });
+                    return nullptr;
+                });
+
+            Load();
+        }
+
+        void ArrangeAndRender(Size const& size)
+        {
+            Size returnedSize;
+            ThrowIfFailed(Control->ArrangeOverride(size, &returnedSize));
+            Assert::AreEqual(size, returnedSize);
+
+            UserControl->Resize(size);
+            RenderSingleFrame();
+        }
+
+        Rect GetClipRect()
+        {
+            return Adapter->LastCreatedRectangleGeometry->CurrentRect;
+        }
+    };
+
+    TEST_METHOD_EX(CanvasControl_WhenArranged_ImageSourceIsRoundedUp_AndClippedToControl)
+    {
+        Fixture f;
+
+        f.ArrangeAndRender(Size{ 100, 200 });
+
+        Assert::AreEqual<size_t>(1, f.CreatedImageSourceSizes.size());
+        Assert::AreEqual(Size{ 128, 256 }, f.CreatedImageSourceSizes.back());
+        Assert::AreEqual(Rect{ 0, 0, 100, 200 }, f.GetClipRect());
+    }
+
+    TEST_METHOD_EX(CanvasControl_WhenResizedWithinImageSource_ImageSourceIsNotRecreated)
+    {
+        Fixture f;
+
+        f.ArrangeAndRender(Size{ 100, 200 });
+        f.ArrangeAndRender(Size{ 120, 250 });
+        f.ArrangeAndRender(Size{ 90, 150 });
+
+        Assert::AreEqual<size_t>(1, f.CreatedImageSourceSizes.size());
+        Assert::AreEqual(Rect{ 0, 0, 90, 150 }, f.GetClipRect());
+    }
+
+    TEST_METHOD_EX(CanvasControl_WhenResizedManyTimes_ImageSourceIsRarelyRecreated)
+    {
+        Fixture f;
+
+        // Simulate the user dragging the edge of a window out and then back
+        // in again.
+        const int resizeSteps = 500;
+        for (int i = 0; i < resizeSteps; ++i)
+        {
+            float offset = static_cast<float>(i < resizeSteps / 2 ? i : resizeSteps - i);
+            f.ArrangeAndRender(Size{ f.InitialWidth + offset * 2, f.InitialHeight + offset });
+        }
+
+        // Without the size policy every one of these would create a new
+        // image source.
+        Assert::IsTrue(f.CreatedImageSourceSizes.size() <= 10);
+    }
+
+    TEST_METHOD_EX(CanvasControl_WhenShrunkOnceAndThenLeftAlone_ImageSourceIsShrunkAfterDelay)
+    {
+        Fixture f;
+
+        f.ArrangeAndRender(Size{ 1000, 1000 });
+        Assert::AreEqual<size_t>(1, f.CreatedImageSourceSizes.size());
+        f.CreatedImageSourceSizes.clear();
+
+        // Layout only runs once for the new size; after that the only thing
+        // happening is frames being rendered.
+        f.ArrangeAndRender(Size{ 100, 100 });
+
+        for (int i = 0; i < RenderTargetSizePolicy::ShrinkDelay - 2; ++i)
+            f.RenderSingleFrame();
+
+        Assert::AreEqual<size_t>(0, f.CreatedImageSourceSizes.size());
+
+        for (int i = 0; i < RenderTargetSizePolicy::ShrinkDelay * 2; ++i)
+            f.RenderSingleFrame();
+
+        Assert::AreEqual<size_t>(1, f.CreatedImageSourceSizes.size());
+        Assert::AreEqual(Size{ 128, 128 }, f.CreatedImageSourceSizes.back());
+    }
+};
+
+TEST_CLASS(RenderTargetSizePolicyTests)
+{
+    TEST_METHOD_EX(RenderTargetSizePolicy_WhenTooSmall_GrowsImmediatelyToNextStep)
+    {
+        RenderTargetSizePolicy policy;
+
+        Assert::AreEqual(Size{ 128, 256 }, policy.GetAllocationSize(Size{}, Size{ 1, 129 }));
+        Assert::AreEqual(Size{ 256, 256 }, policy.GetAllocationSize(Size{ 128, 256 }, Size{ 129, 10 }));
+    }
+
+    TEST_METHOD_EX(RenderTargetSizePolicy_WhenBigEnough_KeepsAllocation)
+    {
+        RenderTargetSizePolicy policy;
+
+        for (int i = 0; i < RenderTargetSizePolicy::ShrinkDelay * 2; ++i)
+        {
+            Assert::AreEqual(Size{ 256, 256 }, policy.GetAllocationSize(Size{ 256, 256 }, Size{ 129, 200 }));
+        }
+    }
+
+    TEST_METHOD_EX(RenderTargetSizePolicy_WhenMuchSmaller_ShrinksAfterDelay)
+    {
+        RenderTargetSizePolicy policy;
+
+        Size allocated{ 512, 512 };
+        Size required{ 10, 300 };
+
+        for (int i = 0; i < RenderTargetSizePolicy::ShrinkDelay - 1; ++i)
+        {
+            Assert::AreEqual(allocated, policy.GetAllocationSize(allocated, required));
+        }
+
+        Assert::AreEqual(Size{ 128, 384 }, policy.GetAllocationSize(allocated, required));
+    }
+
+    TEST_METHOD_EX(RenderTargetSizePolicy_WhenOnlyOneStepSmaller_KeepsAllocation)
+    {
+        RenderTargetSizePolicy policy;
+
+        Size allocated{ 256, 256 };
+
+        Assert::IsFalse(RenderTargetSizePolicy::ShouldShrink(allocated, Size{ 100, 100 }));
+
+        for (int i = 0; i < RenderTargetSizePolicy::ShrinkDelay * 2; ++i)
+        {
+            Assert::AreEqual(allocated, policy.GetAllocationSize(allocated, Size{ 100, 100 }));
+        }
+    }
+
+    TEST_METHOD_EX(RenderTargetSizePolicy_GrowToFit_NeverShrinks)
+    {
+        Assert::AreEqual(Size{ 512, 512 }, RenderTargetSizePolicy::GrowToFit(Size{ 512, 512 }, Size{ 10, 10 }));
+        Assert::AreEqual(Size{ 512, 640 }, RenderTargetSizePolicy::GrowToFit(Size{ 512, 512 }, Size{ 10, 600 }));
+    }
+
+    TEST_METHOD_EX(RenderTargetSizePolicy_WhenSizeRecoversBeforeDelay_DoesNotShrink)
+    {
+        RenderTargetSizePolicy policy;
+
+        Size allocated{ 512, 512 };
+
+        for (int i = 0; i < RenderTargetSizePolicy::ShrinkDelay - 1; ++i)
+            policy.GetAllocationSize(allocated, Size{ 10, 10 });
+
+        // Needing the whole allocation again resets the count
+        Assert::AreEqual(allocated, policy.GetAllocationSize(allocated, Size{ 500, 500 }));
+
+        for (int i = 0; i < RenderTargetSizePolicy::ShrinkDelay - 1; ++i)
+        {
+            Assert::AreEqual(allocated, policy.GetAllocationSize(allocated, Size{ 10, 10 }));
+        }
+    }
+
+    TEST_METHOD_EX(RenderTargetSizePolicy_ZeroSize_AllocatesNothing)
+    {
+        RenderTargetSizePolicy policy;
+
+        Assert::AreEqual(Size{ 0, 0 }, policy.GetAllocationSize(Size{}, Size{ 0, 0 }));
+    }
+};
+
 TEST_CLASS(CanvasControlTests_Dpi)
 {
     class CanvasControlTestAdapter_VerifyDpi : public CanvasControlTestAdapter_InjectDeviceContext
@@ -849,3 +1051,374 @@ TEST_CLASS(CanvasControl_ClearColor)
         f.RenderAnyNumberOfFrames();
     }
 };
+
+TEST_CLASS(CanvasControl_InvalidateRegion)
+{
+    class Fixture : public CanvasControlFixture
+    {
+    public:
+        std::vector<Rect> DrawnRects;
+
+        Fixture()
+        {
+            Adapter->CreateCanvasImageSourceMethod.AllowAnyCall();
+
+            auto onDraw = Callback<Static_DrawEventHandler>(
+                [=](ICanvasControl*, ICanvasDrawEventArgs* args)
+                {
+                    Rect rect;
+                    ThrowIfFailed(args->get_UpdateRectangle(&rect));
+                    DrawnRects.push_back(rect);
+                    return S_OK;
+                });
+            AddDrawHandler(onDraw.Get());
+
+            Load();
+            RenderSingleFrame();
+
+            Reset();
+        }
+
+        void Reset()
+        {
+            DrawnRects.clear();
+            Adapter->CanvasImageSourceDrawingSessionUpdateRects.clear();
+        }
+
+        void Invalidate(Rect const& rect)
+        {
+            ThrowIfFailed(Control->InvalidateRegion(rect));
+        }
+
+        void RenderAndExpectDraws(std::vector<Rect> const& expectedRects)
+        {
+            RenderSingleFrame();
+
+            Assert::AreEqual(expectedRects.size(), DrawnRects.size());
+            Assert::AreEqual(expectedRects.size(), Adapter->CanvasImageSourceDrawingSessionUpdateRects.size());
+
+            for (size_t i = 0; i < expectedRects.size(); ++i)
+            {
+                auto& expected = expectedRects[i];
+                auto& actualRect = Adapter->CanvasImageSourceDrawingSessionUpdateRects[i];
+
+                Assert::AreEqual(expected, DrawnRects[i]);
+
+                // The control is at the default DPI, so dips are pixels
+                Assert::AreEqual(static_cast<LONG>(expected.X), actualRect.left);
+                Assert::AreEqual(static_cast<LONG>(expected.Y), actualRect.top);
+                Assert::AreEqual(static_cast<LONG>(expected.X + expected.Width), actualRect.right);
+                Assert::AreEqual(static_cast<LONG>(expected.Y + expected.Height), actualRect.bottom);
+            }
+
+            Reset();
+        }
+
+        Rect WholeControl() const
+        {
+            return Rect{ 0, 0, InitialWidth, InitialHeight };
+        }
+    };
+
+    TEST_METHOD_EX(CanvasControl_WhenControlIsFirstDrawn_UpdateRectangleIsWholeControl)
+    {
+        CanvasControlFixture f;
+        f.Adapter->CreateCanvasImageSourceMethod.AllowAnyCall();
+
+        int drawCount = 0;
+        auto onDraw = Callback<Static_DrawEventHandler>(
+            [&](ICanvasControl*, ICanvasDrawEventArgs* args)
+            {
+                Rect rect;
+                ThrowIfFailed(args->get_UpdateRectangle(&rect));
+                Assert::AreEqual(Rect{ 0, 0, CanvasControlFixture::InitialWidth, CanvasControlFixture::InitialHeight }, rect);
+                ++drawCount;
+                return S_OK;
+            });
+        f.AddDrawHandler(onDraw.Get());
+
+        // Even if only part of the control has been invalidated, a new image
+        // source must be drawn in full.
+        ThrowIfFailed(f.Control->InvalidateRegion(Rect{ 1, 2, 3, 4 }));
+
+        f.Load();
+        f.RenderSingleFrame();
+
+        Assert::AreEqual(1, drawCount);
+    }
+
+    TEST_METHOD_EX(CanvasControl_InvalidateRegion_DrawsOnlyThatRegion)
+    {
+        Fixture f;
+
+        f.Invalidate(Rect{ 10, 20, 30, 40 });
+        f.RenderAndExpectDraws({ Rect{ 10, 20, 30, 40 } });
+
+        // Nothing is redrawn once the region has been drawn
+        f.RenderAndExpectDraws({});
+    }
+
+    TEST_METHOD_EX(CanvasControl_InvalidateRegion_SeparateRegionsAreDrawnSeparately)
+    {
+        Fixture f;
+
+        f.Invalidate(Rect{ 0, 0, 10, 10 });
+        f.Invalidate(Rect{ 50, 50, 10, 10 });
+        f.RenderAndExpectDraws({ Rect{ 0, 0, 10, 10 }, Rect{ 50, 50, 10, 10 } });
+    }
+
+    TEST_METHOD_EX(CanvasControl_InvalidateRegion_OverlappingRegionsAreMerged)
+    {
+        Fixture f;
+
+        f.Invalidate(Rect{ 10, 10, 20, 20 });
+        f.Invalidate(Rect{ 20, 20, 20, 20 });
+        f.Invalidate(Rect{ 15, 15, 5, 5 });
+        f.RenderAndExpectDraws({ Rect{ 10, 10, 30, 30 } });
+    }
+
+    TEST_METHOD_EX(CanvasControl_InvalidateRegion_NumberOfDrawsIsBounded)
+    {
+        Fixture f;
+
+        std::vector<Rect> invalidatedRects;
+        for (int i = 0; i < 20; ++i)
+        {
+            Rect rect{ static_cast<float>(i * 5), static_cast<float>(i * 10), 2, 2 };
+            invalidatedRects.push_back(rect);
+            f.Invalidate(rect);
+        }
+
+        f.RenderSingleFrame();
+
+        Assert::IsTrue(f.DrawnRects.size() <= InvalidRegion::MaxRectangles);
+
+        // Every invalidated rect must still be covered by one of the draws
+        for (auto& rect : invalidatedRects)
+        {
+            bool covered = std::any_of(f.DrawnRects.begin(), f.DrawnRects.end(),
+                [&](Rect const& drawn)
+                {
+                    return drawn.X <= rect.X &&
+                           drawn.Y <= rect.Y &&
+                           drawn.X + drawn.Width >= rect.X + rect.Width &&
+                           drawn.Y + drawn.Height >= rect.Y + rect.Height;
+                });
+
+            Assert::IsTrue(covered);
+        }
+    }
+
+    TEST_METHOD_EX(CanvasControl_InvalidateRegion_IsOverriddenByInvalidate)
+    {
+        Fixture f;
+
+        f.Invalidate(Rect{ 10, 20, 30, 40 });
+        ThrowIfFailed(f.Control->Invalidate());
+        f.Invalidate(Rect{ 50, 60, 10, 10 });
+
+        f.RenderAndExpectDraws({ f.WholeControl() });
+    }
+
+    TEST_METHOD_EX(CanvasControl_InvalidateRegion_IsOverriddenByClearColorChange)
+    {
+        Fixture f;
+
+        f.Invalidate(Rect{ 10, 20, 30, 40 });
+        ThrowIfFailed(f.Control->put_ClearColor(Color{ 255, 1, 2, 3 }));
+
+        f.RenderAndExpectDraws({ f.WholeControl() });
+    }
+
+    TEST_METHOD_EX(CanvasControl_InvalidateRegion_IsClippedToControl)
+    {
+        Fixture f;
+
+        f.Invalidate(Rect{ -10, 190, 20, 50 });
+        f.RenderAndExpectDraws({ Rect{ 0, 190, 10, 10 } });
+
+        f.Invalidate(Rect{ 500, 500, 10, 10 });
+        f.RenderAndExpectDraws({});
+    }
+
+    TEST_METHOD_EX(CanvasControl_InvalidateRegion_FractionalRegionsAreGrownToWholePixels)
+    {
+        Fixture f;
+
+        // Rounding each edge to the nearest pixel would make this empty
+        f.Invalidate(Rect{ 10.1f, 20.1f, 0.2f, 0.2f });
+        f.RenderAndExpectDraws({ Rect{ 10, 20, 1, 1 } });
+
+        f.Invalidate(Rect{ 10.5f, 20.25f, 5, 5 });
+        f.RenderAndExpectDraws({ Rect{ 10, 20, 6, 6 } });
+    }
+
+    TEST_METHOD_EX(CanvasControl_InvalidateRegion_FractionalRegionsAreGrownToWholePixelsAtCurrentDpi)
+    {
+        Fixture f;
+
+        f.Adapter->LogicalDpi = DEFAULT_DPI * 1.5f;
+        f.Adapter->RaiseDpiChangedEvent();
+        f.RenderSingleFrame();
+        f.Reset();
+
+        // 10.1 to 10.3 dips is 15.15 to 15.45 pixels
+        f.Invalidate(Rect{ 10.1f, 20.1f, 0.2f, 0.2f });
+        f.RenderSingleFrame();
+
+        Assert::AreEqual<size_t>(1, f.Adapter->CanvasImageSourceDrawingSessionUpdateRects.size());
+
+        auto& updateRect = f.Adapter->CanvasImageSourceDrawingSessionUpdateRects[0];
+        Assert::AreEqual(15L, updateRect.left);
+        Assert::AreEqual(30L, updateRect.top);
+        Assert::AreEqual(16L, updateRect.right);
+        Assert::AreEqual(31L, updateRect.bottom);
+    }
+
+    TEST_METHOD_EX(CanvasControl_InvalidateRegion_WithEmptyRegion_DoesNothing)
+    {
+        Fixture f;
+
+        ThrowIfFailed(f.Control->InvalidateRegion(Rect{ 10, 10, 0, 10 }));
+        ThrowIfFailed(f.Control->InvalidateRegion(Rect{ 10, 10, 10, 0 }));
+
+        f.RenderAndExpectDraws({});
+    }
+
+    TEST_METHOD_EX(CanvasControl_InvalidateRegion_WithNegativeSize_Fails)
+    {
+        Fixture f;
+
+        Assert::AreEqual(E_INVALIDARG, f.Control->InvalidateRegion(Rect{ 10, 10, -1, 10 }));
+        Assert::AreEqual(E_INVALIDARG, f.Control->InvalidateRegion(Rect{ 10, 10, 10, -1 }));
+
+        f.RenderAndExpectDraws({});
+    }
+
+    TEST_METHOD_EX(CanvasControl_InvalidateRegion_WhenWindowIsNotVisible_RegionIsDrawnOnceVisible)
+    {
+        Fixture f;
+
+        f.Adapter->GetCurrentMockWindow()->SetVisible(false);
+
+        f.Invalidate(Rect{ 10, 20, 30, 40 });
+        f.RenderAndExpectDraws({});
+
+        f.Adapter->GetCurrentMockWindow()->SetVisible(true);
+        f.RenderAndExpectDraws({ Rect{ 10, 20, 30, 40 } });
+    }
+};
+
+TEST_CLASS(InvalidRegionTests)
+{
+    TEST_METHOD_EX(InvalidRegion_IsInitiallyFull)
+    {
+        InvalidRegion region;
+
+        Assert::IsTrue(region.IsFull());
+        Assert::IsFalse(region.IsEmpty());
+
+        region.Invalidate(Rect{ 1, 2, 3, 4 });
+        Assert::IsTrue(region.IsFull());
+        Assert::IsTrue(region.GetRectangles().empty());
+
+        region.Clear();
+        Assert::IsFalse(region.IsFull());
+        Assert::IsTrue(region.IsEmpty());
+    }
+
+    TEST_METHOD_EX(InvalidRegion_EmptyRectsAreIgnored)
+    {
+        InvalidRegion region;
+        region.Clear();
+
+        region.Invalidate(Rect{ 1, 2, 0, 4 });
+        region.Invalidate(Rect{ 1, 2, 3, 0 });
+
+        Assert::IsTrue(region.IsEmpty());
+    }
+
+    TEST_METHOD_EX(InvalidRegion_TouchingRectsAreMerged)
+    {
+        InvalidRegion region;
+        region.Clear();
+
+        region.Invalidate(Rect{ 0, 0, 10, 10 });
+        region.Invalidate(Rect{ 10, 0, 10, 10 });
+
+        Assert::AreEqual<size_t>(1, region.GetRectangles().size());
+        Assert::AreEqual(Rect{ 0, 0, 20, 10 }, region.GetRectangles()[0]);
+    }
+
+    TEST_METHOD_EX(InvalidRegion_MergingCanCascade)
+    {
+        InvalidRegion region;
+        region.Clear();
+
+        region.Invalidate(Rect{ 0, 0, 10, 10 });
+        region.Invalidate(Rect{ 30, 0, 10, 10 });
+        Assert::AreEqual<size_t>(2, region.GetRectangles().size());
+
+        // This overlaps the first rect, and the union of the two then
+        // overlaps the second.
+        region.Invalidate(Rect{ 5, 0, 20, 5 });
+
+        Assert::AreEqual<size_t>(1, region.GetRectangles().size());
+        Assert::AreEqual(Rect{ 0, 0, 40, 10 }, region.GetRectangles()[0]);
+    }
+
+    TEST_METHOD_EX(InvalidRegion_WhenTooManyRects_CheapestPairIsMerged)
+    {
+        InvalidRegion region;
+        region.Clear();
+
+        for (size_t i = 0; i < InvalidRegion::MaxRectangles; ++i)
+            region.Invalidate(Rect{ i * 100.0f, 0, 10, 10 });
+
+        Assert::AreEqual(InvalidRegion::MaxRectangles, region.GetRectangles().size());
+
+        // This is closest to the first rect, so should be merged with it.
+        region.Invalidate(Rect{ 15, 0, 10, 10 });
+
+        auto& rects = region.GetRectangles();
+        Assert::AreEqual(InvalidRegion::MaxRectangles, rects.size());
+        Assert::IsTrue(std::any_of(rects.begin(), rects.end(), [](Rect const& r) { return r == Rect{ 0, 0, 25, 10 }; }));
+    }
+
+    TEST_METHOD_EX(InvalidRegion_ClipAndSnapToPixels_ClipsToSize)
+    {
+        Size size{ 100, 50 };
+
+        Rect rect{ -10, -10, 20, 100 };
+        Assert::IsTrue(InvalidRegion::ClipAndSnapToPixels(&rect, size, DEFAULT_DPI));
+        Assert::AreEqual(Rect{ 0, 0, 10, 50 }, rect);
+
+        rect = Rect{ 100, 0, 10, 10 };
+        Assert::IsFalse(InvalidRegion::ClipAndSnapToPixels(&rect, size, DEFAULT_DPI));
+    }
+
+    TEST_METHOD_EX(InvalidRegion_ClipAndSnapToPixels_GrowsFractionalRectsToWholePixels)
+    {
+        Size size{ 100, 50 };
+
+        // Smaller than a pixel, and not touching a pixel boundary
+        Rect rect{ 10.1f, 20.1f, 0.2f, 0.2f };
+        Assert::IsTrue(InvalidRegion::ClipAndSnapToPixels(&rect, size, DEFAULT_DPI));
+        Assert::AreEqual(Rect{ 10, 20, 1, 1 }, rect);
+
+        // Partly covered pixels on every edge are included
+        rect = Rect{ 10.5f, 20.25f, 5, 5 };
+        Assert::IsTrue(InvalidRegion::ClipAndSnapToPixels(&rect, size, DEFAULT_DPI));
+        Assert::AreEqual(Rect{ 10, 20, 6, 6 }, rect);
+
+        // At 200% each dip is two pixels, so the result lands on half dips
+        rect = Rect{ 10.3f, 20.3f, 0.1f, 0.1f };
+        Assert::IsTrue(InvalidRegion::ClipAndSnapToPixels(&rect, size, DEFAULT_DPI * 2));
+        Assert::AreEqual(Rect{ 10, 20, 0.5f, 0.5f }, rect);
+
+        // Snapping outward doesn't go past the edge of the control
+        rect = Rect{ 99.5f, 49.5f, 0.25f, 0.25f };
+        Assert::IsTrue(InvalidRegion::ClipAndSnapToPixels(&rect, size, DEFAULT_DPI));
+        Assert::AreEqual(Rect{ 99, 49, 1, 1 }, rect);
+    }
+};
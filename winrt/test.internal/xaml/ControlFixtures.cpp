@@ -37,6 +37,7 @@ std::shared_ptr<CanvasAnimatedControlTestAdapter> CreateAnimatedControlTestAdapt
 
             dxgiSwapChain->Present1Method.AllowAnyCall();
             dxgiSwapChain->SetMatrixTransformMethod.AllowAnyCall();
+            dxgiSwapChain->SetSourceSizeMethod.AllowAnyCall();
             
             dxgiSwapChain->GetDesc1Method.AllowAnyCall(
                 [=](DXGI_SWAP_CHAIN_DESC1* desc)
@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use these files except in compliance with the License. You may obtain
+// a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+// License for the specific language governing permissions and limitations
+// under the License.
+
+#include "pch.h"
+
+#include <lib/xaml/FrameTimingRecorder.h>
+
+using namespace ABI::Microsoft::Graphics::Canvas::UI;
+using namespace ABI::Microsoft::Graphics::Canvas::UI::Xaml;
+
+class StubTimingAdapter : public ICanvasTimingAdapter
+{
+public:
+    int64_t Counter;
+    int64_t Frequency;
+
+    StubTimingAdapter(int64_t frequency)
+        : Counter(0)
+        , Frequency(frequency)
+    {
+    }
+
+    virtual LARGE_INTEGER GetPerformanceCounter() override
+    {
+        LARGE_INTEGER l;
+        l.QuadPart = Counter;
+        return l;
+    }
+
+    virtual LARGE_INTEGER GetPerformanceFrequency() override
+    {
+        LARGE_INTEGER l;
+        l.QuadPart = Frequency;
+        return l;
+    }
+};
+
+TEST_CLASS(FrameTimingRecorderTests)
+{
+    struct Fixture
+    {
+        std::shared_ptr<StubTimingAdapter> Adapter;
+        FrameTimingRecorder Recorder;
+
+        Fixture(size_t capacity = FrameTimingRecorder::DefaultCapacity, int64_t frequency = StepTimer::TicksPerSecond)
+            : Adapter(std::make_shared<StubTimingAdapter>(frequency))
+            , Recorder(Adapter, capacity)
+        {
+        }
+
+        void RecordFrame(int64_t updateTime, int64_t drawTime, int32_t updateCount = 1, bool isRunningSlowly = false)
+        {
+            Recorder.BeginFrame();
+
+            Recorder.BeginPhase();
+            Adapter->Counter += updateTime;
+            Recorder.EndPhase(FramePhase::Update);
+
+            Recorder.BeginPhase();
+            Adapter->Counter += drawTime;
+            Recorder.EndPhase(FramePhase::Draw);
+
+            Recorder.EndFrame(updateCount, isRunningSlowly);
+        }
+    };
+
+    TEST_METHOD_EX(FrameTimingRecorder_WhenNoFramesRecorded_ReturnsEmptyResults)
+    {
+        Fixture f;
+
+        Assert::IsTrue(f.Recorder.GetFrameTimings().empty());
+
+        auto percentile = f.Recorder.GetPercentile(50);
+        Assert::AreEqual(0LL, percentile.TotalTime.Duration);
+        Assert::AreEqual(0, percentile.UpdateCount);
+    }
+
+    TEST_METHOD_EX(FrameTimingRecorder_RecordsTimeSpentInEachPhase)
+    {
+        Fixture f;
+
+        f.Recorder.BeginFrame();
+        f.Adapter->Counter += 5;
+        f.Recorder.EndPhase(FramePhase::Present);
+
+        f.Recorder.BeginPhase();
+        f.Adapter->Counter += 10;
+        f.Recorder.EndPhase(FramePhase::Update);
+
+        // Time between phases counts towards the total only.
+        f.Adapter->Counter += 1;
+
+        f.Recorder.BeginPhase();
+        f.Adapter->Counter += 20;
+        f.Recorder.EndPhase(FramePhase::Update);
+
+        f.Recorder.BeginPhase();
+        f.Adapter->Counter += 30;
+        f.Recorder.EndPhase(FramePhase::Draw);
+
+        f.Recorder.BeginPhase();
+        f.Adapter->Counter += 40;
+        f.Recorder.EndPhase(FramePhase::Present);
+
+        f.Recorder.EndFrame(2, true);
+
+        auto frames = f.Recorder.GetFrameTimings();
+        Assert::AreEqual<size_t>(1, frames.size());
+
+        Assert::AreEqual(30LL, frames[0].UpdateTime.Duration);
+        Assert::AreEqual(30LL, frames[0].DrawTime.Duration);
+        Assert::AreEqual(45LL, frames[0].PresentTime.Duration);
+        Assert::AreEqual(106LL, frames[0].TotalTime.Duration);
+        Assert::AreEqual(2, frames[0].UpdateCount);
+        Assert::IsTrue(!!frames[0].IsRunningSlowly);
+    }
+
+    TEST_METHOD_EX(FrameTimingRecorder_ConvertsPerformanceCounterToTicks)
+    {
+        Fixture f(FrameTimingRecorder::DefaultCapacity, 1000);
+
+        f.RecordFrame(1, 2);
+
+        auto frames = f.Recorder.GetFrameTimings();
+        Assert::AreEqual<size_t>(1, frames.size());
+
+        Assert::AreEqual(StepTimer::TicksPerSecond / 1000, static_cast<uint64_t>(frames[0].UpdateTime.Duration));
+        Assert::AreEqual(StepTimer::TicksPerSecond * 2 / 1000, static_cast<uint64_t>(frames[0].DrawTime.Duration));
+        Assert::AreEqual(StepTimer::TicksPerSecond * 3 / 1000, static_cast<uint64_t>(frames[0].TotalTime.Duration));
+    }
+
+    TEST_METHOD_EX(FrameTimingRecorder_KeepsMostRecentFramesOldestFirst)
+    {
+        const size_t capacity = 4;
+
+        Fixture f(capacity);
+
+        for (int i = 1; i <= 10; i++)
+        {
+            f.RecordFrame(i, 0);
+        }
+
+        auto frames = f.Recorder.GetFrameTimings();
+        Assert::AreEqual(capacity, frames.size());
+
+        for (size_t i = 0; i < capacity; i++)
+        {
+            Assert::AreEqual(static_cast<int64_t>(7 + i), frames[i].UpdateTime.Duration);
+        }
+
+        f.Recorder.Clear();
+        Assert::IsTrue(f.Recorder.GetFrameTimings().empty());
+
+        f.RecordFrame(42, 0);
+        frames = f.Recorder.GetFrameTimings();
+        Assert::AreEqual<size_t>(1, frames.size());
+        Assert::AreEqual(42LL, frames[0].UpdateTime.Duration);
+    }
+
+    TEST_METHOD_EX(FrameTimingRecorder_GetPercentile_UsesNearestRank)
+    {
+        Fixture f;
+
+        // Record frames out of order, to check they are sorted.
+        for (int i = 0; i < 100; i++)
+        {
+            auto value = (i * 37) % 100 + 1;
+            f.RecordFrame(value, 101 - value, value % 4 + 1);
+        }
+
+        auto p0 = f.Recorder.GetPercentile(0);
+        auto p50 = f.Recorder.GetPercentile(50);
+        auto p90 = f.Recorder.GetPercentile(90);
+        auto p99_5 = f.Recorder.GetPercentile(99.5f);
+        auto p100 = f.Recorder.GetPercentile(100);
+
+        Assert::AreEqual(1LL, p0.UpdateTime.Duration);
+        Assert::AreEqual(50LL, p50.UpdateTime.Duration);
+        Assert::AreEqual(90LL, p90.UpdateTime.Duration);
+        Assert::AreEqual(100LL, p99_5.UpdateTime.Duration);
+        Assert::AreEqual(100LL, p100.UpdateTime.Duration);
+
+        // Each field is ranked independently.
+        Assert::AreEqual(90LL, p90.DrawTime.Duration);
+        Assert::AreEqual(101LL, p90.TotalTime.Duration);
+        Assert::AreEqual(1, p0.UpdateCount);
+        Assert::AreEqual(4, p100.UpdateCount);
+    }
+
+    TEST_METHOD_EX(FrameTimingRecorder_GetPercentile_ReportsIsRunningSlowlyForSlowestFrames)
+    {
+        Fixture f;
+
+        for (int i = 0; i < 10; i++)
+        {
+            f.RecordFrame(1, 1, 1, i == 3);
+        }
+
+        Assert::IsFalse(!!f.Recorder.GetPercentile(50).IsRunningSlowly);
+        Assert::IsFalse(!!f.Recorder.GetPercentile(90).IsRunningSlowly);
+        Assert::IsTrue(!!f.Recorder.GetPercentile(91).IsRunningSlowly);
+        Assert::IsTrue(!!f.Recorder.GetPercentile(100).IsRunningSlowly);
+    }
+
+    TEST_METHOD_EX(FrameTimingRecorder_GetPercentile_RejectsOutOfRangeValues)
+    {
+        Fixture f;
+        f.RecordFrame(1, 1);
+
+        ExpectHResultException(E_INVALIDARG, [&] { f.Recorder.GetPercentile(-0.1f); });
+        ExpectHResultException(E_INVALIDARG, [&] { f.Recorder.GetPercentile(100.1f); });
+        ExpectHResultException(E_INVALIDARG, [&] { f.Recorder.GetPercentile(std::numeric_limits<float>::quiet_NaN()); });
+    }
+};